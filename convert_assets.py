@@ -2,7 +2,7 @@
 """
 Script per convertire asset dal progetto Raspberry Pi a formato compatibile ESP32
 - Boot logo: JPG -> BMP o array C
-- Font: TTF -> bitmap array C (opzionale)
+- Font: TTF -> atlas alpha 4-bit in array C (font_atlas.h)
 - Icone: PNG -> bitmap array C (opzionale)
 """
 
@@ -217,6 +217,136 @@ def create_image_array_c(image_path_or_img, output_path, var_name="image_data",
         print(f"   ❌ Errore conversione immagine: {e}")
         return False
 
+# Font da rasterizzare nell'atlas: (nome variabile, dimensione px, set caratteri)
+# - small: etichette e info GPS (ASCII stampabile)
+# - medium: limite velocità dentro il cerchio
+# - large: distanza nell'alert ("350m", "1.2km")
+FONT_ATLAS_SPECS = [
+    ("font_small", 13, "".join(chr(c) for c in range(32, 127))),
+    ("font_medium", 18, "0123456789"),
+    ("font_large", 30, "0123456789mk. "),
+]
+
+# TTF sorgente: prima quello del progetto Raspberry Pi, poi font di sistema
+FONT_TTF_CANDIDATES = [
+    os.path.join(PI_ASSETS_DIR, "fonts", "font.ttf"),
+    "/usr/share/fonts/truetype/dejavu/DejaVuSans-Bold.ttf",
+    "/Library/Fonts/Arial Bold.ttf",
+]
+
+def rasterize_glyph(font, ch, ascent):
+    """Rasterizza un carattere in alpha 8-bit e ritaglia il box con contenuto
+    Ritorna (pixels 4-bit, width, height, x_off, y_off, advance)
+    """
+    from PIL import ImageDraw
+    
+    advance = int(round(font.getlength(ch)))
+    left, top, right, bottom = font.getbbox(ch)
+    width = max(0, right - left)
+    height = max(0, bottom - top)
+    if width == 0 or height == 0:
+        return [], 0, 0, 0, 0, advance
+    
+    img = Image.new('L', (width, height), 0)
+    ImageDraw.Draw(img).text((-left, -top), ch, font=font, fill=255)
+    
+    # Quantizza a 4 bit con arrotondamento (0-15)
+    pixels = [(v * 15 + 127) // 255 for v in img.getdata()]
+    # y_off relativo alla baseline (negativo = sopra la baseline)
+    return pixels, width, height, left, top - ascent, advance
+
+def convert_font():
+    """Converte TTF in atlas alpha 4-bit (src/font_atlas.h)
+    Ogni glifo è ritagliato al box con contenuto e impacchettato a 2 pixel per byte
+    """
+    print("🔤 Conversione font atlas...")
+    
+    from PIL import ImageFont
+    
+    ttf_path = next((p for p in FONT_TTF_CANDIDATES if os.path.exists(p)), None)
+    if not ttf_path:
+        print("   ⚠️  Nessun TTF trovato!")
+        for p in FONT_TTF_CANDIDATES:
+            print(f"   Cercato in: {p}")
+        return False
+    print(f"   📄 TTF: {ttf_path}")
+    
+    atlas_path = os.path.join(SCRIPT_DIR, "src", "font_atlas.h")
+    
+    try:
+        output = f"// Font: {os.path.basename(ttf_path)}\n"
+        output += "// Atlas alpha 4-bit (2 pixel per byte, nibble alto = pixel a sinistra)\n"
+        output += "// Generato automaticamente con convert_assets.py - non modificare manualmente\n"
+        output += "#ifndef FONT_ATLAS_H\n"
+        output += "#define FONT_ATLAS_H\n\n"
+        output += '#include "font_renderer.h"\n\n'
+        
+        total_bytes = 0
+        for var_name, size, charset in FONT_ATLAS_SPECS:
+            font = ImageFont.truetype(ttf_path, size)
+            ascent, _ = font.getmetrics()
+            first = min(ord(c) for c in charset)
+            last = max(ord(c) for c in charset)
+            
+            bitmap = []
+            glyphs = []
+            for code in range(first, last + 1):
+                ch = chr(code)
+                if ch not in charset:
+                    # Carattere non incluso: glifo vuoto senza avanzamento
+                    glyphs.append((0, 0, 0, 0, 0, 0, ch))
+                    continue
+                pixels, w, h, x_off, y_off, advance = rasterize_glyph(font, ch, ascent)
+                offset = len(bitmap)
+                stride = (w + 1) // 2
+                for y in range(h):
+                    row = pixels[y * w:(y + 1) * w] + [0]
+                    for x in range(stride):
+                        bitmap.append((row[2 * x] << 4) | row[2 * x + 1])
+                glyphs.append((offset, w, h, x_off, y_off, advance, ch))
+            
+            if len(bitmap) > 0xFFFF:
+                print(f"   ❌ {var_name}: atlas troppo grande ({len(bitmap)} bytes)")
+                return False
+            
+            output += f"// {var_name}: {size}px, {len(charset)} glifi, {len(bitmap)} bytes\n"
+            output += f"const uint8_t {var_name}_bitmap[] PROGMEM = {{\n"
+            for i in range(0, len(bitmap), 16):
+                output += "  " + ", ".join(f"0x{b:02X}" for b in bitmap[i:i + 16]) + ",\n"
+            output += "};\n\n"
+            
+            output += f"const AtlasGlyph {var_name}_glyphs[] PROGMEM = {{\n"
+            for offset, w, h, x_off, y_off, advance, ch in glyphs:
+                label = ch if ch not in "\\" else "backslash"
+                output += f"  {{ {offset}, {w}, {h}, {x_off}, {y_off}, {advance} }},  // '{label}'\n"
+            output += "};\n\n"
+            
+            # Box verticale comune a tutti i glifi (relativo alla baseline):
+            # il renderer usa solo queste righe, senza spazio vuoto sopra/sotto
+            inked = [g for g in glyphs if g[2] > 0]
+            ink_top = min(g[4] for g in inked)
+            ink_bottom = max(g[4] + g[2] for g in inked)
+            
+            output += f"const AtlasFont {var_name} = {{\n"
+            output += f"  {var_name}_bitmap, {var_name}_glyphs, 0x{first:02X}, 0x{last:02X}, {ink_top}, {ink_bottom - ink_top}\n"
+            output += "};\n\n"
+            
+            total_bytes += len(bitmap) + len(glyphs) * 7
+            print(f"   ✅ {var_name}: {size}px, {len(charset)} glifi, {len(bitmap)} bytes bitmap")
+        
+        output += "#endif // FONT_ATLAS_H\n"
+        
+        with open(atlas_path, 'w') as f:
+            f.write(output)
+        
+        print(f"   ✅ Font atlas generato: {atlas_path}")
+        print(f"   📊 Dimensione totale: {total_bytes} bytes (flash)")
+        return True
+        
+    except Exception as e:
+        print(f"   ❌ Errore conversione font: {e}")
+        return False
+
 def main():
     print("=" * 60)
     print("🔄 Conversione Asset MicroNav ESP32")
@@ -234,7 +364,13 @@ def main():
     
     print()
     
-    # 2. Copia database speedcam
+    # 2. Converti font atlas
+    if not convert_font():
+        success = False
+    
+    print()
+    
+    # 3. Copia database speedcam
     if not copy_speedcam_json():
         success = False
     
@@ -0,0 +1,310 @@
+#include "Arduino.h"
+#include "host_sim.h"
+#include "SPI.h"
+#include <time.h>
+#include <fcntl.h>
+#include <termios.h>
+#include <unistd.h>
+
+HardwareSerial Serial(0);
+SPIClass SPI;
+
+// ---- Tempo ----
+
+static bool clock_virtual = false;
+static uint64_t virtual_us = 0;
+
+static uint64_t monotonic_us() {
+    static uint64_t start_us = 0;
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    uint64_t now = (uint64_t)ts.tv_sec * 1000000ULL + ts.tv_nsec / 1000;
+    if (start_us == 0) start_us = now;
+    return now - start_us;
+}
+
+void host_clock_use_virtual(bool enabled) {
+    if (enabled && !clock_virtual) {
+        virtual_us = monotonic_us();
+    }
+    clock_virtual = enabled;
+}
+
+void host_clock_advance_us(uint64_t us) {
+    virtual_us += us;
+}
+
+uint64_t host_clock_now_us() {
+    return clock_virtual ? virtual_us : monotonic_us();
+}
+
+unsigned long millis() {
+    return (unsigned long)(host_clock_now_us() / 1000);
+}
+
+unsigned long micros() {
+    return (unsigned long)host_clock_now_us();
+}
+
+void delay(unsigned long ms) {
+    delayMicroseconds(ms * 1000);
+}
+
+void delayMicroseconds(unsigned int us) {
+    if (clock_virtual) {
+        virtual_us += us;
+        return;
+    }
+    struct timespec ts;
+    ts.tv_sec = us / 1000000;
+    ts.tv_nsec = (long)(us % 1000000) * 1000;
+    nanosleep(&ts, nullptr);
+}
+
+void yield() {
+}
+
+// ---- Pin ----
+
+static uint8_t pin_levels[64];
+
+void pinMode(uint8_t pin, uint8_t mode) {
+    (void)pin;
+    (void)mode;
+}
+
+void digitalWrite(uint8_t pin, uint8_t val) {
+    if (pin < sizeof(pin_levels)) pin_levels[pin] = val;
+}
+
+int digitalRead(uint8_t pin) {
+    return pin < sizeof(pin_levels) ? pin_levels[pin] : LOW;
+}
+
+long random(long max_value) {
+    return max_value > 0 ? rand() % max_value : 0;
+}
+
+long random(long min_value, long max_value) {
+    return max_value > min_value ? min_value + random(max_value - min_value) : min_value;
+}
+
+void randomSeed(unsigned long seed) {
+    srand((unsigned int)seed);
+}
+
+// ---- Print / Stream / String ----
+
+size_t Print::write(const uint8_t* buffer, size_t size) {
+    size_t written = 0;
+    while (size--) {
+        written += write(*buffer++);
+    }
+    return written;
+}
+
+size_t Print::print(const String& str) {
+    return write(str.c_str());
+}
+
+static size_t print_unsigned(Print& out, unsigned long long value, int base) {
+    char buffer[66];
+    char* p = &buffer[sizeof(buffer) - 1];
+    *p = '\0';
+    if (base < 2) base = 10;
+    do {
+        int digit = (int)(value % base);
+        *--p = (char)(digit < 10 ? '0' + digit : 'A' + digit - 10);
+        value /= base;
+    } while (value);
+    return out.write(p);
+}
+
+size_t Print::print(long value, int base) {
+    return print((long long)value, base);
+}
+
+size_t Print::print(unsigned long value, int base) {
+    return print_unsigned(*this, value, base);
+}
+
+size_t Print::print(long long value, int base) {
+    if (base == DEC && value < 0) {
+        return print('-') + print_unsigned(*this, (unsigned long long)(-value), base);
+    }
+    return print_unsigned(*this, (unsigned long long)value, base);
+}
+
+size_t Print::print(unsigned long long value, int base) {
+    return print_unsigned(*this, value, base);
+}
+
+size_t Print::print(double value, int digits) {
+    char buffer[64];
+    snprintf(buffer, sizeof(buffer), "%.*f", digits, value);
+    return write(buffer);
+}
+
+size_t Stream::readBytes(char* buffer, size_t length) {
+    size_t count = 0;
+    while (count < length) {
+        int c = read();
+        if (c < 0) break;
+        buffer[count++] = (char)c;
+    }
+    return count;
+}
+
+bool String::endsWith(const String& suffix) const {
+    return value.size() >= suffix.value.size() &&
+           value.compare(value.size() - suffix.value.size(), suffix.value.size(), suffix.value) == 0;
+}
+
+int String::indexOf(char c) const {
+    size_t pos = value.find(c);
+    return pos == std::string::npos ? -1 : (int)pos;
+}
+
+// ---- UART ----
+
+/**
+ * Coda RX a dimensione fissa, come il buffer del driver UART: nessuna
+ * allocazione durante il loop (i conteggi heap dopo setup includono l'HAL)
+ */
+struct RxQueue {
+    uint8_t data[HOST_SERIAL_RX_BUFFER];
+    size_t head;
+    size_t count;
+
+    void push(const uint8_t* bytes, size_t length) {
+        static bool overflow_reported = false;
+        for (size_t i = 0; i < length; i++) {
+            if (count == HOST_SERIAL_RX_BUFFER) {
+                // Overflow come su una UART reale: i byte in eccesso si perdono
+                if (!overflow_reported) {
+                    overflow_reported = true;
+                    fprintf(stderr, "host: overflow buffer RX UART (%d byte)\n", HOST_SERIAL_RX_BUFFER);
+                }
+                return;
+            }
+            data[(head + count) % HOST_SERIAL_RX_BUFFER] = bytes[i];
+            count++;
+        }
+    }
+
+    int front() const { return count ? data[head] : -1; }
+
+    int pop() {
+        if (!count) return -1;
+        uint8_t c = data[head];
+        head = (head + 1) % HOST_SERIAL_RX_BUFFER;
+        count--;
+        return c;
+    }
+};
+
+static RxQueue rx_queues[HOST_SERIAL_PORTS];
+static bool console_muted = false;
+static int console_pty = -1;   // Lato master del pty della console (-1 = stdout)
+
+const char* host_console_open_pty() {
+    int master = posix_openpt(O_RDWR | O_NOCTTY);
+    if (master < 0) return nullptr;
+    if (grantpt(master) != 0 || unlockpt(master) != 0) {
+        close(master);
+        return nullptr;
+    }
+    const char* slave_path = ptsname(master);
+    // Slave aperto per tutta la durata: configurato raw (niente eco dell'output
+    // come input) e senza EIO sul master quando nessun client è collegato
+    int slave = slave_path ? open(slave_path, O_RDWR | O_NOCTTY) : -1;
+    if (slave < 0) {
+        close(master);
+        return nullptr;
+    }
+    struct termios tio;
+    tcgetattr(slave, &tio);
+    cfmakeraw(&tio);
+    tcsetattr(slave, TCSANOW, &tio);
+    fcntl(master, F_SETFL, fcntl(master, F_GETFL) | O_NONBLOCK);
+    console_pty = master;
+    return slave_path;
+}
+
+// Sposta nella coda RX della console i byte scritti dal client sul pty
+static void console_pty_poll() {
+    if (console_pty < 0) return;
+    uint8_t buffer[256];
+    ssize_t n;
+    while ((n = ::read(console_pty, buffer, sizeof(buffer))) > 0) {
+        rx_queues[0].push(buffer, n);
+    }
+}
+
+void host_serial_feed(int uart_nr, const char* data, size_t length) {
+    if (uart_nr < 0 || uart_nr >= HOST_SERIAL_PORTS) return;
+    rx_queues[uart_nr].push((const uint8_t*)data, length);
+}
+
+size_t host_serial_pending(int uart_nr) {
+    if (uart_nr < 0 || uart_nr >= HOST_SERIAL_PORTS) return 0;
+    return rx_queues[uart_nr].count;
+}
+
+void host_serial_mute(bool muted) {
+    console_muted = muted;
+}
+
+HardwareSerial::HardwareSerial(int uart_nr) : uart_nr(uart_nr) {
+}
+
+void HardwareSerial::begin(unsigned long baud, uint32_t config, int8_t rx_pin, int8_t tx_pin,
+                           bool invert, unsigned long timeout_ms, uint8_t rx_threshold) {
+    (void)baud; (void)config; (void)rx_pin; (void)tx_pin;
+    (void)invert; (void)timeout_ms; (void)rx_threshold;
+}
+
+void HardwareSerial::end() {
+}
+
+int HardwareSerial::available() {
+    if (uart_nr == 0) console_pty_poll();
+    return (int)host_serial_pending(uart_nr);
+}
+
+int HardwareSerial::read() {
+    if (uart_nr == 0) console_pty_poll();
+    if (uart_nr < 0 || uart_nr >= HOST_SERIAL_PORTS) return -1;
+    return rx_queues[uart_nr].pop();
+}
+
+int HardwareSerial::peek() {
+    if (uart_nr < 0 || uart_nr >= HOST_SERIAL_PORTS) return -1;
+    return rx_queues[uart_nr].front();
+}
+
+size_t HardwareSerial::write(uint8_t c) {
+    return write(&c, 1);
+}
+
+size_t HardwareSerial::write(const uint8_t* buffer, size_t size) {
+    // Solo la console produce output, le altre UART scartano (nessun dispositivo collegato)
+    if (uart_nr == 0 && !console_muted) {
+        if (console_pty >= 0) {
+            // Client lento o assente: i byte oltre il buffer del pty si perdono, come su USB CDC
+            size_t sent = 0;
+            while (sent < size) {
+                ssize_t n = ::write(console_pty, buffer + sent, size - sent);
+                if (n <= 0) break;
+                sent += n;
+            }
+        } else {
+            fwrite(buffer, 1, size, stdout);
+        }
+    }
+    return size;
+}
+
+void HardwareSerial::flush() {
+    if (uart_nr == 0) fflush(stdout);
+}
@@ -0,0 +1,536 @@
+/*
+ * corridor_bench: match della posizione sui corridoi stradali (src/corridor_map.h)
+ *
+ *   corridor_bench [--roads N] [--queries N] [--verbose]
+ *
+ * Rete sintetica nel formato di make_corridors.py, costruita in memoria:
+ * un'autostrada curva est-ovest di 20 km, una strada che la scavalca da sud a
+ * nord, una complanare parallela a 150 m e --roads strade casuali (default
+ * 40) in un quadrato di 40 km. Speedcam agganciate all'autostrada, alla strada
+ * del cavalcavia e alla complanare, più una non agganciata accanto all'autostrada.
+ *
+ *  - correttezza: --queries posizioni (default 4000, metà vicino a una strada)
+ *    confrontate con la ricerca esaustiva in doppia precisione su tutti i
+ *    segmenti. Ai bordi di raggio e tolleranza di rotta l'esito può cambiare
+ *    per arrotondamento: vale la fascia tra ricerca stretta e larga.
+ *  - throughput: µs, chunk e segmenti esaminati per match, guidando lungo le
+ *    strade a 1 Hz (posizioni vicine tra loro) e su posizioni casuali.
+ *  - rilevanza: percorsi sull'autostrada nei due versi, sotto il cavalcavia e
+ *    sulla complanare; per ciascuno le speedcam entro 1 km che darebbero un
+ *    alert devono essere esattamente quelle attese, e nessuna speedcam
+ *    dell'autostrada è rilevante oltre CORRIDOR_BEHIND_SLACK_M dietro.
+ *
+ * Fallisce (exit 1) se un match esce dalla fascia della ricerca esaustiva o
+ * se le speedcam rilevanti di un percorso non sono quelle attese.
+ */
+
+#include <Arduino.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include "host_sim.h"
+#include "hal.h"
+#include "utils.h"
+#include "config.h"
+#include "corridor_map.h"
+
+// Origine della rete sintetica
+#define BENCH_LAT0 45.0
+#define BENCH_LNG0 9.0
+#define BENCH_AREA_M 40000.0
+#define BENCH_HIGHWAY_M 20000.0
+#define BENCH_OVERPASS_X 8000.0         // Incrocio del cavalcavia con l'autostrada
+#define BENCH_SERVICE_OFFSET_M 150.0    // Complanare: oltre il raggio del match
+#define BENCH_ALERT_RADIUS_M 1000.0
+#define BENCH_STEP_M 25.0               // Passo dei percorsi (90 km/h a 1 Hz)
+// Fascia della ricerca esaustiva (coordinate intere: ~1 m)
+#define BENCH_DISTANCE_BAND_M 1.5
+#define BENCH_HEADING_BAND 1.0
+
+static uint32_t seed = 24680;
+
+static double random_unit() {
+    seed = seed * 1103515245 + 12345;
+    return ((seed >> 8) % 100000) / 100000.0;
+}
+
+static double random_range(double min, double max) {
+    return min + (max - min) * random_unit();
+}
+
+static const double meters_per_degree = CORRIDOR_METERS_PER_UNIT * CORRIDOR_SCALE;
+static const double cos_lat0 = cos(BENCH_LAT0 * M_PI / 180.0);
+
+static int32_t units_lat(double y) {
+    return (int32_t)lround((BENCH_LAT0 + y / meters_per_degree) * CORRIDOR_SCALE);
+}
+
+static int32_t units_lng(double x) {
+    return (int32_t)lround((BENCH_LNG0 + x / (meters_per_degree * cos_lat0)) * CORRIDOR_SCALE);
+}
+
+static double unit_lat_deg(int32_t u) { return (double)u / CORRIDOR_SCALE; }
+
+/**
+ * Punto di una strada già quantizzato (come make_corridors.py)
+ */
+struct RoadPoint {
+    int32_t lat;
+    int32_t lng;
+    double s;       // Progressiva in metri
+};
+
+struct BenchCamera {
+    uint32_t id;
+    int road;           // -1 = non agganciata
+    double lat;
+    double lng;
+    double s;
+};
+
+/**
+ * Rete e file dei corridoi costruito in memoria
+ */
+struct Network {
+    std::vector<std::vector<RoadPoint>> roads;
+    std::vector<BenchCamera> cameras;
+    std::vector<uint8_t> file;
+};
+
+static double segment_length(const RoadPoint& a, const RoadPoint& b) {
+    double cos_mid = cos(unit_lat_deg((a.lat + b.lat) / 2) * M_PI / 180.0);
+    double dy = (b.lat - a.lat) * CORRIDOR_METERS_PER_UNIT;
+    double dx = (b.lng - a.lng) * CORRIDOR_METERS_PER_UNIT * cos_mid;
+    return sqrt(dx * dx + dy * dy);
+}
+
+static int add_road(Network& net, const std::vector<double>& xs, const std::vector<double>& ys) {
+    std::vector<RoadPoint> road;
+    for (size_t i = 0; i < xs.size(); i++) {
+        RoadPoint p = { units_lat(ys[i]), units_lng(xs[i]), 0.0 };
+        if (!road.empty()) {
+            if (p.lat == road.back().lat && p.lng == road.back().lng) continue;
+            p.s = road.back().s + segment_length(road.back(), p);
+        }
+        road.push_back(p);
+    }
+    net.roads.push_back(road);
+    return (int)net.roads.size() - 1;
+}
+
+static void add_camera(Network& net, uint32_t id, int road, int vertex) {
+    const RoadPoint& p = net.roads[road][vertex];
+    net.cameras.push_back({ id, road, unit_lat_deg(p.lat), unit_lat_deg(p.lng), p.s });
+}
+
+template <typename T>
+static void append(std::vector<uint8_t>& out, const T& value) {
+    const uint8_t* bytes = (const uint8_t*)&value;
+    out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+/**
+ * Serializza come make_corridors.py: chunk di al più CORRIDOR_CHUNK_POINTS
+ * punti entro l'int16 dall'origine, punto di confine condiviso (CRC non
+ * calcolati: attach() non li verifica)
+ */
+static void write_file(Network& net) {
+    std::vector<CorridorChunk> chunks;
+    std::vector<CorridorPoint> points;
+    for (size_t r = 0; r < net.roads.size(); r++) {
+        const std::vector<RoadPoint>& road = net.roads[r];
+        size_t i = 0;
+        while (i + 1 < road.size()) {
+            CorridorChunk chunk;
+            memset(&chunk, 0, sizeof(chunk));
+            chunk.lat0 = road[i].lat;
+            chunk.lng0 = road[i].lng;
+            chunk.first_point = (uint32_t)points.size();
+            chunk.corridor = (uint16_t)r;
+            chunk.start_m = (uint32_t)lround(road[i].s);
+            size_t j = i;
+            while (j < road.size() && chunk.point_count < CORRIDOR_CHUNK_POINTS) {
+                int32_t dlat = road[j].lat - chunk.lat0;
+                int32_t dlng = road[j].lng - chunk.lng0;
+                if (abs(dlat) > 32000 || abs(dlng) > 32000 || road[j].s - road[i].s > 60000.0) break;
+                CorridorPoint p = { (int16_t)dlat, (int16_t)dlng, (uint16_t)lround(road[j].s - chunk.start_m) };
+                points.push_back(p);
+                if (chunk.point_count == 0 || dlat < chunk.min_lat) chunk.min_lat = (int16_t)dlat;
+                if (chunk.point_count == 0 || dlat > chunk.max_lat) chunk.max_lat = (int16_t)dlat;
+                if (chunk.point_count == 0 || dlng < chunk.min_lng) chunk.min_lng = (int16_t)dlng;
+                if (chunk.point_count == 0 || dlng > chunk.max_lng) chunk.max_lng = (int16_t)dlng;
+                chunk.point_count++;
+                j++;
+            }
+            chunks.push_back(chunk);
+            i = j - 1;
+        }
+    }
+
+    std::vector<CorridorCamera> cameras;
+    for (const BenchCamera& c : net.cameras) {
+        if (c.road < 0) continue;
+        cameras.push_back({ c.id, (uint16_t)c.road, 0, (uint32_t)lround(c.s) });
+    }
+    std::sort(cameras.begin(), cameras.end(),
+              [](const CorridorCamera& a, const CorridorCamera& b) { return a.id < b.id; });
+
+    CorridorHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = CORRIDOR_MAGIC;
+    header.format = CORRIDOR_FORMAT;
+    header.corridor_count = (uint16_t)net.roads.size();
+    header.chunk_count = (uint32_t)chunks.size();
+    header.point_count = (uint32_t)points.size();
+    header.camera_count = (uint32_t)cameras.size();
+
+    net.file.clear();
+    append(net.file, header);
+    for (const CorridorChunk& c : chunks) append(net.file, c);
+    for (const CorridorPoint& p : points) append(net.file, p);
+    while (net.file.size() % 4) net.file.push_back(0);
+    for (const CorridorCamera& c : cameras) append(net.file, c);
+}
+
+static void build_network(Network& net, int random_roads) {
+    std::vector<double> xs, ys;
+
+    // 0: autostrada curva est-ovest attraverso l'origine
+    for (double x = 0.0; x <= BENCH_HIGHWAY_M; x += 250.0) {
+        xs.push_back(x);
+        ys.push_back(600.0 * sin(x / 3000.0));
+    }
+    int highway = add_road(net, xs, ys);
+
+    // 1: strada nord-sud che scavalca l'autostrada
+    xs.clear();
+    ys.clear();
+    double cross_y = 600.0 * sin(BENCH_OVERPASS_X / 3000.0);
+    for (double y = -4000.0; y <= 4000.0; y += 200.0) {
+        xs.push_back(BENCH_OVERPASS_X + 0.02 * y);
+        ys.push_back(cross_y + y);
+    }
+    int overpass = add_road(net, xs, ys);
+
+    // 2: complanare a BENCH_SERVICE_OFFSET_M a nord dell'autostrada per 4 km
+    xs.clear();
+    ys.clear();
+    for (double x = 12000.0; x <= 16000.0; x += 250.0) {
+        xs.push_back(x);
+        ys.push_back(600.0 * sin(x / 3000.0) + BENCH_SERVICE_OFFSET_M);
+    }
+    int service = add_road(net, xs, ys);
+
+    // Strade casuali: passi di 150-400 m con svolte fino a 20°
+    for (int r = 0; r < random_roads; r++) {
+        xs.clear();
+        ys.clear();
+        double x = random_range(-BENCH_AREA_M / 2, BENCH_AREA_M / 2);
+        double y = random_range(-BENCH_AREA_M / 2, BENCH_AREA_M / 2);
+        double heading = random_range(0.0, 2.0 * M_PI);
+        int count = 20 + (int)(random_unit() * 60);
+        for (int i = 0; i < count; i++) {
+            xs.push_back(x);
+            ys.push_back(y);
+            double step = random_range(150.0, 400.0);
+            heading += random_range(-0.35, 0.35);
+            x += step * sin(heading);
+            y += step * cos(heading);
+        }
+        int road = add_road(net, xs, ys);
+        add_camera(net, 1000 + r, road, (int)net.roads[road].size() / 2);
+    }
+
+    // Speedcam dei percorsi di prova (vertici a 250 m l'uno dall'altro)
+    add_camera(net, 10, highway, 12);                   // x = 3000
+    add_camera(net, 11, highway, 30);                   // x = 7500, prima del cavalcavia
+    add_camera(net, 12, highway, 56);                   // x = 14000, accanto alla complanare
+    add_camera(net, 20, overpass, 21);                  // sul cavalcavia, 200 m a nord dell'incrocio
+    add_camera(net, 30, service, 10);                   // complanare, x = 14500
+    // Non agganciata: 60 m a sud dell'autostrada a x = 5000
+    net.cameras.push_back({ 40, -1, BENCH_LAT0 + (600.0 * sin(5000.0 / 3000.0) - 60.0) / meters_per_degree,
+                            BENCH_LNG0 + 5000.0 / (meters_per_degree * cos_lat0), 0.0 });
+
+    write_file(net);
+}
+
+/**
+ * Ricerca esaustiva in doppia precisione sui punti della rete
+ */
+struct BruteResult {
+    bool found;
+    int road;
+    double offset_m;
+};
+
+static BruteResult brute_force(const Network& net, double lat, double lng, double course_deg, bool course_valid,
+                               double radius_m, double tolerance_deg) {
+    BruteResult best = { false, -1, radius_m };
+    double cos_lat = cos(lat * M_PI / 180.0);
+    double qy = lat * CORRIDOR_SCALE;
+    double qx = lng * CORRIDOR_SCALE;
+    double course = course_deg * M_PI / 180.0;
+    double cos_tolerance = cos(tolerance_deg * M_PI / 180.0);
+    for (size_t r = 0; r < net.roads.size(); r++) {
+        const std::vector<RoadPoint>& road = net.roads[r];
+        for (size_t i = 0; i + 1 < road.size(); i++) {
+            double ax = (road[i].lng - qx) * cos_lat;
+            double ay = road[i].lat - qy;
+            double sx = (road[i + 1].lng - qx) * cos_lat - ax;
+            double sy = road[i + 1].lat - qy - ay;
+            double length2 = sx * sx + sy * sy;
+            if (length2 == 0.0) continue;
+            if (course_valid) {
+                double dot = (sx * sin(course) + sy * cos(course)) / sqrt(length2);
+                if (fabs(dot) < cos_tolerance) continue;
+            }
+            double t = clamp(-(ax * sx + ay * sy) / length2, 0.0, 1.0);
+            double px = ax + t * sx;
+            double py = ay + t * sy;
+            double offset = sqrt(px * px + py * py) * CORRIDOR_METERS_PER_UNIT;
+            if (offset <= best.offset_m) {
+                best.found = true;
+                best.road = (int)r;
+                best.offset_m = offset;
+            }
+        }
+    }
+    return best;
+}
+
+/**
+ * Direzione della strada al vertice (gradi dal nord, senso orario)
+ */
+static double road_course(const std::vector<RoadPoint>& road, size_t i) {
+    size_t j = i + 1 < road.size() ? i + 1 : i;
+    size_t k = j > 0 ? j - 1 : 0;
+    double dy = road[j].lat - road[k].lat;
+    double dx = (road[j].lng - road[k].lng) * cos_lat0;
+    return atan2(dx, dy) * 180.0 / M_PI;
+}
+
+static int check_correctness(const Network& net, CorridorMap& map, int query_count, bool verbose) {
+    int mismatches = 0;
+    int matched = 0;
+    for (int q = 0; q < query_count; q++) {
+        double lat, lng, course;
+        if (q % 2 == 0) {
+            // Vicino a un vertice di una strada, rotta attorno a quella della strada
+            const std::vector<RoadPoint>& road = net.roads[(int)(random_unit() * net.roads.size())];
+            size_t i = (size_t)(random_unit() * (road.size() - 1));
+            lat = unit_lat_deg(road[i].lat) + random_range(-80.0, 80.0) / meters_per_degree;
+            lng = unit_lat_deg(road[i].lng) + random_range(-80.0, 80.0) / (meters_per_degree * cos_lat0);
+            course = road_course(road, i) + random_range(-70.0, 70.0) + (random_unit() < 0.5 ? 180.0 : 0.0);
+        } else {
+            lat = BENCH_LAT0 + random_range(-BENCH_AREA_M / 2, BENCH_AREA_M / 2) / meters_per_degree;
+            lng = BENCH_LNG0 + random_range(-BENCH_AREA_M / 2, BENCH_AREA_M / 2) / (meters_per_degree * cos_lat0);
+            course = random_range(0.0, 360.0);
+        }
+        course = fmod(course + 360.0, 360.0);
+        bool course_valid = q % 5 != 0;
+
+        // Match senza storia (nessuna isteresi da un match precedente)
+        map.attach(net.file.data(), net.file.size());
+        const CorridorMatch& m = map.match(lat, lng, (float)course, course_valid);
+        BruteResult strict = brute_force(net, lat, lng, course, course_valid,
+                                         CORRIDOR_MATCH_RADIUS_M - BENCH_DISTANCE_BAND_M,
+                                         CORRIDOR_HEADING_TOLERANCE - BENCH_HEADING_BAND);
+        BruteResult loose = brute_force(net, lat, lng, course, course_valid,
+                                        CORRIDOR_MATCH_RADIUS_M + BENCH_DISTANCE_BAND_M,
+                                        CORRIDOR_HEADING_TOLERANCE + BENCH_HEADING_BAND);
+        if (m.matched) matched++;
+
+        const char* error = nullptr;
+        if (strict.found && !m.matched) {
+            error = "nessun match";
+        } else if (!loose.found && m.matched) {
+            error = "match inatteso";
+        } else if (m.matched && (m.offset_m < loose.offset_m - BENCH_DISTANCE_BAND_M ||
+                                 (strict.found && m.offset_m > strict.offset_m + BENCH_DISTANCE_BAND_M))) {
+            error = "segmento non più vicino";
+        }
+        if (error) {
+            mismatches++;
+            if (verbose || mismatches <= 5) {
+                printf("  ERRORE %s: %.6f,%.6f rotta %.0f%s: match %d a %.1f m, esaustiva %d a %.1f m (larga %d a %.1f m)\n",
+                       error, lat, lng, course, course_valid ? "" : " (non valida)",
+                       m.matched ? m.corridor : -1, m.offset_m, strict.road, strict.offset_m,
+                       loose.road, loose.offset_m);
+            }
+        }
+    }
+    printf("Correttezza: %d posizioni, %d su un corridoio, %d fuori dalla ricerca esaustiva %s\n",
+           query_count, matched, mismatches, mismatches ? "ERRORE" : "OK");
+    return mismatches;
+}
+
+/**
+ * Throughput: cicli, chunk e segmenti per match
+ */
+static void bench_throughput(const Network& net, CorridorMap& map, int query_count) {
+    // Percorsi a 1 Hz lungo le strade e posizioni casuali
+    std::vector<double> track_lat, track_lng, track_course;
+    for (size_t r = 0; r < net.roads.size() && (int)track_lat.size() < query_count; r++) {
+        const std::vector<RoadPoint>& road = net.roads[r];
+        for (size_t i = 0; i + 1 < road.size() && (int)track_lat.size() < query_count; i++) {
+            double length = road[i + 1].s - road[i].s;
+            for (double d = 0.0; d < length; d += BENCH_STEP_M) {
+                double t = d / length;
+                track_lat.push_back(unit_lat_deg(road[i].lat) + t * (unit_lat_deg(road[i + 1].lat) - unit_lat_deg(road[i].lat)));
+                track_lng.push_back(unit_lat_deg(road[i].lng) + t * (unit_lat_deg(road[i + 1].lng) - unit_lat_deg(road[i].lng)));
+                track_course.push_back(fmod(road_course(road, i) + 360.0, 360.0));
+            }
+        }
+    }
+    std::vector<double> random_lat, random_lng, random_course;
+    for (int q = 0; q < query_count; q++) {
+        random_lat.push_back(BENCH_LAT0 + random_range(-BENCH_AREA_M / 2, BENCH_AREA_M / 2) / meters_per_degree);
+        random_lng.push_back(BENCH_LNG0 + random_range(-BENCH_AREA_M / 2, BENCH_AREA_M / 2) / (meters_per_degree * cos_lat0));
+        random_course.push_back(random_range(0.0, 360.0));
+    }
+
+    printf("%-10s %8s %10s %10s %10s %10s %10s\n", "posizioni", "match", "us/match", "su strada", "chunk", "segmenti", "seg. max");
+    const char* names[] = { "percorso", "casuali" };
+    const std::vector<double>* lats[] = { &track_lat, &random_lat };
+    const std::vector<double>* lngs[] = { &track_lng, &random_lng };
+    const std::vector<double>* courses[] = { &track_course, &random_course };
+    for (int k = 0; k < 2; k++) {
+        map.attach(net.file.data(), net.file.size());
+        map.resetStats();
+        size_t count = lats[k]->size();
+        long chunks = 0;
+        uint32_t start = hal_cycles();
+        for (size_t q = 0; q < count; q++) {
+            const CorridorMatch& m = map.match((*lats[k])[q], (*lngs[k])[q], (float)(*courses[k])[q], true);
+            chunks += m.chunks;
+        }
+        uint32_t cycles = hal_cycles() - start;
+        CorridorMap::Stats stats = map.getStats();
+        printf("%-10s %8zu %10.3f %9.1f%% %10.2f %10.2f %10lu\n", names[k], count,
+               (double)cycles / hal_cycles_per_us() / count, 100.0 * stats.matched / count,
+               (double)chunks / count, (double)stats.segments / count, stats.max_segments);
+    }
+}
+
+/**
+ * Percorso lungo una strada della rete (o un tratto), con le speedcam rilevanti
+ * entro BENCH_ALERT_RADIUS_M ad almeno un passo
+ */
+struct DriveScenario {
+    const char* name;
+    int road;
+    bool reverse;
+    double from_m;          // Tratto della strada percorso (progressive)
+    double to_m;
+    std::vector<uint32_t> expected;
+};
+
+static int run_drive(const Network& net, CorridorMap& map, const DriveScenario& scenario, bool verbose) {
+    const std::vector<RoadPoint>& road = net.roads[scenario.road];
+    map.attach(net.file.data(), net.file.size());
+    std::vector<uint32_t> alerted;
+    int behind_errors = 0;
+    int steps = 0;
+
+    double length = scenario.to_m - scenario.from_m;
+    for (double d = 0.0; d <= length; d += BENCH_STEP_M) {
+        double s = scenario.reverse ? scenario.to_m - d : scenario.from_m + d;
+        size_t i = 0;
+        while (i + 2 < road.size() && road[i + 1].s < s) i++;
+        double t = clamp((s - road[i].s) / (road[i + 1].s - road[i].s), 0.0, 1.0);
+        double lat = unit_lat_deg(road[i].lat) + t * (unit_lat_deg(road[i + 1].lat) - unit_lat_deg(road[i].lat));
+        double lng = unit_lat_deg(road[i].lng) + t * (unit_lat_deg(road[i + 1].lng) - unit_lat_deg(road[i].lng));
+        double course = fmod(road_course(road, i) + (scenario.reverse ? 180.0 : 0.0) + 360.0, 360.0);
+        const CorridorMatch& m = map.match(lat, lng, (float)course, true);
+        steps++;
+
+        for (const BenchCamera& c : net.cameras) {
+            if (calculate_distance(lat, lng, c.lat, c.lng) > BENCH_ALERT_RADIUS_M) continue;
+            if (!map.isRelevant(c.id)) continue;
+            if (std::find(alerted.begin(), alerted.end(), c.id) == alerted.end()) {
+                alerted.push_back(c.id);
+                if (verbose) {
+                    printf("  %6.0f m: speedcam %u rilevante (corridoio %d, progressiva %.0f, verso %d)\n",
+                           s, c.id, m.matched ? m.corridor : -1, m.position_m, m.direction);
+                }
+            }
+            // Speedcam della stessa strada già superata
+            if (c.road == scenario.road && (c.s - s) * (scenario.reverse ? -1.0 : 1.0) < -(CORRIDOR_BEHIND_SLACK_M + BENCH_STEP_M)) {
+                behind_errors++;
+            }
+        }
+    }
+
+    std::sort(alerted.begin(), alerted.end());
+    std::vector<uint32_t> expected = scenario.expected;
+    std::sort(expected.begin(), expected.end());
+    bool ok = alerted == expected && behind_errors == 0;
+
+    std::string got, want;
+    for (uint32_t id : alerted) got += std::to_string(id) + " ";
+    for (uint32_t id : expected) want += std::to_string(id) + " ";
+    printf("%-28s %6d passi  %-14s %s", scenario.name, steps, got.c_str(), ok ? "OK\n" : "ERRORE");
+    if (!ok) {
+        printf(" (attese: %s, %d dietro)\n", want.c_str(), behind_errors);
+    }
+    return ok ? 0 : 1;
+}
+
+int main(int argc, char** argv) {
+    int random_roads = 40;
+    int query_count = 4000;
+    bool verbose = false;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--roads") == 0 && i + 1 < argc) {
+            random_roads = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--queries") == 0 && i + 1 < argc) {
+            query_count = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--verbose") == 0) {
+            verbose = true;
+        } else {
+            fprintf(stderr, "uso: %s [--roads N] [--queries N] [--verbose]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (random_roads < 0 || random_roads > 1000 || query_count < 1) {
+        fprintf(stderr, "--roads tra 0 e 1000, --queries almeno 1\n");
+        return 2;
+    }
+    host_serial_mute(true);
+
+    Network net;
+    build_network(net, random_roads);
+    CorridorMap map;
+    if (!map.attach(net.file.data(), net.file.size())) {
+        printf("File dei corridoi non valido\n");
+        return 1;
+    }
+    printf("Rete: %u corridoi, %u chunk, %u punti, %u speedcam agganciate, %zu byte (%s il budget di %d)\n",
+           map.getCorridorCount(), (unsigned int)map.getChunkCount(), (unsigned int)map.getPointCount(),
+           (unsigned int)map.getCameraCount(), net.file.size(),
+           net.file.size() <= CORRIDOR_RAM_BUDGET ? "entro" : "oltre", CORRIDOR_RAM_BUDGET);
+
+    int failures = check_correctness(net, map, query_count, verbose);
+    bench_throughput(net, map, query_count);
+
+    const double highway_end = net.roads[0].back().s;
+    const double overpass_end = net.roads[1].back().s;
+    DriveScenario drives[] = {
+        { "autostrada verso est", 0, false, 0.0, highway_end, { 10, 11, 12, 40 } },
+        { "autostrada verso ovest", 0, true, 0.0, highway_end, { 10, 11, 12, 40 } },
+        { "sotto il cavalcavia", 1, false, 0.0, overpass_end, { 20 } },
+        { "cavalcavia verso sud", 1, true, 0.0, overpass_end, { 20 } },
+        { "complanare", 2, false, 0.0, net.roads[2].back().s, { 30 } },
+    };
+    printf("%-28s %12s  %s\n", "percorso", "", "speedcam rilevanti entro 1 km");
+    for (const DriveScenario& drive : drives) {
+        failures += run_drive(net, map, drive, verbose);
+    }
+
+    if (failures) {
+        printf("\n%d verifiche fallite\n", failures);
+        return 1;
+    }
+    printf("\nTutte le verifiche superate\n");
+    return 0;
+}
@@ -0,0 +1,559 @@
+/*
+ * db_compress_bench: slot del database compresso a blocchi, rapporto di
+ * compressione e velocità di decompressione per dimensione del blocco, con una
+ * directory temporanea come LittleFS
+ *
+ *   db_compress_bench [--count N] [--slot FILE] [--keep]
+ *
+ * --count  Speedcam sintetiche (default: 50000): raggruppate attorno a città e
+ *          lungo strade tra città, type/vmax/art da pochi valori come nei dati
+ *          reali, ordinate per chiave di Hilbert
+ * --slot   Record di uno slot non compresso (make_speedcam_db.py --block-records 0)
+ *          invece di quelli sintetici
+ * --keep   Non cancella la directory temporanea (stampata su stderr)
+ *
+ * Per dimensione del blocco stampa byte dello slot (header, indice e blocchi),
+ * rapporto con e senza la trasposizione per byte, blocchi rimasti non
+ * compressi, decompressione (lz4_block_decompress e trasposizione inversa) in
+ * MB/s di record e microsecondi per blocco, RAM delle due finestre del lettore.
+ * Il compressore è quello di make_speedcam_db.py (stesso algoritmo, stessi byte).
+ * Poi scrive uno slot con blocchi da SPEEDCAM_DB_BLOCK_RECORDS_MAX e lo legge
+ * con SpeedcamDbReader: lettura completa contro lo slot non compresso, ricerca
+ * per blocchi (findBlock/readBlock) di un campione di record, slot con un
+ * blocco alterato, troncato o con byte in coda (rifiutati).
+ * Fallisce (exit 1) se una decompressione non restituisce i record originali o
+ * se un caso del lettore non dà l'esito atteso.
+ */
+
+#include <Arduino.h>
+#include "host_sim.h"
+#include "hal.h"
+#include "speedcam_db.h"
+#include "hilbert_index.h"
+#include "lz4_block.h"
+#include <algorithm>
+#include <unistd.h>
+#include <unordered_map>
+#include <vector>
+
+#define BENCH_ROUNDS 5
+#define BENCH_READ_CHUNK 256
+#define BENCH_LOOKUPS 1000
+
+// Come in make_speedcam_db.py
+#define LZ4_MIN_MATCH 4
+#define LZ4_LAST_LITERALS 5
+#define LZ4_MATCH_LIMIT 12
+#define LZ4_MAX_OFFSET 65535
+
+static const uint32_t block_sizes[] = { 8, 16, 32, 64, 128, 256 };
+
+struct CameraKind {
+    const char* type;
+    char art;
+    uint16_t vmax[4];       // Limiti possibili (0 = sconosciuto)
+    uint32_t weight;        // Su 100
+};
+
+static const CameraKind kinds[] = {
+    { "1",   '1', { 50, 70, 90, 0 },    40 },
+    { "G50", 'G', { 50, 50, 50, 50 },   15 },
+    { "2",   '2', { 90, 110, 130, 0 },  15 },
+    { "A",   'A', { 0, 0, 50, 0 },      12 },
+    { "BK",  'B', { 0, 0, 0, 0 },       10 },
+    { "11",  '1', { 30, 50, 50, 70 },    8 },
+};
+
+struct BlockSizeResult {
+    uint32_t bytes;             // Slot intero
+    uint32_t plain_bytes;       // Senza trasposizione
+    uint32_t blocks;
+    uint32_t stored;            // Blocchi non compressi
+    uint32_t best_cycles;       // Decompressione di tutti i blocchi, miglior giro
+    bool ok;
+};
+
+struct CaseResult {
+    const char* name;
+    bool ok;
+    const char* detail;
+};
+
+static std::string fs_dir;
+
+// Numeri pseudo-casuali deterministici
+static uint32_t random_state = 12345;
+static uint32_t bench_random(uint32_t range) {
+    random_state = random_state * 1103515245UL + 12345UL;
+    return (random_state >> 8) % range;
+}
+
+static float bench_uniform() {
+    return bench_random(65536) / 65536.0f;
+}
+
+static std::vector<Speedcam> make_cameras(uint32_t count) {
+    // Città in un riquadro europeo; un terzo delle speedcam lungo la strada tra due città
+    uint32_t city_count = std::max<uint32_t>(count / 250, 2);
+    std::vector<float> city_lat(city_count);
+    std::vector<float> city_lng(city_count);
+    for (uint32_t i = 0; i < city_count; i++) {
+        city_lat[i] = 36.0f + 24.0f * bench_uniform();
+        city_lng[i] = -9.0f + 37.0f * bench_uniform();
+    }
+
+    std::vector<Speedcam> speedcams(count);
+    uint32_t id = 1;
+    for (Speedcam& sc : speedcams) {
+        sc = Speedcam();
+        id += 1 + bench_random(8);
+        sc.id = id;
+
+        uint32_t city = bench_random(city_count);
+        if (bench_random(3) == 0) {
+            uint32_t other = bench_random(city_count);
+            float t = bench_uniform();
+            sc.lat = city_lat[city] + (city_lat[other] - city_lat[city]) * t;
+            sc.lng = city_lng[city] + (city_lng[other] - city_lng[city]) * t;
+        } else {
+            sc.lat = city_lat[city] + 0.1f * (bench_uniform() + bench_uniform() - 1.0f);
+            sc.lng = city_lng[city] + 0.15f * (bench_uniform() + bench_uniform() - 1.0f);
+        }
+        // Coordinate con 6 decimali come nel JSON
+        sc.lat = roundf(sc.lat * 1e6f) / 1e6f;
+        sc.lng = roundf(sc.lng * 1e6f) / 1e6f;
+
+        uint32_t pick = bench_random(100);
+        const CameraKind* kind = &kinds[0];
+        for (const CameraKind& k : kinds) {
+            kind = &k;
+            if (pick < k.weight) break;
+            pick -= k.weight;
+        }
+        strncpy(sc.type, kind->type, sizeof(sc.type) - 1);
+        sc.art = kind->art;
+        sc.vmax = kind->vmax[bench_random(4)];
+        sc.status = bench_random(20) == 0 ? 'L' : 'A';
+        uint32_t direction = bench_random(10);
+        if (direction >= 6) {
+            sc.direction = direction == 9 ? SPEEDCAM_DIRECTION_BOTH : SPEEDCAM_DIRECTION_ONE;
+            sc.heading = bench_random(256);
+        }
+    }
+    std::stable_sort(speedcams.begin(), speedcams.end(), [](const Speedcam& a, const Speedcam& b) {
+        return hilbert_key(a.lat, a.lng) < hilbert_key(b.lat, b.lng);
+    });
+    return speedcams;
+}
+
+static bool read_slot_file(const char* path, std::vector<Speedcam>& speedcams) {
+    FILE* fp = fopen(path, "rb");
+    if (!fp) return false;
+    SpeedcamDbHeader header;
+    bool ok = fread(&header, sizeof(header), 1, fp) == 1 && header.magic == SPEEDCAM_DB_MAGIC &&
+              header.format == SPEEDCAM_DB_FORMAT && header.record_size == SPEEDCAM_DB_RECORD_SIZE &&
+              header.block_records == 0;
+    if (ok) {
+        speedcams.resize(header.record_count);
+        ok = fread(speedcams.data(), sizeof(Speedcam), speedcams.size(), fp) == speedcams.size() &&
+             speedcam_db_crc32(0, speedcams.data(), speedcams.size() * sizeof(Speedcam)) == header.records_crc;
+    }
+    fclose(fp);
+    return ok;
+}
+
+static void lz4_length(std::vector<uint8_t>& out, uint32_t value) {
+    while (value >= 255) {
+        out.push_back(255);
+        value -= 255;
+    }
+    out.push_back(value);
+}
+
+/**
+ * Una sequenza: token, letterali, offset e lunghezza del match (offset 0: ultima, solo letterali)
+ */
+static void lz4_sequence(std::vector<uint8_t>& out, const uint8_t* literals, uint32_t literal_count,
+                         uint32_t offset, uint32_t length) {
+    uint32_t match = offset ? length - LZ4_MIN_MATCH : 0;
+    out.push_back((std::min<uint32_t>(literal_count, 15) << 4) | std::min<uint32_t>(match, 15));
+    if (literal_count >= 15) lz4_length(out, literal_count - 15);
+    out.insert(out.end(), literals, literals + literal_count);
+    if (offset) {
+        out.push_back(offset & 0xFF);
+        out.push_back(offset >> 8);
+        if (match >= 15) lz4_length(out, match - 15);
+    }
+}
+
+static uint32_t read32(const uint8_t* data) {
+    uint32_t value;
+    memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+/**
+ * Compressione greedy in formato di blocco LZ4, come lz4_compress() di make_speedcam_db.py
+ */
+static std::vector<uint8_t> lz4_compress(const uint8_t* data, uint32_t size) {
+    std::vector<uint8_t> out;
+    std::unordered_map<uint32_t, uint32_t> last;     // Ultima posizione di ogni sequenza di 4 byte
+    uint32_t anchor = 0;
+    uint32_t i = 0;
+    uint32_t match_end = size > LZ4_LAST_LITERALS ? size - LZ4_LAST_LITERALS : 0;
+    while (i + LZ4_MATCH_LIMIT < size) {
+        auto found = last.find(read32(&data[i]));
+        bool has_candidate = found != last.end();
+        uint32_t candidate = has_candidate ? found->second : 0;
+        last[read32(&data[i])] = i;
+        if (!has_candidate || i - candidate > LZ4_MAX_OFFSET) {
+            i++;
+            continue;
+        }
+        uint32_t length = LZ4_MIN_MATCH;
+        while (i + length + 8 <= match_end && memcmp(&data[candidate + length], &data[i + length], 8) == 0) {
+            length += 8;
+        }
+        while (i + length < match_end && data[candidate + length] == data[i + length]) {
+            length++;
+        }
+        lz4_sequence(out, &data[anchor], i - anchor, i - candidate, length);
+        i += length;
+        anchor = i;
+        last[read32(&data[i - 2])] = i - 2;
+    }
+    lz4_sequence(out, &data[anchor], size - anchor, 0, 0);
+    return out;
+}
+
+/**
+ * Indice e blocchi di uno slot compresso (src/speedcam_db.h), dall'offset first_block del file
+ * @param transpose Falso: record compressi così come sono (solo per il confronto)
+ */
+static std::vector<uint8_t> compress_records(const std::vector<Speedcam>& speedcams, uint32_t block_records,
+                                             bool transpose, uint32_t& stored) {
+    uint32_t count = speedcams.size();
+    uint32_t blocks = (count + block_records - 1) / block_records;
+    std::vector<uint8_t> index(blocks * sizeof(SpeedcamDbBlock));
+    std::vector<uint8_t> data;
+    std::vector<uint8_t> shuffled;
+    uint32_t first_block = sizeof(SpeedcamDbHeader) + index.size();
+    stored = 0;
+    for (uint32_t block = 0; block < blocks; block++) {
+        uint32_t first = block * block_records;
+        uint32_t records = std::min(block_records, count - first);
+        const uint8_t* chunk = (const uint8_t*)&speedcams[first];
+        uint32_t raw = records * SPEEDCAM_DB_RECORD_SIZE;
+
+        SpeedcamDbBlock entry;
+        entry.offset = first_block + data.size();
+        entry.first_key = hilbert_key(speedcams[first].lat, speedcams[first].lng);
+        memcpy(&index[block * sizeof(entry)], &entry, sizeof(entry));
+
+        shuffled.resize(raw);
+        for (uint32_t r = 0; r < records; r++) {
+            for (uint32_t j = 0; j < SPEEDCAM_DB_RECORD_SIZE; j++) {
+                shuffled[transpose ? j * records + r : r * SPEEDCAM_DB_RECORD_SIZE + j] =
+                    chunk[r * SPEEDCAM_DB_RECORD_SIZE + j];
+            }
+        }
+        std::vector<uint8_t> compressed = lz4_compress(shuffled.data(), raw);
+        uint16_t size;
+        const std::vector<uint8_t>* body = &compressed;
+        if (compressed.size() < raw) {
+            size = compressed.size();
+        } else {
+            size = raw | SPEEDCAM_DB_BLOCK_STORED;
+            body = &shuffled;
+            stored++;
+        }
+        data.push_back(size & 0xFF);
+        data.push_back(size >> 8);
+        data.insert(data.end(), body->begin(), body->end());
+    }
+    index.insert(index.end(), data.begin(), data.end());
+    return index;
+}
+
+/**
+ * Decompressione di tutti i blocchi come nel lettore (finestra e trasposizione inversa)
+ * @return false se un blocco non è valido
+ */
+static bool decompress_records(const std::vector<uint8_t>& body, uint32_t count, uint32_t block_records,
+                               Speedcam* speedcams) {
+    static uint8_t window[256 * SPEEDCAM_DB_RECORD_SIZE];
+    uint32_t blocks = (count + block_records - 1) / block_records;
+    uint32_t offset = blocks * sizeof(SpeedcamDbBlock);
+    uint8_t* out = (uint8_t*)speedcams;
+    for (uint32_t block = 0; block < blocks; block++) {
+        uint32_t records = std::min(block_records, count - block * block_records);
+        uint32_t raw = records * SPEEDCAM_DB_RECORD_SIZE;
+        if (offset + 2 > body.size()) return false;
+        uint16_t size = body[offset] | (body[offset + 1] << 8);
+        uint32_t stored = size & ~SPEEDCAM_DB_BLOCK_STORED;
+        offset += 2;
+        if (offset + stored > body.size()) return false;
+        if (size & SPEEDCAM_DB_BLOCK_STORED) {
+            if (stored != raw) return false;
+            memcpy(window, &body[offset], raw);
+        } else if (lz4_block_decompress(&body[offset], stored, window, raw) != (int)raw) {
+            return false;
+        }
+        offset += stored;
+        for (uint32_t r = 0; r < records; r++) {
+            for (uint32_t j = 0; j < SPEEDCAM_DB_RECORD_SIZE; j++) {
+                out[j] = window[j * records + r];
+            }
+            out += SPEEDCAM_DB_RECORD_SIZE;
+        }
+    }
+    return offset == body.size();
+}
+
+static BlockSizeResult measure(const std::vector<Speedcam>& speedcams, uint32_t block_records) {
+    BlockSizeResult result;
+    memset(&result, 0, sizeof(result));
+    uint32_t count = speedcams.size();
+    uint32_t plain_stored;
+    std::vector<uint8_t> body = compress_records(speedcams, block_records, true, result.stored);
+    result.bytes = sizeof(SpeedcamDbHeader) + body.size();
+    result.plain_bytes = sizeof(SpeedcamDbHeader) + compress_records(speedcams, block_records, false, plain_stored).size();
+    result.blocks = (count + block_records - 1) / block_records;
+
+    std::vector<Speedcam> decoded(count);
+    result.ok = true;
+    for (int round = 0; round < BENCH_ROUNDS; round++) {
+        uint32_t start = hal_cycles();
+        bool ok = decompress_records(body, count, block_records, decoded.data());
+        uint32_t cycles = hal_cycles() - start;
+        if (round == 0 || cycles < result.best_cycles) result.best_cycles = cycles;
+        result.ok = result.ok && ok;
+    }
+    result.ok = result.ok && memcmp(decoded.data(), speedcams.data(), count * sizeof(Speedcam)) == 0;
+    return result;
+}
+
+static std::vector<uint8_t> make_slot(const std::vector<Speedcam>& speedcams, uint32_t block_records) {
+    SpeedcamDbHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = SPEEDCAM_DB_MAGIC;
+    header.format = SPEEDCAM_DB_FORMAT;
+    header.record_size = SPEEDCAM_DB_RECORD_SIZE;
+    header.version = 1;
+    header.record_count = speedcams.size();
+    header.records_crc = speedcam_db_crc32(0, speedcams.data(), speedcams.size() * sizeof(Speedcam));
+    header.block_records = block_records;
+    header.header_crc = speedcam_db_crc32(0, &header, offsetof(SpeedcamDbHeader, header_crc));
+
+    std::vector<uint8_t> data((const uint8_t*)&header, (const uint8_t*)(&header + 1));
+    if (block_records == 0) {
+        const uint8_t* records = (const uint8_t*)speedcams.data();
+        data.insert(data.end(), records, records + speedcams.size() * sizeof(Speedcam));
+    } else {
+        uint32_t stored;
+        std::vector<uint8_t> body = compress_records(speedcams, block_records, true, stored);
+        data.insert(data.end(), body.begin(), body.end());
+    }
+    return data;
+}
+
+static bool write_file(const char* path, const std::vector<uint8_t>& data) {
+    FILE* fp = fopen((fs_dir + path).c_str(), "wb");
+    if (!fp) return false;
+    bool ok = fwrite(data.data(), 1, data.size(), fp) == data.size();
+    return fclose(fp) == 0 && ok;
+}
+
+/**
+ * Lettura completa come il caricamento: record nell'ordine dello slot e CRC verificato
+ * @return false se la lettura fallisce o i record non sono quelli attesi
+ */
+static bool read_all(SpeedcamDbReader& reader, const std::vector<Speedcam>& expected, uint32_t& cycles) {
+    static Speedcam chunk[BENCH_READ_CHUNK];
+    uint32_t start = hal_cycles();
+    uint32_t position = 0;
+    bool same = true;
+    while (!reader.done()) {
+        int n = reader.read(chunk, BENCH_READ_CHUNK);
+        if (n < 0) return false;
+        for (int i = 0; i < n && same; i++) {
+            same = position + i < expected.size() && memcmp(&chunk[i], &expected[position + i], sizeof(Speedcam)) == 0;
+        }
+        position += n;
+    }
+    cycles = hal_cycles() - start;
+    return same && position == expected.size() && reader.verify();
+}
+
+/**
+ * Ogni record del campione nel blocco indicato da findBlock() (o nei successivi con la stessa chiave)
+ */
+static bool lookup_sample(SpeedcamDbReader& reader, const std::vector<Speedcam>& speedcams, uint32_t& blocks_read) {
+    static Speedcam block[SPEEDCAM_DB_BLOCK_RECORDS_MAX];
+    blocks_read = 0;
+    for (uint32_t s = 0; s < BENCH_LOOKUPS; s++) {
+        const Speedcam& wanted = speedcams[bench_random(speedcams.size())];
+        uint32_t key = hilbert_key(wanted.lat, wanted.lng);
+        int first = reader.findBlock(key);
+        if (first < 0) return false;
+        bool found = false;
+        for (uint32_t b = first; b < reader.blockCount() && !found; b++) {
+            int n = reader.readBlock(b, block);
+            blocks_read++;
+            if (n <= 0) return false;
+            bool after = false;
+            for (int i = 0; i < n; i++) {
+                found = found || block[i].id == wanted.id;
+                after = after || hilbert_key(block[i].lat, block[i].lng) > key;
+            }
+            if (after) break;
+        }
+        if (!found) return false;
+    }
+    return true;
+}
+
+/**
+ * Slot rifiutato: l'apertura o la lettura fallisce prima di un CRC valido
+ */
+static bool rejected(const char* path, const std::vector<Speedcam>& speedcams) {
+    SpeedcamDbReader reader;
+    uint32_t cycles;
+    bool loaded = reader.open(path) && read_all(reader, speedcams, cycles);
+    reader.close();
+    return !loaded;
+}
+
+int main(int argc, char** argv) {
+    uint32_t count = 50000;
+    const char* slot_file = nullptr;
+    bool keep = false;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--count") == 0 && i + 1 < argc) {
+            count = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--slot") == 0 && i + 1 < argc) {
+            slot_file = argv[++i];
+        } else if (strcmp(argv[i], "--keep") == 0) {
+            keep = true;
+        } else {
+            fprintf(stderr, "uso: %s [--count N] [--slot FILE] [--keep]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    std::vector<Speedcam> speedcams;
+    if (slot_file) {
+        if (!read_slot_file(slot_file, speedcams) || speedcams.empty()) {
+            fprintf(stderr, "db_compress_bench: %s non è uno slot non compresso valido\n", slot_file);
+            return 2;
+        }
+    } else if (count < 2) {
+        fprintf(stderr, "db_compress_bench: --count deve essere almeno 2\n");
+        return 2;
+    } else {
+        speedcams = make_cameras(count);
+    }
+    count = speedcams.size();
+
+    char dir_template[] = "/tmp/micronav_compress_XXXXXX";
+    if (!mkdtemp(dir_template)) {
+        fprintf(stderr, "db_compress_bench: directory temporanea non creata\n");
+        return 2;
+    }
+    fs_dir = dir_template;
+    host_fs_set_root(fs_dir.c_str());
+    host_serial_mute(true);
+    if (keep) fprintf(stderr, "db_compress_bench: directory %s\n", fs_dir.c_str());
+
+    uint32_t raw_bytes = sizeof(SpeedcamDbHeader) + count * sizeof(Speedcam);
+    printf("%u speedcam%s, slot non compresso %u byte, finestra del lettore %d record\n", count,
+           slot_file ? "" : " sintetiche", raw_bytes, SPEEDCAM_DB_BLOCK_RECORDS_MAX);
+    printf("%8s %10s %9s %9s %8s %10s %10s %8s  %s\n", "record", "byte", "rapporto", "non tras.", "interi",
+           "MB/s", "us/blocco", "RAM", "");
+
+    int failures = 0;
+    for (uint32_t block_records : block_sizes) {
+        BlockSizeResult result = measure(speedcams, block_records);
+        double us = (double)result.best_cycles / hal_cycles_per_us();
+        const char* note = !result.ok ? "record diversi dopo la decompressione"
+                         : block_records > SPEEDCAM_DB_BLOCK_RECORDS_MAX ? "oltre il massimo del lettore" : "OK";
+        if (!result.ok) failures++;
+        printf("%8u %10u %8.2f:1 %7.2f:1 %8u %10.1f %10.2f %8u  %s\n", block_records, result.bytes,
+               (double)raw_bytes / result.bytes, (double)raw_bytes / result.plain_bytes, result.stored,
+               us > 0.0 ? count * sizeof(Speedcam) / us : 0.0, us / result.blocks,
+               2 * block_records * SPEEDCAM_DB_RECORD_SIZE, note);
+    }
+
+    // Lettore: slot non compresso (A) e compresso (B) con gli stessi record
+    const char* plain_path = speedcam_db_slot_path(0);
+    const char* compressed_path = speedcam_db_slot_path(1);
+    std::vector<uint8_t> compressed = make_slot(speedcams, SPEEDCAM_DB_BLOCK_RECORDS_MAX);
+    if (!write_file(plain_path, make_slot(speedcams, 0)) || !write_file(compressed_path, compressed)) {
+        fprintf(stderr, "db_compress_bench: slot non scritti in %s\n", fs_dir.c_str());
+        return 2;
+    }
+
+    static SpeedcamDbReader reader;
+    CaseResult cases[7];
+    int case_count = 0;
+    uint32_t plain_cycles = 0;
+    uint32_t compressed_cycles = 0;
+    bool ok = reader.open(plain_path) && !reader.isCompressed() && read_all(reader, speedcams, plain_cycles);
+    reader.close();
+    cases[case_count++] = { "non compresso", ok, "lettura completa" };
+
+    ok = reader.open(compressed_path) && reader.isCompressed() && read_all(reader, speedcams, compressed_cycles);
+    cases[case_count++] = { "compresso", ok, "lettura completa" };
+
+    uint32_t blocks_read = 0;
+    ok = reader.isOpen() && lookup_sample(reader, speedcams, blocks_read);
+    cases[case_count++] = { "per blocchi", ok, "campione trovato con findBlock/readBlock" };
+
+    // Dopo l'accesso per blocchi la lettura sequenziale riparte solo da rewind()
+    Speedcam one;
+    ok = reader.isOpen() && reader.read(&one, 1) < 0 && reader.rewind() &&
+         read_all(reader, speedcams, compressed_cycles);
+    reader.close();
+    cases[case_count++] = { "rewind", ok, "lettura completa dopo readBlock" };
+
+    // Un byte alterato a metà del blocco centrale, troncato, un byte in coda
+    uint32_t middle_block = (count - 1) / SPEEDCAM_DB_BLOCK_RECORDS_MAX / 2;
+    SpeedcamDbBlock middle;
+    memcpy(&middle, &compressed[sizeof(SpeedcamDbHeader) + middle_block * sizeof(SpeedcamDbBlock)], sizeof(middle));
+    std::vector<uint8_t> altered = compressed;
+    uint16_t middle_size = altered[middle.offset] | (altered[middle.offset + 1] << 8);
+    altered[middle.offset + 2 + (middle_size & ~SPEEDCAM_DB_BLOCK_STORED) / 2] ^= 0x5A;
+    ok = write_file(compressed_path, altered) && rejected(compressed_path, speedcams);
+    cases[case_count++] = { "blocco alterato", ok, "rifiutato" };
+
+    std::vector<uint8_t> truncated(compressed.begin(), compressed.end() - 7);
+    ok = write_file(compressed_path, truncated) && rejected(compressed_path, speedcams);
+    cases[case_count++] = { "troncato", ok, "rifiutato" };
+
+    std::vector<uint8_t> trailing = compressed;
+    trailing.push_back(0);
+    ok = write_file(compressed_path, trailing) && rejected(compressed_path, speedcams);
+    cases[case_count++] = { "byte in coda", ok, "rifiutato" };
+
+    printf("Lettura completa (SpeedcamDbReader): non compresso %.0f us, compresso %.0f us (blocchi da %d)\n",
+           (double)plain_cycles / hal_cycles_per_us(), (double)compressed_cycles / hal_cycles_per_us(),
+           SPEEDCAM_DB_BLOCK_RECORDS_MAX);
+    printf("Ricerca per blocchi: %d speedcam, %.2f blocchi letti per speedcam\n", BENCH_LOOKUPS,
+           (double)blocks_read / BENCH_LOOKUPS);
+    printf("%-16s %-42s  %s\n", "caso", "atteso", "");
+    for (int i = 0; i < case_count; i++) {
+        printf("%-16s %-42s  %s\n", cases[i].name, cases[i].detail, cases[i].ok ? "OK" : "ERRORE");
+        if (!cases[i].ok) failures++;
+    }
+
+    if (!keep) {
+        remove((fs_dir + plain_path).c_str());
+        remove((fs_dir + compressed_path).c_str());
+        rmdir(fs_dir.c_str());
+    }
+    if (failures) {
+        fprintf(stderr, "%d casi con esito diverso dall'atteso\n", failures);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,487 @@
+/*
+ * db_patch_bench: aggiornamenti settimanali del database con una patch
+ * (SPEEDCAM_DB_PATCH) invece dell'intero slot, con una directory temporanea
+ * come LittleFS
+ *
+ *   db_patch_bench [--count N] [--weeks W] [--keep]
+ *
+ * --count  Speedcam del database di partenza (default: 20000, ordinate per chiave di Hilbert)
+ * --weeks  Settimane simulate (default: 4)
+ * --keep   Non cancella la directory temporanea (stampata su stderr)
+ *
+ * Ogni settimana cambia lo 0.5% dei limiti, sposta lo 0.1% delle speedcam
+ * (chiave di Hilbert diversa: rimossa e reinserita), ne aggiunge lo 0.3% e ne
+ * rimuove lo 0.2%. La patch della settimana è sempre dallo slot A di partenza
+ * (le differenze si accumulano) e viene caricata in background come un
+ * aggiornamento ('U'). Per settimana stampa byte della patch contro lo slot
+ * intero, passi e tempo del caricamento con la patch.
+ * Poi: patch per un'altra base (ignorata), con un record alterato o troncata
+ * (rifiutate e non ritentate, resta la versione attiva), riavvio con la patch
+ * (applicata) e con la patch alterata o troncata (resta lo slot senza patch,
+ * la patch non viene ritentata).
+ * Fallisce (exit 1) se un caso non dà l'esito atteso o se il database caricato
+ * con la patch non ha versione e CRC dei record della settimana.
+ */
+
+#include <Arduino.h>
+#include "host_sim.h"
+#include "hal.h"
+#include "arena.h"
+#include "gps_controller.h"
+#include "speedcam_controller.h"
+#include "display_controller.h"
+#include "speedcam_db.h"
+#include "hilbert_index.h"
+#include <algorithm>
+#include <unistd.h>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#define PATCH_STEP_MS MAIN_LOOP_PERIOD
+#define PATCH_MAX_STEPS 100000
+
+// Cambi per settimana, in millesimi delle speedcam
+#define WEEK_MODIFIED 5
+#define WEEK_MOVED 1
+#define WEEK_INSERTED 3
+#define WEEK_DELETED 2
+
+struct PatchCounts {
+    uint32_t ops;
+    uint32_t copied;
+    uint32_t deleted;
+    uint32_t modified;
+    uint32_t inserted;
+};
+
+struct CaseResult {
+    const char* name;
+    bool ok;
+    uint32_t version;
+    uint32_t patch_bytes;
+    uint32_t steps;
+    uint32_t load_us;
+    uint32_t max_step_us;
+};
+
+static std::string fs_dir;
+
+// Numeri pseudo-casuali deterministici
+static uint32_t random_state = 12345;
+static uint32_t bench_random(uint32_t range) {
+    random_state = random_state * 1103515245UL + 12345UL;
+    return (random_state >> 8) % range;
+}
+
+static Speedcam make_camera(uint32_t id) {
+    Speedcam sc;
+    sc.id = id;
+    sc.lat = 37.0f + bench_random(90000) * 0.0001f;
+    sc.lng = 7.0f + bench_random(110000) * 0.0001f;
+    strcpy(sc.type, "G50");
+    sc.vmax = 50 + 10 * bench_random(9);
+    sc.status = 'A';
+    sc.art = 'G';
+    return sc;
+}
+
+/**
+ * Ordine del compilatore: chiave di Hilbert, a parità l'ordine precedente
+ */
+static void sort_records(std::vector<Speedcam>& speedcams) {
+    std::stable_sort(speedcams.begin(), speedcams.end(), [](const Speedcam& a, const Speedcam& b) {
+        return hilbert_key(a.lat, a.lng) < hilbert_key(b.lat, b.lng);
+    });
+}
+
+/**
+ * Una settimana di cambi sul database corrente
+ */
+static void apply_week(std::vector<Speedcam>& speedcams, uint32_t& next_id) {
+    uint32_t count = speedcams.size();
+    for (uint32_t i = 0; i < count * WEEK_MODIFIED / 1000; i++) {
+        Speedcam& sc = speedcams[bench_random(speedcams.size())];
+        sc.vmax = sc.vmax == 130 ? 90 : sc.vmax + 10;
+    }
+    for (uint32_t i = 0; i < count * WEEK_MOVED / 1000; i++) {
+        Speedcam& sc = speedcams[bench_random(speedcams.size())];
+        sc.lat += 0.002f;
+    }
+    for (uint32_t i = 0; i < count * WEEK_DELETED / 1000; i++) {
+        speedcams.erase(speedcams.begin() + bench_random(speedcams.size()));
+    }
+    for (uint32_t i = 0; i < count * WEEK_INSERTED / 1000; i++) {
+        speedcams.push_back(make_camera(next_id++));
+    }
+    sort_records(speedcams);
+}
+
+static uint32_t records_crc(const std::vector<Speedcam>& speedcams) {
+    return speedcam_db_crc32(0, speedcams.data(), speedcams.size() * sizeof(Speedcam));
+}
+
+static bool write_file(const char* path, const void* data, size_t bytes) {
+    FILE* fp = fopen((fs_dir + path).c_str(), "wb");
+    if (!fp) return false;
+    bool ok = fwrite(data, 1, bytes, fp) == bytes;
+    return fclose(fp) == 0 && ok;
+}
+
+static bool write_slot(uint8_t slot, uint32_t version, const std::vector<Speedcam>& speedcams) {
+    std::vector<uint8_t> data(sizeof(SpeedcamDbHeader) + speedcams.size() * sizeof(Speedcam));
+    SpeedcamDbHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = SPEEDCAM_DB_MAGIC;
+    header.format = SPEEDCAM_DB_FORMAT;
+    header.record_size = SPEEDCAM_DB_RECORD_SIZE;
+    header.version = version;
+    header.record_count = speedcams.size();
+    header.records_crc = records_crc(speedcams);
+    header.header_crc = speedcam_db_crc32(0, &header, offsetof(SpeedcamDbHeader, header_crc));
+    memcpy(data.data(), &header, sizeof(header));
+    memcpy(data.data() + sizeof(header), speedcams.data(), speedcams.size() * sizeof(Speedcam));
+    return write_file(speedcam_db_slot_path(slot), data.data(), data.size());
+}
+
+static void add_op(std::vector<uint8_t>& body, PatchCounts& counts, uint8_t kind, uint32_t arg,
+                   const Speedcam* record) {
+    SpeedcamDbPatchOp op;
+    memset(&op, 0, sizeof(op));
+    op.kind = kind;
+    op.arg = arg;
+    body.insert(body.end(), (const uint8_t*)&op, (const uint8_t*)&op + sizeof(op));
+    if (record) {
+        body.insert(body.end(), (const uint8_t*)record, (const uint8_t*)record + sizeof(Speedcam));
+    }
+    counts.ops++;
+}
+
+/**
+ * Patch da base a target, stesso algoritmo di diff_records() in make_speedcam_db.py
+ */
+static std::vector<uint8_t> make_patch(const std::vector<Speedcam>& base, uint32_t base_version,
+                                       const std::vector<Speedcam>& target, uint32_t version,
+                                       PatchCounts& counts) {
+    memset(&counts, 0, sizeof(counts));
+    std::unordered_map<uint32_t, uint32_t> base_pos;
+    std::unordered_map<uint32_t, uint32_t> target_pos;
+    for (uint32_t i = 0; i < base.size(); i++) base_pos[base[i].id] = i;
+    for (uint32_t j = 0; j < target.size(); j++) target_pos[target[j].id] = j;
+    std::unordered_set<uint32_t> moved;
+
+    std::vector<uint8_t> body;
+    size_t run_offset = 0;      // Op COPY o INSERT in corso, da estendere
+    uint8_t run_kind = 0;
+    auto extend = [&](uint8_t kind, const Speedcam* record) {
+        if (run_kind == kind) {
+            SpeedcamDbPatchOp* op = (SpeedcamDbPatchOp*)&body[run_offset];
+            op->arg++;
+            if (record) body.insert(body.end(), (const uint8_t*)record, (const uint8_t*)record + sizeof(Speedcam));
+            return;
+        }
+        run_offset = body.size();
+        run_kind = kind;
+        add_op(body, counts, kind, 1, record);
+    };
+    auto single = [&](uint8_t kind, uint32_t id, const Speedcam* record) {
+        run_kind = 0;
+        add_op(body, counts, kind, id, record);
+    };
+
+    uint32_t i = 0;
+    uint32_t j = 0;
+    while (i < base.size() || j < target.size()) {
+        if (i < base.size()) {
+            uint32_t id = base[i].id;
+            if (!target_pos.count(id) || moved.count(id)) {
+                single(PATCH_DELETE, id, nullptr);
+                counts.deleted++;
+                i++;
+                continue;
+            }
+        }
+        const Speedcam& record = target[j];
+        if (!base_pos.count(record.id) || moved.count(record.id)) {
+            extend(PATCH_INSERT, &record);
+            counts.inserted++;
+            j++;
+            continue;
+        }
+        if (base[i].id == record.id) {
+            if (memcmp(&base[i], &record, sizeof(Speedcam)) == 0) {
+                extend(PATCH_COPY, nullptr);
+                counts.copied++;
+            } else {
+                single(PATCH_MODIFY, record.id, &record);
+                counts.modified++;
+            }
+            i++;
+            j++;
+            continue;
+        }
+        if (target_pos[base[i].id] - j >= base_pos[record.id] - i) {
+            moved.insert(base[i].id);
+        } else {
+            moved.insert(record.id);
+        }
+    }
+
+    SpeedcamDbPatchHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = SPEEDCAM_DB_PATCH_MAGIC;
+    header.format = SPEEDCAM_DB_PATCH_FORMAT;
+    header.record_size = SPEEDCAM_DB_RECORD_SIZE;
+    header.base_version = base_version;
+    header.base_crc = records_crc(base);
+    header.version = version;
+    header.record_count = target.size();
+    header.records_crc = records_crc(target);
+    header.op_count = counts.ops;
+    header.header_crc = speedcam_db_crc32(0, &header, offsetof(SpeedcamDbPatchHeader, header_crc));
+
+    std::vector<uint8_t> patch(sizeof(header) + body.size());
+    memcpy(patch.data(), &header, sizeof(header));
+    memcpy(patch.data() + sizeof(header), body.data(), body.size());
+    return patch;
+}
+
+static bool write_patch(const std::vector<uint8_t>& patch) {
+    return write_file(SPEEDCAM_DB_PATCH, patch.data(), patch.size());
+}
+
+/**
+ * Controller come nello sketch, su arene vuote (riavvio)
+ */
+struct Device {
+    DisplayController display;
+    GPSController gps;
+    SpeedcamController speedcams;
+
+    bool begin() {
+        for (uint8_t i = 0; i < ARENA_REGION_COUNT; i++) {
+            arena_get((ArenaRegion)i).reset();
+        }
+        if (!display.begin() || !gps.begin() || !speedcams.begin(&gps, &display)) {
+            fprintf(stderr, "db_patch_bench: inizializzazione controller fallita\n");
+            return false;
+        }
+        speedcams.setCheckInterval(0);
+        return true;
+    }
+};
+
+/**
+ * Loop dello sketch durante un aggiornamento: un passo di updateDatabase() per iterazione
+ */
+static void run_update(Device& device, CaseResult& result) {
+    while (device.speedcams.isUpdating() && result.steps < PATCH_MAX_STEPS) {
+        host_clock_advance_us(PATCH_STEP_MS * 1000UL);
+        uint32_t t0 = hal_cycles();
+        device.speedcams.updateDatabase();
+        uint32_t step_us = (hal_cycles() - t0) / hal_cycles_per_us();
+        result.load_us += step_us;
+        if (step_us > result.max_step_us) result.max_step_us = step_us;
+        result.steps++;
+    }
+}
+
+static bool loaded(Device& device, uint32_t version, uint32_t crc) {
+    const SpeedcamLoadStats& load = device.speedcams.getLoadStats();
+    return device.speedcams.getDatabaseSlot() == 0 && load.db_version == version && load.db_crc == crc;
+}
+
+/**
+ * Boot cronometrato (loadDatabaseSlots)
+ */
+static bool boot(Device& device, CaseResult& result) {
+    if (!device.begin()) return false;
+    uint32_t t0 = hal_cycles();
+    bool ok = device.speedcams.loadDatabaseSlots();
+    result.load_us = (hal_cycles() - t0) / hal_cycles_per_us();
+    result.patch_bytes = device.speedcams.getLoadStats().patch_size;
+    result.version = device.speedcams.getLoadStats().db_version;
+    return ok;
+}
+
+int main(int argc, char** argv) {
+    uint32_t count = 20000;
+    uint32_t weeks = 4;
+    bool keep = false;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--count") == 0 && i + 1 < argc) {
+            count = (uint32_t)atol(argv[++i]);
+        } else if (strcmp(argv[i], "--weeks") == 0 && i + 1 < argc) {
+            weeks = (uint32_t)atol(argv[++i]);
+        } else if (strcmp(argv[i], "--keep") == 0) {
+            keep = true;
+        } else {
+            fprintf(stderr, "uso: %s [--count N] [--weeks W] [--keep]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (count < 1000 || weeks < 1 || weeks > 52) {
+        fprintf(stderr, "db_patch_bench: --count almeno 1000, --weeks tra 1 e 52\n");
+        return 2;
+    }
+
+    char dir_template[] = "/tmp/micronav_patch_XXXXXX";
+    if (!mkdtemp(dir_template)) {
+        fprintf(stderr, "db_patch_bench: directory temporanea non creata\n");
+        return 2;
+    }
+    fs_dir = dir_template;
+    host_fs_set_root(fs_dir.c_str());
+    host_clock_use_virtual(true);
+    host_serial_mute(true);
+
+    std::vector<Speedcam> base;
+    for (uint32_t i = 0; i < count; i++) base.push_back(make_camera(1000 + i));
+    sort_records(base);
+    uint32_t next_id = 1000 + count;
+    const uint32_t full_bytes = sizeof(SpeedcamDbHeader) + count * sizeof(Speedcam);
+    if (!write_slot(0, 1, base)) {
+        fprintf(stderr, "db_patch_bench: slot non scritto\n");
+        return 2;
+    }
+
+    std::vector<CaseResult> results;
+    auto add_case = [&](const char* name) -> CaseResult& {
+        CaseResult r = {};
+        r.name = name;
+        results.push_back(r);
+        return results.back();
+    };
+    std::vector<std::string> week_names;
+    for (uint32_t w = 1; w <= weeks; w++) week_names.push_back("settimana " + std::to_string(w));
+    std::vector<PatchCounts> week_counts;
+
+    std::vector<Speedcam> current = base;
+    std::vector<uint8_t> last_patch;
+    std::vector<uint8_t> truncated_patch;
+    uint32_t version = 1;
+    {
+        Device device;
+        CaseResult& r = add_case("boot senza patch");
+        r.ok = boot(device, r) && loaded(device, 1, records_crc(base));
+
+        // 1. Settimane: patch cumulativa dallo slot A, caricata in background
+        for (uint32_t w = 1; w <= weeks; w++) {
+            apply_week(current, next_id);
+            version++;
+            PatchCounts counts;
+            last_patch = make_patch(base, 1, current, version, counts);
+            week_counts.push_back(counts);
+
+            CaseResult& week = add_case(week_names[w - 1].c_str());
+            week.patch_bytes = last_patch.size();
+            bool started = write_patch(last_patch) && device.speedcams.requestDatabaseUpdate();
+            run_update(device, week);
+            week.version = device.speedcams.getLoadStats().db_version;
+            week.ok = started && week.steps < PATCH_MAX_STEPS && loaded(device, version, records_crc(current));
+        }
+
+        // 2. Patch per un'altra versione dello slot: ignorata
+        {
+            CaseResult& c = add_case("patch di un'altra base");
+            PatchCounts counts;
+            std::vector<Speedcam> other = base;
+            other[0].vmax ^= 1;
+            std::vector<uint8_t> patch = make_patch(other, 1, current, version + 1, counts);
+            c.patch_bytes = patch.size();
+            bool started = write_patch(patch) && device.speedcams.requestDatabaseUpdate();
+            c.version = device.speedcams.getLoadStats().db_version;
+            c.ok = !started && c.version == version;
+        }
+
+        // 3. Record della patch alterato: rifiutata al CRC, non ritentata
+        {
+            CaseResult& c = add_case("patch alterata");
+            PatchCounts counts;
+            std::vector<uint8_t> patch = make_patch(base, 1, current, version + 1, counts);
+            patch[patch.size() - sizeof(Speedcam) / 2] ^= 0x40;
+            c.patch_bytes = patch.size();
+            unsigned long rejected = device.speedcams.getStats().db_rejected;
+            bool started = write_patch(patch) && device.speedcams.requestDatabaseUpdate();
+            run_update(device, c);
+            bool retried = device.speedcams.requestDatabaseUpdate();
+            c.version = device.speedcams.getLoadStats().db_version;
+            c.ok = started && !retried && loaded(device, version, records_crc(current)) &&
+                   device.speedcams.getStats().db_rejected == rejected + 1;
+        }
+
+        // 4. Patch troncata: rifiutata (all'apertura o durante la lettura), non ritentata
+        {
+            CaseResult& c = add_case("patch troncata");
+            PatchCounts counts;
+            truncated_patch = make_patch(base, 1, current, version + 2, counts);
+            truncated_patch.resize(sizeof(SpeedcamDbPatchHeader) +
+                                   (truncated_patch.size() - sizeof(SpeedcamDbPatchHeader)) * 3 / 4);
+            c.patch_bytes = truncated_patch.size();
+            write_patch(truncated_patch);
+            if (device.speedcams.requestDatabaseUpdate()) {
+                run_update(device, c);
+            }
+            bool retried = device.speedcams.requestDatabaseUpdate();
+            c.version = device.speedcams.getLoadStats().db_version;
+            c.ok = !retried && loaded(device, version, records_crc(current));
+        }
+    }
+
+    // 5. Riavvio con la patch dell'ultima settimana: applicata al boot
+    {
+        CaseResult& c = add_case("boot con patch");
+        write_patch(last_patch);
+        Device rebooted;
+        c.ok = boot(rebooted, c) && loaded(rebooted, version, records_crc(current));
+    }
+
+    // 6. Riavvio con la patch alterata: resta lo slot senza patch
+    {
+        CaseResult& c = add_case("boot patch alterata");
+        std::vector<uint8_t> patch = last_patch;
+        patch[patch.size() - sizeof(Speedcam) / 2] ^= 0x40;
+        write_patch(patch);
+        Device rebooted;
+        c.ok = boot(rebooted, c) && loaded(rebooted, 1, records_crc(base));
+    }
+
+    // 7. Riavvio con la patch troncata: letta fino al taglio, poi lo slot senza
+    // patch; un aggiornamento ('U') non la ritenta
+    {
+        CaseResult& c = add_case("boot patch troncata");
+        write_patch(truncated_patch);
+        Device rebooted;
+        c.ok = boot(rebooted, c) && loaded(rebooted, 1, records_crc(base)) &&
+               rebooted.speedcams.getStats().db_rejected == 1 && !rebooted.speedcams.requestDatabaseUpdate();
+    }
+
+    printf("Slot di %u speedcam: %u byte; per settimana %d/%d/%d/%d per mille modificate/spostate/nuove/rimosse\n",
+           count, full_bytes, WEEK_MODIFIED, WEEK_MOVED, WEEK_INSERTED, WEEK_DELETED);
+    printf("%-24s %8s %10s %7s %6s %8s %10s %10s  %s\n", "caso", "versione", "patch B", "%slot", "passi",
+           "op", "carico ms", "passo max", "");
+    bool ok = true;
+    for (size_t i = 0; i < results.size(); i++) {
+        const CaseResult& r = results[i];
+        ok = ok && r.ok;
+        bool week = i >= 1 && i <= weeks;
+        printf("%-24s %8u %10u %6.2f%% %6u %8u %9.1f %8u us  %s\n", r.name, r.version, r.patch_bytes,
+               100.0 * r.patch_bytes / full_bytes, r.steps, week ? week_counts[i - 1].ops : 0,
+               r.load_us / 1000.0, r.max_step_us, r.ok ? "OK" : "ERRORE");
+    }
+    for (uint32_t w = 0; w < weeks; w++) {
+        const PatchCounts& counts = week_counts[w];
+        printf("settimana %u: %u nuove, %u rimosse, %u modificate, %u invariate\n", w + 1, counts.inserted,
+               counts.deleted, counts.modified, counts.copied);
+    }
+
+    if (keep) {
+        fprintf(stderr, "File in %s\n", fs_dir.c_str());
+    } else {
+        unlink((fs_dir + speedcam_db_slot_path(0)).c_str());
+        unlink((fs_dir + SPEEDCAM_DB_PATCH).c_str());
+        rmdir(fs_dir.c_str());
+    }
+    fprintf(stderr, "%s Patch del database: %zu casi\n", ok ? "✅" : "❌", results.size());
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,365 @@
+/*
+ * db_update_bench: aggiornamento del database speedcam sugli slot A/B, con una
+ * directory temporanea come LittleFS e corruzioni iniettate nei file
+ *  1. boot con lo slot A valido
+ *  2. versione più recente nello slot B: caricata in background mentre i check
+ *     continuano, poi sostituisce il database attivo
+ *  3. versioni nello slot A con un record alterato, troncate, con l'header
+ *     alterato o alterate tra i due passaggi del caricamento: rifiutate, resta
+ *     il database attivo (e uno slot rifiutato non viene ritentato)
+ *  4. riavvii con lo slot più recente corrotto (torna all'altro) e con entrambi
+ *     non validi (nessuno slot: fallback JSON)
+ * Durante ogni aggiornamento i check alternano la posizione della speedcam di
+ * riferimento (presente in ogni versione) e una posizione senza speedcam.
+ * Fallisce (exit 1) se un caso non dà l'esito atteso o se un check vicino alla
+ * speedcam di riferimento non la rileva.
+ *
+ *   db_update_bench [--count N] [--keep]
+ *
+ * --count  Speedcam dei database generati (default: 3000: oltre il budget, con pre-filtro)
+ * --keep   Non cancella la directory temporanea (stampata su stderr)
+ */
+
+#include <Arduino.h>
+#include "host_sim.h"
+#include "hal.h"
+#include "arena.h"
+#include "gps_controller.h"
+#include "speedcam_controller.h"
+#include "display_controller.h"
+#include "speedcam_db.h"
+#include <unistd.h>
+#include <vector>
+
+// Passo del loop simulato (MAIN_LOOP_PERIOD dello sketch)
+#define DB_STEP_MS MAIN_LOOP_PERIOD
+// Limite di passi di un aggiornamento (evita un ciclo infinito se non termina)
+#define DB_MAX_STEPS 100000
+
+// Speedcam di riferimento (in ogni versione) e posizione senza speedcam nel raggio
+#define DB_REFERENCE_ID 1
+#define DB_REFERENCE_LAT 45.0f
+#define DB_REFERENCE_LNG 10.0f
+#define DB_EMPTY_LAT 44.5
+#define DB_EMPTY_LNG 9.5
+
+enum Corruption {
+    CORRUPT_NONE = 0,
+    CORRUPT_RECORD,       // Un byte di un record alterato dopo il calcolo del CRC
+    CORRUPT_TRUNCATED,    // Metà dei record
+    CORRUPT_HEADER,       // Versione cambiata dopo il calcolo del CRC dell'header
+};
+
+/**
+ * Esito di un caso
+ */
+struct CaseResult {
+    const char* name;
+    bool ok;
+    int slot;
+    uint32_t version;
+    int loaded;
+    uint32_t steps;
+    uint32_t max_step_us;
+    uint32_t checks;
+    uint32_t missed;
+};
+
+static std::string fs_dir;
+
+static std::string slot_file(uint8_t slot) {
+    return fs_dir + speedcam_db_slot_path(slot);
+}
+
+/**
+ * Scrive un database nello slot: la speedcam di riferimento e count speedcam su
+ * una griglia a nord-est (oltre 10 km). La versione cambia il numero di speedcam.
+ */
+static bool write_db(uint8_t slot, uint32_t version, uint32_t count, Corruption corruption) {
+    count += version * 10;
+    std::vector<Speedcam> speedcams(count + 1);
+    speedcams[0].id = DB_REFERENCE_ID;
+    speedcams[0].lat = DB_REFERENCE_LAT;
+    speedcams[0].lng = DB_REFERENCE_LNG;
+    for (uint32_t i = 0; i < count; i++) {
+        Speedcam& sc = speedcams[i + 1];
+        sc = Speedcam();
+        sc.id = 1000 + i;
+        sc.lat = 45.1f + (i / 50) * 0.01f;
+        sc.lng = 10.1f + (i % 50) * 0.01f;
+    }
+    for (Speedcam& sc : speedcams) {
+        strcpy(sc.type, "G50");
+        sc.vmax = 50;
+        sc.status = 'A';
+        sc.art = 'G';
+    }
+
+    size_t bytes = speedcams.size() * sizeof(Speedcam);
+    SpeedcamDbHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = SPEEDCAM_DB_MAGIC;
+    header.format = SPEEDCAM_DB_FORMAT;
+    header.record_size = SPEEDCAM_DB_RECORD_SIZE;
+    header.version = version;
+    header.record_count = speedcams.size();
+    header.records_crc = speedcam_db_crc32(0, speedcams.data(), bytes);
+    header.header_crc = speedcam_db_crc32(0, &header, offsetof(SpeedcamDbHeader, header_crc));
+
+    if (corruption == CORRUPT_RECORD) {
+        ((uint8_t*)speedcams.data())[bytes / 2] ^= 0x40;
+    } else if (corruption == CORRUPT_TRUNCATED) {
+        bytes /= 2;
+    } else if (corruption == CORRUPT_HEADER) {
+        header.version++;
+    }
+
+    FILE* fp = fopen(slot_file(slot).c_str(), "wb");
+    if (!fp) return false;
+    bool ok = fwrite(&header, sizeof(header), 1, fp) == 1 &&
+              fwrite(speedcams.data(), 1, bytes, fp) == bytes;
+    return fclose(fp) == 0 && ok;
+}
+
+/**
+ * Altera un byte dell'ultimo record (file aperto dal caricamento in corso)
+ */
+static bool corrupt_last_record(uint8_t slot) {
+    FILE* fp = fopen(slot_file(slot).c_str(), "r+b");
+    if (!fp) return false;
+    bool ok = fseek(fp, -(long)sizeof(Speedcam), SEEK_END) == 0 && fputc(0x7F, fp) != EOF;
+    return fclose(fp) == 0 && ok;
+}
+
+/**
+ * Controller come nello sketch, su arene vuote (riavvio)
+ */
+struct Device {
+    DisplayController display;
+    GPSController gps;
+    SpeedcamController speedcams;
+
+    bool begin() {
+        for (uint8_t i = 0; i < ARENA_REGION_COUNT; i++) {
+            arena_get((ArenaRegion)i).reset();
+        }
+        if (!display.begin() || !gps.begin() || !speedcams.begin(&gps, &display)) {
+            fprintf(stderr, "db_update_bench: inizializzazione controller fallita\n");
+            return false;
+        }
+        speedcams.setCheckInterval(0);
+        return true;
+    }
+};
+
+/**
+ * Loop dello sketch durante un aggiornamento: check alternati vicino alla
+ * speedcam di riferimento e lontano, poi un passo di updateDatabase()
+ * @param corrupt_after Passo dopo il quale alterare lo slot (0 = mai)
+ */
+static void run_update(Device& device, CaseResult& result, uint8_t slot = 0, uint32_t corrupt_after = 0) {
+    GPSPosition near_position;
+    near_position.latitude = DB_REFERENCE_LAT;
+    near_position.longitude = DB_REFERENCE_LNG;
+    near_position.is_valid = true;
+    GPSPosition far_position = near_position;
+    far_position.latitude = DB_EMPTY_LAT;
+    far_position.longitude = DB_EMPTY_LNG;
+
+    while (device.speedcams.isUpdating() && result.steps < DB_MAX_STEPS) {
+        host_clock_advance_us(DB_STEP_MS * 1000UL);
+        bool near = (result.steps % 2) == 0;
+        const Speedcam* detected = device.speedcams.checkSpeedcams(near ? &near_position : &far_position);
+        result.checks++;
+        if (near && (!detected || detected->id != DB_REFERENCE_ID)) {
+            result.missed++;
+        }
+
+        uint32_t t0 = hal_cycles();
+        device.speedcams.updateDatabase();
+        uint32_t step_us = (hal_cycles() - t0) / hal_cycles_per_us();
+        if (step_us > result.max_step_us) result.max_step_us = step_us;
+        result.steps++;
+
+        if (corrupt_after > 0 && result.steps == corrupt_after) {
+            corrupt_last_record(slot);
+        }
+    }
+}
+
+static void finish_case(Device& device, CaseResult& result, bool expected) {
+    result.slot = device.speedcams.getDatabaseSlot();
+    result.version = device.speedcams.getLoadStats().db_version;
+    result.loaded = device.speedcams.getSpeedcamCount();
+    result.ok = expected && result.missed == 0 && result.steps < DB_MAX_STEPS;
+}
+
+static void write_case(const CaseResult& r, bool last) {
+    printf("    {\"case\": \"%s\", \"ok\": %s, \"slot\": %d, \"version\": %u, \"loaded\": %d, "
+           "\"steps\": %u, \"max_step_us\": %u, \"checks\": %u, \"missed\": %u}%s\n",
+           r.name, r.ok ? "true" : "false", r.slot, r.version, r.loaded,
+           r.steps, r.max_step_us, r.checks, r.missed, last ? "" : ",");
+}
+
+int main(int argc, char** argv) {
+    uint32_t count = 3000;
+    bool keep = false;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--count") == 0 && i + 1 < argc) {
+            count = (uint32_t)atol(argv[++i]);
+        } else if (strcmp(argv[i], "--keep") == 0) {
+            keep = true;
+        } else {
+            fprintf(stderr, "uso: %s [--count N] [--keep]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    char dir_template[] = "/tmp/micronav_db_XXXXXX";
+    if (!mkdtemp(dir_template)) {
+        fprintf(stderr, "db_update_bench: directory temporanea non creata\n");
+        return 2;
+    }
+    fs_dir = dir_template;
+    host_fs_set_root(fs_dir.c_str());
+    host_clock_use_virtual(true);
+    host_serial_mute(true);
+
+    std::vector<CaseResult> results;
+    auto add_case = [&](const char* name) -> CaseResult& {
+        CaseResult r = {};
+        r.name = name;
+        r.slot = -1;
+        results.push_back(r);
+        return results.back();
+    };
+
+    // Il dispositivo si spegne prima dei riavvii: gli oggetti nelle arene vengono distrutti una volta
+    {
+        Device device;
+        if (!device.begin() || !write_db(0, 1, count, CORRUPT_NONE)) {
+            return 2;
+        }
+
+        // 1. Boot dallo slot A
+        {
+            CaseResult& r = add_case("boot_slot_a");
+            bool loaded = device.speedcams.loadDatabaseSlots();
+            finish_case(device, r, loaded && device.speedcams.getDatabaseSlot() == 0 &&
+                                   device.speedcams.getLoadStats().db_version == 1);
+        }
+
+        // 2. Versione 2 nello slot B, scambio in background
+        {
+            CaseResult& r = add_case("update_slot_b");
+            write_db(1, 2, count, CORRUPT_NONE);
+            bool started = device.speedcams.requestDatabaseUpdate();
+            run_update(device, r);
+            finish_case(device, r, started && device.speedcams.getDatabaseSlot() == 1 &&
+                                   device.speedcams.getLoadStats().db_version == 2 &&
+                                   device.speedcams.getStats().db_swaps == 1);
+        }
+
+        // 3. Record alterato: rifiutato dopo il primo passaggio, non ritentato
+        {
+            CaseResult& r = add_case("corrupt_record");
+            write_db(0, 3, count, CORRUPT_RECORD);
+            unsigned long rejected = device.speedcams.getStats().db_rejected;
+            bool started = device.speedcams.requestDatabaseUpdate();
+            run_update(device, r);
+            bool retried = device.speedcams.requestDatabaseUpdate();
+            finish_case(device, r, started && !retried && device.speedcams.getDatabaseSlot() == 1 &&
+                                   device.speedcams.getLoadStats().db_version == 2 &&
+                                   device.speedcams.getStats().db_rejected == rejected + 1);
+        }
+
+        // 4. File troncato e header alterato: lo slot non viene neanche caricato
+        {
+            CaseResult& r = add_case("truncated");
+            write_db(0, 4, count, CORRUPT_TRUNCATED);
+            bool started = device.speedcams.requestDatabaseUpdate();
+            finish_case(device, r, !started && device.speedcams.getLoadStats().db_version == 2);
+        }
+        {
+            CaseResult& r = add_case("corrupt_header");
+            write_db(0, 5, count, CORRUPT_HEADER);
+            bool started = device.speedcams.requestDatabaseUpdate();
+            finish_case(device, r, !started && device.speedcams.getLoadStats().db_version == 2);
+        }
+
+        // 5. File alterato dopo la verifica del primo passaggio: rifiutato dal secondo
+        {
+            CaseResult& r = add_case("corrupt_between_passes");
+            write_db(0, 6, count, CORRUPT_NONE);
+            SpeedcamDbHeader header;
+            SpeedcamDbReader::readHeader(SPEEDCAM_DB_SLOT_A, header);
+            uint32_t count_steps = (header.record_count + SPEEDCAM_DB_LOAD_CHUNK - 1) / SPEEDCAM_DB_LOAD_CHUNK;
+            bool started = device.speedcams.requestDatabaseUpdate();
+            run_update(device, r, 0, count_steps);
+            finish_case(device, r, started && r.steps > count_steps &&
+                                   device.speedcams.getLoadStats().db_version == 2);
+        }
+
+        // 6. Nuova versione valida nello stesso slot dopo i rifiuti
+        {
+            CaseResult& r = add_case("update_slot_a");
+            write_db(0, 7, count, CORRUPT_NONE);
+            bool started = device.speedcams.requestDatabaseUpdate();
+            run_update(device, r);
+            finish_case(device, r, started && device.speedcams.getDatabaseSlot() == 0 &&
+                                   device.speedcams.getLoadStats().db_version == 7);
+        }
+    }
+
+    // 7. Riavvio con lo slot più recente corrotto: si torna all'altro
+    {
+        CaseResult& r = add_case("reboot_rollback");
+        write_db(0, 8, count, CORRUPT_RECORD);
+        Device rebooted;
+        bool loaded = rebooted.begin() && rebooted.speedcams.loadDatabaseSlots();
+        finish_case(rebooted, r, loaded && rebooted.speedcams.getDatabaseSlot() == 1 &&
+                                 rebooted.speedcams.getLoadStats().db_version == 2);
+    }
+
+    // 8. Riavvio senza slot validi: loadDatabaseSlots fallisce (lo sketch usa il JSON)
+    {
+        CaseResult& r = add_case("reboot_no_slot");
+        write_db(0, 9, count, CORRUPT_TRUNCATED);
+        write_db(1, 10, count, CORRUPT_HEADER);
+        Device rebooted;
+        bool loaded = rebooted.begin() && rebooted.speedcams.loadDatabaseSlots();
+        finish_case(rebooted, r, !loaded && rebooted.speedcams.getSpeedcamCount() == 0);
+    }
+
+    bool ok = true;
+    for (const CaseResult& r : results) ok = ok && r.ok;
+
+    printf("{\n");
+    printf("  \"count\": %u,\n", count);
+    printf("  \"load_chunk\": %d,\n", SPEEDCAM_DB_LOAD_CHUNK);
+    printf("  \"cases\": [\n");
+    for (size_t i = 0; i < results.size(); i++) {
+        write_case(results[i], i + 1 == results.size());
+    }
+    printf("  ],\n");
+    printf("  \"ok\": %s\n", ok ? "true" : "false");
+    printf("}\n");
+
+    for (const CaseResult& r : results) {
+        if (!r.ok) {
+            fprintf(stderr, "❌ %s: slot %d versione %u, %u check mancati\n",
+                    r.name, r.slot, r.version, r.missed);
+        }
+    }
+
+    if (keep) {
+        fprintf(stderr, "Slot in %s\n", fs_dir.c_str());
+    } else {
+        unlink(slot_file(0).c_str());
+        unlink(slot_file(1).c_str());
+        rmdir(fs_dir.c_str());
+    }
+    fprintf(stderr, "%s Aggiornamenti database: %zu casi\n", ok ? "✅" : "❌", results.size());
+    return ok ? 0 : 1;
+}
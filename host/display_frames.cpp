@@ -0,0 +1,272 @@
+/*
+ * display_frames: esegue le schermate di DisplayController sul display host
+ * e stampa per ogni frame i byte SPI (esatti dal bus simulato e stimati dal
+ * controller), i pixel scartati dal clipping circolare e l'hash del framebuffer.
+ *
+ *   display_frames [--ppm DIR] [--reference FILE] [--write-reference] [--verbose]
+ *
+ * --ppm              Salva un'immagine PPM del framebuffer dopo ogni frame
+ * --reference        Hash di riferimento per frame (default: host/display_frames.ref)
+ * --write-reference  Riscrive il riferimento con i frame correnti (dopo un
+ *                    cambio voluto del rendering, controllando i PPM)
+ *
+ * Schermate: boot logo, alert in avvicinamento (rounded rect, anello, arco),
+ * bordo dell'avviso di velocità con lampeggio, timeout, pannello Tutor e
+ * anteprima della prossima speedcam.
+ * Fallisce (exit 1) se un frame ha un hash diverso dal riferimento o se il
+ * numero di frame cambia: rasterizzazione di span, testo o clipping modificata.
+ */
+
+#include <Arduino.h>
+#include "host_sim.h"
+#include "display_controller.h"
+#include "speedcam.h"
+#include "section_control.h"
+#include "overspeed.h"
+#include <vector>
+
+#ifndef DISPLAY_FRAMES_REFERENCE
+#define DISPLAY_FRAMES_REFERENCE "host/display_frames.ref"
+#endif
+
+static DisplayController* display_controller = nullptr;
+static const char* ppm_dir = nullptr;
+static unsigned long frames_seen = 0;
+static Adafruit_GC9A01A::BusStats bus_before;
+static DisplayController::Stats stats_before;
+
+// Frame riportati: numero e hash, nell'ordine
+struct FrameHash {
+    unsigned long frame;
+    uint32_t hash;
+};
+static std::vector<FrameHash> frame_hashes;
+
+static void printHeader() {
+    printf("%-6s %-9s %-24s %10s %10s %8s %10s %10s\n",
+           "frame", "t_ms", "evento", "spi_bytes", "stimati", "finestre", "scartati", "hash");
+}
+
+/**
+ * FNV-1a a 32 bit del framebuffer
+ */
+static uint32_t hashFramebuffer(const Adafruit_GC9A01A* tft) {
+    const uint16_t* fb = tft->framebuffer();
+    uint32_t hash = 2166136261UL;
+    for (int32_t i = 0; i < (int32_t)DISPLAY_WIDTH * DISPLAY_HEIGHT; i++) {
+        hash = (hash ^ (fb[i] & 0xFF)) * 16777619UL;
+        hash = (hash ^ (fb[i] >> 8)) * 16777619UL;
+    }
+    return hash;
+}
+
+/**
+ * Stampa i frame completati dall'ultima chiamata
+ */
+static void reportFrames(const char* event) {
+    DisplayController::Stats stats = display_controller->getStats();
+    if (stats.frames == frames_seen) return;
+    frames_seen = stats.frames;
+
+    Adafruit_GC9A01A* tft = Adafruit_GC9A01A::instance();
+    Adafruit_GC9A01A::BusStats bus = tft->getBusStats();
+    uint32_t hash = hashFramebuffer(tft);
+    frame_hashes.push_back({ stats.frames, hash });
+
+    printf("%-6lu %-9lu %-24s %10lu %10lu %8lu %10lu   %08x\n",
+           stats.frames, millis(), event,
+           bus.bytes - bus_before.bytes,
+           stats.spi_bytes - stats_before.spi_bytes,
+           bus.windows - bus_before.windows,
+           stats.last_frame_skipped_pixels, hash);
+
+    if (ppm_dir) {
+        char path[256];
+        snprintf(path, sizeof(path), "%s/frame_%03lu.ppm", ppm_dir, stats.frames);
+        tft->savePPM(path);
+    }
+
+    bus_before = bus;
+    stats_before = stats;
+}
+
+/**
+ * Avanza il clock virtuale chiamando update() ogni 10ms
+ */
+static void run(unsigned long duration_ms, const char* event) {
+    for (unsigned long t = 0; t < duration_ms; t += 10) {
+        host_clock_advance_us(10000);
+        display_controller->update();
+        reportFrames(event);
+    }
+}
+
+/**
+ * Riferimento: una riga per frame riportato, "frame hash" (hash in esadecimale, # commenti)
+ */
+static bool readReference(const char* path, std::vector<FrameHash>& hashes) {
+    FILE* fp = fopen(path, "r");
+    if (!fp) return false;
+    char line[128];
+    while (fgets(line, sizeof(line), fp)) {
+        FrameHash entry;
+        unsigned int hash;
+        if (line[0] == '#' || sscanf(line, "%lu %x", &entry.frame, &hash) != 2) continue;
+        entry.hash = hash;
+        hashes.push_back(entry);
+    }
+    fclose(fp);
+    return true;
+}
+
+static bool writeReference(const char* path) {
+    FILE* fp = fopen(path, "w");
+    if (!fp) return false;
+    fprintf(fp, "# Hash FNV-1a del framebuffer per frame (display_frames --write-reference)\n");
+    for (const FrameHash& entry : frame_hashes) {
+        fprintf(fp, "%lu %08x\n", entry.frame, entry.hash);
+    }
+    return fclose(fp) == 0;
+}
+
+int main(int argc, char** argv) {
+    bool verbose = false;
+    const char* reference_path = DISPLAY_FRAMES_REFERENCE;
+    bool write_reference = false;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--ppm") == 0 && i + 1 < argc) {
+            ppm_dir = argv[++i];
+        } else if (strcmp(argv[i], "--reference") == 0 && i + 1 < argc) {
+            reference_path = argv[++i];
+        } else if (strcmp(argv[i], "--write-reference") == 0) {
+            write_reference = true;
+        } else if (strcmp(argv[i], "--verbose") == 0) {
+            verbose = true;
+        } else {
+            fprintf(stderr, "uso: %s [--ppm DIR] [--reference FILE] [--write-reference] [--verbose]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    host_clock_use_virtual(true);
+    host_serial_mute(!verbose);
+
+    display_controller = new DisplayController();
+    if (!display_controller->begin()) {
+        fprintf(stderr, "display_frames: begin() fallito\n");
+        return 1;
+    }
+
+    Adafruit_GC9A01A* tft = Adafruit_GC9A01A::instance();
+    bus_before = tft->getBusStats();
+    stats_before = display_controller->getStats();
+    frames_seen = stats_before.frames;
+
+    printHeader();
+
+    // Boot: fade, info GPS e permanenza logo
+    display_controller->showBootLogo(BOOT_LOGO_DISPLAY_TIME);
+    reportFrames("boot logo");
+    run(BOOT_LOGO_FADE_DURATION + BOOT_LOGO_DISPLAY_TIME + 100, "boot logo");
+
+    display_controller->updateGPSIndicator(true, 7);
+    reportFrames("fix GPS");
+
+    // Alert: disegno completo, poi aggiornamenti incrementali in avvicinamento
+    Speedcam speedcam;
+    speedcam.id = 1;
+    speedcam.lat = 45.0f;
+    speedcam.lng = 9.0f;
+    strcpy(speedcam.type, "G50");
+    speedcam.vmax = 50;
+    speedcam.status = 'A';
+
+    for (int distance = 950; distance >= 50; distance -= 100) {
+        display_controller->showSpeedcamAlert(speedcam, (float)distance);
+        reportFrames(distance == 950 ? "alert" : "alert update");
+        run(1000, "alert");
+    }
+
+    // Avviso di velocità: bordo colorato, poi lampeggio
+    display_controller->setOverspeedLevel(OVERSPEED_OVER);
+    reportFrames("velocità oltre");
+    display_controller->setOverspeedLevel(OVERSPEED_BRAKE);
+    reportFrames("frenata");
+    run(1000, "frenata");
+
+    // Timeout alert e ritorno al logo
+    run(15000, "timeout alert");
+
+    // Tutor: pannello completo, poi solo le righe cambiate
+    SectionStatus section;
+    memset(&section, 0, sizeof(section));
+    section.active = true;
+    section.section.start_id = 7;
+    section.section.vmax_kmh = 110;
+    section.average_kmh = 104.0f;
+    section.projected_kmh = 106.0f;
+    section.margin_kmh = 4.0f;
+    section.allowed_kmh = 118.0f;
+    section.remaining_m = 5400.0f;
+    display_controller->showSectionStatus(section);
+    reportFrames("tutor");
+    section.average_kmh = 112.0f;
+    section.projected_kmh = 114.0f;
+    section.margin_kmh = -4.0f;
+    section.allowed_kmh = 96.0f;
+    section.remaining_m = 3100.0f;
+    display_controller->showSectionStatus(section);
+    reportFrames("tutor update");
+    display_controller->hideSectionStatus();
+    reportFrames("fine tutor");
+    run(BOOT_LOGO_FADE_DURATION + 100, "fine tutor");
+
+    // Anteprima della prossima speedcam sulla schermata idle
+    display_controller->showNextSpeedcam(speedcam, 1840.0f);
+    reportFrames("anteprima");
+    display_controller->showNextSpeedcam(speedcam, 620.0f);
+    reportFrames("anteprima update");
+
+    DisplayController::Stats stats = display_controller->getStats();
+    Adafruit_GC9A01A::BusStats bus = tft->getBusStats();
+    printf("\nTotale: %lu frame, %lu byte SPI (stimati %lu), %lu finestre, %lu pixel scartati\n",
+           stats.frames, bus.bytes, stats.spi_bytes, bus.windows, stats.clip_skipped_pixels);
+    delete display_controller;
+
+    if (write_reference) {
+        if (!writeReference(reference_path)) {
+            fprintf(stderr, "display_frames: %s non scritto\n", reference_path);
+            return 1;
+        }
+        printf("Riferimento %s: %zu frame\n", reference_path, frame_hashes.size());
+        return 0;
+    }
+
+    std::vector<FrameHash> reference;
+    if (!readReference(reference_path, reference)) {
+        fprintf(stderr, "display_frames: riferimento %s non leggibile\n", reference_path);
+        return 1;
+    }
+    int mismatches = 0;
+    for (size_t i = 0; i < frame_hashes.size() && i < reference.size(); i++) {
+        const FrameHash& got = frame_hashes[i];
+        const FrameHash& want = reference[i];
+        if (got.frame != want.frame || got.hash != want.hash) {
+            if (mismatches < 5) {
+                fprintf(stderr, "display_frames: frame %lu hash %08x, atteso frame %lu hash %08x\n", got.frame,
+                        got.hash, want.frame, want.hash);
+            }
+            mismatches++;
+        }
+    }
+    if (frame_hashes.size() != reference.size()) {
+        fprintf(stderr, "display_frames: %zu frame, attesi %zu\n", frame_hashes.size(), reference.size());
+        return 1;
+    }
+    if (mismatches) {
+        fprintf(stderr, "display_frames: %d frame diversi dal riferimento %s\n", mismatches, reference_path);
+        return 1;
+    }
+    printf("Riferimento: %zu frame identici\n", reference.size());
+    return 0;
+}
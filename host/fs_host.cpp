@@ -0,0 +1,195 @@
+#include "FS.h"
+#include "LittleFS.h"
+#include "host_sim.h"
+#include <sys/stat.h>
+#include <unistd.h>
+
+fs::LittleFSFS LittleFS;
+
+static std::string fs_root = "data";
+
+void host_fs_set_root(const char* dir) {
+    fs_root = dir ? dir : ".";
+}
+
+const char* host_fs_root() {
+    return fs_root.c_str();
+}
+
+namespace fs {
+
+// Handle condiviso tra copie di File, chiuso all'ultima copia o con close()
+struct File::Handle {
+    FILE* fp;
+    int refs;
+};
+
+File::File(FILE* fp, const char* path) : handle(nullptr), file_size(0), file_path(path) {
+    if (!fp) return;
+    handle = new Handle{ fp, 1 };
+    struct stat st;
+    if (fstat(fileno(fp), &st) == 0) {
+        file_size = (size_t)st.st_size;
+    }
+}
+
+File::File(const File& other) : handle(other.handle), file_size(other.file_size), file_path(other.file_path) {
+    if (handle) handle->refs++;
+}
+
+File& File::operator=(const File& other) {
+    if (this != &other) {
+        if (other.handle) other.handle->refs++;
+        release();
+        handle = other.handle;
+        file_size = other.file_size;
+        file_path = other.file_path;
+    }
+    return *this;
+}
+
+File::~File() {
+    release();
+}
+
+void File::release() {
+    if (!handle) return;
+    if (--handle->refs == 0) {
+        if (handle->fp) fclose(handle->fp);
+        delete handle;
+    }
+    handle = nullptr;
+}
+
+File::operator bool() const {
+    return handle && handle->fp;
+}
+
+int File::available() {
+    if (!handle || !handle->fp) return 0;
+    long pos = ftell(handle->fp);
+    return pos < 0 ? 0 : (int)(file_size - (size_t)pos);
+}
+
+int File::read() {
+    if (!handle || !handle->fp) return -1;
+    int c = fgetc(handle->fp);
+    return c == EOF ? -1 : c;
+}
+
+int File::peek() {
+    if (!handle || !handle->fp) return -1;
+    int c = fgetc(handle->fp);
+    if (c != EOF) ungetc(c, handle->fp);
+    return c == EOF ? -1 : c;
+}
+
+size_t File::read(uint8_t* buffer, size_t size) {
+    if (!handle || !handle->fp) return 0;
+    return fread(buffer, 1, size, handle->fp);
+}
+
+size_t File::write(uint8_t c) {
+    return write(&c, 1);
+}
+
+size_t File::write(const uint8_t* buffer, size_t size) {
+    if (!handle || !handle->fp) return 0;
+    size_t written = fwrite(buffer, 1, size, handle->fp);
+    long pos = ftell(handle->fp);
+    if (pos > 0 && (size_t)pos > file_size) file_size = (size_t)pos;
+    return written;
+}
+
+void File::flush() {
+    if (handle && handle->fp) fflush(handle->fp);
+}
+
+bool File::seek(uint32_t pos) {
+    return handle && handle->fp && fseek(handle->fp, pos, SEEK_SET) == 0;
+}
+
+size_t File::position() const {
+    if (!handle || !handle->fp) return 0;
+    long pos = ftell(handle->fp);
+    return pos < 0 ? 0 : (size_t)pos;
+}
+
+size_t File::size() const {
+    return file_size;
+}
+
+void File::close() {
+    if (!handle) return;
+    if (handle->fp) {
+        fclose(handle->fp);
+        handle->fp = nullptr;
+    }
+    release();
+}
+
+const char* File::name() const {
+    size_t slash = file_path.rfind('/');
+    return slash == std::string::npos ? file_path.c_str() : file_path.c_str() + slash + 1;
+}
+
+std::string FS::resolve(const char* path) const {
+    std::string full = fs_root;
+    if (!path || path[0] != '/') full += '/';
+    if (path) full += path;
+    return full;
+}
+
+File FS::open(const char* path, const char* mode, bool create) {
+    (void)create;
+    // Modalità Arduino ("r", "w", "a") su file binari
+    std::string fmode = mode ? mode : "r";
+    if (fmode.find('b') == std::string::npos) fmode += 'b';
+    FILE* fp = fopen(resolve(path).c_str(), fmode.c_str());
+    return File(fp, path);
+}
+
+bool FS::exists(const char* path) {
+    struct stat st;
+    return stat(resolve(path).c_str(), &st) == 0;
+}
+
+bool FS::remove(const char* path) {
+    return ::remove(resolve(path).c_str()) == 0;
+}
+
+bool FS::rename(const char* path_from, const char* path_to) {
+    return ::rename(resolve(path_from).c_str(), resolve(path_to).c_str()) == 0;
+}
+
+bool FS::mkdir(const char* path) {
+    return ::mkdir(resolve(path).c_str(), 0755) == 0;
+}
+
+bool LittleFSFS::begin(bool format_on_fail, const char* base_path,
+                       uint8_t max_open_files, const char* partition_label) {
+    (void)base_path; (void)max_open_files; (void)partition_label;
+    struct stat st;
+    if (stat(fs_root.c_str(), &st) == 0 && S_ISDIR(st.st_mode)) {
+        return true;
+    }
+    // "Formattazione": crea la directory radice
+    return format_on_fail && ::mkdir(fs_root.c_str(), 0755) == 0;
+}
+
+void LittleFSFS::end() {
+}
+
+bool LittleFSFS::format() {
+    return false;
+}
+
+size_t LittleFSFS::totalBytes() {
+    return 0x160000;
+}
+
+size_t LittleFSFS::usedBytes() {
+    return 0;
+}
+
+} // namespace fs
@@ -0,0 +1,219 @@
+#include "Adafruit_GFX.h"
+#include "Adafruit_GC9A01A.h"
+
+// Byte di comando per finestra: CASET + 4 byte, RASET + 4 byte, RAMWR
+#define HOST_WINDOW_COMMAND_BYTES 11
+
+static Adafruit_GC9A01A* last_display = nullptr;
+
+// ---- Adafruit_GFX ----
+
+Adafruit_GFX::Adafruit_GFX(int16_t w, int16_t h) :
+    _width(w),
+    _height(h),
+    cursor_x(0),
+    cursor_y(0),
+    textcolor(0xFFFF),
+    textbgcolor(0xFFFF),
+    textsize(1),
+    rotation(0) {
+}
+
+void Adafruit_GFX::writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    for (int16_t j = y; j < y + h; j++) {
+        for (int16_t i = x; i < x + w; i++) {
+            writePixel(i, j, color);
+        }
+    }
+}
+
+void Adafruit_GFX::writeFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+    writeFillRect(x, y, w, 1, color);
+}
+
+void Adafruit_GFX::writeFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+    writeFillRect(x, y, 1, h, color);
+}
+
+void Adafruit_GFX::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    startWrite();
+    writeFillRect(x, y, w, h, color);
+    endWrite();
+}
+
+void Adafruit_GFX::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+    startWrite();
+    writeFastHLine(x, y, w, color);
+    endWrite();
+}
+
+void Adafruit_GFX::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+    startWrite();
+    writeFastVLine(x, y, h, color);
+    endWrite();
+}
+
+void Adafruit_GFX::drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    startWrite();
+    writeFastHLine(x, y, w, color);
+    writeFastHLine(x, y + h - 1, w, color);
+    writeFastVLine(x, y, h, color);
+    writeFastVLine(x + w - 1, y, h, color);
+    endWrite();
+}
+
+void Adafruit_GFX::getTextBounds(const char* str, int16_t x, int16_t y,
+                                 int16_t* x1, int16_t* y1, uint16_t* w, uint16_t* h) {
+    *x1 = x;
+    *y1 = y;
+    *w = (uint16_t)(strlen(str) * 6 * textsize);
+    *h = (uint16_t)(8 * textsize);
+}
+
+size_t Adafruit_GFX::write(uint8_t c) {
+    if (c == '\n') {
+        cursor_x = 0;
+        cursor_y += 8 * textsize;
+        return 1;
+    }
+    if (c == '\r') return 1;
+
+    // Come drawChar di GFX: un rettangolo textsize x textsize per ogni cella 6x8
+    // (i glifi non sono riprodotti, il costo sul bus sì)
+    startWrite();
+    for (int8_t i = 0; i < 6; i++) {
+        for (int8_t j = 0; j < 8; j++) {
+            uint16_t color = (i < 5 && ((i + j + c) & 1)) ? textcolor : textbgcolor;
+            if (textsize == 1) {
+                writePixel(cursor_x + i, cursor_y + j, color);
+            } else {
+                writeFillRect(cursor_x + i * textsize, cursor_y + j * textsize, textsize, textsize, color);
+            }
+        }
+    }
+    endWrite();
+    cursor_x += 6 * textsize;
+    return 1;
+}
+
+// ---- Adafruit_GC9A01A ----
+
+Adafruit_GC9A01A::Adafruit_GC9A01A(int8_t cs, int8_t dc, int8_t rst) :
+    Adafruit_GFX(GC9A01A_TFTWIDTH, GC9A01A_TFTHEIGHT),
+    win_x(0), win_y(0), win_w(0), win_h(0), win_pos(0) {
+    (void)cs; (void)dc; (void)rst;
+    fb = new uint16_t[GC9A01A_TFTWIDTH * GC9A01A_TFTHEIGHT]();
+    resetBusStats();
+    last_display = this;
+}
+
+Adafruit_GC9A01A::Adafruit_GC9A01A(int8_t cs, int8_t dc, int8_t mosi, int8_t sclk, int8_t rst, int8_t miso) :
+    Adafruit_GC9A01A(cs, dc, rst) {
+    (void)mosi; (void)sclk; (void)miso;
+}
+
+Adafruit_GC9A01A::~Adafruit_GC9A01A() {
+    delete[] fb;
+    if (last_display == this) last_display = nullptr;
+}
+
+Adafruit_GC9A01A* Adafruit_GC9A01A::instance() {
+    return last_display;
+}
+
+void Adafruit_GC9A01A::begin(uint32_t freq) {
+    (void)freq;
+}
+
+void Adafruit_GC9A01A::resetBusStats() {
+    bus.bytes = 0;
+    bus.windows = 0;
+    bus.pixels = 0;
+}
+
+void Adafruit_GC9A01A::openWindow(int16_t x, int16_t y, int16_t w, int16_t h) {
+    win_x = x;
+    win_y = y;
+    win_w = w;
+    win_h = h;
+    win_pos = 0;
+    bus.bytes += HOST_WINDOW_COMMAND_BYTES;
+    bus.windows++;
+}
+
+void Adafruit_GC9A01A::pushColor(uint16_t color) {
+    bus.bytes += 2;
+    bus.pixels++;
+    if (win_w <= 0 || win_h <= 0) return;
+
+    // Il controller scrive riga per riga dentro la finestra e ricomincia alla fine
+    int16_t x = win_x + (int16_t)(win_pos % win_w);
+    int16_t y = win_y + (int16_t)((win_pos / win_w) % win_h);
+    win_pos++;
+    if (x >= 0 && x < _width && y >= 0 && y < _height) {
+        fb[y * _width + x] = color;
+    }
+}
+
+void Adafruit_GC9A01A::setAddrWindow(uint16_t x, uint16_t y, uint16_t w, uint16_t h) {
+    openWindow(x, y, w, h);
+}
+
+void Adafruit_GC9A01A::writePixels(uint16_t* colors, uint32_t len, bool block, bool big_endian) {
+    (void)block;
+    for (uint32_t i = 0; i < len; i++) {
+        uint16_t color = colors[i];
+        if (big_endian) color = (uint16_t)((color >> 8) | (color << 8));
+        pushColor(color);
+    }
+}
+
+void Adafruit_GC9A01A::writeColor(uint16_t color, uint32_t len) {
+    for (uint32_t i = 0; i < len; i++) {
+        pushColor(color);
+    }
+}
+
+void Adafruit_GC9A01A::drawPixel(int16_t x, int16_t y, uint16_t color) {
+    startWrite();
+    writePixel(x, y, color);
+    endWrite();
+}
+
+void Adafruit_GC9A01A::writePixel(int16_t x, int16_t y, uint16_t color) {
+    if (x < 0 || x >= _width || y < 0 || y >= _height) return;
+    openWindow(x, y, 1, 1);
+    pushColor(color);
+}
+
+void Adafruit_GC9A01A::writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    // Clipping allo schermo come Adafruit_SPITFT
+    if (w < 0) { x += w + 1; w = -w; }
+    if (h < 0) { y += h + 1; h = -h; }
+    if (x < 0) { w += x; x = 0; }
+    if (y < 0) { h += y; y = 0; }
+    if (x + w > _width) w = _width - x;
+    if (y + h > _height) h = _height - y;
+    if (w <= 0 || h <= 0) return;
+
+    openWindow(x, y, w, h);
+    writeColor(color, (uint32_t)w * h);
+}
+
+bool Adafruit_GC9A01A::savePPM(const char* path) const {
+    FILE* fp = fopen(path, "wb");
+    if (!fp) return false;
+
+    fprintf(fp, "P6\n%d %d\n255\n", _width, _height);
+    for (int32_t i = 0; i < (int32_t)_width * _height; i++) {
+        uint16_t c = fb[i];
+        uint8_t rgb[3] = {
+            (uint8_t)(((c >> 11) & 0x1F) * 255 / 31),
+            (uint8_t)(((c >> 5) & 0x3F) * 255 / 63),
+            (uint8_t)((c & 0x1F) * 255 / 31)
+        };
+        fwrite(rgb, 1, 3, fp);
+    }
+    fclose(fp);
+    return true;
+}
@@ -0,0 +1,87 @@
+#include "hal.h"
+#include "host_sim.h"
+#include <time.h>
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+// Heap "virtuale" del target: la build host non ha un limite, si misura l'uso
+// a partire dall'avvio e lo si sottrae alla RAM dell'ESP32-C3
+#define HOST_HEAP_SIZE (320 * 1024)
+
+uint32_t hal_cycles() {
+    // Cicli equivalenti a 160 MHz sul clock CPU del processo (indipendente dal clock virtuale)
+    struct timespec ts;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    uint64_t ns = (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+    return (uint32_t)(ns * 160 / 1000);
+}
+
+uint32_t hal_cycles_per_us() {
+    return 160;
+}
+
+// Conteggio chiamate heap: malloc & co. sostituite (glibc lo consente) e inoltrate all'allocatore di libc
+static uint32_t heap_calls = 0;
+
+#ifdef __GLIBC__
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* ptr, size_t size);
+void __libc_free(void* ptr);
+
+void* malloc(size_t size) noexcept {
+    heap_calls++;
+    return __libc_malloc(size);
+}
+
+void* calloc(size_t count, size_t size) noexcept {
+    heap_calls++;
+    return __libc_calloc(count, size);
+}
+
+void* realloc(void* ptr, size_t size) noexcept {
+    heap_calls++;
+    return __libc_realloc(ptr, size);
+}
+
+void free(void* ptr) noexcept {
+    if (ptr) heap_calls++;
+    __libc_free(ptr);
+}
+}
+#endif
+
+uint32_t host_heap_calls() {
+    return heap_calls;
+}
+
+static size_t heap_in_use() {
+    #ifdef __GLIBC__
+    struct mallinfo2 info = mallinfo2();
+    return info.uordblks;
+    #else
+    return 0;
+    #endif
+}
+
+static size_t heap_baseline = heap_in_use();
+static size_t heap_peak = 0;
+
+uint32_t hal_free_heap() {
+    size_t used = heap_in_use();
+    used = used > heap_baseline ? used - heap_baseline : 0;
+    if (used > heap_peak) heap_peak = used;
+    return used >= HOST_HEAP_SIZE ? 0 : (uint32_t)(HOST_HEAP_SIZE - used);
+}
+
+uint32_t hal_min_free_heap() {
+    hal_free_heap();
+    return heap_peak >= HOST_HEAP_SIZE ? 0 : (uint32_t)(HOST_HEAP_SIZE - heap_peak);
+}
+
+uint32_t hal_stack_free_min() {
+    // Lo stack del processo host non ha relazione con quello del loopTask
+    return 0;
+}
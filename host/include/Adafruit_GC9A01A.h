@@ -0,0 +1,71 @@
+#ifndef HOST_ADAFRUIT_GC9A01A_H
+#define HOST_ADAFRUIT_GC9A01A_H
+
+#include "Adafruit_GFX.h"
+#include "SPI.h"
+
+#define GC9A01A_TFTWIDTH 240
+#define GC9A01A_TFTHEIGHT 240
+
+/**
+ * GC9A01A simulato su framebuffer RGB565
+ * Conta i byte SPI esatti come il driver reale: ogni finestra indirizzo
+ * costa CASET (1+4) + RASET (1+4) + RAMWR (1) byte, ogni pixel 2 byte
+ */
+class Adafruit_GC9A01A : public Adafruit_GFX {
+public:
+    Adafruit_GC9A01A(int8_t cs, int8_t dc, int8_t rst = -1);
+    Adafruit_GC9A01A(int8_t cs, int8_t dc, int8_t mosi, int8_t sclk, int8_t rst = -1, int8_t miso = -1);
+    ~Adafruit_GC9A01A();
+
+    void begin(uint32_t freq = 0);
+
+    void drawPixel(int16_t x, int16_t y, uint16_t color) override;
+    void writePixel(int16_t x, int16_t y, uint16_t color) override;
+    void writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) override;
+    void setAddrWindow(uint16_t x, uint16_t y, uint16_t w, uint16_t h);
+    void writePixels(uint16_t* colors, uint32_t len, bool block = true, bool big_endian = false);
+    void writeColor(uint16_t color, uint32_t len);
+
+    /**
+     * Contatori bus (solo host)
+     */
+    struct BusStats {
+        unsigned long bytes;       // Byte SPI totali (comandi + dati)
+        unsigned long windows;     // Finestre indirizzo aperte
+        unsigned long pixels;      // Pixel scritti
+    };
+    BusStats getBusStats() const { return bus; }
+    void resetBusStats();
+
+    /**
+     * Framebuffer (solo host), DISPLAY_WIDTH x DISPLAY_HEIGHT RGB565
+     */
+    const uint16_t* framebuffer() const { return fb; }
+
+    /**
+     * Salva il framebuffer come immagine PPM (solo host)
+     */
+    bool savePPM(const char* path) const;
+
+    /**
+     * Ultimo display creato (per ispezione dagli harness host)
+     */
+    static Adafruit_GC9A01A* instance();
+
+private:
+    uint16_t* fb;
+    BusStats bus;
+
+    // Finestra corrente e cursore di scrittura (come RAMWR del controller)
+    int16_t win_x;
+    int16_t win_y;
+    int16_t win_w;
+    int16_t win_h;
+    uint32_t win_pos;
+
+    void openWindow(int16_t x, int16_t y, int16_t w, int16_t h);
+    void pushColor(uint16_t color);
+};
+
+#endif // HOST_ADAFRUIT_GC9A01A_H
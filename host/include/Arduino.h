@@ -0,0 +1,172 @@
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+/**
+ * Arduino.h per build host (POSIX)
+ * Sottoinsieme dell'API Arduino-ESP32 usato dai sorgenti in src/:
+ * tipi, macro PROGMEM, tempo, pin (no-op), Print/Stream, String e seriali
+ * Il comportamento simulato (clock virtuale, dati seriali, root filesystem)
+ * si controlla da host_sim.h
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+#ifndef ARDUINO
+#define ARDUINO 10819
+#endif
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+// Memoria programma: su host è normale memoria
+#define PROGMEM
+#define PGM_P const char*
+#define pgm_read_byte(addr) (*(const uint8_t*)(addr))
+#define pgm_read_word(addr) (*(const uint16_t*)(addr))
+#define pgm_read_dword(addr) (*(const uint32_t*)(addr))
+#define pgm_read_float(addr) (*(const float*)(addr))
+#define pgm_read_ptr(addr) (*(void* const*)(addr))
+#define memcpy_P memcpy
+#define strlen_P strlen
+#define strcmp_P strcmp
+#define strncmp_P strncmp
+
+#define HIGH 0x1
+#define LOW 0x0
+#define INPUT 0x01
+#define OUTPUT 0x03
+#define INPUT_PULLUP 0x05
+
+#define DEC 10
+#define HEX 16
+#define BIN 2
+
+#define PI 3.1415926535897932384626433832795
+#define HALF_PI 1.5707963267948966192313216916398
+#define TWO_PI 6.283185307179586476925286766559
+#define DEG_TO_RAD 0.017453292519943295769236907684886
+#define RAD_TO_DEG 57.295779513082320876798154814105
+
+#define radians(deg) ((deg) * DEG_TO_RAD)
+#define degrees(rad) ((rad) * RAD_TO_DEG)
+#define sq(x) ((x) * (x))
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+using std::min;
+using std::max;
+using std::abs;
+using std::isnan;
+using std::isinf;
+
+// Tempo (clock reale o virtuale, vedi host_sim.h)
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+void yield();
+
+// Pin: no-op (lo stato viene solo memorizzato)
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int digitalRead(uint8_t pin);
+
+long random(long max_value);
+long random(long min_value, long max_value);
+void randomSeed(unsigned long seed);
+
+class String;
+
+/**
+ * Print: come Arduino, i numeri sono stampati in testo
+ */
+class Print {
+public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t* buffer, size_t size);
+    size_t write(const char* str) { return str ? write((const uint8_t*)str, strlen(str)) : 0; }
+    size_t write(const char* buffer, size_t size) { return write((const uint8_t*)buffer, size); }
+    virtual void flush() {}
+
+    size_t print(const char* str) { return write(str); }
+    size_t print(const String& str);
+    size_t print(char c) { return write((uint8_t)c); }
+    size_t print(unsigned char value, int base = DEC) { return print((unsigned long)value, base); }
+    size_t print(int value, int base = DEC) { return print((long)value, base); }
+    size_t print(unsigned int value, int base = DEC) { return print((unsigned long)value, base); }
+    size_t print(long value, int base = DEC);
+    size_t print(unsigned long value, int base = DEC);
+    size_t print(long long value, int base = DEC);
+    size_t print(unsigned long long value, int base = DEC);
+    size_t print(double value, int digits = 2);
+
+    size_t println() { return write("\n"); }
+    size_t println(const char* str) { return print(str) + println(); }
+    size_t println(const String& str) { return print(str) + println(); }
+    size_t println(char c) { return print(c) + println(); }
+    size_t println(unsigned char value, int base = DEC) { return print(value, base) + println(); }
+    size_t println(int value, int base = DEC) { return print(value, base) + println(); }
+    size_t println(unsigned int value, int base = DEC) { return print(value, base) + println(); }
+    size_t println(long value, int base = DEC) { return print(value, base) + println(); }
+    size_t println(unsigned long value, int base = DEC) { return print(value, base) + println(); }
+    size_t println(long long value, int base = DEC) { return print(value, base) + println(); }
+    size_t println(unsigned long long value, int base = DEC) { return print(value, base) + println(); }
+    size_t println(double value, int digits = 2) { return print(value, digits) + println(); }
+};
+
+/**
+ * Stream: sorgente di byte con lettura non bloccante
+ */
+class Stream : public Print {
+public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+    size_t readBytes(char* buffer, size_t length);
+    size_t readBytes(uint8_t* buffer, size_t length) { return readBytes((char*)buffer, length); }
+};
+
+/**
+ * String minimale (su std::string)
+ */
+class String {
+public:
+    String(const char* str = "") : value(str ? str : "") {}
+    String(const std::string& str) : value(str) {}
+    String(char c) : value(1, c) {}
+    String(int number) : value(std::to_string(number)) {}
+    String(unsigned long number) : value(std::to_string(number)) {}
+
+    const char* c_str() const { return value.c_str(); }
+    unsigned int length() const { return (unsigned int)value.size(); }
+    bool reserve(unsigned int size) { value.reserve(size); return true; }
+    bool concat(char c) { value += c; return true; }
+    bool concat(const char* str) { value += str; return true; }
+    bool concat(const char* str, unsigned int length) { value.append(str, length); return true; }
+    bool concat(const String& str) { value += str.value; return true; }
+    char charAt(unsigned int index) const { return index < value.size() ? value[index] : 0; }
+    char operator[](unsigned int index) const { return charAt(index); }
+    String& operator+=(char c) { value += c; return *this; }
+    String& operator+=(const char* str) { value += str; return *this; }
+    String& operator+=(const String& str) { value += str.value; return *this; }
+    bool operator==(const char* str) const { return value == str; }
+    bool operator==(const String& str) const { return value == str.value; }
+    bool endsWith(const String& suffix) const;
+    bool startsWith(const String& prefix) const { return value.compare(0, prefix.value.size(), prefix.value) == 0; }
+    int indexOf(char c) const;
+
+private:
+    std::string value;
+};
+
+#include "HardwareSerial.h"
+
+#endif // HOST_ARDUINO_H
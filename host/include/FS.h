@@ -0,0 +1,66 @@
+#ifndef HOST_FS_H
+#define HOST_FS_H
+
+#include "Arduino.h"
+
+namespace fs {
+
+/**
+ * File su filesystem POSIX (stessa interfaccia di fs::File di Arduino-ESP32)
+ */
+class File : public Stream {
+public:
+    File() : handle(nullptr), file_size(0) {}
+    File(FILE* fp, const char* path);
+    File(const File& other);
+    File& operator=(const File& other);
+    ~File();
+
+    int available() override;
+    int read() override;
+    int peek() override;
+    size_t read(uint8_t* buffer, size_t size);
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t* buffer, size_t size) override;
+    using Print::write;
+    void flush() override;
+
+    bool seek(uint32_t pos);
+    size_t position() const;
+    size_t size() const;
+    void close();
+    const char* path() const { return file_path.c_str(); }
+    const char* name() const;
+
+    operator bool() const;
+
+private:
+    // Condiviso tra le copie (come il File Arduino, che è un handle)
+    struct Handle;
+    Handle* handle;
+    void release();
+    size_t file_size;
+    std::string file_path;
+};
+
+/**
+ * Filesystem con radice in una directory del PC (vedi host_fs_set_root)
+ */
+class FS {
+public:
+    File open(const char* path, const char* mode = "r", bool create = false);
+    bool exists(const char* path);
+    bool remove(const char* path);
+    bool rename(const char* path_from, const char* path_to);
+    bool mkdir(const char* path);
+
+protected:
+    std::string resolve(const char* path) const;
+};
+
+} // namespace fs
+
+using fs::File;
+using fs::FS;
+
+#endif // HOST_FS_H
@@ -0,0 +1,43 @@
+#ifndef HOST_HARDWARE_SERIAL_H
+#define HOST_HARDWARE_SERIAL_H
+
+#include "Arduino.h"
+
+#define SERIAL_8N1 0x800001c
+
+// Numero di UART simulate (0 = console, 1..2 = periferiche)
+#define HOST_SERIAL_PORTS 3
+// Buffer RX per UART (byte oltre la capacità persi, come un overflow del driver)
+#define HOST_SERIAL_RX_BUFFER 16384
+
+/**
+ * UART simulata
+ * Porta 0 (Serial) scrive su stdout (silenziabile da host_sim.h),
+ * le altre ricevono i byte iniettati con host_serial_feed()
+ */
+class HardwareSerial : public Stream {
+public:
+    explicit HardwareSerial(int uart_nr);
+
+    void begin(unsigned long baud, uint32_t config = SERIAL_8N1,
+               int8_t rx_pin = -1, int8_t tx_pin = -1, bool invert = false,
+               unsigned long timeout_ms = 20000UL, uint8_t rx_threshold = 112);
+    void end();
+
+    int available() override;
+    int read() override;
+    int peek() override;
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t* buffer, size_t size) override;
+    using Print::write;
+    void flush() override;
+
+    operator bool() const { return true; }
+
+private:
+    int uart_nr;
+};
+
+extern HardwareSerial Serial;
+
+#endif // HOST_HARDWARE_SERIAL_H
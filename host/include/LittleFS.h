@@ -0,0 +1,25 @@
+#ifndef HOST_LITTLEFS_H
+#define HOST_LITTLEFS_H
+
+#include "FS.h"
+
+namespace fs {
+
+/**
+ * LittleFS simulato: montaggio sempre riuscito se la directory radice esiste
+ */
+class LittleFSFS : public FS {
+public:
+    bool begin(bool format_on_fail = false, const char* base_path = "/littlefs",
+               uint8_t max_open_files = 10, const char* partition_label = "spiffs");
+    void end();
+    bool format();
+    size_t totalBytes();
+    size_t usedBytes();
+};
+
+} // namespace fs
+
+extern fs::LittleFSFS LittleFS;
+
+#endif // HOST_LITTLEFS_H
@@ -0,0 +1,40 @@
+#ifndef HOST_PREFERENCES_H
+#define HOST_PREFERENCES_H
+
+#include "Arduino.h"
+
+/**
+ * Preferences (NVS) simulato: chiavi in una tabella statica a dimensione fissa
+ * (HOST_NVS_ENTRIES voci da HOST_NVS_VALUE_MAX byte), nessuna allocazione.
+ * Con host_nvs_set_path() il contenuto sopravvive tra esecuzioni (riavvii).
+ */
+#define HOST_NVS_ENTRIES 16
+#define HOST_NVS_KEY_MAX 16        // Come NVS: nomi fino a 15 caratteri
+#define HOST_NVS_VALUE_MAX 1024
+
+class Preferences {
+public:
+    Preferences();
+    ~Preferences();
+
+    bool begin(const char* name, bool read_only = false, const char* partition_label = nullptr);
+    void end();
+
+    bool clear();
+    bool remove(const char* key);
+    bool isKey(const char* key);
+
+    size_t putBytes(const char* key, const void* value, size_t length);
+    size_t getBytesLength(const char* key);
+    size_t getBytes(const char* key, void* buffer, size_t max_length);
+
+    size_t putUInt(const char* key, uint32_t value);
+    uint32_t getUInt(const char* key, uint32_t default_value = 0);
+
+private:
+    char name_space[HOST_NVS_KEY_MAX];
+    bool opened;
+    bool read_only;
+};
+
+#endif // HOST_PREFERENCES_H
@@ -0,0 +1,15 @@
+#ifndef HOST_SPI_H
+#define HOST_SPI_H
+
+#include "Arduino.h"
+
+// Bus SPI simulato: il display host conta i byte a livello di comando
+class SPIClass {
+public:
+    void begin(int8_t /* sck */ = -1, int8_t /* miso */ = -1, int8_t /* mosi */ = -1, int8_t /* ss */ = -1) {}
+    void end() {}
+};
+
+extern SPIClass SPI;
+
+#endif // HOST_SPI_H
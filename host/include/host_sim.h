@@ -0,0 +1,58 @@
+#ifndef HOST_SIM_H
+#define HOST_SIM_H
+
+#include "Arduino.h"
+
+/**
+ * Controlli della simulazione host (non esistono sul firmware)
+ * Usati dagli harness in host/ per pilotare tempo, seriali e filesystem
+ */
+
+/**
+ * Clock virtuale: millis()/micros() avanzano solo con delay() o host_clock_advance_us()
+ * Con clock reale (default) il tempo è CLOCK_MONOTONIC dall'avvio del processo
+ */
+void host_clock_use_virtual(bool enabled);
+void host_clock_advance_us(uint64_t us);
+uint64_t host_clock_now_us();
+
+/**
+ * Inietta byte nella coda RX di una UART (es. frasi NMEA sulla UART del GPS)
+ */
+void host_serial_feed(int uart_nr, const char* data, size_t length);
+size_t host_serial_pending(int uart_nr);
+
+/**
+ * Silenzia l'output della console (Serial), utile nei benchmark
+ */
+void host_serial_mute(bool muted);
+
+/**
+ * Collega la console (Serial) a uno pseudo-terminale: l'output va sul pty invece
+ * che su stdout e i byte scritti dal client sul pty arrivano a Serial.read()
+ * (es. metrics_cli.py --port /dev/pts/N). Solo POSIX con pty Unix98.
+ * @return Percorso del lato slave da aprire nel client, nullptr se errore
+ */
+const char* host_console_open_pty();
+
+/**
+ * Chiamate a malloc/calloc/realloc/free (comprese new/delete) dall'avvio del
+ * processo, per verificare che il loop non usi l'heap (0 se non glibc)
+ */
+uint32_t host_heap_calls();
+
+/**
+ * NVS simulato (Preferences): in memoria, oppure persistito su un file del PC
+ * per conservare lo stato tra esecuzioni (nullptr = solo memoria, svuotato)
+ */
+void host_nvs_set_path(const char* path);
+void host_nvs_erase();
+uint32_t host_nvs_writes();
+
+/**
+ * Directory del PC usata come radice di LittleFS (default: "data")
+ */
+void host_fs_set_root(const char* dir);
+const char* host_fs_root();
+
+#endif // HOST_SIM_H
@@ -0,0 +1,156 @@
+/*
+ * log_bench: costo del ciclo di rilevazione speedcam con il log a diversi livelli
+ *
+ *   log_bench [--cameras N] [--passes N]
+ *
+ * Lo stesso ciclo (host/log_bench_loop.cpp) è compilato con LOG_LEVEL_SPEEDCAM
+ * NONE, INFO, DEBUG e VERBOSE; VERBOSE è misurato sia differito (record nel
+ * ring buffer, log_flush() fuori dalla misura) sia immediato (formattazione
+ * nel ciclo). "legacy" riproduce il vecchio controllo runtime DEBUG_ENABLED
+ * con millis() per ogni speedcam.
+ */
+
+#include <Arduino.h>
+#include "host_sim.h"
+#include "hal.h"
+#include "log.h"
+#include "utils.h"
+#include "speedcam.h"
+
+typedef const Speedcam* (*DetectLoop)(const Speedcam*, int, double, double, float);
+
+const Speedcam* detect_loop_none(const Speedcam*, int, double, double, float);
+const Speedcam* detect_loop_info(const Speedcam*, int, double, double, float);
+const Speedcam* detect_loop_debug(const Speedcam*, int, double, double, float);
+const Speedcam* detect_loop_verbose(const Speedcam*, int, double, double, float);
+
+// Posizione del test: stessa zona di data/fake_gps.json
+#define BENCH_LAT 43.66
+#define BENCH_LNG 13.15
+#define BENCH_RADIUS 1000.0f
+#define BENCH_ROUNDS 5
+
+/**
+ * Ciclo con il controllo runtime precedente (if DEBUG_ENABLED + millis() per speedcam)
+ */
+static const Speedcam* detect_loop_legacy(const Speedcam* speedcams, int speedcam_count,
+                                          double lat, double lng, float radius) {
+    const Speedcam* closest_speedcam = nullptr;
+    float closest_distance = radius + 1.0;
+    const bool debug_enabled = true;
+    
+    for (int i = 0; i < speedcam_count; i++) {
+        const Speedcam& sc = speedcams[i];
+        if (!is_valid_float(sc.lat) || !is_valid_float(sc.lng)) {
+            continue;
+        }
+        float distance = calculate_distance(lat, lng, sc.lat, sc.lng);
+        if (debug_enabled) {
+            if (distance < 2000.0) {
+                static unsigned long last_near_debug = 0;
+                if (millis() - last_near_debug > 2000) {
+                    Serial.print("[Speedcam] Speedcam vicina - ID: ");
+                    Serial.print(sc.id);
+                    Serial.print(", Distanza: ");
+                    Serial.print((int)distance);
+                    Serial.print("m, Tipo: ");
+                    Serial.println(sc.type);
+                    last_near_debug = millis();
+                }
+            }
+        }
+        if (distance <= radius && distance < closest_distance) {
+            closest_distance = distance;
+            closest_speedcam = &sc;
+        }
+    }
+    return closest_speedcam;
+}
+
+struct BenchCase {
+    const char* name;
+    DetectLoop loop;
+    bool deferred;
+};
+
+int main(int argc, char** argv) {
+    int camera_count = SPEEDCAM_RAM_BUDGET / sizeof(Speedcam);
+    int passes = 200;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--cameras") == 0 && i + 1 < argc) {
+            camera_count = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--passes") == 0 && i + 1 < argc) {
+            passes = atoi(argv[++i]);
+        } else {
+            fprintf(stderr, "uso: %s [--cameras N] [--passes N]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (camera_count < 1 || passes < 1) return 2;
+    
+    // Il testo dei log non interessa: conta solo il costo nel ciclo
+    host_serial_mute(true);
+    log_begin(&Serial);
+    
+    // Speedcam distribuite in ±0.15° (~±16km): circa l'1.5% entro 2km (righe VERBOSE)
+    Speedcam* speedcams = new Speedcam[camera_count];
+    uint32_t seed = 12345;
+    for (int i = 0; i < camera_count; i++) {
+        seed = seed * 1103515245 + 12345;
+        float dx = (((seed >> 8) % 10000) / 10000.0f - 0.5f) * 0.3f;
+        seed = seed * 1103515245 + 12345;
+        float dy = (((seed >> 8) % 10000) / 10000.0f - 0.5f) * 0.3f;
+        speedcams[i].id = 1000 + i;
+        speedcams[i].lat = BENCH_LAT + dy;
+        speedcams[i].lng = BENCH_LNG + dx;
+        strcpy(speedcams[i].type, "G50");
+        speedcams[i].vmax = 50;
+    }
+    
+    const BenchCase cases[] = {
+        { "NONE", detect_loop_none, true },
+        { "INFO", detect_loop_info, true },
+        { "DEBUG", detect_loop_debug, true },
+        { "VERBOSE differito", detect_loop_verbose, true },
+        { "VERBOSE immediato", detect_loop_verbose, false },
+        { "legacy DEBUG_ENABLED", detect_loop_legacy, true },
+    };
+    
+    printf("Ciclo detectSpeedcam: %d speedcam, %d passate\n", camera_count, passes);
+    printf("%-22s %12s %12s %10s %10s\n", "livello", "us/passata", "ns/speedcam", "record", "persi");
+    
+    const size_t case_count = sizeof(cases) / sizeof(cases[0]);
+    uint32_t best[case_count];
+    LogStats case_stats[case_count];
+    
+    // Casi alternati per BENCH_ROUNDS giri, si tiene il giro migliore (il primo fa da riscaldamento)
+    for (int round = 0; round < BENCH_ROUNDS; round++) {
+        for (size_t k = 0; k < case_count; k++) {
+            log_set_deferred(cases[k].deferred);
+            log_reset_stats();
+            
+            uint32_t cycles = 0;
+            for (int p = 0; p < passes; p++) {
+                // Posizione leggermente diversa a ogni passata (come un veicolo in movimento)
+                double lat = BENCH_LAT + p * 0.00001;
+                uint32_t start = hal_cycles();
+                cases[k].loop(speedcams, camera_count, lat, BENCH_LNG, BENCH_RADIUS);
+                cycles += hal_cycles() - start;
+                log_flush();
+            }
+            if (round == 0 || cycles < best[k]) best[k] = cycles;
+            case_stats[k] = log_get_stats();
+        }
+    }
+    
+    for (size_t k = 0; k < case_count; k++) {
+        const BenchCase& c = cases[k];
+        const LogStats& stats = case_stats[k];
+        double us_per_pass = (double)best[k] / hal_cycles_per_us() / passes;
+        printf("%-22s %12.1f %12.1f %10lu %10lu\n", c.name, us_per_pass,
+               us_per_pass * 1000.0 / camera_count, stats.records, stats.dropped);
+    }
+    
+    delete[] speedcams;
+    return 0;
+}
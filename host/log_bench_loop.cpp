@@ -0,0 +1,37 @@
+/*
+ * Ciclo di rilevazione di SpeedcamController::detectSpeedcam con le stesse
+ * chiamate di log, compilato una volta per livello (vedi CMakeLists.txt):
+ * LOG_LEVEL_SPEEDCAM e LOG_BENCH_FUNCTION arrivano dalla riga di comando.
+ */
+
+#include "log.h"
+#include "utils.h"
+#include "speedcam.h"
+
+const Speedcam* LOG_BENCH_FUNCTION(const Speedcam* speedcams, int speedcam_count,
+                                   double lat, double lng, float radius) {
+    const Speedcam* closest_speedcam = nullptr;
+    float closest_distance = radius + 1.0;
+    
+    LOG_D(SPEEDCAM, "Check posizione: %.6f, %.6f | Database: %d speedcam | Raggio: %.0fm",
+          lat, lng, speedcam_count, radius);
+    
+    for (int i = 0; i < speedcam_count; i++) {
+        const Speedcam& sc = speedcams[i];
+        if (!is_valid_float(sc.lat) || !is_valid_float(sc.lng)) {
+            continue;
+        }
+        
+        float distance = calculate_distance(lat, lng, sc.lat, sc.lng);
+        
+        if (distance < 2000.0) {
+            LOG_V(SPEEDCAM, "Speedcam vicina - ID: %u, Distanza: %dm, Tipo: %s", sc.id, (int)distance, sc.type);
+        }
+        
+        if (distance <= radius && distance < closest_distance) {
+            closest_distance = distance;
+            closest_speedcam = &sc;
+        }
+    }
+    return closest_speedcam;
+}
@@ -0,0 +1,475 @@
+/*
+ * lookahead_bench: speedcam ravvicinate su una strada rettilinea nord-sud,
+ * con una directory temporanea come LittleFS e fix a 1 Hz sul clock virtuale
+ *
+ *   lookahead_bench [--speed KMH] [--verbose]
+ *
+ * Tre speedcam a 150 m e 100 m l'una dall'altra, una quarta più avanti e una
+ * che controlla solo chi va verso sud in mezzo al gruppo (la terza solo chi va
+ * verso nord); accanto alla prima altre tre sulle corsie vicine, superate
+ * insieme a lei e poi più vicine della successiva. Tre percorsi: verso nord
+ * con le sole speedcam della strada, poi verso nord e verso sud con tre strade
+ * trasversali di 72 speedcam ciascuna (controllano il traffico trasversale,
+ * scartate dal filtro di rotta): prima del gruppo nei due versi e dentro il
+ * gruppo, dopo la prima speedcam. Le trasversali sono più vicine delle
+ * speedcam della strada e oltre SPEEDCAM_CANDIDATE_MAX: i check usano la
+ * ricerca nell'indice, dove i filtri (rotta, superate) vanno applicati prima
+ * del taglio a SPEEDCAM_KD_NEAREST. Ogni fix passa da checkSpeedcams() come
+ * nello sketch; tra un fix e l'altro il display avanza le animazioni a passi
+ * di MAIN_LOOP_PERIOD. Infine un'inversione a U 200 m prima della quarta e
+ * di nuovo verso nord: la quarta non è stata raggiunta e deve tornare in alert.
+ *
+ * Fallisce (exit 1) se gli alert non sono le speedcam della strada per il
+ * verso di marcia nell'ordine del percorso, se un alert arriva più di un fix
+ * dopo l'ingresso nel raggio di rilevazione o dopo aver superato di
+ * LOOKAHEAD_PASSED_M la speedcam precedente, se nel gruppo l'alert viene
+ * ridisegnato da zero invece della transizione, se la coda non è ordinata
+ * lungo la rotta o contiene una speedcam non controllata nel verso di marcia,
+ * se l'anteprima non compare prima del primo alert, se la coda viene riempita
+ * dall'indice più di una volta ogni LOOKAHEAD_REFILL_M percorsi o se nei
+ * percorsi con le trasversali la ricerca nell'indice non viene mai usata, o se
+ * dopo l'inversione la quarta viene data per superata e resta senza alert.
+ */
+
+#include <Arduino.h>
+#include "host_sim.h"
+#include "hal.h"
+#include "arena.h"
+#include "gps_controller.h"
+#include "speedcam_controller.h"
+#include "display_controller.h"
+#include "speedcam_db.h"
+#include <unistd.h>
+#include <vector>
+
+// Strada lungo il meridiano da (BENCH_LAT0, BENCH_LNG0)
+#define BENCH_LAT0 45.0
+#define BENCH_LNG0 9.0
+#define BENCH_METERS_PER_DEGREE (6371000.0 * M_PI / 180.0)
+#define BENCH_ROAD_M 5000.0
+#define BENCH_FIX_MS 1000UL
+
+// Strade trasversali: speedcam a 20-370 m dalla strada, alternate ai due lati
+#define BENCH_CROSS_CAMERAS 72
+#define BENCH_CROSS_FIRST_M 20.0
+#define BENCH_CROSS_SPACING_M 10.0
+#define BENCH_CROSS_FIRST_ID 1000
+
+// Inversione a U sulla strada senza trasversali: verso nord fino a 200 m dalla 4,
+// verso sud per 400 m, poi di nuovo verso nord oltre la 4
+#define BENCH_UTURN_CAMERA_M 3500.0
+#define BENCH_UTURN_START_M 2600.0
+#define BENCH_UTURN_AT_M 3300.0
+#define BENCH_UTURN_BACK_M 2900.0
+#define BENCH_UTURN_END_M 3700.0
+
+struct BenchCamera {
+    uint32_t id;
+    double along_m;         // Progressiva sulla strada (da sud)
+    double lateral_m;       // Verso est; diversa da 0: corsia accanto, mai in alert
+    uint8_t direction;
+    uint8_t heading;        // Angolo binario
+};
+
+// Accanto alla 1 tre speedcam sulle corsie verso nord: superate nello stesso fix,
+// poi sono le più vicine ma la rilevazione deve passare alla 2
+static const BenchCamera cameras[] = {
+    { 1, 1500.0, 0.0, SPEEDCAM_DIRECTION_ANY, 0 },
+    { 5, 1500.0, 3.5, SPEEDCAM_DIRECTION_ONE, 0 },
+    { 6, 1500.0, -3.5, SPEEDCAM_DIRECTION_ONE, 0 },
+    { 7, 1500.0, 7.0, SPEEDCAM_DIRECTION_ONE, 0 },
+    { 2, 1650.0, 0.0, SPEEDCAM_DIRECTION_ANY, 0 },
+    { 3, 1750.0, 0.0, SPEEDCAM_DIRECTION_ONE, 0 },
+    { 4, 3500.0, 0.0, SPEEDCAM_DIRECTION_ANY, 0 },
+    { 99, 1600.0, 0.0, SPEEDCAM_DIRECTION_ONE, 128 },
+};
+#define BENCH_CAMERAS (int)(sizeof(cameras) / sizeof(cameras[0]))
+
+// Progressive delle strade trasversali: prima del gruppo nei due versi e dentro il
+// gruppo, dove dopo una speedcam superata sono più vicine della successiva
+static const double cross_along_m[] = { 1400.0, 1520.0, 1900.0 };
+#define BENCH_CROSS_ROADS (int)(sizeof(cross_along_m) / sizeof(cross_along_m[0]))
+
+struct Scenario {
+    const char* name;
+    bool cross_roads;
+    bool southbound;
+};
+
+static const Scenario scenarios[] = {
+    { "nord",        false, false },
+    { "nord, denso", true,  false },
+    { "sud, denso",  true,  true },
+};
+
+static std::string fs_dir;
+
+/**
+ * Speedcam del database: quelle della strada e, se richieste, le trasversali
+ * (controllano il traffico verso est o verso ovest)
+ */
+static bool write_db(bool cross_roads, int* count) {
+    const double lng_meters = BENCH_METERS_PER_DEGREE * cos(BENCH_LAT0 * M_PI / 180.0);
+    std::vector<Speedcam> speedcams;
+    for (const BenchCamera& camera : cameras) {
+        Speedcam sc;
+        sc.id = camera.id;
+        sc.lat = (float)(BENCH_LAT0 + camera.along_m / BENCH_METERS_PER_DEGREE);
+        sc.lng = (float)(BENCH_LNG0 + camera.lateral_m / lng_meters);
+        sc.direction = camera.direction;
+        sc.heading = camera.heading;
+        speedcams.push_back(sc);
+    }
+    for (int road = 0; cross_roads && road < BENCH_CROSS_ROADS; road++) {
+        for (int i = 0; i < BENCH_CROSS_CAMERAS; i++) {
+            double offset_m = BENCH_CROSS_FIRST_M + (i / 2) * BENCH_CROSS_SPACING_M;
+            Speedcam sc;
+            sc.id = BENCH_CROSS_FIRST_ID + road * BENCH_CROSS_CAMERAS + i;
+            sc.lat = (float)(BENCH_LAT0 + cross_along_m[road] / BENCH_METERS_PER_DEGREE);
+            sc.lng = (float)(BENCH_LNG0 + (i % 2 ? -offset_m : offset_m) / lng_meters);
+            sc.direction = SPEEDCAM_DIRECTION_ONE;
+            sc.heading = i % 2 ? 192 : 64;
+            speedcams.push_back(sc);
+        }
+    }
+    for (Speedcam& sc : speedcams) {
+        strcpy(sc.type, "G50");
+        sc.vmax = 90;
+        sc.status = 'A';
+        sc.art = 'G';
+    }
+    *count = (int)speedcams.size();
+
+    size_t bytes = speedcams.size() * sizeof(Speedcam);
+    SpeedcamDbHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = SPEEDCAM_DB_MAGIC;
+    header.format = SPEEDCAM_DB_FORMAT;
+    header.record_size = SPEEDCAM_DB_RECORD_SIZE;
+    header.version = 1;
+    header.record_count = speedcams.size();
+    header.records_crc = speedcam_db_crc32(0, speedcams.data(), bytes);
+    header.header_crc = speedcam_db_crc32(0, &header, offsetof(SpeedcamDbHeader, header_crc));
+
+    FILE* fp = fopen((fs_dir + speedcam_db_slot_path(0)).c_str(), "wb");
+    if (!fp) return false;
+    bool ok = fwrite(&header, sizeof(header), 1, fp) == 1 &&
+              fwrite(speedcams.data(), 1, bytes, fp) == bytes;
+    return fclose(fp) == 0 && ok;
+}
+
+/**
+ * Speedcam della strada controllata nel verso di marcia, nullptr altrimenti
+ */
+static const BenchCamera* road_camera(uint32_t id, bool southbound) {
+    for (const BenchCamera& camera : cameras) {
+        if (camera.id != id) continue;
+        bool checked = camera.direction == SPEEDCAM_DIRECTION_ANY || camera.heading == (southbound ? 128 : 0);
+        return checked ? &camera : nullptr;
+    }
+    return nullptr;
+}
+
+/**
+ * Percorso dall'inizio della strada nel verso di marcia
+ */
+static double travel_m(double along_m, bool southbound) {
+    return southbound ? BENCH_ROAD_M - along_m : along_m;
+}
+
+/**
+ * Controller come nello sketch sul database del percorso
+ * @return 0, 2 se l'inizializzazione fallisce
+ */
+static int setup(bool cross_roads, DisplayController& display, GPSController& gps, SpeedcamController& speedcams,
+                 int* db_count) {
+    // Database diverso per percorso: le arene ripartono vuote
+    for (uint8_t i = 0; i < ARENA_REGION_COUNT; i++) {
+        arena_get((ArenaRegion)i).reset();
+    }
+    if (!write_db(cross_roads, db_count) || !display.begin() || !gps.begin() ||
+        !speedcams.begin(&gps, &display)) {
+        fprintf(stderr, "lookahead_bench: inizializzazione fallita\n");
+        return 2;
+    }
+    speedcams.setCheckInterval(0);
+    if (!speedcams.loadDatabaseSlots() || speedcams.getSpeedcamCount() != *db_count) {
+        fprintf(stderr, "lookahead_bench: database non caricato\n");
+        return 2;
+    }
+    display.resetStats();
+    speedcams.resetStats();
+    return 0;
+}
+
+/**
+ * Fix sulla strada (progressiva da sud)
+ */
+static GPSPosition road_position(double along_m, float course, float speed_kmh) {
+    GPSPosition position;
+    position.latitude = BENCH_LAT0 + along_m / BENCH_METERS_PER_DEGREE;
+    position.longitude = BENCH_LNG0;
+    position.speed = speed_kmh;
+    position.course = course;
+    position.is_valid = true;
+    return position;
+}
+
+/**
+ * Animazioni del display fino al fix successivo
+ */
+static void advance_fix(DisplayController& display) {
+    for (unsigned long t = 0; t < BENCH_FIX_MS; t += MAIN_LOOP_PERIOD) {
+        host_clock_advance_us(MAIN_LOOP_PERIOD * 1000UL);
+        display.update();
+    }
+}
+
+static int run_scenario(const Scenario& scenario, float speed_kmh, bool verbose) {
+    DisplayController display;
+    GPSController gps;
+    SpeedcamController speedcams;
+    int db_count = 0;
+    int result = setup(scenario.cross_roads, display, gps, speedcams, &db_count);
+    if (result) return result;
+
+    // Speedcam attese: quelle controllate nel verso di marcia, in ordine di percorso
+    // (tutte superate, in alert solo quelle sulla strada)
+    const BenchCamera* expected[BENCH_CAMERAS];
+    int expected_count = 0;
+    int expected_passed = 0;
+    for (const BenchCamera& camera : cameras) {
+        if (!road_camera(camera.id, scenario.southbound)) continue;
+        expected_passed++;
+        if (camera.lateral_m != 0.0) continue;
+        int pos = expected_count++;
+        while (pos > 0 && travel_m(expected[pos - 1]->along_m, scenario.southbound) >
+                              travel_m(camera.along_m, scenario.southbound)) {
+            expected[pos] = expected[pos - 1];
+            pos--;
+        }
+        expected[pos] = &camera;
+    }
+
+    const double step_m = speed_kmh / 3.6 * BENCH_FIX_MS / 1000.0;
+    uint32_t alerted[BENCH_CAMERAS + 2];
+    double alerted_at[BENCH_CAMERAS + 2];
+    int alert_count = 0;
+    uint32_t shown_id = 0;
+    uint32_t shown_next_id = 0;
+    unsigned long previews_before_alert = 0;
+    int fixes = 0;
+    uint32_t check_cycles = 0;
+    const char* error = nullptr;
+
+    for (double s = 0.0; s <= BENCH_ROAD_M; s += step_m) {
+        GPSPosition position = road_position(travel_m(s, scenario.southbound),
+                                             scenario.southbound ? 180.0f : 0.0f, speed_kmh);
+        uint32_t t0 = hal_cycles();
+        const Speedcam* detected = speedcams.checkSpeedcams(&position);
+        check_cycles += hal_cycles() - t0;
+        fixes++;
+
+        if (detected && detected->id != shown_id) {
+            shown_id = detected->id;
+            if (alert_count < BENCH_CAMERAS + 2) {
+                alerted[alert_count] = shown_id;
+                alerted_at[alert_count] = s;
+                alert_count++;
+            }
+            if (verbose) printf("  %6.0f m: alert %u\n", s, shown_id);
+        }
+        if (alert_count == 0) {
+            previews_before_alert = display.getStats().preview_updates;
+        }
+
+        // Coda ordinata lungo la rotta, solo speedcam della strada per il verso di marcia
+        const SpeedcamLookahead& lookahead = speedcams.getLookahead();
+        for (int i = 0; i < lookahead.getCount() && !error; i++) {
+            const LookaheadEntry& entry = lookahead.get(i);
+            if (!road_camera(entry.speedcam->id, scenario.southbound)) {
+                error = "speedcam non controllata nel verso di marcia in coda";
+            } else if (i > 0 && entry.along_m < lookahead.get(i - 1).along_m) {
+                error = "coda non ordinata";
+            }
+        }
+        uint32_t next_id = lookahead.next() ? lookahead.next()->speedcam->id : 0;
+        if (verbose && next_id != shown_next_id && next_id) {
+            printf("  %6.0f m: prossima %u a %.0f m lungo la rotta\n", s, next_id, lookahead.next()->along_m);
+        }
+        shown_next_id = next_id;
+        advance_fix(display);
+    }
+
+    // Alert nell'ordine del percorso, entro un fix dall'ingresso nel raggio
+    // o dal superamento della precedente (nel gruppo)
+    if (!error && alert_count != expected_count) {
+        error = "alert diversi dalle speedcam della strada";
+    }
+    for (int i = 0; !error && i < alert_count; i++) {
+        double at = travel_m(expected[i]->along_m, scenario.southbound) - SPEEDCAM_DETECTION_RADIUS;
+        if (i > 0) {
+            at = max(at, travel_m(expected[i - 1]->along_m, scenario.southbound) + LOOKAHEAD_PASSED_M);
+        }
+        if (alerted[i] != expected[i]->id) {
+            error = "alert fuori ordine";
+        } else if (alerted_at[i] > at + step_m + 1.0) {
+            error = i > 0 && at > travel_m(expected[i]->along_m, scenario.southbound) - SPEEDCAM_DETECTION_RADIUS
+                        ? "passaggio in ritardo alla speedcam successiva"
+                        : "alert in ritardo all'ingresso nel raggio";
+        }
+    }
+
+    DisplayController::Stats display_stats = display.getStats();
+    SpeedcamLookahead::Stats lookahead_stats = speedcams.getLookahead().getStats();
+    SpeedcamController::Stats speedcam_stats = speedcams.getStats();
+    if (!error && display_stats.alert_transitions != 2) {
+        error = "transizioni tra alert";
+    } else if (!error && display_stats.alert_full_redraws != 2) {
+        error = "alert ridisegnati da zero";
+    } else if (!error && previews_before_alert == 0) {
+        error = "nessuna anteprima prima del primo alert";
+    } else if (!error && lookahead_stats.refills > BENCH_ROAD_M / LOOKAHEAD_REFILL_M + 2) {
+        error = "coda riempita troppo spesso";
+    } else if (!error && lookahead_stats.passed != (unsigned long)expected_passed) {
+        error = "speedcam superate";
+    } else if (!error && scenario.cross_roads && speedcam_stats.index_checks == 0) {
+        error = "ricerca nell'indice mai usata";
+    }
+
+    printf("\nVerso %s: %d speedcam, %d fix, coda %d, superata a %.0f m\n", scenario.name, db_count, fixes,
+           LOOKAHEAD_MAX, LOOKAHEAD_PASSED_M);
+    printf("%-10s %10s %12s\n", "speedcam", "alert a m", "dopo la prec.");
+    for (int i = 0; i < alert_count; i++) {
+        const BenchCamera* camera = road_camera(alerted[i], scenario.southbound);
+        const BenchCamera* previous = i > 0 ? road_camera(alerted[i - 1], scenario.southbound) : nullptr;
+        double along = camera ? travel_m(camera->along_m, scenario.southbound) : 0.0;
+        printf("%-10u %10.0f %12.0f\n", alerted[i], alerted_at[i] - along,
+               previous ? alerted_at[i] - travel_m(previous->along_m, scenario.southbound) : 0.0);
+    }
+    printf("riempimenti %lu, superate %lu, scartate %lu | alert da zero %lu, transizioni %lu, "
+           "anteprime %lu | check nell'indice %lu, %.2f us/fix\n",
+           lookahead_stats.refills, lookahead_stats.passed, lookahead_stats.dropped,
+           display_stats.alert_full_redraws, display_stats.alert_transitions, display_stats.preview_updates,
+           speedcam_stats.index_checks, fixes ? (double)check_cycles / hal_cycles_per_us() / fixes : 0.0);
+
+    if (error) {
+        fprintf(stderr, "lookahead_bench: verso %s: %s\n", scenario.name, error);
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * Inversione a U prima della 4 (già in coda e in alert), poi di nuovo verso nord:
+ * la 4 non è stata raggiunta, va scartata dalla coda e non data per superata
+ */
+static int run_uturn(float speed_kmh, bool verbose) {
+    static const struct {
+        double from_m;
+        double to_m;
+        float course;
+    } legs[] = {
+        { BENCH_UTURN_START_M, BENCH_UTURN_AT_M, 0.0f },
+        { BENCH_UTURN_AT_M, BENCH_UTURN_BACK_M, 180.0f },
+        { BENCH_UTURN_BACK_M, BENCH_UTURN_END_M, 0.0f },
+    };
+    const uint32_t target = 4;
+
+    DisplayController display;
+    GPSController gps;
+    SpeedcamController speedcams;
+    int db_count = 0;
+    int result = setup(false, display, gps, speedcams, &db_count);
+    if (result) return result;
+
+    const double step_m = speed_kmh / 3.6 * BENCH_FIX_MS / 1000.0;
+    bool alerted_before = false;
+    bool alerted_after = false;
+    for (int leg = 0; leg < (int)(sizeof(legs) / sizeof(legs[0])); leg++) {
+        double direction = legs[leg].to_m > legs[leg].from_m ? 1.0 : -1.0;
+        for (double d = 0.0; d <= fabs(legs[leg].to_m - legs[leg].from_m); d += step_m) {
+            double s = legs[leg].from_m + direction * d;
+            GPSPosition position = road_position(s, legs[leg].course, speed_kmh);
+            const Speedcam* detected = speedcams.checkSpeedcams(&position);
+            bool on_target = detected && detected->id == target;
+            if (leg == 0 && on_target) alerted_before = true;
+            // Ultimo tratto: alert per la 4 prima di raggiungerla
+            if (leg == 2 && on_target && s < BENCH_UTURN_CAMERA_M) alerted_after = true;
+            if (verbose && detected) printf("  %6.0f m, rotta %3.0f: alert %u\n", s, legs[leg].course, detected->id);
+            advance_fix(display);
+        }
+    }
+
+    SpeedcamLookahead::Stats lookahead_stats = speedcams.getLookahead().getStats();
+    const char* error = nullptr;
+    if (!alerted_before) {
+        error = "nessun alert prima dell'inversione";
+    } else if (!alerted_after) {
+        error = "speedcam non raggiunta data per superata dopo l'inversione";
+    } else if (lookahead_stats.passed != 1) {
+        error = "speedcam superate";
+    } else if (lookahead_stats.dropped == 0) {
+        error = "speedcam dietro dopo l'inversione non scartata";
+    }
+
+    printf("\nInversione a %.0f m dalla %u, ritorno fino a %.0f m: alert prima %s, dopo %s | "
+           "superate %lu, scartate %lu\n",
+           BENCH_UTURN_CAMERA_M - BENCH_UTURN_AT_M, target, BENCH_UTURN_CAMERA_M - BENCH_UTURN_BACK_M,
+           alerted_before ? "sì" : "no", alerted_after ? "sì" : "no", lookahead_stats.passed,
+           lookahead_stats.dropped);
+    if (error) {
+        fprintf(stderr, "lookahead_bench: inversione: %s\n", error);
+        return 1;
+    }
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    float speed_kmh = 90.0f;
+    bool verbose = false;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--speed") == 0 && i + 1 < argc) {
+            speed_kmh = (float)atof(argv[++i]);
+        } else if (strcmp(argv[i], "--verbose") == 0) {
+            verbose = true;
+        } else {
+            fprintf(stderr, "uso: %s [--speed KMH] [--verbose]\n", argv[0]);
+            return 2;
+        }
+    }
+    // Sotto ~36 km/h due fix distano meno dei 10 m con cui la rilevazione
+    // ripete l'alert: scade il timeout e la transizione non è misurabile
+    if (speed_kmh < 40.0f || speed_kmh > 250.0f) {
+        fprintf(stderr, "lookahead_bench: velocità fuori da 40-250 km/h\n");
+        return 2;
+    }
+
+    char dir_template[] = "/tmp/micronav_lookahead_XXXXXX";
+    if (!mkdtemp(dir_template)) {
+        fprintf(stderr, "lookahead_bench: directory temporanea non creata\n");
+        return 2;
+    }
+    fs_dir = dir_template;
+    host_fs_set_root(fs_dir.c_str());
+    host_clock_use_virtual(true);
+    host_serial_mute(true);
+
+    printf("Velocità %.0f km/h\n", speed_kmh);
+    int failures = 0;
+    int result = 0;
+    for (const Scenario& scenario : scenarios) {
+        result = run_scenario(scenario, speed_kmh, verbose);
+        if (result == 2) break;
+        if (result) failures++;
+    }
+    if (result != 2) {
+        result = run_uturn(speed_kmh, verbose);
+        if (result == 1) failures++;
+    }
+
+    remove((fs_dir + speedcam_db_slot_path(0)).c_str());
+    rmdir(fs_dir.c_str());
+    if (result == 2) return 2;
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,273 @@
+/*
+ * overspeed_bench: avviso di eccesso di velocità su avvicinamenti sintetici
+ *
+ *   overspeed_bench [--verbose]
+ *
+ * Una strada rettilinea verso nord fino alla speedcam e oltre; fix a 1 Hz con
+ * l'ora GPS, velocità in decimi di km/h come dal GPS. Scenari: sotto il
+ * limite, velocità costante oltre il limite, frenata dopo l'avviso, rumore
+ * di velocità e posizione attorno alla soglia, limite sconosciuto.
+ *
+ * Ogni fix passa da OverspeedMonitor (interi) e da un modello di riferimento
+ * in double (distanza Haversine, stessa formula e stessa isteresi): i cambi di
+ * livello devono essere gli stessi, con tempi entro BENCH_TOLERANCE_MS.
+ * Per fix stampa i cambi con --verbose; per scenario livello massimo, cambi e
+ * costo di update() per fix.
+ * Fallisce (exit 1) se i cambi differiscono dal riferimento, se il livello
+ * massimo non è quello atteso, se dopo la speedcam resta un avviso o se il
+ * rumore produce più cambi di quelli attesi.
+ */
+
+#include <Arduino.h>
+#include "host_sim.h"
+#include "hal.h"
+#include "utils.h"
+#include "config.h"
+#include "speedcam.h"
+#include "overspeed.h"
+
+// Speedcam all'origine, strada lungo il meridiano
+#define BENCH_LAT0 45.0
+#define BENCH_LNG0 9.0
+#define BENCH_METERS_PER_DEGREE (6371000.0 * M_PI / 180.0)
+#define BENCH_START_MS 36000000UL       // Ora UTC del primo fix
+#define BENCH_AFTER_M 200.0             // Strada oltre la speedcam
+#define BENCH_TOLERANCE_MS 1000         // Un fix di scarto sul confine di una soglia
+#define BENCH_MAX_CHANGES 16
+
+struct Scenario {
+    const char* name;
+    double start_m;         // Distanza iniziale dalla speedcam
+    float speed_kmh;        // Velocità iniziale
+    uint16_t vmax;          // Limite della speedcam (0 = sconosciuto)
+    double brake_at_m;      // Inizio frenata (0 = nessuna)
+    float brake_decel;      // m/s²
+    float brake_to_kmh;     // Velocità a fine frenata
+    float speed_noise_kmh;  // Rumore uniforme sulla velocità
+    float position_noise_m; // Rumore uniforme sulla posizione lungo la strada
+    // Esito atteso
+    OverspeedLevel expect_max;
+    int max_changes;        // Cambi di livello al più (0 = nessun limite oltre il riferimento)
+};
+
+static const Scenario scenarios[] = {
+    { "sotto il limite",   800.0,  85.0f, 90,   0.0, 0.0f,  0.0f, 0.0f, 0.0f, OVERSPEED_NONE,     0 },
+    { "costante 130/90",   800.0, 130.0f, 90,   0.0, 0.0f,  0.0f, 0.0f, 0.0f, OVERSPEED_CRITICAL, 0 },
+    { "costante 110/90",   800.0, 110.0f, 90,   0.0, 0.0f,  0.0f, 0.0f, 0.0f, OVERSPEED_CRITICAL, 0 },
+    { "frenata 130->80",   800.0, 130.0f, 90, 450.0, 2.0f, 80.0f, 0.0f, 0.0f, OVERSPEED_OVER,     0 },
+    { "frenata tardiva",   800.0, 130.0f, 90, 150.0, 4.0f, 80.0f, 0.0f, 0.0f, OVERSPEED_BRAKE,    0 },
+    { "rumore 95/90",      800.0,  95.0f, 90,   0.0, 0.0f,  0.0f, 3.0f, 4.0f, OVERSPEED_BRAKE,    4 },
+    { "limite sconosciuto",800.0, 150.0f,  0,   0.0, 0.0f,  0.0f, 0.0f, 0.0f, OVERSPEED_NONE,     0 },
+};
+
+struct LevelChange {
+    uint32_t time_ms;
+    OverspeedLevel level;
+};
+
+/**
+ * Riferimento in double: stessa logica di OverspeedMonitor senza interi
+ */
+struct ReferenceMonitor {
+    uint16_t vmax;
+    OverspeedLevel level;
+    bool passed;
+    bool lowering;
+    uint32_t lower_since;
+    double min_distance;
+
+    void reset(uint16_t limit) {
+        vmax = limit;
+        level = OVERSPEED_NONE;
+        passed = false;
+        lowering = false;
+        lower_since = 0;
+        min_distance = 1e9;
+    }
+
+    OverspeedLevel evaluate(double distance, float speed_kmh) {
+        if (distance < min_distance) {
+            min_distance = distance;
+        } else if (distance > min_distance + OVERSPEED_PASSED_M) {
+            passed = true;
+        }
+        if (passed || vmax == 0 || speed_kmh <= vmax + OVERSPEED_MARGIN_KMH) return OVERSPEED_NONE;
+        double v = speed_kmh / 3.6;
+        double v_limit = vmax / 3.6;
+        double room = distance - v * OVERSPEED_REACTION_MS / 1000.0;
+        if (room <= 0.0) return OVERSPEED_BRAKE;
+        double decel = (v * v - v_limit * v_limit) / (2.0 * room);
+        if (decel >= OVERSPEED_CRITICAL_DECEL) return OVERSPEED_CRITICAL;
+        if (decel >= OVERSPEED_BRAKE_DECEL) return OVERSPEED_BRAKE;
+        return OVERSPEED_OVER;
+    }
+
+    bool update(double distance, float speed_kmh, uint32_t time_ms) {
+        OverspeedLevel next = evaluate(distance, speed_kmh);
+        OverspeedLevel previous = level;
+        if (next >= level || passed) {
+            lowering = false;
+            level = next;
+        } else if (!lowering) {
+            lowering = true;
+            lower_since = time_ms;
+        } else if (time_ms - lower_since >= OVERSPEED_RELEASE_MS) {
+            lowering = false;
+            level = next;
+        }
+        return level != previous;
+    }
+};
+
+struct Outcome {
+    LevelChange changes[BENCH_MAX_CHANGES];
+    LevelChange expected[BENCH_MAX_CHANGES];
+    int change_count;
+    int expected_count;
+    OverspeedLevel max_level;
+    OverspeedLevel final_level;
+    uint32_t max_decel;         // cm/s²
+    int fixes;
+    uint32_t update_cycles;
+    uint32_t max_cycles;
+};
+
+// Rumore deterministico uniforme in [-1, 1]
+static uint32_t noise_state;
+static float bench_noise() {
+    noise_state = noise_state * 1103515245UL + 12345UL;
+    return (float)((noise_state >> 8) & 0xFFFF) / 32767.5f - 1.0f;
+}
+
+static const char* level_name(OverspeedLevel level) {
+    switch (level) {
+        case OVERSPEED_OVER: return "oltre";
+        case OVERSPEED_BRAKE: return "frenata";
+        case OVERSPEED_CRITICAL: return "critico";
+        default: return "nessuno";
+    }
+}
+
+static Outcome run(const Scenario& scenario, bool verbose) {
+    Outcome outcome;
+    memset(&outcome, 0, sizeof(outcome));
+    noise_state = 12345;
+
+    Speedcam camera;
+    camera.id = 501;
+    camera.lat = (float)BENCH_LAT0;
+    camera.lng = (float)BENCH_LNG0;
+    strcpy(camera.type, "1");
+    camera.vmax = scenario.vmax;
+    camera.status = 'A';
+    camera.art = '1';
+
+    OverspeedMonitor monitor;
+    monitor.setTarget(camera);
+    ReferenceMonitor reference;
+    reference.reset(scenario.vmax);
+
+    double s = scenario.start_m;
+    float speed = scenario.speed_kmh;
+    for (int t = 0; s > -BENCH_AFTER_M; t++) {
+        if (scenario.brake_at_m > 0.0 && s <= scenario.brake_at_m && speed > scenario.brake_to_kmh) {
+            speed = max(scenario.brake_to_kmh, speed - scenario.brake_decel * 3.6f);
+        }
+        // Velocità del GPS in decimi di km/h: la stessa per il monitor e il riferimento
+        float reported = roundf((speed + scenario.speed_noise_kmh * bench_noise()) * 10.0f) / 10.0f;
+        double along = s + scenario.position_noise_m * bench_noise();
+        double lat = BENCH_LAT0 - along / BENCH_METERS_PER_DEGREE;
+        double lng = BENCH_LNG0;
+        uint32_t time_ms = BENCH_START_MS + t * 1000UL;
+
+        OverspeedFix fix = overspeed_fix(lat, lng, reported, time_ms);
+        uint32_t start = hal_cycles();
+        bool changed = monitor.update(fix);
+        uint32_t cycles = hal_cycles() - start;
+        outcome.update_cycles += cycles;
+        outcome.max_cycles = max(outcome.max_cycles, cycles);
+        outcome.fixes++;
+
+        double distance = calculate_distance(lat, lng, camera.lat, camera.lng);
+        bool expected_changed = reference.update(distance, reported, time_ms);
+
+        if (changed && outcome.change_count < BENCH_MAX_CHANGES) {
+            outcome.changes[outcome.change_count++] = { time_ms, monitor.getLevel() };
+            if (verbose) {
+                printf("  t=%3d %6.0f m %5.1f km/h -> %-8s (%u cm/s²)\n", t, s, reported,
+                       level_name(monitor.getLevel()), monitor.getRequiredDecel());
+            }
+        }
+        if (expected_changed && outcome.expected_count < BENCH_MAX_CHANGES) {
+            outcome.expected[outcome.expected_count++] = { time_ms, reference.level };
+        }
+        outcome.max_level = max(outcome.max_level, monitor.getLevel());
+        s -= speed / 3.6;
+    }
+    outcome.final_level = monitor.getLevel();
+    outcome.max_decel = monitor.getStats().max_decel;
+    return outcome;
+}
+
+int main(int argc, char** argv) {
+    bool verbose = false;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--verbose") == 0) {
+            verbose = true;
+        } else {
+            fprintf(stderr, "uso: %s [--verbose]\n", argv[0]);
+            return 2;
+        }
+    }
+    host_serial_mute(true);
+
+    printf("Margine %d km/h, reazione %d ms, frenata %.1f m/s², critica %.1f m/s², rilascio %d ms\n",
+           OVERSPEED_MARGIN_KMH, OVERSPEED_REACTION_MS, OVERSPEED_BRAKE_DECEL, OVERSPEED_CRITICAL_DECEL,
+           OVERSPEED_RELEASE_MS);
+    printf("%-20s %8s %6s %10s %10s %10s  %s\n", "scenario", "massimo", "cambi", "decel max", "us/fix",
+           "us max", "");
+
+    int failures = 0;
+    for (const Scenario& scenario : scenarios) {
+        if (verbose) printf("%s\n", scenario.name);
+        Outcome outcome = run(scenario, verbose);
+
+        const char* error = nullptr;
+        if (outcome.change_count != outcome.expected_count) {
+            error = "cambi diversi dal riferimento";
+        } else {
+            for (int i = 0; i < outcome.change_count; i++) {
+                const LevelChange& got = outcome.changes[i];
+                const LevelChange& want = outcome.expected[i];
+                int32_t delta = (int32_t)(got.time_ms - want.time_ms);
+                if (got.level != want.level || delta > BENCH_TOLERANCE_MS || delta < -BENCH_TOLERANCE_MS) {
+                    error = "tempi diversi dal riferimento";
+                    if (verbose) {
+                        printf("  cambio %d: %s a %+d ms dal riferimento (%s)\n", i, level_name(got.level),
+                               (int)delta, level_name(want.level));
+                    }
+                    break;
+                }
+            }
+        }
+        if (!error && outcome.max_level != scenario.expect_max) {
+            error = "livello massimo";
+        } else if (!error && outcome.final_level != OVERSPEED_NONE) {
+            error = "avviso dopo la speedcam";
+        } else if (!error && scenario.max_changes > 0 && outcome.change_count > scenario.max_changes) {
+            error = "lampeggio con il rumore";
+        }
+        if (error) failures++;
+
+        double us = outcome.fixes ? (double)outcome.update_cycles / hal_cycles_per_us() / outcome.fixes : 0.0;
+        printf("%-20s %8s %6d %10.2f %10.2f %10.2f  %s\n", scenario.name, level_name(outcome.max_level),
+               outcome.change_count, outcome.max_decel / 100.0, us,
+               (double)outcome.max_cycles / hal_cycles_per_us(), error ? error : "OK");
+    }
+
+    if (failures) {
+        fprintf(stderr, "%d scenari con esito diverso dall'atteso\n", failures);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,154 @@
+#include "Preferences.h"
+#include "host_sim.h"
+
+/**
+ * Voce NVS: namespace + chiave -> valore
+ */
+struct NvsEntry {
+    bool used;
+    char name_space[HOST_NVS_KEY_MAX];
+    char key[HOST_NVS_KEY_MAX];
+    uint16_t length;
+    uint8_t value[HOST_NVS_VALUE_MAX];
+};
+
+static NvsEntry nvs_entries[HOST_NVS_ENTRIES];
+static char nvs_path[256];
+static uint32_t nvs_writes = 0;
+
+static void nvs_persist() {
+    if (!nvs_path[0]) return;
+    FILE* fp = fopen(nvs_path, "wb");
+    if (!fp) {
+        fprintf(stderr, "host: impossibile scrivere NVS %s\n", nvs_path);
+        return;
+    }
+    fwrite(nvs_entries, sizeof(nvs_entries), 1, fp);
+    fclose(fp);
+}
+
+void host_nvs_set_path(const char* path) {
+    memset(nvs_entries, 0, sizeof(nvs_entries));
+    nvs_path[0] = '\0';
+    if (!path) return;
+    snprintf(nvs_path, sizeof(nvs_path), "%s", path);
+
+    // File assente o di un'altra versione della tabella: NVS vuoto
+    FILE* fp = fopen(nvs_path, "rb");
+    if (!fp) return;
+    if (fread(nvs_entries, sizeof(nvs_entries), 1, fp) != 1) {
+        memset(nvs_entries, 0, sizeof(nvs_entries));
+    }
+    fclose(fp);
+}
+
+void host_nvs_erase() {
+    memset(nvs_entries, 0, sizeof(nvs_entries));
+    nvs_persist();
+}
+
+uint32_t host_nvs_writes() {
+    return nvs_writes;
+}
+
+static NvsEntry* nvs_find(const char* name_space, const char* key) {
+    for (int i = 0; i < HOST_NVS_ENTRIES; i++) {
+        NvsEntry& entry = nvs_entries[i];
+        if (entry.used && strcmp(entry.name_space, name_space) == 0 && strcmp(entry.key, key) == 0) {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+Preferences::Preferences() : opened(false), read_only(false) {
+    name_space[0] = '\0';
+}
+
+Preferences::~Preferences() {
+    end();
+}
+
+bool Preferences::begin(const char* name, bool read_only, const char* partition_label) {
+    (void)partition_label;
+    if (!name || strlen(name) >= HOST_NVS_KEY_MAX) return false;
+    strcpy(name_space, name);
+    this->read_only = read_only;
+    opened = true;
+    return true;
+}
+
+void Preferences::end() {
+    opened = false;
+}
+
+bool Preferences::clear() {
+    if (!opened || read_only) return false;
+    for (int i = 0; i < HOST_NVS_ENTRIES; i++) {
+        if (nvs_entries[i].used && strcmp(nvs_entries[i].name_space, name_space) == 0) {
+            nvs_entries[i].used = false;
+        }
+    }
+    nvs_writes++;
+    nvs_persist();
+    return true;
+}
+
+bool Preferences::remove(const char* key) {
+    if (!opened || read_only) return false;
+    NvsEntry* entry = nvs_find(name_space, key);
+    if (!entry) return false;
+    entry->used = false;
+    nvs_writes++;
+    nvs_persist();
+    return true;
+}
+
+bool Preferences::isKey(const char* key) {
+    return opened && nvs_find(name_space, key) != nullptr;
+}
+
+size_t Preferences::putBytes(const char* key, const void* value, size_t length) {
+    if (!opened || read_only || !key || strlen(key) >= HOST_NVS_KEY_MAX) return 0;
+    if (length > HOST_NVS_VALUE_MAX) return 0;
+
+    NvsEntry* entry = nvs_find(name_space, key);
+    for (int i = 0; !entry && i < HOST_NVS_ENTRIES; i++) {
+        if (!nvs_entries[i].used) {
+            entry = &nvs_entries[i];
+            entry->used = true;
+            strcpy(entry->name_space, name_space);
+            strcpy(entry->key, key);
+        }
+    }
+    if (!entry) {
+        fprintf(stderr, "host: NVS pieno (%d voci)\n", HOST_NVS_ENTRIES);
+        return 0;
+    }
+    memcpy(entry->value, value, length);
+    entry->length = (uint16_t)length;
+    nvs_writes++;
+    nvs_persist();
+    return length;
+}
+
+size_t Preferences::getBytesLength(const char* key) {
+    NvsEntry* entry = opened ? nvs_find(name_space, key) : nullptr;
+    return entry ? entry->length : 0;
+}
+
+size_t Preferences::getBytes(const char* key, void* buffer, size_t max_length) {
+    NvsEntry* entry = opened ? nvs_find(name_space, key) : nullptr;
+    if (!entry || entry->length > max_length) return 0;
+    memcpy(buffer, entry->value, entry->length);
+    return entry->length;
+}
+
+size_t Preferences::putUInt(const char* key, uint32_t value) {
+    return putBytes(key, &value, sizeof(value));
+}
+
+uint32_t Preferences::getUInt(const char* key, uint32_t default_value) {
+    uint32_t value;
+    return getBytes(key, &value, sizeof(value)) == sizeof(value) ? value : default_value;
+}
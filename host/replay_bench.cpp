@@ -0,0 +1,365 @@
+/*
+ * replay_bench: ripercorre un tragitto registrato (NMEA) attraverso l'intera
+ * pipeline GPS parse -> rilevazione speedcam -> rendering alert e misura:
+ *  - latenza per stadio (p50/p99/max) e CPU per fix
+ *  - picco di heap usato e chiamate heap dopo il setup (devono essere 0: i buffer
+ *    vengono dalle arene statiche, vedi arena.h)
+ *  - metri mancanti alla speedcam quando compare l'alert
+ * Scrive un report JSON e fallisce (exit 1) se il replay usa l'heap, se le
+ * speedcam segnalate non sono quelle attese (--expect-alerts) o, se indicato
+ * un baseline, quando una metrica peggiora oltre la soglia.
+ *
+ *   replay_bench --drive FILE.nmea [--fs DIR] [--report OUT.json]
+ *                [--baseline BASE.json] [--threshold PCT] [--write-baseline]
+ *                [--expect-alerts N]
+ *
+ * --drive          Frasi NMEA del tragitto (es. generate con make_replay_drive.py)
+ * --fs             Directory usata come LittleFS con speedcams.json (default: data)
+ * --report         Report JSON (default: stdout)
+ * --baseline       Report di riferimento da confrontare
+ * --threshold      Peggioramento tollerato in percentuale (default: 20)
+ * --write-baseline Salva il report corrente come baseline (in --baseline)
+ * --expect-alerts  Speedcam distinte che devono generare un alert (es. stampate
+ *                  da make_replay_drive.py --directional per ciascun verso)
+ *
+ * Il tempo simulato è virtuale (UART a 9600 baud), le latenze sono tempo CPU
+ * del processo convertito in µs: confrontabili solo tra run sulla stessa macchina.
+ */
+
+#include <Arduino.h>
+#include "host_sim.h"
+#include "hal.h"
+#include "metrics.h"
+#include "utils.h"
+#include "gps_controller.h"
+#include "speedcam_controller.h"
+#include "display_controller.h"
+#include <ArduinoJson.h>
+
+// UART del GPS (GPSController usa HardwareSerial(1)), 9600 baud 8N1
+#define REPLAY_GPS_UART 1
+#define REPLAY_GPS_BYTES_PER_MS 0.96
+// Passo del loop simulato
+#define REPLAY_STEP_MS 10
+// Tempo simulato dopo la fine del file, per svuotare la UART
+#define REPLAY_TAIL_MS 2000
+#define REPLAY_MAX_ALERTS 256
+
+/**
+ * Metrica confrontata con il baseline
+ */
+struct ReplayMetric {
+    const char* name;
+    float value;
+    bool higher_is_better;
+};
+
+/**
+ * Distanze al primo alert di ogni speedcam
+ */
+struct AlertRecord {
+    uint32_t speedcam_id;
+    float distance;
+};
+
+static uint32_t cycles_to_us(uint32_t cycles) {
+    return cycles / hal_cycles_per_us();
+}
+
+static bool read_file(const char* path, std::string& out) {
+    FILE* fp = fopen(path, "rb");
+    if (!fp) return false;
+    char buffer[4096];
+    size_t n;
+    while ((n = fread(buffer, 1, sizeof(buffer), fp)) > 0) {
+        out.append(buffer, n);
+    }
+    fclose(fp);
+    return true;
+}
+
+/**
+ * Scrive il report su file (stdout se path è nullptr)
+ */
+static bool write_file(const char* path, const char* data, size_t length) {
+    FILE* fp = path ? fopen(path, "w") : stdout;
+    if (!fp) {
+        fprintf(stderr, "replay_bench: impossibile scrivere %s\n", path);
+        return false;
+    }
+    fwrite(data, 1, length, fp);
+    if (fp != stdout) fclose(fp);
+    return true;
+}
+
+static void write_stage(FILE* out, const char* name, const LatencyHistogram& h, bool last) {
+    fprintf(out, "    \"%s\": {\"count\": %u, \"mean_us\": %u, \"p50_us\": %u, \"p99_us\": %u, \"max_us\": %u}%s\n",
+            name, h.count(), h.mean(), h.percentile(50), h.percentile(99), h.max(), last ? "" : ",");
+}
+
+int main(int argc, char** argv) {
+    const char* fs_dir = "data";
+    const char* drive_path = nullptr;
+    const char* report_path = nullptr;
+    const char* baseline_path = nullptr;
+    float threshold_pct = 20.0f;
+    bool write_baseline = false;
+    int expect_alerts = -1;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--fs") == 0 && i + 1 < argc) {
+            fs_dir = argv[++i];
+        } else if (strcmp(argv[i], "--drive") == 0 && i + 1 < argc) {
+            drive_path = argv[++i];
+        } else if (strcmp(argv[i], "--report") == 0 && i + 1 < argc) {
+            report_path = argv[++i];
+        } else if (strcmp(argv[i], "--baseline") == 0 && i + 1 < argc) {
+            baseline_path = argv[++i];
+        } else if (strcmp(argv[i], "--threshold") == 0 && i + 1 < argc) {
+            threshold_pct = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--write-baseline") == 0) {
+            write_baseline = true;
+        } else if (strcmp(argv[i], "--expect-alerts") == 0 && i + 1 < argc) {
+            expect_alerts = atoi(argv[++i]);
+        } else {
+            drive_path = nullptr;
+            break;
+        }
+    }
+    if (!drive_path || (write_baseline && !baseline_path)) {
+        fprintf(stderr, "uso: %s --drive FILE.nmea [--fs DIR] [--report OUT.json] "
+                        "[--baseline BASE.json] [--threshold PCT] [--write-baseline] [--expect-alerts N]\n", argv[0]);
+        return 2;
+    }
+
+    std::string nmea;
+    if (!read_file(drive_path, nmea)) {
+        fprintf(stderr, "replay_bench: impossibile aprire %s\n", drive_path);
+        return 2;
+    }
+
+    uint32_t heap_start = hal_free_heap();
+    host_fs_set_root(fs_dir);
+    host_clock_use_virtual(true);
+    host_serial_mute(true);
+
+    // Stessa inizializzazione dello sketch, ma GPS reale sulla UART simulata
+    DisplayController display;
+    GPSController gps;
+    SpeedcamController speedcams;
+    if (!display.begin() || !gps.begin() || !speedcams.begin(&gps, &display)) {
+        fprintf(stderr, "replay_bench: inizializzazione controller fallita\n");
+        return 1;
+    }
+    if (!speedcams.loadDatabase(SPEEDCAM_JSON_PATH)) {
+        fprintf(stderr, "replay_bench: %s/%s non caricato\n", fs_dir, SPEEDCAM_JSON_PATH + 1);
+        return 1;
+    }
+    // Un check per ogni fix: misura la latenza di rilevazione, non il throttling
+    speedcams.setCheckInterval(0);
+    
+    // Da qui nessuna allocazione: né i controller né l'HAL host
+    uint32_t heap_calls_setup = host_heap_calls();
+
+    LatencyHistogram parse_us;
+    LatencyHistogram detect_us;
+    LatencyHistogram render_us;
+    LatencyHistogram fix_us;
+    AlertRecord alerts[REPLAY_MAX_ALERTS];
+    uint16_t alert_count = 0;
+
+    uint32_t parse_cycles = 0;
+    double last_lat = 0.0;
+    double last_lng = 0.0;
+    unsigned long alerts_seen = 0;
+    unsigned long start = millis();
+    size_t sent = 0;
+    unsigned long duration = (unsigned long)(nmea.size() / REPLAY_GPS_BYTES_PER_MS) + REPLAY_TAIL_MS;
+
+    while (millis() - start < duration) {
+        host_clock_advance_us(REPLAY_STEP_MS * 1000UL);
+        size_t due = min((size_t)((millis() - start) * REPLAY_GPS_BYTES_PER_MS), nmea.size());
+        if (due > sent) {
+            host_serial_feed(REPLAY_GPS_UART, nmea.data() + sent, due - sent);
+            sent = due;
+        }
+
+        // Parse: cicli accumulati fino al completamento del fix
+        uint32_t t0 = hal_cycles();
+        gps.update();
+        parse_cycles += hal_cycles() - t0;
+
+        GPSPosition position = gps.getPosition();
+        uint32_t render_cycles = 0;
+        // Nuovo fix = coordinate cambiate: RMC e GGA della stessa epoca aggiornano
+        // entrambe la posizione ma contano una volta sola (tragitti in movimento)
+        bool new_fix = position.is_valid &&
+                       (position.latitude != last_lat || position.longitude != last_lng);
+        if (new_fix) {
+            last_lat = position.latitude;
+            last_lng = position.longitude;
+
+            t0 = hal_cycles();
+            const Speedcam* detected = speedcams.checkSpeedcams(&position);
+            uint32_t check_cycles = hal_cycles() - t0;
+
+            // Il rendering dell'alert avviene dentro checkSpeedcams: va scorporato
+            DisplayController::Stats stats = display.getStats();
+            unsigned long alerts_now = stats.alert_full_redraws + stats.alert_updates;
+            if (alerts_now != alerts_seen) {
+                alerts_seen = alerts_now;
+                render_cycles = stats.last_alert_cycles;
+            }
+            uint32_t detect_cycles = check_cycles > render_cycles ? check_cycles - render_cycles : 0;
+
+            if (detected) {
+                bool known = false;
+                for (uint16_t i = 0; i < alert_count; i++) {
+                    if (alerts[i].speedcam_id == detected->id) {
+                        known = true;
+                        break;
+                    }
+                }
+                if (!known && alert_count < REPLAY_MAX_ALERTS) {
+                    alerts[alert_count].speedcam_id = detected->id;
+                    alerts[alert_count].distance = calculate_distance(
+                        position.latitude, position.longitude, detected->lat, detected->lng);
+                    alert_count++;
+                }
+            }
+
+            // Animazioni e timeout della stessa iterazione
+            t0 = hal_cycles();
+            display.update();
+            render_cycles += hal_cycles() - t0;
+
+            parse_us.record(cycles_to_us(parse_cycles));
+            detect_us.record(cycles_to_us(detect_cycles));
+            render_us.record(cycles_to_us(render_cycles));
+            fix_us.record(cycles_to_us(parse_cycles + detect_cycles + render_cycles));
+            parse_cycles = 0;
+            hal_free_heap();
+        } else {
+            display.update();
+        }
+    }
+
+    uint32_t heap_calls_replay = host_heap_calls() - heap_calls_setup;
+    uint32_t heap_min = hal_min_free_heap();
+    uint32_t heap_peak = heap_start > heap_min ? heap_start - heap_min : 0;
+
+    float distance_min = 0.0f;
+    float distance_sum = 0.0f;
+    for (uint16_t i = 0; i < alert_count; i++) {
+        if (i == 0 || alerts[i].distance < distance_min) distance_min = alerts[i].distance;
+        distance_sum += alerts[i].distance;
+    }
+    float distance_mean = alert_count ? distance_sum / alert_count : 0.0f;
+
+    ReplayMetric metrics[] = {
+        { "parse_p99_us", (float)parse_us.percentile(99), false },
+        { "detect_p99_us", (float)detect_us.percentile(99), false },
+        { "render_p99_us", (float)render_us.percentile(99), false },
+        { "fix_p50_us", (float)fix_us.percentile(50), false },
+        { "fix_p99_us", (float)fix_us.percentile(99), false },
+        { "fix_max_us", (float)fix_us.max(), false },
+        { "cpu_us_per_fix", (float)fix_us.mean(), false },
+        { "heap_peak_bytes", (float)heap_peak, false },
+        { "alert_distance_min_m", distance_min, true },
+        { "alert_distance_mean_m", distance_mean, true },
+    };
+    const size_t metric_count = sizeof(metrics) / sizeof(metrics[0]);
+
+    // Confronto con il baseline
+    std::string baseline_json;
+    bool compare = baseline_path && !write_baseline;
+    if (compare && !read_file(baseline_path, baseline_json)) {
+        fprintf(stderr, "replay_bench: baseline %s non trovato (usa --write-baseline)\n", baseline_path);
+        return 2;
+    }
+    // Dopo il replay: l'allocatore di default non entra in heap_calls_after_setup
+    JsonDocument baseline;
+    if (compare) {
+        DeserializationError error = deserializeJson(baseline, baseline_json.c_str());
+        if (error) {
+            fprintf(stderr, "replay_bench: baseline non valido: %s\n", error.c_str());
+            return 2;
+        }
+    }
+
+    // Report composto in memoria: va su --report (o stdout) ed eventualmente nel baseline
+    char* report = nullptr;
+    size_t report_size = 0;
+    FILE* out = open_memstream(&report, &report_size);
+
+    fprintf(out, "{\n");
+    fprintf(out, "  \"drive\": \"%s\",\n", drive_path);
+    fprintf(out, "  \"fixes\": %u,\n", fix_us.count());
+    fprintf(out, "  \"alerts\": %u,\n", alert_count);
+    fprintf(out, "  \"stages\": {\n");
+    write_stage(out, "parse", parse_us, false);
+    write_stage(out, "detect", detect_us, false);
+    write_stage(out, "render", render_us, false);
+    write_stage(out, "fix_total", fix_us, true);
+    fprintf(out, "  },\n");
+    fprintf(out, "  \"metrics\": {\n");
+    for (size_t i = 0; i < metric_count; i++) {
+        fprintf(out, "    \"%s\": %.1f%s\n", metrics[i].name, metrics[i].value,
+                i + 1 < metric_count ? "," : "");
+    }
+    fprintf(out, "  },\n");
+
+    // Verifica assoluta, indipendente dal baseline
+    bool heap_ok = heap_calls_replay == 0;
+    bool regression = !heap_ok;
+    fprintf(out, "  \"checks\": [");
+    fprintf(out, "\n    {\"metric\": \"heap_calls_after_setup\", \"value\": %u, \"limit\": 0, \"ok\": %s}",
+            heap_calls_replay, heap_ok ? "true" : "false");
+    if (!heap_ok) {
+        fprintf(stderr, "❌ heap_calls_after_setup: %u chiamate malloc/free durante il replay\n", heap_calls_replay);
+    }
+    if (expect_alerts >= 0) {
+        bool alerts_ok = alert_count == (unsigned int)expect_alerts;
+        if (!alerts_ok) regression = true;
+        fprintf(out, ",\n    {\"metric\": \"alerts\", \"value\": %u, \"expected\": %d, \"ok\": %s}",
+                alert_count, expect_alerts, alerts_ok ? "true" : "false");
+        if (!alerts_ok) {
+            fprintf(stderr, "❌ alerts: %u speedcam segnalate, attese %d\n", alert_count, expect_alerts);
+        }
+    }
+    if (compare) {
+        for (size_t i = 0; i < metric_count; i++) {
+            JsonVariant reference = baseline["metrics"][metrics[i].name];
+            if (reference.isNull()) continue;
+            float base = reference.as<float>();
+            float limit = metrics[i].higher_is_better ? base * (1.0f - threshold_pct / 100.0f)
+                                                      : base * (1.0f + threshold_pct / 100.0f);
+            bool ok = metrics[i].higher_is_better ? metrics[i].value >= limit
+                                                  : metrics[i].value <= limit;
+            if (!ok) regression = true;
+            fprintf(out, ",\n    {\"metric\": \"%s\", \"value\": %.1f, \"baseline\": %.1f, \"limit\": %.1f, \"ok\": %s}",
+                    metrics[i].name, metrics[i].value, base, limit, ok ? "true" : "false");
+            if (!ok) {
+                fprintf(stderr, "❌ %s: %.1f (baseline %.1f, limite %.1f)\n",
+                        metrics[i].name, metrics[i].value, base, limit);
+            }
+        }
+    }
+    fprintf(out, "\n  ],\n");
+    fprintf(out, "  \"threshold_pct\": %.1f,\n", threshold_pct);
+    fprintf(out, "  \"regression\": %s\n", regression ? "true" : "false");
+    fprintf(out, "}\n");
+    fclose(out);
+
+    bool written = write_file(report_path, report, report_size);
+    if (written && write_baseline) {
+        written = write_file(baseline_path, report, report_size);
+        if (written) fprintf(stderr, "✅ Baseline salvato in %s\n", baseline_path);
+    }
+    free(report);
+    if (!written) return 2;
+
+    fprintf(stderr, "%s %u fix, %u alert, fix p99 %u µs, heap picco %u byte\n",
+            regression ? "❌" : "✅", fix_us.count(), alert_count, fix_us.percentile(99), heap_peak);
+    return regression ? 1 : 0;
+}
@@ -0,0 +1,337 @@
+/*
+ * section_bench: Tutor (controllo della velocità media su tratta) su percorsi sintetici
+ *
+ *   section_bench [--length M] [--verbose]
+ *
+ * Una strada curva (una semionda di 400 m su una tratta di --length metri,
+ * default 5000) con i portali di inizio e fine nel database; fix a 1 Hz con
+ * l'ora GPS, ciascuno consegnato due volte (una callback per frase NMEA).
+ * Scenari: velocità costante sotto e sopra il limite, velocità variabile,
+ * tratta percorsa al contrario, deviazione dal percorso, fix persi, tratta a
+ * cavallo della mezzanotte e collegamento dei portali nel database.
+ *
+ * La media attesa è la lunghezza della strada tra i portali diviso il tempo
+ * di passaggio tra i portali; per ogni scenario stampa media misurata e
+ * attesa, margine e costo di SectionTracker::update() per fix.
+ * Fallisce (exit 1) se un esito (ingresso, completamento, interruzione,
+ * segno del margine) è diverso dall'atteso o se la media si scosta più di
+ * BENCH_AVERAGE_TOLERANCE.
+ */
+
+#include <Arduino.h>
+#include "host_sim.h"
+#include "hal.h"
+#include "utils.h"
+#include "config.h"
+#include "speedcam.h"
+#include "section_control.h"
+
+// Origine della strada sintetica
+#define BENCH_LAT0 45.0
+#define BENCH_LNG0 9.0
+#define BENCH_METERS_PER_DEGREE (6371000.0 * M_PI / 180.0)
+#define BENCH_CURVE_AMPLITUDE_M 400.0
+#define BENCH_APPROACH_M 300.0          // Strada prima e dopo i portali
+#define BENCH_VMAX 110
+#define BENCH_AVERAGE_TOLERANCE 0.02    // Scarto relativo massimo della media
+#define BENCH_DAY_MS 86400000UL
+#define BENCH_FIX_GAP_S (SECTION_FIX_TIMEOUT_MS / 1000 + 10)
+#define BENCH_MIN_LENGTH_M 3000.0      // Il buco dei fix deve cadere dentro la tratta
+
+enum Drive : uint8_t {
+    DRIVE_FORWARD = 0,
+    DRIVE_REVERSE,      // Dalla fine all'inizio
+    DRIVE_DETOUR,       // A metà tratta esce dalla strada e si allontana
+    DRIVE_FIX_GAP       // A metà tratta nessun fix per BENCH_FIX_GAP_S secondi
+};
+
+struct Scenario {
+    const char* name;
+    Drive drive;
+    float speed_kmh;        // Velocità di crociera
+    float speed_swing_kmh;  // Oscillazione attorno alla crociera (periodo 90 s)
+    uint32_t start_time_ms; // Ora UTC del primo fix
+    // Esito atteso (media oltre il limite se lo è quella attesa)
+    bool expect_entry;
+    bool expect_completed;
+};
+
+static const Scenario scenarios[] = {
+    { "costante 100",        DRIVE_FORWARD, 100.0f,  0.0f, 36000000UL, true,  true  },
+    { "costante 130",        DRIVE_FORWARD, 130.0f,  0.0f, 36000000UL, true,  true  },
+    { "variabile 105 +-35",  DRIVE_FORWARD, 105.0f, 35.0f, 36000000UL, true,  true  },
+    { "contromano",          DRIVE_REVERSE, 100.0f,  0.0f, 36000000UL, false, false },
+    { "deviazione",          DRIVE_DETOUR,  100.0f,  0.0f, 36000000UL, true,  false },
+    { "fix persi",           DRIVE_FIX_GAP, 100.0f,  0.0f, 36000000UL, true,  false },
+    { "mezzanotte",          DRIVE_FORWARD,  90.0f, 20.0f, BENCH_DAY_MS - 90000UL, true, true },
+};
+
+/**
+ * Strada: y = A sin(pi x / L) tra i portali (x in [0, L]), rettilinea fuori.
+ * Lunghezze d'arco tabulate ogni metro per posizionare il veicolo.
+ */
+struct Road {
+    double length_m;        // Distanza tra i portali
+    double x0;              // Ascissa del primo campione
+    int samples;
+    double* arc;            // Lunghezza d'arco dal primo campione
+
+    double y(double x) const {
+        if (x <= 0.0 || x >= length_m) return 0.0;
+        return BENCH_CURVE_AMPLITUDE_M * sin(M_PI * x / length_m);
+    }
+
+    void build(double length) {
+        length_m = length;
+        x0 = -BENCH_APPROACH_M;
+        samples = (int)(length + 2 * BENCH_APPROACH_M) + 1;
+        arc = new double[samples];
+        arc[0] = 0.0;
+        for (int i = 1; i < samples; i++) {
+            double xa = x0 + i - 1;
+            double xb = x0 + i;
+            arc[i] = arc[i - 1] + sqrt(1.0 + (y(xb) - y(xa)) * (y(xb) - y(xa)));
+        }
+    }
+
+    // Ascissa alla lunghezza d'arco s (interpolazione tra i campioni)
+    double xAt(double s) const {
+        if (s <= 0.0) return x0 + s;
+        if (s >= arc[samples - 1]) return x0 + (samples - 1) + (s - arc[samples - 1]);
+        int lo = 0;
+        int hi = samples - 1;
+        while (hi - lo > 1) {
+            int mid = (lo + hi) / 2;
+            if (arc[mid] <= s) lo = mid; else hi = mid;
+        }
+        return x0 + lo + (s - arc[lo]) / (arc[hi] - arc[lo]);
+    }
+
+    double arcAt(double x) const {
+        int i = (int)(x - x0);
+        i = constrain(i, 0, samples - 1);
+        return arc[i];
+    }
+};
+
+static void to_lat_lng(double x, double y, double& lat, double& lng) {
+    lat = BENCH_LAT0 + y / BENCH_METERS_PER_DEGREE;
+    lng = BENCH_LNG0 + x / (BENCH_METERS_PER_DEGREE * cos(deg_to_rad(BENCH_LAT0)));
+}
+
+static void make_speedcam(Speedcam& sc, uint32_t id, double x, double y, const char* type, uint16_t vmax) {
+    double lat;
+    double lng;
+    to_lat_lng(x, y, lat, lng);
+    sc.id = id;
+    sc.lat = (float)lat;
+    sc.lng = (float)lng;
+    strncpy(sc.type, type, sizeof(sc.type) - 1);
+    sc.type[sizeof(sc.type) - 1] = '\0';
+    sc.vmax = vmax;
+    sc.status = 'A';
+    sc.art = '1';
+}
+
+struct Outcome {
+    bool entered;
+    bool completed;
+    bool aborted;
+    float average_kmh;      // Media all'uscita (SectionTracker::Stats::last_average_kmh)
+    float expected_kmh;     // Lunghezza della strada tra i portali / tempo di passaggio
+    float margin_kmh;       // Ultimo margine in tratta
+    int fixes;
+    uint32_t update_cycles; // Somma e massimo dei cicli di update() in tratta
+    uint32_t max_cycles;
+    int active_updates;
+};
+
+static Outcome run(SectionTracker& tracker, const Road& road, const Scenario& scenario, bool verbose) {
+    Outcome outcome;
+    memset(&outcome, 0, sizeof(outcome));
+    tracker.reset();
+    tracker.resetStats();
+
+    const double total = road.arc[road.samples - 1];
+    const double gate_start = road.arcAt(0.0);
+    const double gate_end = road.arcAt(road.length_m);
+    const bool reverse = scenario.drive == DRIVE_REVERSE;
+    double s = 0.0;
+    double detour_x = 0.0;
+    double detour_y = 0.0;
+    bool detouring = false;
+    double t_start = -1.0;
+    double t_end = -1.0;
+
+    for (int t = 0; t < 3600; t++) {
+        float speed = scenario.speed_kmh + scenario.speed_swing_kmh * sin(2.0 * M_PI * t / 90.0);
+        double step = speed / 3.6;
+
+        // Passaggio ai portali (interpolato al secondo)
+        double along = reverse ? total - s : s;
+        double next = reverse ? total - (s + step) : s + step;
+        if (t_start < 0.0 && ((along - gate_start) * (next - gate_start) <= 0.0)) {
+            t_start = t + fabs(gate_start - along) / step;
+        }
+        if (t_end < 0.0 && ((along - gate_end) * (next - gate_end) <= 0.0)) {
+            t_end = t + fabs(gate_end - along) / step;
+        }
+
+        double x;
+        double y;
+        double course;
+        if (detouring) {
+            // Verso sud, lontano dalla strada
+            detour_y -= step;
+            x = detour_x;
+            y = detour_y;
+            course = 180.0;
+        } else {
+            double xa = road.xAt(along);
+            double xb = road.xAt(along + (reverse ? -1.0 : 1.0));
+            x = xa;
+            y = road.y(xa);
+            course = atan2(xb - xa, road.y(xb) - y) * 180.0 / M_PI;
+            if (course < 0.0) course += 360.0;
+        }
+
+        bool skip = scenario.drive == DRIVE_FIX_GAP && along > gate_start + road.length_m / 2 &&
+                    along < gate_start + road.length_m / 2 + BENCH_FIX_GAP_S * step;
+        if (!skip) {
+            SectionFix fix;
+            to_lat_lng(x, y, fix.lat, fix.lng);
+            fix.speed_kmh = speed;
+            fix.course_deg = (float)course;
+            fix.time_ms = (scenario.start_time_ms + t * 1000UL) % BENCH_DAY_MS;
+            fix.gps_time = true;
+
+            for (int copy = 0; copy < 2; copy++) {
+                bool was_active = tracker.getStatus().active;
+                uint32_t start = hal_cycles();
+                tracker.update(fix);
+                uint32_t cycles = hal_cycles() - start;
+                if (was_active) {
+                    outcome.update_cycles += cycles;
+                    outcome.max_cycles = max(outcome.max_cycles, cycles);
+                    outcome.active_updates++;
+                }
+            }
+            outcome.fixes++;
+            const SectionStatus& status = tracker.getStatus();
+            if (status.active) {
+                outcome.margin_kmh = status.margin_kmh;
+                if (verbose && t % 30 == 0) {
+                    printf("  t=%4d v=%5.1f media %5.1f prevista %5.1f margine %+5.1f max %5.0f fine %5.0f m\n",
+                           t, speed, status.average_kmh, status.projected_kmh, status.margin_kmh,
+                           status.allowed_kmh, status.remaining_m);
+                }
+            }
+        }
+
+        if (scenario.drive == DRIVE_DETOUR && !detouring && along > gate_start + road.length_m / 2) {
+            detouring = true;
+            detour_x = x;
+            detour_y = y;
+        }
+        s += step;
+        SectionTracker::Stats stats = tracker.getStats();
+        // Dopo l'uscita si prosegue fino al portale di fine (tempo di passaggio per la media attesa)
+        if (stats.aborted || (stats.completed && t_end >= 0.0)) break;
+        if (!reverse && !detouring && s > total) break;
+        if (reverse && s > total) break;
+    }
+
+    SectionTracker::Stats stats = tracker.getStats();
+    outcome.entered = stats.entries > 0;
+    outcome.completed = stats.completed > 0;
+    outcome.aborted = stats.aborted > 0;
+    outcome.average_kmh = stats.last_average_kmh;
+    if (outcome.completed && t_start >= 0.0 && t_end > t_start) {
+        outcome.expected_kmh = (float)((gate_end - gate_start) / (t_end - t_start) * 3.6);
+    }
+    return outcome;
+}
+
+int main(int argc, char** argv) {
+    double length = 5000.0;
+    bool verbose = false;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--length") == 0 && i + 1 < argc) {
+            length = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--verbose") == 0) {
+            verbose = true;
+        } else {
+            fprintf(stderr, "uso: %s [--length M] [--verbose]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (length < BENCH_MIN_LENGTH_M || length > SECTION_MAX_LENGTH_M) {
+        fprintf(stderr, "--length tra %.0f e %.0f m\n", BENCH_MIN_LENGTH_M, SECTION_MAX_LENGTH_M);
+        return 2;
+    }
+    host_serial_mute(true);
+
+    Road road;
+    road.build(length);
+
+    // Database: la tratta della strada, una seconda tratta con limite diverso
+    // (la sua fine non va collegata alla prima), un inizio senza fine e due speedcam fisse
+    const uint16_t vmax = BENCH_VMAX;
+    Speedcam db[7];
+    make_speedcam(db[0], 101, 0.0, 0.0, SECTION_TYPE_START, vmax);
+    make_speedcam(db[1], 102, length, 0.0, SECTION_TYPE_END, vmax);
+    make_speedcam(db[2], 201, 200.0, 3000.0, SECTION_TYPE_START, 90);
+    make_speedcam(db[3], 202, length - 200.0, 2500.0, SECTION_TYPE_END, 90);
+    make_speedcam(db[4], 301, -20000.0, 20000.0, SECTION_TYPE_START, vmax);
+    make_speedcam(db[5], 401, length / 3, road.y(length / 3), "1", 90);
+    make_speedcam(db[6], 402, length / 2, road.y(length / 2), "1", vmax);
+
+    SectionTracker tracker;
+    int sections = tracker.build(db, 7);
+    const SpeedcamSection* linked = tracker.getSections();
+    bool pairing_ok = sections == 2 && tracker.getStats().unpaired == 1 &&
+                      linked[0].start_id == 101 && linked[0].end_id == 102 && linked[0].vmax_kmh == BENCH_VMAX &&
+                      linked[1].start_id == 201 && linked[1].end_id == 202;
+    printf("Tratte collegate: %d, portali senza corrispondente: %lu %s\n", sections,
+           tracker.getStats().unpaired, pairing_ok ? "OK" : "ERRORE (attese 101->102 e 201->202, 1 senza)");
+    printf("Strada tra i portali: %.0f m (linea d'aria %.0f m), limite %d km/h\n",
+           road.arcAt(length) - road.arcAt(0.0), length, BENCH_VMAX);
+    printf("%-20s %8s %8s %8s %8s %10s %10s  %s\n", "scenario", "esito", "media", "attesa", "margine",
+           "us/fix", "us max", "");
+
+    int failures = pairing_ok ? 0 : 1;
+    for (const Scenario& scenario : scenarios) {
+        if (verbose) printf("%s\n", scenario.name);
+        Outcome outcome = run(tracker, road, scenario, verbose);
+
+        const char* error = nullptr;
+        if (outcome.entered != scenario.expect_entry) {
+            error = scenario.expect_entry ? "nessun ingresso" : "ingresso inatteso";
+        } else if (outcome.completed != scenario.expect_completed) {
+            error = scenario.expect_completed ? "non completata" : "completata";
+        } else if (scenario.expect_entry && !scenario.expect_completed && !outcome.aborted) {
+            error = "non interrotta";
+        } else if (scenario.expect_completed) {
+            if (outcome.expected_kmh <= 0.0f ||
+                fabsf(outcome.average_kmh - outcome.expected_kmh) > outcome.expected_kmh * BENCH_AVERAGE_TOLERANCE) {
+                error = "media fuori tolleranza";
+            } else if ((outcome.margin_kmh < 0.0f) != (outcome.expected_kmh > BENCH_VMAX) ||
+                       (tracker.getStats().over_limit > 0) != (outcome.expected_kmh > BENCH_VMAX)) {
+                error = "segno del margine";
+            }
+        }
+        if (error) failures++;
+
+        const char* result = outcome.completed ? "uscita" : outcome.aborted ? "interr." : outcome.entered ? "in corso" : "-";
+        double us = outcome.active_updates ? (double)outcome.update_cycles / hal_cycles_per_us() / outcome.active_updates : 0.0;
+        printf("%-20s %8s %8.1f %8.1f %+8.1f %10.2f %10.2f  %s\n", scenario.name, result,
+               outcome.average_kmh, outcome.expected_kmh, outcome.margin_kmh, us,
+               (double)outcome.max_cycles / hal_cycles_per_us(), error ? error : "OK");
+    }
+
+    if (failures) {
+        fprintf(stderr, "%d scenari con esito diverso dall'atteso\n", failures);
+        return 1;
+    }
+    return 0;
+}
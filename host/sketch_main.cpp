@@ -0,0 +1,151 @@
+/*
+ * micronav_sketch: esegue micronav_esp32.ino (setup + loop) sull'HAL host
+ *
+ *   micronav_sketch [--fs DIR] [--nmea FILE] [--duration-ms N] [--realtime] [--trace FILE] [--pty]
+ *                   [--nvs FILE]
+ *
+ * --fs        Directory usata come LittleFS (default: data)
+ * --nmea      File di frasi NMEA inviate alla UART del GPS a 9600 baud
+ * --duration  Tempo simulato di esecuzione del loop (default: 60000 ms)
+ * --realtime  Usa il clock reale invece di quello virtuale
+ * --trace     Salva il dump binario di trace.h a fine esecuzione (build con MICRONAV_TRACE)
+ * --pty       Console (Serial) su uno pseudo-terminale, con clock reale: il percorso
+ *             è stampato su stderr (es. python3 metrics_cli.py --port /dev/pts/N)
+ * --nvs       File del PC che conserva l'NVS tra esecuzioni: il run successivo
+ *             parte in warm start (default: NVS vuoto a ogni avvio)
+ *
+ * A fine esecuzione stampa la durata del setup e il tempo alla prima posizione
+ * valida elaborata. micronav_sketch_blocking è lo stesso sketch compilato con
+ * DISPLAY_NONBLOCKING_ANIMATIONS=false (boot logo bloccante) per il confronto.
+ */
+
+#include <Arduino.h>
+#include "host_sim.h"
+
+// Lo sketch invariato: include src/*.h e definisce setup()/loop()
+#include "../micronav_esp32.ino"
+
+// UART del GPS (GPSController usa HardwareSerial(1))
+#define HOST_GPS_UART 1
+// 9600 baud 8N1: ~960 byte/s
+#define HOST_GPS_BYTES_PER_MS 0.96
+
+/**
+ * Print su file del PC (destinazione del dump del trace)
+ */
+class FilePrint : public Print {
+public:
+    explicit FilePrint(FILE* fp) : fp(fp) {}
+    size_t write(uint8_t c) override { return fputc(c, fp) == EOF ? 0 : 1; }
+    size_t write(const uint8_t* buffer, size_t size) override { return fwrite(buffer, 1, size, fp); }
+
+private:
+    FILE* fp;
+};
+
+int main(int argc, char** argv) {
+    const char* fs_dir = "data";
+    const char* nmea_path = nullptr;
+    unsigned long duration_ms = 60000;
+    bool realtime = false;
+    const char* trace_path = nullptr;
+    bool use_pty = false;
+    const char* nvs_path = nullptr;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--fs") == 0 && i + 1 < argc) {
+            fs_dir = argv[++i];
+        } else if (strcmp(argv[i], "--nmea") == 0 && i + 1 < argc) {
+            nmea_path = argv[++i];
+        } else if (strcmp(argv[i], "--duration-ms") == 0 && i + 1 < argc) {
+            duration_ms = strtoul(argv[++i], nullptr, 10);
+        } else if (strcmp(argv[i], "--realtime") == 0) {
+            realtime = true;
+        } else if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+            trace_path = argv[++i];
+        } else if (strcmp(argv[i], "--pty") == 0) {
+            use_pty = true;
+        } else if (strcmp(argv[i], "--nvs") == 0 && i + 1 < argc) {
+            nvs_path = argv[++i];
+        } else {
+            fprintf(stderr, "uso: %s [--fs DIR] [--nmea FILE] [--duration-ms N] [--realtime] [--trace FILE] [--pty] "
+                            "[--nvs FILE]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    host_fs_set_root(fs_dir);
+    host_nvs_set_path(nvs_path);
+    if (use_pty) {
+        // Il client sul pty interroga in tempo reale: clock virtuale non sensato
+        const char* pty_path = host_console_open_pty();
+        if (!pty_path) {
+            perror("micronav_sketch: pty");
+            return 1;
+        }
+        fprintf(stderr, "micronav_sketch: console su %s\n", pty_path);
+        realtime = true;
+    }
+    host_clock_use_virtual(!realtime);
+
+    // NMEA: caricato tutto e rilasciato alla velocità della UART
+    std::string nmea;
+    if (nmea_path) {
+        FILE* fp = fopen(nmea_path, "rb");
+        if (!fp) {
+            fprintf(stderr, "micronav_sketch: impossibile aprire %s\n", nmea_path);
+            return 1;
+        }
+        char buffer[4096];
+        size_t n;
+        while ((n = fread(buffer, 1, sizeof(buffer), fp)) > 0) {
+            nmea.append(buffer, n);
+        }
+        fclose(fp);
+    }
+
+    setup();
+    unsigned long setup_ms = millis();
+
+    unsigned long start = millis();
+    unsigned long first_fix_ms = 0;
+    size_t nmea_sent = 0;
+    while (millis() - start < duration_ms) {
+        size_t due = min((size_t)((millis() - start) * HOST_GPS_BYTES_PER_MS), nmea.size());
+        if (due > nmea_sent) {
+            host_serial_feed(HOST_GPS_UART, nmea.data() + nmea_sent, due - nmea_sent);
+            nmea_sent = due;
+        }
+        loop();
+        // Il callback della posizione è chiamato dentro loop()
+        if (first_fix_ms == 0 && gps_controller && gps_controller->getPosition().is_valid) {
+            first_fix_ms = millis();
+        }
+    }
+
+    printf("Animazioni %s: setup %lu ms, prima posizione elaborata ",
+           DISPLAY_NONBLOCKING_ANIMATIONS ? "non bloccanti" : "bloccanti", setup_ms);
+    if (first_fix_ms) {
+        printf("a %lu ms\n", first_fix_ms);
+    } else {
+        printf("assente\n");
+    }
+
+    if (trace_path) {
+        #ifdef TRACE_ENABLED
+        FILE* fp = fopen(trace_path, "wb");
+        if (!fp) {
+            fprintf(stderr, "micronav_sketch: impossibile scrivere %s\n", trace_path);
+            return 1;
+        }
+        FilePrint out(fp);
+        trace_dump(out);
+        fclose(fp);
+        #else
+        fprintf(stderr, "micronav_sketch: --trace richiede la build con -DMICRONAV_TRACE=ON\n");
+        return 1;
+        #endif
+    }
+
+    return 0;
+}
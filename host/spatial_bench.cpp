@@ -0,0 +1,535 @@
+/*
+ * spatial_bench: ricerca per raggio nel database speedcam con quattro indici
+ *  - lineare: scansione di tutto l'array (il vecchio detectSpeedcam)
+ *  - hilbert: array ordinato per curva di Hilbert, intervalli con ricerca
+ *    binaria (src/hilbert_index.h, nessuna memoria oltre all'array)
+ *  - kdtree: k-d tree implicito nell'array, virgola fissa (src/kd_index.h),
+ *    risultati verificati con Haversine come in SpeedcamController
+ *  - griglia: celle regolari con gli indici in formato CSR (solo nel bench,
+ *    per confronto: costa memoria in RAM oltre all'array)
+ * e ricerche delle k più vicine nel k-d tree (kd_search) contro la forza
+ * bruta con la stessa metrica (kd_scan): la più vicina, le 8 più vicine,
+ * le 4 più vicine davanti a una rotta e le 4 più vicine tra quelle che
+ * controllano la rotta (filtro nella ricerca, come nei check fuori dal working
+ * set). Una zona densa con oltre SPEEDCAM_CANDIDATE_MAX speedcam nel raggio,
+ * tutte di un'altra carreggiata, verifica che il filtro nella ricerca trovi la
+ * sola speedcam della rotta, più lontana di tutte.
+ *
+ *   spatial_bench [--cameras N] [--queries N] [--radius M]
+ *
+ * Speedcam sintetiche nel nord Italia, per metà in cluster urbani; le
+ * posizioni di ricerca sono per metà vicino a una speedcam e per metà
+ * uniformi. Senza --cameras misura 500, 2000, 8000 e 32000 speedcam.
+ * Fallisce (exit 1) se un indice non trova la stessa speedcam più vicina e lo
+ * stesso numero di speedcam nel raggio della scansione lineare, se
+ * kd_search non dà esattamente i risultati di kd_scan o se nella zona densa
+ * la speedcam della rotta non viene trovata.
+ */
+
+#include <Arduino.h>
+#include "host_sim.h"
+#include "hal.h"
+#include "utils.h"
+#include "config.h"
+#include "speedcam.h"
+#include "hilbert_index.h"
+#include "kd_index.h"
+
+// Zona delle speedcam sintetiche
+#define BENCH_LAT_MIN 44.0
+#define BENCH_LAT_MAX 46.0
+#define BENCH_LNG_MIN 7.5
+#define BENCH_LNG_MAX 13.5
+#define BENCH_CLUSTERS 40
+#define BENCH_CLUSTER_SPREAD 0.05
+#define BENCH_ROUNDS 3
+// Lato delle celle della griglia (~1.1 km in latitudine)
+#define BENCH_GRID_CELL_DEG 0.01
+// Metri per grado di latitudine con margine (come hilbert_query)
+#define BENCH_METERS_PER_DEGREE (6371000.0 * M_PI / 180.0 / 1.01)
+// Risultati massimi di una ricerca per raggio nel k-d tree
+#define BENCH_KD_MAX 512
+#define BENCH_INDEXES 4
+// k massimo delle ricerche delle più vicine
+#define BENCH_NEAREST_MAX 8
+// Zona densa fuori dalla zona sintetica: speedcam trasversali entro 300 m, quella della rotta a 800 m
+#define BENCH_DENSE_LAT 47.0
+#define BENCH_DENSE_LNG 9.0
+#define BENCH_DENSE_CAMERAS 96
+#define BENCH_DENSE_SPREAD_M 300.0
+#define BENCH_DENSE_TARGET_M 800.0
+// Tolleranza del filtro di rotta in angolo binario (45°, come SPEEDCAM_HEADING_TOLERANCE)
+#define BENCH_HEADING_TOLERANCE 32
+
+/**
+ * Esito di una ricerca: speedcam più vicina nel raggio e speedcam nel raggio
+ */
+struct QueryResult {
+    uint32_t closest_id;     // 0 se nessuna
+    float closest_distance;
+    int within;
+    int examined;            // Speedcam di cui è stata calcolata la distanza
+};
+
+static uint32_t seed = 12345;
+
+static double random_unit() {
+    seed = seed * 1103515245 + 12345;
+    return ((seed >> 8) % 100000) / 100000.0;
+}
+
+static double random_range(double min, double max) {
+    return min + (max - min) * random_unit();
+}
+
+static void visit(const Speedcam& sc, double lat, double lng, float radius, QueryResult& result) {
+    result.examined++;
+    float distance = calculate_distance(lat, lng, sc.lat, sc.lng);
+    if (distance > radius) return;
+    result.within++;
+    // A parità di distanza vince l'id minore: stesso esito in qualunque ordine
+    if (result.closest_id == 0 || distance < result.closest_distance ||
+        (distance == result.closest_distance && sc.id < result.closest_id)) {
+        result.closest_id = sc.id;
+        result.closest_distance = distance;
+    }
+}
+
+static QueryResult empty_result() {
+    QueryResult result;
+    result.closest_id = 0;
+    result.closest_distance = 0.0f;
+    result.within = 0;
+    result.examined = 0;
+    return result;
+}
+
+static QueryResult query_linear(const Speedcam* speedcams, int count, double lat, double lng, float radius) {
+    QueryResult result = empty_result();
+    for (int i = 0; i < count; i++) {
+        visit(speedcams[i], lat, lng, radius, result);
+    }
+    return result;
+}
+
+static QueryResult query_kdtree(const Speedcam* speedcams, int count, double lat, double lng, float radius) {
+    QueryResult result = empty_result();
+    KdNeighbor nearest[BENCH_KD_MAX];
+    KdQuery query;
+    kd_query_init(query, lat, lng, radius, nearest, BENCH_KD_MAX);
+    int found = kd_search(speedcams, count, query);
+    for (int j = 0; j < found; j++) {
+        visit(speedcams[nearest[j].index], lat, lng, radius, result);
+    }
+    // Distanze calcolate dall'albero in virgola fissa
+    result.examined = query.visited;
+    if (found == BENCH_KD_MAX) result.within = -1;  // Troncata: confronto non valido
+    return result;
+}
+
+static QueryResult query_hilbert(const Speedcam* speedcams, int count, double lat, double lng, float radius) {
+    QueryResult result = empty_result();
+    HilbertSpan spans[HILBERT_MAX_SPANS];
+    int span_count = hilbert_query(speedcams, count, lat, lng, radius, spans);
+    for (int s = 0; s < span_count; s++) {
+        for (int i = spans[s].first; i < spans[s].end; i++) {
+            visit(speedcams[i], lat, lng, radius, result);
+        }
+    }
+    return result;
+}
+
+/**
+ * Griglia regolare sulla zona del bench: l'array è riordinato per cella e
+ * cell_start[c]..cell_start[c+1] sono le speedcam della cella c
+ */
+struct Grid {
+    int columns;
+    int rows;
+    double lng_cell;
+    uint32_t* cell_start;
+    Speedcam* speedcams;
+
+    int column(double lng) const {
+        return (int)constrain((lng - BENCH_LNG_MIN) / lng_cell, 0.0, (double)(columns - 1));
+    }
+    int row(double lat) const {
+        return (int)constrain((lat - BENCH_LAT_MIN) / BENCH_GRID_CELL_DEG, 0.0, (double)(rows - 1));
+    }
+    size_t memory() const { return (size_t)(columns * rows + 1) * sizeof(uint32_t); }
+};
+
+static void grid_build(Grid& grid, const Speedcam* speedcams, int count) {
+    // Celle quadrate alla latitudine media della zona
+    grid.lng_cell = BENCH_GRID_CELL_DEG / cos(deg_to_rad((BENCH_LAT_MIN + BENCH_LAT_MAX) / 2));
+    grid.columns = (int)ceil((BENCH_LNG_MAX - BENCH_LNG_MIN) / grid.lng_cell);
+    grid.rows = (int)ceil((BENCH_LAT_MAX - BENCH_LAT_MIN) / BENCH_GRID_CELL_DEG);
+    int cells = grid.columns * grid.rows;
+    grid.cell_start = new uint32_t[cells + 1]();
+    grid.speedcams = new Speedcam[count];
+
+    // Conteggio per cella, somma prefissa, poi distribuzione
+    for (int i = 0; i < count; i++) {
+        grid.cell_start[grid.row(speedcams[i].lat) * grid.columns + grid.column(speedcams[i].lng) + 1]++;
+    }
+    for (int c = 0; c < cells; c++) {
+        grid.cell_start[c + 1] += grid.cell_start[c];
+    }
+    uint32_t* next = new uint32_t[cells];
+    memcpy(next, grid.cell_start, cells * sizeof(uint32_t));
+    for (int i = 0; i < count; i++) {
+        int cell = grid.row(speedcams[i].lat) * grid.columns + grid.column(speedcams[i].lng);
+        grid.speedcams[next[cell]++] = speedcams[i];
+    }
+    delete[] next;
+}
+
+static QueryResult query_grid(const Grid& grid, double lat, double lng, float radius) {
+    QueryResult result = empty_result();
+    double dlat = radius / BENCH_METERS_PER_DEGREE;
+    double dlng = dlat / cos(deg_to_rad(min(fabs(lat) + dlat, 89.0)));
+    int row_last = grid.row(lat + dlat);
+    int column_first = grid.column(lng - dlng);
+    int column_last = grid.column(lng + dlng);
+    for (int r = grid.row(lat - dlat); r <= row_last; r++) {
+        // Celle contigue della stessa riga sono contigue nell'array
+        uint32_t first = grid.cell_start[r * grid.columns + column_first];
+        uint32_t end = grid.cell_start[r * grid.columns + column_last + 1];
+        for (uint32_t i = first; i < end; i++) {
+            visit(grid.speedcams[i], lat, lng, radius, result);
+        }
+    }
+    return result;
+}
+
+static void generate(Speedcam* speedcams, int count) {
+    double cluster_lat[BENCH_CLUSTERS];
+    double cluster_lng[BENCH_CLUSTERS];
+    for (int c = 0; c < BENCH_CLUSTERS; c++) {
+        cluster_lat[c] = random_range(BENCH_LAT_MIN + 0.2, BENCH_LAT_MAX - 0.2);
+        cluster_lng[c] = random_range(BENCH_LNG_MIN + 0.2, BENCH_LNG_MAX - 0.2);
+    }
+    for (int i = 0; i < count; i++) {
+        Speedcam& sc = speedcams[i];
+        sc = Speedcam();
+        sc.id = 1000 + i;
+        if (i % 2 == 0) {
+            int c = (int)(random_unit() * BENCH_CLUSTERS);
+            sc.lat = cluster_lat[c] + random_range(-BENCH_CLUSTER_SPREAD, BENCH_CLUSTER_SPREAD);
+            sc.lng = cluster_lng[c] + random_range(-BENCH_CLUSTER_SPREAD, BENCH_CLUSTER_SPREAD);
+        } else {
+            sc.lat = random_range(BENCH_LAT_MIN, BENCH_LAT_MAX);
+            sc.lng = random_range(BENCH_LNG_MIN, BENCH_LNG_MAX);
+        }
+        strcpy(sc.type, "G50");
+        sc.vmax = 50;
+        sc.status = 'A';
+        // Un terzo controlla un solo verso di marcia (filtro di rotta)
+        if (i % 3 == 0) {
+            sc.direction = SPEEDCAM_DIRECTION_ONE;
+            sc.heading = (uint8_t)(i * 37);
+        }
+    }
+}
+
+/**
+ * Filtro di rotta come nei check: ctx è la rotta in angolo binario
+ */
+static bool heading_filter(void* ctx, const Speedcam& speedcam) {
+    return speedcam_heading_match(speedcam, *(const uint8_t*)ctx, BENCH_HEADING_TOLERANCE);
+}
+
+/**
+ * Ricerca delle k più vicine nel k-d tree
+ */
+struct NearestCase {
+    const char* name;
+    int k;
+    float radius;
+    bool ahead;
+    bool heading;           // Solo le speedcam che controllano la rotta (kd_query_filter)
+};
+
+// Rotta del filtro della ricerca in corso
+static uint8_t filter_course;
+
+static void nearest_init(KdQuery& query, const NearestCase& c, double lat, double lng, int q, KdNeighbor* results) {
+    kd_query_init(query, lat, lng, c.radius, results, c.k);
+    if (c.ahead) {
+        kd_query_ahead(query, (q * 37) % 360, SPEEDCAM_AHEAD_HALF_ANGLE);
+    }
+    if (c.heading) {
+        filter_course = heading_to_binary((q * 37) % 360);
+        kd_query_filter(query, heading_filter, &filter_course);
+    }
+}
+
+/**
+ * Zona densa (BENCH_DENSE_*) nelle prime speedcam dell'array: le trasversali
+ * controllano il traffico verso est, quella della rotta (id 1) entrambi i versi
+ */
+static void generate_dense(Speedcam* speedcams) {
+    double lng_scale = cos(deg_to_rad(BENCH_DENSE_LAT));
+    for (int i = 0; i < BENCH_DENSE_CAMERAS; i++) {
+        Speedcam& sc = speedcams[i];
+        sc.lat = BENCH_DENSE_LAT + random_range(-BENCH_DENSE_SPREAD_M, BENCH_DENSE_SPREAD_M) / BENCH_METERS_PER_DEGREE;
+        sc.lng = BENCH_DENSE_LNG +
+                 random_range(-BENCH_DENSE_SPREAD_M, BENCH_DENSE_SPREAD_M) / BENCH_METERS_PER_DEGREE / lng_scale;
+        sc.direction = SPEEDCAM_DIRECTION_ONE;
+        sc.heading = 64;
+    }
+    Speedcam& target = speedcams[BENCH_DENSE_CAMERAS];
+    target.id = 1;
+    target.lat = BENCH_DENSE_LAT + BENCH_DENSE_TARGET_M / BENCH_METERS_PER_DEGREE;
+    target.lng = BENCH_DENSE_LNG;
+    target.direction = SPEEDCAM_DIRECTION_ANY;
+}
+
+/**
+ * Zona densa verso nord: le SPEEDCAM_KD_NEAREST più vicine con il filtro nella
+ * ricerca contro la forza bruta, e quante restano filtrando dopo il taglio
+ * @return 1 se la speedcam della rotta non è la prima trovata
+ */
+static int check_dense(const Speedcam* tree, int count) {
+    KdNeighbor found[SPEEDCAM_KD_NEAREST];
+    KdNeighbor expected[SPEEDCAM_KD_NEAREST];
+    KdNeighbor unfiltered[SPEEDCAM_KD_NEAREST];
+    uint8_t course = heading_to_binary(0.0f);
+    KdQuery search;
+    KdQuery scan;
+    KdQuery nearest;
+    kd_query_init(search, BENCH_DENSE_LAT, BENCH_DENSE_LNG, SPEEDCAM_DETECTION_RADIUS, found, SPEEDCAM_KD_NEAREST);
+    kd_query_init(scan, BENCH_DENSE_LAT, BENCH_DENSE_LNG, SPEEDCAM_DETECTION_RADIUS, expected, SPEEDCAM_KD_NEAREST);
+    kd_query_init(nearest, BENCH_DENSE_LAT, BENCH_DENSE_LNG, SPEEDCAM_DETECTION_RADIUS, unfiltered,
+                  SPEEDCAM_KD_NEAREST);
+    kd_query_filter(search, heading_filter, &course);
+    kd_query_filter(scan, heading_filter, &course);
+    int n = kd_search(tree, count, search);
+    int expected_count = kd_scan(tree, 0, count, scan);
+    bool same = n == expected_count;
+    for (int j = 0; same && j < n; j++) {
+        same = found[j].index == expected[j].index && found[j].distance2 == expected[j].distance2;
+    }
+    // Come prima: le più vicine senza filtro, poi il filtro
+    int kept = 0;
+    int cut = kd_search(tree, count, nearest);
+    for (int j = 0; j < cut; j++) {
+        if (heading_filter(&course, tree[unfiltered[j].index])) kept++;
+    }
+
+    bool ok = same && n > 0 && tree[found[0].index].id == 1;
+    printf("%8d zona densa: %d trasversali entro %.0f m, della rotta %s a %.0f m"
+           " (filtrando dopo le %d più vicine: %d)\n",
+           count, BENCH_DENSE_CAMERAS, BENCH_DENSE_SPREAD_M, ok ? "trovata" : "NON TROVATA",
+           n > 0 ? kd_distance_m(found[0].distance2) : 0.0f, SPEEDCAM_KD_NEAREST, kept);
+    return ok ? 0 : 1;
+}
+
+/**
+ * kd_search contro kd_scan su tutto l'albero: stessi indici e distanze
+ * Stampa tempi e speedcam visitate per ricerca.
+ * @return Ricerche con risultati diversi
+ */
+static int check_nearest(const Speedcam* tree, int count, const NearestCase& c,
+                         const double* query_lat, const double* query_lng, int query_count) {
+    KdNeighbor found[BENCH_NEAREST_MAX];
+    KdNeighbor expected[BENCH_NEAREST_MAX];
+    int mismatches = 0;
+    for (int q = 0; q < query_count; q++) {
+        KdQuery search;
+        KdQuery scan;
+        nearest_init(search, c, query_lat[q], query_lng[q], q, found);
+        nearest_init(scan, c, query_lat[q], query_lng[q], q, expected);
+        int n = kd_search(tree, count, search);
+        bool same = n == kd_scan(tree, 0, count, scan);
+        for (int j = 0; same && j < n; j++) {
+            same = found[j].index == expected[j].index && found[j].distance2 == expected[j].distance2;
+        }
+        if (!same) {
+            if (mismatches < 5) {
+                fprintf(stderr, "kdtree %s: %d speedcam, ricerca %.6f,%.6f: %d risultati, attesi %d\n",
+                        c.name, count, query_lat[q], query_lng[q], n, scan.count);
+            }
+            mismatches++;
+        }
+    }
+
+    uint32_t best[2];
+    long visited = 0;
+    for (int round = 0; round < BENCH_ROUNDS; round++) {
+        for (int k = 0; k < 2; k++) {
+            uint32_t start = hal_cycles();
+            for (int q = 0; q < query_count; q++) {
+                KdQuery query;
+                nearest_init(query, c, query_lat[q], query_lng[q], q, found);
+                if (k == 0) {
+                    kd_search(tree, count, query);
+                    visited += round == 0 ? query.visited : 0;
+                } else {
+                    kd_scan(tree, 0, count, query);
+                }
+            }
+            uint32_t cycles = hal_cycles() - start;
+            if (round == 0 || cycles < best[k]) best[k] = cycles;
+        }
+    }
+    printf("%8d %-17s %12.2f %12.1f %12.2f\n", count, c.name,
+           (double)best[0] / hal_cycles_per_us() / query_count, (double)visited / query_count,
+           (double)best[1] / hal_cycles_per_us() / query_count);
+    return mismatches;
+}
+
+/**
+ * Misura di un indice: microsecondi e speedcam esaminate per ricerca
+ */
+struct IndexTiming {
+    uint32_t best_cycles;
+    long examined;
+};
+
+int main(int argc, char** argv) {
+    int sizes[] = { 500, 2000, 8000, 32000 };
+    int size_count = sizeof(sizes) / sizeof(sizes[0]);
+    int query_count = 2000;
+    float radius = 1000.0f;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--cameras") == 0 && i + 1 < argc) {
+            sizes[0] = atoi(argv[++i]);
+            size_count = 1;
+        } else if (strcmp(argv[i], "--queries") == 0 && i + 1 < argc) {
+            query_count = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--radius") == 0 && i + 1 < argc) {
+            radius = atof(argv[++i]);
+        } else {
+            fprintf(stderr, "uso: %s [--cameras N] [--queries N] [--radius M]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (sizes[0] < 1 || query_count < 1 || radius <= 0.0f) return 2;
+
+    printf("Ricerca per raggio: %d ricerche entro %.0fm\n", query_count, radius);
+    printf("%8s %-8s %12s %12s %12s\n", "speedcam", "indice", "us/ricerca", "esaminate", "memoria");
+
+    int mismatches = 0;
+    for (int n = 0; n < size_count; n++) {
+        int count = sizes[n];
+        Speedcam* linear = new Speedcam[count];
+        generate(linear, count);
+        if (count > BENCH_DENSE_CAMERAS) generate_dense(linear);
+
+        // Stesso contenuto in ordine di Hilbert (come dopo SpeedcamController::commitLoad)
+        Speedcam* sorted = new Speedcam[count];
+        memcpy(sorted, linear, count * sizeof(Speedcam));
+        uint32_t sort_start = hal_cycles();
+        hilbert_sort(sorted, count);
+        double sort_us = (double)(hal_cycles() - sort_start) / hal_cycles_per_us();
+
+        // k-d tree costruito sul posto in una copia (come dopo SpeedcamController::commitLoad)
+        Speedcam* tree = new Speedcam[count];
+        memcpy(tree, linear, count * sizeof(Speedcam));
+        uint32_t build_start = hal_cycles();
+        kd_build(tree, count);
+        double build_us = (double)(hal_cycles() - build_start) / hal_cycles_per_us();
+
+        Grid grid;
+        grid_build(grid, linear, count);
+
+        // Metà vicino a una speedcam (entro ~500m), metà uniformi
+        double* query_lat = new double[query_count];
+        double* query_lng = new double[query_count];
+        for (int q = 0; q < query_count; q++) {
+            if (q % 2 == 0) {
+                const Speedcam& sc = linear[(int)(random_unit() * count)];
+                query_lat[q] = sc.lat + random_range(-0.005, 0.005);
+                query_lng[q] = sc.lng + random_range(-0.005, 0.005);
+            } else {
+                query_lat[q] = random_range(BENCH_LAT_MIN, BENCH_LAT_MAX);
+                query_lng[q] = random_range(BENCH_LNG_MIN, BENCH_LNG_MAX);
+            }
+        }
+
+        // Correttezza: stessa speedcam più vicina e stesso conteggio della scansione lineare
+        int size_mismatches = 0;
+        for (int q = 0; q < query_count; q++) {
+            QueryResult expected = query_linear(linear, count, query_lat[q], query_lng[q], radius);
+            QueryResult hilbert = query_hilbert(sorted, count, query_lat[q], query_lng[q], radius);
+            QueryResult kdtree = query_kdtree(tree, count, query_lat[q], query_lng[q], radius);
+            QueryResult cells = query_grid(grid, query_lat[q], query_lng[q], radius);
+            const QueryResult* results[] = { &hilbert, &kdtree, &cells };
+            const char* names[] = { "hilbert", "kdtree", "griglia" };
+            for (int k = 0; k < 3; k++) {
+                if (results[k]->closest_id != expected.closest_id || results[k]->within != expected.within) {
+                    if (size_mismatches < 5) {
+                        fprintf(stderr, "%s: %d speedcam, ricerca %.6f,%.6f: id %u/%d nel raggio, atteso %u/%d\n",
+                                names[k], count, query_lat[q], query_lng[q],
+                                (unsigned int)results[k]->closest_id, results[k]->within,
+                                (unsigned int)expected.closest_id, expected.within);
+                    }
+                    size_mismatches++;
+                }
+            }
+        }
+        mismatches += size_mismatches;
+
+        // Tempi: indici alternati per BENCH_ROUNDS giri, si tiene il giro migliore
+        IndexTiming timings[BENCH_INDEXES];
+        for (int round = 0; round < BENCH_ROUNDS; round++) {
+            for (int k = 0; k < BENCH_INDEXES; k++) {
+                long examined = 0;
+                uint32_t start = hal_cycles();
+                for (int q = 0; q < query_count; q++) {
+                    QueryResult result;
+                    if (k == 0) result = query_linear(linear, count, query_lat[q], query_lng[q], radius);
+                    else if (k == 1) result = query_hilbert(sorted, count, query_lat[q], query_lng[q], radius);
+                    else if (k == 2) result = query_kdtree(tree, count, query_lat[q], query_lng[q], radius);
+                    else result = query_grid(grid, query_lat[q], query_lng[q], radius);
+                    examined += result.examined;
+                }
+                uint32_t cycles = hal_cycles() - start;
+                if (round == 0 || cycles < timings[k].best_cycles) timings[k].best_cycles = cycles;
+                timings[k].examined = examined;
+            }
+        }
+
+        const char* index_names[] = { "lineare", "hilbert", "kdtree", "griglia" };
+        size_t index_memory[] = { 0, 0, 0, grid.memory() };
+        for (int k = 0; k < BENCH_INDEXES; k++) {
+            double us = (double)timings[k].best_cycles / hal_cycles_per_us() / query_count;
+            printf("%8d %-8s %12.2f %12.1f %10u B\n", count, index_names[k], us,
+                   (double)timings[k].examined / query_count, (unsigned int)index_memory[k]);
+        }
+        printf("%8d ordinamento Hilbert sul posto: %.0f us, k-d tree: %.0f us%s\n", count, sort_us, build_us,
+               size_mismatches ? " | RISULTATI DIVERSI DALLA SCANSIONE LINEARE" : "");
+
+        // Più vicine nel k-d tree contro la forza bruta
+        const NearestCase nearest_cases[] = {
+            { "1 vicina", 1, radius, false, false },
+            { "8 vicine", 8, 5000.0f, false, false },
+            { "4 davanti", 4, 5000.0f, true, false },
+            { "4 della rotta", SPEEDCAM_KD_NEAREST, radius, false, true },
+        };
+        printf("%8s %-17s %12s %12s %12s\n", "", "k-d tree", "us/ricerca", "visitate", "us forza bruta");
+        for (const NearestCase& c : nearest_cases) {
+            int nearest_mismatches = check_nearest(tree, count, c, query_lat, query_lng, query_count);
+            if (nearest_mismatches) {
+                printf("%8d %s: %d RISULTATI DIVERSI DALLA FORZA BRUTA\n", count, c.name, nearest_mismatches);
+            }
+            mismatches += nearest_mismatches;
+        }
+        if (count > BENCH_DENSE_CAMERAS) mismatches += check_dense(tree, count);
+
+        delete[] query_lat;
+        delete[] query_lng;
+        delete[] grid.cell_start;
+        delete[] grid.speedcams;
+        delete[] tree;
+        delete[] sorted;
+        delete[] linear;
+    }
+
+    if (mismatches) {
+        fprintf(stderr, "%d ricerche con risultato diverso dalla scansione lineare o dalla forza bruta\n", mismatches);
+        return 1;
+    }
+    return 0;
+}
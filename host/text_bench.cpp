@@ -0,0 +1,170 @@
+/*
+ * text_bench: rendering del testo sul display host, font atlas anti-aliased
+ * con band buffer contro il font GFX 5x7 con print() (metodo precedente)
+ *
+ *   text_bench [--iterations N]
+ *
+ * Stesse stringhe dell'alert e della schermata idle. Per l'atlas compone il box
+ * testo nel band buffer come DisplayController::drawTextBox (box dentro il
+ * disco: una sola finestra, a bande se non entra nel buffer) e lo invia con
+ * writePixels(); per GFX setTextSize(2), getTextBounds() per centrare e
+ * print(). Per percorso e
+ * stringa stampa microsecondi per stringa e glifi/s (CPU host, miglior giro),
+ * byte SPI e finestre dal bus simulato; per l'atlas anche la sola composizione.
+ * Fallisce (exit 1) se l'atlas non invia il box con una sola finestra o se i
+ * byte SPI non sono esattamente quelli dei pixel del box.
+ */
+
+#include <Arduino.h>
+#include "host_sim.h"
+#include "hal.h"
+#include "config.h"
+#include <Adafruit_GC9A01A.h>
+#include "font_renderer.h"
+#include "font_atlas.h"
+
+#define BENCH_ROUNDS 5
+#define BENCH_WINDOW_BYTES 11       // CASET + RASET + RAMWR per finestra
+
+struct TextCase {
+    const char* name;
+    const AtlasFont* font;
+    const char* text;
+};
+
+static const TextCase cases[] = {
+    { "distanza",   &font_large,  "1234m" },
+    { "limite",     &font_medium, "130" },
+    { "tipo",       &font_medium, "G50" },
+    { "info GPS",   &font_small,  "GPS 3D 12 sat" },
+};
+
+struct PathResult {
+    uint32_t best_cycles;
+    unsigned long bytes;            // Per stringa
+    unsigned long windows;          // Per stringa
+};
+
+static uint16_t band[TEXT_BAND_PIXELS];
+
+/**
+ * Box testo come DisplayController::drawTextBox (non tagliato dal disco)
+ * @return Bande composte
+ */
+static int draw_atlas(Adafruit_GC9A01A& tft, FontRenderer& renderer, const AtlasFont& font, const char* text,
+                      int16_t y, bool send) {
+    uint16_t width = renderer.measure(font, text);
+    int16_t x = (DISPLAY_WIDTH - width) / 2;
+    const int16_t height = font.height;
+    const int16_t band_rows = min((int16_t)(TEXT_BAND_PIXELS / width), height);
+    int bands = 0;
+
+    if (send) {
+        tft.startWrite();
+        tft.setAddrWindow(x, y, width, height);
+    }
+    for (int16_t row = 0; row < height; row += band_rows) {
+        int16_t rows = min(band_rows, (int16_t)(height - row));
+        uint32_t pixels = (uint32_t)rows * width;
+        for (uint32_t i = 0; i < pixels; i++) {
+            band[i] = COLOR_BLACK;
+        }
+        renderer.render(font, text, COLOR_WHITE, band, width, row, rows, 0);
+        if (send) tft.writePixels(band, pixels, true, false);
+        bands++;
+    }
+    if (send) tft.endWrite();
+    return bands;
+}
+
+static void draw_gfx(Adafruit_GC9A01A& tft, const char* text, int16_t y) {
+    int16_t x1, y1;
+    uint16_t w, h;
+    tft.setTextColor(COLOR_WHITE, COLOR_BLACK);
+    tft.setTextSize(2);
+    tft.getTextBounds(text, 0, 0, &x1, &y1, &w, &h);
+    tft.setCursor((DISPLAY_WIDTH - w) / 2, y);
+    tft.print(text);
+}
+
+/**
+ * percorso: 0 atlas con SPI, 1 solo composizione atlas, 2 GFX
+ */
+static PathResult measure(Adafruit_GC9A01A& tft, FontRenderer& renderer, const TextCase& c, int path,
+                          int iterations) {
+    PathResult result;
+    memset(&result, 0, sizeof(result));
+    for (int round = 0; round < BENCH_ROUNDS; round++) {
+        tft.resetBusStats();
+        uint32_t start = hal_cycles();
+        for (int i = 0; i < iterations; i++) {
+            if (path == 2) {
+                draw_gfx(tft, c.text, 100);
+            } else {
+                draw_atlas(tft, renderer, *c.font, c.text, 100, path == 0);
+            }
+        }
+        uint32_t cycles = hal_cycles() - start;
+        if (round == 0 || cycles < result.best_cycles) result.best_cycles = cycles;
+    }
+    Adafruit_GC9A01A::BusStats bus = tft.getBusStats();
+    result.bytes = bus.bytes / iterations;
+    result.windows = bus.windows / iterations;
+    return result;
+}
+
+int main(int argc, char** argv) {
+    int iterations = 2000;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--iterations") == 0 && i + 1 < argc) {
+            iterations = atoi(argv[++i]);
+        } else {
+            fprintf(stderr, "uso: %s [--iterations N]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (iterations <= 0) {
+        fprintf(stderr, "text_bench: --iterations deve essere positivo\n");
+        return 2;
+    }
+    host_serial_mute(true);
+
+    Adafruit_GC9A01A tft(DISPLAY_CS_PIN, DISPLAY_DC_PIN, DISPLAY_RST_PIN);
+    tft.begin();
+    FontRenderer renderer;
+
+    static const char* path_names[] = { "atlas + SPI", "atlas compose", "GFX print" };
+    printf("%d stringhe per prova, band buffer %d pixel\n", iterations, TEXT_BAND_PIXELS);
+    printf("%-10s %-15s %-14s %10s %12s %10s %9s  %s\n", "stringa", "testo", "percorso", "us/str",
+           "glifi/s", "byte SPI", "finestre", "");
+
+    int failures = 0;
+    for (const TextCase& c : cases) {
+        size_t glyphs = strlen(c.text);
+        uint16_t width = renderer.measure(*c.font, c.text);
+        int bands = draw_atlas(tft, renderer, *c.font, c.text, 100, false);
+        unsigned long box_bytes = (unsigned long)width * c.font->height * 2 + BENCH_WINDOW_BYTES;
+
+        for (int path = 0; path < 3; path++) {
+            PathResult result = measure(tft, renderer, c, path, iterations);
+            double us = (double)result.best_cycles / hal_cycles_per_us() / iterations;
+            const char* error = nullptr;
+            if (path == 0 && (result.windows != 1 || result.bytes != box_bytes)) {
+                error = "box non inviato con una finestra";
+            }
+            if (error) failures++;
+            printf("%-10s %-15s %-14s %10.2f %12.0f %10lu %9lu  %s\n", c.name, c.text, path_names[path], us,
+                   us > 0.0 ? glyphs / us * 1000000.0 : 0.0, result.bytes, result.windows,
+                   error ? error : path == 0 && bands > 1 ? "a bande" : "");
+        }
+    }
+
+    FontRenderer::Stats stats = renderer.getStats();
+    printf("Cache larghezze: %lu hit, %lu miss\n", stats.width_cache_hits, stats.width_cache_misses);
+
+    if (failures) {
+        fprintf(stderr, "%d prove con esito diverso dall'atteso\n", failures);
+        return 1;
+    }
+    return 0;
+}
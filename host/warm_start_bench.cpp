@@ -0,0 +1,241 @@
+/*
+ * warm_start_bench: verifica del warm start con l'NVS simulato
+ *  1. boot a freddo (NVS vuoto) e prima parte del tragitto: lo stato viene
+ *     salvato con la politica di config.h (STATE_SAVE_*)
+ *  2. spegnimento e riavvio con la stessa NVS, seconda parte del tragitto
+ *  3. la seconda parte ripetuta da freddo, come riferimento
+ * Per ogni boot: stato ripristinato, centro del database, CPU del caricamento e
+ * del primo check, scansioni complete del database, scritture NVS.
+ * Fallisce (exit 1) se il riavvio non ripristina posizione e working set o se il
+ * primo check scansiona tutto il database più del boot a freddo.
+ *
+ *   warm_start_bench --drive FILE.nmea [--fs DIR] [--split PCT]
+ *
+ * --drive  Frasi NMEA del tragitto (es. generate con make_replay_drive.py)
+ * --fs     Directory usata come LittleFS con speedcams.json (default: data)
+ * --split  Punto dello spegnimento, in percentuale del tragitto (default: 50)
+ */
+
+#include <Arduino.h>
+#include "host_sim.h"
+#include "hal.h"
+#include "arena.h"
+#include "gps_controller.h"
+#include "speedcam_controller.h"
+#include "display_controller.h"
+#include "state_store.h"
+
+// UART del GPS (GPSController usa HardwareSerial(1)), 9600 baud 8N1
+#define WARM_GPS_UART 1
+#define WARM_GPS_BYTES_PER_MS 0.96
+// Passo del loop simulato
+#define WARM_STEP_MS 10
+// Tempo simulato dopo la fine del segmento, per svuotare la UART
+#define WARM_TAIL_MS 2000
+
+/**
+ * Misure di un boot
+ */
+struct BootResult {
+    const char* name;
+    bool position_restored;
+    bool candidates_restored;
+    float center_lat;
+    float center_lng;
+    int loaded;
+    uint32_t load_us;
+    unsigned long fixes;
+    uint32_t first_check_us;
+    unsigned long first_check_full_scans;
+    unsigned long full_scans;
+    unsigned long detections;
+    unsigned long nvs_writes;
+};
+
+static bool read_file(const char* path, std::string& out) {
+    FILE* fp = fopen(path, "rb");
+    if (!fp) return false;
+    char buffer[4096];
+    size_t n;
+    while ((n = fread(buffer, 1, sizeof(buffer), fp)) > 0) {
+        out.append(buffer, n);
+    }
+    fclose(fp);
+    return true;
+}
+
+/**
+ * Accensione, setup come lo sketch e guida del segmento [from, to) del tragitto
+ */
+static bool run_boot(const std::string& nmea, size_t from, size_t to, BootResult& result) {
+    // Riavvio: la RAM statica torna vuota, l'NVS resta
+    for (uint8_t i = 0; i < ARENA_REGION_COUNT; i++) {
+        arena_get((ArenaRegion)i).reset();
+    }
+
+    DisplayController display;
+    GPSController gps;
+    SpeedcamController speedcams;
+    StateStore state_store;
+    if (!display.begin() || !gps.begin() || !speedcams.begin(&gps, &display)) {
+        fprintf(stderr, "warm_start_bench: inizializzazione controller fallita\n");
+        return false;
+    }
+
+    state_store.begin(&gps, &speedcams);
+    uint32_t t0 = hal_cycles();
+    if (!speedcams.loadDatabase(SPEEDCAM_JSON_PATH, state_store.lastKnownPosition())) {
+        fprintf(stderr, "warm_start_bench: %s/%s non caricato\n", host_fs_root(), SPEEDCAM_JSON_PATH + 1);
+        return false;
+    }
+    state_store.restore();
+    result.load_us = (hal_cycles() - t0) / hal_cycles_per_us();
+    // Un check per ogni fix, come replay_bench
+    speedcams.setCheckInterval(0);
+
+    const SpeedcamLoadStats& load = speedcams.getLoadStats();
+    result.center_lat = load.center_lat;
+    result.center_lng = load.center_lng;
+    result.loaded = speedcams.getSpeedcamCount();
+
+    uint32_t nvs_writes_start = host_nvs_writes();
+    double last_lat = 0.0;
+    double last_lng = 0.0;
+    unsigned long start = millis();
+    size_t sent = from;
+    unsigned long duration = (unsigned long)((to - from) / WARM_GPS_BYTES_PER_MS) + WARM_TAIL_MS;
+
+    while (millis() - start < duration) {
+        host_clock_advance_us(WARM_STEP_MS * 1000UL);
+        size_t due = min(from + (size_t)((millis() - start) * WARM_GPS_BYTES_PER_MS), to);
+        if (due > sent) {
+            host_serial_feed(WARM_GPS_UART, nmea.data() + sent, due - sent);
+            sent = due;
+        }
+
+        gps.update();
+        GPSPosition position = gps.getPosition();
+        bool new_fix = position.is_valid &&
+                       (position.latitude != last_lat || position.longitude != last_lng);
+        if (new_fix) {
+            last_lat = position.latitude;
+            last_lng = position.longitude;
+
+            unsigned long scans_before = speedcams.getStats().full_scans;
+            t0 = hal_cycles();
+            speedcams.checkSpeedcams(&position);
+            uint32_t check_us = (hal_cycles() - t0) / hal_cycles_per_us();
+            if (result.fixes == 0) {
+                result.first_check_us = check_us;
+                result.first_check_full_scans = speedcams.getStats().full_scans - scans_before;
+            }
+            result.fixes++;
+        }
+        display.update();
+        state_store.update();
+    }
+
+    StateStore::Stats store_stats = state_store.getStats();
+    SpeedcamController::Stats stats = speedcams.getStats();
+    result.position_restored = store_stats.position_restored;
+    result.candidates_restored = store_stats.candidates_restored;
+    result.full_scans = stats.full_scans;
+    result.detections = stats.detections_count;
+    result.nvs_writes = host_nvs_writes() - nvs_writes_start;
+    return true;
+}
+
+static void write_boot(const BootResult& r, bool last) {
+    printf("    {\"boot\": \"%s\", \"position_restored\": %s, \"candidates_restored\": %s, "
+           "\"center\": [%.6f, %.6f], \"loaded\": %d, \"load_us\": %u, \"fixes\": %lu, "
+           "\"first_check_us\": %u, \"first_check_full_scans\": %lu, \"full_scans\": %lu, "
+           "\"detections\": %lu, \"nvs_writes\": %lu}%s\n",
+           r.name, r.position_restored ? "true" : "false", r.candidates_restored ? "true" : "false",
+           r.center_lat, r.center_lng, r.loaded, r.load_us, r.fixes,
+           r.first_check_us, r.first_check_full_scans, r.full_scans,
+           r.detections, r.nvs_writes, last ? "" : ",");
+}
+
+int main(int argc, char** argv) {
+    const char* fs_dir = "data";
+    const char* drive_path = nullptr;
+    float split_pct = 50.0f;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--fs") == 0 && i + 1 < argc) {
+            fs_dir = argv[++i];
+        } else if (strcmp(argv[i], "--drive") == 0 && i + 1 < argc) {
+            drive_path = argv[++i];
+        } else if (strcmp(argv[i], "--split") == 0 && i + 1 < argc) {
+            split_pct = atof(argv[++i]);
+        } else {
+            drive_path = nullptr;
+            break;
+        }
+    }
+    if (!drive_path || split_pct <= 0.0f || split_pct >= 100.0f) {
+        fprintf(stderr, "uso: %s --drive FILE.nmea [--fs DIR] [--split PCT]\n", argv[0]);
+        return 2;
+    }
+
+    std::string nmea;
+    if (!read_file(drive_path, nmea)) {
+        fprintf(stderr, "warm_start_bench: impossibile aprire %s\n", drive_path);
+        return 2;
+    }
+
+    // Spegnimento a fine riga: il riavvio riprende da una frase intera
+    size_t split = (size_t)(nmea.size() * split_pct / 100.0f);
+    while (split < nmea.size() && nmea[split - 1] != '\n') split++;
+
+    host_fs_set_root(fs_dir);
+    host_clock_use_virtual(true);
+    host_serial_mute(true);
+
+    BootResult cold = {};
+    BootResult warm = {};
+    BootResult reference = {};
+    cold.name = "cold";
+    warm.name = "warm";
+    reference.name = "cold_reference";
+
+    // 1-2. Boot a freddo e riavvio sulla stessa NVS
+    host_nvs_set_path(nullptr);
+    if (!run_boot(nmea, 0, split, cold) || !run_boot(nmea, split, nmea.size(), warm)) {
+        return 2;
+    }
+    // 3. Stesso segmento del riavvio, NVS vuota
+    host_nvs_erase();
+    if (!run_boot(nmea, split, nmea.size(), reference)) {
+        return 2;
+    }
+
+    bool restored = warm.position_restored && warm.candidates_restored;
+    bool scans_ok = warm.first_check_full_scans <= reference.first_check_full_scans;
+    bool ok = restored && scans_ok;
+
+    printf("{\n");
+    printf("  \"drive\": \"%s\",\n", drive_path);
+    printf("  \"split_pct\": %.1f,\n", split_pct);
+    printf("  \"boots\": [\n");
+    write_boot(cold, false);
+    write_boot(warm, false);
+    write_boot(reference, true);
+    printf("  ],\n");
+    printf("  \"ok\": %s\n", ok ? "true" : "false");
+    printf("}\n");
+
+    if (!restored) {
+        fprintf(stderr, "❌ Riavvio senza stato: posizione %s, working set %s\n",
+                warm.position_restored ? "ripristinata" : "assente",
+                warm.candidates_restored ? "ripristinato" : "assente");
+    }
+    if (!scans_ok) {
+        fprintf(stderr, "❌ Primo check dopo il riavvio: %lu scansioni complete (a freddo %lu)\n",
+                warm.first_check_full_scans, reference.first_check_full_scans);
+    }
+    fprintf(stderr, "%s Warm start: primo check %u µs (a freddo %u µs), %lu scritture NVS in %lu fix\n",
+            ok ? "✅" : "❌", warm.first_check_us, reference.first_check_us,
+            cold.nvs_writes, cold.fixes);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,300 @@
+#!/usr/bin/env python3
+"""
+Compila le strade con speedcam nel file dei corridoi (src/corridor_map.h)
+- strade da GeoJSON (LineString o MultiLineString, es. esportate da
+  OpenStreetMap con osmtogeojson o ogr2ogr), semplificate con Douglas-Peucker
+  entro --tolerance metri
+- ogni speedcam di speedcams.json viene agganciata alla strada più vicina
+  entro --attach metri (con "heading", solo a strade con quella direzione);
+  restano solo le strade con almeno una speedcam agganciata
+- coordinate quantizzate a 1e-5 gradi, in chunk di al più 64 punti relativi a
+  un'origine (int16), con bounding box e progressive in metri
+- header di 32 byte: magic "MNCR", formato, conteggi, CRC-32 dei dati e
+  CRC-32 dell'header
+
+Sul dispositivo (/corridors.bin, CORRIDOR_PATH) ogni check associa posizione e
+rotta a un corridoio: le speedcam agganciate danno l'alert solo viaggiando
+sulla loro strada e verso di esse, non da strade laterali o cavalcavia. Le
+speedcam non agganciate restano alla sola distanza. Il file deve stare in
+CORRIDOR_RAM_BUDGET: se non ci sta aumenta --tolerance o riduci le strade.
+
+Uso:
+    python3 make_corridors.py --roads FILE [--json FILE] [--out FILE]
+                              [--tolerance M] [--attach M] [--budget BYTE]
+"""
+
+import argparse
+import json
+import math
+import os
+import struct
+import sys
+import zlib
+
+SCRIPT_DIR = os.path.dirname(os.path.abspath(__file__))
+DATA_DIR = os.path.join(SCRIPT_DIR, "data")
+
+# Devono coincidere con src/corridor_map.h e CORRIDOR_RAM_BUDGET in src/config.h
+CORRIDOR_MAGIC = 0x52434E4D
+CORRIDOR_FORMAT = 1
+CORRIDOR_SCALE = 100000
+CORRIDOR_METERS_PER_UNIT = 1.11194927
+CORRIDOR_CHUNK_POINTS = 64
+CORRIDOR_RAM_BUDGET = 16384
+CHUNK_MAX_DELTA = 32000          # Punti entro l'int16 dall'origine del chunk
+CHUNK_MAX_LENGTH_M = 60000       # Progressive nel chunk entro l'uint16
+HEADING_TOLERANCE = 45.0         # Come SPEEDCAM_HEADING_TOLERANCE
+
+HEADER_NO_CRC = struct.Struct("<IHHIIIII")   # Header senza header_crc (28 byte)
+CHUNK = struct.Struct("<iihhhhIHHI")          # struct CorridorChunk
+POINT = struct.Struct("<hhH")                 # struct CorridorPoint
+CAMERA = struct.Struct("<IHHI")               # struct CorridorCamera
+
+METERS_PER_DEGREE = CORRIDOR_METERS_PER_UNIT * CORRIDOR_SCALE
+
+
+def load_roads(path):
+    """Polilinee [(lat, lng), ...] delle LineString del GeoJSON"""
+    with open(path) as f:
+        data = json.load(f)
+    features = data.get("features", [data]) if isinstance(data, dict) else []
+    roads = []
+    for feature in features:
+        geometry = feature.get("geometry") if feature.get("type") == "Feature" else feature
+        if not geometry:
+            continue
+        if geometry.get("type") == "LineString":
+            parts = [geometry["coordinates"]]
+        elif geometry.get("type") == "MultiLineString":
+            parts = geometry["coordinates"]
+        else:
+            continue
+        for part in parts:
+            line = [(float(p[1]), float(p[0])) for p in part if len(p) >= 2]
+            if len(line) >= 2:
+                roads.append(line)
+    return roads
+
+
+def simplify(points, tolerance):
+    """Douglas-Peucker in metri (equirettangolare attorno alla strada)"""
+    if len(points) < 3 or tolerance <= 0:
+        return list(points)
+    cos_lat = math.cos(math.radians(sum(p[0] for p in points) / len(points)))
+    xy = [(p[1] * cos_lat * METERS_PER_DEGREE, p[0] * METERS_PER_DEGREE) for p in points]
+    keep = [False] * len(points)
+    keep[0] = keep[-1] = True
+    stack = [(0, len(points) - 1)]
+    while stack:
+        first, last = stack.pop()
+        ax, ay = xy[first]
+        bx, by = xy[last]
+        dx, dy = bx - ax, by - ay
+        length = math.hypot(dx, dy)
+        worst, worst_index = 0.0, -1
+        for i in range(first + 1, last):
+            px, py = xy[i]
+            if length == 0.0:
+                distance = math.hypot(px - ax, py - ay)
+            else:
+                distance = abs(dx * (ay - py) - dy * (ax - px)) / length
+            if distance > worst:
+                worst, worst_index = distance, i
+        if worst > tolerance:
+            keep[worst_index] = True
+            stack.append((first, worst_index))
+            stack.append((worst_index, last))
+    return [p for p, k in zip(points, keep) if k]
+
+
+def quantize(points):
+    """Coordinate intere (1e-5 gradi) senza punti ripetuti"""
+    result = []
+    for lat, lng in points:
+        q = (round(lat * CORRIDOR_SCALE), round(lng * CORRIDOR_SCALE))
+        if not result or q != result[-1]:
+            result.append(q)
+    return result
+
+
+def segment_length(a, b):
+    """Come corridor_bench: equirettangolare alla latitudine media del segmento"""
+    cos_mid = math.cos(math.radians((a[0] + b[0]) / 2 / CORRIDOR_SCALE))
+    dy = (b[0] - a[0]) * CORRIDOR_METERS_PER_UNIT
+    dx = (b[1] - a[1]) * CORRIDOR_METERS_PER_UNIT * cos_mid
+    return math.hypot(dx, dy)
+
+
+def progressives(road):
+    arc = [0.0]
+    for a, b in zip(road, road[1:]):
+        arc.append(arc[-1] + segment_length(a, b))
+    return arc
+
+
+def valid_coordinate(value):
+    """Come is_valid_float() sul dispositivo: finita e diversa da 0"""
+    return isinstance(value, (int, float)) and math.isfinite(value) and value != 0.0
+
+
+def attach_camera(sc, roads, arcs, boxes, max_distance):
+    """(strada, progressiva, distanza) del segmento più vicino, None oltre max_distance"""
+    lat, lng = sc["lat"] * CORRIDOR_SCALE, sc["lng"] * CORRIDOR_SCALE
+    cos_lat = math.cos(math.radians(sc["lat"]))
+    reach_lat = max_distance / CORRIDOR_METERS_PER_UNIT
+    reach_lng = reach_lat / max(cos_lat, 0.01)
+    heading = sc.get("heading")
+    direction = None
+    if isinstance(heading, (int, float)) and math.isfinite(heading):
+        direction = (math.sin(math.radians(heading)), math.cos(math.radians(heading)))
+    min_cos = math.cos(math.radians(HEADING_TOLERANCE))
+
+    best = None
+    for r, road in enumerate(roads):
+        min_lat, min_lng, max_lat, max_lng = boxes[r]
+        if lat < min_lat - reach_lat or lat > max_lat + reach_lat or \
+                lng < min_lng - reach_lng or lng > max_lng + reach_lng:
+            continue
+        for i, (a, b) in enumerate(zip(road, road[1:])):
+            ax, ay = (a[1] - lng) * cos_lat, a[0] - lat
+            sx, sy = (b[1] - lng) * cos_lat - ax, b[0] - lat - ay
+            length2 = sx * sx + sy * sy
+            if length2 == 0:
+                continue
+            if direction:
+                dot = (sx * direction[0] + sy * direction[1]) / math.sqrt(length2)
+                if abs(dot) < min_cos:
+                    continue
+            t = min(max(-(ax * sx + ay * sy) / length2, 0.0), 1.0)
+            distance = math.hypot(ax + t * sx, ay + t * sy) * CORRIDOR_METERS_PER_UNIT
+            if distance <= max_distance and (best is None or distance < best[2]):
+                best = (r, arcs[r][i] + t * (arcs[r][i + 1] - arcs[r][i]), distance)
+    return best
+
+
+def build_chunks(road, arc, corridor, chunks, points):
+    """Chunk consecutivi della strada, il punto di confine è in entrambi"""
+    i = 0
+    while i + 1 < len(road):
+        lat0, lng0 = road[i]
+        start = round(arc[i])
+        first_point = len(points)
+        box = [0, 0, 0, 0]
+        j = i
+        while j < len(road) and j - i < CORRIDOR_CHUNK_POINTS:
+            dlat, dlng = road[j][0] - lat0, road[j][1] - lng0
+            if abs(dlat) > CHUNK_MAX_DELTA or abs(dlng) > CHUNK_MAX_DELTA or \
+                    arc[j] - arc[i] > CHUNK_MAX_LENGTH_M:
+                break
+            points.append(POINT.pack(dlat, dlng, round(arc[j] - start)))
+            box = [min(box[0], dlat), min(box[1], dlng), max(box[2], dlat), max(box[3], dlng)]
+            j += 1
+        if j - i < 2:
+            # Segmento più lungo del raggio di un chunk: le coordinate non starebbero in int16
+            raise ValueError(f"segmento oltre {CHUNK_MAX_DELTA / CORRIDOR_SCALE:.2f} gradi nella strada {corridor}")
+        chunks.append(CHUNK.pack(lat0, lng0, box[0], box[1], box[2], box[3],
+                                 first_point, j - i, corridor, start))
+        i = j - 1
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Strade GeoJSON + speedcams.json -> corridoi per ESP32")
+    parser.add_argument("--roads", required=True, help="Strade (GeoJSON con LineString)")
+    parser.add_argument("--json", default=os.path.join(DATA_DIR, "speedcams.json"),
+                        help="Database JSON (array \"result\")")
+    parser.add_argument("--out", default=os.path.join(DATA_DIR, "corridors.bin"),
+                        help="File dei corridoi (caricato su LittleFS)")
+    parser.add_argument("--tolerance", type=float, default=10.0,
+                        help="Scarto massimo della semplificazione in metri (default 10)")
+    parser.add_argument("--attach", type=float, default=30.0,
+                        help="Distanza massima speedcam-strada in metri (default 30)")
+    parser.add_argument("--budget", type=int, default=CORRIDOR_RAM_BUDGET,
+                        help=f"Dimensione massima del file (CORRIDOR_RAM_BUDGET, default {CORRIDOR_RAM_BUDGET})")
+    args = parser.parse_args()
+
+    print("🛣️  Compilazione corridoi stradali...")
+    try:
+        raw_roads = load_roads(args.roads)
+    except (OSError, ValueError, KeyError, TypeError, IndexError) as e:
+        print(f"   ❌ {args.roads} non valido: {e}")
+        return 1
+    try:
+        with open(args.json) as f:
+            speedcams = json.load(f)["result"]
+    except (OSError, ValueError, KeyError, TypeError) as e:
+        print(f"   ❌ {args.json} non valido: {e}")
+        return 1
+    if not raw_roads:
+        print(f"   ❌ Nessuna LineString in {args.roads}")
+        return 1
+
+    roads = [quantize(simplify(road, args.tolerance)) for road in raw_roads]
+    roads = [road for road in roads if len(road) >= 2]
+    arcs = [progressives(road) for road in roads]
+    boxes = [(min(p[0] for p in road), min(p[1] for p in road),
+              max(p[0] for p in road), max(p[1] for p in road)) for road in roads]
+
+    # Aggancio: speedcam -> strada più vicina
+    attached = {}
+    ids = set()
+    for sc in speedcams:
+        if not isinstance(sc, dict) or not valid_coordinate(sc.get("lat")) or \
+                not valid_coordinate(sc.get("lng")):
+            continue
+        sc_id = int(sc.get("id", 0)) & 0xFFFFFFFF
+        if sc_id in ids:
+            continue
+        ids.add(sc_id)
+        best = attach_camera(sc, roads, arcs, boxes, args.attach)
+        if best:
+            attached[sc_id] = best
+
+    # Solo le strade con speedcam, rinumerate nell'ordine del GeoJSON
+    used = sorted({road for road, _, _ in attached.values()})
+    if len(used) > 0xFFFE:
+        print(f"   ❌ Troppe strade con speedcam: {len(used)}")
+        return 1
+    corridor_of = {road: corridor for corridor, road in enumerate(used)}
+
+    chunks, points = [], []
+    try:
+        for road in used:
+            build_chunks(roads[road], arcs[road], corridor_of[road], chunks, points)
+    except ValueError as e:
+        print(f"   ❌ {e}")
+        return 1
+    cameras = [CAMERA.pack(sc_id, corridor_of[road], 0, round(position))
+               for sc_id, (road, position, _) in sorted(attached.items())]
+
+    point_bytes = b"".join(points)
+    point_bytes += b"\0" * (-len(point_bytes) % 4)
+    payload = b"".join(chunks) + point_bytes + b"".join(cameras)
+    header = HEADER_NO_CRC.pack(CORRIDOR_MAGIC, CORRIDOR_FORMAT, len(used), len(chunks), len(points),
+                                len(cameras), zlib.crc32(payload), 0)
+    header += struct.pack("<I", zlib.crc32(header))
+    size = len(header) + len(payload)
+
+    raw_points = sum(len(road) for road in raw_roads)
+    kept_points = sum(len(roads[road]) for road in used)
+    print(f"   Strade: {len(raw_roads)} lette, {len(used)} con speedcam")
+    print(f"   Punti: {raw_points} -> {kept_points} (tolleranza {args.tolerance:.0f} m), {len(chunks)} chunk")
+    print(f"   Speedcam agganciate: {len(attached)} di {len(ids)} (entro {args.attach:.0f} m)")
+    if size > args.budget:
+        print(f"   ❌ {size} byte oltre il budget di {args.budget}: aumenta --tolerance o riduci le strade")
+        return 1
+
+    os.makedirs(os.path.dirname(os.path.abspath(args.out)), exist_ok=True)
+    # Scrittura atomica sul PC: il file compare solo completo
+    tmp_path = args.out + ".tmp"
+    with open(tmp_path, "wb") as f:
+        f.write(header)
+        f.write(payload)
+    os.replace(tmp_path, args.out)
+
+    print(f"   ✅ {args.out}: {size} byte (budget {args.budget})")
+    print(f"   CRC dati: {zlib.crc32(payload):08x}")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
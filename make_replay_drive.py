@@ -0,0 +1,208 @@
+#!/usr/bin/env python3
+"""
+Genera un tragitto di prova per replay_bench (build host)
+- NMEA: frasi RMC + GGA a 1 Hz lungo un percorso a tratti rettilinei
+- speedcams.json: speedcam lungo il percorso (stesso formato del database SCDB)
+
+Uso:
+    python3 make_replay_drive.py [--out DIR] [--duration S] [--speed KMH]
+                                 [--cameras N] [--noise M] [--seed N]
+                                 [--directional] [--reverse]
+
+Con --directional le speedcam sul percorso hanno un "heading": a rotazione
+nella direzione di marcia, in quella opposta e bidirezionali; le speedcam
+fuori percorso restano lontane dal tragitto. --reverse percorre lo stesso
+tragitto al contrario con lo stesso database (stesso --seed): le speedcam
+che devono dare un alert nei due versi sono diverse e il numero atteso viene
+stampato per replay_bench --expect-alerts.
+
+Con un tragitto registrato dal modulo GPS (log NMEA della UART) non serve:
+replay_bench accetta qualsiasi file NMEA.
+"""
+
+import argparse
+import json
+import math
+import os
+import random
+
+SCRIPT_DIR = os.path.dirname(os.path.abspath(__file__))
+
+# Partenza: stessa zona di data/fake_gps.json (dentro il pre-filtro Nord Italia)
+START_LAT = 43.66
+START_LNG = 13.15
+EARTH_RADIUS = 6371000.0
+
+
+def nmea_checksum(body):
+    """XOR dei caratteri tra '$' e '*'"""
+    value = 0
+    for c in body:
+        value ^= ord(c)
+    return f"{value:02X}"
+
+
+def nmea_sentence(body):
+    return f"${body}*{nmea_checksum(body)}\r\n"
+
+
+def nmea_coord(value, is_lat):
+    """Gradi decimali -> ddmm.mmmmm / dddmm.mmmmm con emisfero"""
+    hemisphere = ("N" if value >= 0 else "S") if is_lat else ("E" if value >= 0 else "W")
+    value = abs(value)
+    degrees = int(value)
+    minutes = (value - degrees) * 60.0
+    width = 2 if is_lat else 3
+    return f"{degrees:0{width}d}{minutes:08.5f}", hemisphere
+
+
+def move(lat, lng, course, distance):
+    """Sposta un punto di distance metri lungo course (gradi, 0 = nord)"""
+    rad = math.radians(course)
+    dlat = distance * math.cos(rad) / EARTH_RADIUS
+    dlng = distance * math.sin(rad) / (EARTH_RADIUS * math.cos(math.radians(lat)))
+    return lat + math.degrees(dlat), lng + math.degrees(dlng)
+
+
+def build_route(duration, speed_kmh, rng):
+    """Punti a 1 Hz, con cambi di direzione ogni 2-4 minuti"""
+    points = []
+    lat, lng = START_LAT, START_LNG
+    course = 45.0
+    next_turn = rng.randint(120, 240)
+    step = speed_kmh / 3.6
+    for t in range(duration):
+        if t == next_turn:
+            course = (course + rng.uniform(-60.0, 60.0)) % 360.0
+            next_turn = t + rng.randint(120, 240)
+        points.append((t, lat, lng, course))
+        lat, lng = move(lat, lng, course, step)
+    return points
+
+
+def reverse_route(points):
+    """Stesso tragitto al contrario: tempi dall'inizio, rotta opposta"""
+    return [(t, lat, lng, (course + 180.0) % 360.0)
+            for t, (_, lat, lng, course) in enumerate(reversed(points))]
+
+
+def distance(lat1, lng1, lat2, lng2):
+    """Equirettangolare: basta per tenere lontane le speedcam fuori percorso"""
+    x = math.radians(lng2 - lng1) * math.cos(math.radians((lat1 + lat2) / 2.0))
+    y = math.radians(lat2 - lat1)
+    return math.hypot(x, y) * EARTH_RADIUS
+
+
+def write_nmea(path, points, speed_kmh, noise, rng):
+    with open(path, "w") as f:
+        for t, lat, lng, course in points:
+            # Rumore di posizione del ricevitore
+            jitter_lat, jitter_lng = move(lat, lng, rng.uniform(0, 360), abs(rng.gauss(0, noise)))
+            hh, mm, ss = (t // 3600) % 24, (t // 60) % 60, t % 60
+            stamp = f"{10 + hh:02d}{mm:02d}{ss:02d}.00"
+            lat_s, lat_h = nmea_coord(jitter_lat, True)
+            lng_s, lng_h = nmea_coord(jitter_lng, False)
+            knots = speed_kmh / 1.852
+            f.write(nmea_sentence(
+                f"GPRMC,{stamp},A,{lat_s},{lat_h},{lng_s},{lng_h},{knots:.2f},{course:.1f},010125,,,A"))
+            f.write(nmea_sentence(
+                f"GPGGA,{stamp},{lat_s},{lat_h},{lng_s},{lng_h},1,08,1.2,50.0,M,47.0,M,,"))
+
+
+def write_speedcams(path, points, count, rng, directional=False):
+    """Speedcam sul percorso (a qualche metro dalla carreggiata) più altre lontane
+    Ritorna le speedcam sul percorso attese in andata e al ritorno"""
+    result = []
+    expected = {"forward": 0, "reverse": 0}
+    if count > 0:
+        spacing = max(1, len(points) // (count + 1))
+        for i in range(count):
+            _, lat, lng, course = points[min((i + 1) * spacing, len(points) - 1)]
+            lat, lng = move(lat, lng, course + 90.0, rng.uniform(5.0, 20.0))
+            speedcam = {
+                "id": 9000 + i,
+                "lat": round(lat, 6),
+                "lng": round(lng, 6),
+                "type": "1",
+                "vmax": rng.choice(["50", "70", "90", "110"]),
+                "status": "A",
+                "art": "1",
+            }
+            if directional:
+                # Direzione di marcia, opposta (altra carreggiata), bidirezionale
+                kind = i % 3
+                speedcam["heading"] = round((course + (180.0 if kind == 1 else 0.0)) % 360.0, 1)
+                if kind == 2:
+                    speedcam["bidirectional"] = True
+                expected["forward"] += kind != 1
+                expected["reverse"] += kind != 0
+            else:
+                expected["forward"] += 1
+                expected["reverse"] += 1
+            result.append(speedcam)
+    # Speedcam fuori percorso: popolano il database come quello reale
+    # (con --directional oltre 2 km dal tragitto, così gli alert attesi sono esatti)
+    route = points[::10]
+    placed = 0
+    while placed < count * 20:
+        lat = START_LAT + rng.uniform(-0.5, 0.5)
+        lng = START_LNG + rng.uniform(-0.5, 0.5)
+        if directional and any(distance(lat, lng, p[1], p[2]) < 2000.0 for p in route):
+            continue
+        i = placed
+        placed += 1
+        result.append({
+            "id": 20000 + i,
+            "lat": round(lat, 6),
+            "lng": round(lng, 6),
+            "type": "1",
+            "vmax": "50",
+            "status": "A",
+            "art": "1",
+        })
+    with open(path, "w") as f:
+        json.dump({"result": result}, f, indent=1)
+    return expected
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Genera tragitto NMEA e speedcam per replay_bench")
+    parser.add_argument("--out", default=os.path.join(SCRIPT_DIR, "build", "replay"),
+                        help="Directory di output (usata poi come --fs)")
+    parser.add_argument("--duration", type=int, default=900, help="Durata in secondi (fix a 1 Hz)")
+    parser.add_argument("--speed", type=float, default=90.0, help="Velocità in km/h")
+    parser.add_argument("--cameras", type=int, default=10, help="Speedcam lungo il percorso")
+    parser.add_argument("--noise", type=float, default=3.0, help="Rumore di posizione in metri")
+    parser.add_argument("--seed", type=int, default=1, help="Seed (tragitti riproducibili)")
+    parser.add_argument("--directional", action="store_true",
+                        help="Speedcam con heading (nella direzione, opposta, bidirezionali)")
+    parser.add_argument("--reverse", action="store_true",
+                        help="Percorre il tragitto al contrario (stesso database)")
+    args = parser.parse_args()
+
+    rng = random.Random(args.seed)
+    os.makedirs(args.out, exist_ok=True)
+
+    print("🚗 Generazione tragitto di replay...")
+    points = build_route(args.duration, args.speed, rng)
+    nmea_path = os.path.join(args.out, "drive_reverse.nmea" if args.reverse else "drive.nmea")
+    write_nmea(nmea_path, reverse_route(points) if args.reverse else points, args.speed, args.noise, rng)
+    print(f"   ✅ {nmea_path}: {len(points)} fix a {args.speed:.0f} km/h{' (al contrario)' if args.reverse else ''}")
+
+    # Database dal tragitto in andata: identico con e senza --reverse
+    speedcam_path = os.path.join(args.out, "speedcams.json")
+    expected = write_speedcams(speedcam_path, points, args.cameras, rng, args.directional)
+    print(f"   ✅ {speedcam_path}: {args.cameras} speedcam sul percorso"
+          f"{' con direzione' if args.directional else ''}")
+
+    print("")
+    print("▶️  Esegui:")
+    if args.directional:
+        alerts = expected["reverse" if args.reverse else "forward"]
+        print(f"   build/replay_bench --fs {args.out} --drive {nmea_path} --expect-alerts {alerts}")
+    else:
+        print(f"   build/replay_bench --fs {args.out} --drive {nmea_path} --report replay_report.json")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,804 @@
+#!/usr/bin/env python3
+"""
+Compila speedcams.json nel database binario versionato (src/speedcam_db.h)
+- validazione: coordinate finite, diverse da 0 ed entro ±90°/±180°, id intero
+  tra 1 e 2^32-1 (0 è "nessuna speedcam" sul dispositivo), id ripetuti scartati
+  (resta il primo); il dispositivo non ricontrolla le coordinate a ogni scansione
+- normalizzazione: "type" senza spazi e in maiuscolo, "status" 'A' (attivo) o
+  'L' (inattivo: qualunque altro valore, come lo mostra il dispositivo)
+- speedcam quasi identiche unite (entro --dedup-m metri, stesso type, limiti e
+  direzioni compatibili): resta la prima del JSON, con il limite e la
+  direzione dell'altra se le mancano
+- header di 32 byte: magic "MNDB", formato, versione, numero record, CRC-32
+  dei record e CRC-32 dell'header
+- record di 24 byte con il layout di struct Speedcam (little-endian), ordinati
+  per chiave di Hilbert (src/hilbert_index.h): il dispositivo non deve
+  riordinarli al caricamento
+- "vmax" convertito in intero (km/h, 0 se assente o non numerico) al posto
+  della stringa: il dispositivo non lo interpreta più a ogni allerta
+- campi opzionali "heading" (direzione di marcia controllata, gradi) e
+  "bidirectional" (anche la direzione opposta) negli ultimi due byte del
+  record, a zero senza heading: i file senza direzioni non cambiano
+- record compressi a blocchi di --block-records record (default
+  BLOCK_RECORDS_DEFAULT, 0 = non compressi): ogni blocco trasposto per byte e
+  compresso in formato di blocco LZ4, con un indice per chiave di Hilbert; il
+  dispositivo ne decomprime uno alla volta (circa metà della flash dello slot)
+
+Il dispositivo usa due slot, /speedcams_a.bin e /speedcams_b.bin: al boot carica
+lo slot valido con la versione più alta; il comando seriale 'U'
+(SPEEDCAM_DB_UPDATE_COMMAND) cerca una versione più recente e la carica in
+background. Un file corrotto viene rifiutato e resta il database attivo.
+
+Con --patch-from SLOT_FILE (lo slot presente sul dispositivo) scrive invece la
+patch /speedcams.patch: record inseriti, rimossi e modificati per id rispetto
+a quello slot, che il dispositivo applica durante il caricamento senza
+riscriverlo (pochi KB sulla flash invece dell'intero database). Le patch
+successive si generano dallo stesso slot e sostituiscono la precedente.
+
+Uso:
+    python3 make_speedcam_db.py [--json FILE] [--out DIR] [--slot a|b|auto] [--version N]
+                                [--dedup-m M] [--dry-run] [--patch-from SLOT_FILE]
+                                [--block-records N]
+
+Senza --slot scrive nello slot inattivo (quello con la versione più bassa in
+--out), senza --version usa la versione più alta trovata + 1. Con --dry-run
+valida e stampa le statistiche senza scrivere lo slot.
+"""
+
+import argparse
+import json
+import math
+import os
+import struct
+import sys
+import time
+import zlib
+
+SCRIPT_DIR = os.path.dirname(os.path.abspath(__file__))
+DATA_DIR = os.path.join(SCRIPT_DIR, "data")
+
+# Devono coincidere con src/speedcam_db.h e SPEEDCAM_DB_SLOT_A/B in src/config.h
+DB_MAGIC = 0x42444E4D
+DB_FORMAT = 2
+DB_RECORD_SIZE = 24
+# Direzione controllata (src/speedcam.h)
+SPEEDCAM_DIRECTION_ANY = 0
+SPEEDCAM_DIRECTION_ONE = 1
+SPEEDCAM_DIRECTION_BOTH = 2
+SPEEDCAM_VMAX_MAX = 300
+SLOT_FILES = {"a": "speedcams_a.bin", "b": "speedcams_b.bin"}
+PATCH_FILE = "speedcams.patch"                # SPEEDCAM_DB_PATCH in src/config.h
+BLOCK_RECORDS_MAX = 64                        # SPEEDCAM_DB_BLOCK_RECORDS_MAX in src/config.h
+BLOCK_RECORDS_DEFAULT = 64
+BLOCK_STORED = 0x8000
+PATCH_MAGIC = 0x50444E4D
+PATCH_FORMAT = 1
+
+HEADER_NO_CRC = struct.Struct("<IHHIIIII")   # Header senza header_crc (28 byte)
+RECORD = struct.Struct("<Iff4sHxxccBB")       # struct Speedcam
+FLOAT32 = struct.Struct("<f")
+PATCH_HEADER_NO_CRC = struct.Struct("<IHHIIIIIIII")   # SpeedcamDbPatchHeader senza header_crc (40 byte)
+PATCH_OP = struct.Struct("<B3xI")                     # SpeedcamDbPatchOp
+RECORD_ID = struct.Struct("<I")
+BLOCK_INDEX = struct.Struct("<II")                    # SpeedcamDbBlock
+BLOCK_SIZE = struct.Struct("<H")
+RECORD_POSITION = struct.Struct("<ff")                # lat, lng dopo l'id
+
+# Formato di blocco LZ4 (src/lz4_block.h)
+LZ4_MIN_MATCH = 4
+LZ4_LAST_LITERALS = 5       # L'ultima sequenza ha almeno 5 letterali
+LZ4_MATCH_LIMIT = 12        # Nessun match che inizi negli ultimi 12 byte
+LZ4_MAX_OFFSET = 65535
+
+# Devono coincidere con src/hilbert_index.cpp
+HILBERT_BITS = 16
+HILBERT_SIDE = 1 << HILBERT_BITS
+
+# Speedcam quasi identiche: distanza di default e scarto di direzione (angolo binario, ~11°)
+DEDUP_DEFAULT_M = 5.0
+DEDUP_HEADING_TOLERANCE = 8
+METERS_PER_DEGREE = 6371000.0 * math.pi / 180.0
+
+
+def read_version(path):
+    """Versione di uno slot esistente con header valido, 0 altrimenti"""
+    try:
+        with open(path, "rb") as f:
+            header = f.read(HEADER_NO_CRC.size + 4)
+    except OSError:
+        return 0
+    if len(header) != HEADER_NO_CRC.size + 4:
+        return 0
+    fields = HEADER_NO_CRC.unpack(header[:HEADER_NO_CRC.size])
+    (header_crc,) = struct.unpack("<I", header[HEADER_NO_CRC.size:])
+    if fields[0] != DB_MAGIC or zlib.crc32(header[:HEADER_NO_CRC.size]) != header_crc:
+        return 0
+    return fields[3]
+
+
+def read_slot(path):
+    """Header (campi senza header_crc) e record di uno slot verificato: ValueError se non valido"""
+    with open(path, "rb") as f:
+        data = f.read()
+    size = HEADER_NO_CRC.size + 4
+    if len(data) < size:
+        raise ValueError("file troncato")
+    fields = HEADER_NO_CRC.unpack(data[:HEADER_NO_CRC.size])
+    (header_crc,) = struct.unpack("<I", data[HEADER_NO_CRC.size:size])
+    if fields[0] != DB_MAGIC or fields[1] != DB_FORMAT or fields[2] != DB_RECORD_SIZE:
+        raise ValueError("non è un database di formato " + str(DB_FORMAT))
+    if zlib.crc32(data[:HEADER_NO_CRC.size]) != header_crc:
+        raise ValueError("CRC dell'header errato")
+    payload = data[size:]
+    if fields[7]:
+        payload = decompress_records(payload, fields[4], fields[7])
+    if len(payload) != fields[4] * DB_RECORD_SIZE or zlib.crc32(payload) != fields[6]:
+        raise ValueError("record troncati o CRC dei record errato")
+    return fields, payload
+
+
+def read_patch_version(path):
+    """Versione risultante di una patch esistente con header valido, 0 altrimenti"""
+    try:
+        with open(path, "rb") as f:
+            header = f.read(PATCH_HEADER_NO_CRC.size + 4)
+    except OSError:
+        return 0
+    if len(header) != PATCH_HEADER_NO_CRC.size + 4:
+        return 0
+    fields = PATCH_HEADER_NO_CRC.unpack(header[:PATCH_HEADER_NO_CRC.size])
+    (header_crc,) = struct.unpack("<I", header[PATCH_HEADER_NO_CRC.size:])
+    if fields[0] != PATCH_MAGIC or zlib.crc32(header[:PATCH_HEADER_NO_CRC.size]) != header_crc:
+        return 0
+    return fields[5]
+
+
+def short_string(value, length=3):
+    """Come JSONParser::safeStringCopy: al più length caratteri, terminati da NUL"""
+    text = "" if value is None else str(value)
+    return text.encode("ascii", "replace")[:length].ljust(length + 1, b"\0")
+
+
+def first_char(value):
+    text = "" if value is None else str(value)
+    return text.encode("ascii", "replace")[:1] or b" "
+
+
+def type_value(value):
+    """"type" senza spazi e in maiuscolo ("g50 " -> "G50"), al più 3 caratteri"""
+    text = "" if value is None else str(value)
+    return text.strip().upper()[:3]
+
+
+def status_value(value):
+    """'A' se attivo, altrimenti 'L': il dispositivo mostra "inattivo" per ogni valore diverso da 'A'"""
+    text = "" if value is None else str(value).strip()
+    return "A" if text[:1].upper() == "A" else "L"
+
+
+def id_value(value):
+    """id intero tra 1 e 2^32-1 (anche come testo di cifre), None se non valido"""
+    if isinstance(value, bool):
+        return None
+    if isinstance(value, float) and value.is_integer():
+        value = int(value)
+    elif isinstance(value, str) and value.strip().isdigit():
+        value = int(value.strip())
+    if not isinstance(value, int) or not 0 < value <= 0xFFFFFFFF:
+        return None
+    return value
+
+
+def float32(value):
+    return FLOAT32.unpack(FLOAT32.pack(value))[0]
+
+
+def vmax_value(value):
+    """Come JSONParser::parseSpeedcam: km/h da numero o cifre iniziali, 0 se sconosciuto"""
+    if isinstance(value, bool):
+        return 0
+    if isinstance(value, int):
+        return value if 0 < value <= SPEEDCAM_VMAX_MAX else 0
+    digits = ""
+    for c in value if isinstance(value, str) else "":
+        if not "0" <= c <= "9":
+            break
+        digits += c
+        if int(digits) > SPEEDCAM_VMAX_MAX:
+            return 0
+    return int(digits) if digits else 0
+
+
+def heading_fields(sc):
+    """heading/direction come JSONParser::parseSpeedcam (heading_to_binary in float32)"""
+    heading = sc.get("heading")
+    if isinstance(heading, bool) or not isinstance(heading, (int, float)) or not math.isfinite(heading):
+        return 0, SPEEDCAM_DIRECTION_ANY
+    scaled = float32(float32(heading) * float32(256.0 / 360.0))
+    # lroundf: metà lontano da zero, poi modulo 256
+    binary = int(math.floor(abs(scaled) + 0.5)) * (1 if scaled >= 0 else -1)
+    both = sc.get("bidirectional")
+    both = isinstance(both, (bool, int, float)) and both != 0
+    direction = SPEEDCAM_DIRECTION_BOTH if both else SPEEDCAM_DIRECTION_ONE
+    return binary & 0xFF, direction
+
+
+def hilbert_quantize(value, minimum, extent):
+    """Come quantize() in hilbert_index.cpp (calcolo in double)"""
+    q = (value - minimum) * (HILBERT_SIDE / extent)
+    if not q > 0.0:
+        return 0
+    if q >= HILBERT_SIDE - 1:
+        return HILBERT_SIDE - 1
+    return int(q)
+
+
+def hilbert_table(bits):
+    """
+    key_xy() di hilbert_index.cpp a bits bit per passo: le trasformazioni dei
+    bit successivi (scambio x/y, complemento) formano quattro stati; per stato e
+    blocco di bit di x e y, le cifre della chiave e lo stato successivo
+    """
+    table = []
+    for state in range(4):
+        for xy in range(1 << (2 * bits)):
+            x, y = xy >> bits, xy & ((1 << bits) - 1)
+            swap, complement = state & 1, state >> 1
+            digits = 0
+            for level in range(bits - 1, -1, -1):
+                rx, ry = (x >> level) & 1, (y >> level) & 1
+                if complement:
+                    rx, ry = 1 - rx, 1 - ry
+                if swap:
+                    rx, ry = ry, rx
+                digits = (digits << 2) | ((3 * rx) ^ ry)
+                if ry == 0:
+                    swap ^= 1
+                    complement ^= rx
+            table.append((digits, (complement << 1) | swap))
+    return table
+
+
+HILBERT_STEP_BITS = 4
+HILBERT_TABLE = hilbert_table(HILBERT_STEP_BITS)
+
+
+def hilbert_key(lat, lng):
+    """Chiave di Hilbert delle coordinate arrotondate a float32, come hilbert_key()"""
+    lat = FLOAT32.unpack(FLOAT32.pack(lat))[0]
+    lng = FLOAT32.unpack(FLOAT32.pack(lng))[0]
+    x = hilbert_quantize(lng, -180.0, 360.0)
+    y = hilbert_quantize(lat, -90.0, 180.0)
+    key = 0
+    state = 0
+    mask = (1 << HILBERT_STEP_BITS) - 1
+    for shift in range(HILBERT_BITS - HILBERT_STEP_BITS, -1, -HILBERT_STEP_BITS):
+        xy = (((x >> shift) & mask) << HILBERT_STEP_BITS) | ((y >> shift) & mask)
+        digits, state = HILBERT_TABLE[(state << (2 * HILBERT_STEP_BITS)) | xy]
+        key = (key << (2 * HILBERT_STEP_BITS)) | digits
+    return key
+
+
+def valid_position(lat, lng):
+    """
+    Come speedcam_position_valid() sul dispositivo: coordinate arrotondate a
+    float32 se valide, None altrimenti
+    """
+    if isinstance(lat, bool) or isinstance(lng, bool) or \
+            not isinstance(lat, (int, float)) or not isinstance(lng, (int, float)):
+        return None
+    if not math.isfinite(lat) or not math.isfinite(lng):
+        return None
+    lat, lng = float32(lat), float32(lng)
+    if lat == 0.0 or lng == 0.0 or abs(lat) > 90.0 or abs(lng) > 180.0:
+        return None
+    return lat, lng
+
+
+def validate_speedcams(speedcams, stats):
+    """Speedcam con coordinate e id validi (id ripetuti: resta la prima), campi normalizzati"""
+    cameras = []
+    ids = set()
+    for sc in speedcams:
+        position = valid_position(sc.get("lat"), sc.get("lng")) if isinstance(sc, dict) else None
+        if position is None:
+            stats["invalid_position"] += 1
+            continue
+        speedcam_id = id_value(sc.get("id"))
+        if speedcam_id is None:
+            stats["invalid_id"] += 1
+            continue
+        if speedcam_id in ids:
+            stats["duplicate_id"] += 1
+            continue
+        ids.add(speedcam_id)
+
+        raw_type = sc.get("type")
+        raw_status = sc.get("status")
+        heading, direction = heading_fields(sc)
+        camera = {
+            "id": speedcam_id,
+            "lat": position[0],
+            "lng": position[1],
+            "type": type_value(raw_type),
+            "vmax": vmax_value(sc.get("vmax")),
+            "status": status_value(raw_status),
+            "art": first_char(sc.get("art")),
+            "heading": heading,
+            "direction": direction,
+        }
+        if camera["type"] != ("" if raw_type is None else str(raw_type)[:3]):
+            stats["type_normalized"] += 1
+        if camera["status"] != raw_status:
+            stats["status_normalized"] += 1
+        cameras.append(camera)
+    return cameras
+
+
+def same_camera(a, b, dedup_m):
+    """Stessa speedcam: entro dedup_m, stesso type, limiti e direzioni compatibili"""
+    if a["type"] != b["type"]:
+        return False
+    if a["vmax"] and b["vmax"] and a["vmax"] != b["vmax"]:
+        return False
+    if a["direction"] != SPEEDCAM_DIRECTION_ANY and b["direction"] != SPEEDCAM_DIRECTION_ANY:
+        diff = (a["heading"] - b["heading"]) & 0xFF
+        if a["direction"] != b["direction"] or min(diff, 256 - diff) > DEDUP_HEADING_TOLERANCE:
+            return False
+    # Equirettangolare: a pochi metri l'errore è trascurabile
+    dy = (a["lat"] - b["lat"]) * METERS_PER_DEGREE
+    dx = (a["lng"] - b["lng"]) * METERS_PER_DEGREE * math.cos(math.radians(a["lat"]))
+    return dx * dx + dy * dy <= dedup_m * dedup_m
+
+
+def dedup_speedcams(cameras, dedup_m, stats):
+    """
+    Unisce le speedcam quasi identiche: resta la prima, con il limite e la
+    direzione dell'altra se le mancano
+    """
+    # Griglia in gradi con celle di 2 * dedup_m, in longitudine alla latitudine più alta
+    # dei dati: una speedcam entro dedup_m sta nella stessa cella o in quella adiacente
+    # verso il bordo più vicino (2 x 2 celle per speedcam)
+    max_lat = max((abs(camera["lat"]) for camera in cameras), default=0.0)
+    cell_lat = 2.0 * dedup_m / METERS_PER_DEGREE
+    cell_lng = cell_lat / max(math.cos(math.radians(min(max_lat, 89.0))), 0.01)
+    grid = {}
+    kept = []
+    for camera in cameras:
+        fx = camera["lng"] / cell_lng
+        fy = camera["lat"] / cell_lat
+        cx, cy = math.floor(fx), math.floor(fy)
+        nx = cx - 1 if fx - cx < 0.5 else cx + 1
+        ny = cy - 1 if fy - cy < 0.5 else cy + 1
+        match = None
+        for cell in ((cx, cy), (nx, cy), (cx, ny), (nx, ny)):
+            for other in grid.get(cell, ()):
+                if same_camera(other, camera, dedup_m):
+                    match = other
+                    break
+            if match:
+                break
+        if match:
+            if not match["vmax"]:
+                match["vmax"] = camera["vmax"]
+            if match["direction"] == SPEEDCAM_DIRECTION_ANY:
+                match["heading"], match["direction"] = camera["heading"], camera["direction"]
+            stats["merged"] += 1
+            continue
+        grid.setdefault((cx, cy), []).append(camera)
+        kept.append(camera)
+    return kept
+
+
+def compile_speedcams(speedcams, dedup_m):
+    """Valida, normalizza e unisce le speedcam quasi identiche: (speedcam, statistiche)"""
+    stats = {"input": len(speedcams), "invalid_position": 0, "invalid_id": 0, "duplicate_id": 0,
+             "merged": 0, "type_normalized": 0, "status_normalized": 0}
+    cameras = validate_speedcams(speedcams, stats)
+    if dedup_m > 0.0:
+        cameras = dedup_speedcams(cameras, dedup_m, stats)
+    stats["vmax_unknown"] = sum(1 for camera in cameras if not camera["vmax"])
+    stats["output"] = len(cameras)
+    return cameras, stats
+
+
+def build_records(cameras):
+    """Record ordinati per chiave di Hilbert (stabile: a parità resta l'ordine del JSON)"""
+    records = [(hilbert_key(camera["lat"], camera["lng"]), RECORD.pack(
+        camera["id"],
+        camera["lat"],
+        camera["lng"],
+        short_string(camera["type"]),
+        camera["vmax"],
+        camera["status"].encode("ascii"),
+        camera["art"],
+        camera["heading"],
+        camera["direction"],
+    )) for camera in cameras]
+    records.sort(key=lambda record: record[0])
+    return b"".join(record for _, record in records)
+
+
+def lz4_length(out, value):
+    while value >= 255:
+        out.append(255)
+        value -= 255
+    out.append(value)
+
+
+def lz4_sequence(out, literals, offset, length):
+    """Una sequenza: token, letterali, offset e lunghezza del match (offset 0: ultima, solo letterali)"""
+    match = length - LZ4_MIN_MATCH if offset else 0
+    out.append((min(len(literals), 15) << 4) | min(match, 15))
+    if len(literals) >= 15:
+        lz4_length(out, len(literals) - 15)
+    out += literals
+    if offset:
+        out += offset.to_bytes(2, "little")
+        if match >= 15:
+            lz4_length(out, match - 15)
+
+
+def lz4_compress(data):
+    """Compressione greedy in formato di blocco LZ4 (stesso algoritmo di host/db_compress_bench.cpp)"""
+    out = bytearray()
+    last = {}                   # Ultima posizione di ogni sequenza di 4 byte
+    anchor = 0
+    i = 0
+    match_end = len(data) - LZ4_LAST_LITERALS
+    while i < len(data) - LZ4_MATCH_LIMIT:
+        key = data[i:i + LZ4_MIN_MATCH]
+        candidate = last.get(key)
+        last[key] = i
+        if candidate is None or i - candidate > LZ4_MAX_OFFSET:
+            i += 1
+            continue
+        length = LZ4_MIN_MATCH
+        while i + length + 8 <= match_end and data[candidate + length:candidate + length + 8] == \
+                data[i + length:i + length + 8]:
+            length += 8
+        while i + length < match_end and data[candidate + length] == data[i + length]:
+            length += 1
+        lz4_sequence(out, data[anchor:i], i - candidate, length)
+        i += length
+        anchor = i
+        last[data[i - 2:i + 2]] = i - 2
+    lz4_sequence(out, data[anchor:], 0, 0)
+    return bytes(out)
+
+
+def lz4_decompress(data, size):
+    """Come lz4_block_decompress(): ValueError se il blocco non è valido"""
+    out = bytearray()
+    i = 0
+
+    def length(value):
+        nonlocal i
+        if value == 15:
+            while True:
+                byte = data[i]
+                i += 1
+                value += byte
+                if byte != 255:
+                    break
+        return value
+
+    try:
+        while i < len(data):
+            token = data[i]
+            i += 1
+            literals = length(token >> 4)
+            out += data[i:i + literals]
+            i += literals
+            if i >= len(data):
+                break
+            offset = data[i] | (data[i + 1] << 8)
+            i += 2
+            match = length(token & 0x0F) + LZ4_MIN_MATCH
+            if offset == 0 or offset > len(out):
+                raise ValueError("offset non valido")
+            for _ in range(match):
+                out.append(out[-offset])
+    except IndexError:
+        raise ValueError("blocco troncato") from None
+    if len(out) != size:
+        raise ValueError("dimensione del blocco errata")
+    return bytes(out)
+
+
+def compress_records(payload, block_records):
+    """
+    Indice e blocchi di uno slot compresso (src/speedcam_db.h): record trasposti
+    per byte e compressi; un blocco che non si riduce resta trasposto e basta
+    """
+    step = block_records * DB_RECORD_SIZE
+    chunks = [payload[offset:offset + step] for offset in range(0, len(payload), step)]
+    offset = HEADER_NO_CRC.size + 4 + len(chunks) * BLOCK_INDEX.size
+    index = bytearray()
+    blocks = bytearray()
+    for chunk in chunks:
+        lat, lng = RECORD_POSITION.unpack_from(chunk, RECORD_ID.size)
+        index += BLOCK_INDEX.pack(offset + len(blocks), hilbert_key(lat, lng))
+        shuffled = b"".join(chunk[j::DB_RECORD_SIZE] for j in range(DB_RECORD_SIZE))
+        compressed = lz4_compress(shuffled)
+        if len(compressed) < len(shuffled):
+            blocks += BLOCK_SIZE.pack(len(compressed)) + compressed
+        else:
+            blocks += BLOCK_SIZE.pack(len(shuffled) | BLOCK_STORED) + shuffled
+    return bytes(index + blocks)
+
+
+def decompress_records(data, count, block_records):
+    """Record di uno slot compresso (per --patch-from): ValueError se non valido"""
+    blocks = (count + block_records - 1) // block_records
+    offset = blocks * BLOCK_INDEX.size
+    out = bytearray()
+    for block in range(blocks):
+        records = min(block_records, count - block * block_records)
+        raw = records * DB_RECORD_SIZE
+        if offset + BLOCK_SIZE.size > len(data):
+            raise ValueError("blocchi troncati")
+        (size,) = BLOCK_SIZE.unpack_from(data, offset)
+        offset += BLOCK_SIZE.size
+        stored = size & ~BLOCK_STORED
+        chunk = data[offset:offset + stored]
+        offset += stored
+        shuffled = chunk if size & BLOCK_STORED else lz4_decompress(chunk, raw)
+        if len(shuffled) != raw:
+            raise ValueError("blocco troncato")
+        records_bytes = bytearray(raw)
+        for j in range(DB_RECORD_SIZE):
+            records_bytes[j::DB_RECORD_SIZE] = shuffled[j * records:(j + 1) * records]
+        out += records_bytes
+    if offset != len(data):
+        raise ValueError("byte in coda dopo l'ultimo blocco")
+    return bytes(out)
+
+
+def record_ids(payload):
+    return [RECORD_ID.unpack_from(payload, offset)[0] for offset in range(0, len(payload), DB_RECORD_SIZE)]
+
+
+def diff_records(base, target):
+    """
+    Op (tipo, arg, record) che trasformano i record base in target, nell'ordine di
+    target. Stesso id nello stesso punto: COPY se identico, MODIFY altrimenti.
+    Un id che cambia posizione (speedcam spostata, chiave di Hilbert diversa)
+    diventa DELETE + INSERT: dei due record fuori posto si sposta quello più
+    lontano dalla posizione corrente, così un solo spostamento non rompe le copie.
+    """
+    base_ids = record_ids(base)
+    target_ids = record_ids(target)
+    base_pos = {record_id: i for i, record_id in enumerate(base_ids)}
+    target_pos = {record_id: j for j, record_id in enumerate(target_ids)}
+    if len(base_pos) != len(base_ids):
+        raise ValueError("id ripetuti nella base")
+
+    ops = []
+
+    def emit(kind, arg, record=b""):
+        # COPY e INSERT consecutive in un'unica op
+        if ops and kind in (b"C", b"I") and ops[-1][0] == kind:
+            last = ops[-1]
+            ops[-1] = (kind, last[1] + arg, last[2] + record)
+        else:
+            ops.append((kind, arg, record))
+
+    moved = set()
+    i = j = 0
+    while i < len(base_ids) or j < len(target_ids):
+        if i < len(base_ids):
+            base_id = base_ids[i]
+            if base_id not in target_pos or base_id in moved:
+                emit(b"D", base_id)
+                i += 1
+                continue
+        target_id = target_ids[j]
+        target_record = target[j * DB_RECORD_SIZE:(j + 1) * DB_RECORD_SIZE]
+        if target_id not in base_pos or target_id in moved:
+            emit(b"I", 1, target_record)
+            j += 1
+            continue
+        if base_id == target_id:
+            if base[i * DB_RECORD_SIZE:(i + 1) * DB_RECORD_SIZE] == target_record:
+                emit(b"C", 1)
+            else:
+                emit(b"M", base_id, target_record)
+            i += 1
+            j += 1
+            continue
+        if target_pos[base_id] - j >= base_pos[target_id] - i:
+            moved.add(base_id)
+        else:
+            moved.add(target_id)
+    return ops
+
+
+def build_patch(base_fields, payload, version, ops):
+    """Patch (src/speedcam_db.h) dallo slot base_fields alla versione con questi record"""
+    body = b"".join(PATCH_OP.pack(kind[0], arg) + record for kind, arg, record in ops)
+    header = PATCH_HEADER_NO_CRC.pack(PATCH_MAGIC, PATCH_FORMAT, DB_RECORD_SIZE, base_fields[3], base_fields[6],
+                                      version, len(payload) // DB_RECORD_SIZE, int(time.time()),
+                                      zlib.crc32(payload), len(ops), 0)
+    return header + struct.pack("<I", zlib.crc32(header)) + body
+
+
+def apply_patch(base, patch):
+    """Record risultanti (come SpeedcamDbReader sul dispositivo): verifica prima di scrivere la patch"""
+    fields = PATCH_HEADER_NO_CRC.unpack_from(patch)
+    offset = PATCH_HEADER_NO_CRC.size + 4
+    out = []
+    base_next = 0
+    for _ in range(fields[9]):
+        kind, arg = PATCH_OP.unpack_from(patch, offset)
+        offset += PATCH_OP.size
+        if kind == ord("C"):
+            out.append(base[base_next * DB_RECORD_SIZE:(base_next + arg) * DB_RECORD_SIZE])
+            base_next += arg
+        elif kind == ord("I"):
+            out.append(patch[offset:offset + arg * DB_RECORD_SIZE])
+            offset += arg * DB_RECORD_SIZE
+        else:
+            if RECORD_ID.unpack_from(base, base_next * DB_RECORD_SIZE)[0] != arg:
+                raise ValueError(f"op {chr(kind)}: id {arg} non nella posizione attesa")
+            base_next += 1
+            if kind == ord("M"):
+                out.append(patch[offset:offset + DB_RECORD_SIZE])
+                offset += DB_RECORD_SIZE
+    if offset != len(patch) or base_next * DB_RECORD_SIZE != len(base):
+        raise ValueError("op o record della base in eccesso")
+    return b"".join(out)
+
+
+def write_file(path, data):
+    # Scrittura atomica sul PC: il file compare solo completo
+    tmp_path = path + ".tmp"
+    with open(tmp_path, "wb") as f:
+        f.write(data)
+    os.replace(tmp_path, path)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="speedcams.json -> database binario A/B per ESP32")
+    parser.add_argument("--json", default=os.path.join(DATA_DIR, "speedcams.json"),
+                        help="Database JSON (array \"result\")")
+    parser.add_argument("--out", default=DATA_DIR, help="Directory degli slot (caricata su LittleFS)")
+    parser.add_argument("--slot", choices=["a", "b", "auto"], default="auto",
+                        help="Slot da scrivere (default: quello inattivo)")
+    parser.add_argument("--version", type=int, default=0,
+                        help="Versione del database (default: la più alta negli slot + 1)")
+    parser.add_argument("--dedup-m", type=float, default=DEDUP_DEFAULT_M,
+                        help=f"Unisce le speedcam quasi identiche entro questa distanza "
+                             f"(default: {DEDUP_DEFAULT_M:g}m, 0 = mai)")
+    parser.add_argument("--dry-run", action="store_true",
+                        help="Valida e stampa le statistiche senza scrivere lo slot")
+    parser.add_argument("--patch-from", metavar="SLOT_FILE",
+                        help=f"Scrive in --out solo la patch ({PATCH_FILE}) dallo slot presente sul "
+                             f"dispositivo invece dell'intero slot")
+    parser.add_argument("--block-records", type=int, default=BLOCK_RECORDS_DEFAULT, metavar="N",
+                        help=f"Record per blocco compresso (default: {BLOCK_RECORDS_DEFAULT}, "
+                             f"max {BLOCK_RECORDS_MAX}, 0 = slot non compresso)")
+    args = parser.parse_args()
+    if args.dedup_m < 0.0 or not math.isfinite(args.dedup_m):
+        parser.error("--dedup-m deve essere >= 0")
+    if not 0 <= args.block_records <= BLOCK_RECORDS_MAX:
+        parser.error(f"--block-records deve essere tra 0 e {BLOCK_RECORDS_MAX}")
+
+    print("🗄️  Compilazione database speedcam...")
+    start = time.monotonic()
+    try:
+        with open(args.json) as f:
+            speedcams = json.load(f)["result"]
+        if not isinstance(speedcams, list):
+            raise TypeError("\"result\" non è un array")
+    except (OSError, ValueError, KeyError, TypeError) as e:
+        print(f"   ❌ {args.json} non valido: {e}")
+        return 1
+
+    cameras, stats = compile_speedcams(speedcams, args.dedup_m)
+    payload = build_records(cameras)
+    count = len(cameras)
+    elapsed = time.monotonic() - start
+
+    print(f"   📊 {stats['input']} speedcam nel JSON -> {count} nel database ({elapsed:.2f}s)")
+    discarded = [(stats["invalid_position"], "coordinate non valide"), (stats["invalid_id"], "id non valido"),
+                 (stats["duplicate_id"], "id ripetuto")]
+    for value, reason in discarded:
+        if value:
+            print(f"   ⚠️  {value} scartate: {reason}")
+    if stats["merged"]:
+        print(f"   🔗 {stats['merged']} unite a una speedcam entro {args.dedup_m:g}m")
+    if stats["type_normalized"] or stats["status_normalized"]:
+        print(f"   🔧 Normalizzati: {stats['type_normalized']} type, {stats['status_normalized']} status")
+    if stats["vmax_unknown"]:
+        print(f"   ℹ️  {stats['vmax_unknown']} senza limite (vmax 0)")
+    if not count:
+        print("   ❌ Nessuna speedcam valida")
+        return 1
+    if args.dry_run:
+        return 0
+
+    if args.patch_from:
+        return write_patch(args, payload)
+
+    versions = {slot: read_version(os.path.join(args.out, name)) for slot, name in SLOT_FILES.items()}
+    version = args.version or max(versions.values()) + 1
+    slot = args.slot
+    if slot == "auto":
+        slot = "a" if versions["a"] <= versions["b"] else "b"
+    if version < 1 or version > 0xFFFFFFFF:
+        print(f"   ❌ Versione non valida: {version}")
+        return 1
+    if version <= max(versions.values()):
+        print(f"   ⚠️  Versione {version} non più recente degli slot "
+              f"(A: {versions['a']}, B: {versions['b']}): il dispositivo non la caricherà")
+
+    header = HEADER_NO_CRC.pack(DB_MAGIC, DB_FORMAT, DB_RECORD_SIZE, version, count,
+                                int(time.time()), zlib.crc32(payload), args.block_records)
+    header += struct.pack("<I", zlib.crc32(header))
+
+    body = payload
+    if args.block_records:
+        start = time.monotonic()
+        body = compress_records(payload, args.block_records)
+        print(f"   🗜️  Blocchi da {args.block_records} record: {len(payload)} -> {len(body)} byte "
+              f"({len(payload) / len(body):.2f}:1, {time.monotonic() - start:.2f}s)")
+
+    os.makedirs(args.out, exist_ok=True)
+    path = os.path.join(args.out, SLOT_FILES[slot])
+    write_file(path, header + body)
+
+    print(f"   ✅ {path}: versione {version}, {count} speedcam ({len(header) + len(body)} byte)")
+    print(f"   CRC record: {zlib.crc32(payload):08x}")
+    return 0
+
+
+def write_patch(args, payload):
+    """Patch dallo slot --patch-from ai record compilati (versione come per uno slot)"""
+    try:
+        base_fields, base = read_slot(args.patch_from)
+    except (OSError, ValueError) as e:
+        print(f"   ❌ {args.patch_from} non valido: {e}")
+        return 1
+    base_version = base_fields[3]
+    # Dopo la base, gli slot in --out e la patch precedente (il dispositivo carica la più recente)
+    known = [base_version, read_patch_version(os.path.join(args.out, PATCH_FILE))]
+    known += [read_version(os.path.join(args.out, name)) for name in SLOT_FILES.values()]
+    version = args.version or max(known) + 1
+    if version <= base_version or version > 0xFFFFFFFF:
+        print(f"   ❌ Versione {version} non più recente della base ({base_version})")
+        return 1
+
+    start = time.monotonic()
+    try:
+        ops = diff_records(base, payload)
+    except ValueError as e:
+        print(f"   ❌ Patch non generabile: {e}, serve l'intero slot")
+        return 1
+    patch = build_patch(base_fields, payload, version, ops)
+    if apply_patch(base, patch) != payload:
+        print("   ❌ La patch applicata alla base non dà il database compilato")
+        return 1
+    elapsed = time.monotonic() - start
+
+    counts = {kind: 0 for kind in (b"C", b"D", b"M", b"I")}
+    for kind, arg, _ in ops:
+        counts[kind] += arg if kind in (b"C", b"I") else 1
+    full_size = HEADER_NO_CRC.size + 4 + len(payload)
+    print(f"   🧩 Patch dalla versione {base_version} alla {version} ({elapsed:.2f}s): "
+          f"{counts[b'I']} nuove, {counts[b'D']} rimosse, {counts[b'M']} modificate, {counts[b'C']} invariate")
+    print(f"   📦 {len(patch)} byte in {len(ops)} op invece di {full_size} byte "
+          f"({100.0 * len(patch) / full_size:.1f}%)")
+    if len(patch) >= full_size:
+        print("   ⚠️  La patch non è più piccola dello slot: conviene scrivere l'intero slot")
+
+    os.makedirs(args.out, exist_ok=True)
+    path = os.path.join(args.out, PATCH_FILE)
+    write_file(path, patch)
+    print(f"   ✅ {path}: per lo slot versione {base_version} (CRC {base_fields[6]:08x}), "
+          f"CRC record risultanti {zlib.crc32(payload):08x}")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
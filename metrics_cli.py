@@ -0,0 +1,187 @@
+#!/usr/bin/env python3
+"""
+Legge le metriche runtime dalla console seriale (metrics_console.h) e le salva in CSV
+- Invia 'H' (nomi dei campi) una volta, poi 'M' ogni --interval secondi
+- Una riga CSV per risposta: timestamp host + campi della board
+- Le righe di log sulla stessa seriale sono ignorate (o mostrate con --echo)
+- --window: invia 'R' dopo ogni lettura, percentili e contatori per intervallo
+
+Funziona con la board (/dev/ttyACM0, richiede pyserial) e con la build host
+collegata a uno pseudo-terminale (micronav_sketch --pty); sui pty e sulle
+seriali Linux/macOS senza pyserial usa termios direttamente.
+
+Uso:
+    python3 metrics_cli.py --port /dev/ttyACM0 -o metrics.csv
+    python3 metrics_cli.py --port /dev/pts/3 --interval 0.5 --count 20
+"""
+
+import argparse
+import csv
+import os
+import sys
+import time
+
+HEADER_PREFIX = "#MNH,"
+REPORT_PREFIX = "#MN,"
+RESET_PREFIX = "#MNR,"
+SUPPORTED_VERSION = 1
+COMMAND_REPORT = b"M"   # METRICS_COMMAND_* in config.h
+COMMAND_HEADER = b"H"
+COMMAND_RESET = b"R"
+
+
+class PosixLink:
+    """Seriale/pty via termios (fallback senza pyserial)"""
+
+    def __init__(self, port, baud):
+        import termios
+        import tty
+        self.fd = os.open(port, os.O_RDWR | os.O_NOCTTY | os.O_NONBLOCK)
+        tty.setraw(self.fd)
+        attrs = termios.tcgetattr(self.fd)
+        speed = getattr(termios, f"B{baud}", None)
+        if speed is not None:
+            attrs[4] = attrs[5] = speed
+            termios.tcsetattr(self.fd, termios.TCSANOW, attrs)
+        termios.tcflush(self.fd, termios.TCIFLUSH)
+
+    def write(self, data):
+        os.write(self.fd, data)
+
+    def read(self, timeout):
+        import select
+        ready, _, _ = select.select([self.fd], [], [], timeout)
+        if not ready:
+            return b""
+        try:
+            return os.read(self.fd, 4096)
+        except BlockingIOError:
+            return b""
+
+    def close(self):
+        os.close(self.fd)
+
+
+class PySerialLink:
+    def __init__(self, port, baud):
+        import serial
+        self.link = serial.Serial(port, baud, timeout=0)
+        self.link.reset_input_buffer()
+
+    def write(self, data):
+        self.link.write(data)
+
+    def read(self, timeout):
+        deadline = time.time() + timeout
+        while True:
+            chunk = self.link.read(4096)
+            if chunk or time.time() >= deadline:
+                return chunk
+            time.sleep(0.005)
+
+    def close(self):
+        self.link.close()
+
+
+def open_link(port, baud):
+    try:
+        return PySerialLink(port, baud)
+    except ImportError:
+        if os.name != "posix":
+            sys.exit("❌ pyserial non installato: pip install pyserial")
+        return PosixLink(port, baud)
+
+
+class LineReader:
+    """Spezza lo stream in righe, conserva i frammenti tra una lettura e l'altra"""
+
+    def __init__(self, link, echo):
+        self.link = link
+        self.echo = echo
+        self.pending = b""
+
+    def wait_for(self, prefix, timeout):
+        deadline = time.time() + timeout
+        while time.time() < deadline:
+            while b"\n" in self.pending:
+                raw, self.pending = self.pending.split(b"\n", 1)
+                line = raw.decode("utf-8", "replace").strip()
+                if line.startswith(prefix):
+                    return line
+                if self.echo and line:
+                    print(f"   {line}", file=sys.stderr)
+            self.pending += self.link.read(max(0.0, min(0.1, deadline - time.time())))
+        return None
+
+
+def parse_fields(line, prefix):
+    fields = line[len(prefix):].split(",")
+    version = int(fields[0])
+    if version != SUPPORTED_VERSION:
+        sys.exit(f"❌ Versione protocollo {version} non supportata (attesa {SUPPORTED_VERSION})")
+    return fields[1:]
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Metriche runtime MicroNav dalla seriale -> CSV")
+    parser.add_argument("--port", required=True, help="Seriale della board o pty della build host")
+    parser.add_argument("--baud", type=int, default=115200, help="Baudrate seriale")
+    parser.add_argument("--interval", type=float, default=1.0, help="Secondi tra due letture")
+    parser.add_argument("--count", type=int, default=0, help="Numero di letture (0 = fino a Ctrl+C)")
+    parser.add_argument("--timeout", type=float, default=2.0, help="Attesa massima di una risposta in secondi")
+    parser.add_argument("--window", action="store_true", help="Azzera le metriche dopo ogni lettura")
+    parser.add_argument("--echo", action="store_true", help="Mostra su stderr le righe di log della board")
+    parser.add_argument("-o", "--output", help="File CSV (default: stdout)")
+    args = parser.parse_args()
+
+    link = open_link(args.port, args.baud)
+    reader = LineReader(link, args.echo)
+
+    link.write(COMMAND_HEADER)
+    header_line = reader.wait_for(HEADER_PREFIX, args.timeout)
+    if header_line is None:
+        sys.exit(f"❌ Nessuna risposta da {args.port} (firmware con METRICS_CONSOLE_ENABLED?)")
+    names = parse_fields(header_line, HEADER_PREFIX)
+    print(f"📡 {args.port}: {len(names)} campi", file=sys.stderr)
+
+    out = open(args.output, "w", newline="") if args.output else sys.stdout
+    writer = csv.writer(out)
+    writer.writerow(["host_time"] + names)
+    out.flush()
+
+    rows = 0
+    missed = 0
+    try:
+        while args.count == 0 or rows < args.count:
+            started = time.time()
+            link.write(COMMAND_REPORT)
+            line = reader.wait_for(REPORT_PREFIX, args.timeout)
+            if line is None:
+                missed += 1
+                print("⚠️  Nessuna risposta, riprovo", file=sys.stderr)
+                continue
+            values = parse_fields(line, REPORT_PREFIX)
+            writer.writerow([f"{started:.3f}"] + values[:len(names)])
+            out.flush()
+            rows += 1
+
+            if args.window:
+                link.write(COMMAND_RESET)
+                reader.wait_for(RESET_PREFIX, args.timeout)
+
+            remaining = args.interval - (time.time() - started)
+            if remaining > 0:
+                time.sleep(remaining)
+    except KeyboardInterrupt:
+        pass
+    finally:
+        link.close()
+        if args.output:
+            out.close()
+
+    print(f"✅ {rows} letture" + (f", {missed} senza risposta" if missed else "") +
+          (f" in {args.output}" if args.output else ""), file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
@@ -4,6 +4,13 @@
  */
 
 #include "src/config.h"
+#include "src/hal.h"
+#include "src/trace.h"
+#include "src/log.h"
+#include "src/arena.h"
+#include "src/loop_monitor.h"
+#include "src/metrics_console.h"
+#include "src/state_store.h"
 #include "src/gps_controller.h"
 #include "src/speedcam_controller.h"
 #include "src/display_controller.h"
@@ -14,6 +21,12 @@ GPSController* gps_controller = nullptr;
 SpeedcamController* speedcam_controller = nullptr;
 DisplayController* display_controller = nullptr;
 
+// Console metriche sulla seriale (python3 metrics_cli.py --port ...)
+MetricsConsole metrics_console;
+
+// Stato tra i riavvii in NVS: ultima posizione e working set (warm start)
+StateStore state_store;
+
 // Callback per aggiornamento posizione GPS
 void onGPSPositionUpdate(const GPSPosition& position) {
     // Aggiorna display con nuovo stato GPS
@@ -24,12 +37,38 @@ void onGPSPositionUpdate(const GPSPosition& position) {
         );
     }
     
+    // Tempo alla prima posizione valida elaborata (confronto boot bloccante/non bloccante)
+    static bool first_fix_logged = false;
+    if (!first_fix_logged && position.is_valid) {
+        first_fix_logged = true;
+        LOG_I(SETUP, "Prima posizione valida elaborata a %lu ms dall'avvio (boot logo %s)", millis(),
+              display_controller && !display_controller->isBootComplete() ? "in corso" : "terminato");
+    }
+    
     // Verifica speedcam (se posizione valida)
     if (position.is_valid && speedcam_controller) {
         speedcam_controller->checkSpeedcams(&position);
+#if OVERSPEED_ENABLED
+        // Avviso di velocità verso la speedcam dell'alert
+        speedcam_controller->updateOverspeed(position);
+#endif
+#if SECTION_CONTROL_ENABLED
+        // Tutor: media sulla tratta in corso (dopo il check, un alert ha la precedenza sul pannello)
+        speedcam_controller->updateSection(position);
+#endif
     }
 }
 
+// Attesa durante il setup che continua ad avanzare le animazioni del display:
+// il fade del boot logo procede mentre GPS e database vengono inizializzati
+static void setupDelay(unsigned long ms) {
+    unsigned long start = millis();
+    do {
+        if (display_controller) display_controller->update();
+        delay(1);
+    } while (millis() - start < ms);
+}
+
 void setup() {
     // Inizializza Serial per debug PRIMA di tutto
     // IMPORTANTE: USB CDC On Boot deve essere "Enabled" nelle impostazioni della board
@@ -45,10 +84,8 @@ void setup() {
     Serial.println("========================================");
     Serial.print("Baudrate: ");
     Serial.println(115200);
-    #ifdef ESP32
     Serial.print("Free heap: ");
-    Serial.println(ESP.getFreeHeap());
-    #endif
+    Serial.println(hal_free_heap());
     Serial.println("========================================\n");
     Serial.flush();
     delay(100);
@@ -57,6 +94,15 @@ void setup() {
     Serial.flush();
     delay(100);
     
+    // Durante il setup i log dei moduli sono stampati subito, in ordine con le righe [Setup]
+    log_begin(&Serial);
+    log_set_deferred(false);
+    
+    #ifdef TRACE_ENABLED
+    // Calibra il costo degli span prima di tracciare il setup
+    trace_begin();
+    #endif
+    
     // Crea istanze degli oggetti DOPO che Serial è inizializzato
     Serial.println("[Setup] Creazione oggetti controller...");
     Serial.flush();
@@ -85,18 +131,23 @@ void setup() {
         Serial.flush();
         delay(100);
         
-        // 2. Mostra boot logo
+        #ifdef DISPLAY_TEXT_BENCHMARK
+        display_controller->runTextBenchmark();
+        #endif
+        
+        // 2. Mostra boot logo (non bloccante: fade e permanenza avanzano in setupDelay()
+        // e tra i blocchi del caricamento del database, poi in loop())
         Serial.println("[Setup] Mostra boot logo...");
         Serial.flush();
         display_controller->showBootLogo(BOOT_LOGO_DISPLAY_TIME);
-        Serial.println("[Setup] Boot logo completato");
+        Serial.println("[Setup] Boot logo avviato");
         Serial.flush();
     }
     
     // 3. Inizializza GPS controller
     Serial.println("[Setup] Inizializzazione GPS...");
     Serial.flush();
-    delay(100);
+    setupDelay(100);
     
     #ifdef GPS_FAKE_MODE
     if (GPS_FAKE_MODE) {
@@ -127,18 +178,18 @@ void setup() {
         Serial.flush();
     }
     #endif
-    delay(100);
+    setupDelay(100);
     
     // Imposta callback per aggiornamento posizione GPS
     Serial.println("[Setup] Impostazione callback GPS...");
     Serial.flush();
     gps_controller->setPositionUpdateCallback(onGPSPositionUpdate);
-    delay(100);
+    setupDelay(100);
     
     // 4. Inizializza Speedcam controller
     Serial.println("[Setup] Inizializzazione Speedcam controller...");
     Serial.flush();
-    delay(100);
+    setupDelay(100);
     
     if (!speedcam_controller->begin(gps_controller, display_controller)) {
         Serial.println("[Setup] ERRORE: Speedcam controller non inizializzato!");
@@ -147,47 +198,78 @@ void setup() {
         Serial.println("[Setup] Speedcam controller inizializzato");
         Serial.flush();
     }
-    delay(100);
+    setupDelay(100);
     
     // 5. Carica database speedcam
     Serial.println("[Setup] Caricamento database speedcam...");
     Serial.flush();
-    delay(100);
+    setupDelay(100);
     
-    // Carica con pre-filtraggio geografico se abilitato
-    bool pre_filter = SPEEDCAM_PRE_FILTER_ENABLED;
-    Serial.print("[Setup] Pre-filtro geografico: ");
-    Serial.println(pre_filter ? "abilitato" : "disabilitato");
+    #if STATE_STORE_ENABLED
+    // Stato del boot precedente: il database viene caricato attorno all'ultima posizione nota
+    state_store.begin(gps_controller, speedcam_controller);
+    #endif
+    
+    // Array dimensionato sul file; oltre il budget RAM pre-filtro attorno alla posizione
+    Serial.print("[Setup] Pre-filtro geografico oltre budget: ");
+    Serial.println(SPEEDCAM_PRE_FILTER_ENABLED ? "abilitato" : "disabilitato");
     Serial.flush();
-    delay(100);
+    setupDelay(100);
+    
+    // Slot A/B del database binario (versione più alta con CRC valido), poi il JSON
+    bool database_loaded = speedcam_controller->loadDatabaseSlots(state_store.lastKnownPosition());
+    if (database_loaded) {
+        Serial.print("[Setup] Database binario: slot ");
+        Serial.println(speedcam_controller->getDatabaseSlot() == 0 ? "A" : "B");
+    } else {
+        database_loaded = speedcam_controller->loadDatabase(SPEEDCAM_JSON_PATH, state_store.lastKnownPosition());
+    }
     
-    if (!speedcam_controller->loadDatabase(
-            SPEEDCAM_JSON_PATH, 
-            pre_filter,
-            PRE_FILTER_MIN_LAT, PRE_FILTER_MAX_LAT,
-            PRE_FILTER_MIN_LNG, PRE_FILTER_MAX_LNG)) {
+    if (!database_loaded) {
         Serial.println("[Setup] ERRORE: Database speedcam non caricato!");
         Serial.println("[Setup] Assicurati che il file sia presente su LittleFS");
         Serial.flush();
     } else {
         Serial.println("[Setup] Database speedcam caricato con successo!");
         Serial.flush();
+        
+        // Working set salvato: il primo check non scansiona tutto il database
+        if (state_store.restore()) {
+            Serial.println("[Setup] Warm start: working set ripristinato");
+            Serial.flush();
+        }
+        
+        #if CORRIDOR_MATCHING_ENABLED
+        // Corridoi stradali (opzionali): alert solo per le speedcam della strada percorsa
+        Serial.print("[Setup] Corridoi stradali: ");
+        Serial.println(speedcam_controller->loadCorridors() ? "caricati" : "assenti (solo distanza)");
+        Serial.flush();
+        #endif
     }
-    delay(100);
+    setupDelay(100);
     
-    // 6. Mostra schermata idle
+    // 6. Mostra schermata idle (al termine del boot logo se ancora in corso)
     Serial.println("[Setup] Mostra schermata idle...");
     Serial.flush();
     if (display_controller) {
         display_controller->showIdleScreen();
     }
-    delay(100);
+    setupDelay(100);
     
     Serial.println("\n[Setup] ========================================");
     Serial.println("[Setup] Setup completato!");
     Serial.println("[Setup] In attesa di fix GPS...");
     Serial.println("[Setup] ========================================\n");
     Serial.flush();
+    
+    // Occupazione delle arene statiche dopo il boot (scratch già rilasciata)
+    arena_report();
+    
+    metrics_console.begin(&Serial, gps_controller, speedcam_controller, display_controller);
+    loop_monitor_begin();
+    
+    // Da qui i log sono differiti: formattati in loop() dopo il lavoro del ciclo
+    log_set_deferred(true);
 }
 
 void loop() {
@@ -197,6 +279,8 @@ void loop() {
         return;
     }
     
+    loop_monitor_iteration_start();
+    
     // 1. Aggiorna GPS (legge seriale e parse NMEA)
     gps_controller->update();
     
@@ -210,15 +294,7 @@ void loop() {
         if (position.is_valid) {
             speedcam_controller->checkSpeedcams(&position);
         } else {
-            #ifdef DEBUG_ENABLED
-            if (DEBUG_ENABLED) {
-                static unsigned long last_warn = 0;
-                if (millis() - last_warn > 5000) {
-                    Serial.println("[Loop] Posizione GPS non valida, skip check speedcam");
-                    last_warn = millis();
-                }
-            }
-            #endif
+            LOG_EVERY(LOG_LEVEL_DEBUG, LOOP, 5000, "Posizione GPS non valida, skip check speedcam");
         }
         last_speedcam_check = millis();
     }
@@ -226,6 +302,36 @@ void loop() {
     // 3. Aggiorna display (gestisce timeout alert, ecc.)
     display_controller->update();
     
-    // 4. Piccolo delay per evitare loop troppo veloce
-    delay(MAIN_LOOP_DELAY);
+    // 4. Stato per il warm start (scritture NVS rade, vedi STATE_SAVE_* in config.h)
+    #if STATE_STORE_ENABLED
+    state_store.update();
+    #endif
+    
+    // 5. Aggiornamento del database in background (SPEEDCAM_DB_LOAD_CHUNK record per ciclo)
+    speedcam_controller->updateDatabase();
+    
+    // 6. Stampa i log accodati durante il ciclo
+    log_flush();
+    
+    loop_monitor_iteration_end();
+    
+    // 7. Comandi dalla seriale: metriche (metrics_cli.py), dump del trace (trace_to_perfetto.py),
+    // ricerca di un aggiornamento del database negli slot A/B
+    int command = -1;
+    #if METRICS_CONSOLE_ENABLED
+    command = metrics_console.poll();
+    #else
+    if (Serial.available() > 0) command = Serial.read();
+    #endif
+    #ifdef TRACE_ENABLED
+    if (command == TRACE_DUMP_COMMAND) {
+        trace_dump(Serial);
+    }
+    #endif
+    if (command == SPEEDCAM_DB_UPDATE_COMMAND) {
+        speedcam_controller->requestDatabaseUpdate();
+    }
+    
+    // 8. Attesa fino al prossimo deadline (periodo fisso, non delay fisso)
+    loop_monitor_wait();
 }
@@ -0,0 +1,95 @@
+#include "animation.h"
+#include "log.h"
+
+AnimationScheduler::AnimationScheduler() {
+    for (uint8_t i = 0; i < ANIMATION_MAX_TWEENS; i++) {
+        tweens[i].active = false;
+    }
+    
+    stats.started = 0;
+    stats.completed = 0;
+    stats.cancelled = 0;
+    stats.updates = 0;
+}
+
+int8_t AnimationScheduler::start(unsigned long duration_ms, float from, float to,
+                                 UpdateCallback on_update, CompleteCallback on_complete, void* ctx) {
+    for (uint8_t i = 0; i < ANIMATION_MAX_TWEENS; i++) {
+        if (tweens[i].active) continue;
+        
+        Tween& tween = tweens[i];
+        tween.active = true;
+        tween.start_ms = millis();
+        tween.duration_ms = duration_ms;
+        tween.from = from;
+        tween.to = to;
+        tween.on_update = on_update;
+        tween.on_complete = on_complete;
+        tween.ctx = ctx;
+        stats.started++;
+        return i;
+    }
+    
+    LOG_E(ANIMATION, "Nessuno slot libero per il tween");
+    return -1;
+}
+
+int8_t AnimationScheduler::startTimer(unsigned long duration_ms, CompleteCallback on_complete, void* ctx) {
+    return start(duration_ms, 0.0f, 1.0f, nullptr, on_complete, ctx);
+}
+
+void AnimationScheduler::cancel(int8_t id) {
+    if (id < 0 || id >= ANIMATION_MAX_TWEENS || !tweens[id].active) return;
+    tweens[id].active = false;
+    stats.cancelled++;
+}
+
+bool AnimationScheduler::isActive(int8_t id) const {
+    return id >= 0 && id < ANIMATION_MAX_TWEENS && tweens[id].active;
+}
+
+bool AnimationScheduler::isBusy() const {
+    for (uint8_t i = 0; i < ANIMATION_MAX_TWEENS; i++) {
+        if (tweens[i].active) return true;
+    }
+    return false;
+}
+
+void AnimationScheduler::update(unsigned long now) {
+    bool any_active = false;
+    
+    // Le callback possono avviare o annullare tween: lo slot viene liberato
+    // prima di on_complete così un tween può concatenarne un altro
+    for (uint8_t i = 0; i < ANIMATION_MAX_TWEENS; i++) {
+        Tween& tween = tweens[i];
+        if (!tween.active) continue;
+        any_active = true;
+        
+        unsigned long elapsed = now - tween.start_ms;
+        bool finished = elapsed >= tween.duration_ms;
+        
+        if (tween.on_update) {
+            float t = finished ? 1.0f : (float)elapsed / (float)tween.duration_ms;
+            tween.on_update(tween.ctx, tween.from + (tween.to - tween.from) * t);
+            
+            // Annullato dalla propria callback
+            if (!tween.active) continue;
+        }
+        
+        if (finished) {
+            tween.active = false;
+            stats.completed++;
+            if (tween.on_complete) {
+                tween.on_complete(tween.ctx);
+            }
+        }
+    }
+    
+    if (any_active) {
+        stats.updates++;
+    }
+}
+
+AnimationScheduler::Stats AnimationScheduler::getStats() const {
+    return stats;
+}
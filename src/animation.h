@@ -0,0 +1,88 @@
+#ifndef ANIMATION_H
+#define ANIMATION_H
+
+#include <Arduino.h>
+#include "config.h"
+
+/**
+ * Scheduler cooperativo di animazioni (tween e timer)
+ * Nessun delay(): ogni tween interpola un valore tra from e to nel tempo e viene
+ * avanzato da update(), chiamato dal loop principale tramite DisplayController::update()
+ * Un timer è un tween senza callback di aggiornamento
+ */
+class AnimationScheduler {
+public:
+    // Callback con contesto (tipicamente il DisplayController proprietario)
+    typedef void (*UpdateCallback)(void* ctx, float value);
+    typedef void (*CompleteCallback)(void* ctx);
+    
+    AnimationScheduler();
+    
+    /**
+     * Avvia un tween
+     * @param duration_ms Durata (0 = completa al prossimo update)
+     * @param from Valore iniziale
+     * @param to Valore finale (passato sempre all'ultimo aggiornamento)
+     * @param on_update Chiamata a ogni update con il valore corrente (può essere nullptr)
+     * @param on_complete Chiamata al termine (può essere nullptr)
+     * @param ctx Contesto passato alle callback
+     * @return Id del tween, -1 se non ci sono slot liberi
+     */
+    int8_t start(unsigned long duration_ms, float from, float to,
+                 UpdateCallback on_update, CompleteCallback on_complete, void* ctx);
+    
+    /**
+     * Avvia un timer (tween senza valore)
+     * @return Id del timer, -1 se non ci sono slot liberi
+     */
+    int8_t startTimer(unsigned long duration_ms, CompleteCallback on_complete, void* ctx);
+    
+    /**
+     * Annulla un tween senza chiamare on_complete
+     */
+    void cancel(int8_t id);
+    
+    /**
+     * Verifica se un tween è in corso
+     */
+    bool isActive(int8_t id) const;
+    
+    /**
+     * Verifica se ci sono tween in corso
+     */
+    bool isBusy() const;
+    
+    /**
+     * Avanza tutti i tween attivi
+     * @param now Tempo corrente (millis())
+     */
+    void update(unsigned long now);
+    
+    /**
+     * Statistiche scheduler
+     */
+    struct Stats {
+        unsigned long started;      // Tween/timer avviati
+        unsigned long completed;    // Tween/timer completati
+        unsigned long cancelled;    // Tween/timer annullati
+        unsigned long updates;      // Chiamate a update() con tween attivi
+    };
+    Stats getStats() const;
+
+private:
+    struct Tween {
+        bool active;
+        unsigned long start_ms;
+        unsigned long duration_ms;
+        float from;
+        float to;
+        UpdateCallback on_update;
+        CompleteCallback on_complete;
+        void* ctx;
+    };
+    
+    Tween tweens[ANIMATION_MAX_TWEENS];
+    Stats stats;
+};
+
+#endif // ANIMATION_H
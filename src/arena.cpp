@@ -0,0 +1,80 @@
+#include "arena.h"
+#include "log.h"
+
+static_assert((ARENA_ALIGN & (ARENA_ALIGN - 1)) == 0, "ARENA_ALIGN deve essere una potenza di 2");
+
+alignas(ARENA_ALIGN) static uint8_t database_storage[ARENA_DATABASE_SIZE];
+alignas(ARENA_ALIGN) static uint8_t scratch_storage[ARENA_SCRATCH_SIZE];
+alignas(ARENA_ALIGN) static uint8_t render_storage[ARENA_RENDER_SIZE];
+alignas(ARENA_ALIGN) static uint8_t gps_storage[ARENA_GPS_SIZE];
+
+static Arena arenas[ARENA_REGION_COUNT] = {
+    Arena("database", database_storage, sizeof(database_storage)),
+    Arena("scratch", scratch_storage, sizeof(scratch_storage)),
+    Arena("render", render_storage, sizeof(render_storage)),
+    Arena("gps", gps_storage, sizeof(gps_storage)),
+};
+
+void* Arena::allocate(size_t size, size_t align) {
+    uintptr_t base = (uintptr_t)buffer;
+    uintptr_t aligned = (base + offset + align - 1) & ~(uintptr_t)(align - 1);
+    size_t start = aligned - base;
+    if (start > region_capacity || size > region_capacity - start) {
+        failed++;
+        LOG_E(MEMORY, "Arena %s piena: richiesti %u byte, liberi %u",
+              region_name, (unsigned int)size, (unsigned int)(region_capacity - offset));
+        return nullptr;
+    }
+    offset = start + size;
+    if (offset > peak_offset) peak_offset = offset;
+    return buffer + start;
+}
+
+void* Arena::reallocate(void* ptr, size_t old_size, size_t new_size, size_t align) {
+    if (!ptr) return allocate(new_size, align);
+
+    // Ultimo blocco: cresce o si riduce sul posto
+    size_t start = (uint8_t*)ptr - buffer;
+    if (start + old_size == offset) {
+        if (new_size > region_capacity - start) {
+            failed++;
+            LOG_E(MEMORY, "Arena %s piena: richiesti %u byte, liberi %u",
+                  region_name, (unsigned int)new_size, (unsigned int)(region_capacity - start));
+            return nullptr;
+        }
+        offset = start + new_size;
+        if (offset > peak_offset) peak_offset = offset;
+        return ptr;
+    }
+
+    void* moved = allocate(new_size, align);
+    if (moved) {
+        memcpy(moved, ptr, old_size < new_size ? old_size : new_size);
+    }
+    return moved;
+}
+
+void Arena::deallocate(void* ptr, size_t size) {
+    if (!ptr) return;
+    size_t start = (uint8_t*)ptr - buffer;
+    if (start + size == offset) {
+        offset = start;
+    }
+}
+
+void Arena::release(size_t mark) {
+    if (mark < offset) offset = mark;
+}
+
+Arena& arena_get(ArenaRegion region) {
+    return arenas[region < ARENA_REGION_COUNT ? region : ARENA_SCRATCH];
+}
+
+void arena_report() {
+    for (uint8_t i = 0; i < ARENA_REGION_COUNT; i++) {
+        const Arena& arena = arenas[i];
+        LOG_I(MEMORY, "Arena %-8s %6u / %6u byte (picco %u, %lu allocazioni fallite)",
+              arena.name(), (unsigned int)arena.used(), (unsigned int)arena.capacity(),
+              (unsigned int)arena.peak(), (unsigned long)arena.failures());
+    }
+}
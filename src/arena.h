@@ -0,0 +1,108 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <Arduino.h>
+#include <new>
+#include "config.h"
+
+/**
+ * Allocatore a stack (bump) su memoria statica
+ *
+ * Tutti i buffer dei controller vengono da regioni a dimensione fissa in .bss
+ * (ARENA_*_SIZE in config.h), riservate al link: nessuna allocazione su heap
+ * durante il funzionamento e nessuna frammentazione prima del primo fix.
+ *
+ *   ARENA_DATABASE  array speedcam e file dei corridoi (SpeedcamController)
+ *   ARENA_SCRATCH   buffer temporanei di caricamento (file, documenti JSON):
+ *                   ogni caricamento li rilascia all'uscita (ArenaScope)
+ *   ARENA_RENDER    oggetti e buffer del display
+ *   ARENA_GPS       seriale GPS e percorso fake
+ *
+ * La memoria si libera solo in ordine inverso (release a un mark, o l'ultimo
+ * blocco con deallocate): le regioni permanenti si riempiono una volta al boot.
+ */
+class Arena {
+public:
+    constexpr Arena(const char* name, uint8_t* buffer, size_t capacity) :
+        region_name(name), buffer(buffer), region_capacity(capacity),
+        offset(0), peak_offset(0), failed(0) {}
+
+    /**
+     * Alloca un blocco allineato
+     * @return nullptr se la regione è piena (conteggiato in failures())
+     */
+    void* allocate(size_t size, size_t align = ARENA_ALIGN);
+
+    /**
+     * Alloca e costruisce un array di T (costruttore di default)
+     */
+    template <typename T>
+    T* allocateArray(size_t count) {
+        T* items = (T*)allocate(sizeof(T) * count, alignof(T));
+        if (items) {
+            for (size_t i = 0; i < count; i++) new (&items[i]) T();
+        }
+        return items;
+    }
+
+    /**
+     * Ridimensiona un blocco: sul posto se è l'ultimo, altrimenti nuovo blocco e copia
+     */
+    void* reallocate(void* ptr, size_t old_size, size_t new_size, size_t align = ARENA_ALIGN);
+
+    /**
+     * Libera un blocco se è l'ultimo allocato (altrimenti resta fino al release)
+     */
+    void deallocate(void* ptr, size_t size);
+
+    /**
+     * Posizione corrente e ritorno a una posizione precedente
+     */
+    size_t mark() const { return offset; }
+    void release(size_t mark);
+    void reset() { release(0); }
+
+    const char* name() const { return region_name; }
+    size_t capacity() const { return region_capacity; }
+    size_t used() const { return offset; }
+    size_t peak() const { return peak_offset; }
+    uint32_t failures() const { return failed; }
+
+private:
+    const char* region_name;
+    uint8_t* buffer;
+    size_t region_capacity;
+    size_t offset;
+    size_t peak_offset;
+    uint32_t failed;
+};
+
+/**
+ * Scope di una regione temporanea: all'uscita torna al mark dell'ingresso
+ */
+class ArenaScope {
+public:
+    explicit ArenaScope(Arena& arena) : arena(arena), start(arena.mark()) {}
+    ~ArenaScope() { arena.release(start); }
+
+private:
+    Arena& arena;
+    size_t start;
+};
+
+enum ArenaRegion : uint8_t {
+    ARENA_DATABASE = 0,
+    ARENA_SCRATCH,
+    ARENA_RENDER,
+    ARENA_GPS,
+    ARENA_REGION_COUNT
+};
+
+Arena& arena_get(ArenaRegion region);
+
+/**
+ * Riepilogo per regione (uso, picco, capacità, allocazioni fallite) nel log
+ */
+void arena_report();
+
+#endif // ARENA_H
@@ -0,0 +1,48 @@
+#ifndef ARENA_JSON_H
+#define ARENA_JSON_H
+
+#include <ArduinoJson.h>
+#include "arena.h"
+
+/**
+ * Allocatore ArduinoJson su un'arena (JsonDocument doc(&allocator))
+ * I documenti dei caricamenti usano ARENA_SCRATCH invece dell'heap: se l'arena
+ * è piena deserializeJson restituisce NoMemory, come con un heap esaurito.
+ * Ogni blocco ha un header con la dimensione (per reallocate e deallocate).
+ */
+class ArenaJsonAllocator : public ArduinoJson::Allocator {
+public:
+    explicit ArenaJsonAllocator(Arena& arena) : arena(arena) {}
+
+    void* allocate(size_t size) override {
+        uint8_t* block = (uint8_t*)arena.allocate(HEADER_SIZE + size);
+        if (!block) return nullptr;
+        *(size_t*)block = size;
+        return block + HEADER_SIZE;
+    }
+
+    void deallocate(void* ptr) override {
+        if (!ptr) return;
+        uint8_t* block = (uint8_t*)ptr - HEADER_SIZE;
+        arena.deallocate(block, HEADER_SIZE + *(size_t*)block);
+    }
+
+    void* reallocate(void* ptr, size_t new_size) override {
+        if (!ptr) return allocate(new_size);
+        uint8_t* block = (uint8_t*)ptr - HEADER_SIZE;
+        size_t old_size = *(size_t*)block;
+        block = (uint8_t*)arena.reallocate(block, HEADER_SIZE + old_size, HEADER_SIZE + new_size);
+        if (!block) return nullptr;
+        *(size_t*)block = new_size;
+        return block + HEADER_SIZE;
+    }
+
+private:
+    // Header grande quanto l'allineamento: il blocco utente resta allineato
+    static const size_t HEADER_SIZE = ARENA_ALIGN;
+    static_assert(sizeof(size_t) <= ARENA_ALIGN, "L'header deve contenere size_t");
+
+    Arena& arena;
+};
+
+#endif // ARENA_JSON_H
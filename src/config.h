@@ -29,9 +29,41 @@
 // Speedcam Configuration
 #define SPEEDCAM_DETECTION_RADIUS 1000  // Raggio di rilevazione in metri (default 1km)
 #define SPEEDCAM_CHECK_INTERVAL 5000    // Intervallo tra check in millisecondi (default 5 secondi)
+// Speedcam direzionali (heading nel database): scartate se la rotta differisce oltre la tolleranza
+#define SPEEDCAM_HEADING_FILTER true
+#define SPEEDCAM_HEADING_TOLERANCE 45.0    // Gradi tra rotta e direzione controllata
+#define SPEEDCAM_HEADING_MIN_SPEED 10.0    // km/h: più piano la rotta GPS non è affidabile, nessun filtro
 #define SPEEDCAM_JSON_PATH "/speedcams.json"
 #define SPEEDCAM_ENABLED true
 
+// Database binario versionato con CRC (make_speedcam_db.py) in due slot A/B.
+// Al boot vince lo slot valido con la versione più alta (JSON se nessuno è valido);
+// un aggiornamento si scrive nello slot inattivo e viene caricato in background
+// nel secondo buffer, poi sostituisce quello attivo solo se il CRC è corretto
+#define SPEEDCAM_DB_SLOT_A "/speedcams_a.bin"
+#define SPEEDCAM_DB_SLOT_B "/speedcams_b.bin"
+#define SPEEDCAM_DB_HOT_SWAP true          // Secondo buffer (raddoppia l'arena database)
+#define SPEEDCAM_DB_LOAD_CHUNK 128         // Record letti per iterazione del loop durante un aggiornamento
+#define SPEEDCAM_DB_UPDATE_COMMAND 'U'     // Carattere seriale che cerca un aggiornamento negli slot
+// Patch (make_speedcam_db.py --patch-from): applicata durante il caricamento allo
+// slot con la versione e il CRC per cui è stata generata, senza riscriverlo
+#define SPEEDCAM_DB_PATCH "/speedcams.patch"
+// Slot compressi (make_speedcam_db.py --block-records): record per blocco al massimo.
+// Il lettore tiene due buffer da questi record (finestra e blocco compresso)
+#define SPEEDCAM_DB_BLOCK_RECORDS_MAX 64
+
+// Corridoi stradali (make_corridors.py, vedi corridor_map.h): polilinee semplificate
+// delle strade con speedcam. Le speedcam agganciate a un corridoio danno l'alert
+// solo viaggiando su quel corridoio e verso di esse (non da strade laterali o
+// cavalcavia); senza file dei corridoi tutto resta alla sola distanza
+#define CORRIDOR_MATCHING_ENABLED true
+#define CORRIDOR_PATH "/corridors.bin"
+#define CORRIDOR_RAM_BUDGET 16384          // Byte per il file dei corridoi in RAM (nell'arena database)
+#define CORRIDOR_MATCH_RADIUS_M 50.0       // Distanza massima dal segmento (errore GPS + semplificazione)
+#define CORRIDOR_HEADING_TOLERANCE 45.0    // Gradi tra rotta e segmento, in uno dei due versi
+#define CORRIDOR_SWITCH_MARGIN_M 15.0      // Isteresi: si cambia corridoio solo se un altro è più vicino di tanto
+#define CORRIDOR_BEHIND_SLACK_M 50.0       // Speedcam appena superate ancora rilevanti
+
 // Display Configuration (GC9A01 240x240 onboard)
 #define DISPLAY_WIDTH 240
 #define DISPLAY_HEIGHT 240
@@ -41,6 +73,33 @@
 #define BOOT_LOGO_FADE_DURATION 500  // Durata fade-in in millisecondi
 #define BOOT_LOGO_FADE_STEPS 12      // Numero di step per fade (più step = più fluido, ma più lento)
 
+// Animazioni (fade, permanenza logo, timeout alert) avanzate da DisplayController::update()
+#define ANIMATION_MAX_TWEENS 6                // Tween/timer contemporanei
+#ifndef DISPLAY_NONBLOCKING_ANIMATIONS
+#define DISPLAY_NONBLOCKING_ANIMATIONS true   // false = showBootLogo attende la fine (comportamento precedente)
+#endif
+
+// Testo anti-aliased (font atlas generato da convert_assets.py in font_atlas.h)
+#define TEXT_BAND_PIXELS 2048        // Pixel del band buffer per comporre il testo (4KB RAM)
+#define FONT_WIDTH_CACHE_SIZE 16     // Voci cache larghezza stringhe
+
+// Bordi anti-aliased per cerchi e anelli (pixel di bordo miscelati con lo sfondo)
+#define DISPLAY_ANTIALIAS_EDGES true
+
+// Clipping al disco visibile del pannello rotondo (gli angoli non sono mai visibili)
+#define DISPLAY_CIRCULAR_CLIP true
+#define DISPLAY_VIEWPORT_RADIUS 120  // Raggio del disco visibile in pixel
+
+// Alert speedcam: aggiornamento incrementale distanza
+#define ALERT_DISTANCE_DIGITS 4      // Cifre del countdown distanza (max 9999m)
+#define ALERT_PROGRESS_STEPS 120     // Risoluzione arco distanza residua (3° per step)
+#define ALERT_TRANSITION_MS 300      // Alert che passa a un'altra speedcam: distanza e arco animati
+#define PREVIEW_Y 205                // Riga dell'anteprima della prossima speedcam (schermata idle)
+
+// Per eseguire il microbenchmark del testo all'avvio (output su seriale), decommenta
+// (sul PC: text_bench della build host)
+// #define DISPLAY_TEXT_BENCHMARK 1
+
 // Display Pin Configuration
 // Configurazione basata su Factory_samples.ino del produttore ESP32-2424S012
 // File: 1.28inch_ESP32-2424S012/1-Demo/Demo_Arduino/Factory_samples.ino
@@ -71,26 +130,124 @@
 // Colori MicroNav (RGB565)
 #define COLOR_MICRONAV_RED 0xC0C7      // Rosso principale
 #define COLOR_MICRONAV_RED_20 0x31E7   // Rosso con trasparenza ~20% (approssimato)
+#define COLOR_MICRONAV_BLUE_20 0x00C6  // Blu con trasparenza ~20% (sfondo pannello Tutor)
 
 // Serial Debug
 #define SERIAL_DEBUG_BAUD 115200
-#define DEBUG_ENABLED true
+
+// Log (vedi log.h): livelli NONE, ERROR, WARN, INFO, DEBUG, VERBOSE
+// Sotto il livello le chiamate non generano codice; sopra, la formattazione
+// avviene in log_flush() dal loop principale
+#define LOG_LEVEL LOG_LEVEL_INFO
+// Livello di un singolo modulo (SETUP, LOOP, GPS, SPEEDCAM, JSON, DISPLAY, ANIMATION, TRACE, SECTION), es.:
+// #define LOG_LEVEL_SPEEDCAM LOG_LEVEL_VERBOSE
+#define LOG_BUFFER_SIZE 2048     // Ring buffer record in attesa di stampa (potenza di 2)
+#define LOG_RECORD_MAX 96        // Byte massimi di argomenti per record
+#define LOG_MAX_STRING_ARG 32    // Stringhe negli argomenti troncate a questa lunghezza
 
 // Memory Configuration
-// ESP32-C3 ha ~400KB RAM totale, ogni Speedcam è ~24 bytes
-// 2000 speedcam = ~48KB (ragionevole per ESP32-C3)
-#define MAX_SPEEDCAM_COUNT 2000  // Numero massimo speedcam in memoria
-#define SPEEDCAM_PRE_FILTER_ENABLED true  // Abilita pre-filtraggio geografico
-
-// Pre-filtraggio geografico (bounding box Italia settentrionale)
-// Utile per ridurre numero speedcam caricate in memoria
-#define PRE_FILTER_MIN_LAT 43.0   // Latitudine minima
-#define PRE_FILTER_MAX_LAT 47.0   // Latitudine massima
-#define PRE_FILTER_MIN_LNG 6.0    // Longitudine minima
-#define PRE_FILTER_MAX_LNG 14.0   // Longitudine massima
+// ESP32-C3 ha ~400KB RAM totale, ogni Speedcam è 24 bytes: l'array viene
+// dimensionato al caricamento sul numero reale di speedcam, entro il budget
+#define SPEEDCAM_RAM_BUDGET 49152  // Byte per il database in RAM (48KB = 2048 speedcam)
+#define SPEEDCAM_PRE_FILTER_ENABLED true  // Oltre budget: tieni le più vicine (altrimenti le prime del file)
+
+// Arene statiche (vedi arena.h): i buffer dei controller non usano l'heap
+#define ARENA_ALIGN 8                                   // Allineamento blocchi (double)
+#define ARENA_DATABASE_SIZE (SPEEDCAM_RAM_BUDGET * (SPEEDCAM_DB_HOT_SWAP ? 2 : 1) + \
+                             (CORRIDOR_MATCHING_ENABLED ? CORRIDOR_RAM_BUDGET : 0))  // Array speedcam attivo + aggiornamento, corridoi
+#define ARENA_SCRATCH_SIZE 32768    // Caricamenti: buffer file (8KB) + documento JSON, liberata dopo ogni load
+#define ARENA_RENDER_SIZE 512       // Oggetto Adafruit_GC9A01A
+#define ARENA_GPS_SIZE 4096         // HardwareSerial + percorso fake (~48 byte per punto)
+
+// Pre-filtraggio geografico (solo se il file supera SPEEDCAM_RAM_BUDGET)
+// Speedcam più vicine all'ultima posizione nota, scelte per anelli di distanza
+#define PRE_FILTER_RINGS 64          // Anelli del conteggio (raggio ~ quadrato dell'indice)
+#define PRE_FILTER_MAX_KM 2000.0f    // Raggio esterno dell'ultimo anello
+#define PRE_FILTER_DEFAULT_LAT 45.0  // Centro senza posizione nota (Italia settentrionale)
+#define PRE_FILTER_DEFAULT_LNG 10.0
+
+// Working set di rilevazione: le speedcam più vicine all'ultima ricostruzione.
+// I check scansionano solo questo finché il raggio di rilevazione resta coperto;
+// la scansione completa del database serve solo a ricostruirlo
+#define SPEEDCAM_CANDIDATE_MAX 64         // Speedcam nel working set (2 byte ciascuna)
+#define SPEEDCAM_CANDIDATE_RADIUS 5000.0  // Raggio massimo del working set in metri
+
+// Indice spaziale delle ricerche per raggio (ricostruzione del working set e check fuori working set)
+#define SPEEDCAM_INDEX_LINEAR 0    // Scansione di tutto l'array
+#define SPEEDCAM_INDEX_HILBERT 1   // Array ordinato per curva di Hilbert, intervalli con ricerca binaria (hilbert_index.h)
+#define SPEEDCAM_INDEX_KDTREE 2    // k-d tree implicito nell'array, ricerche delle più vicine in virgola fissa (kd_index.h)
+#define SPEEDCAM_INDEX SPEEDCAM_INDEX_KDTREE
+#define SPEEDCAM_KD_NEAREST 4      // Più vicine secondo l'albero verificate con Haversine nei check fuori working set
+#define SPEEDCAM_AHEAD_HALF_ANGLE 60.0  // Semi-angolo attorno alla rotta delle speedcam "davanti" (gradi)
+#define SPEEDCAM_AHEAD_MAX 8       // Risultati massimi di findSpeedcamsAhead
+
+// Coda delle prossime speedcam davanti (vedi lookahead.h): anteprima sulla schermata idle
+// e alert che passa alla speedcam successiva appena superata la precedente
+#define LOOKAHEAD_ENABLED true
+#define LOOKAHEAD_MAX 4                 // Speedcam in coda (<= SPEEDCAM_AHEAD_MAX)
+#define LOOKAHEAD_PASSED_MAX 8          // Speedcam superate ricordate (saltate dalla rilevazione)
+#define LOOKAHEAD_RADIUS_M 3000.0       // Raggio della ricerca davanti e dell'anteprima
+#define LOOKAHEAD_REFILL_M 200.0        // Percorso dopo cui la coda viene riempita di nuovo dall'indice
+#define LOOKAHEAD_REFILL_COURSE 30.0    // Svolta (gradi) dopo cui la coda viene riempita di nuovo
+#define LOOKAHEAD_PASSED_M 15.0         // Oltre questa distanza dietro (lungo la rotta) la speedcam è superata
+
+// Tutor (controllo della velocità media su tratta, vedi section_control.h)
+// Le tratte sono coppie di speedcam con i type di inizio e fine (codici SCDB/iGO)
+#define SECTION_CONTROL_ENABLED true
+#define SECTION_TYPE_START "4"           // type della speedcam di inizio tratta
+#define SECTION_TYPE_END "5"             // type della speedcam di fine tratta
+#define SECTION_MAX 32                   // Tratte collegate in RAM (~28 byte ciascuna)
+#define SECTION_MAX_LENGTH_M 30000.0     // Distanza massima tra i portali di una tratta
+#define SECTION_GATE_RADIUS_M 60.0       // Raggio dei portali di ingresso e uscita
+#define SECTION_MAX_DETOUR 2.0           // Percorso massimo (multiplo della lunghezza) prima di abbandonare
+#define SECTION_FIX_TIMEOUT_MS 30000     // Senza fix per più di così la tratta è interrotta
+#define SECTION_MIN_SPEED_KMH 5.0        // Sotto questa velocità la rotta non è affidabile
+
+// Avviso di eccesso di velocità verso la speedcam dell'alert (vedi overspeed.h)
+// Livelli: oltre il limite (colore), frenata necessaria (lampeggio), frenata forte (beep)
+#define OVERSPEED_ENABLED true
+#define OVERSPEED_MARGIN_KMH 3           // Tolleranza sul vmax prima di avvisare
+#define OVERSPEED_REACTION_MS 1000       // Tempo di reazione: spazio percorso prima di frenare
+#define OVERSPEED_BRAKE_DECEL 1.5        // m/s²: frenata normale necessaria (lampeggio)
+#define OVERSPEED_CRITICAL_DECEL 3.0     // m/s²: frenata decisa necessaria (beep)
+#define OVERSPEED_RELEASE_MS 2000        // Tempo sotto il livello corrente prima di scendere
+#define OVERSPEED_BEEP_PIN -1            // GPIO del buzzer attivo (-1 = nessuno)
+#define OVERSPEED_PULSE_MS 400           // Semiperiodo del lampeggio (frenata)
+#define OVERSPEED_PULSE_FAST_MS 200      // Semiperiodo del lampeggio e del beep (frenata forte)
+
+// Stato persistente in NVS per il warm start (ultimo fix, firma database, working set)
+// Scritture rade per l'usura della flash: in marcia al più una ogni intervallo e solo
+// dopo uno spostamento minimo; da fermi (es. parcheggio) subito, una volta per sosta
+#define STATE_STORE_ENABLED true
+#define STATE_STORE_NAMESPACE "micronav"
+#define STATE_SAVE_INTERVAL_MS 60000       // Intervallo minimo tra scritture in marcia
+#define STATE_SAVE_MIN_DISTANCE_M 500.0    // Spostamento minimo dall'ultimo stato salvato
+#define STATE_SAVE_STOP_SPEED_KMH 3.0      // Sotto questa velocità il veicolo è fermo
+
+// Metriche di latenza (istogrammi log2 con 2^N sotto-bucket lineari per ottava)
+#define METRICS_HISTOGRAM_SUB_BITS 2   // Errore percentili <= 25%, 124 bucket (~500 byte)
+
+// Console metriche sulla seriale USB (comandi di un carattere, risposta su una riga, vedi metrics_cli.py)
+#define METRICS_CONSOLE_ENABLED true
+#define METRICS_COMMAND_REPORT 'M'   // Riga "#MN,..." con i valori correnti
+#define METRICS_COMMAND_HEADER 'H'   // Riga "#MNH,..." con i nomi dei campi
+#define METRICS_COMMAND_RESET 'R'    // Azzera contatori e istogrammi
+
+// Tracing del percorso critico (span con contatore cicli in un ring buffer, vedi trace.h)
+// Per attivarlo decommenta (o -DMICRONAV_TRACE=ON nella build host); dump binario
+// inviando TRACE_DUMP_COMMAND sulla seriale, conversione con trace_to_perfetto.py
+// #define TRACE_ENABLED 1
+#define TRACE_BUFFER_EVENTS 512      // Eventi nel ring buffer (12 byte ciascuno, 6KB RAM)
+#define TRACE_DUMP_COMMAND 'T'       // Carattere seriale che richiede il dump
 
 // Timing
-#define MAIN_LOOP_DELAY 100  // Delay loop principale in millisecondi
+#define MAIN_LOOP_PERIOD 100  // Periodo loop principale in millisecondi (deadline, vedi loop_monitor.h)
 #define GPS_UPDATE_INTERVAL 1000  // Intervallo aggiornamento GPS in millisecondi
 
+// Monitor del loop: durata iterazioni, overrun del periodo, margine watchdog (vedi loop_monitor.h)
+#define LOOP_MIN_IDLE_MS 1              // Attesa minima a fine ciclo anche in ritardo (il task idle serve il watchdog)
+#define LOOP_ALARM_ITERATION_MS 50      // Allarme se un'iterazione dura di più
+#define LOOP_WDT_TIMEOUT_MS 5000        // Timeout task watchdog (CONFIG_ESP_TASK_WDT_TIMEOUT_S del core)
+#define LOOP_ALARM_WDT_MARGIN_MS 2500   // Allarme se il margine dal timeout scende sotto questa soglia
+
 #endif // CONFIG_H
@@ -0,0 +1,230 @@
+#include "corridor_map.h"
+#include "utils.h"
+
+static inline int32_t to_units(double deg) {
+    return (int32_t)lround(deg * CORRIDOR_SCALE);
+}
+
+/**
+ * Candidato del match: segmento più vicino, ovunque o sul corridoio precedente
+ */
+struct CorridorCandidate {
+    float distance2;            // Unità²
+    float position_m;
+    uint16_t corridor;
+    int8_t direction;
+};
+
+CorridorMap::CorridorMap() {
+    clear();
+    memset(&stats, 0, sizeof(stats));
+}
+
+void CorridorMap::clear() {
+    chunks = nullptr;
+    points = nullptr;
+    cameras = nullptr;
+    corridor_count = 0;
+    chunk_count = 0;
+    point_count = 0;
+    camera_count = 0;
+    memset(&last_match, 0, sizeof(last_match));
+    last_match.corridor = CORRIDOR_NONE;
+}
+
+bool CorridorMap::attach(const uint8_t* data, size_t size) {
+    clear();
+    if (!data || size < sizeof(CorridorHeader) || ((uintptr_t)data & 3) != 0) {
+        return false;
+    }
+    const CorridorHeader* header = (const CorridorHeader*)data;
+    if (header->magic != CORRIDOR_MAGIC || header->format != CORRIDOR_FORMAT) {
+        return false;
+    }
+
+    // Dimensioni delle tabelle (in 64 bit: conteggi alterati non vanno in overflow)
+    uint64_t chunks_offset = sizeof(CorridorHeader);
+    uint64_t points_offset = chunks_offset + (uint64_t)header->chunk_count * sizeof(CorridorChunk);
+    uint64_t cameras_offset = points_offset + (((uint64_t)header->point_count * sizeof(CorridorPoint) + 3) & ~(uint64_t)3);
+    uint64_t end = cameras_offset + (uint64_t)header->camera_count * sizeof(CorridorCamera);
+    if (end != size) {
+        return false;
+    }
+
+    // Chunk: punti dentro la tabella e corridoi esistenti (il match non ricontrolla)
+    const CorridorChunk* table = (const CorridorChunk*)(data + chunks_offset);
+    for (uint32_t c = 0; c < header->chunk_count; c++) {
+        const CorridorChunk& chunk = table[c];
+        if (chunk.point_count < 2 || chunk.corridor >= header->corridor_count ||
+            (uint64_t)chunk.first_point + chunk.point_count > header->point_count) {
+            return false;
+        }
+    }
+
+    chunks = table;
+    points = (const CorridorPoint*)(data + points_offset);
+    cameras = (const CorridorCamera*)(data + cameras_offset);
+    corridor_count = header->corridor_count;
+    chunk_count = header->chunk_count;
+    point_count = header->point_count;
+    camera_count = header->camera_count;
+    return true;
+}
+
+const CorridorMatch& CorridorMap::match(double lat, double lng, float course_deg, bool course_valid) {
+    stats.matches++;
+    uint16_t previous = last_match.corridor;
+    int8_t previous_direction = last_match.direction;
+
+    int32_t qlat = to_units(lat);
+    int32_t qlng = to_units(lng);
+    // Longitudine scalata per il coseno della latitudine (Q15), una volta per match
+    int32_t cos_lat = (int32_t)(cos(deg_to_rad(lat)) * 32768.0);
+    if (cos_lat < 1) cos_lat = 1;
+    const float radius = (float)(CORRIDOR_MATCH_RADIUS_M / CORRIDOR_METERS_PER_UNIT);
+    const float radius2 = radius * radius;
+    int32_t reach_lat = (int32_t)radius + 1;
+    int32_t reach_lng = (int32_t)(((int64_t)reach_lat << 15) / cos_lat) + 1;
+
+    // Rotta in Q14: x verso est, y verso nord
+    int64_t dir_x = 0;
+    int64_t dir_y = 0;
+    int64_t cos2_tolerance = 0;
+    if (course_valid) {
+        double course = deg_to_rad(course_deg);
+        double cos_tolerance = cos(deg_to_rad(CORRIDOR_HEADING_TOLERANCE));
+        dir_x = (int64_t)(sin(course) * 16384.0);
+        dir_y = (int64_t)(cos(course) * 16384.0);
+        cos2_tolerance = (int64_t)(cos_tolerance * cos_tolerance * 16384.0);
+    }
+
+    CorridorCandidate best = { radius2, 0.0f, CORRIDOR_NONE, 0 };
+    CorridorCandidate same = best;
+    uint16_t chunk_hits = 0;
+    uint32_t segments = 0;
+
+    for (uint32_t c = 0; c < chunk_count; c++) {
+        const CorridorChunk& chunk = chunks[c];
+        // Posizione relativa all'origine del chunk: scarto sulla bounding box allargata del raggio
+        int32_t rel_lat = qlat - chunk.lat0;
+        int32_t rel_lng = qlng - chunk.lng0;
+        if (rel_lat < chunk.min_lat - reach_lat || rel_lat > chunk.max_lat + reach_lat ||
+            rel_lng < chunk.min_lng - reach_lng || rel_lng > chunk.max_lng + reach_lng) {
+            continue;
+        }
+        chunk_hits++;
+
+        const CorridorPoint* p = points + chunk.first_point;
+        for (uint16_t j = 0; j + 1 < chunk.point_count; j++) {
+            const CorridorPoint& a = p[j];
+            const CorridorPoint& b = p[j + 1];
+            // Scarto sulla bounding box del segmento: quattro confronti interi
+            if ((a.lat < b.lat ? a.lat : b.lat) - reach_lat > rel_lat ||
+                (a.lat > b.lat ? a.lat : b.lat) + reach_lat < rel_lat ||
+                (a.lng < b.lng ? a.lng : b.lng) - reach_lng > rel_lng ||
+                (a.lng > b.lng ? a.lng : b.lng) + reach_lng < rel_lng) {
+                continue;
+            }
+            segments++;
+
+            // Estremi rispetto alla posizione, in unità di latitudine
+            int64_t ax = ((int64_t)(a.lng - rel_lng) * cos_lat) >> 15;
+            int64_t ay = a.lat - rel_lat;
+            int64_t sx = (((int64_t)(b.lng - rel_lng) * cos_lat) >> 15) - ax;
+            int64_t sy = (b.lat - rel_lat) - ay;
+            int64_t length2 = sx * sx + sy * sy;
+            if (length2 == 0) continue;
+
+            // Direzione: |cos| tra rotta e segmento almeno cos(tolleranza), in uno dei due versi
+            int8_t direction = 0;
+            if (course_valid) {
+                int64_t dot = sx * dir_x + sy * dir_y;
+                if (dot * dot < length2 * 16384 * cos2_tolerance) continue;
+                direction = dot > 0 ? 1 : -1;
+            }
+
+            // Proiezione della posizione (origine) sul segmento
+            int64_t along = -(ax * sx + ay * sy);
+            float t = along <= 0 ? 0.0f : along >= length2 ? 1.0f : (float)along / (float)length2;
+            float px = (float)ax + t * (float)sx;
+            float py = (float)ay + t * (float)sy;
+            float distance2 = px * px + py * py;
+            if (distance2 > radius2) continue;
+
+            CorridorCandidate candidate = {
+                distance2,
+                chunk.start_m + a.offset_m + t * (float)(b.offset_m - a.offset_m),
+                chunk.corridor,
+                direction
+            };
+            if (distance2 < best.distance2 || best.corridor == CORRIDOR_NONE) best = candidate;
+            if (chunk.corridor == previous && (distance2 < same.distance2 || same.corridor == CORRIDOR_NONE)) {
+                same = candidate;
+            }
+        }
+    }
+
+    // Isteresi: il corridoio precedente resta finché un altro non è nettamente più vicino
+    if (same.corridor != CORRIDOR_NONE && best.corridor != previous) {
+        float margin = (float)(CORRIDOR_SWITCH_MARGIN_M / CORRIDOR_METERS_PER_UNIT);
+        if (sqrtf(same.distance2) <= sqrtf(best.distance2) + margin) best = same;
+    }
+
+    last_match.matched = best.corridor != CORRIDOR_NONE;
+    last_match.corridor = best.corridor;
+    last_match.chunks = chunk_hits;
+    last_match.segments = (uint16_t)min(segments, (uint32_t)0xFFFF);
+    if (last_match.matched) {
+        last_match.position_m = best.position_m;
+        last_match.offset_m = sqrtf(best.distance2) * (float)CORRIDOR_METERS_PER_UNIT;
+        // Senza rotta affidabile (fermi, manovre) resta il verso noto sullo stesso corridoio
+        last_match.direction = best.direction != 0 ? best.direction :
+                               best.corridor == previous ? previous_direction : 0;
+        stats.matched++;
+        if (previous != CORRIDOR_NONE && best.corridor != previous) stats.switches++;
+    } else {
+        last_match.position_m = 0.0f;
+        last_match.offset_m = 0.0f;
+        last_match.direction = 0;
+    }
+    stats.segments += segments;
+    if (segments > stats.max_segments) stats.max_segments = segments;
+    return last_match;
+}
+
+const CorridorCamera* CorridorMap::findCamera(uint32_t speedcam_id) const {
+    uint32_t first = 0;
+    uint32_t end = camera_count;
+    while (first < end) {
+        uint32_t mid = first + (end - first) / 2;
+        if (cameras[mid].id < speedcam_id) {
+            first = mid + 1;
+        } else {
+            end = mid;
+        }
+    }
+    return first < camera_count && cameras[first].id == speedcam_id ? &cameras[first] : nullptr;
+}
+
+bool CorridorMap::isRelevant(uint32_t speedcam_id) {
+    bool relevant = checkRelevant(speedcam_id);
+    if (!relevant) stats.suppressed++;
+    return relevant;
+}
+
+bool CorridorMap::checkRelevant(uint32_t speedcam_id) const {
+    const CorridorCamera* camera = findCamera(speedcam_id);
+    if (!camera) {
+        return true;
+    }
+    // Speedcam di una strada con corridoio: fuori dal corridoio (strada laterale,
+    // cavalcavia) o già superata non interessa
+    return last_match.matched && camera->corridor == last_match.corridor &&
+           (last_match.direction == 0 ||
+            ((float)camera->position_m - last_match.position_m) * last_match.direction >=
+                -(float)CORRIDOR_BEHIND_SLACK_M);
+}
+
+void CorridorMap::resetStats() {
+    memset(&stats, 0, sizeof(stats));
+}
@@ -0,0 +1,164 @@
+#ifndef CORRIDOR_MAP_H
+#define CORRIDOR_MAP_H
+
+#include <Arduino.h>
+#include "config.h"
+
+/**
+ * Corridoi stradali: polilinee semplificate delle strade con speedcam
+ *
+ * File binario generato da make_corridors.py (little-endian, letto in RAM così
+ * com'è):
+ *
+ *   header    CorridorHeader (32 byte)
+ *   chunk     chunk_count x CorridorChunk: tratti consecutivi di un corridoio,
+ *             al più CORRIDOR_CHUNK_POINTS punti, con bounding box
+ *   punti     point_count x CorridorPoint, relativi all'origine del chunk;
+ *             chunk adiacenti dello stesso corridoio condividono il punto di confine
+ *             (tabella completata a un multiplo di 4 byte)
+ *   speedcam  camera_count x CorridorCamera, ordinate per ID: corridoio e
+ *             progressiva di ogni speedcam agganciata a una strada
+ *
+ * Il match associa posizione e rotta al segmento più vicino entro
+ * CORRIDOR_MATCH_RADIUS_M, percorribile nella direzione della rotta (in uno dei
+ * due versi): il costo per fix è un confronto di bounding box per chunk e i
+ * segmenti dei soli chunk vicini, in virgola fissa. Una speedcam agganciata è
+ * rilevante solo sul corridoio corrente e davanti nel verso di marcia; quelle
+ * non agganciate restano alla sola distanza (comportamento senza corridoi).
+ */
+
+#define CORRIDOR_MAGIC 0x52434E4D      // "MNCR"
+#define CORRIDOR_FORMAT 1              // Cambia se cambia il layout del file
+#define CORRIDOR_SCALE 100000          // Unità di coordinata per grado (1e-5°, ~1.1 m)
+#define CORRIDOR_METERS_PER_UNIT 1.11194927  // Metri per unità di latitudine (EARTH_RADIUS_M)
+#define CORRIDOR_CHUNK_POINTS 64       // Punti massimi per chunk (limita i segmenti per chunk)
+#define CORRIDOR_NONE 0xFFFF
+
+struct CorridorHeader {
+    uint32_t magic;             // CORRIDOR_MAGIC
+    uint16_t format;            // CORRIDOR_FORMAT
+    uint16_t corridor_count;
+    uint32_t chunk_count;
+    uint32_t point_count;
+    uint32_t camera_count;
+    uint32_t data_crc;          // CRC-32 di tutto ciò che segue l'header
+    uint32_t reserved;
+    uint32_t header_crc;        // CRC-32 dei 28 byte precedenti
+};
+
+struct CorridorChunk {
+    int32_t lat0;               // Origine (unità CORRIDOR_SCALE)
+    int32_t lng0;
+    int16_t min_lat;            // Bounding box dei punti, relativa all'origine
+    int16_t min_lng;
+    int16_t max_lat;
+    int16_t max_lng;
+    uint32_t first_point;       // Indice del primo punto
+    uint16_t point_count;       // >= 2
+    uint16_t corridor;
+    uint32_t start_m;           // Progressiva del primo punto lungo il corridoio
+};
+
+struct CorridorPoint {
+    int16_t lat;                // Relativi all'origine del chunk
+    int16_t lng;
+    uint16_t offset_m;          // Progressiva dall'inizio del chunk
+};
+
+struct CorridorCamera {
+    uint32_t id;                // ID della speedcam (ordinate per ID)
+    uint16_t corridor;
+    uint16_t reserved;
+    uint32_t position_m;        // Progressiva della proiezione sul corridoio
+};
+
+static_assert(sizeof(CorridorHeader) == 32, "Header dei corridoi: 32 byte");
+static_assert(sizeof(CorridorChunk) == 28, "Chunk dei corridoi: 28 byte");
+static_assert(sizeof(CorridorPoint) == 6, "Punto dei corridoi: 6 byte");
+static_assert(sizeof(CorridorCamera) == 12, "Speedcam dei corridoi: 12 byte");
+
+/**
+ * Esito dell'ultimo match
+ */
+struct CorridorMatch {
+    bool matched;
+    uint16_t corridor;          // CORRIDOR_NONE se !matched
+    int8_t direction;           // +1 progressive crescenti, -1 decrescenti, 0 rotta non affidabile
+    float position_m;           // Progressiva della posizione proiettata
+    float offset_m;             // Distanza dal segmento
+    uint16_t chunks;            // Chunk entro il raggio (bounding box)
+    uint16_t segments;          // Segmenti esaminati
+};
+
+class CorridorMap {
+public:
+    CorridorMap();
+
+    /**
+     * Usa i dati di un file dei corridoi già in RAM (non copiati: devono restare
+     * validi). Controlla header e dimensioni delle tabelle; il CRC dei dati lo
+     * verifica chi legge il file (speedcam_db_crc32).
+     * @return false se il formato non è valido (mappa vuota)
+     */
+    bool attach(const uint8_t* data, size_t size);
+    void clear();
+    bool isLoaded() const { return chunk_count > 0; }
+
+    /**
+     * Associa la posizione al corridoio: segmento più vicino entro
+     * CORRIDOR_MATCH_RADIUS_M con direzione compatibile con la rotta (se
+     * course_valid). Si resta sul corridoio precedente finché un altro non è più
+     * vicino di CORRIDOR_SWITCH_MARGIN_M (strade parallele, svincoli).
+     */
+    const CorridorMatch& match(double lat, double lng, float course_deg, bool course_valid);
+    const CorridorMatch& getMatch() const { return last_match; }
+
+    /**
+     * Rilevanza di una speedcam per l'ultimo match: non agganciata, oppure sul
+     * corridoio corrente e non più di CORRIDOR_BEHIND_SLACK_M dietro la posizione
+     */
+    bool isRelevant(uint32_t speedcam_id);
+
+    /**
+     * Come isRelevant(), senza contare le scartate (es. coda delle prossime speedcam)
+     */
+    bool checkRelevant(uint32_t speedcam_id) const;
+
+    /**
+     * Speedcam agganciata a un corridoio (nullptr se non agganciata)
+     */
+    const CorridorCamera* findCamera(uint32_t speedcam_id) const;
+
+    uint16_t getCorridorCount() const { return corridor_count; }
+    uint32_t getChunkCount() const { return chunk_count; }
+    uint32_t getPointCount() const { return point_count; }
+    uint32_t getCameraCount() const { return camera_count; }
+
+    /**
+     * Statistiche
+     */
+    struct Stats {
+        unsigned long matches;          // Chiamate a match()
+        unsigned long matched;          // Posizioni su un corridoio
+        unsigned long switches;         // Cambi di corridoio
+        unsigned long segments;         // Segmenti esaminati in totale
+        unsigned long max_segments;     // Massimo in un match
+        unsigned long suppressed;       // Speedcam non rilevanti (isRelevant false)
+    };
+    Stats getStats() const { return stats; }
+    void resetStats();
+
+private:
+    const CorridorChunk* chunks;
+    const CorridorPoint* points;
+    const CorridorCamera* cameras;
+    uint16_t corridor_count;
+    uint32_t chunk_count;
+    uint32_t point_count;
+    uint32_t camera_count;
+
+    CorridorMatch last_match;
+    Stats stats;
+};
+
+#endif // CORRIDOR_MAP_H
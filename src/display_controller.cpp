@@ -1,10 +1,46 @@
 #include "display_controller.h"
-#include "speedcam_controller.h"
+#include "speedcam.h"
+#include "section_control.h"
+#include "overspeed.h"
+#include "hal.h"
+#include "arena.h"
+#include "trace.h"
+#include "log.h"
 
 // Include boot logo array (se il file esiste, definisce BOOT_LOGO_DATA_AVAILABLE all'inizio)
 // Se il file non esiste, la compilazione fallirà - genera con: python3 convert_assets.py
 #include "boot_logo.h"
 
+// Font atlas anti-aliased (generato con: python3 convert_assets.py)
+#include "font_atlas.h"
+
+// Band buffer per comporre il testo prima dell'invio SPI
+static uint16_t text_band[TEXT_BAND_PIXELS];
+
+// Byte SPI di comando per ogni finestra indirizzo (CASET 4 + RASET 4 + RAMWR, con opcode)
+#define SPI_WINDOW_OVERHEAD_BYTES 11
+
+// Layout alert adattato per 240x240 (vs 320x240 originale)
+// Scala approssimativa: 75% (240/320)
+static const int16_t ALERT_WIDTH = 120;   // 160 * 0.75
+static const int16_t ALERT_HEIGHT = 120;  // 160 * 0.75
+static const int16_t ALERT_X = (DISPLAY_WIDTH - ALERT_WIDTH) / 2;  // Centrato
+static const int16_t ALERT_Y = 60;
+static const int16_t ALERT_DISTANCE_Y = ALERT_Y + 80;
+
+// Pannello Tutor nell'area dell'alert, sopra le info GPS (righe 165-200)
+static const int16_t SECTION_PANEL_HEIGHT = 100;
+static const int16_t SECTION_AVERAGE_Y = ALERT_Y + 24;
+static const int16_t SECTION_MARGIN_Y = ALERT_Y + 48;
+static const int16_t SECTION_ALLOWED_Y = ALERT_Y + 64;
+static const int16_t SECTION_REMAINING_Y = ALERT_Y + 80;
+
+// Arco distanza residua lungo il bordo del display rotondo
+static const int16_t ARC_CENTER_X = DISPLAY_WIDTH / 2;
+static const int16_t ARC_CENTER_Y = DISPLAY_HEIGHT / 2;
+static const int16_t ARC_R_OUTER = 119;
+static const int16_t ARC_R_INNER = 114;
+
 // Nota: Implementare con libreria display GC9A01 corretta
 // Per ora, implementazione stub che deve essere completata con driver specifico
 // Opzioni:
@@ -16,15 +52,43 @@ DisplayController::DisplayController() :
     display(nullptr),
     is_initialized(false),
     showing_alert(false),
-    alert_start_time(0),
     alert_display_time(10000),  // 10 secondi default
+    boot_tween(-1),
+    alert_timer(-1),
+    pulse_timer(-1),
+    transition_tween(-1),
+    boot_in_progress(false),
+    idle_pending(false),
+    boot_fade_step(-1),
+    boot_hold_ms(0),
+    overspeed_level(0),
+    pulse_on(false),
+    beep_pending(false),
     gps_has_fix(false),
     gps_satellites(0) {
+    
+    alert_widget.drawn = false;
+    alert_widget.speedcam_id = 0;
+    alert_widget.digits[0] = '\0';
+    alert_widget.progress_steps = 0;
+    alert_widget.distance = 0.0f;
+    
+    section_widget.drawn = false;
+    section_widget.start_id = 0;
+    
+    preview_widget.drawn = false;
+    preview_widget.text[0] = '\0';
+    
+    // Tabella semi-larghezze del disco visibile
+    viewport_begin();
+    
+    resetStats();
 }
 
 DisplayController::~DisplayController() {
+    // Oggetto nell'arena render (statica): solo distruzione
     if (display) {
-        delete display;
+        display->~Adafruit_GC9A01A();
     }
 }
 
@@ -32,67 +96,44 @@ bool DisplayController::begin() {
     // Opzione per disabilitare display (per debug)
     #ifdef DISPLAY_ENABLED
     if (!DISPLAY_ENABLED) {
-        #ifdef DEBUG_ENABLED
-        if (DEBUG_ENABLED) {
-            Serial.println("[Display] Display disabilitato in config.h");
-        }
-        #endif
+        LOG_W(DISPLAY, "Display disabilitato in config.h");
         return false;
     }
     #endif
     
-    #ifdef DEBUG_ENABLED
-    if (DEBUG_ENABLED) {
-        Serial.println("[Display] Inizio inizializzazione...");
-        Serial.flush();
-    }
-    #endif
+    LOG_D(DISPLAY, "Inizio inizializzazione...");
     
     // Inizializza pin di reset e backlight prima di SPI
     // Nota: RST può essere -1 se non usato (come nel Factory_samples.ino)
     if (DISPLAY_RST_PIN >= 0) {
-        #ifdef DEBUG_ENABLED
-        if (DEBUG_ENABLED) {
-            Serial.print("[Display] Reset pin: ");
-            Serial.println(DISPLAY_RST_PIN);
-        }
-        #endif
+        LOG_D(DISPLAY, "Reset pin: %d", DISPLAY_RST_PIN);
         pinMode(DISPLAY_RST_PIN, OUTPUT);
         digitalWrite(DISPLAY_RST_PIN, LOW);
         delay(10);
         digitalWrite(DISPLAY_RST_PIN, HIGH);
         delay(10);
     } else {
-        #ifdef DEBUG_ENABLED
-        if (DEBUG_ENABLED) {
-            Serial.println("[Display] Reset pin: non usato (-1)");
-        }
-        #endif
+        LOG_D(DISPLAY, "Reset pin: non usato (-1)");
     }
     
     // Inizializza backlight se presente (ma NON accenderlo ancora!)
     // Lo accenderemo solo DOPO che lo schermo è pulito per evitare "effetto neve"
     if (DISPLAY_BL_PIN >= 0) {
-        #ifdef DEBUG_ENABLED
-        if (DEBUG_ENABLED) {
-            Serial.print("[Display] Backlight pin: ");
-            Serial.println(DISPLAY_BL_PIN);
-        }
-        #endif
+        LOG_D(DISPLAY, "Backlight pin: %d", DISPLAY_BL_PIN);
         pinMode(DISPLAY_BL_PIN, OUTPUT);
         digitalWrite(DISPLAY_BL_PIN, LOW);  // Backlight SPENTO durante inizializzazione
     }
     
+    // Buzzer dell'avviso di velocità (spento)
+    if (OVERSPEED_BEEP_PIN >= 0) {
+        pinMode(OVERSPEED_BEEP_PIN, OUTPUT);
+        digitalWrite(OVERSPEED_BEEP_PIN, LOW);
+    }
+    
     // Inizializza SPI per display
     // NOTA: Non chiamare SPI.begin() qui - la libreria Adafruit lo fa automaticamente
     // Chiamarlo qui può causare conflitti
-    #ifdef DEBUG_ENABLED
-    if (DEBUG_ENABLED) {
-        Serial.println("[Display] SPI verrà inizializzato dalla libreria...");
-        Serial.flush();
-    }
-    #endif
-    delay(50);  // Delay per stabilizzazione prima di creare display
+    LOG_D(DISPLAY, "SPI verrà inizializzato dalla libreria...");
     
     // Crea oggetto display GC9A01
     // Nota: Per ESP32-C3, i pin SPI hardware di default sono:
@@ -101,63 +142,45 @@ bool DisplayController::begin() {
     // - SCK: GPIO6
     // Il costruttore con 3 parametri usa SPI hardware di default
     // Se i pin MOSI/SCK sono diversi, usare costruttore con 5 parametri
-    #ifdef DEBUG_ENABLED
-    if (DEBUG_ENABLED) {
-        Serial.print("[Display] Creazione oggetto display (CS=");
-        Serial.print(DISPLAY_CS_PIN);
-        Serial.print(", DC=");
-        Serial.print(DISPLAY_DC_PIN);
-        Serial.print(", RST=");
-        Serial.print(DISPLAY_RST_PIN);
-        #if defined(DISPLAY_MOSI_PIN) && defined(DISPLAY_SCK_PIN)
-        Serial.print(", MOSI=");
-        Serial.print(DISPLAY_MOSI_PIN);
-        Serial.print(", SCK=");
-        Serial.print(DISPLAY_SCK_PIN);
-        #else
-        Serial.print(", SPI=hardware default (MOSI=7, SCK=6)");
-        #endif
-        Serial.println(")...");
-    }
+    #if defined(DISPLAY_MOSI_PIN) && defined(DISPLAY_SCK_PIN)
+    LOG_D(DISPLAY, "Creazione oggetto display (CS=%d, DC=%d, RST=%d, MOSI=%d, SCK=%d)...",
+          DISPLAY_CS_PIN, DISPLAY_DC_PIN, DISPLAY_RST_PIN, DISPLAY_MOSI_PIN, DISPLAY_SCK_PIN);
+    #else
+    LOG_D(DISPLAY, "Creazione oggetto display (CS=%d, DC=%d, RST=%d, SPI=hardware default (MOSI=7, SCK=6))...",
+          DISPLAY_CS_PIN, DISPLAY_DC_PIN, DISPLAY_RST_PIN);
     #endif
     
+    // Oggetto nell'arena render (begin() chiamato una sola volta)
+    void* display_memory = arena_get(ARENA_RENDER).allocate(sizeof(Adafruit_GC9A01A), alignof(Adafruit_GC9A01A));
+    
     // Usa costruttore con pin SPI espliciti se definiti, altrimenti usa SPI hardware default
     #if defined(DISPLAY_MOSI_PIN) && defined(DISPLAY_SCK_PIN) && DISPLAY_MOSI_PIN >= 0 && DISPLAY_SCK_PIN >= 0
         // Costruttore con pin SPI espliciti
-        display = new Adafruit_GC9A01A(
+        display = display_memory ? new (display_memory) Adafruit_GC9A01A(
             DISPLAY_CS_PIN,
             DISPLAY_DC_PIN,
             DISPLAY_MOSI_PIN,
             DISPLAY_SCK_PIN,
             DISPLAY_RST_PIN
-        );
+        ) : nullptr;
     #else
         // Costruttore con SPI hardware di default (MOSI=7, SCK=6 su ESP32-C3)
-        display = new Adafruit_GC9A01A(
+        display = display_memory ? new (display_memory) Adafruit_GC9A01A(
             DISPLAY_CS_PIN,
             DISPLAY_DC_PIN,
             DISPLAY_RST_PIN
-        );
+        ) : nullptr;
     #endif
     
     if (!display) {
-        #ifdef DEBUG_ENABLED
-        if (DEBUG_ENABLED) {
-            Serial.println("[Display] ERRORE: Errore creazione oggetto display");
-        }
-        #endif
+        LOG_E(DISPLAY, "Creazione oggetto display fallita");
         return false;
     }
     
     // Inizializza display
     // Nota: begin() restituisce void, non bool
     // IMPORTANTE: begin() può richiedere tempo e potrebbe causare reset watchdog
-    #ifdef DEBUG_ENABLED
-    if (DEBUG_ENABLED) {
-        Serial.println("[Display] Chiamata display->begin()...");
-        Serial.flush();
-    }
-    #endif
+    LOG_D(DISPLAY, "Chiamata display->begin()...");
     
     // Feed watchdog prima di begin() per evitare reset
     #ifdef ESP32
@@ -174,70 +197,43 @@ bool DisplayController::begin() {
     
     // Pulisci IMMEDIATAMENTE lo schermo per evitare puntini casuali all'avvio
     // Fallo prima di qualsiasi altra operazione e PRIMA di accendere il backlight
-    display->fillScreen(COLOR_BLACK);
-    delay(10);  // Delay per permettere l'aggiornamento
+    // (fillRect è sincrono: nessuna attesa necessaria prima di proseguire)
+    fillArea(0, 0, DISPLAY_WIDTH, DISPLAY_HEIGHT, COLOR_BLACK);
     
-    delay(50);  // Delay per stabilizzazione hardware dopo pulizia
-    
-    #ifdef DEBUG_ENABLED
-    if (DEBUG_ENABLED) {
-        Serial.println("[Display] display->begin() completato");
-        Serial.flush();
-    }
-    #endif
+    LOG_D(DISPLAY, "display->begin() completato");
     
-    #ifdef DEBUG_ENABLED
-    if (DEBUG_ENABLED) {
-        Serial.println("[Display] Configurazione display...");
-    }
-    #endif
+    LOG_D(DISPLAY, "Configurazione display...");
     
     // Configura display
     display->setRotation(0);  // Orientamento normale
-    delay(10);
     
     // Pulisci nuovamente lo schermo per sicurezza
-    display->fillScreen(COLOR_BLACK);
-    delay(10);
+    fillArea(0, 0, DISPLAY_WIDTH, DISPLAY_HEIGHT, COLOR_BLACK);
     
     // ORA accendi il backlight solo quando lo schermo è già nero e pulito
     // Questo elimina completamente l'effetto "neve" all'avvio
     if (DISPLAY_BL_PIN >= 0) {
         digitalWrite(DISPLAY_BL_PIN, HIGH);
-        delay(10);  // Piccolo delay per stabilizzazione backlight
-        #ifdef DEBUG_ENABLED
-        if (DEBUG_ENABLED) {
-            Serial.println("[Display] Backlight acceso (schermo già pulito)");
-        }
-        #endif
+        LOG_D(DISPLAY, "Backlight acceso (schermo già pulito)");
     }
     
     is_initialized = true;
     
-    #ifdef DEBUG_ENABLED
-    if (DEBUG_ENABLED) {
-        Serial.println("[Display] ✅ Display inizializzato (240x240)");
-    }
-    #endif
+    LOG_I(DISPLAY, "✅ Display inizializzato (240x240)");
     
     return true;
 }
 
 void DisplayController::showBootLogo(unsigned long display_time_ms) {
     if (!is_initialized || !display) {
-        #ifdef DEBUG_ENABLED
-        if (DEBUG_ENABLED) {
-            Serial.println("[Display] showBootLogo: display non inizializzato!");
-        }
-        #endif
+        LOG_E(DISPLAY, "showBootLogo: display non inizializzato!");
         return;
     }
     
-    #ifdef DEBUG_ENABLED
-    if (DEBUG_ENABLED) {
-        Serial.println("[Display] showBootLogo: inizio rendering...");
-    }
-    #endif
+    LOG_D(DISPLAY, "showBootLogo: inizio rendering...");
+    
+    // Riavvio della sequenza (es. ritorno da alert durante il boot)
+    cancelBootSequence();
     
     // Assicura che backlight sia acceso
     if (DISPLAY_BL_PIN >= 0) {
@@ -245,103 +241,93 @@ void DisplayController::showBootLogo(unsigned long display_time_ms) {
     }
     
     // Mostra boot logo da array C (veloce, compilato nel firmware)
-    display->fillScreen(COLOR_BLACK);
-    delay(10);
+    fillArea(0, 0, DISPLAY_WIDTH, DISPLAY_HEIGHT, COLOR_BLACK);
+    section_widget.drawn = false;
+    preview_widget.drawn = false;
+    
+    boot_in_progress = true;
+    boot_hold_ms = display_time_ms;
+    boot_fade_step = -1;
+    
+    #if defined(BOOT_LOGO_DATA_AVAILABLE) && BOOT_LOGO_FADE_ENABLED
+    // Fade-in: ogni update() ridisegna il logo se lo step di intensità è cambiato
+    LOG_D(DISPLAY, "Boot logo fade-in: %d step, %d ms", BOOT_LOGO_FADE_STEPS, BOOT_LOGO_FADE_DURATION);
+    boot_tween = animations.start(BOOT_LOGO_FADE_DURATION, 0.0f, 1.0f,
+                                  onBootFadeUpdate, onBootFadeComplete, this);
+    #endif
+    
+    if (boot_tween < 0) {
+        // Nessun fade (o nessuno slot libero): logo pieno subito
+        drawBootLogoFrame(1.0f);
+        onBootFadeComplete(this);
+    }
+    
+    if (!DISPLAY_NONBLOCKING_ANIMATIONS) {
+        // Comportamento bloccante: attende fade e permanenza
+        while (boot_in_progress) {
+            animations.update(millis());
+            delay(1);
+        }
+    }
+}
+
+bool DisplayController::isBootComplete() const {
+    return !boot_in_progress;
+}
+
+void DisplayController::drawBootLogoFrame(float fade_factor) {
+    if (!display) return;
+    TRACE_SCOPE(TRACE_DISPLAY_BOOT_LOGO);
+    
     
     #ifdef BOOT_LOGO_DATA_AVAILABLE
-    // Mostra boot logo con fade-in opzionale
     unsigned long render_start = millis();
     
     const uint16_t width = boot_logo_data_width;
     const uint16_t height = boot_logo_data_height;
+    const bool faded = fade_factor < 1.0f;
     
-    #if BOOT_LOGO_FADE_ENABLED
-        // Fade-in: renderizza il logo più volte con intensità crescente
-        const uint16_t fade_steps = BOOT_LOGO_FADE_STEPS;
-        const unsigned long fade_duration = BOOT_LOGO_FADE_DURATION;
-        const unsigned long step_delay = fade_duration / fade_steps;
-        
-        #ifdef DEBUG_ENABLED
-        if (DEBUG_ENABLED) {
-            Serial.print("[Display] Boot logo fade-in: ");
-            Serial.print(fade_steps);
-            Serial.print(" step, ");
-            Serial.print(fade_duration);
-            Serial.println(" ms");
-            Serial.flush();
-        }
-        #endif
-        
-        // Buffer per una riga (200 pixel = 400 bytes)
-        static uint16_t row_buffer[200];  // Max width del logo
-        
-        for (uint16_t step = 0; step <= fade_steps; step++) {
-            // Calcola fattore fade (0.0 = nero, 1.0 = colore pieno)
-            float fade_factor = (float)step / (float)fade_steps;
-            
-            // Imposta area di disegno
-            display->startWrite();
-            display->setAddrWindow(boot_logo_data_offset_x, boot_logo_data_offset_y, 
-                                  width, height);
-            
-            // Renderizza logo con fade applicato
-            for (uint16_t y = 0; y < height; y++) {
-                // Copia riga da PROGMEM a RAM e applica fade
-                for (uint16_t x = 0; x < width; x++) {
-                    uint32_t idx = y * width + x;
-                    uint16_t original_color = pgm_read_word(&boot_logo_data[idx]);
-                    row_buffer[x] = fadeColor565(original_color, fade_factor);
-                }
-                // Invia riga completa in batch
-                display->writePixels(row_buffer, width, true, false);
-            }
-            
-            display->endWrite();
-            
-            // Delay tra step (tranne l'ultimo)
-            if (step < fade_steps) {
-                delay(step_delay);
-            }
-        }
-    #else
-        // Rendering normale senza fade (velocissimo)
-        display->startWrite();
+    // Logo che sporge dal disco visibile: una finestra per riga, tagliata al disco
+    const bool logo_clipped = DISPLAY_CIRCULAR_CLIP &&
+        !viewport_rect_inside(boot_logo_data_offset_x, boot_logo_data_offset_y, width, height);
+    
+    // Buffer per una riga (200 pixel = 400 bytes)
+    static uint16_t row_buffer[200];  // Max width del logo
+    
+    // Imposta area di disegno
+    display->startWrite();
+    if (!logo_clipped) {
         display->setAddrWindow(boot_logo_data_offset_x, boot_logo_data_offset_y, 
                               width, height);
-        
-        // Buffer per una riga (200 pixel = 400 bytes)
-        static uint16_t row_buffer[200];  // Max width del logo
-        
-        for (uint16_t y = 0; y < height; y++) {
-            // Copia riga da PROGMEM a RAM
-            for (uint16_t x = 0; x < width; x++) {
-                uint32_t idx = y * width + x;
-                row_buffer[x] = pgm_read_word(&boot_logo_data[idx]);
-            }
-            // Invia riga completa in batch (MOLTO più veloce di pixel singoli!)
+    }
+    
+    for (uint16_t y = 0; y < height; y++) {
+        // Copia riga da PROGMEM a RAM (applicando il fade se richiesto)
+        for (uint16_t x = 0; x < width; x++) {
+            uint32_t idx = y * width + x;
+            uint16_t original_color = pgm_read_word(&boot_logo_data[idx]);
+            row_buffer[x] = faded ? fadeColor565(original_color, fade_factor) : original_color;
+        }
+        // Invia riga completa in batch (MOLTO più veloce di pixel singoli!)
+        if (logo_clipped) {
+            writeClippedRow(boot_logo_data_offset_x, boot_logo_data_offset_y + y, row_buffer, width);
+        } else {
             display->writePixels(row_buffer, width, true, false);
         }
-        
-        display->endWrite();
-    #endif
+    }
+    
+    display->endWrite();
+    if (!logo_clipped) {
+        accountPixels((uint32_t)width * height);
+    }
     
     unsigned long render_time = millis() - render_start;
-    #ifdef DEBUG_ENABLED
-    if (DEBUG_ENABLED) {
-        Serial.print("[Display] Boot logo renderizzato in ");
-        Serial.print(render_time);
-        Serial.print(" ms (");
-        #if BOOT_LOGO_FADE_ENABLED
-        Serial.print("fade-in, ");
-        #endif
-        Serial.print(width * height);
-        Serial.println(" pixel)");
-        Serial.flush();
+    if (!faded) {
+        LOG_D(DISPLAY, "Boot logo renderizzato in %lu ms (%lu pixel)", render_time, (unsigned long)width * height);
     }
-    #endif
     #else
     // Fallback: mostra testo "MicroNav"
-    display->setTextColor(COLOR_WHITE);
+    display->setTextColor(fadeColor565(COLOR_WHITE, fade_factor));
     display->setTextSize(2);
     
     // Centra testo "MicroNav"
@@ -353,53 +339,117 @@ void DisplayController::showBootLogo(unsigned long display_time_ms) {
     
     display->setCursor(x, y);
     display->print("MicroNav");
-    #ifdef DEBUG_ENABLED
-    if (DEBUG_ENABLED) {
-        Serial.println("[Display] Boot logo non disponibile, uso testo fallback");
-        Serial.flush();
-    }
-    #endif
+    LOG_D(DISPLAY, "Boot logo non disponibile, uso testo fallback");
     #endif
     
-    #ifdef DEBUG_ENABLED
-    if (DEBUG_ENABLED) {
-        Serial.println("[Display] showBootLogo: rendering completato");
-        Serial.flush();
-    }
-    #endif
+    endFrame();
+}
+
+void DisplayController::cancelBootSequence() {
+    animations.cancel(boot_tween);
+    boot_tween = -1;
+    boot_in_progress = false;
+}
+
+void DisplayController::onBootFadeUpdate(void* ctx, float value) {
+    DisplayController* self = static_cast<DisplayController*>(ctx);
+    
+    // Ridisegna solo quando cambia lo step di intensità
+    int16_t step = (int16_t)(value * BOOT_LOGO_FADE_STEPS + 0.5f);
+    if (step == self->boot_fade_step) return;
+    
+    self->boot_fade_step = step;
+    self->drawBootLogoFrame((float)step / (float)BOOT_LOGO_FADE_STEPS);
+}
+
+void DisplayController::onBootFadeComplete(void* ctx) {
+    DisplayController* self = static_cast<DisplayController*>(ctx);
+    self->boot_tween = -1;
+    
+    LOG_D(DISPLAY, "showBootLogo: rendering completato");
+    
     
     // Disegna indicatore GPS in alto al centro (pallino verde/rosso)
-    drawGPSIndicator(gps_has_fix, gps_satellites);
+    self->drawGPSIndicator(self->gps_has_fix, self->gps_satellites);
     
     // Aggiungi info GPS sotto il logo (senza re-render completo)
-    drawGPSInfo();
+    self->drawGPSInfo();
+    
+    self->endFrame();
+    
+    LOG_D(DISPLAY, "showBootLogo: info GPS aggiunte");
     
-    #ifdef DEBUG_ENABLED
-    if (DEBUG_ENABLED) {
-        Serial.println("[Display] showBootLogo: info GPS aggiunte");
-        Serial.flush();
+    // Mostra per tempo specificato (timer, senza bloccare il loop)
+    self->boot_tween = self->animations.startTimer(self->boot_hold_ms, onBootHoldComplete, self);
+    if (self->boot_tween < 0) {
+        onBootHoldComplete(self);
     }
-    #endif
+}
+
+void DisplayController::onBootHoldComplete(void* ctx) {
+    DisplayController* self = static_cast<DisplayController*>(ctx);
+    self->boot_tween = -1;
+    self->boot_in_progress = false;
+    
+    LOG_I(DISPLAY, "Boot logo completato");
     
-    // Mostra per tempo specificato
-    delay(display_time_ms);
+    // Schermata idle richiesta mentre il logo era ancora in corso
+    if (self->idle_pending) {
+        self->idle_pending = false;
+        self->showIdleScreen();
+    }
+}
+
+void DisplayController::onAlertTimeout(void* ctx) {
+    DisplayController* self = static_cast<DisplayController*>(ctx);
+    self->alert_timer = -1;
+    self->hideSpeedcamAlert();
+}
+
+void DisplayController::onOverspeedPulse(void* ctx) {
+    DisplayController* self = static_cast<DisplayController*>(ctx);
+    self->pulse_timer = -1;
+    self->pulse_on = !self->pulse_on;
+    if (!self->pulse_on) {
+        self->beep_pending = false;
+    }
+    self->setBeep(self->pulse_on && (self->overspeed_level == OVERSPEED_CRITICAL || self->beep_pending));
+    self->drawAlertBorder();
+    self->endFrame();
+    self->pulse_timer = self->animations.startTimer(
+        self->overspeed_level == OVERSPEED_CRITICAL ? OVERSPEED_PULSE_FAST_MS : OVERSPEED_PULSE_MS,
+        onOverspeedPulse, self);
+}
+
+void DisplayController::onAlertTransitionUpdate(void* ctx, float value) {
+    DisplayController* self = static_cast<DisplayController*>(ctx);
+    if (!self->showing_alert || !self->alert_widget.drawn) return;
+    self->drawAlertDistance(value, false);
+    self->drawAlertProgress(value, false);
+    self->endFrame();
+}
+
+void DisplayController::onAlertTransitionComplete(void* ctx) {
+    DisplayController* self = static_cast<DisplayController*>(ctx);
+    self->transition_tween = -1;
 }
 
 void DisplayController::showIdleScreen() {
+    TRACE_SCOPE(TRACE_DISPLAY_IDLE_SCREEN);
+    
     if (!is_initialized || !display) {
-        #ifdef DEBUG_ENABLED
-        if (DEBUG_ENABLED) {
-            Serial.println("[Display] showIdleScreen: display non inizializzato!");
-        }
-        #endif
+        LOG_E(DISPLAY, "showIdleScreen: display non inizializzato!");
         return;
     }
     
-    #ifdef DEBUG_ENABLED
-    if (DEBUG_ENABLED) {
-        Serial.println("[Display] showIdleScreen: aggiornamento info GPS...");
+    // Boot logo ancora in corso: la schermata idle arriva al termine
+    if (boot_in_progress) {
+        idle_pending = true;
+        LOG_D(DISPLAY, "showIdleScreen: rimandata a fine boot logo");
+        return;
     }
-    #endif
+    
+    LOG_D(DISPLAY, "showIdleScreen: aggiornamento info GPS...");
     
     // Assicura che backlight sia acceso
     if (DISPLAY_BL_PIN >= 0) {
@@ -409,11 +459,7 @@ void DisplayController::showIdleScreen() {
     // Aggiorna solo le info GPS (senza re-render completo, mantiene il logo)
     drawGPSInfo();
     
-    #ifdef DEBUG_ENABLED
-    if (DEBUG_ENABLED) {
-        Serial.println("[Display] showIdleScreen: rendering completato");
-    }
-    #endif
+    LOG_D(DISPLAY, "showIdleScreen: rendering completato");
     
     showing_alert = false;
 }
@@ -421,38 +467,255 @@ void DisplayController::showIdleScreen() {
 void DisplayController::showSpeedcamAlert(const struct Speedcam& speedcam, float distance) {
     if (!is_initialized) return;
     
+    // Un alert ha la precedenza sul boot logo
+    if (boot_in_progress) {
+        cancelBootSequence();
+    }
+    
+    uint32_t cycles_before = hal_cycles();
+    unsigned long bytes_before = stats.spi_bytes;
+    bool incremental = showing_alert && alert_widget.drawn && alert_widget.speedcam_id == speedcam.id;
+    bool transition = showing_alert && alert_widget.drawn && !incremental;
+    
+    // Il fix nuovo sostituisce la distanza animata
+    animations.cancel(transition_tween);
+    transition_tween = -1;
+    
+    if (incremental) {
+        // Stessa speedcam già a schermo: aggiorna solo cifre e arco
+        updateSpeedcamAlertContent(distance);
+        stats.alert_updates++;
+    } else if (transition) {
+        // Speedcam successiva (ravvicinate): solo la scheda, distanza animata
+        drawSpeedcamAlertContent(speedcam, distance, true);
+        stats.alert_transitions++;
+    } else {
+        // Disegna alert sopra schermata corrente
+        drawSpeedcamAlertContent(speedcam, distance, false);
+        stats.alert_full_redraws++;
+    }
+    alert_widget.distance = distance;
+    
     showing_alert = true;
-    alert_start_time = millis();
     
-    // Disegna alert sopra schermata corrente
-    drawSpeedcamAlertContent(speedcam, distance);
+    // (Ri)avvia timeout alert
+    animations.cancel(alert_timer);
+    alert_timer = animations.startTimer(alert_display_time, onAlertTimeout, this);
+    stats.last_alert_bytes = stats.spi_bytes - bytes_before;
+    endFrame();
+    stats.last_alert_cycles = hal_cycles() - cycles_before;
+    
+    LOG_D(DISPLAY, "Alert %s: %lu byte SPI", incremental ? "aggiornato" : "disegnato", stats.last_alert_bytes);
 }
 
 void DisplayController::hideSpeedcamAlert() {
     if (!is_initialized) return;
+    TRACE_SCOPE(TRACE_DISPLAY_ALERT_HIDE);
     
     showing_alert = false;
+    alert_widget.drawn = false;
+    animations.cancel(alert_timer);
+    alert_timer = -1;
+    animations.cancel(transition_tween);
+    transition_tween = -1;
+    
+    // L'avviso di velocità vive sull'alert
+    animations.cancel(pulse_timer);
+    pulse_timer = -1;
+    overspeed_level = OVERSPEED_NONE;
+    pulse_on = false;
+    beep_pending = false;
+    setBeep(false);
+    
+    LOG_D(DISPLAY, "hideSpeedcamAlert: ritorno al boot logo");
     
-    #ifdef DEBUG_ENABLED
-    if (DEBUG_ENABLED) {
-        Serial.println("[Display] hideSpeedcamAlert: ritorno al boot logo");
+    // Mostra boot logo invece della schermata idle
+    showBootLogo(0);  // 0 = nessuna permanenza dopo il fade
+}
+
+void DisplayController::showSectionStatus(const SectionStatus& status) {
+    if (!is_initialized || !display) return;
+    
+    // Alert o boot logo a schermo: il pannello torna con il primo fix successivo
+    if (showing_alert || boot_in_progress) return;
+    
+    const uint16_t vmax = status.section.vmax_kmh;
+    bool force = !section_widget.drawn || section_widget.start_id != status.section.start_id;
+    if (force) {
+        drawRoundedRectFilled(ALERT_X, ALERT_Y, ALERT_WIDTH, SECTION_PANEL_HEIGHT, 6, COLOR_MICRONAV_BLUE_20);
+        drawRoundedRect(ALERT_X, ALERT_Y, ALERT_WIDTH, SECTION_PANEL_HEIGHT, 6, COLOR_BLUE);
+        drawText(font_small, "TUTOR", ALERT_X + 10, ALERT_Y + 6, COLOR_WHITE, COLOR_MICRONAV_BLUE_20);
+        if (vmax) {
+            char limit[12];
+            snprintf(limit, sizeof(limit), "lim %u", vmax);
+            drawText(font_small, limit, ALERT_X + ALERT_WIDTH - 10, ALERT_Y + 6, COLOR_WHITE,
+                     COLOR_MICRONAV_BLUE_20, TEXT_ALIGN_RIGHT);
+        }
     }
-    #endif
     
-    // Mostra boot logo invece della schermata idle
-    showBootLogo(0);  // 0 = mostra senza delay
+    // Media: cifre in celle fisse come la distanza dell'alert (font_medium ha solo cifre)
+    char average[4];
+    snprintf(average, sizeof(average), "%3d", constrain((int)(status.average_kmh + 0.5f), 0, 999));
+    const uint16_t cell_width = font_renderer.measure(font_medium, "0");
+    const uint16_t unit_width = font_renderer.measure(font_small, " km/h");
+    const int16_t average_x = ALERT_X + (ALERT_WIDTH - (cell_width * 3 + unit_width)) / 2;
+    for (uint8_t i = 0; i < 3; i++) {
+        if (!force && average[i] == section_widget.average[i]) continue;
+        char cell[2] = { average[i], '\0' };
+        drawTextBox(font_medium, cell, average_x + i * cell_width, SECTION_AVERAGE_Y, cell_width,
+                    COLOR_WHITE, COLOR_MICRONAV_BLUE_20, TEXT_ALIGN_CENTER);
+    }
+    if (force) {
+        drawText(font_small, " km/h", average_x + 3 * cell_width,
+                 SECTION_AVERAGE_Y + font_medium.height - font_small.height, COLOR_WHITE, COLOR_MICRONAV_BLUE_20);
+    }
+    memcpy(section_widget.average, average, sizeof(average));
+    
+    // Margine della media prevista all'uscita e velocità massima sul resto della tratta
+    char text[12];
+    int margin = (int)floorf(status.margin_kmh + 0.5f);
+    if (vmax) {
+        snprintf(text, sizeof(text), "marg %+d", margin);
+    } else {
+        snprintf(text, sizeof(text), "lim ?");
+    }
+    drawSectionRow(text, section_widget.margin, sizeof(section_widget.margin), SECTION_MARGIN_Y,
+                   vmax && margin < 0 ? COLOR_RED : COLOR_GREEN, force);
+    
+    if (!vmax) {
+        text[0] = '\0';
+    } else if (status.allowed_kmh >= SECTION_NO_LIMIT) {
+        snprintf(text, sizeof(text), "max libera");
+    } else {
+        snprintf(text, sizeof(text), "max %d", (int)status.allowed_kmh);
+    }
+    drawSectionRow(text, section_widget.allowed, sizeof(section_widget.allowed), SECTION_ALLOWED_Y,
+                   COLOR_WHITE, force);
+    
+    snprintf(text, sizeof(text), "fine %.1f km", status.remaining_m / 1000.0f);
+    drawSectionRow(text, section_widget.remaining, sizeof(section_widget.remaining), SECTION_REMAINING_Y,
+                   COLOR_LIGHT_GRAY, force);
+    
+    section_widget.drawn = true;
+    section_widget.start_id = status.section.start_id;
+    stats.section_updates++;
+    endFrame();
 }
 
-void DisplayController::update() {
+void DisplayController::hideSectionStatus() {
+    if (!is_initialized || !section_widget.drawn) return;
+    
+    section_widget.drawn = false;
+    LOG_D(DISPLAY, "hideSectionStatus: ritorno al boot logo");
+    showBootLogo(0);
+}
+
+void DisplayController::showNextSpeedcam(const struct Speedcam& speedcam, float distance) {
+    if (!is_initialized || !display) return;
+    if (showing_alert || boot_in_progress) return;
+    
+    // Distanza arrotondata a 50 m (sotto il km) o a 100 m: la riga cambia di rado
+    char text[sizeof(preview_widget.text)];
+    const char* type_text = (speedcam.type[0] == 'A') ? "T RED" : "VELOX";
+    // Limitata a 999.9 km: "1000m" e "999.9km" sono le righe più lunghe
+    char distance_text[8];
+    if (distance < 1000.0f) {
+        unsigned meters = min((unsigned)max(distance, 0.0f), 999u);
+        snprintf(distance_text, sizeof(distance_text), "%um", (meters + 25) / 50 * 50);
+    } else {
+        snprintf(distance_text, sizeof(distance_text), "%.1fkm", min(distance, 999900.0f) / 1000.0f);
+    }
+    if (speedcam.type[0] != 'A' && speedcam.vmax) {
+        snprintf(text, sizeof(text), "%s %s %u", type_text, distance_text, speedcam.vmax);
+    } else {
+        snprintf(text, sizeof(text), "%s %s", type_text, distance_text);
+    }
+    if (preview_widget.drawn && strcmp(text, preview_widget.text) == 0) return;
+    
+    drawTextBox(font_small, text, ALERT_X, PREVIEW_Y, ALERT_WIDTH, COLOR_YELLOW, COLOR_BLACK, TEXT_ALIGN_CENTER);
+    strncpy(preview_widget.text, text, sizeof(preview_widget.text) - 1);
+    preview_widget.text[sizeof(preview_widget.text) - 1] = '\0';
+    preview_widget.drawn = true;
+    stats.preview_updates++;
+    endFrame();
+}
+
+void DisplayController::hideNextSpeedcam() {
+    if (!is_initialized || !display || !preview_widget.drawn) return;
+    if (showing_alert || boot_in_progress) return;
+    
+    drawTextBox(font_small, "", ALERT_X, PREVIEW_Y, ALERT_WIDTH, COLOR_YELLOW, COLOR_BLACK, TEXT_ALIGN_CENTER);
+    preview_widget.drawn = false;
+    endFrame();
+}
+
+void DisplayController::setOverspeedLevel(uint8_t level) {
     if (!is_initialized) return;
     
-    // Verifica timeout alert
-    if (showing_alert && (millis() - alert_start_time) > alert_display_time) {
-        hideSpeedcamAlert();
+    // Senza alert a schermo non c'è bordo da colorare
+    if (!showing_alert || !alert_widget.drawn) {
+        level = OVERSPEED_NONE;
+    }
+    if (level == overspeed_level) return;
+    
+    bool entering_brake = level >= OVERSPEED_BRAKE && overspeed_level < OVERSPEED_BRAKE;
+    overspeed_level = level;
+    stats.overspeed_changes++;
+    
+    // Il lampeggio riparte dalla fase accesa (bordo bianco, beep)
+    animations.cancel(pulse_timer);
+    pulse_timer = -1;
+    pulse_on = level >= OVERSPEED_BRAKE;
+    beep_pending = entering_brake;
+    if (pulse_on) {
+        pulse_timer = animations.startTimer(level == OVERSPEED_CRITICAL ? OVERSPEED_PULSE_FAST_MS : OVERSPEED_PULSE_MS,
+                                            onOverspeedPulse, this);
+    }
+    setBeep(pulse_on && (level == OVERSPEED_CRITICAL || beep_pending));
+    
+    if (showing_alert && alert_widget.drawn) {
+        drawAlertBorder();
+        endFrame();
+    }
+    LOG_D(DISPLAY, "Avviso velocità: livello %u", (unsigned int)level);
+}
+
+void DisplayController::drawAlertBorder() {
+    uint16_t color = overspeed_level == OVERSPEED_NONE ? COLOR_MICRONAV_RED :
+                     pulse_on ? COLOR_WHITE : COLOR_YELLOW;
+    drawRoundedRect(ALERT_X, ALERT_Y, ALERT_WIDTH, ALERT_HEIGHT, 6, color);
+    // Secondo pixel solo con un avviso: a riposo torna lo sfondo dell'alert
+    drawRoundedRect(ALERT_X + 1, ALERT_Y + 1, ALERT_WIDTH - 2, ALERT_HEIGHT - 2, 5,
+                    overspeed_level == OVERSPEED_NONE ? COLOR_MICRONAV_RED_20 : color);
+}
+
+void DisplayController::setBeep(bool on) {
+    if (OVERSPEED_BEEP_PIN >= 0) {
+        digitalWrite(OVERSPEED_BEEP_PIN, on ? HIGH : LOW);
     }
 }
 
+void DisplayController::drawSectionRow(const char* text, char* shown, size_t size, int16_t y, uint16_t color,
+                                       bool force) {
+    if (!force && strcmp(text, shown) == 0) return;
+    
+    drawTextBox(font_small, text, ALERT_X + 6, y, ALERT_WIDTH - 12, color, COLOR_MICRONAV_BLUE_20, TEXT_ALIGN_CENTER);
+    strncpy(shown, text, size - 1);
+    shown[size - 1] = '\0';
+}
+
+void DisplayController::update() {
+    TRACE_SCOPE(TRACE_DISPLAY_UPDATE);
+    
+    if (!is_initialized) return;
+    
+    // Avanza fade, permanenza logo e timeout alert
+    animations.update(millis());
+}
+
 void DisplayController::updateGPSIndicator(bool has_fix, uint8_t satellites) {
+    TRACE_SCOPE(TRACE_DISPLAY_GPS_INDICATOR);
+    
     gps_has_fix = has_fix;
     gps_satellites = satellites;
     
@@ -461,98 +724,167 @@ void DisplayController::updateGPSIndicator(bool has_fix, uint8_t satellites) {
         drawGPSIndicator(has_fix, satellites);
         // Aggiorna anche le info GPS testuali (senza re-render completo)
         drawGPSInfo();
+        endFrame();
     }
 }
 
-void DisplayController::drawSpeedcamAlertContent(const struct Speedcam& speedcam, float distance) {
+void DisplayController::drawSpeedcamAlertContent(const struct Speedcam& speedcam, float distance, bool transition) {
     if (!display) return;
+    TRACE_SCOPE(TRACE_DISPLAY_ALERT_DRAW);
     
-    // Dimensioni alert adattate per 240x240 (vs 320x240 originale)
-    // Scala approssimativa: 75% (240/320)
-    int16_t alert_width = 120;  // 160 * 0.75
-    int16_t alert_height = 120; // 160 * 0.75
-    int16_t alert_x = (DISPLAY_WIDTH - alert_width) / 2;  // Centrato
-    int16_t alert_y = 60;
+    // Background semi-trasparente (simulato con rettangolo grigio scuro):
+    // in una transizione è già a schermo
+    if (!transition) {
+        fillArea(0, 20, DISPLAY_WIDTH, DISPLAY_HEIGHT - 40, COLOR_DARK_GRAY);
+    }
     
-    // Background semi-trasparente (simulato con rettangolo grigio scuro)
-    display->fillRect(0, 20, DISPLAY_WIDTH, DISPLAY_HEIGHT - 40, COLOR_DARK_GRAY);
+    // L'alert copre il pannello Tutor e l'anteprima
+    section_widget.drawn = false;
+    preview_widget.drawn = false;
     
-    // Rounded rectangle rosso per alert (simulato con rettangolo normale)
-    drawRoundedRectFilled(alert_x, alert_y, alert_width, alert_height, 6, COLOR_MICRONAV_RED_20);
-    drawRoundedRect(alert_x, alert_y, alert_width, alert_height, 6, COLOR_MICRONAV_RED);
+    // Rounded rectangle rosso per alert
+    drawRoundedRectFilled(ALERT_X, ALERT_Y, ALERT_WIDTH, ALERT_HEIGHT, 6, COLOR_MICRONAV_RED_20);
+    if (overspeed_level == OVERSPEED_NONE) {
+        drawRoundedRect(ALERT_X, ALERT_Y, ALERT_WIDTH, ALERT_HEIGHT, 6, COLOR_MICRONAV_RED);
+    } else {
+        drawAlertBorder();  // Nuova speedcam con avviso già attivo
+    }
     
     // Tipo speedcam
     const char* type_text = (speedcam.type[0] == 'A') ? "T RED" : "VELOX";
-    display->setTextColor(COLOR_WHITE);
-    display->setTextSize(1);
-    display->setCursor(alert_x + 10, alert_y + 20);
-    display->print(type_text);
+    drawText(font_small, type_text, ALERT_X + 10, ALERT_Y + 14, COLOR_WHITE, COLOR_MICRONAV_RED_20);
     
     // Stato (attivo/inattivo)
     const char* status_text = (speedcam.status == 'A') ? "attivo" : "inattivo";
-    display->setCursor(alert_x + 10, alert_y + 35);
-    display->print(status_text);
-    
-    // Distanza (grande)
-    char distance_str[16];
-    snprintf(distance_str, sizeof(distance_str), "%dm", (int)distance);
-    display->setTextSize(2);
-    display->setCursor(alert_x + 10, alert_y + 55);
-    display->print(distance_str);
+    drawText(font_small, status_text, ALERT_X + 10, ALERT_Y + 30, COLOR_WHITE, COLOR_MICRONAV_RED_20);
     
     // Indicatore visivo (cerchio)
     int16_t indicator_size = 38;  // 50 * 0.75
-    int16_t indicator_x = alert_x + alert_width - indicator_size / 2 - 8;
-    int16_t indicator_y = alert_y + 50;
+    int16_t indicator_x = ALERT_X + ALERT_WIDTH - indicator_size / 2 - 8;
+    int16_t indicator_y = ALERT_Y + 50;
     
     // Disegna cerchio con bordo
-    drawCircleWithBorder(indicator_x, indicator_y, indicator_size / 2, COLOR_WHITE, COLOR_RED, 4);
+    drawCircleWithBorder(indicator_x, indicator_y, indicator_size / 2, COLOR_WHITE, COLOR_RED, 4, COLOR_MICRONAV_RED_20);
     
     // Mostra limite velocità o icona semaforo
     if (speedcam.type[0] == 'A') {
         // Tipo A: mostra icona semaforo (per ora testo)
-        display->setTextColor(COLOR_BLACK);
-        display->setTextSize(1);
-        display->setCursor(indicator_x - 8, indicator_y - 4);
-        display->print("TL");
-    } else if (speedcam.vmax[0] != '\0' && speedcam.vmax[0] != '/') {
+        drawText(font_small, "TL", indicator_x, indicator_y - font_small.height / 2,
+                 COLOR_BLACK, COLOR_WHITE, TEXT_ALIGN_CENTER);
+    } else if (speedcam.vmax) {
         // Mostra limite velocità
-        display->setTextColor(COLOR_BLACK);
-        display->setTextSize(1);
-        int16_t text_x = indicator_x - 6;
-        int16_t text_y = indicator_y - 4;
-        display->setCursor(text_x, text_y);
-        display->print(speedcam.vmax);
+        char vmax[6];               // vmax è uint16_t: fino a 5 cifre
+        snprintf(vmax, sizeof(vmax), "%u", speedcam.vmax);
+        drawText(font_medium, vmax, indicator_x, indicator_y - font_medium.height / 2,
+                 COLOR_BLACK, COLOR_WHITE, TEXT_ALIGN_CENTER);
+    }
+    
+    // Distanza (grande, sotto il cerchio) e arco distanza residua
+    if (transition) {
+        // Si riparte dalla distanza della speedcam precedente: la scheda appena
+        // ridisegnata richiede tutte le cifre, l'arco resta e cambia per delta
+        float from = alert_widget.distance;
+        drawAlertDistance(from, true);
+        drawAlertProgress(from, false);
+        transition_tween = animations.start(ALERT_TRANSITION_MS, from, distance,
+                                            onAlertTransitionUpdate, onAlertTransitionComplete, this);
+        if (transition_tween < 0) {
+            // Nessuno slot libero: subito la distanza finale
+            drawAlertDistance(distance, false);
+            drawAlertProgress(distance, false);
+        }
+    } else {
+        drawAlertDistance(distance, true);
+        drawAlertProgress(distance, true);
+    }
+    
+    alert_widget.drawn = true;
+    alert_widget.speedcam_id = speedcam.id;
+}
+
+void DisplayController::updateSpeedcamAlertContent(float distance) {
+    if (!display) return;
+    TRACE_SCOPE(TRACE_DISPLAY_ALERT_UPDATE);
+    
+    drawAlertDistance(distance, false);
+    drawAlertProgress(distance, false);
+}
+
+void DisplayController::drawAlertDistance(float distance, bool force) {
+    // Cifre allineate a destra in celle di larghezza fissa (cifre tabulari nel font),
+    // così una cifra cambiata ridisegna solo la propria cella
+    int value = (int)distance;
+    int max_value = 1;
+    for (uint8_t i = 0; i < ALERT_DISTANCE_DIGITS; i++) max_value *= 10;
+    value = constrain(value, 0, max_value - 1);
+    
+    char digits[ALERT_DISTANCE_DIGITS + 1];
+    snprintf(digits, sizeof(digits), "%*d", ALERT_DISTANCE_DIGITS, value);
+    
+    const uint16_t cell_width = font_renderer.measure(font_large, "0");
+    const uint16_t unit_width = font_renderer.measure(font_large, "m");
+    const int16_t digits_x = ALERT_X + (ALERT_WIDTH - (cell_width * ALERT_DISTANCE_DIGITS + unit_width)) / 2;
+    
+    for (uint8_t i = 0; i < ALERT_DISTANCE_DIGITS; i++) {
+        if (!force && digits[i] == alert_widget.digits[i]) continue;
+        
+        char cell[2] = { digits[i], '\0' };
+        drawTextBox(font_large, cell, digits_x + i * cell_width, ALERT_DISTANCE_Y, cell_width,
+                    COLOR_WHITE, COLOR_MICRONAV_RED_20, TEXT_ALIGN_CENTER);
+    }
+    
+    if (force) {
+        drawText(font_large, "m", digits_x + ALERT_DISTANCE_DIGITS * cell_width, ALERT_DISTANCE_Y,
+                 COLOR_WHITE, COLOR_MICRONAV_RED_20);
+    }
+    
+    memcpy(alert_widget.digits, digits, sizeof(digits));
+}
+
+void DisplayController::drawAlertProgress(float distance, bool force) {
+    // Arco pieno = speedcam al bordo del raggio di rilevazione, vuoto = speedcam raggiunta
+    float fraction = constrain(distance / (float)SPEEDCAM_DETECTION_RADIUS, 0.0f, 1.0f);
+    uint16_t steps = (uint16_t)(fraction * ALERT_PROGRESS_STEPS + 0.5f);
+    
+    if (force) {
+        drawArcSteps(0, steps, COLOR_MICRONAV_RED);
+        drawArcSteps(steps, ALERT_PROGRESS_STEPS, COLOR_DARK_GRAY);
+    } else if (steps < alert_widget.progress_steps) {
+        // Avvicinamento: spegni solo gli step persi
+        drawArcSteps(steps, alert_widget.progress_steps, COLOR_DARK_GRAY);
+    } else if (steps > alert_widget.progress_steps) {
+        drawArcSteps(alert_widget.progress_steps, steps, COLOR_MICRONAV_RED);
     }
+    
+    alert_widget.progress_steps = steps;
+}
+
+void DisplayController::drawArcSteps(uint16_t from, uint16_t to, uint16_t color) {
+    if (from >= to) return;
+    
+    const float step_deg = 360.0f / ALERT_PROGRESS_STEPS;
+    drawArc(ARC_R_OUTER, ARC_R_INNER, from * step_deg, (to - from) * step_deg, color);
 }
 
 void DisplayController::drawGPSInfo() {
     if (!display) return;
     
     // Pulisci solo l'area delle info GPS (righe 170-200) per evitare artefatti
-    display->fillRect(0, 165, DISPLAY_WIDTH, 35, COLOR_BLACK);
-    
-    // Informazioni GPS
-    display->setTextColor(COLOR_WHITE);
-    display->setTextSize(1);
+    // (gli angoli della fascia fuori dal disco visibile vengono scartati dal clipping)
+    fillArea(0, 165, DISPLAY_WIDTH, 35, COLOR_BLACK);
     
-    // Centra la scritta "GPS: ..." orizzontalmente usando la larghezza dello schermo
+    // Informazioni GPS (centrate, larghezze stringhe in cache nel renderer)
+    // Il blocco delle due righe viene spostato verso il centro se non entra nel disco
     const char* gps_status_text = gps_has_fix ? "GPS: Fix OK" : "GPS: In attesa...";
-    int16_t x1, y1;
-    uint16_t w, h;
-    display->getTextBounds(gps_status_text, 0, 0, &x1, &y1, &w, &h);
-    int16_t center_x = (display->width() - w) / 2;
-    display->setCursor(center_x, 170);
-    display->print(gps_status_text);
+    int16_t block_x;
+    int16_t block_y = 170;
+    viewport_fit_box(font_renderer.measure(font_small, gps_status_text), 15 + font_small.height, &block_x, &block_y);
+    drawText(font_small, gps_status_text, DISPLAY_WIDTH / 2, block_y, COLOR_WHITE, COLOR_BLACK, TEXT_ALIGN_CENTER);
     
     if (gps_has_fix) {
-        // Centra la scritta "Sat: X" rispetto allo schermo
         char sat_text[16];
         snprintf(sat_text, sizeof(sat_text), "Sat: %u", gps_satellites);
-        display->getTextBounds(sat_text, 0, 0, &x1, &y1, &w, &h);
-        center_x = (display->width() - w) / 2;
-        display->setCursor(center_x, 185);
-        display->print(sat_text);
+        drawText(font_small, sat_text, DISPLAY_WIDTH / 2, block_y + 15, COLOR_WHITE, COLOR_BLACK, TEXT_ALIGN_CENTER);
     }
 }
 
@@ -564,43 +896,299 @@ void DisplayController::drawGPSIndicator(bool has_fix, uint8_t satellites) {
     int16_t y = 15;  // In alto
     int16_t radius = 8;
     
-    // Pulisci area del cerchio per evitare artefatti (disegna cerchio nero leggermente più grande)
-    display->fillCircle(x, y, radius + 2, COLOR_BLACK);
-    
     // Colore: verde se ha fix, rosso se in attesa
+    // Il bordo nero largo 3 pixel (contorno + 2 pixel di margine) pulisce anche l'area attorno
     uint16_t color = has_fix ? COLOR_GREEN : COLOR_RED;
-    display->fillCircle(x, y, radius, color);
-    display->drawCircle(x, y, radius, COLOR_BLACK);
+    drawCircleWithBorder(x, y, radius + 2, color, COLOR_BLACK, 3);
+}
+
+uint16_t DisplayController::drawText(const AtlasFont& font, const char* text, int16_t x, int16_t y,
+                                     uint16_t color, uint16_t bg, TextAlign align) {
+    if (!display || !text) return 0;
+    
+    uint16_t width = font_renderer.measure(font, text);
+    if (width == 0) return 0;
+    
+    if (align == TEXT_ALIGN_CENTER) {
+        x -= width / 2;
+    } else if (align == TEXT_ALIGN_RIGHT) {
+        x -= width;
+    }
+    
+    drawTextBox(font, text, x, y, width, color, bg);
+    
+    return width;
+}
+
+void DisplayController::drawTextBox(const AtlasFont& font, const char* text, int16_t x, int16_t y, uint16_t box_width,
+                                    uint16_t color, uint16_t bg, TextAlign align) {
+    if (!display || !text || box_width == 0 || box_width > TEXT_BAND_PIXELS) return;
+    
+    // Posizione del testo dentro il box
+    uint16_t width = font_renderer.measure(font, text);
+    int16_t text_x = 0;
+    if (align == TEXT_ALIGN_CENTER) {
+        text_x = ((int16_t)box_width - (int16_t)width) / 2;
+    } else if (align == TEXT_ALIGN_RIGHT) {
+        text_x = (int16_t)box_width - (int16_t)width;
+    }
+    
+    // Righe per banda: il box testo viene composto a bande se non entra nel buffer
+    const int16_t height = font.height;
+    const int16_t band_rows = min((int16_t)(TEXT_BAND_PIXELS / box_width), height);
+    
+    // Box che sporge dal disco visibile: una finestra per riga, tagliata al disco
+    const bool clipped = DISPLAY_CIRCULAR_CLIP && !viewport_rect_inside(x, y, box_width, height);
+    
+    display->startWrite();
+    if (!clipped) {
+        display->setAddrWindow(x, y, box_width, height);
+    }
+    
+    for (int16_t row = 0; row < height; row += band_rows) {
+        int16_t rows = min(band_rows, (int16_t)(height - row));
+        uint32_t pixels = (uint32_t)rows * box_width;
+        
+        for (uint32_t i = 0; i < pixels; i++) {
+            text_band[i] = bg;
+        }
+        font_renderer.render(font, text, color, text_band, box_width, row, rows, text_x);
+        if (clipped) {
+            for (int16_t r = 0; r < rows; r++) {
+                writeClippedRow(x, y + row + r, text_band + r * box_width, box_width);
+            }
+        } else {
+            display->writePixels(text_band, pixels, true, false);
+        }
+    }
+    
+    display->endWrite();
+    if (!clipped) {
+        accountPixels((uint32_t)box_width * height);
+    }
+}
+
+#ifdef DISPLAY_TEXT_BENCHMARK
+void DisplayController::runTextBenchmark(uint16_t iterations) {
+    if (!is_initialized || !display) return;
+    
+    const char* sample = "1234m";
+    
+    // Atlas: misura (cache), composizione e invio SPI
+    unsigned long start = micros();
+    for (uint16_t i = 0; i < iterations; i++) {
+        drawText(font_large, sample, DISPLAY_WIDTH / 2, 100, COLOR_WHITE, COLOR_BLACK, TEXT_ALIGN_CENTER);
+    }
+    unsigned long atlas_us = micros() - start;
+    
+    // Solo composizione nel band buffer (senza SPI)
+    uint16_t width = font_renderer.measure(font_large, sample);
+    start = micros();
+    for (uint16_t i = 0; i < iterations; i++) {
+        font_renderer.render(font_large, sample, COLOR_WHITE, text_band, width, 0,
+                             min((int16_t)font_large.height, (int16_t)(TEXT_BAND_PIXELS / width)));
+    }
+    unsigned long compose_us = micros() - start;
+    
+    // Font GFX 5x7 con setTextSize(2) e getTextBounds per centrare (metodo precedente)
+    start = micros();
+    for (uint16_t i = 0; i < iterations; i++) {
+        int16_t x1, y1;
+        uint16_t w, h;
+        display->setTextColor(COLOR_WHITE, COLOR_BLACK);
+        display->setTextSize(2);
+        display->getTextBounds(sample, 0, 0, &x1, &y1, &w, &h);
+        display->setCursor((DISPLAY_WIDTH - w) / 2, 100);
+        display->print(sample);
+    }
+    unsigned long gfx_us = micros() - start;
+    
+    unsigned long glyphs = (unsigned long)iterations * strlen(sample);
+    Serial.println("[Display] Benchmark testo:");
+    Serial.print("  Atlas (compose + SPI): ");
+    Serial.print(atlas_us / iterations);
+    Serial.print(" us/stringa, ");
+    Serial.print(glyphs * 1000000UL / max(atlas_us, 1UL));
+    Serial.println(" glifi/s");
+    Serial.print("  Atlas (solo compose): ");
+    Serial.print(compose_us / iterations);
+    Serial.print(" us/stringa, ");
+    Serial.print(glyphs * 1000000UL / max(compose_us, 1UL));
+    Serial.println(" glifi/s");
+    Serial.print("  GFX 5x7 x2: ");
+    Serial.print(gfx_us / iterations);
+    Serial.print(" us/stringa, ");
+    Serial.print(glyphs * 1000000UL / max(gfx_us, 1UL));
+    Serial.println(" glifi/s");
+    
+    FontRenderer::Stats font_stats = font_renderer.getStats();
+    Serial.print("  Cache larghezze: ");
+    Serial.print(font_stats.width_cache_hits);
+    Serial.print(" hit, ");
+    Serial.print(font_stats.width_cache_misses);
+    Serial.println(" miss");
+    
+    fillArea(0, 95, DISPLAY_WIDTH, 40, COLOR_BLACK);
 }
+#endif
 
 void DisplayController::drawRoundedRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t radius, uint16_t color) {
     if (!display) return;
     
-    // Simulazione rounded rectangle (Adafruit GFX non ha rounded rect nativo)
-    // Disegna rettangolo normale per ora
-    // TODO: Implementare rounded rectangle manualmente se necessario
-    display->drawRect(x, y, w, h, color);
+    SpanRow row;
+    display->startWrite();
+    for (int16_t i = 0; i < h; i++) {
+        span_rounded_rect_row(w, h, radius, 1, i, row);
+        writeSpanRow(x, y + i, row, color, color, color);
+    }
+    display->endWrite();
 }
 
 void DisplayController::drawRoundedRectFilled(int16_t x, int16_t y, int16_t w, int16_t h, int16_t radius, uint16_t color) {
     if (!display) return;
     
-    // Simulazione rounded rectangle filled
-    // Disegna rettangolo riempito per ora
-    // TODO: Implementare rounded rectangle filled manualmente se necessario
-    display->fillRect(x, y, w, h, color);
+    SpanRow row;
+    display->startWrite();
+    for (int16_t i = 0; i < h; i++) {
+        span_rounded_rect_row(w, h, radius, 0, i, row);
+        writeSpanRow(x, y + i, row, color, color, color);
+    }
+    display->endWrite();
 }
 
-void DisplayController::drawCircleWithBorder(int16_t x, int16_t y, int16_t radius, uint16_t fill_color, uint16_t border_color, int16_t border_width) {
+void DisplayController::drawCircleWithBorder(int16_t x, int16_t y, int16_t radius, uint16_t fill_color, uint16_t border_color,
+                                             int16_t border_width, uint16_t bg_color) {
     if (!display) return;
     
-    // Disegna cerchio riempito
-    display->fillCircle(x, y, radius, fill_color);
+    const int16_t inner_radius = radius - border_width;
+    SpanRow fill_row;
+    SpanRow border_row;
+    
+    // Per ogni riga: prima il riempimento, poi l'anello (i suoi pixel di bordo interni
+    // si miscelano con il riempimento, quelli esterni con lo sfondo)
+    display->startWrite();
+    for (int16_t dy = -radius; dy <= radius; dy++) {
+        if (inner_radius >= 0) {
+            span_ring_row(inner_radius, 0, dy, false, fill_row);
+            writeSpanRow(x, y + dy, fill_row, fill_color, bg_color, fill_color);
+        }
+        if (border_width > 0) {
+            span_ring_row(radius, inner_radius, dy, DISPLAY_ANTIALIAS_EDGES, border_row);
+            writeSpanRow(x, y + dy, border_row, border_color, bg_color, fill_color);
+        }
+    }
+    display->endWrite();
+}
+
+void DisplayController::drawArc(int16_t r_outer, int16_t r_inner, float start_deg, float sweep_deg, uint16_t color) {
+    if (!display || sweep_deg <= 0.0f) return;
+    
+    int16_t dy_min, dy_max;
+    span_arc_rows(r_outer, r_inner, start_deg, sweep_deg, &dy_min, &dy_max);
+    
+    SpanRow row;
+    display->startWrite();
+    for (int16_t dy = dy_min; dy <= dy_max; dy++) {
+        span_arc_row(r_outer, r_inner, dy, start_deg, sweep_deg, false, row);
+        writeSpanRow(ARC_CENTER_X, ARC_CENTER_Y + dy, row, color, color, color);
+    }
+    display->endWrite();
+}
+
+void DisplayController::writeSpanRow(int16_t x_origin, int16_t y, const SpanRow& row, uint16_t color,
+                                     uint16_t bg, uint16_t inner_bg) {
+    for (uint8_t i = 0; i < row.span_count; i++) {
+        int16_t x0 = x_origin + row.spans[i].x0;
+        int16_t x1 = x_origin + row.spans[i].x1;
+        if (!clipSpan(y, x0, x1)) continue;
+        display->writeFastHLine(x0, y, x1 - x0 + 1, color);
+        accountPixels(x1 - x0 + 1);
+    }
+    
+    for (uint8_t i = 0; i < row.edge_count; i++) {
+        const SpanEdge& edge = row.edges[i];
+        int16_t ex0 = x_origin + edge.x;
+        int16_t ex1 = ex0;
+        if (!clipSpan(y, ex0, ex1)) continue;
+        uint16_t under = edge.inner ? inner_bg : bg;
+        display->writePixel(ex0, y, FontRenderer::blend565(color, under, edge.alpha));
+        accountPixels(1);
+    }
+}
+
+void DisplayController::fillArea(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    if (!display || w <= 0 || h <= 0) return;
+    
+    // Rettangolo interamente visibile: una sola finestra
+    if (!DISPLAY_CIRCULAR_CLIP || viewport_rect_inside(x, y, w, h)) {
+        display->fillRect(x, y, w, h, color);
+        accountPixels((uint32_t)w * h);
+        return;
+    }
     
-    // Disegna bordo (cerchi concentrici)
-    for (int16_t i = 0; i < border_width; i++) {
-        display->drawCircle(x, y, radius - i, border_color);
+    // Altrimenti uno span per riga, tagliato al disco: gli 11 byte di finestra
+    // per riga costano molto meno dei pixel negli angoli (~21% dello schermo intero)
+    display->startWrite();
+    for (int16_t row = y; row < y + h; row++) {
+        int16_t x0 = x;
+        int16_t x1 = x + w - 1;
+        if (!clipSpan(row, x0, x1)) continue;
+        display->writeFastHLine(x0, row, x1 - x0 + 1, color);
+        accountPixels(x1 - x0 + 1);
     }
+    display->endWrite();
+}
+
+void DisplayController::writeClippedRow(int16_t x, int16_t y, uint16_t* pixels, int16_t w) {
+    int16_t x0 = x;
+    int16_t x1 = x + w - 1;
+    if (!clipSpan(y, x0, x1)) return;
+    
+    display->setAddrWindow(x0, y, x1 - x0 + 1, 1);
+    display->writePixels(pixels + (x0 - x), x1 - x0 + 1, true, false);
+    accountPixels(x1 - x0 + 1);
+}
+
+bool DisplayController::clipSpan(int16_t y, int16_t& x0, int16_t& x1) {
+    if (x0 > x1) return false;
+    if (!DISPLAY_CIRCULAR_CLIP) return true;
+    
+    int16_t width = x1 - x0 + 1;
+    bool visible = viewport_clip_span(y, x0, x1);
+    stats.clip_skipped_pixels += visible ? width - (x1 - x0 + 1) : width;
+    return visible;
+}
+
+void DisplayController::endFrame() {
+    stats.frames++;
+    stats.last_frame_skipped_pixels = stats.clip_skipped_pixels - frame_skipped_start;
+    frame_skipped_start = stats.clip_skipped_pixels;
+}
+
+void DisplayController::accountPixels(uint32_t pixels, uint32_t windows) {
+    stats.spi_bytes += pixels * 2 + windows * SPI_WINDOW_OVERHEAD_BYTES;
+    stats.spi_windows += windows;
+}
+
+DisplayController::Stats DisplayController::getStats() const {
+    return stats;
+}
+
+void DisplayController::resetStats() {
+    stats.spi_bytes = 0;
+    stats.spi_windows = 0;
+    stats.alert_full_redraws = 0;
+    stats.alert_updates = 0;
+    stats.last_alert_bytes = 0;
+    stats.last_alert_cycles = 0;
+    stats.clip_skipped_pixels = 0;
+    stats.frames = 0;
+    stats.last_frame_skipped_pixels = 0;
+    stats.section_updates = 0;
+    stats.overspeed_changes = 0;
+    stats.alert_transitions = 0;
+    stats.preview_updates = 0;
+    frame_skipped_start = 0;
 }
 
 uint16_t DisplayController::color565(uint8_t r, uint8_t g, uint8_t b) {
@@ -7,9 +7,23 @@
 #include <SPI.h>
 #include <LittleFS.h>
 #include "config.h"
+#include "font_renderer.h"
+#include "span_raster.h"
+#include "viewport.h"
+#include "animation.h"
 
 // Forward declaration
 struct Speedcam;
+struct SectionStatus;
+
+/**
+ * Allineamento orizzontale testo
+ */
+enum TextAlign {
+    TEXT_ALIGN_LEFT,
+    TEXT_ALIGN_CENTER,
+    TEXT_ALIGN_RIGHT
+};
 
 /**
  * Controller display GC9A01 240x240
@@ -27,13 +41,21 @@ public:
     bool begin();
     
     /**
-     * Mostra boot logo
-     * @param display_time_ms Tempo visualizzazione in millisecondi
+     * Mostra boot logo (non bloccante)
+     * Avvia fade-in e permanenza come animazioni avanzate da update():
+     * nel frattempo GPS e caricamento database procedono
+     * @param display_time_ms Tempo visualizzazione in millisecondi dopo il fade
      */
     void showBootLogo(unsigned long display_time_ms = BOOT_LOGO_DISPLAY_TIME);
     
+    /**
+     * Verifica se la sequenza di boot (fade + permanenza logo) è terminata
+     */
+    bool isBootComplete() const;
+    
     /**
      * Mostra schermata idle (GPS status, ecc.)
+     * Se il boot logo è ancora in corso viene mostrata al suo termine
      */
     void showIdleScreen();
     
@@ -50,7 +72,39 @@ public:
     void hideSpeedcamAlert();
     
     /**
-     * Aggiorna display (da chiamare periodicamente)
+     * Mostra o aggiorna il pannello Tutor (media, margine sul limite, velocità
+     * massima sul resto, distanza dalla fine). Ridisegna solo le righe cambiate;
+     * un alert speedcam ha la precedenza e il pannello torna al fix successivo.
+     */
+    void showSectionStatus(const SectionStatus& status);
+    
+    /**
+     * Nasconde il pannello Tutor (uscita dalla tratta) e torna al boot logo
+     */
+    void hideSectionStatus();
+    
+    /**
+     * Anteprima della prossima speedcam davanti sulla schermata idle (tipo,
+     * distanza, limite) in una riga sotto le info GPS; ridisegnata solo se il
+     * testo cambia. Alert o boot logo a schermo: nessun effetto.
+     */
+    void showNextSpeedcam(const struct Speedcam& speedcam, float distance);
+    
+    /**
+     * Cancella la riga dell'anteprima (nessuna speedcam davanti)
+     */
+    void hideNextSpeedcam();
+    
+    /**
+     * Livello dell'avviso di velocità (OverspeedLevel) sul bordo dell'alert:
+     * colore oltre il limite, lampeggio se serve frenare, beep su
+     * OVERSPEED_BEEP_PIN (uno all'ingresso in frenata, continuo in frenata forte).
+     * Senza alert a schermo non ha effetto; hideSpeedcamAlert() lo azzera.
+     */
+    void setOverspeedLevel(uint8_t level);
+    
+    /**
+     * Aggiorna display e avanza le animazioni (da chiamare periodicamente)
      */
     void update();
     
@@ -58,6 +112,41 @@ public:
      * Aggiorna indicatore GPS
      */
     void updateGPSIndicator(bool has_fix, uint8_t satellites);
+    
+    /**
+     * Statistiche rendering
+     * I byte SPI sono stimati per primitiva: 2 byte per pixel più i comandi
+     * di finestra (CASET/RASET/RAMWR) per ogni finestra aperta
+     */
+    struct Stats {
+        unsigned long spi_bytes;              // Byte SPI totali
+        unsigned long spi_windows;            // Finestre indirizzo aperte
+        unsigned long alert_full_redraws;     // Alert disegnati da zero
+        unsigned long alert_updates;          // Aggiornamenti incrementali alert
+        unsigned long last_alert_bytes;       // Byte SPI ultimo show/update alert
+        uint32_t last_alert_cycles;           // Cicli CPU ultimo show/update alert (hal_cycles)
+        unsigned long clip_skipped_pixels;    // Pixel fuori dal disco visibile non inviati
+        unsigned long frames;                 // Schermate/aggiornamenti completati
+        unsigned long last_frame_skipped_pixels;  // Pixel scartati nell'ultimo frame
+        unsigned long section_updates;        // Aggiornamenti del pannello Tutor
+        unsigned long overspeed_changes;      // Cambi di livello dell'avviso di velocità
+        unsigned long alert_transitions;      // Alert passati a un'altra speedcam senza ridisegno completo
+        unsigned long preview_updates;        // Anteprime della prossima speedcam ridisegnate
+    };
+    Stats getStats() const;
+    
+    /**
+     * Reset statistiche
+     */
+    void resetStats();
+    
+    #ifdef DISPLAY_TEXT_BENCHMARK
+    /**
+     * Microbenchmark rendering testo (atlas vs font GFX), risultati su seriale
+     * @param iterations Numero di stringhe renderizzate per ogni prova
+     */
+    void runTextBenchmark(uint16_t iterations = 200);
+    #endif
 
 private:
     Adafruit_GC9A01A* display;
@@ -65,17 +154,127 @@ private:
     
     // Stato corrente
     bool showing_alert;
-    unsigned long alert_start_time;
     unsigned long alert_display_time;
     
+    // Animazioni: sequenza di boot e timeout alert
+    AnimationScheduler animations;
+    int8_t boot_tween;             // Fade o permanenza logo in corso (-1 = nessuno)
+    int8_t alert_timer;            // Timer timeout alert (-1 = nessuno)
+    int8_t pulse_timer;            // Semiperiodo del lampeggio avviso velocità (-1 = nessuno)
+    int8_t transition_tween;       // Distanza animata verso la nuova speedcam (-1 = nessuno)
+    bool boot_in_progress;
+    bool idle_pending;             // showIdleScreen richiesta durante il boot
+    int16_t boot_fade_step;        // Ultimo step di fade disegnato
+    unsigned long boot_hold_ms;    // Permanenza logo dopo il fade
+    
+    // Avviso di velocità sull'alert
+    uint8_t overspeed_level;       // OverspeedLevel a schermo
+    bool pulse_on;                 // Fase accesa del lampeggio (bordo bianco, beep)
+    bool beep_pending;             // Beep singolo dell'ingresso in frenata
+    
     // GPS status
     bool gps_has_fix;
     uint8_t gps_satellites;
     
+    // Renderer testo anti-aliased
+    FontRenderer font_renderer;
+    
+    // Stato widget alert (cosa c'è a schermo, per aggiornamenti incrementali)
+    struct AlertWidget {
+        bool drawn;
+        uint32_t speedcam_id;
+        char digits[ALERT_DISTANCE_DIGITS + 1];  // Cifre a schermo, allineate a destra
+        uint16_t progress_steps;                 // Step arco accesi
+        float distance;                          // Ultima distanza richiesta (partenza della transizione)
+    };
+    AlertWidget alert_widget;
+    
+    // Stato pannello Tutor: testo a schermo di ogni riga
+    struct SectionWidget {
+        bool drawn;
+        uint32_t start_id;
+        char average[4];
+        char margin[12];
+        char allowed[12];
+        char remaining[12];
+    };
+    SectionWidget section_widget;
+    
+    // Anteprima della prossima speedcam: testo a schermo
+    struct PreviewWidget {
+        bool drawn;
+        char text[20];
+    };
+    PreviewWidget preview_widget;
+    
+    // Statistiche
+    Stats stats;
+    unsigned long frame_skipped_start;  // clip_skipped_pixels alla fine dell'ultimo frame
+    
+    /**
+     * Disegna il boot logo con il fattore di fade indicato
+     * @param fade_factor 0.0 = nero, 1.0 = colore pieno
+     */
+    void drawBootLogoFrame(float fade_factor);
+    
+    /**
+     * Interrompe la sequenza di boot (es. alert durante il boot)
+     */
+    void cancelBootSequence();
+    
+    // Callback animazioni (ctx = DisplayController)
+    static void onBootFadeUpdate(void* ctx, float value);
+    static void onBootFadeComplete(void* ctx);
+    static void onBootHoldComplete(void* ctx);
+    static void onAlertTimeout(void* ctx);
+    static void onOverspeedPulse(void* ctx);
+    static void onAlertTransitionUpdate(void* ctx, float value);
+    static void onAlertTransitionComplete(void* ctx);
+    
+    /**
+     * Bordo dell'alert (2 pixel) nel colore del livello o della fase del lampeggio
+     */
+    void drawAlertBorder();
+    
+    /**
+     * Pilota il buzzer (se OVERSPEED_BEEP_PIN è configurato)
+     */
+    void setBeep(bool on);
+    
     /**
      * Disegna contenuto alert speedcam
+     * @param transition Alert già a schermo per un'altra speedcam: niente sfondo
+     *                   a schermo intero, distanza e arco animati dai valori precedenti
+     */
+    void drawSpeedcamAlertContent(const Speedcam& speedcam, float distance, bool transition);
+    
+    /**
+     * Aggiorna alert già a schermo: solo cifre cambiate e delta dell'arco
+     */
+    void updateSpeedcamAlertContent(float distance);
+    
+    /**
+     * Disegna le cifre della distanza diverse da quelle a schermo
+     * @param force Ridisegna tutte le cifre
      */
-    void drawSpeedcamAlertContent(const Speedcam& speedcam, float distance);
+    void drawAlertDistance(float distance, bool force);
+    
+    /**
+     * Aggiorna arco distanza residua (solo gli step cambiati)
+     * @param force Ridisegna traccia e arco completi
+     */
+    void drawAlertProgress(float distance, bool force);
+    
+    /**
+     * Disegna step [from, to) dell'arco attorno al bordo del display
+     */
+    void drawArcSteps(uint16_t from, uint16_t to, uint16_t color);
+    
+    /**
+     * Disegna una riga del pannello Tutor se il testo è cambiato
+     * @param shown Testo a schermo, aggiornato
+     */
+    void drawSectionRow(const char* text, char* shown, size_t size, int16_t y, uint16_t color, bool force);
     
     /**
      * Disegna informazioni GPS (testo, senza re-render completo)
@@ -88,19 +287,88 @@ private:
     void drawGPSIndicator(bool has_fix, uint8_t satellites);
     
     /**
-     * Disegna rounded rectangle (simulazione, Adafruit GFX non ha rounded rect nativo)
+     * Disegna testo anti-aliased da font atlas
+     * Il box testo (larghezza stringa x altezza font) viene composto nel band buffer
+     * su sfondo bg e inviato con un'unica finestra SPI
+     * @param x Ascissa di riferimento (sinistra, centro o destra secondo align)
+     * @param y Ordinata del bordo superiore del box testo
+     * @return Larghezza del testo in pixel
+     */
+    uint16_t drawText(const AtlasFont& font, const char* text, int16_t x, int16_t y,
+                      uint16_t color, uint16_t bg, TextAlign align = TEXT_ALIGN_LEFT);
+    
+    /**
+     * Disegna testo in un box di larghezza fissa (lo sfondo copre tutto il box)
+     * Usato per le celle delle cifre: una cifra cambiata ridisegna solo la sua cella
+     * @param x Bordo sinistro del box
+     * @param align Allineamento del testo dentro il box
+     */
+    void drawTextBox(const AtlasFont& font, const char* text, int16_t x, int16_t y, uint16_t box_width,
+                     uint16_t color, uint16_t bg, TextAlign align = TEXT_ALIGN_LEFT);
+    
+    /**
+     * Riempie un rettangolo (con conteggio byte SPI)
+     */
+    void fillArea(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+    
+    /**
+     * Scrive una riga di pixel già composta, tagliata al disco visibile
+     * (da chiamare tra startWrite/endWrite, apre una finestra per riga)
+     * @param pixels Pixel della riga a partire da x
+     */
+    void writeClippedRow(int16_t x, int16_t y, uint16_t* pixels, int16_t w);
+    
+    /**
+     * Taglia uno span al disco visibile, conteggiando i pixel scartati
+     * @return false se lo span è interamente invisibile
+     */
+    bool clipSpan(int16_t y, int16_t& x0, int16_t& x1);
+    
+    /**
+     * Chiude un frame: i pixel scartati dalla fine del frame precedente
+     * vengono attribuiti a questo
+     */
+    void endFrame();
+    
+    /**
+     * Conteggia byte SPI inviati
+     * @param pixels Pixel scritti
+     * @param windows Finestre indirizzo aperte
+     */
+    void accountPixels(uint32_t pixels, uint32_t windows = 1);
+    
+    /**
+     * Disegna bordo di un rounded rectangle (1 pixel), uno span per lato per riga
      */
     void drawRoundedRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t radius, uint16_t color);
     
     /**
-     * Disegna rounded rectangle filled
+     * Disegna rounded rectangle filled, uno span per riga
      */
     void drawRoundedRectFilled(int16_t x, int16_t y, int16_t w, int16_t h, int16_t radius, uint16_t color);
     
     /**
-     * Disegna cerchio con bordo
+     * Disegna cerchio con bordo: per ogni riga uno span di riempimento e gli span dell'anello
+     * @param bg_color Colore sotto il cerchio (per i pixel di bordo anti-aliased)
+     */
+    void drawCircleWithBorder(int16_t x, int16_t y, int16_t radius, uint16_t fill_color, uint16_t border_color,
+                              int16_t border_width, uint16_t bg_color = COLOR_BLACK);
+    
+    /**
+     * Disegna arco di anello centrato sul display
+     * @param start_deg Angolo iniziale (senso orario da ore 12)
+     * @param sweep_deg Ampiezza in gradi
+     */
+    void drawArc(int16_t r_outer, int16_t r_inner, float start_deg, float sweep_deg, uint16_t color);
+    
+    /**
+     * Scrive gli span di una riga (da chiamare tra startWrite/endWrite)
+     * @param x_origin Ascissa a cui sono relativi gli span
+     * @param bg Colore sotto i pixel di bordo esterni
+     * @param inner_bg Colore sotto i pixel di bordo interni (foro dell'anello)
      */
-    void drawCircleWithBorder(int16_t x, int16_t y, int16_t radius, uint16_t fill_color, uint16_t border_color, int16_t border_width);
+    void writeSpanRow(int16_t x_origin, int16_t y, const SpanRow& row, uint16_t color,
+                      uint16_t bg, uint16_t inner_bg);
     
     /**
      * Ottiene colore da RGB
@@ -0,0 +1,714 @@
+// Font: DejaVuSans-Bold.ttf
+// Atlas alpha 4-bit (2 pixel per byte, nibble alto = pixel a sinistra)
+// Generato automaticamente con convert_assets.py - non modificare manualmente
+#ifndef FONT_ATLAS_H
+#define FONT_ATLAS_H
+
+#include "font_renderer.h"
+
+// font_small: 13px, 95 glifi, 3931 bytes
+const uint8_t font_small_bitmap[] PROGMEM = {
+  0x03, 0xFF, 0x20, 0x03, 0xFF, 0x20, 0x03, 0xFF, 0x20, 0x02, 0xFF, 0x10, 0x01, 0xFF, 0x00, 0x00,
+  0xED, 0x00, 0x00, 0x00, 0x00, 0x03, 0xFF, 0x20, 0x03, 0xFF, 0x20, 0x0C, 0xB0, 0xF8, 0x00, 0x0C,
+  0xB0, 0xF8, 0x00, 0x0C, 0xB0, 0xF8, 0x00, 0x0C, 0xB0, 0xF8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0xC9, 0x0A, 0xB0, 0x00, 0x00, 0x01, 0xF5, 0x1E, 0x60, 0x00, 0x06, 0xFF, 0xFF, 0xFF, 0xFF,
+  0x00, 0x00, 0x0B, 0xB0, 0x9C, 0x00, 0x00, 0x00, 0x0E, 0x70, 0xC9, 0x00, 0x00, 0x2F, 0xFF, 0xFF,
+  0xFF, 0xF4, 0x00, 0x00, 0x7E, 0x05, 0xF1, 0x00, 0x00, 0x00, 0xAB, 0x08, 0xD0, 0x00, 0x00, 0x00,
+  0xD8, 0x0B, 0x90, 0x00, 0x00, 0x00, 0x00, 0xF1, 0x00, 0x00, 0x01, 0x9D, 0xFD, 0x81, 0x00, 0x0B,
+  0xF5, 0xF2, 0x67, 0x00, 0x0E, 0xF4, 0xF1, 0x00, 0x00, 0x0A, 0xFF, 0xFB, 0x71, 0x00, 0x01, 0x7B,
+  0xFF, 0xFC, 0x00, 0x00, 0x00, 0xF3, 0xEF, 0x20, 0x0B, 0x51, 0xF2, 0xEE, 0x00, 0x03, 0xAE, 0xFE,
+  0xB3, 0x00, 0x00, 0x00, 0xF1, 0x00, 0x00, 0x00, 0x00, 0xF1, 0x00, 0x00, 0x09, 0xEE, 0x80, 0x00,
+  0x8C, 0x00, 0x00, 0x6F, 0x46, 0xF4, 0x03, 0xF3, 0x00, 0x00, 0x8F, 0x02, 0xF7, 0x0D, 0x80, 0x00,
+  0x00, 0x5F, 0x46, 0xF4, 0x8D, 0x00, 0x00, 0x00, 0x09, 0xEE, 0x83, 0xF3, 0x7E, 0xE9, 0x00, 0x00,
+  0x00, 0x0C, 0x84, 0xF6, 0x4F, 0x60, 0x00, 0x00, 0x8D, 0x16, 0xF2, 0x0F, 0x90, 0x00, 0x03, 0xF4,
+  0x04, 0xF6, 0x4F, 0x60, 0x00, 0x0C, 0x90, 0x00, 0x7E, 0xE9, 0x00, 0x00, 0x2B, 0xEE, 0xA2, 0x00,
+  0x00, 0x00, 0xBF, 0x91, 0x47, 0x00, 0x00, 0x00, 0x8F, 0xD1, 0x00, 0x00, 0x00, 0x03, 0xEF, 0xFC,
+  0x00, 0xAF, 0x40, 0x0D, 0xF9, 0xDF, 0xA0, 0xDF, 0x20, 0x3F, 0xF1, 0x3F, 0xFB, 0xFD, 0x00, 0x2F,
+  0xF1, 0x06, 0xFF, 0xF6, 0x00, 0x0B, 0xFA, 0x13, 0xEF, 0xF4, 0x00, 0x01, 0x8D, 0xFE, 0xCA, 0xFE,
+  0x40, 0x0C, 0xB0, 0x0C, 0xB0, 0x0C, 0xB0, 0x0C, 0xB0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x4F, 0xA0, 0x00, 0xCF, 0x30, 0x03, 0xFD, 0x00, 0x08, 0xF9, 0x00, 0x0B,
+  0xF6, 0x00, 0x0D, 0xF5, 0x00, 0x0D, 0xF5, 0x00, 0x0B, 0xF6, 0x00, 0x08, 0xF9, 0x00, 0x03, 0xFD,
+  0x00, 0x00, 0xCF, 0x30, 0x00, 0x4F, 0xA0, 0x0B, 0xF3, 0x00, 0x04, 0xFB, 0x00, 0x00, 0xEF, 0x20,
+  0x00, 0xAF, 0x70, 0x00, 0x7F, 0xA0, 0x00, 0x5F, 0xC0, 0x00, 0x5F, 0xC0, 0x00, 0x7F, 0xA0, 0x00,
+  0xAF, 0x70, 0x00, 0xEF, 0x20, 0x04, 0xFB, 0x00, 0x0B, 0xF3, 0x00, 0x00, 0x2E, 0x00, 0x00, 0x79,
+  0x3E, 0x2A, 0x50, 0x18, 0xEF, 0xE7, 0x00, 0x18, 0xEF, 0xD7, 0x00, 0x79, 0x3E, 0x2A, 0x50, 0x00,
+  0x2E, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x5F, 0x30, 0x00, 0x00, 0x00, 0x00, 0x5F, 0x30, 0x00, 0x00, 0x00, 0x00, 0x5F, 0x30, 0x00,
+  0x00, 0x09, 0xFF, 0xFF, 0xFF, 0xF8, 0x00, 0x09, 0xFF, 0xFF, 0xFF, 0xF8, 0x00, 0x00, 0x00, 0x5F,
+  0x30, 0x00, 0x00, 0x00, 0x00, 0x5F, 0x30, 0x00, 0x00, 0x00, 0x00, 0x5F, 0x30, 0x00, 0x00, 0x0A,
+  0xF9, 0x00, 0x0A, 0xF9, 0x00, 0x0D, 0xE2, 0x00, 0x3F, 0x60, 0x00, 0x4F, 0xFF, 0xA0, 0x4F, 0xFF,
+  0xA0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0A, 0xF9, 0x00, 0x0A, 0xF9, 0x00,
+  0x00, 0x0C, 0x90, 0x00, 0x2F, 0x40, 0x00, 0x6E, 0x00, 0x00, 0xBA, 0x00, 0x01, 0xF6, 0x00, 0x05,
+  0xF1, 0x00, 0x0A, 0xC0, 0x00, 0x0E, 0x70, 0x00, 0x4F, 0x20, 0x00, 0x8D, 0x00, 0x00, 0xD8, 0x00,
+  0x00, 0x00, 0x7D, 0xFD, 0x80, 0x00, 0x09, 0xF9, 0x19, 0xF9, 0x00, 0x1F, 0xF3, 0x03, 0xFF, 0x20,
+  0x4F, 0xF1, 0x01, 0xFF, 0x50, 0x5F, 0xF1, 0x00, 0xFF, 0x60, 0x4F, 0xF1, 0x01, 0xFF, 0x50, 0x1F,
+  0xF3, 0x03, 0xFF, 0x20, 0x09, 0xFA, 0x19, 0xF9, 0x00, 0x00, 0x7D, 0xFD, 0x80, 0x00, 0x08, 0xFF,
+  0xFF, 0x00, 0x00, 0x00, 0x05, 0xFF, 0x00, 0x00, 0x00, 0x05, 0xFF, 0x00, 0x00, 0x00, 0x05, 0xFF,
+  0x00, 0x00, 0x00, 0x05, 0xFF, 0x00, 0x00, 0x00, 0x05, 0xFF, 0x00, 0x00, 0x00, 0x05, 0xFF, 0x00,
+  0x00, 0x00, 0x05, 0xFF, 0x00, 0x00, 0x07, 0xFF, 0xFF, 0xFF, 0x20, 0x03, 0xAE, 0xED, 0x70, 0x00,
+  0x0B, 0x41, 0x3E, 0xF7, 0x00, 0x00, 0x00, 0x0A, 0xFC, 0x00, 0x00, 0x00, 0x0D, 0xFB, 0x00, 0x00,
+  0x00, 0x8F, 0xF3, 0x00, 0x00, 0x08, 0xFE, 0x40, 0x00, 0x00, 0x7F, 0xE4, 0x00, 0x00, 0x07, 0xFF,
+  0x40, 0x00, 0x00, 0x0F, 0xFF, 0xFF, 0xFE, 0x00, 0x02, 0x9D, 0xED, 0x80, 0x00, 0x08, 0x41, 0x3E,
+  0xF8, 0x00, 0x00, 0x00, 0x0B, 0xFB, 0x00, 0x00, 0x00, 0x3E, 0xF6, 0x00, 0x00, 0x8F, 0xFF, 0xA1,
+  0x00, 0x00, 0x00, 0x3C, 0xFB, 0x00, 0x00, 0x00, 0x07, 0xFF, 0x00, 0x2A, 0x31, 0x2C, 0xFB, 0x00,
+  0x05, 0xBE, 0xEC, 0x81, 0x00, 0x00, 0x02, 0xEF, 0xF1, 0x00, 0x00, 0x1D, 0xEF, 0xF1, 0x00, 0x00,
+  0xBE, 0x6F, 0xF1, 0x00, 0x0A, 0xF5, 0x3F, 0xF1, 0x00, 0x5F, 0x80, 0x3F, 0xF1, 0x00, 0x6F, 0xFF,
+  0xFF, 0xFF, 0x70, 0x00, 0x00, 0x3F, 0xF1, 0x00, 0x00, 0x00, 0x3F, 0xF1, 0x00, 0x00, 0x00, 0x3F,
+  0xF1, 0x00, 0x09, 0xFF, 0xFF, 0xF7, 0x00, 0x09, 0xF5, 0x00, 0x00, 0x00, 0x09, 0xF5, 0x00, 0x00,
+  0x00, 0x09, 0xFE, 0xFD, 0x81, 0x00, 0x07, 0x51, 0x3D, 0xFA, 0x00, 0x00, 0x00, 0x06, 0xFF, 0x10,
+  0x00, 0x00, 0x06, 0xFF, 0x10, 0x0B, 0x41, 0x2D, 0xFA, 0x00, 0x04, 0xAE, 0xED, 0x71, 0x00, 0x00,
+  0x3B, 0xEE, 0xA2, 0x00, 0x04, 0xFD, 0x41, 0x48, 0x00, 0x0C, 0xF5, 0x00, 0x00, 0x00, 0x1F, 0xFC,
+  0xEE, 0xB2, 0x00, 0x2F, 0xFC, 0x16, 0xFD, 0x10, 0x1F, 0xF7, 0x01, 0xFF, 0x40, 0x0D, 0xF7, 0x01,
+  0xFF, 0x30, 0x06, 0xFC, 0x16, 0xFC, 0x00, 0x00, 0x6D, 0xFD, 0x91, 0x00, 0x2F, 0xFF, 0xFF, 0xFF,
+  0x00, 0x00, 0x00, 0x0C, 0xFD, 0x00, 0x00, 0x00, 0x3F, 0xF7, 0x00, 0x00, 0x00, 0xAF, 0xE1, 0x00,
+  0x00, 0x02, 0xFF, 0x70, 0x00, 0x00, 0x08, 0xFE, 0x10, 0x00, 0x00, 0x1E, 0xF8, 0x00, 0x00, 0x00,
+  0x6F, 0xE1, 0x00, 0x00, 0x00, 0xDF, 0x80, 0x00, 0x00, 0x02, 0xAD, 0xFE, 0xA2, 0x00, 0x0B, 0xF9,
+  0x19, 0xFC, 0x00, 0x0E, 0xF5, 0x05, 0xFF, 0x00, 0x0A, 0xF9, 0x19, 0xFA, 0x00, 0x01, 0xCF, 0xFF,
+  0xC1, 0x00, 0x0D, 0xF7, 0x17, 0xFD, 0x00, 0x2F, 0xF2, 0x02, 0xFF, 0x30, 0x0E, 0xF7, 0x17, 0xFE,
+  0x10, 0x03, 0xAE, 0xFE, 0xA3, 0x00, 0x01, 0x9D, 0xFD, 0x60, 0x00, 0x0C, 0xF7, 0x1C, 0xF6, 0x00,
+  0x3F, 0xF1, 0x07, 0xFE, 0x00, 0x4F, 0xF1, 0x07, 0xFF, 0x20, 0x1D, 0xF7, 0x1C, 0xFF, 0x30, 0x02,
+  0xBE, 0xEC, 0xFF, 0x20, 0x00, 0x00, 0x05, 0xFC, 0x00, 0x08, 0x41, 0x3D, 0xF4, 0x00, 0x02, 0xBE,
+  0xEB, 0x30, 0x00, 0x08, 0xFB, 0x00, 0x08, 0xFB, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x08, 0xFB, 0x00, 0x08, 0xFB, 0x00, 0x08, 0xFB, 0x00, 0x08, 0xFB, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0xFB, 0x00, 0x08, 0xFB, 0x00, 0x0B, 0xF4, 0x00,
+  0x1F, 0x80, 0x00, 0x00, 0x00, 0x00, 0x05, 0xA7, 0x00, 0x00, 0x00, 0x49, 0xEF, 0xD5, 0x00, 0x03,
+  0x9E, 0xFC, 0x72, 0x00, 0x00, 0x09, 0xFD, 0x40, 0x00, 0x00, 0x00, 0x03, 0x9E, 0xFC, 0x72, 0x00,
+  0x00, 0x00, 0x00, 0x49, 0xEF, 0xC5, 0x00, 0x00, 0x00, 0x00, 0x05, 0xA7, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x09, 0xFF, 0xFF, 0xFF, 0xF8, 0x00, 0x09, 0xFF, 0xFF, 0xFF, 0xF8, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x09, 0xFF, 0xFF, 0xFF, 0xF8,
+  0x00, 0x09, 0xFF, 0xFF, 0xFF, 0xF8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0x94, 0x00,
+  0x00, 0x00, 0x00, 0x06, 0xDF, 0xE9, 0x40, 0x00, 0x00, 0x00, 0x03, 0x8D, 0xFD, 0x82, 0x00, 0x00,
+  0x00, 0x00, 0x5E, 0xF8, 0x00, 0x00, 0x03, 0x8D, 0xFD, 0x82, 0x00, 0x06, 0xDF, 0xE9, 0x40, 0x00,
+  0x00, 0x08, 0x94, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x05, 0xCE, 0xD9,
+  0x10, 0x2A, 0x31, 0xCF, 0x80, 0x00, 0x00, 0xBF, 0x90, 0x00, 0x07, 0xFF, 0x40, 0x00, 0x6F, 0xF4,
+  0x00, 0x00, 0xBF, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xCF, 0x80, 0x00, 0x00, 0xCF, 0x80,
+  0x00, 0x00, 0x02, 0x9D, 0xFE, 0xA4, 0x00, 0x00, 0x00, 0x5E, 0x83, 0x11, 0x6D, 0x90, 0x00, 0x03,
+  0xE4, 0x00, 0x00, 0x01, 0xD6, 0x00, 0x0B, 0x80, 0x4D, 0xEA, 0xF3, 0x5D, 0x00, 0x1F, 0x30, 0xE9,
+  0x19, 0xF3, 0x2F, 0x10, 0x2F, 0x12, 0xF5, 0x04, 0xF3, 0x4E, 0x00, 0x1F, 0x30, 0xE9, 0x19, 0xF5,
+  0xC9, 0x00, 0x0B, 0x80, 0x4D, 0xEA, 0xFD, 0x70, 0x00, 0x04, 0xE3, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x6E, 0x72, 0x02, 0x7C, 0x10, 0x00, 0x00, 0x03, 0x9D, 0xFE, 0xB4, 0x00, 0x00, 0x00, 0x09,
+  0xFF, 0xA0, 0x00, 0x00, 0x1E, 0xFF, 0xF1, 0x00, 0x00, 0x6F, 0xED, 0xF7, 0x00, 0x00, 0xCF, 0x98,
+  0xFD, 0x00, 0x03, 0xFF, 0x43, 0xFF, 0x40, 0x09, 0xFD, 0x00, 0xDF, 0x90, 0x0E, 0xFF, 0xFF, 0xFF,
+  0xE1, 0x5F, 0xE0, 0x00, 0x0E, 0xF6, 0xBF, 0xA0, 0x00, 0x09, 0xFC, 0x0C, 0xFF, 0xFF, 0xD7, 0x00,
+  0x0C, 0xFA, 0x03, 0xFF, 0x50, 0x0C, 0xFA, 0x00, 0xDF, 0x90, 0x0C, 0xFA, 0x03, 0xFF, 0x50, 0x0C,
+  0xFF, 0xFF, 0xFC, 0x10, 0x0C, 0xFA, 0x01, 0xCF, 0xB0, 0x0C, 0xFA, 0x00, 0x7F, 0xE0, 0x0C, 0xFA,
+  0x01, 0xCF, 0xB0, 0x0C, 0xFF, 0xFF, 0xD9, 0x20, 0x00, 0x29, 0xDF, 0xED, 0x70, 0x04, 0xEF, 0x71,
+  0x15, 0x80, 0x0D, 0xFA, 0x00, 0x00, 0x00, 0x4F, 0xF4, 0x00, 0x00, 0x00, 0x5F, 0xF3, 0x00, 0x00,
+  0x00, 0x4F, 0xF4, 0x00, 0x00, 0x00, 0x0D, 0xF9, 0x00, 0x00, 0x00, 0x04, 0xFF, 0x71, 0x15, 0x80,
+  0x00, 0x29, 0xDF, 0xED, 0x70, 0x0C, 0xFF, 0xFE, 0xC7, 0x10, 0x00, 0x0C, 0xFA, 0x03, 0xAF, 0xD2,
+  0x00, 0x0C, 0xFA, 0x00, 0x0D, 0xFA, 0x00, 0x0C, 0xFA, 0x00, 0x08, 0xFF, 0x00, 0x0C, 0xFA, 0x00,
+  0x07, 0xFF, 0x10, 0x0C, 0xFA, 0x00, 0x08, 0xFF, 0x00, 0x0C, 0xFA, 0x00, 0x0D, 0xFA, 0x00, 0x0C,
+  0xFA, 0x03, 0xAF, 0xD2, 0x00, 0x0C, 0xFF, 0xFE, 0xC8, 0x10, 0x00, 0x0C, 0xFF, 0xFF, 0xFC, 0x00,
+  0x0C, 0xFA, 0x00, 0x00, 0x00, 0x0C, 0xFA, 0x00, 0x00, 0x00, 0x0C, 0xFA, 0x00, 0x00, 0x00, 0x0C,
+  0xFF, 0xFF, 0xF8, 0x00, 0x0C, 0xFA, 0x00, 0x00, 0x00, 0x0C, 0xFA, 0x00, 0x00, 0x00, 0x0C, 0xFA,
+  0x00, 0x00, 0x00, 0x0C, 0xFF, 0xFF, 0xFE, 0x00, 0x0C, 0xFF, 0xFF, 0xFC, 0x00, 0x0C, 0xFA, 0x00,
+  0x00, 0x00, 0x0C, 0xFA, 0x00, 0x00, 0x00, 0x0C, 0xFA, 0x00, 0x00, 0x00, 0x0C, 0xFF, 0xFF, 0xF8,
+  0x00, 0x0C, 0xFA, 0x00, 0x00, 0x00, 0x0C, 0xFA, 0x00, 0x00, 0x00, 0x0C, 0xFA, 0x00, 0x00, 0x00,
+  0x0C, 0xFA, 0x00, 0x00, 0x00, 0x00, 0x29, 0xDF, 0xEE, 0xB3, 0x00, 0x04, 0xEF, 0x82, 0x13, 0x95,
+  0x00, 0x0D, 0xFA, 0x00, 0x00, 0x00, 0x00, 0x4F, 0xF5, 0x00, 0x00, 0x00, 0x00, 0x5F, 0xF3, 0x01,
+  0xFF, 0xFB, 0x00, 0x4F, 0xF4, 0x00, 0x09, 0xFB, 0x00, 0x0D, 0xF9, 0x00, 0x09, 0xFB, 0x00, 0x04,
+  0xFF, 0x72, 0x1A, 0xFB, 0x00, 0x00, 0x29, 0xDF, 0xED, 0xB6, 0x00, 0x0C, 0xFA, 0x00, 0x0B, 0xFA,
+  0x00, 0x0C, 0xFA, 0x00, 0x0B, 0xFA, 0x00, 0x0C, 0xFA, 0x00, 0x0B, 0xFA, 0x00, 0x0C, 0xFA, 0x00,
+  0x0B, 0xFA, 0x00, 0x0C, 0xFF, 0xFF, 0xFF, 0xFA, 0x00, 0x0C, 0xFA, 0x00, 0x0B, 0xFA, 0x00, 0x0C,
+  0xFA, 0x00, 0x0B, 0xFA, 0x00, 0x0C, 0xFA, 0x00, 0x0B, 0xFA, 0x00, 0x0C, 0xFA, 0x00, 0x0B, 0xFA,
+  0x00, 0x0C, 0xFA, 0x00, 0x0C, 0xFA, 0x00, 0x0C, 0xFA, 0x00, 0x0C, 0xFA, 0x00, 0x0C, 0xFA, 0x00,
+  0x0C, 0xFA, 0x00, 0x0C, 0xFA, 0x00, 0x0C, 0xFA, 0x00, 0x0C, 0xFA, 0x00, 0x00, 0xCF, 0xA0, 0x00,
+  0xCF, 0xA0, 0x00, 0xCF, 0xA0, 0x00, 0xCF, 0xA0, 0x00, 0xCF, 0xA0, 0x00, 0xCF, 0xA0, 0x00, 0xCF,
+  0xA0, 0x00, 0xCF, 0xA0, 0x00, 0xCF, 0xA0, 0x00, 0xDF, 0x90, 0x04, 0xFF, 0x40, 0xBE, 0xC5, 0x00,
+  0x0C, 0xFA, 0x00, 0x6F, 0xF7, 0x00, 0x0C, 0xFA, 0x07, 0xFF, 0x60, 0x00, 0x0C, 0xFA, 0x8F, 0xF5,
+  0x00, 0x00, 0x0C, 0xFE, 0xFE, 0x40, 0x00, 0x00, 0x0C, 0xFF, 0xFB, 0x00, 0x00, 0x00, 0x0C, 0xFD,
+  0xFF, 0xB1, 0x00, 0x00, 0x0C, 0xFA, 0x4E, 0xFB, 0x10, 0x00, 0x0C, 0xFA, 0x04, 0xEF, 0xC1, 0x00,
+  0x0C, 0xFA, 0x00, 0x3E, 0xFC, 0x20, 0x0C, 0xFA, 0x00, 0x00, 0x0C, 0xFA, 0x00, 0x00, 0x0C, 0xFA,
+  0x00, 0x00, 0x0C, 0xFA, 0x00, 0x00, 0x0C, 0xFA, 0x00, 0x00, 0x0C, 0xFA, 0x00, 0x00, 0x0C, 0xFA,
+  0x00, 0x00, 0x0C, 0xFA, 0x00, 0x00, 0x0C, 0xFF, 0xFF, 0xFE, 0x0C, 0xFF, 0x80, 0x00, 0x9F, 0xFB,
+  0x00, 0x0C, 0xFF, 0xE1, 0x01, 0xFF, 0xFB, 0x00, 0x0C, 0xFD, 0xF7, 0x08, 0xFD, 0xFB, 0x00, 0x0C,
+  0xF8, 0xEE, 0x1E, 0xD9, 0xFB, 0x00, 0x0C, 0xF8, 0x7F, 0xCF, 0x69, 0xFB, 0x00, 0x0C, 0xF8, 0x1E,
+  0xFE, 0x09, 0xFB, 0x00, 0x0C, 0xF8, 0x08, 0xF7, 0x09, 0xFB, 0x00, 0x0C, 0xF8, 0x00, 0x00, 0x09,
+  0xFB, 0x00, 0x0C, 0xF8, 0x00, 0x00, 0x09, 0xFB, 0x00, 0x0C, 0xFF, 0x30, 0x09, 0xFA, 0x00, 0x0C,
+  0xFF, 0xB0, 0x09, 0xFA, 0x00, 0x0C, 0xFF, 0xF5, 0x09, 0xFA, 0x00, 0x0C, 0xFA, 0xFD, 0x09, 0xFA,
+  0x00, 0x0C, 0xF8, 0x8F, 0x79, 0xFA, 0x00, 0x0C, 0xF8, 0x1E, 0xEA, 0xFA, 0x00, 0x0C, 0xF8, 0x07,
+  0xFF, 0xFA, 0x00, 0x0C, 0xF8, 0x00, 0xDF, 0xFA, 0x00, 0x0C, 0xF8, 0x00, 0x5F, 0xFA, 0x00, 0x00,
+  0x3A, 0xEF, 0xEA, 0x30, 0x00, 0x05, 0xFE, 0x51, 0x5E, 0xF5, 0x00, 0x1E, 0xF8, 0x00, 0x08, 0xFE,
+  0x10, 0x4F, 0xF4, 0x00, 0x03, 0xFF, 0x40, 0x5F, 0xF3, 0x00, 0x02, 0xFF, 0x60, 0x4F, 0xF4, 0x00,
+  0x03, 0xFF, 0x40, 0x1E, 0xF8, 0x00, 0x08, 0xFE, 0x10, 0x05, 0xFE, 0x51, 0x5E, 0xF5, 0x00, 0x00,
+  0x3A, 0xEF, 0xEA, 0x40, 0x00, 0x0C, 0xFF, 0xFE, 0xD7, 0x00, 0x0C, 0xFA, 0x02, 0xEF, 0x80, 0x0C,
+  0xFA, 0x00, 0x9F, 0xE0, 0x0C, 0xFA, 0x00, 0x9F, 0xE0, 0x0C, 0xFA, 0x02, 0xEF, 0x80, 0x0C, 0xFF,
+  0xFF, 0xD7, 0x00, 0x0C, 0xFA, 0x00, 0x00, 0x00, 0x0C, 0xFA, 0x00, 0x00, 0x00, 0x0C, 0xFA, 0x00,
+  0x00, 0x00, 0x00, 0x3A, 0xEF, 0xEA, 0x30, 0x00, 0x05, 0xFE, 0x51, 0x5E, 0xF5, 0x00, 0x0E, 0xF8,
+  0x00, 0x08, 0xFE, 0x10, 0x4F, 0xF4, 0x00, 0x03, 0xFF, 0x40, 0x5F, 0xF3, 0x00, 0x02, 0xFF, 0x50,
+  0x4F, 0xF4, 0x00, 0x03, 0xFF, 0x40, 0x1E, 0xF8, 0x00, 0x08, 0xFE, 0x10, 0x05, 0xFE, 0x51, 0x5E,
+  0xF6, 0x00, 0x00, 0x3A, 0xEF, 0xFE, 0x50, 0x00, 0x00, 0x00, 0x00, 0xCF, 0x60, 0x00, 0x00, 0x00,
+  0x00, 0x2E, 0xF4, 0x00, 0x0C, 0xFF, 0xFE, 0xC5, 0x00, 0x0C, 0xFA, 0x05, 0xFF, 0x30, 0x0C, 0xFA,
+  0x00, 0xEF, 0x70, 0x0C, 0xFA, 0x00, 0xEF, 0x70, 0x0C, 0xFA, 0x05, 0xFE, 0x20, 0x0C, 0xFF, 0xFF,
+  0xE4, 0x00, 0x0C, 0xFA, 0x17, 0xFF, 0x40, 0x0C, 0xFA, 0x00, 0xBF, 0xD0, 0x0C, 0xFA, 0x00, 0x2F,
+  0xF7, 0x01, 0x9D, 0xFE, 0xD9, 0x00, 0x0B, 0xF7, 0x12, 0x6A, 0x00, 0x0F, 0xF4, 0x00, 0x00, 0x00,
+  0x0E, 0xFE, 0xA6, 0x20, 0x00, 0x06, 0xFF, 0xFF, 0xFA, 0x00, 0x00, 0x27, 0xBE, 0xFF, 0x40, 0x00,
+  0x00, 0x02, 0xFF, 0x50, 0x0C, 0x62, 0x04, 0xFE, 0x20, 0x0A, 0xDE, 0xFE, 0xB3, 0x00, 0xEF, 0xFF,
+  0xFF, 0xFF, 0xC0, 0x00, 0x0C, 0xFA, 0x00, 0x00, 0x00, 0x0C, 0xFA, 0x00, 0x00, 0x00, 0x0C, 0xFA,
+  0x00, 0x00, 0x00, 0x0C, 0xFA, 0x00, 0x00, 0x00, 0x0C, 0xFA, 0x00, 0x00, 0x00, 0x0C, 0xFA, 0x00,
+  0x00, 0x00, 0x0C, 0xFA, 0x00, 0x00, 0x00, 0x0C, 0xFA, 0x00, 0x00, 0x0C, 0xFA, 0x00, 0x1F, 0xF5,
+  0x00, 0x0C, 0xFA, 0x00, 0x1F, 0xF5, 0x00, 0x0C, 0xFA, 0x00, 0x1F, 0xF5, 0x00, 0x0C, 0xFA, 0x00,
+  0x1F, 0xF5, 0x00, 0x0C, 0xFA, 0x00, 0x1F, 0xF5, 0x00, 0x0C, 0xFA, 0x00, 0x1F, 0xF5, 0x00, 0x0A,
+  0xFB, 0x00, 0x2F, 0xF4, 0x00, 0x05, 0xFE, 0x31, 0x9F, 0xD1, 0x00, 0x00, 0x6C, 0xEF, 0xEA, 0x20,
+  0x00, 0xBF, 0xB0, 0x00, 0x0A, 0xFC, 0x5F, 0xF1, 0x00, 0x1E, 0xF6, 0x0E, 0xF7, 0x00, 0x6F, 0xE1,
+  0x09, 0xFD, 0x00, 0xCF, 0x90, 0x03, 0xFF, 0x32, 0xFF, 0x40, 0x00, 0xCF, 0x98, 0xFD, 0x00, 0x00,
+  0x6F, 0xEE, 0xF7, 0x00, 0x00, 0x1E, 0xFF, 0xF1, 0x00, 0x00, 0x09, 0xFF, 0xA0, 0x00, 0x7F, 0xD0,
+  0x02, 0xFF, 0x70, 0x08, 0xFC, 0x4F, 0xF2, 0x06, 0xFF, 0xB0, 0x0C, 0xF8, 0x0E, 0xF5, 0x09, 0xFC,
+  0xE0, 0x1F, 0xF5, 0x0B, 0xF9, 0x0D, 0xC8, 0xF3, 0x4F, 0xF1, 0x07, 0xFD, 0x2F, 0x94, 0xF7, 0x8F,
+  0xC0, 0x04, 0xFF, 0x7F, 0x50, 0xFB, 0xCF, 0x90, 0x00, 0xEF, 0xEF, 0x10, 0xBE, 0xFF, 0x50, 0x00,
+  0xBF, 0xFC, 0x00, 0x8F, 0xFF, 0x10, 0x00, 0x7F, 0xF9, 0x00, 0x4F, 0xFC, 0x00, 0x4F, 0xF4, 0x00,
+  0x4F, 0xF4, 0x08, 0xFE, 0x11, 0xEF, 0x80, 0x00, 0xCF, 0xBB, 0xFC, 0x00, 0x00, 0x2E, 0xFF, 0xE2,
+  0x00, 0x00, 0x0A, 0xFF, 0xA0, 0x00, 0x00, 0x4F, 0xFF, 0xF4, 0x00, 0x01, 0xDF, 0x99, 0xFD, 0x10,
+  0x0A, 0xFD, 0x11, 0xCF, 0xA0, 0x6F, 0xF3, 0x00, 0x3F, 0xF6, 0x0C, 0xFD, 0x10, 0x07, 0xFF, 0x30,
+  0x02, 0xEF, 0x80, 0x3F, 0xF8, 0x00, 0x00, 0x6F, 0xF4, 0xCF, 0xC0, 0x00, 0x00, 0x0A, 0xFF, 0xFE,
+  0x20, 0x00, 0x00, 0x01, 0xEF, 0xF6, 0x00, 0x00, 0x00, 0x00, 0x8F, 0xE0, 0x00, 0x00, 0x00, 0x00,
+  0x8F, 0xE0, 0x00, 0x00, 0x00, 0x00, 0x8F, 0xE0, 0x00, 0x00, 0x00, 0x00, 0x8F, 0xE0, 0x00, 0x00,
+  0x4F, 0xFF, 0xFF, 0xFF, 0xB0, 0x00, 0x00, 0x0B, 0xFF, 0x90, 0x00, 0x00, 0x8F, 0xFD, 0x10, 0x00,
+  0x05, 0xFF, 0xF3, 0x00, 0x00, 0x2E, 0xFF, 0x60, 0x00, 0x01, 0xDF, 0xF9, 0x00, 0x00, 0x0A, 0xFF,
+  0xC0, 0x00, 0x00, 0x5F, 0xFE, 0x10, 0x00, 0x00, 0x6F, 0xFF, 0xFF, 0xFF, 0xD0, 0x0D, 0xFF, 0xF1,
+  0x0D, 0xF4, 0x00, 0x0D, 0xF4, 0x00, 0x0D, 0xF4, 0x00, 0x0D, 0xF4, 0x00, 0x0D, 0xF4, 0x00, 0x0D,
+  0xF4, 0x00, 0x0D, 0xF4, 0x00, 0x0D, 0xF4, 0x00, 0x0D, 0xF4, 0x00, 0x0D, 0xF4, 0x00, 0x0D, 0xFF,
+  0xF1, 0xD8, 0x00, 0x00, 0x8D, 0x00, 0x00, 0x4F, 0x20, 0x00, 0x0E, 0x70, 0x00, 0x0A, 0xC0, 0x00,
+  0x05, 0xF1, 0x00, 0x01, 0xF6, 0x00, 0x00, 0xBA, 0x00, 0x00, 0x6E, 0x00, 0x00, 0x2F, 0x40, 0x00,
+  0x0C, 0x90, 0x2F, 0xFF, 0xC0, 0x00, 0x5F, 0xC0, 0x00, 0x5F, 0xC0, 0x00, 0x5F, 0xC0, 0x00, 0x5F,
+  0xC0, 0x00, 0x5F, 0xC0, 0x00, 0x5F, 0xC0, 0x00, 0x5F, 0xC0, 0x00, 0x5F, 0xC0, 0x00, 0x5F, 0xC0,
+  0x00, 0x5F, 0xC0, 0x2F, 0xFF, 0xC0, 0x00, 0x00, 0xBF, 0xA0, 0x00, 0x00, 0x00, 0x09, 0xFF, 0xF7,
+  0x00, 0x00, 0x00, 0x6F, 0xA1, 0xBF, 0x50, 0x00, 0x04, 0xF7, 0x00, 0x08, 0xE3, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0x80, 0x1B, 0xC1, 0x00, 0x00, 0x00, 0x9B, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x0C, 0xFF, 0xFD, 0x70, 0x00, 0x00, 0x00, 0x2D, 0xF5, 0x00, 0x00, 0x00, 0x08, 0xF9, 0x00, 0x07,
+  0xDE, 0xFF, 0xFB, 0x00, 0x5F, 0xE3, 0x09, 0xFB, 0x00, 0x5F, 0xE2, 0x3E, 0xFB, 0x00, 0x08, 0xEE,
+  0xAA, 0xFB, 0x00, 0x0E, 0xF5, 0x00, 0x00, 0x00, 0x0E, 0xF5, 0x00, 0x00, 0x00, 0x0E, 0xF5, 0x00,
+  0x00, 0x00, 0x0E, 0xF8, 0xBE, 0xD5, 0x00, 0x0E, 0xFD, 0x24, 0xFF, 0x30, 0x0E, 0xF7, 0x00, 0xBF,
+  0x80, 0x0E, 0xF6, 0x00, 0xAF, 0xA0, 0x0E, 0xF7, 0x00, 0xBF, 0x80, 0x0E, 0xFD, 0x24, 0xFF, 0x30,
+  0x0E, 0xF8, 0xBE, 0xD5, 0x00, 0x01, 0x8D, 0xEC, 0x40, 0x0C, 0xFA, 0x12, 0x80, 0x4F, 0xF1, 0x00,
+  0x00, 0x6F, 0xE0, 0x00, 0x00, 0x4F, 0xF1, 0x00, 0x00, 0x0C, 0xFA, 0x12, 0x80, 0x01, 0x8D, 0xEC,
+  0x40, 0x00, 0x00, 0x01, 0xFF, 0x30, 0x00, 0x00, 0x01, 0xFF, 0x30, 0x00, 0x00, 0x01, 0xFF, 0x30,
+  0x02, 0xBE, 0xC6, 0xFF, 0x30, 0x0D, 0xF8, 0x1A, 0xFF, 0x30, 0x4F, 0xF1, 0x03, 0xFF, 0x30, 0x6F,
+  0xE0, 0x02, 0xFF, 0x30, 0x4F, 0xF1, 0x03, 0xFF, 0x30, 0x0D, 0xF8, 0x1A, 0xFF, 0x30, 0x02, 0xBE,
+  0xD7, 0xFF, 0x30, 0x01, 0x8D, 0xED, 0x70, 0x00, 0x0C, 0xF8, 0x19, 0xF9, 0x00, 0x4F, 0xF1, 0x03,
+  0xFF, 0x10, 0x6F, 0xFF, 0xFF, 0xFF, 0x30, 0x5F, 0xE0, 0x00, 0x00, 0x00, 0x0C, 0xF8, 0x12, 0x5A,
+  0x00, 0x01, 0x8D, 0xED, 0x93, 0x00, 0x01, 0xAE, 0xFC, 0x07, 0xFC, 0x00, 0x09, 0xFA, 0x00, 0xBF,
+  0xFF, 0xF9, 0x09, 0xFA, 0x00, 0x09, 0xFA, 0x00, 0x09, 0xFA, 0x00, 0x09, 0xFA, 0x00, 0x09, 0xFA,
+  0x00, 0x09, 0xFA, 0x00, 0x02, 0xBE, 0xC6, 0xFF, 0x30, 0x0D, 0xF8, 0x1A, 0xFF, 0x30, 0x4F, 0xF1,
+  0x03, 0xFF, 0x30, 0x6F, 0xE0, 0x02, 0xFF, 0x30, 0x4F, 0xF1, 0x03, 0xFF, 0x30, 0x0D, 0xF7, 0x1A,
+  0xFF, 0x30, 0x02, 0xBE, 0xD7, 0xFF, 0x30, 0x00, 0x00, 0x04, 0xFF, 0x10, 0x07, 0x51, 0x2B, 0xF9,
+  0x00, 0x01, 0x9E, 0xEC, 0x60, 0x00, 0x0E, 0xF5, 0x00, 0x00, 0x00, 0x0E, 0xF5, 0x00, 0x00, 0x00,
+  0x0E, 0xF5, 0x00, 0x00, 0x00, 0x0E, 0xF8, 0xBE, 0xD6, 0x00, 0x0E, 0xFD, 0x25, 0xFF, 0x10, 0x0E,
+  0xF7, 0x01, 0xFF, 0x30, 0x0E, 0xF5, 0x01, 0xFF, 0x40, 0x0E, 0xF5, 0x01, 0xFF, 0x40, 0x0E, 0xF5,
+  0x01, 0xFF, 0x40, 0x0E, 0xF5, 0x01, 0xFF, 0x40, 0x0E, 0xF5, 0x0E, 0xF5, 0x00, 0x00, 0x0E, 0xF5,
+  0x0E, 0xF5, 0x0E, 0xF5, 0x0E, 0xF5, 0x0E, 0xF5, 0x0E, 0xF5, 0x0E, 0xF5, 0x00, 0xEF, 0x50, 0x00,
+  0xEF, 0x50, 0x00, 0x00, 0x00, 0x00, 0xEF, 0x50, 0x00, 0xEF, 0x50, 0x00, 0xEF, 0x50, 0x00, 0xEF,
+  0x50, 0x00, 0xEF, 0x50, 0x00, 0xEF, 0x50, 0x00, 0xEF, 0x50, 0x00, 0xEF, 0x50, 0x02, 0xFF, 0x20,
+  0x7F, 0xD6, 0x00, 0x0E, 0xF5, 0x00, 0x00, 0x00, 0x0E, 0xF5, 0x00, 0x00, 0x00, 0x0E, 0xF5, 0x00,
+  0x00, 0x00, 0x0E, 0xF5, 0x08, 0xFE, 0x30, 0x0E, 0xF5, 0x8F, 0xD2, 0x00, 0x0E, 0xFD, 0xFC, 0x10,
+  0x00, 0x0E, 0xFF, 0xF7, 0x00, 0x00, 0x0E, 0xF9, 0xFF, 0x60, 0x00, 0x0E, 0xF5, 0x5F, 0xF6, 0x00,
+  0x0E, 0xF5, 0x05, 0xFF, 0x60, 0x0E, 0xF5, 0x0E, 0xF5, 0x0E, 0xF5, 0x0E, 0xF5, 0x0E, 0xF5, 0x0E,
+  0xF5, 0x0E, 0xF5, 0x0E, 0xF5, 0x0E, 0xF5, 0x0E, 0xF5, 0x0E, 0xF8, 0xBE, 0xC4, 0x9E, 0xE9, 0x00,
+  0x0E, 0xFC, 0x19, 0xFF, 0x71, 0xEF, 0x50, 0x0E, 0xF7, 0x06, 0xFF, 0x00, 0xCF, 0x80, 0x0E, 0xF5,
+  0x05, 0xFE, 0x00, 0xCF, 0x80, 0x0E, 0xF5, 0x05, 0xFE, 0x00, 0xCF, 0x80, 0x0E, 0xF5, 0x05, 0xFE,
+  0x00, 0xCF, 0x80, 0x0E, 0xF5, 0x05, 0xFE, 0x00, 0xCF, 0x80, 0x0E, 0xF8, 0xBE, 0xD6, 0x00, 0x0E,
+  0xFD, 0x25, 0xFF, 0x10, 0x0E, 0xF7, 0x01, 0xFF, 0x30, 0x0E, 0xF5, 0x01, 0xFF, 0x40, 0x0E, 0xF5,
+  0x01, 0xFF, 0x40, 0x0E, 0xF5, 0x01, 0xFF, 0x40, 0x0E, 0xF5, 0x01, 0xFF, 0x40, 0x01, 0x9D, 0xED,
+  0x81, 0x00, 0x0C, 0xF8, 0x19, 0xFC, 0x00, 0x5F, 0xF1, 0x02, 0xFF, 0x40, 0x6F, 0xE0, 0x00, 0xFF,
+  0x50, 0x5F, 0xF1, 0x02, 0xFF, 0x40, 0x0D, 0xF8, 0x19, 0xFC, 0x00, 0x01, 0x9D, 0xFD, 0x81, 0x00,
+  0x0E, 0xF8, 0xBE, 0xD5, 0x00, 0x0E, 0xFD, 0x24, 0xFF, 0x30, 0x0E, 0xF7, 0x00, 0xBF, 0x80, 0x0E,
+  0xF6, 0x00, 0xAF, 0xA0, 0x0E, 0xF7, 0x00, 0xBF, 0x80, 0x0E, 0xFD, 0x24, 0xFF, 0x30, 0x0E, 0xF8,
+  0xBE, 0xD5, 0x00, 0x0E, 0xF5, 0x00, 0x00, 0x00, 0x0E, 0xF5, 0x00, 0x00, 0x00, 0x0E, 0xF5, 0x00,
+  0x00, 0x00, 0x02, 0xBE, 0xC6, 0xFF, 0x30, 0x0D, 0xF8, 0x1A, 0xFF, 0x30, 0x4F, 0xF1, 0x03, 0xFF,
+  0x30, 0x6F, 0xE0, 0x02, 0xFF, 0x30, 0x4F, 0xF1, 0x03, 0xFF, 0x30, 0x0D, 0xF8, 0x1A, 0xFF, 0x30,
+  0x02, 0xBE, 0xD7, 0xFF, 0x30, 0x00, 0x00, 0x01, 0xFF, 0x30, 0x00, 0x00, 0x01, 0xFF, 0x30, 0x00,
+  0x00, 0x01, 0xFF, 0x30, 0x0E, 0xF8, 0xBE, 0x60, 0x0E, 0xFD, 0x30, 0x00, 0x0E, 0xF7, 0x00, 0x00,
+  0x0E, 0xF5, 0x00, 0x00, 0x0E, 0xF5, 0x00, 0x00, 0x0E, 0xF5, 0x00, 0x00, 0x0E, 0xF5, 0x00, 0x00,
+  0x07, 0xDE, 0xD9, 0x20, 0x3F, 0xC1, 0x26, 0x80, 0x4F, 0xE6, 0x41, 0x00, 0x0A, 0xFF, 0xFF, 0x80,
+  0x00, 0x14, 0x8F, 0xF1, 0x39, 0x31, 0x4F, 0xE0, 0x05, 0xBE, 0xEB, 0x40, 0x0B, 0xF9, 0x00, 0x0B,
+  0xF9, 0x00, 0xCF, 0xFF, 0xFE, 0x0B, 0xF9, 0x00, 0x0B, 0xF9, 0x00, 0x0B, 0xF9, 0x00, 0x0B, 0xF9,
+  0x00, 0x09, 0xFB, 0x00, 0x03, 0xCF, 0xFB, 0x0F, 0xF4, 0x02, 0xFF, 0x20, 0x0F, 0xF4, 0x02, 0xFF,
+  0x20, 0x0F, 0xF4, 0x02, 0xFF, 0x20, 0x0F, 0xF4, 0x02, 0xFF, 0x20, 0x0F, 0xF5, 0x03, 0xFF, 0x20,
+  0x0C, 0xF9, 0x1A, 0xFF, 0x20, 0x03, 0xCE, 0xC6, 0xFF, 0x20, 0x9F, 0xA0, 0x03, 0xFF, 0x10, 0x3F,
+  0xE1, 0x08, 0xFA, 0x00, 0x0C, 0xF6, 0x0E, 0xF4, 0x00, 0x06, 0xFB, 0x4F, 0xD0, 0x00, 0x01, 0xEF,
+  0xBF, 0x70, 0x00, 0x00, 0x9F, 0xFF, 0x10, 0x00, 0x00, 0x3F, 0xFA, 0x00, 0x00, 0x6F, 0xC0, 0x1F,
+  0xF1, 0x0C, 0xF6, 0x2F, 0xF1, 0x5F, 0xF5, 0x1F, 0xF2, 0x0D, 0xF4, 0x8E, 0xE9, 0x4F, 0xD0, 0x09,
+  0xF8, 0xCA, 0xAD, 0x8F, 0x90, 0x05, 0xFD, 0xF6, 0x6F, 0xDF, 0x50, 0x01, 0xFF, 0xF3, 0x3F, 0xFF,
+  0x10, 0x00, 0xCF, 0xE0, 0x0E, 0xFC, 0x00, 0x5F, 0xE2, 0x0A, 0xFA, 0x00, 0x08, 0xFC, 0x6F, 0xD1,
+  0x00, 0x00, 0xCF, 0xFF, 0x30, 0x00, 0x00, 0x5F, 0xFA, 0x00, 0x00, 0x01, 0xDF, 0xFF, 0x50, 0x00,
+  0x0A, 0xFA, 0x4F, 0xE2, 0x00, 0x6F, 0xD1, 0x09, 0xFC, 0x00, 0xAF, 0xA0, 0x03, 0xFF, 0x10, 0x3F,
+  0xF1, 0x08, 0xFA, 0x00, 0x0C, 0xF7, 0x0D, 0xF5, 0x00, 0x06, 0xFD, 0x3F, 0xE0, 0x00, 0x00, 0xEF,
+  0xCF, 0x90, 0x00, 0x00, 0x8F, 0xFF, 0x40, 0x00, 0x00, 0x2F, 0xFD, 0x00, 0x00, 0x00, 0x0B, 0xF8,
+  0x00, 0x00, 0x00, 0x2E, 0xF2, 0x00, 0x00, 0x0B, 0xFD, 0x50, 0x00, 0x00, 0x4F, 0xFF, 0xFF, 0xE0,
+  0x00, 0x03, 0xEF, 0xE0, 0x00, 0x2D, 0xFF, 0x40, 0x01, 0xCF, 0xF6, 0x00, 0x0B, 0xFF, 0x80, 0x00,
+  0x6F, 0xFA, 0x00, 0x00, 0x6F, 0xFF, 0xFF, 0xE0, 0x00, 0x00, 0x9E, 0xF9, 0x00, 0x00, 0x05, 0xFE,
+  0x20, 0x00, 0x00, 0x06, 0xFB, 0x00, 0x00, 0x00, 0x07, 0xFB, 0x00, 0x00, 0x00, 0x1B, 0xF9, 0x00,
+  0x00, 0x06, 0xFF, 0xD2, 0x00, 0x00, 0x00, 0x1C, 0xF9, 0x00, 0x00, 0x00, 0x07, 0xFB, 0x00, 0x00,
+  0x00, 0x06, 0xFB, 0x00, 0x00, 0x00, 0x06, 0xFC, 0x00, 0x00, 0x00, 0x04, 0xFE, 0x20, 0x00, 0x00,
+  0x00, 0x9E, 0xF9, 0x00, 0x05, 0xF1, 0x00, 0x05, 0xF1, 0x00, 0x05, 0xF1, 0x00, 0x05, 0xF1, 0x00,
+  0x05, 0xF1, 0x00, 0x05, 0xF1, 0x00, 0x05, 0xF1, 0x00, 0x05, 0xF1, 0x00, 0x05, 0xF1, 0x00, 0x05,
+  0xF1, 0x00, 0x05, 0xF1, 0x00, 0x05, 0xF1, 0x00, 0x05, 0xF1, 0x00, 0x06, 0xFE, 0xB2, 0x00, 0x00,
+  0x00, 0x1B, 0xF9, 0x00, 0x00, 0x00, 0x08, 0xFA, 0x00, 0x00, 0x00, 0x07, 0xFA, 0x00, 0x00, 0x00,
+  0x05, 0xFE, 0x20, 0x00, 0x00, 0x00, 0xBF, 0xF9, 0x00, 0x00, 0x05, 0xFE, 0x30, 0x00, 0x00, 0x07,
+  0xFB, 0x00, 0x00, 0x00, 0x08, 0xFA, 0x00, 0x00, 0x00, 0x08, 0xFA, 0x00, 0x00, 0x00, 0x1C, 0xF8,
+  0x00, 0x00, 0x06, 0xFE, 0xB1, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0xAE, 0xD8,
+  0x21, 0x67, 0x00, 0x09, 0xFF, 0xFF, 0xFF, 0xF8, 0x00, 0x07, 0x51, 0x38, 0xEE, 0x91, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+};
+
+const AtlasGlyph font_small_glyphs[] PROGMEM = {
+  { 0, 0, 0, 0, 0, 5 },  // ' '
+  { 0, 6, 9, 0, -9, 6 },  // '!'
+  { 27, 7, 9, 0, -9, 7 },  // '"'
+  { 63, 11, 9, 0, -9, 11 },  // '#'
+  { 117, 9, 11, 0, -9, 9 },  // '$'
+  { 172, 13, 9, 0, -9, 13 },  // '%'
+  { 235, 11, 9, 0, -9, 11 },  // '&'
+  { 289, 4, 9, 0, -9, 4 },  // '''
+  { 307, 6, 12, 0, -10, 6 },  // '('
+  { 343, 6, 12, 0, -10, 6 },  // ')'
+  { 379, 7, 9, 0, -9, 7 },  // '*'
+  { 415, 11, 8, 0, -8, 11 },  // '+'
+  { 463, 5, 4, 0, -2, 5 },  // ','
+  { 475, 5, 5, 0, -5, 5 },  // '-'
+  { 490, 5, 2, 0, -2, 5 },  // '.'
+  { 496, 5, 11, 0, -9, 5 },  // '/'
+  { 529, 9, 9, 0, -9, 9 },  // '0'
+  { 574, 9, 9, 0, -9, 9 },  // '1'
+  { 619, 9, 9, 0, -9, 9 },  // '2'
+  { 664, 9, 9, 0, -9, 9 },  // '3'
+  { 709, 9, 9, 0, -9, 9 },  // '4'
+  { 754, 9, 9, 0, -9, 9 },  // '5'
+  { 799, 9, 9, 0, -9, 9 },  // '6'
+  { 844, 9, 9, 0, -9, 9 },  // '7'
+  { 889, 9, 9, 0, -9, 9 },  // '8'
+  { 934, 9, 9, 0, -9, 9 },  // '9'
+  { 979, 5, 7, 0, -7, 5 },  // ':'
+  { 1000, 5, 9, 0, -7, 5 },  // ';'
+  { 1027, 11, 8, 0, -8, 11 },  // '<'
+  { 1075, 11, 7, 0, -7, 11 },  // '='
+  { 1117, 11, 8, 0, -8, 11 },  // '>'
+  { 1165, 8, 9, 0, -9, 8 },  // '?'
+  { 1201, 13, 11, 0, -9, 13 },  // '@'
+  { 1278, 10, 9, 0, -9, 10 },  // 'A'
+  { 1323, 10, 9, 0, -9, 10 },  // 'B'
+  { 1368, 10, 9, 0, -9, 10 },  // 'C'
+  { 1413, 11, 9, 0, -9, 11 },  // 'D'
+  { 1467, 9, 9, 0, -9, 9 },  // 'E'
+  { 1512, 9, 9, 0, -9, 9 },  // 'F'
+  { 1557, 11, 9, 0, -9, 11 },  // 'G'
+  { 1611, 11, 9, 0, -9, 11 },  // 'H'
+  { 1665, 5, 9, 0, -9, 5 },  // 'I'
+  { 1692, 6, 12, -1, -9, 5 },  // 'J'
+  { 1728, 11, 9, 0, -9, 10 },  // 'K'
+  { 1782, 8, 9, 0, -9, 8 },  // 'L'
+  { 1818, 13, 9, 0, -9, 13 },  // 'M'
+  { 1881, 11, 9, 0, -9, 11 },  // 'N'
+  { 1935, 11, 9, 0, -9, 11 },  // 'O'
+  { 1989, 10, 9, 0, -9, 10 },  // 'P'
+  { 2034, 11, 11, 0, -9, 11 },  // 'Q'
+  { 2100, 10, 9, 0, -9, 10 },  // 'R'
+  { 2145, 9, 9, 0, -9, 9 },  // 'S'
+  { 2190, 9, 9, 0, -9, 9 },  // 'T'
+  { 2235, 11, 9, 0, -9, 11 },  // 'U'
+  { 2289, 10, 9, 0, -9, 10 },  // 'V'
+  { 2334, 14, 9, 0, -9, 14 },  // 'W'
+  { 2397, 10, 9, 0, -9, 10 },  // 'X'
+  { 2442, 11, 9, -1, -9, 9 },  // 'Y'
+  { 2496, 9, 9, 0, -9, 9 },  // 'Z'
+  { 2541, 6, 12, 0, -10, 6 },  // '['
+  { 2577, 5, 11, 0, -9, 5 },  // 'backslash'
+  { 2610, 6, 12, 0, -10, 6 },  // ']'
+  { 2646, 11, 9, 0, -9, 11 },  // '^'
+  { 2700, 7, 3, 0, 0, 7 },  // '_'
+  { 2712, 7, 10, 0, -10, 7 },  // '`'
+  { 2752, 9, 7, 0, -7, 9 },  // 'a'
+  { 2787, 9, 10, 0, -10, 9 },  // 'b'
+  { 2837, 8, 7, 0, -7, 8 },  // 'c'
+  { 2865, 9, 10, 0, -10, 9 },  // 'd'
+  { 2915, 9, 7, 0, -7, 9 },  // 'e'
+  { 2950, 6, 10, 0, -10, 6 },  // 'f'
+  { 2980, 9, 10, 0, -7, 9 },  // 'g'
+  { 3030, 9, 10, 0, -10, 9 },  // 'h'
+  { 3080, 4, 10, 0, -10, 4 },  // 'i'
+  { 3100, 5, 13, -1, -10, 4 },  // 'j'
+  { 3139, 9, 10, 0, -10, 9 },  // 'k'
+  { 3189, 4, 10, 0, -10, 4 },  // 'l'
+  { 3209, 14, 7, 0, -7, 14 },  // 'm'
+  { 3258, 9, 7, 0, -7, 9 },  // 'n'
+  { 3293, 9, 7, 0, -7, 9 },  // 'o'
+  { 3328, 9, 10, 0, -7, 9 },  // 'p'
+  { 3378, 9, 10, 0, -7, 9 },  // 'q'
+  { 3428, 7, 7, 0, -7, 6 },  // 'r'
+  { 3456, 8, 7, 0, -7, 8 },  // 's'
+  { 3484, 6, 9, 0, -9, 6 },  // 't'
+  { 3511, 9, 7, 0, -7, 9 },  // 'u'
+  { 3546, 9, 7, 0, -7, 8 },  // 'v'
+  { 3581, 12, 7, 0, -7, 12 },  // 'w'
+  { 3623, 9, 7, 0, -7, 8 },  // 'x'
+  { 3658, 9, 10, 0, -7, 8 },  // 'y'
+  { 3708, 8, 7, 0, -7, 8 },  // 'z'
+  { 3736, 9, 12, 0, -10, 9 },  // '{'
+  { 3796, 5, 13, 0, -10, 5 },  // '|'
+  { 3835, 9, 12, 0, -10, 9 },  // '}'
+  { 3895, 11, 6, 0, -6, 11 },  // '~'
+};
+
+const AtlasFont font_small = {
+  font_small_bitmap, font_small_glyphs, 0x20, 0x7E, -10, 13
+};
+
+// font_medium: 18px, 10 glifi, 910 bytes
+const uint8_t font_medium_bitmap[] PROGMEM = {
+  0x00, 0x05, 0xBE, 0xFD, 0x81, 0x00, 0x00, 0x00, 0x8F, 0xFF, 0xFF, 0xFD, 0x20, 0x00, 0x04, 0xFF,
+  0xE3, 0x19, 0xFF, 0xB0, 0x00, 0x0A, 0xFF, 0x80, 0x01, 0xFF, 0xF3, 0x00, 0x0E, 0xFF, 0x50, 0x00,
+  0xDF, 0xF7, 0x00, 0x1F, 0xFF, 0x40, 0x00, 0xBF, 0xF9, 0x00, 0x2F, 0xFF, 0x40, 0x00, 0xBF, 0xFA,
+  0x00, 0x1F, 0xFF, 0x40, 0x00, 0xBF, 0xF9, 0x00, 0x0E, 0xFF, 0x50, 0x00, 0xDF, 0xF7, 0x00, 0x0A,
+  0xFF, 0x80, 0x01, 0xFF, 0xF3, 0x00, 0x04, 0xFF, 0xE3, 0x19, 0xFF, 0xB0, 0x00, 0x00, 0x8F, 0xFF,
+  0xFF, 0xFD, 0x20, 0x00, 0x00, 0x05, 0xBE, 0xFD, 0x81, 0x00, 0x00, 0x00, 0x27, 0xCF, 0xFF, 0x40,
+  0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0x40, 0x00, 0x00, 0x00, 0xC8, 0x3E, 0xFF, 0x40, 0x00, 0x00,
+  0x00, 0x00, 0x0E, 0xFF, 0x40, 0x00, 0x00, 0x00, 0x00, 0x0E, 0xFF, 0x40, 0x00, 0x00, 0x00, 0x00,
+  0x0E, 0xFF, 0x40, 0x00, 0x00, 0x00, 0x00, 0x0E, 0xFF, 0x40, 0x00, 0x00, 0x00, 0x00, 0x0E, 0xFF,
+  0x40, 0x00, 0x00, 0x00, 0x00, 0x0E, 0xFF, 0x40, 0x00, 0x00, 0x00, 0x00, 0x0E, 0xFF, 0x40, 0x00,
+  0x00, 0x00, 0x00, 0x0E, 0xFF, 0x40, 0x00, 0x00, 0x00, 0xDF, 0xFF, 0xFF, 0xFF, 0xF4, 0x00, 0x00,
+  0xDF, 0xFF, 0xFF, 0xFF, 0xF4, 0x00, 0x01, 0x5A, 0xDF, 0xED, 0x81, 0x00, 0x00, 0x08, 0xFF, 0xFF,
+  0xFF, 0xFD, 0x10, 0x00, 0x08, 0xF8, 0x21, 0x6F, 0xFF, 0x90, 0x00, 0x06, 0x30, 0x00, 0x0B, 0xFF,
+  0xC0, 0x00, 0x00, 0x00, 0x00, 0x09, 0xFF, 0xC0, 0x00, 0x00, 0x00, 0x00, 0x0C, 0xFF, 0x80, 0x00,
+  0x00, 0x00, 0x00, 0x7F, 0xFE, 0x10, 0x00, 0x00, 0x00, 0x07, 0xFF, 0xE3, 0x00, 0x00, 0x00, 0x00,
+  0x9F, 0xFE, 0x30, 0x00, 0x00, 0x00, 0x1B, 0xFF, 0xC2, 0x00, 0x00, 0x00, 0x02, 0xDF, 0xFB, 0x10,
+  0x00, 0x00, 0x00, 0x09, 0xFF, 0xFF, 0xFF, 0xFF, 0xE0, 0x00, 0x09, 0xFF, 0xFF, 0xFF, 0xFF, 0xE0,
+  0x00, 0x00, 0x4A, 0xDF, 0xED, 0xA3, 0x00, 0x00, 0x04, 0xFF, 0xFF, 0xFF, 0xFF, 0x40, 0x00, 0x03,
+  0xA4, 0x11, 0x4E, 0xFF, 0xB0, 0x00, 0x00, 0x00, 0x00, 0x0A, 0xFF, 0xB0, 0x00, 0x00, 0x00, 0x01,
+  0x4E, 0xFF, 0x50, 0x00, 0x00, 0x08, 0xFF, 0xFF, 0xD4, 0x00, 0x00, 0x00, 0x08, 0xFF, 0xFF, 0xFC,
+  0x20, 0x00, 0x00, 0x00, 0x01, 0x5E, 0xFF, 0xB0, 0x00, 0x00, 0x00, 0x00, 0x06, 0xFF, 0xF0, 0x00,
+  0x00, 0x00, 0x00, 0x06, 0xFF, 0xF1, 0x00, 0x0A, 0x73, 0x11, 0x5E, 0xFF, 0xC0, 0x00, 0x0C, 0xFF,
+  0xFF, 0xFF, 0xFE, 0x30, 0x00, 0x02, 0x7C, 0xEF, 0xEC, 0x81, 0x00, 0x00, 0x00, 0x00, 0x04, 0xFF,
+  0xFC, 0x00, 0x00, 0x00, 0x00, 0x1E, 0xFF, 0xFC, 0x00, 0x00, 0x00, 0x00, 0xBF, 0xFF, 0xFC, 0x00,
+  0x00, 0x00, 0x07, 0xFE, 0x7F, 0xFC, 0x00, 0x00, 0x00, 0x3F, 0xF5, 0x6F, 0xFC, 0x00, 0x00, 0x01,
+  0xDF, 0xA0, 0x6F, 0xFC, 0x00, 0x00, 0x09, 0xFD, 0x10, 0x6F, 0xFC, 0x00, 0x00, 0x2F, 0xF4, 0x00,
+  0x6F, 0xFC, 0x00, 0x00, 0x3F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFB, 0x00, 0x3F, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFB, 0x00, 0x00, 0x00, 0x00, 0x6F, 0xFC, 0x00, 0x00, 0x00, 0x00, 0x00, 0x6F, 0xFC, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x6F, 0xFC, 0x00, 0x00, 0x01, 0xFF, 0xFF, 0xFF, 0xFF, 0x50, 0x00, 0x01, 0xFF,
+  0xFF, 0xFF, 0xFF, 0x50, 0x00, 0x01, 0xFF, 0x90, 0x00, 0x00, 0x00, 0x00, 0x01, 0xFF, 0x90, 0x00,
+  0x00, 0x00, 0x00, 0x01, 0xFF, 0xEE, 0xFD, 0x92, 0x00, 0x00, 0x01, 0xFF, 0xFF, 0xFF, 0xFE, 0x30,
+  0x00, 0x01, 0xB5, 0x21, 0x4D, 0xFF, 0xD0, 0x00, 0x00, 0x00, 0x00, 0x05, 0xFF, 0xF2, 0x00, 0x00,
+  0x00, 0x00, 0x02, 0xFF, 0xF4, 0x00, 0x00, 0x00, 0x00, 0x05, 0xFF, 0xF2, 0x00, 0x08, 0x94, 0x11,
+  0x4D, 0xFF, 0xC0, 0x00, 0x09, 0xFF, 0xFF, 0xFF, 0xFE, 0x30, 0x00, 0x01, 0x6B, 0xDF, 0xEC, 0x81,
+  0x00, 0x00, 0x00, 0x00, 0x7C, 0xEE, 0xC8, 0x20, 0x00, 0x00, 0x1C, 0xFF, 0xFF, 0xFF, 0xB0, 0x00,
+  0x00, 0xCF, 0xFA, 0x31, 0x26, 0x90, 0x00, 0x05, 0xFF, 0xB0, 0x00, 0x00, 0x00, 0x00, 0x09, 0xFF,
+  0xAB, 0xEF, 0xC6, 0x00, 0x00, 0x0C, 0xFF, 0xFF, 0xFF, 0xFF, 0x90, 0x00, 0x0D, 0xFF, 0xF6, 0x16,
+  0xFF, 0xF3, 0x00, 0x0D, 0xFF, 0xD0, 0x00, 0xDF, 0xF7, 0x00, 0x0B, 0xFF, 0xB0, 0x00, 0xBF, 0xF8,
+  0x00, 0x07, 0xFF, 0xD0, 0x00, 0xDF, 0xF6, 0x00, 0x01, 0xEF, 0xF6, 0x16, 0xFF, 0xE1, 0x00, 0x00,
+  0x5F, 0xFF, 0xFF, 0xFF, 0x50, 0x00, 0x00, 0x03, 0xAE, 0xFE, 0xA3, 0x00, 0x00, 0x0C, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xF1, 0x00, 0x0C, 0xFF, 0xFF, 0xFF, 0xFF, 0xF1, 0x00, 0x00, 0x00, 0x00, 0x0A, 0xFF,
+  0xC0, 0x00, 0x00, 0x00, 0x00, 0x2F, 0xFF, 0x50, 0x00, 0x00, 0x00, 0x00, 0x9F, 0xFD, 0x00, 0x00,
+  0x00, 0x00, 0x01, 0xEF, 0xF6, 0x00, 0x00, 0x00, 0x00, 0x07, 0xFF, 0xE1, 0x00, 0x00, 0x00, 0x00,
+  0x0D, 0xFF, 0x80, 0x00, 0x00, 0x00, 0x00, 0x5F, 0xFF, 0x10, 0x00, 0x00, 0x00, 0x00, 0xCF, 0xF9,
+  0x00, 0x00, 0x00, 0x00, 0x03, 0xFF, 0xF2, 0x00, 0x00, 0x00, 0x00, 0x0A, 0xFF, 0xA0, 0x00, 0x00,
+  0x00, 0x00, 0x2F, 0xFF, 0x30, 0x00, 0x00, 0x00, 0x00, 0x29, 0xDE, 0xFE, 0xB6, 0x00, 0x00, 0x02,
+  0xEF, 0xFF, 0xFF, 0xFF, 0x80, 0x00, 0x08, 0xFF, 0xD3, 0x18, 0xFF, 0xF1, 0x00, 0x08, 0xFF, 0xA0,
+  0x02, 0xFF, 0xF1, 0x00, 0x04, 0xFF, 0xD3, 0x18, 0xFF, 0xB0, 0x00, 0x00, 0x5D, 0xFF, 0xFF, 0xF9,
+  0x10, 0x00, 0x00, 0x7E, 0xFF, 0xFF, 0xFB, 0x20, 0x00, 0x07, 0xFF, 0xC2, 0x17, 0xFF, 0xD1, 0x00,
+  0x0C, 0xFF, 0x60, 0x00, 0xDF, 0xF5, 0x00, 0x0D, 0xFF, 0x60, 0x00, 0xDF, 0xF6, 0x00, 0x0A, 0xFF,
+  0xC2, 0x17, 0xFF, 0xF3, 0x00, 0x03, 0xEF, 0xFF, 0xFF, 0xFF, 0x90, 0x00, 0x00, 0x29, 0xDE, 0xFE,
+  0xB6, 0x00, 0x00, 0x00, 0x17, 0xCE, 0xEC, 0x70, 0x00, 0x00, 0x01, 0xCF, 0xFF, 0xFF, 0xFB, 0x00,
+  0x00, 0x08, 0xFF, 0xC2, 0x2C, 0xFF, 0x80, 0x00, 0x0E, 0xFF, 0x50, 0x06, 0xFF, 0xE0, 0x00, 0x1F,
+  0xFF, 0x30, 0x04, 0xFF, 0xF3, 0x00, 0x0F, 0xFF, 0x50, 0x05, 0xFF, 0xF5, 0x00, 0x0B, 0xFF, 0xC2,
+  0x2C, 0xFF, 0xF5, 0x00, 0x02, 0xEF, 0xFF, 0xFF, 0xFF, 0xF4, 0x00, 0x00, 0x2A, 0xEF, 0xD8, 0xEF,
+  0xF2, 0x00, 0x00, 0x00, 0x00, 0x04, 0xFF, 0xC0, 0x00, 0x03, 0xA4, 0x11, 0x5E, 0xFF, 0x40, 0x00,
+  0x03, 0xFF, 0xFF, 0xFF, 0xF6, 0x00, 0x00, 0x00, 0x5B, 0xEF, 0xD9, 0x30, 0x00, 0x00,
+};
+
+const AtlasGlyph font_medium_glyphs[] PROGMEM = {
+  { 0, 13, 13, 0, -13, 13 },  // '0'
+  { 91, 13, 13, 0, -13, 13 },  // '1'
+  { 182, 13, 13, 0, -13, 13 },  // '2'
+  { 273, 13, 13, 0, -13, 13 },  // '3'
+  { 364, 13, 13, 0, -13, 13 },  // '4'
+  { 455, 13, 13, 0, -13, 13 },  // '5'
+  { 546, 13, 13, 0, -13, 13 },  // '6'
+  { 637, 13, 13, 0, -13, 13 },  // '7'
+  { 728, 13, 13, 0, -13, 13 },  // '8'
+  { 819, 13, 13, 0, -13, 13 },  // '9'
+};
+
+const AtlasFont font_medium = {
+  font_medium_bitmap, font_medium_glyphs, 0x30, 0x39, -13, 13
+};
+
+// font_large: 30px, 14 glifi, 2965 bytes
+const uint8_t font_large_bitmap[] PROGMEM = {
+  0x00, 0x0E, 0xFF, 0xFF, 0x50, 0x00, 0x00, 0x0E, 0xFF, 0xFF, 0x50, 0x00, 0x00, 0x0E, 0xFF, 0xFF,
+  0x50, 0x00, 0x00, 0x0E, 0xFF, 0xFF, 0x50, 0x00, 0x00, 0x0E, 0xFF, 0xFF, 0x50, 0x00, 0x00, 0x0E,
+  0xFF, 0xFF, 0x50, 0x00, 0x00, 0x00, 0x00, 0x38, 0xCE, 0xFE, 0xC8, 0x20, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x1A, 0xFF, 0xFF, 0xFF, 0xFF, 0xF8, 0x00, 0x00, 0x00, 0x00, 0x01, 0xCF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xA0, 0x00, 0x00, 0x00, 0x0A, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xF8, 0x00, 0x00,
+  0x00, 0x4F, 0xFF, 0xFF, 0xB2, 0x03, 0xCF, 0xFF, 0xFF, 0x20, 0x00, 0x00, 0xAF, 0xFF, 0xFD, 0x10,
+  0x00, 0x1E, 0xFF, 0xFF, 0x80, 0x00, 0x00, 0xFF, 0xFF, 0xF8, 0x00, 0x00, 0x0A, 0xFF, 0xFF, 0xD0,
+  0x00, 0x03, 0xFF, 0xFF, 0xF5, 0x00, 0x00, 0x07, 0xFF, 0xFF, 0xF1, 0x00, 0x06, 0xFF, 0xFF, 0xF3,
+  0x00, 0x00, 0x05, 0xFF, 0xFF, 0xF4, 0x00, 0x07, 0xFF, 0xFF, 0xF2, 0x00, 0x00, 0x04, 0xFF, 0xFF,
+  0xF5, 0x00, 0x08, 0xFF, 0xFF, 0xF1, 0x00, 0x00, 0x03, 0xFF, 0xFF, 0xF6, 0x00, 0x08, 0xFF, 0xFF,
+  0xF1, 0x00, 0x00, 0x03, 0xFF, 0xFF, 0xF6, 0x00, 0x07, 0xFF, 0xFF, 0xF2, 0x00, 0x00, 0x04, 0xFF,
+  0xFF, 0xF5, 0x00, 0x06, 0xFF, 0xFF, 0xF3, 0x00, 0x00, 0x05, 0xFF, 0xFF, 0xF4, 0x00, 0x03, 0xFF,
+  0xFF, 0xF5, 0x00, 0x00, 0x07, 0xFF, 0xFF, 0xF1, 0x00, 0x00, 0xFF, 0xFF, 0xF8, 0x00, 0x00, 0x0A,
+  0xFF, 0xFF, 0xD0, 0x00, 0x00, 0xAF, 0xFF, 0xFD, 0x10, 0x00, 0x1E, 0xFF, 0xFF, 0x80, 0x00, 0x00,
+  0x4F, 0xFF, 0xFF, 0xB2, 0x03, 0xCF, 0xFF, 0xFF, 0x20, 0x00, 0x00, 0x0A, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xF8, 0x00, 0x00, 0x00, 0x01, 0xCF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xA0, 0x00, 0x00,
+  0x00, 0x00, 0x1A, 0xFF, 0xFF, 0xFF, 0xFF, 0xF8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x38, 0xCE,
+  0xFE, 0xC8, 0x20, 0x00, 0x00, 0x00, 0x00, 0x01, 0x36, 0x9C, 0xFF, 0xFF, 0xFC, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x09, 0xFF, 0xFF, 0xFF, 0xFF, 0xFC, 0x00, 0x00, 0x00, 0x00, 0x00, 0x09, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xFC, 0x00, 0x00, 0x00, 0x00, 0x00, 0x09, 0xFF, 0xFF, 0xFF, 0xFF, 0xFC, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x09, 0xC9, 0x63, 0x8F, 0xFF, 0xFC, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x8F, 0xFF, 0xFC, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x8F, 0xFF, 0xFC, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x8F, 0xFF, 0xFC, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x8F, 0xFF, 0xFC, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x8F, 0xFF, 0xFC,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x8F, 0xFF, 0xFC, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x8F, 0xFF, 0xFC, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x8F, 0xFF,
+  0xFC, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x8F, 0xFF, 0xFC, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x8F, 0xFF, 0xFC, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x8F,
+  0xFF, 0xFC, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x8F, 0xFF, 0xFC, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x8F, 0xFF, 0xFC, 0x00, 0x00, 0x00, 0x00, 0x00, 0x07, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xC0, 0x00, 0x00, 0x07, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xC0, 0x00, 0x00, 0x07, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xC0, 0x00, 0x00, 0x07, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xC0, 0x00, 0x00, 0x03, 0x69, 0xBD, 0xEF, 0xED, 0xB7, 0x20,
+  0x00, 0x00, 0x00, 0x00, 0x8F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xF8, 0x00, 0x00, 0x00, 0x00, 0x8F,
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xB0, 0x00, 0x00, 0x00, 0x8F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xF6, 0x00, 0x00, 0x00, 0x8F, 0xE9, 0x52, 0x02, 0x6E, 0xFF, 0xFF, 0xFC, 0x00, 0x00, 0x00,
+  0x77, 0x10, 0x00, 0x00, 0x02, 0xEF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0xAF, 0xFF, 0xFF, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x9F, 0xFF, 0xFF, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xCF, 0xFF, 0xFB, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x05, 0xFF, 0xFF, 0xF5, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3E, 0xFF, 0xFF, 0xA0, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0xEF, 0xFF, 0xFC, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x6F, 0xFF, 0xFF, 0xC1, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0xFF, 0xFF, 0xFB, 0x10, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x9F, 0xFF, 0xFF, 0x90, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1B,
+  0xFF, 0xFF, 0xF7, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0xCF, 0xFF, 0xFF, 0x60, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x3D, 0xFF, 0xFF, 0xE4, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x9F,
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x40, 0x00, 0x00, 0x9F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xFF, 0x40, 0x00, 0x00, 0x9F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x40, 0x00, 0x00,
+  0x9F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x40, 0x00, 0x00, 0x02, 0x59, 0xBD, 0xEF, 0xED,
+  0xB8, 0x40, 0x00, 0x00, 0x00, 0x00, 0x1F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFC, 0x20, 0x00, 0x00,
+  0x00, 0x1F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xE1, 0x00, 0x00, 0x00, 0x1F, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xF8, 0x00, 0x00, 0x00, 0x1D, 0x95, 0x31, 0x02, 0x5C, 0xFF, 0xFF, 0xFD, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0xDF, 0xFF, 0xFE, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0xBF, 0xFF, 0xFD, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0xDF, 0xFF, 0xF9,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x5C, 0xFF, 0xFF, 0xE2, 0x00, 0x00, 0x00, 0x00, 0x04,
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFC, 0x20, 0x00, 0x00, 0x00, 0x00, 0x04, 0xFF, 0xFF, 0xFF, 0xFF, 0x91,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0xFF, 0xFF, 0xFF, 0xFF, 0xFE, 0x60, 0x00, 0x00, 0x00, 0x00,
+  0x04, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xF7, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x49, 0xFF,
+  0xFF, 0xFE, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7F, 0xFF, 0xFF, 0x50, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x3F, 0xFF, 0xFF, 0x70, 0x00, 0x00, 0xB3, 0x00, 0x00, 0x00, 0x00,
+  0x7F, 0xFF, 0xFF, 0x60, 0x00, 0x00, 0xFF, 0xB6, 0x31, 0x01, 0x49, 0xFF, 0xFF, 0xFF, 0x30, 0x00,
+  0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFC, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xD2, 0x00, 0x00, 0x00, 0x4C, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFA, 0x10, 0x00,
+  0x00, 0x00, 0x00, 0x38, 0xBE, 0xFF, 0xEC, 0xA7, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x03, 0xFF, 0xFF, 0xFF, 0x60, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1D, 0xFF, 0xFF, 0xFF, 0x60,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x8F, 0xFF, 0xFF, 0xFF, 0x60, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x04, 0xFF, 0xFF, 0xFF, 0xFF, 0x60, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1D, 0xFF, 0xFF, 0xFF, 0xFF,
+  0x60, 0x00, 0x00, 0x00, 0x00, 0x00, 0x8F, 0xFF, 0x8E, 0xFF, 0xFF, 0x60, 0x00, 0x00, 0x00, 0x00,
+  0x04, 0xFF, 0xFC, 0x0E, 0xFF, 0xFF, 0x60, 0x00, 0x00, 0x00, 0x00, 0x1D, 0xFF, 0xF3, 0x0E, 0xFF,
+  0xFF, 0x60, 0x00, 0x00, 0x00, 0x00, 0x8F, 0xFF, 0x80, 0x0E, 0xFF, 0xFF, 0x60, 0x00, 0x00, 0x00,
+  0x04, 0xFF, 0xFC, 0x00, 0x0E, 0xFF, 0xFF, 0x60, 0x00, 0x00, 0x00, 0x1D, 0xFF, 0xF3, 0x00, 0x0E,
+  0xFF, 0xFF, 0x60, 0x00, 0x00, 0x00, 0x8F, 0xFF, 0x80, 0x00, 0x0E, 0xFF, 0xFF, 0x60, 0x00, 0x00,
+  0x04, 0xFF, 0xFC, 0x00, 0x00, 0x0E, 0xFF, 0xFF, 0x60, 0x00, 0x00, 0x0A, 0xFF, 0xF3, 0x00, 0x00,
+  0x0E, 0xFF, 0xFF, 0x60, 0x00, 0x00, 0x0A, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xF8,
+  0x00, 0x0A, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xF8, 0x00, 0x0A, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xF8, 0x00, 0x0A, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xF8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0E, 0xFF, 0xFF, 0x60, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x0E, 0xFF, 0xFF, 0x60, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0E, 0xFF, 0xFF,
+  0x60, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0E, 0xFF, 0xFF, 0x60, 0x00, 0x00, 0x00, 0x0C,
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xF3, 0x00, 0x00, 0x00, 0x0C, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xF3, 0x00, 0x00, 0x00, 0x0C, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xF3, 0x00, 0x00, 0x00,
+  0x0C, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xF3, 0x00, 0x00, 0x00, 0x0C, 0xFF, 0xFA, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0xFF, 0xFA, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x0C, 0xFF, 0xFA, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0xFF, 0xFD, 0xCE,
+  0xFE, 0xC9, 0x40, 0x00, 0x00, 0x00, 0x00, 0x0C, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFB, 0x20, 0x00,
+  0x00, 0x00, 0x0C, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xD2, 0x00, 0x00, 0x00, 0x0C, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFB, 0x00, 0x00, 0x00, 0x0C, 0xFC, 0x62, 0x01, 0x4B, 0xFF, 0xFF, 0xFF,
+  0x40, 0x00, 0x00, 0x09, 0x40, 0x00, 0x00, 0x00, 0x8F, 0xFF, 0xFF, 0x80, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x1F, 0xFF, 0xFF, 0xA0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0D, 0xFF,
+  0xFF, 0xB0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1F, 0xFF, 0xFF, 0xA0, 0x00, 0x00, 0x96,
+  0x00, 0x00, 0x00, 0x00, 0x8F, 0xFF, 0xFF, 0x80, 0x00, 0x00, 0xAF, 0xE9, 0x52, 0x01, 0x4B, 0xFF,
+  0xFF, 0xFF, 0x30, 0x00, 0x00, 0xAF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFA, 0x00, 0x00, 0x00,
+  0xAF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xC1, 0x00, 0x00, 0x00, 0x29, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xF9, 0x10, 0x00, 0x00, 0x00, 0x00, 0x15, 0x9C, 0xEF, 0xED, 0xB7, 0x20, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x01, 0x7B, 0xDE, 0xED, 0xA4, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x8E, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xC3, 0x00, 0x00, 0x00, 0x00, 0x1B, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFC, 0x00,
+  0x00, 0x00, 0x00, 0xBF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFC, 0x00, 0x00, 0x00, 0x07, 0xFF, 0xFF,
+  0xFB, 0x52, 0x01, 0x4A, 0xFC, 0x00, 0x00, 0x00, 0x1E, 0xFF, 0xFF, 0x80, 0x00, 0x00, 0x00, 0x29,
+  0x00, 0x00, 0x00, 0x6F, 0xFF, 0xFC, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xAF, 0xFF,
+  0xF7, 0x39, 0xDF, 0xEC, 0x93, 0x00, 0x00, 0x00, 0x00, 0xEF, 0xFF, 0xFC, 0xFF, 0xFF, 0xFF, 0xFF,
+  0x80, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFA, 0x00, 0x00, 0x01, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x50, 0x00, 0x02, 0xFF, 0xFF, 0xFF, 0xE5, 0x12, 0x7F,
+  0xFF, 0xFF, 0xC0, 0x00, 0x01, 0xFF, 0xFF, 0xFF, 0x50, 0x00, 0x09, 0xFF, 0xFF, 0xF1, 0x00, 0x00,
+  0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x04, 0xFF, 0xFF, 0xF3, 0x00, 0x00, 0xDF, 0xFF, 0xFE, 0x00, 0x00,
+  0x03, 0xFF, 0xFF, 0xF3, 0x00, 0x00, 0x9F, 0xFF, 0xFF, 0x00, 0x00, 0x04, 0xFF, 0xFF, 0xF2, 0x00,
+  0x00, 0x4F, 0xFF, 0xFF, 0x50, 0x00, 0x09, 0xFF, 0xFF, 0xE0, 0x00, 0x00, 0x0D, 0xFF, 0xFF, 0xE5,
+  0x12, 0x7F, 0xFF, 0xFF, 0x90, 0x00, 0x00, 0x04, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFE, 0x20,
+  0x00, 0x00, 0x00, 0x7F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xF4, 0x00, 0x00, 0x00, 0x00, 0x06, 0xEF,
+  0xFF, 0xFF, 0xFF, 0xFD, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00, 0x17, 0xBD, 0xFE, 0xDA, 0x50, 0x00,
+  0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x70, 0x00, 0x00, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x70, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0x70, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x50, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0xAF, 0xFF, 0xFD, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0xFF,
+  0xFF, 0xF7, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x09, 0xFF, 0xFF, 0xE1, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x1E, 0xFF, 0xFF, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7F,
+  0xFF, 0xFF, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xDF, 0xFF, 0xF9, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x06, 0xFF, 0xFF, 0xF3, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0C,
+  0xFF, 0xFF, 0xB0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x4F, 0xFF, 0xFF, 0x40, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0xBF, 0xFF, 0xFC, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03,
+  0xFF, 0xFF, 0xF5, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x09, 0xFF, 0xFF, 0xD0, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x1F, 0xFF, 0xFF, 0x70, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x8F, 0xFF, 0xFE, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0xEF, 0xFF, 0xF8, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x06, 0xFF, 0xFF, 0xF2, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x0D, 0xFF, 0xFF, 0xA0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x5F, 0xFF, 0xFF, 0x30, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x8B, 0xDE, 0xFE, 0xDB, 0x72, 0x00, 0x00, 0x00, 0x00,
+  0x01, 0xAF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x90, 0x00, 0x00, 0x00, 0x0C, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xFA, 0x00, 0x00, 0x00, 0x5F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x30, 0x00,
+  0x00, 0x9F, 0xFF, 0xFF, 0x82, 0x02, 0x9F, 0xFF, 0xFF, 0x70, 0x00, 0x00, 0xAF, 0xFF, 0xFB, 0x00,
+  0x00, 0x0E, 0xFF, 0xFF, 0x80, 0x00, 0x00, 0x7F, 0xFF, 0xFB, 0x00, 0x00, 0x0E, 0xFF, 0xFF, 0x60,
+  0x00, 0x00, 0x2E, 0xFF, 0xFF, 0x82, 0x02, 0x9F, 0xFF, 0xFE, 0x10, 0x00, 0x00, 0x05, 0xEF, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xFF, 0xD3, 0x00, 0x00, 0x00, 0x00, 0x28, 0xEF, 0xFF, 0xFF, 0xFF, 0xE7, 0x10,
+  0x00, 0x00, 0x00, 0x00, 0x5C, 0xFF, 0xFF, 0xFF, 0xFF, 0xFB, 0x40, 0x00, 0x00, 0x00, 0x09, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xF7, 0x00, 0x00, 0x00, 0x6F, 0xFF, 0xFF, 0x82, 0x12, 0x9F, 0xFF,
+  0xFF, 0x40, 0x00, 0x00, 0xDF, 0xFF, 0xF8, 0x00, 0x00, 0x0A, 0xFF, 0xFF, 0xB0, 0x00, 0x01, 0xFF,
+  0xFF, 0xF4, 0x00, 0x00, 0x06, 0xFF, 0xFF, 0xE0, 0x00, 0x02, 0xFF, 0xFF, 0xF4, 0x00, 0x00, 0x06,
+  0xFF, 0xFF, 0xF0, 0x00, 0x01, 0xFF, 0xFF, 0xF8, 0x00, 0x00, 0x0A, 0xFF, 0xFF, 0xE0, 0x00, 0x00,
+  0xDF, 0xFF, 0xFF, 0x72, 0x02, 0x9F, 0xFF, 0xFF, 0xB0, 0x00, 0x00, 0x7F, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xFF, 0x50, 0x00, 0x00, 0x0C, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFA, 0x00, 0x00,
+  0x00, 0x01, 0x9F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x80, 0x00, 0x00, 0x00, 0x00, 0x02, 0x8B, 0xDE,
+  0xFE, 0xDB, 0x72, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x6B, 0xDE, 0xED, 0xA6, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x5E, 0xFF, 0xFF, 0xFF, 0xFF, 0xD4, 0x00, 0x00, 0x00, 0x00, 0x07, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xFF, 0x50, 0x00, 0x00, 0x00, 0x4F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xE2,
+  0x00, 0x00, 0x00, 0xCF, 0xFF, 0xFE, 0x61, 0x16, 0xEF, 0xFF, 0xFA, 0x00, 0x00, 0x02, 0xFF, 0xFF,
+  0xF6, 0x00, 0x00, 0x7F, 0xFF, 0xFF, 0x20, 0x00, 0x05, 0xFF, 0xFF, 0xF2, 0x00, 0x00, 0x3F, 0xFF,
+  0xFF, 0x60, 0x00, 0x06, 0xFF, 0xFF, 0xF0, 0x00, 0x00, 0x1F, 0xFF, 0xFF, 0xA0, 0x00, 0x06, 0xFF,
+  0xFF, 0xF2, 0x00, 0x00, 0x3F, 0xFF, 0xFF, 0xC0, 0x00, 0x04, 0xFF, 0xFF, 0xF6, 0x00, 0x00, 0x7F,
+  0xFF, 0xFF, 0xD0, 0x00, 0x01, 0xEF, 0xFF, 0xFE, 0x51, 0x16, 0xEF, 0xFF, 0xFF, 0xE0, 0x00, 0x00,
+  0x8F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xE0, 0x00, 0x00, 0x1C, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xC0, 0x00, 0x00, 0x01, 0xBF, 0xFF, 0xFF, 0xFF, 0xFC, 0xFF, 0xFF, 0xB0, 0x00,
+  0x00, 0x00, 0x04, 0xAD, 0xEE, 0xD9, 0x2A, 0xFF, 0xFF, 0x70, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x1E, 0xFF, 0xFF, 0x30, 0x00, 0x00, 0x0A, 0x10, 0x00, 0x00, 0x00, 0xBF, 0xFF, 0xFC, 0x00,
+  0x00, 0x00, 0x0F, 0xE8, 0x31, 0x02, 0x6D, 0xFF, 0xFF, 0xF4, 0x00, 0x00, 0x00, 0x0F, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xFF, 0x90, 0x00, 0x00, 0x00, 0x0F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xF9, 0x00,
+  0x00, 0x00, 0x00, 0x05, 0xDF, 0xFF, 0xFF, 0xFF, 0xFE, 0x60, 0x00, 0x00, 0x00, 0x00, 0x00, 0x06,
+  0xAE, 0xFE, 0xDA, 0x61, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7F, 0xFF, 0xFC, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x7F, 0xFF, 0xFC, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7F,
+  0xFF, 0xFC, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7F, 0xFF, 0xFC, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x7F, 0xFF, 0xFC, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x7F, 0xFF, 0xFC, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7F, 0xFF, 0xFC, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7F, 0xFF, 0xFC, 0x00, 0x00, 0x0A, 0xFF, 0xFF, 0xF5, 0x00,
+  0x00, 0x7F, 0xFF, 0xFC, 0x00, 0x00, 0xBF, 0xFF, 0xFE, 0x40, 0x00, 0x00, 0x7F, 0xFF, 0xFC, 0x00,
+  0x1B, 0xFF, 0xFF, 0xE3, 0x00, 0x00, 0x00, 0x7F, 0xFF, 0xFC, 0x01, 0xBF, 0xFF, 0xFD, 0x30, 0x00,
+  0x00, 0x00, 0x7F, 0xFF, 0xFC, 0x1C, 0xFF, 0xFF, 0xD2, 0x00, 0x00, 0x00, 0x00, 0x7F, 0xFF, 0xFC,
+  0xCF, 0xFF, 0xFC, 0x10, 0x00, 0x00, 0x00, 0x00, 0x7F, 0xFF, 0xFF, 0xFF, 0xFF, 0xB1, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x7F, 0xFF, 0xFF, 0xFF, 0xFF, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7F, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xD2, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7F, 0xFF, 0xFD, 0xEF, 0xFF, 0xFD, 0x20,
+  0x00, 0x00, 0x00, 0x00, 0x7F, 0xFF, 0xFC, 0x3E, 0xFF, 0xFF, 0xD2, 0x00, 0x00, 0x00, 0x00, 0x7F,
+  0xFF, 0xFC, 0x03, 0xEF, 0xFF, 0xFD, 0x20, 0x00, 0x00, 0x00, 0x7F, 0xFF, 0xFC, 0x00, 0x4E, 0xFF,
+  0xFF, 0xD2, 0x00, 0x00, 0x00, 0x7F, 0xFF, 0xFC, 0x00, 0x04, 0xFF, 0xFF, 0xFD, 0x20, 0x00, 0x00,
+  0x7F, 0xFF, 0xFC, 0x00, 0x00, 0x5F, 0xFF, 0xFF, 0xD2, 0x00, 0x00, 0x7F, 0xFF, 0xFC, 0x00, 0x00,
+  0x05, 0xFF, 0xFF, 0xFD, 0x20, 0x00, 0x8F, 0xFF, 0xFC, 0x01, 0x7C, 0xEE, 0xB4, 0x00, 0x00, 0x6C,
+  0xEF, 0xD9, 0x30, 0x00, 0x00, 0x00, 0x8F, 0xFF, 0xFC, 0x2C, 0xFF, 0xFF, 0xFF, 0x90, 0x2C, 0xFF,
+  0xFF, 0xFF, 0xF5, 0x00, 0x00, 0x00, 0x8F, 0xFF, 0xFC, 0xCF, 0xFF, 0xFF, 0xFF, 0xF7, 0xCF, 0xFF,
+  0xFF, 0xFF, 0xFF, 0x20, 0x00, 0x00, 0x8F, 0xFF, 0xFF, 0xF6, 0x12, 0xBF, 0xFF, 0xFF, 0xFC, 0x31,
+  0x5E, 0xFF, 0xFF, 0x80, 0x00, 0x00, 0x8F, 0xFF, 0xFF, 0x70, 0x00, 0x3F, 0xFF, 0xFF, 0xE1, 0x00,
+  0x09, 0xFF, 0xFF, 0xC0, 0x00, 0x00, 0x8F, 0xFF, 0xFF, 0x10, 0x00, 0x1F, 0xFF, 0xFF, 0xA0, 0x00,
+  0x07, 0xFF, 0xFF, 0xD0, 0x00, 0x00, 0x8F, 0xFF, 0xFD, 0x00, 0x00, 0x0F, 0xFF, 0xFF, 0x60, 0x00,
+  0x06, 0xFF, 0xFF, 0xD0, 0x00, 0x00, 0x8F, 0xFF, 0xFC, 0x00, 0x00, 0x0E, 0xFF, 0xFF, 0x50, 0x00,
+  0x06, 0xFF, 0xFF, 0xD0, 0x00, 0x00, 0x8F, 0xFF, 0xFC, 0x00, 0x00, 0x0E, 0xFF, 0xFF, 0x50, 0x00,
+  0x06, 0xFF, 0xFF, 0xD0, 0x00, 0x00, 0x8F, 0xFF, 0xFC, 0x00, 0x00, 0x0E, 0xFF, 0xFF, 0x50, 0x00,
+  0x06, 0xFF, 0xFF, 0xD0, 0x00, 0x00, 0x8F, 0xFF, 0xFC, 0x00, 0x00, 0x0E, 0xFF, 0xFF, 0x50, 0x00,
+  0x06, 0xFF, 0xFF, 0xD0, 0x00, 0x00, 0x8F, 0xFF, 0xFC, 0x00, 0x00, 0x0E, 0xFF, 0xFF, 0x50, 0x00,
+  0x06, 0xFF, 0xFF, 0xD0, 0x00, 0x00, 0x8F, 0xFF, 0xFC, 0x00, 0x00, 0x0E, 0xFF, 0xFF, 0x50, 0x00,
+  0x06, 0xFF, 0xFF, 0xD0, 0x00, 0x00, 0x8F, 0xFF, 0xFC, 0x00, 0x00, 0x0E, 0xFF, 0xFF, 0x50, 0x00,
+  0x06, 0xFF, 0xFF, 0xD0, 0x00, 0x00, 0x8F, 0xFF, 0xFC, 0x00, 0x00, 0x0E, 0xFF, 0xFF, 0x50, 0x00,
+  0x06, 0xFF, 0xFF, 0xD0, 0x00, 0x00, 0x8F, 0xFF, 0xFC, 0x00, 0x00, 0x0E, 0xFF, 0xFF, 0x50, 0x00,
+  0x06, 0xFF, 0xFF, 0xD0, 0x00,
+};
+
+const AtlasGlyph font_large_glyphs[] PROGMEM = {
+  { 0, 0, 0, 0, 0, 10 },  // ' '
+  { 0, 0, 0, 0, 0, 0 },  // '!'
+  { 0, 0, 0, 0, 0, 0 },  // '"'
+  { 0, 0, 0, 0, 0, 0 },  // '#'
+  { 0, 0, 0, 0, 0, 0 },  // '$'
+  { 0, 0, 0, 0, 0, 0 },  // '%'
+  { 0, 0, 0, 0, 0, 0 },  // '&'
+  { 0, 0, 0, 0, 0, 0 },  // '''
+  { 0, 0, 0, 0, 0, 0 },  // '('
+  { 0, 0, 0, 0, 0, 0 },  // ')'
+  { 0, 0, 0, 0, 0, 0 },  // '*'
+  { 0, 0, 0, 0, 0, 0 },  // '+'
+  { 0, 0, 0, 0, 0, 0 },  // ','
+  { 0, 0, 0, 0, 0, 0 },  // '-'
+  { 0, 11, 6, 0, -6, 11 },  // '.'
+  { 0, 0, 0, 0, 0, 0 },  // '/'
+  { 36, 21, 22, 0, -22, 21 },  // '0'
+  { 278, 21, 22, 0, -22, 21 },  // '1'
+  { 520, 21, 22, 0, -22, 21 },  // '2'
+  { 762, 21, 22, 0, -22, 21 },  // '3'
+  { 1004, 21, 22, 0, -22, 21 },  // '4'
+  { 1246, 21, 22, 0, -22, 21 },  // '5'
+  { 1488, 21, 22, 0, -22, 21 },  // '6'
+  { 1730, 21, 22, 0, -22, 21 },  // '7'
+  { 1972, 21, 22, 0, -22, 21 },  // '8'
+  { 2214, 21, 22, 0, -22, 21 },  // '9'
+  { 0, 0, 0, 0, 0, 0 },  // ':'
+  { 0, 0, 0, 0, 0, 0 },  // ';'
+  { 0, 0, 0, 0, 0, 0 },  // '<'
+  { 0, 0, 0, 0, 0, 0 },  // '='
+  { 0, 0, 0, 0, 0, 0 },  // '>'
+  { 0, 0, 0, 0, 0, 0 },  // '?'
+  { 0, 0, 0, 0, 0, 0 },  // '@'
+  { 0, 0, 0, 0, 0, 0 },  // 'A'
+  { 0, 0, 0, 0, 0, 0 },  // 'B'
+  { 0, 0, 0, 0, 0, 0 },  // 'C'
+  { 0, 0, 0, 0, 0, 0 },  // 'D'
+  { 0, 0, 0, 0, 0, 0 },  // 'E'
+  { 0, 0, 0, 0, 0, 0 },  // 'F'
+  { 0, 0, 0, 0, 0, 0 },  // 'G'
+  { 0, 0, 0, 0, 0, 0 },  // 'H'
+  { 0, 0, 0, 0, 0, 0 },  // 'I'
+  { 0, 0, 0, 0, 0, 0 },  // 'J'
+  { 0, 0, 0, 0, 0, 0 },  // 'K'
+  { 0, 0, 0, 0, 0, 0 },  // 'L'
+  { 0, 0, 0, 0, 0, 0 },  // 'M'
+  { 0, 0, 0, 0, 0, 0 },  // 'N'
+  { 0, 0, 0, 0, 0, 0 },  // 'O'
+  { 0, 0, 0, 0, 0, 0 },  // 'P'
+  { 0, 0, 0, 0, 0, 0 },  // 'Q'
+  { 0, 0, 0, 0, 0, 0 },  // 'R'
+  { 0, 0, 0, 0, 0, 0 },  // 'S'
+  { 0, 0, 0, 0, 0, 0 },  // 'T'
+  { 0, 0, 0, 0, 0, 0 },  // 'U'
+  { 0, 0, 0, 0, 0, 0 },  // 'V'
+  { 0, 0, 0, 0, 0, 0 },  // 'W'
+  { 0, 0, 0, 0, 0, 0 },  // 'X'
+  { 0, 0, 0, 0, 0, 0 },  // 'Y'
+  { 0, 0, 0, 0, 0, 0 },  // 'Z'
+  { 0, 0, 0, 0, 0, 0 },  // '['
+  { 0, 0, 0, 0, 0, 0 },  // 'backslash'
+  { 0, 0, 0, 0, 0, 0 },  // ']'
+  { 0, 0, 0, 0, 0, 0 },  // '^'
+  { 0, 0, 0, 0, 0, 0 },  // '_'
+  { 0, 0, 0, 0, 0, 0 },  // '`'
+  { 0, 0, 0, 0, 0, 0 },  // 'a'
+  { 0, 0, 0, 0, 0, 0 },  // 'b'
+  { 0, 0, 0, 0, 0, 0 },  // 'c'
+  { 0, 0, 0, 0, 0, 0 },  // 'd'
+  { 0, 0, 0, 0, 0, 0 },  // 'e'
+  { 0, 0, 0, 0, 0, 0 },  // 'f'
+  { 0, 0, 0, 0, 0, 0 },  // 'g'
+  { 0, 0, 0, 0, 0, 0 },  // 'h'
+  { 0, 0, 0, 0, 0, 0 },  // 'i'
+  { 0, 0, 0, 0, 0, 0 },  // 'j'
+  { 2456, 21, 23, 0, -23, 20 },  // 'k'
+  { 0, 0, 0, 0, 0, 0 },  // 'l'
+  { 2709, 31, 16, 0, -16, 31 },  // 'm'
+};
+
+const AtlasFont font_large = {
+  font_large_bitmap, font_large_glyphs, 0x20, 0x6D, -23, 23
+};
+
+#endif // FONT_ATLAS_H
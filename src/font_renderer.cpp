@@ -0,0 +1,109 @@
+#include "font_renderer.h"
+
+FontRenderer::FontRenderer() {
+    for (int i = 0; i < FONT_WIDTH_CACHE_SIZE; i++) {
+        width_cache[i].font = nullptr;
+        width_cache[i].hash = 0;
+        width_cache[i].width = 0;
+    }
+
+    stats.glyphs_rendered = 0;
+    stats.width_cache_hits = 0;
+    stats.width_cache_misses = 0;
+}
+
+uint32_t FontRenderer::hashText(const char* text) {
+    uint32_t hash = 2166136261u;
+    while (*text) {
+        hash ^= (uint8_t)*text++;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+bool FontRenderer::readGlyph(const AtlasFont& font, char c, AtlasGlyph& glyph) const {
+    uint8_t code = (uint8_t)c;
+    if (code < font.first || code > font.last) {
+        return false;
+    }
+    memcpy_P(&glyph, &font.glyphs[code - font.first], sizeof(AtlasGlyph));
+    return glyph.advance > 0;
+}
+
+uint16_t FontRenderer::measure(const AtlasFont& font, const char* text) {
+    uint32_t hash = hashText(text);
+    WidthCacheEntry& entry = width_cache[hash % FONT_WIDTH_CACHE_SIZE];
+
+    if (entry.font == &font && entry.hash == hash) {
+        stats.width_cache_hits++;
+        return entry.width;
+    }
+    stats.width_cache_misses++;
+
+    // Larghezza = somma avanzamenti, ma l'ultimo glifo può sporgere oltre l'advance
+    int16_t cursor = 0;
+    int16_t right = 0;
+    AtlasGlyph glyph;
+    for (const char* p = text; *p; p++) {
+        if (!readGlyph(font, *p, glyph)) continue;
+        int16_t glyph_right = cursor + glyph.x_off + glyph.width;
+        if (glyph_right > right) right = glyph_right;
+        cursor += glyph.advance;
+    }
+    if (cursor > right) right = cursor;
+
+    entry.font = &font;
+    entry.hash = hash;
+    entry.width = (uint16_t)right;
+    return entry.width;
+}
+
+void FontRenderer::render(const AtlasFont& font, const char* text, uint16_t color,
+                          uint16_t* band, int16_t band_width,
+                          int16_t row_start, int16_t row_count, int16_t x) {
+    int16_t cursor = x;
+    AtlasGlyph glyph;
+
+    for (const char* p = text; *p; p++) {
+        if (!readGlyph(font, *p, glyph)) continue;
+
+        // Riga del box testo in cui inizia il glifo
+        int16_t glyph_top = glyph.y_off - font.ink_top;
+        int16_t y0 = max(glyph_top, row_start);
+        int16_t y1 = min((int16_t)(glyph_top + glyph.height), (int16_t)(row_start + row_count));
+        int16_t gx0 = cursor + glyph.x_off;
+        const uint8_t stride = (glyph.width + 1) / 2;
+
+        for (int16_t y = y0; y < y1; y++) {
+            const uint8_t* src = font.bitmap + glyph.offset + (y - glyph_top) * stride;
+            uint16_t* dst = band + (y - row_start) * band_width;
+
+            for (uint8_t gx = 0; gx < glyph.width; gx++) {
+                int16_t bx = gx0 + gx;
+                if (bx < 0 || bx >= band_width) continue;
+
+                uint8_t packed = pgm_read_byte(&src[gx >> 1]);
+                uint8_t alpha4 = (gx & 1) ? (packed & 0x0F) : (packed >> 4);
+                if (alpha4 == 0) continue;
+
+                dst[bx] = (alpha4 == 15) ? color : blend565(color, dst[bx], alpha4 * 17);
+            }
+        }
+
+        cursor += glyph.advance;
+        stats.glyphs_rendered++;
+    }
+}
+
+uint16_t FontRenderer::blend565(uint16_t fg, uint16_t bg, uint8_t alpha) {
+    // Rosso e blu insieme (campi separati da 6 bit di guardia), verde a parte
+    uint32_t rb = bg & 0xF81F;
+    rb += ((uint32_t)(fg & 0xF81F) - rb) * (alpha >> 2) >> 6;
+    uint32_t g = bg & 0x07E0;
+    g += ((uint32_t)(fg & 0x07E0) - g) * alpha >> 8;
+    return (rb & 0xF81F) | (g & 0x07E0);
+}
+
+FontRenderer::Stats FontRenderer::getStats() const {
+    return stats;
+}
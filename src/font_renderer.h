@@ -0,0 +1,99 @@
+#ifndef FONT_RENDERER_H
+#define FONT_RENDERER_H
+
+#include <Arduino.h>
+#include "config.h"
+
+/**
+ * Glifo di un font atlas (alpha 4-bit, 2 pixel per byte)
+ * Generato da convert_assets.py in font_atlas.h
+ */
+struct AtlasGlyph {
+    uint16_t offset;     // Offset nel bitmap del font (bytes)
+    uint8_t width;       // Larghezza box glifo (pixel)
+    uint8_t height;      // Altezza box glifo (pixel)
+    int8_t x_off;        // Offset orizzontale dal cursore
+    int8_t y_off;        // Offset verticale dalla baseline (negativo = sopra)
+    uint8_t advance;     // Avanzamento cursore dopo il glifo
+};
+
+/**
+ * Font atlas: intervallo contiguo di caratteri [first, last]
+ * I caratteri non inclusi hanno glifo vuoto (width = 0, advance = 0)
+ */
+struct AtlasFont {
+    const uint8_t* bitmap;
+    const AtlasGlyph* glyphs;
+    uint8_t first;
+    uint8_t last;
+    int8_t ink_top;      // Riga più alta tra tutti i glifi, relativa alla baseline
+    uint8_t height;      // Altezza box testo (righe effettivamente renderizzate)
+};
+
+/**
+ * Renderer testo anti-aliased da font atlas
+ * Compone i glifi in un buffer RGB565 (band buffer) fornito dal chiamante,
+ * così una stringa viene inviata al display con un'unica finestra SPI.
+ * Le larghezze delle stringhe sono in cache (le stesse stringhe vengono
+ * centrate ad ogni redraw).
+ */
+class FontRenderer {
+public:
+    FontRenderer();
+
+    /**
+     * Larghezza in pixel di una stringa (con cache)
+     */
+    uint16_t measure(const AtlasFont& font, const char* text);
+
+    /**
+     * Compone una stringa nel band buffer, miscelando i glifi con i pixel già presenti
+     * @param band Buffer RGB565 (band_width pixel per riga), già riempito con lo sfondo
+     * @param band_width Larghezza del buffer in pixel
+     * @param row_start Prima riga del box testo contenuta nel buffer
+     * @param row_count Numero di righe nel buffer
+     * @param x Posizione orizzontale del cursore nel buffer
+     */
+    void render(const AtlasFont& font, const char* text, uint16_t color,
+                uint16_t* band, int16_t band_width,
+                int16_t row_start, int16_t row_count, int16_t x = 0);
+
+    /**
+     * Miscela due colori RGB565
+     * @param alpha 0 = solo bg, 255 = solo fg
+     */
+    static uint16_t blend565(uint16_t fg, uint16_t bg, uint8_t alpha);
+
+    /**
+     * Statistiche
+     */
+    struct Stats {
+        unsigned long glyphs_rendered;
+        unsigned long width_cache_hits;
+        unsigned long width_cache_misses;
+    };
+    Stats getStats() const;
+
+private:
+    // Cache larghezze (direct-mapped, indicizzata per hash della stringa)
+    struct WidthCacheEntry {
+        const AtlasFont* font;
+        uint32_t hash;
+        uint16_t width;
+    };
+    WidthCacheEntry width_cache[FONT_WIDTH_CACHE_SIZE];
+
+    Stats stats;
+
+    /**
+     * Legge glifo da PROGMEM, ritorna false se carattere non nel font
+     */
+    bool readGlyph(const AtlasFont& font, char c, AtlasGlyph& glyph) const;
+
+    /**
+     * Hash FNV-1a della stringa
+     */
+    static uint32_t hashText(const char* text);
+};
+
+#endif // FONT_RENDERER_H
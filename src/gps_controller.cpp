@@ -1,4 +1,7 @@
 #include "gps_controller.h"
+#include "arena_json.h"
+#include "trace.h"
+#include "log.h"
 
 GPSController::GPSController() : 
     gps_serial(nullptr),
@@ -17,19 +20,18 @@ GPSController::GPSController() :
 }
 
 GPSController::~GPSController() {
+    // Memoria nell'arena GPS (statica): solo distruzione, nessun rilascio
     if (gps_serial) {
         gps_serial->end();
-        delete gps_serial;
-    }
-    if (fake_route) {
-        delete[] fake_route;
+        gps_serial->~HardwareSerial();
     }
 }
 
 bool GPSController::begin(int rx_pin, int tx_pin) {
     // Crea seriale hardware per GPS
     // ESP32-C3 ha più UART, usiamo UART1 per GPS
-    gps_serial = new HardwareSerial(1);
+    void* serial_memory = arena_get(ARENA_GPS).allocate(sizeof(HardwareSerial), alignof(HardwareSerial));
+    gps_serial = serial_memory ? new (serial_memory) HardwareSerial(1) : nullptr;
     
     if (!gps_serial) {
         status = GPS_ERROR;
@@ -41,22 +43,14 @@ bool GPSController::begin(int rx_pin, int tx_pin) {
     
     status = GPS_CONNECTING;
     
-    #ifdef DEBUG_ENABLED
-    if (DEBUG_ENABLED) {
-        Serial.println("[GPS] Controller inizializzato");
-        Serial.print("[GPS] RX Pin: ");
-        Serial.println(rx_pin);
-        if (tx_pin >= 0) {
-            Serial.print("[GPS] TX Pin: ");
-            Serial.println(tx_pin);
-        }
-    }
-    #endif
+    LOG_I(GPS, "Controller inizializzato (RX pin %d, TX pin %d)", rx_pin, tx_pin);
     
     return true;
 }
 
 void GPSController::update() {
+    TRACE_SCOPE(TRACE_GPS_UPDATE);
+    
     // Modalità fake: aggiorna posizione da percorso fake
     if (fake_mode) {
         updateFakePosition();
@@ -84,16 +78,14 @@ void GPSController::update() {
     if (status == GPS_CONNECTING) {
         if (millis() > 5000) {  // Dopo 5 secondi considera connesso
             status = GPS_CONNECTED;
-            #ifdef DEBUG_ENABLED
-            if (DEBUG_ENABLED) {
-                Serial.println("[GPS] Connesso");
-            }
-            #endif
+            LOG_I(GPS, "Connesso");
         }
     }
 }
 
 void GPSController::updatePosition() {
+    TRACE_SCOPE(TRACE_GPS_UPDATE_POSITION);
+    
     // Aggiorna posizione dai dati TinyGPS++
     if (gps_parser.location.isValid()) {
         current_position.latitude = gps_parser.location.lat();
@@ -115,6 +107,13 @@ void GPSController::updatePosition() {
         current_position.course = gps_parser.course.deg();
     }
     
+    // Ora del fix: misura il tempo tra i fix senza il ritardo di ricezione e parsing
+    current_position.time_valid = gps_parser.time.isValid();
+    if (current_position.time_valid) {
+        current_position.time_ms = ((gps_parser.time.hour() * 60UL + gps_parser.time.minute()) * 60UL +
+                                    gps_parser.time.second()) * 1000UL + gps_parser.time.centisecond() * 10UL;
+    }
+    
     current_position.satellites = gps_parser.satellites.value();
     current_position.hdop = gps_parser.hdop.hdop();
     current_position.last_update = millis();
@@ -138,15 +137,8 @@ void GPSController::updateStatus() {
             if (status != GPS_FIXED) {
                 status = GPS_FIXED;
                 stats.last_fix_time = millis();
-                #ifdef DEBUG_ENABLED
-                if (DEBUG_ENABLED) {
-                    Serial.println("[GPS] Fix ottenuto!");
-                    Serial.print("[GPS] Satelliti: ");
-                    Serial.println(current_position.satellites);
-                    Serial.print("[GPS] HDOP: ");
-                    Serial.println(current_position.hdop);
-                }
-                #endif
+                LOG_I(GPS, "Fix ottenuto! Satelliti: %u, HDOP: %.2f",
+                      current_position.satellites, current_position.hdop);
             }
         } else {
             status = GPS_FIXING;
@@ -169,34 +161,20 @@ GPSStatus GPSController::getStatus() const {
 bool GPSController::waitForFix(unsigned long timeout_ms) {
     unsigned long start_time = millis();
     
-    #ifdef DEBUG_ENABLED
-    if (DEBUG_ENABLED) {
-        Serial.print("[GPS] Attesa fix (timeout: ");
-        Serial.print(timeout_ms);
-        Serial.println("ms)...");
-    }
-    #endif
+    LOG_I(GPS, "Attesa fix (timeout: %lums)...", timeout_ms);
     
     while (millis() - start_time < timeout_ms) {
         update();
         
         if (hasFix()) {
-            #ifdef DEBUG_ENABLED
-            if (DEBUG_ENABLED) {
-                Serial.println("[GPS] Fix ottenuto!");
-            }
-            #endif
+            LOG_I(GPS, "Fix ottenuto!");
             return true;
         }
         
         delay(100);
     }
     
-    #ifdef DEBUG_ENABLED
-    if (DEBUG_ENABLED) {
-        Serial.println("[GPS] Timeout attesa fix");
-    }
-    #endif
+    LOG_W(GPS, "Timeout attesa fix");
     
     return false;
 }
@@ -209,25 +187,22 @@ GPSController::Stats GPSController::getStats() const {
     return stats;
 }
 
+void GPSController::resetStats() {
+    stats.sentences_received = 0;
+    stats.valid_sentences = 0;
+    stats.fix_attempts = 0;
+}
+
 bool GPSController::beginFake(const char* json_path) {
     fake_mode = true;
     status = GPS_CONNECTING;
     
-    #ifdef DEBUG_ENABLED
-    if (DEBUG_ENABLED) {
-        Serial.println("[GPS] Modalità FAKE abilitata");
-        Serial.print("[GPS] Caricamento percorso da: ");
-        Serial.println(json_path);
-    }
-    #endif
+    LOG_I(GPS, "Modalità FAKE abilitata");
+    LOG_I(GPS, "Caricamento percorso da: %s", json_path);
     
     if (!loadFakeRoute(json_path)) {
         status = GPS_ERROR;
-        #ifdef DEBUG_ENABLED
-        if (DEBUG_ENABLED) {
-            Serial.println("[GPS] ERRORE: Impossibile caricare percorso fake");
-        }
-        #endif
+        LOG_E(GPS, "Impossibile caricare percorso fake");
         return false;
     }
     
@@ -238,15 +213,8 @@ bool GPSController::beginFake(const char* json_path) {
     
     status = GPS_FIXED;
     
-    #ifdef DEBUG_ENABLED
-    if (DEBUG_ENABLED) {
-        Serial.print("[GPS] Percorso fake caricato: ");
-        Serial.print(fake_route_count);
-        Serial.println(" punti");
-        Serial.print("[GPS] Loop: ");
-        Serial.println(fake_route_loop ? "abilitato" : "disabilitato");
-    }
-    #endif
+    LOG_I(GPS, "Percorso fake caricato: %d punti (loop %s)",
+          fake_route_count, fake_route_loop ? "abilitato" : "disabilitato");
     
     return true;
 }
@@ -255,43 +223,28 @@ bool GPSController::loadFakeRoute(const char* json_path) {
     // Monta LittleFS con gli stessi parametri usati in json_parser
     // Specifica esplicitamente il nome della partizione "littlefs"
     if (!LittleFS.begin(false, "/littlefs", 5, "littlefs")) {
-        #ifdef DEBUG_ENABLED
-        if (DEBUG_ENABLED) {
-            Serial.println("[GPS] LittleFS non montato, tentativo di formattazione...");
-        }
-        #endif
+        LOG_W(GPS, "LittleFS non montato, tentativo di formattazione...");
         
         // Se il mount fallisce, formatta e rimontare (true = formatOnFail)
         if (!LittleFS.begin(true, "/littlefs", 5, "littlefs")) {
-            #ifdef DEBUG_ENABLED
-            if (DEBUG_ENABLED) {
-                Serial.println("[GPS] ERRORE: Impossibile montare LittleFS anche dopo formattazione");
-            }
-            #endif
+            LOG_E(GPS, "Impossibile montare LittleFS anche dopo formattazione");
             return false;
         }
         
-        #ifdef DEBUG_ENABLED
-        if (DEBUG_ENABLED) {
-            Serial.println("[GPS] LittleFS formattato e montato con successo");
-        }
-        #endif
+        LOG_I(GPS, "LittleFS formattato e montato con successo");
     }
     
     File file = LittleFS.open(json_path, "r");
     if (!file) {
-        #ifdef DEBUG_ENABLED
-        if (DEBUG_ENABLED) {
-            Serial.print("[GPS] ERRORE: File non trovato: ");
-            Serial.println(json_path);
-        }
-        #endif
+        LOG_E(GPS, "File non trovato: %s", json_path);
         return false;
     }
     
-    // Leggi file JSON
+    // Leggi file JSON (buffer e documento sull'arena scratch, rilasciata all'uscita)
+    Arena& scratch = arena_get(ARENA_SCRATCH);
+    ArenaScope scratch_scope(scratch);
     size_t file_size = file.size();
-    char* json_buffer = new char[file_size + 1];
+    char* json_buffer = (char*)scratch.allocate(file_size + 1, 1);
     if (!json_buffer) {
         file.close();
         return false;
@@ -302,49 +255,32 @@ bool GPSController::loadFakeRoute(const char* json_path) {
     file.close();
     
     // Parse JSON
-    DynamicJsonDocument doc(4096);
+    ArenaJsonAllocator allocator(scratch);
+    JsonDocument doc(&allocator);
     DeserializationError error = deserializeJson(doc, json_buffer);
-    delete[] json_buffer;
     
     if (error) {
-        #ifdef DEBUG_ENABLED
-        if (DEBUG_ENABLED) {
-            Serial.print("[GPS] ERRORE: Parsing JSON fallito: ");
-            Serial.println(error.c_str());
-        }
-        #endif
+        LOG_E(GPS, "Parsing JSON fallito: %s", error.c_str());
         return false;
     }
     
     // Leggi array route
     JsonArray route = doc["route"];
     if (!route) {
-        #ifdef DEBUG_ENABLED
-        if (DEBUG_ENABLED) {
-            Serial.println("[GPS] ERRORE: Campo 'route' non trovato");
-        }
-        #endif
+        LOG_E(GPS, "Campo 'route' non trovato");
         return false;
     }
     
     fake_route_count = route.size();
     if (fake_route_count == 0) {
-        #ifdef DEBUG_ENABLED
-        if (DEBUG_ENABLED) {
-            Serial.println("[GPS] ERRORE: Percorso vuoto");
-        }
-        #endif
+        LOG_E(GPS, "Percorso vuoto");
         return false;
     }
     
-    // Alloca array punti
-    fake_route = new FakeRoutePoint[fake_route_count];
+    // Alloca array punti (arena GPS)
+    fake_route = arena_get(ARENA_GPS).allocateArray<FakeRoutePoint>(fake_route_count);
     if (!fake_route) {
-        #ifdef DEBUG_ENABLED
-        if (DEBUG_ENABLED) {
-            Serial.println("[GPS] ERRORE: Memoria insufficiente");
-        }
-        #endif
+        LOG_E(GPS, "Memoria insufficiente");
         return false;
     }
     
@@ -392,20 +328,10 @@ void GPSController::updateFakePosition() {
     current_position.hdop = point.hdop;
     current_position.is_valid = true;
     current_position.last_update = current_time;
+    current_position.time_valid = false;  // Tempi dei fix da millis()
     
-    #ifdef DEBUG_ENABLED
-    if (DEBUG_ENABLED) {
-        Serial.print("[GPS] Posizione fake aggiornata: ");
-        Serial.print(point.lat, 6);
-        Serial.print(", ");
-        Serial.print(point.lng, 6);
-        Serial.print(" (punto ");
-        Serial.print(fake_route_index + 1);
-        Serial.print("/");
-        Serial.print(fake_route_count);
-        Serial.println(")");
-    }
-    #endif
+    LOG_D(GPS, "Posizione fake aggiornata: %.6f, %.6f (punto %d/%d)",
+          point.lat, point.lng, fake_route_index + 1, fake_route_count);
     
     // Passa al punto successivo
     fake_route_index++;
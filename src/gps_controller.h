@@ -21,6 +21,8 @@ struct GPSPosition {
     float hdop;           // Horizontal Dilution of Precision
     bool is_valid;
     unsigned long last_update;
+    uint32_t time_ms;     // Ora UTC del fix in ms dalla mezzanotte (se time_valid)
+    bool time_valid;
     
     GPSPosition() : 
         latitude(0.0), 
@@ -31,7 +33,9 @@ struct GPSPosition {
         satellites(0),
         hdop(0.0),
         is_valid(false),
-        last_update(0) {}
+        last_update(0),
+        time_ms(0),
+        time_valid(false) {}
 };
 
 /**
@@ -118,6 +122,11 @@ public:
         unsigned long last_fix_time;
     };
     Stats getStats() const;
+    
+    /**
+     * Reset statistiche (last_fix_time resta: è lo stato del fix, non un contatore)
+     */
+    void resetStats();
 
 private:
     HardwareSerial* gps_serial;
@@ -0,0 +1,24 @@
+#include "hal.h"
+
+#ifdef ESP32
+uint32_t hal_cycles() {
+    return ESP.getCycleCount();
+}
+
+uint32_t hal_cycles_per_us() {
+    return getCpuFrequencyMhz();
+}
+
+uint32_t hal_free_heap() {
+    return ESP.getFreeHeap();
+}
+
+uint32_t hal_min_free_heap() {
+    return ESP.getMinFreeHeap();
+}
+
+uint32_t hal_stack_free_min() {
+    // ESP-IDF: high-water mark in byte del task che chiama (loopTask per setup/loop)
+    return uxTaskGetStackHighWaterMark(nullptr);
+}
+#endif
@@ -0,0 +1,43 @@
+#ifndef HAL_H
+#define HAL_H
+
+#include <Arduino.h>
+
+/**
+ * Hardware abstraction layer
+ *
+ * I sorgenti in src/ usano l'API Arduino per seriali (Stream/HardwareSerial),
+ * filesystem (fs::FS/File su LittleFS) e display (Adafruit_GC9A01A): sul firmware
+ * la implementa il core Arduino-ESP32, nella build host le versioni POSIX in host/.
+ * Qui ci sono solo i servizi che l'API Arduino non copre in modo portabile:
+ * contatore di cicli e memoria heap.
+ *
+ * Implementazioni: src/hal.cpp (ESP32), host/hal_posix.cpp (host)
+ */
+
+/**
+ * Contatore cicli CPU (a 32 bit, va in overflow: usare differenze)
+ */
+uint32_t hal_cycles();
+
+/**
+ * Frequenza del contatore cicli in MHz (cicli per microsecondo)
+ */
+uint32_t hal_cycles_per_us();
+
+/**
+ * Heap libero in byte
+ */
+uint32_t hal_free_heap();
+
+/**
+ * Minimo heap libero dall'avvio (high-water mark dell'uso heap)
+ */
+uint32_t hal_min_free_heap();
+
+/**
+ * Minimo stack libero del task corrente dall'avvio in byte (0 = non disponibile)
+ */
+uint32_t hal_stack_free_min();
+
+#endif // HAL_H
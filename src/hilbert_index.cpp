@@ -0,0 +1,209 @@
+#include "hilbert_index.h"
+#include "utils.h"
+
+#define HILBERT_SIDE (1UL << HILBERT_BITS)
+// Celle del quadtree che coprono il cerchio (al più 6x6 con la dimensione minima scelta in hilbert_query)
+#define HILBERT_MAX_CELLS 64
+// Metri per grado di latitudine (EARTH_RADIUS_M di utils.cpp), con margine dell'1%
+#define HILBERT_METERS_PER_DEGREE (6371000.0 * M_PI / 180.0 / 1.01)
+
+static uint32_t quantize(double value, double min, double range) {
+    double q = (value - min) * (HILBERT_SIDE / range);
+    if (!(q > 0.0)) return 0;
+    if (q >= HILBERT_SIDE - 1) return HILBERT_SIDE - 1;
+    return (uint32_t)q;
+}
+
+static uint32_t key_xy(uint32_t x, uint32_t y) {
+    uint32_t key = 0;
+    for (uint32_t s = HILBERT_SIDE / 2; s > 0; s >>= 1) {
+        uint32_t rx = (x & s) ? 1 : 0;
+        uint32_t ry = (y & s) ? 1 : 0;
+        key += s * s * ((3 * rx) ^ ry);
+        // Rotazione del quadrante: contano solo i bit sotto s
+        if (ry == 0) {
+            if (rx == 1) {
+                x = (s - 1) - (x & (s - 1));
+                y = (s - 1) - (y & (s - 1));
+            }
+            uint32_t t = x;
+            x = y;
+            y = t;
+        }
+    }
+    return key;
+}
+
+uint32_t hilbert_key(float lat, float lng) {
+    return key_xy(quantize(lng, -180.0, 360.0), quantize(lat, -90.0, 180.0));
+}
+
+bool hilbert_is_sorted(const Speedcam* speedcams, int count) {
+    uint32_t previous = 0;
+    for (int i = 0; i < count; i++) {
+        uint32_t key = hilbert_key(speedcams[i].lat, speedcams[i].lng);
+        if (key < previous) return false;
+        previous = key;
+    }
+    return true;
+}
+
+// Heapsort: sul posto, senza ricorsione né allocazioni, O(n log n) anche nel caso peggiore
+static void sift_down(Speedcam* speedcams, int root, int count) {
+    uint32_t root_key = hilbert_key(speedcams[root].lat, speedcams[root].lng);
+    while (true) {
+        int child = 2 * root + 1;
+        if (child >= count) return;
+        uint32_t child_key = hilbert_key(speedcams[child].lat, speedcams[child].lng);
+        if (child + 1 < count) {
+            uint32_t right_key = hilbert_key(speedcams[child + 1].lat, speedcams[child + 1].lng);
+            if (right_key > child_key) {
+                child++;
+                child_key = right_key;
+            }
+        }
+        if (child_key <= root_key) return;
+        Speedcam t = speedcams[root];
+        speedcams[root] = speedcams[child];
+        speedcams[child] = t;
+        root = child;
+    }
+}
+
+void hilbert_sort(Speedcam* speedcams, int count) {
+    for (int i = count / 2 - 1; i >= 0; i--) {
+        sift_down(speedcams, i, count);
+    }
+    for (int end = count - 1; end > 0; end--) {
+        Speedcam t = speedcams[0];
+        speedcams[0] = speedcams[end];
+        speedcams[end] = t;
+        sift_down(speedcams, 0, end);
+    }
+}
+
+/**
+ * Primo indice con chiave >= key (count se nessuno)
+ */
+static int lower_bound(const Speedcam* speedcams, int count, uint32_t key) {
+    int lo = 0;
+    int hi = count;
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (hilbert_key(speedcams[mid].lat, speedcams[mid].lng) < key) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+/**
+ * Intervallo di chiavi [first, last] di una cella del quadtree
+ */
+struct KeyRange {
+    uint32_t first;
+    uint32_t last;
+};
+
+/**
+ * Copertura del riquadro [x0, x1] x [y0, y1] con celle allineate
+ */
+struct Cover {
+    uint32_t x0, x1, y0, y1;
+    uint32_t min_size;
+    KeyRange ranges[HILBERT_MAX_CELLS];
+    int count;
+};
+
+static void cover_cell(Cover& cover, uint32_t x, uint32_t y, uint32_t size) {
+    uint32_t x_last = x + (size - 1);
+    uint32_t y_last = y + (size - 1);
+    if (x > cover.x1 || x_last < cover.x0 || y > cover.y1 || y_last < cover.y0) {
+        return;
+    }
+    bool inside = x >= cover.x0 && x_last <= cover.x1 && y >= cover.y0 && y_last <= cover.y1;
+    if (inside || size <= cover.min_size) {
+        // Una cella allineata è percorsa dalla curva in un solo tratto
+        if (cover.count < HILBERT_MAX_CELLS) {
+            uint64_t area = (uint64_t)size * size;
+            uint32_t first = key_xy(x, y) & ~(uint32_t)(area - 1);
+            cover.ranges[cover.count].first = first;
+            cover.ranges[cover.count].last = first + (uint32_t)(area - 1);
+            cover.count++;
+        }
+        return;
+    }
+    uint32_t half = size / 2;
+    cover_cell(cover, x, y, half);
+    cover_cell(cover, x + half, y, half);
+    cover_cell(cover, x, y + half, half);
+    cover_cell(cover, x + half, y + half, half);
+}
+
+int hilbert_query(const Speedcam* speedcams, int count, double lat, double lng, float radius_m,
+                  HilbertSpan* spans) {
+    if (count <= 0) return 0;
+
+    // Riquadro del cerchio (senza attraversamento dell'antimeridiano)
+    double dlat = radius_m / HILBERT_METERS_PER_DEGREE;
+    double cos_lat = cos(deg_to_rad(min(fabs(lat) + dlat, 89.0)));
+    double dlng = dlat / cos_lat;
+
+    Cover cover;
+    cover.x0 = quantize(lng - dlng, -180.0, 360.0);
+    cover.x1 = quantize(lng + dlng, -180.0, 360.0);
+    cover.y0 = quantize(lat - dlat, -90.0, 180.0);
+    cover.y1 = quantize(lat + dlat, -90.0, 180.0);
+    cover.count = 0;
+
+    // Celle non più piccole di 1/4 del riquadro: al più 6 per lato
+    uint32_t extent = max(cover.x1 - cover.x0, cover.y1 - cover.y0) + 1;
+    cover.min_size = 1;
+    while (cover.min_size * 4 < extent) cover.min_size <<= 1;
+    cover_cell(cover, 0, 0, HILBERT_SIDE);
+
+    // Intervalli di chiavi in ordine, fusi se contigui
+    KeyRange* ranges = cover.ranges;
+    for (int i = 1; i < cover.count; i++) {
+        KeyRange r = ranges[i];
+        int j = i;
+        while (j > 0 && ranges[j - 1].first > r.first) {
+            ranges[j] = ranges[j - 1];
+            j--;
+        }
+        ranges[j] = r;
+    }
+    int merged = 0;
+    for (int i = 0; i < cover.count; i++) {
+        if (merged > 0 && (uint64_t)ranges[i].first <= (uint64_t)ranges[merged - 1].last + 1) {
+            if (ranges[i].last > ranges[merged - 1].last) ranges[merged - 1].last = ranges[i].last;
+        } else {
+            ranges[merged++] = ranges[i];
+        }
+    }
+
+    // Intervalli di indici: due ricerche binarie per intervallo di chiavi, ciascuna
+    // a partire dalla fine del precedente (gli intervalli sono in ordine)
+    int span_count = 0;
+    int from = 0;
+    for (int i = 0; i < merged && from < count; i++) {
+        int first = from + lower_bound(speedcams + from, count - from, ranges[i].first);
+        int end = ranges[i].last == 0xFFFFFFFF ? count :
+                  first + lower_bound(speedcams + first, count - first, ranges[i].last + 1);
+        from = end;
+        if (first >= end) continue;
+        if (span_count > 0 && spans[span_count - 1].end >= first) {
+            spans[span_count - 1].end = end;
+        } else if (span_count == HILBERT_MAX_SPANS) {
+            // Oltre il limite l'ultimo intervallo si allarga: più speedcam da verificare, nessuna persa
+            spans[span_count - 1].end = end;
+        } else {
+            spans[span_count].first = first;
+            spans[span_count].end = end;
+            span_count++;
+        }
+    }
+    return span_count;
+}
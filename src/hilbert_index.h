@@ -0,0 +1,55 @@
+#ifndef HILBERT_INDEX_H
+#define HILBERT_INDEX_H
+
+#include <Arduino.h>
+#include "speedcam.h"
+
+/**
+ * Ordinamento delle speedcam lungo una curva di Hilbert
+ *
+ * Lat/lng quantizzate a HILBERT_BITS bit per asse (~300 m in latitudine)
+ * danno una chiave a 32 bit: speedcam vicine hanno chiavi vicine, e ogni cella
+ * allineata del quadtree corrisponde a un intervallo contiguo di chiavi.
+ * Con l'array ordinato per chiave una ricerca per raggio diventa pochi
+ * intervalli di chiavi, ciascuno trovato con una ricerca binaria: nessuna
+ * memoria oltre all'array (la chiave si ricalcola dalle coordinate).
+ */
+
+#define HILBERT_BITS 16
+#define HILBERT_MAX_SPANS 16   // Intervalli di indici restituiti da hilbert_query
+
+/**
+ * Intervallo [first, end) di indici nell'array ordinato
+ */
+struct HilbertSpan {
+    int first;
+    int end;
+};
+
+/**
+ * Chiave di Hilbert della posizione (calcolata in double: stessa chiave di make_speedcam_db.py)
+ */
+uint32_t hilbert_key(float lat, float lng);
+
+/**
+ * Vero se l'array è già ordinato per chiave (es. compilato da make_speedcam_db.py)
+ */
+bool hilbert_is_sorted(const Speedcam* speedcams, int count);
+
+/**
+ * Ordina l'array per chiave, sul posto e senza allocazioni
+ */
+void hilbert_sort(Speedcam* speedcams, int count);
+
+/**
+ * Speedcam che possono essere entro radius_m dalla posizione (array ordinato)
+ * Il cerchio viene coperto da celle del quadtree, fuse in intervalli di chiavi
+ * e convertiti in intervalli di indici con ricerca binaria. Gli intervalli
+ * contengono anche speedcam fuori dal cerchio: la distanza va verificata.
+ * @param spans Array di almeno HILBERT_MAX_SPANS elementi
+ * @return Numero di intervalli (ordinati, disgiunti)
+ */
+int hilbert_query(const Speedcam* speedcams, int count, double lat, double lng, float radius_m,
+                  HilbertSpan* spans);
+
+#endif // HILBERT_INDEX_H
@@ -1,4 +1,8 @@
 #include "json_parser.h"
+#include "arena_json.h"
+#include "utils.h"
+#include "trace.h"
+#include "log.h"
 
 JSONParser::JSONParser() {
 }
@@ -14,207 +18,63 @@ bool JSONParser::isLittleFSMounted() {
     }
     
     // Se il mount fallisce, prova a formattare e rimontare
-    #ifdef DEBUG_ENABLED
-    if (DEBUG_ENABLED) {
-        Serial.println("[JSON] LittleFS non montato, tentativo di formattazione...");
-    }
-    #endif
+    LOG_W(JSON, "LittleFS non montato, tentativo di formattazione...");
     
     // Formatta e monta (true = formatOnFail)
     if (LittleFS.begin(true, "/littlefs", 5, "littlefs")) {
         return true;
     }
     
-    #ifdef DEBUG_ENABLED
-    if (DEBUG_ENABLED) {
-        Serial.println("[JSON] ERRORE: Impossibile montare LittleFS");
-    }
-    #endif
+    LOG_E(JSON, "Impossibile montare LittleFS");
     return false;
 }
 
-int JSONParser::loadFromFile(const char* filename, Speedcam* speedcams, int max_count) {
-    // Specifica esplicitamente il nome della partizione "littlefs"
-    // Primo tentativo: monta senza formattare
-    if (!LittleFS.begin(false, "/littlefs", 5, "littlefs")) {
-        #ifdef DEBUG_ENABLED
-        if (DEBUG_ENABLED) {
-            Serial.println("[JSON] LittleFS non montato, tentativo di formattazione...");
-        }
-        #endif
-        
-        // Se il mount fallisce, formatta e rimontare (true = formatOnFail)
-        if (!LittleFS.begin(true, "/littlefs", 5, "littlefs")) {
-            #ifdef DEBUG_ENABLED
-            if (DEBUG_ENABLED) {
-                Serial.println("[JSON] ERRORE: Impossibile montare LittleFS anche dopo formattazione");
-                Serial.println("[JSON] Verifica che la partizione 'littlefs' sia presente nella tabella partizioni");
-            }
-            #endif
-            return -1;
-        }
-        
-        #ifdef DEBUG_ENABLED
-        if (DEBUG_ENABLED) {
-            Serial.println("[JSON] LittleFS formattato e montato con successo");
-        }
-        #endif
+int JSONParser::scanFile(const char* filename, RecordCallback callback, void* ctx,
+                         SpeedcamLoadStats* stats) {
+    TRACE_SCOPE(TRACE_JSON_LOAD_FILE);
+    
+    if (!isLittleFSMounted()) {
+        LOG_E(JSON, "Verifica che la partizione 'littlefs' sia presente nella tabella partizioni");
+        return -1;
     }
     
     File file = LittleFS.open(filename, "r");
     if (!file) {
-        #ifdef DEBUG_ENABLED
-        if (DEBUG_ENABLED) {
-            Serial.print("[JSON] File non trovato: ");
-            Serial.println(filename);
-        }
-        #endif
+        LOG_E(JSON, "File non trovato: %s", filename);
         return -1;
     }
     
-    // Leggi file in buffer (streaming per file grandi)
-    // Per file molto grandi, usiamo streaming parser
-    size_t file_size = file.size();
-    
-    #ifdef DEBUG_ENABLED
-    if (DEBUG_ENABLED) {
-        Serial.print("[JSON] Dimensione file: ");
-        Serial.print(file_size);
-        Serial.println(" bytes");
-    }
-    #endif
-    
-    // Alloca buffer per JSON (limite memoria)
-    // Per file grandi, usiamo streaming
-    const size_t buffer_size = min((size_t)8192, file_size);
-    char* buffer = (char*)malloc(buffer_size + 1);
-    
-    if (!buffer) {
-        file.close();
-        return -1;
+    LOG_D(JSON, "Dimensione file: %u bytes", (unsigned int)file.size());
+    if (stats) {
+        stats->file_size = file.size();
     }
     
-    // Per file molto grandi, usiamo approccio streaming
-    // Per ora, leggiamo tutto il file (se possibile)
-    int loaded_count = 0;
-    
-    if (file_size <= buffer_size) {
-        // File piccolo, leggilo tutto
-        file.readBytes(buffer, file_size);
-        buffer[file_size] = '\0';
-        
-        loaded_count = loadFromString(buffer, speedcams, max_count);
-    } else {
-        // File grande: usa parser streaming incrementale
-        // Processa il JSON carattere per carattere senza caricare tutto in memoria
-        #ifdef DEBUG_ENABLED
-        if (DEBUG_ENABLED) {
-            Serial.println("[JSON] File grande, uso parser streaming incrementale");
-        }
-        #endif
-        
-        // Usa ArduinoJson streaming con documento più grande per array
-        // Calcola dimensione documento basata su max_count speedcam
-        // Ogni speedcam richiede ~200-300 bytes nel documento JSON
-        const size_t doc_size = min((size_t)65536, (size_t)(max_count * 300));
-        
-        #ifdef DEBUG_ENABLED
-        if (DEBUG_ENABLED) {
-            Serial.print("[JSON] Dimensione documento streaming: ");
-            Serial.print(doc_size);
-            Serial.println(" bytes");
-        }
-        #endif
-        
-        // Riavvia il file dall'inizio
-        file.seek(0);
-        
-        // Usa JsonStreamingParser o deserializeJson con stream
-        // ArduinoJson v7 supporta streaming nativo
-        DynamicJsonDocument doc(doc_size);
-        
-        // Configura per ignorare overflow (processa solo quello che può)
-        DeserializationError error = deserializeJson(doc, file);
-        
-        if (error && error.code() != DeserializationError::Ok) {
-            #ifdef DEBUG_ENABLED
-            if (DEBUG_ENABLED) {
-                Serial.print("[JSON] Errore parsing: ");
-                Serial.println(error.c_str());
-                if (error.code() == DeserializationError::NoMemory) {
-                    Serial.println("[JSON] Memoria insufficiente, provo con parser incrementale...");
-                }
-            }
-            #endif
-            
-            // Se errore di memoria, prova parser incrementale manuale
-            if (error.code() == DeserializationError::NoMemory) {
-                free(buffer);
-                file.seek(0);
-                loaded_count = loadFromFileIncremental(file, speedcams, max_count);
-                file.close();
-                return loaded_count;
-            }
-            
-            free(buffer);
-            file.close();
-            return -1;
-        }
-        
-        JsonArray result = doc["result"];
-        if (!result) {
-            free(buffer);
-            file.close();
-            return -1;
-        }
-        
-        for (JsonObject obj : result) {
-            if (loaded_count >= max_count) break;
-            
-            if (parseSpeedcam(obj, speedcams[loaded_count])) {
-                loaded_count++;
-            }
-        }
-    }
-    
-    free(buffer);
+    // Un oggetto alla volta anche per file piccoli: memoria costante (buffer
+    // oggetto + documento del record sull'arena scratch) e stessi conteggi
+    // in ogni passaggio
+    int valid_count = scanIncremental(file, callback, ctx, stats);
     file.close();
     
-    #ifdef DEBUG_ENABLED
-    if (DEBUG_ENABLED) {
-        Serial.print("[JSON] Speedcam caricate: ");
-        Serial.println(loaded_count);
-    }
-    #endif
-    
-    return loaded_count;
+    return valid_count;
 }
 
 int JSONParser::loadFromString(const char* json_string, Speedcam* speedcams, int max_count) {
-    // Usa DynamicJsonDocument per parsing
-    // Dimensione basata su dimensione stringa (max 32KB per sicurezza)
-    const size_t doc_size = min((size_t)32768, (size_t)(strlen(json_string) * 1.2));
-    DynamicJsonDocument doc(doc_size);
+    // Documento sull'arena scratch (limite: la sua capacità libera)
+    Arena& scratch = arena_get(ARENA_SCRATCH);
+    ArenaScope scratch_scope(scratch);
+    ArenaJsonAllocator allocator(scratch);
+    JsonDocument doc(&allocator);
     
     DeserializationError error = deserializeJson(doc, json_string);
     
     if (error) {
-        #ifdef DEBUG_ENABLED
-        if (DEBUG_ENABLED) {
-            Serial.print("[JSON] Errore parsing: ");
-            Serial.println(error.c_str());
-        }
-        #endif
+        LOG_E(JSON, "Parsing fallito: %s", error.c_str());
         return -1;
     }
     
     JsonArray result = doc["result"];
     if (!result) {
-        #ifdef DEBUG_ENABLED
-        if (DEBUG_ENABLED) {
-            Serial.println("[JSON] Campo 'result' non trovato");
-        }
-        #endif
+        LOG_E(JSON, "Campo 'result' non trovato");
         return -1;
     }
     
@@ -222,12 +82,7 @@ int JSONParser::loadFromString(const char* json_string, Speedcam* speedcams, int
     
     for (JsonObject obj : result) {
         if (loaded_count >= max_count) {
-            #ifdef DEBUG_ENABLED
-            if (DEBUG_ENABLED) {
-                Serial.print("[JSON] Raggiunto limite massimo speedcam: ");
-                Serial.println(max_count);
-            }
-            #endif
+            LOG_W(JSON, "Raggiunto limite massimo speedcam: %d", max_count);
             break;
         }
         
@@ -252,15 +107,25 @@ bool JSONParser::parseSpeedcam(JsonObject obj, Speedcam& speedcam) {
     } else {
         return false;  // Coordinate obbligatorie
     }
+    if (!speedcam_position_valid(speedcam.lat, speedcam.lng)) {
+        return false;  // Scartata qui: la rilevazione non ricontrolla le coordinate
+    }
     
     // Tipo
     if (obj.containsKey("type")) {
         safeStringCopy(speedcam.type, obj["type"].as<const char*>(), 4);
     }
     
-    // Velocità massima
+    // Velocità massima: numero o testo ("50", "/"), in km/h una volta sola
+    speedcam.vmax = 0;
     if (obj.containsKey("vmax")) {
-        safeStringCopy(speedcam.vmax, obj["vmax"].as<const char*>(), 4);
+        JsonVariant vmax = obj["vmax"];
+        if (vmax.is<int>()) {
+            int value = vmax.as<int>();
+            speedcam.vmax = value > 0 && value <= SPEEDCAM_VMAX_MAX ? (uint16_t)value : 0;
+        } else {
+            speedcam.vmax = speedcam_parse_vmax(vmax.as<const char*>());
+        }
     }
     
     // Status
@@ -279,27 +144,19 @@ bool JSONParser::parseSpeedcam(JsonObject obj, Speedcam& speedcam) {
         }
     }
     
-    return true;
-}
-
-int JSONParser::filterByBoundingBox(Speedcam* speedcams, int count, 
-                                   float min_lat, float max_lat, 
-                                   float min_lng, float max_lng) {
-    int filtered_count = 0;
-    
-    for (int i = 0; i < count; i++) {
-        if (speedcams[i].lat >= min_lat && speedcams[i].lat <= max_lat &&
-            speedcams[i].lng >= min_lng && speedcams[i].lng <= max_lng) {
-            
-            // Sposta speedcam valida all'inizio
-            if (filtered_count != i) {
-                speedcams[filtered_count] = speedcams[i];
-            }
-            filtered_count++;
+    // Direzione controllata (opzionale): gradi, "bidirectional" anche l'opposta
+    speedcam.heading = 0;
+    speedcam.direction = SPEEDCAM_DIRECTION_ANY;
+    JsonVariant heading = obj["heading"];
+    if (heading.is<float>()) {
+        float degrees = heading.as<float>();
+        if (is_valid_float(degrees)) {
+            speedcam.heading = heading_to_binary(degrees);
+            speedcam.direction = obj["bidirectional"].as<bool>() ? SPEEDCAM_DIRECTION_BOTH : SPEEDCAM_DIRECTION_ONE;
         }
     }
     
-    return filtered_count;
+    return true;
 }
 
 void JSONParser::safeStringCopy(char* dest, const char* src, size_t max_len) {
@@ -314,45 +171,51 @@ void JSONParser::safeStringCopy(char* dest, const char* src, size_t max_len) {
     dest[len] = '\0';
 }
 
-int JSONParser::loadFromFileIncremental(File& file, Speedcam* speedcams, int max_count) {
+int JSONParser::scanIncremental(File& file, RecordCallback callback, void* ctx,
+                                SpeedcamLoadStats* stats) {
     // Parser incrementale: estrae ogni oggetto speedcam e lo parsa individualmente
     // Questo evita di dover caricare tutto il JSON in memoria
     
-    int loaded_count = 0;
+    int valid_count = 0;
+    uint32_t records = 0;
     bool found_result_array = false;
     int brace_depth = 0;
     int bracket_depth = 0;
     bool in_string = false;
     bool escape_next = false;
     
-    // Buffer per oggetto JSON corrente (max 512 bytes per oggetto)
+    // Buffer per oggetto JSON corrente (max 512 bytes per oggetto), sull'arena scratch
+    Arena& scratch = arena_get(ARENA_SCRATCH);
+    ArenaScope scratch_scope(scratch);
     const size_t obj_buffer_size = 512;
-    char* obj_buffer = (char*)malloc(obj_buffer_size);
+    char* obj_buffer = (char*)scratch.allocate(obj_buffer_size, 1);
     if (!obj_buffer) {
-        #ifdef DEBUG_ENABLED
-        if (DEBUG_ENABLED) {
-            Serial.println("[JSON] ERRORE: Memoria insufficiente per buffer oggetto");
-        }
-        #endif
+        LOG_E(JSON, "Memoria insufficiente per buffer oggetto");
         return -1;
     }
     
-    int obj_pos = 0;
+    size_t obj_pos = 0;
     bool in_object = false;
+    bool obj_truncated = false;
+    
+    // Accoda un carattere all'oggetto corrente (oltre il buffer l'oggetto è scartato)
+    auto append = [&](char c) {
+        if (!in_object) return;
+        if (obj_pos < obj_buffer_size - 1) {
+            obj_buffer[obj_pos++] = c;
+        } else {
+            obj_truncated = true;
+        }
+    };
     
     // Cerca l'array "result"
-    String search_buffer = "";
     const char* result_key = "\"result\"";
-    int result_key_pos = 0;
+    size_t result_key_pos = 0;
     
-    #ifdef DEBUG_ENABLED
-    if (DEBUG_ENABLED) {
-        Serial.println("[JSON] Parser incrementale: ricerca array 'result'...");
-    }
-    #endif
+    LOG_D(JSON, "Parser incrementale: ricerca array 'result'...");
     
     // Leggi file carattere per carattere
-    while (file.available() && loaded_count < max_count) {
+    while (file.available()) {
         char c = file.read();
         
         // Cerca "result" prima di iniziare a parsare
@@ -367,11 +230,7 @@ int JSONParser::loadFromFileIncremental(File& file, Speedcam* speedcams, int max
                         char next_c = file.read();
                         if (next_c == '[') {
                             found_result_array = true;
-                            #ifdef DEBUG_ENABLED
-                            if (DEBUG_ENABLED) {
-                                Serial.println("[JSON] Array 'result' trovato, inizio parsing oggetti...");
-                            }
-                            #endif
+                            LOG_D(JSON, "Array 'result' trovato, inizio parsing oggetti...");
                             break;
                         } else if (next_c == ' ' || next_c == '\t' || next_c == '\n' || next_c == '\r' || next_c == ':') {
                             continue;  // Ignora whitespace e :
@@ -391,35 +250,26 @@ int JSONParser::loadFromFileIncremental(File& file, Speedcam* speedcams, int max
         
         // Gestisci escape in stringhe
         if (escape_next) {
-            if (in_object && obj_pos < obj_buffer_size - 1) {
-                obj_buffer[obj_pos++] = '\\';
-                obj_buffer[obj_pos++] = c;
-            }
+            append(c);
             escape_next = false;
             continue;
         }
         
         if (c == '\\' && in_string) {
             escape_next = true;
-            if (in_object && obj_pos < obj_buffer_size - 1) {
-                obj_buffer[obj_pos++] = c;
-            }
+            append(c);
             continue;
         }
         
         // Gestisci stringhe
         if (c == '"') {
             in_string = !in_string;
-            if (in_object && obj_pos < obj_buffer_size - 1) {
-                obj_buffer[obj_pos++] = c;
-            }
+            append(c);
             continue;
         }
         
         if (in_string) {
-            if (in_object && obj_pos < obj_buffer_size - 1) {
-                obj_buffer[obj_pos++] = c;
-            }
+            append(c);
             continue;
         }
         
@@ -429,77 +279,73 @@ int JSONParser::loadFromFileIncremental(File& file, Speedcam* speedcams, int max
             if (brace_depth == 1) {
                 // Inizio nuovo oggetto speedcam
                 in_object = true;
+                obj_truncated = false;
                 obj_pos = 0;
-                obj_buffer[obj_pos++] = c;
-            } else if (in_object && obj_pos < obj_buffer_size - 1) {
-                obj_buffer[obj_pos++] = c;
             }
+            append(c);
         } else if (c == '}') {
             brace_depth--;
-            if (in_object && obj_pos < obj_buffer_size - 1) {
-                obj_buffer[obj_pos++] = c;
-            }
+            append(c);
             
             if (brace_depth == 0 && in_object) {
                 // Fine oggetto speedcam, parsalo
                 obj_buffer[obj_pos] = '\0';
+                records++;
                 
-                // Parsa oggetto con ArduinoJson
-                DynamicJsonDocument doc(512);
-                DeserializationError error = deserializeJson(doc, obj_buffer);
-                
-                if (!error) {
+                bool valid = false;
+                if (!obj_truncated) {
+                    // Parsa oggetto con ArduinoJson (documento rilasciato a fine record)
+                    ArenaScope record_scope(scratch);
+                    ArenaJsonAllocator allocator(scratch);
+                    JsonDocument doc(&allocator);
+                    DeserializationError error = deserializeJson(doc, obj_buffer);
+                    
                     Speedcam sc;
-                    if (parseSpeedcam(doc.as<JsonObject>(), sc)) {
-                        // Verifica coordinate valide
-                        if (sc.lat != 0.0 || sc.lng != 0.0) {
-                            speedcams[loaded_count++] = sc;
-                            
-                            #ifdef DEBUG_ENABLED
-                            if (DEBUG_ENABLED && loaded_count % 100 == 0) {
-                                Serial.print("[JSON] Caricate ");
-                                Serial.print(loaded_count);
-                                Serial.println(" speedcam...");
-                            }
-                            #endif
+                    // Coordinate obbligatorie e valide (speedcam_position_valid)
+                    if (!error && parseSpeedcam(doc.as<JsonObject>(), sc)) {
+                        valid = true;
+                        valid_count++;
+                        callback(ctx, sc);
+                        
+                        if (valid_count % 1000 == 0) {
+                            LOG_D(JSON, "Lette %d speedcam...", valid_count);
                         }
                     }
                 }
+                if (!valid && stats) {
+                    stats->dropped_invalid++;
+                }
                 
                 in_object = false;
                 obj_pos = 0;
             }
         } else if (c == '[') {
             bracket_depth++;
-            if (in_object && obj_pos < obj_buffer_size - 1) {
-                obj_buffer[obj_pos++] = c;
-            }
+            append(c);
         } else if (c == ']') {
             bracket_depth--;
-            if (bracket_depth == 0) {
+            if (bracket_depth < 0) {
                 // Fine array result
                 break;
             }
-            if (in_object && obj_pos < obj_buffer_size - 1) {
-                obj_buffer[obj_pos++] = c;
-            }
+            append(c);
         } else {
             // Altri caratteri
-            if (in_object && obj_pos < obj_buffer_size - 1) {
-                obj_buffer[obj_pos++] = c;
-            }
+            append(c);
         }
     }
     
-    free(obj_buffer);
+    if (stats) {
+        stats->records += records;
+    }
     
-    #ifdef DEBUG_ENABLED
-    if (DEBUG_ENABLED) {
-        Serial.print("[JSON] Parser incrementale completato: ");
-        Serial.print(loaded_count);
-        Serial.println(" speedcam caricate");
+    if (!found_result_array) {
+        LOG_E(JSON, "Campo 'result' non trovato");
+        return -1;
     }
-    #endif
     
-    return loaded_count;
+    LOG_D(JSON, "Parser incrementale completato: %d speedcam valide su %u oggetti",
+          valid_count, (unsigned int)records);
+    
+    return valid_count;
 }
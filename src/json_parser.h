@@ -6,29 +6,28 @@
 #include <FS.h>
 #include <LittleFS.h>
 #include "config.h"
+#include "speedcam.h"
 
 /**
- * Struttura dati speedcam
- * Ottimizzata per memoria limitata ESP32
+ * Statistiche di caricamento del database
+ * Ogni record del file finisce in loaded o in uno dei contatori dropped_*
  */
-struct Speedcam {
-    uint32_t id;
-    float lat;
-    float lng;
-    char type[4];        // "G50", "A", "BK", ecc.
-    char vmax[4];        // "50", "/", ecc.
-    char status;         // 'A' (attivo) o 'L' (inattivo)
-    char art;            // Tipo: 'G', 'A', 'BK', ecc.
-    
-    Speedcam() : 
-        id(0), 
-        lat(0.0), 
-        lng(0.0), 
-        status(' '), 
-        art(' ') {
-        type[0] = '\0';
-        vmax[0] = '\0';
-    }
+struct SpeedcamLoadStats {
+    uint32_t records;           // Oggetti nell'array "result"
+    uint32_t loaded;            // Speedcam in RAM
+    uint32_t dropped_invalid;   // JSON non valido, oggetto troppo lungo o senza coordinate valide
+    uint32_t dropped_distance;  // Oltre il raggio del pre-filtro (database oltre budget)
+    uint32_t dropped_budget;    // Nell'anello di confine del pre-filtro, oltre la capacità
+    uint32_t capacity;          // Speedcam contenute nel budget RAM
+    uint32_t file_size;         // Byte del file (con records e db_crc: firma del database)
+    uint32_t db_version;        // Versione del database binario, 0 per il JSON
+    uint32_t db_crc;            // CRC-32 dei record del database binario, 0 per il JSON
+    uint32_t patch_size;        // Byte della patch applicata allo slot, 0 se nessuna
+    float min_lat, max_lat;     // Bounding box delle speedcam valide
+    float min_lng, max_lng;
+    float center_lat, center_lng;  // Centro del pre-filtro
+    float radius_km;            // Raggio del pre-filtro, 0 se tutto il file è in RAM
+    unsigned long duration_ms;  // Durata dei due passaggi
 };
 
 /**
@@ -41,13 +40,20 @@ public:
     ~JSONParser();
     
     /**
-     * Carica database speedcam da file JSON su LittleFS
+     * Callback per ogni speedcam valida del file
+     */
+    typedef void (*RecordCallback)(void* ctx, const Speedcam& speedcam);
+    
+    /**
+     * Legge il file JSON su LittleFS un oggetto alla volta (memoria costante)
      * @param filename Nome file JSON (es. "/speedcams.json")
-     * @param speedcams Array dove salvare le speedcam
-     * @param max_count Dimensione massima array
-     * @return Numero di speedcam caricate, -1 se errore
+     * @param callback Chiamata per ogni speedcam con coordinate valide
+     * @param ctx Contesto passato al callback
+     * @param stats Se non nullptr, incrementa records e dropped_invalid
+     * @return Numero di speedcam valide, -1 se errore
      */
-    int loadFromFile(const char* filename, Speedcam* speedcams, int max_count);
+    int scanFile(const char* filename, RecordCallback callback, void* ctx,
+                 SpeedcamLoadStats* stats = nullptr);
     
     /**
      * Carica database speedcam da stringa JSON
@@ -58,21 +64,6 @@ public:
      */
     int loadFromString(const char* json_string, Speedcam* speedcams, int max_count);
     
-    /**
-     * Pre-filtra speedcam per bounding box geografico
-     * Utile per ridurre il numero di speedcam da processare
-     * @param speedcams Array speedcam
-     * @param count Numero speedcam nell'array
-     * @param min_lat Latitudine minima
-     * @param max_lat Latitudine massima
-     * @param min_lng Longitudine minima
-     * @param max_lng Longitudine massima
-     * @return Numero di speedcam dopo filtro
-     */
-    int filterByBoundingBox(Speedcam* speedcams, int count, 
-                           float min_lat, float max_lat, 
-                           float min_lng, float max_lng);
-    
     /**
      * Verifica se LittleFS è inizializzato
      */
@@ -90,10 +81,10 @@ private:
     void safeStringCopy(char* dest, const char* src, size_t max_len);
     
     /**
-     * Carica speedcam da file usando parser incrementale (per file molto grandi)
-     * Processa il JSON carattere per carattere estraendo solo i dati necessari
+     * Parser incrementale: processa il JSON carattere per carattere e parsa
+     * individualmente ogni oggetto dell'array "result"
      */
-    int loadFromFileIncremental(File& file, Speedcam* speedcams, int max_count);
+    int scanIncremental(File& file, RecordCallback callback, void* ctx, SpeedcamLoadStats* stats);
 };
 
 #endif // JSON_PARSER_H
@@ -0,0 +1,189 @@
+#include "kd_index.h"
+#include "utils.h"
+
+static inline int32_t to_fixed(float deg) {
+    return (int32_t)(deg * (float)KD_SCALE + (deg >= 0.0f ? 0.5f : -0.5f));
+}
+
+static inline float axis_value(const Speedcam& sc, int axis) {
+    return axis ? sc.lng : sc.lat;
+}
+
+static inline void swap_speedcams(Speedcam& a, Speedcam& b) {
+    Speedcam t = a;
+    a = b;
+    b = t;
+}
+
+/**
+ * Porta in nth l'elemento che ci starebbe ordinando [first, end) sull'asse,
+ * con i minori o uguali prima e i maggiori o uguali dopo (quickselect a tre
+ * vie: le coordinate ripetute non degradano a O(n²))
+ */
+static void select_nth(Speedcam* speedcams, int first, int end, int nth, int axis) {
+    while (end - first > 1) {
+        // Pivot: mediana di primo, centrale e ultimo (l'array può arrivare già ordinato)
+        float a = axis_value(speedcams[first], axis);
+        float b = axis_value(speedcams[first + (end - first) / 2], axis);
+        float c = axis_value(speedcams[end - 1], axis);
+        float pivot = max(min(a, b), min(max(a, b), c));
+
+        // [first, lt) < pivot, [lt, i) == pivot, [gt, end) > pivot
+        int lt = first;
+        int i = first;
+        int gt = end;
+        while (i < gt) {
+            float value = axis_value(speedcams[i], axis);
+            if (value < pivot) {
+                swap_speedcams(speedcams[lt++], speedcams[i++]);
+            } else if (value > pivot) {
+                swap_speedcams(speedcams[i], speedcams[--gt]);
+            } else {
+                i++;
+            }
+        }
+        if (nth < lt) {
+            end = lt;
+        } else if (nth >= gt) {
+            first = gt;
+        } else {
+            return;
+        }
+    }
+}
+
+static void build(Speedcam* speedcams, int first, int end, int depth) {
+    while (end - first > 1) {
+        int mid = first + (end - first) / 2;
+        select_nth(speedcams, first, end, mid, depth & 1);
+        depth++;
+        build(speedcams, first, mid, depth);
+        first = mid + 1;
+    }
+}
+
+void kd_build(Speedcam* speedcams, int count) {
+    build(speedcams, 0, count, 0);
+}
+
+void kd_query_init(KdQuery& query, double lat, double lng, float radius_m, KdNeighbor* results, int k) {
+    query.lat = to_fixed(lat);
+    query.lng = to_fixed(lng);
+    query.cos_lat = (int32_t)(cos(deg_to_rad(lat)) * 32768.0);
+    double radius = (radius_m * (1.0 + KD_DISTANCE_ERROR) + KD_DISTANCE_SLACK_M) / KD_METERS_PER_UNIT;
+    query.radius2 = (int64_t)(radius * radius);
+    query.ahead = false;
+    query.dir_x = 0;
+    query.dir_y = 0;
+    query.cos2_half = 0;
+    query.filter = nullptr;
+    query.filter_ctx = nullptr;
+    query.results = results;
+    query.k = k;
+    query.count = 0;
+    query.visited = 0;
+}
+
+void kd_query_ahead(KdQuery& query, float heading_deg, float half_angle_deg) {
+    double heading = deg_to_rad(heading_deg);
+    double cos_half = cos(deg_to_rad(clamp(half_angle_deg, 0.0f, 90.0f)));
+    query.ahead = true;
+    // x verso est, y verso nord: la rotta è in senso orario dal nord
+    query.dir_x = (int32_t)(sin(heading) * 16384.0);
+    query.dir_y = (int32_t)(cos(heading) * 16384.0);
+    query.cos2_half = (int32_t)(cos_half * cos_half * 16384.0);
+}
+
+void kd_query_filter(KdQuery& query, KdFilter filter, void* ctx) {
+    query.filter = filter;
+    query.filter_ctx = ctx;
+}
+
+/**
+ * Ordine dei risultati: distanza, poi indice (stesso esito in qualunque ordine di visita)
+ */
+static inline bool before(int64_t distance2, int index, const KdNeighbor& other) {
+    return distance2 < other.distance2 || (distance2 == other.distance2 && index < other.index);
+}
+
+static inline int64_t worst_distance2(const KdQuery& query) {
+    return query.count < query.k ? query.radius2 : query.results[query.k - 1].distance2;
+}
+
+static void offer(KdQuery& query, const Speedcam* speedcams, int index, int64_t dx, int64_t dy) {
+    query.visited++;
+    int64_t distance2 = dx * dx + dy * dy;
+    if (distance2 > query.radius2) return;
+    if (query.count == query.k && !before(distance2, index, query.results[query.k - 1])) return;
+    if (query.ahead) {
+        // Angolo dalla direzione entro il semi-angolo: dot > 0 e dot² >= d² cos²
+        int64_t dot = (dx * query.dir_x + dy * query.dir_y) >> 14;
+        if (dot <= 0 || dot * dot < (distance2 >> 14) * query.cos2_half) return;
+    }
+    // Per ultimo: solo le speedcam che entrerebbero tra i risultati
+    if (query.filter && !query.filter(query.filter_ctx, speedcams[index])) return;
+
+    // Inserimento ordinato; a lista piena esce l'ultimo
+    int pos = query.count < query.k ? query.count++ : query.k - 1;
+    while (pos > 0 && before(distance2, index, query.results[pos - 1])) {
+        query.results[pos] = query.results[pos - 1];
+        pos--;
+    }
+    query.results[pos].index = index;
+    query.results[pos].distance2 = distance2;
+}
+
+static inline int64_t delta_lat(const Speedcam& sc, const KdQuery& query) {
+    return (int64_t)to_fixed(sc.lat) - query.lat;
+}
+
+static inline int64_t delta_lng(const Speedcam& sc, const KdQuery& query) {
+    return (((int64_t)to_fixed(sc.lng) - query.lng) * query.cos_lat) >> 15;
+}
+
+static void search(const Speedcam* speedcams, int first, int end, int depth, KdQuery& query) {
+    while (first < end) {
+        int mid = first + (end - first) / 2;
+        int64_t dy = delta_lat(speedcams[mid], query);
+        int64_t dx = delta_lng(speedcams[mid], query);
+        offer(query, speedcams, mid, dx, dy);
+
+        // Prima il lato della posizione, poi l'altro solo se il piano di taglio
+        // è più vicino del peggior risultato (le distanze lungo l'asse sono monotone)
+        int64_t diff = (depth & 1) ? dx : dy;
+        depth++;
+        if (diff > 0) {
+            search(speedcams, first, mid, depth, query);
+            if (diff * diff > worst_distance2(query)) return;
+            first = mid + 1;
+        } else {
+            search(speedcams, mid + 1, end, depth, query);
+            if (diff * diff > worst_distance2(query)) return;
+            end = mid;
+        }
+    }
+}
+
+int kd_search(const Speedcam* speedcams, int count, KdQuery& query) {
+    if (query.k > 0) {
+        search(speedcams, 0, count, 0, query);
+    }
+    return query.count;
+}
+
+int kd_scan(const Speedcam* speedcams, int first, int end, KdQuery& query) {
+    if (query.k <= 0) return 0;
+    for (int i = first; i < end; i++) {
+        offer(query, speedcams, i, delta_lng(speedcams[i], query), delta_lat(speedcams[i], query));
+    }
+    return query.count;
+}
+
+float kd_distance_m(int64_t distance2) {
+    return sqrtf((float)distance2) * (float)KD_METERS_PER_UNIT;
+}
+
+float kd_min_distance_m(int64_t distance2) {
+    float distance = kd_distance_m(distance2) * (1.0f - KD_DISTANCE_ERROR) - KD_DISTANCE_SLACK_M;
+    return distance > 0.0f ? distance : 0.0f;
+}
@@ -0,0 +1,114 @@
+#ifndef KD_INDEX_H
+#define KD_INDEX_H
+
+#include <Arduino.h>
+#include "speedcam.h"
+
+/**
+ * k-d tree implicito sulle coordinate delle speedcam
+ *
+ * L'albero è l'array stesso, riordinato sul posto da kd_build(): la radice
+ * dell'intervallo [first, end) è l'elemento centrale, a sinistra le speedcam
+ * con coordinata minore o uguale, a destra maggiore o uguale; l'asse alterna
+ * latitudine e longitudine a ogni livello. Nessun puntatore né memoria oltre
+ * all'array: la profondità della ricorsione è log2(count).
+ *
+ * Le ricerche lavorano in virgola fissa (microgradi, int32) con una distanza
+ * equirettangolare: la longitudine è scalata per il coseno della latitudine
+ * della ricerca, calcolato una volta per ricerca. Le distanze in metri sono
+ * quindi approssimate (KD_DISTANCE_ERROR rispetto a calculate_distance).
+ */
+
+#define KD_SCALE 1000000                  // Microgradi per grado
+#define KD_METERS_PER_UNIT 0.111194927    // Metri per microgrado di latitudine (EARTH_RADIUS_M)
+#define KD_DISTANCE_ERROR 0.01f           // Errore relativo massimo della distanza approssimata
+#define KD_DISTANCE_SLACK_M 2.0f          // Errore assoluto (arrotondamento delle coordinate)
+
+/**
+ * Una speedcam trovata: indice nell'array e distanza al quadrato in microgradi²
+ */
+struct KdNeighbor {
+    int index;
+    int64_t distance2;
+};
+
+/**
+ * Filtro di una ricerca: false scarta la speedcam (es. già superata, altra
+ * carreggiata), che così non occupa uno dei k posti
+ */
+typedef bool (*KdFilter)(void* ctx, const Speedcam& speedcam);
+
+/**
+ * Ricerca delle k speedcam più vicine entro un raggio (inizializzata da kd_query_init)
+ */
+struct KdQuery {
+    int32_t lat;            // Posizione in microgradi
+    int32_t lng;
+    int32_t cos_lat;        // Coseno della latitudine (Q15)
+    int64_t radius2;        // Raggio al quadrato, già allargato dell'errore massimo
+    // Solo speedcam davanti (kd_query_ahead): direzione e coseno² del semi-angolo (Q14)
+    bool ahead;
+    int32_t dir_x;
+    int32_t dir_y;
+    int32_t cos2_half;
+    // Filtro opzionale (kd_query_filter), chiamato solo per le speedcam entro il raggio
+    KdFilter filter;
+    void* filter_ctx;
+    // Risultati in ordine di distanza
+    KdNeighbor* results;
+    int k;
+    int count;
+    int visited;            // Speedcam di cui è stata calcolata la distanza
+};
+
+/**
+ * Costruisce l'albero riordinando l'array (selezione della mediana, O(n log n), senza allocazioni)
+ * Le speedcam devono avere coordinate valide (come dopo il caricamento).
+ */
+void kd_build(Speedcam* speedcams, int count);
+
+/**
+ * Prepara una ricerca delle k più vicine entro radius_m dalla posizione
+ * Il raggio viene allargato di KD_DISTANCE_ERROR: nessuna speedcam entro
+ * radius_m secondo calculate_distance viene esclusa.
+ * @param results Array di almeno k elementi
+ */
+void kd_query_init(KdQuery& query, double lat, double lng, float radius_m, KdNeighbor* results, int k);
+
+/**
+ * Limita la ricerca alle speedcam davanti: entro half_angle_deg (0-90) dalla direzione di marcia
+ */
+void kd_query_ahead(KdQuery& query, float heading_deg, float half_angle_deg);
+
+/**
+ * Tiene solo le speedcam per cui filter restituisce true: le k più vicine sono
+ * cercate tra quelle accettate, non filtrate dopo il taglio a k
+ */
+void kd_query_filter(KdQuery& query, KdFilter filter, void* ctx);
+
+/**
+ * Ricerca nell'albero (array costruito da kd_build), con potatura dei rami
+ * più lontani del k-esimo risultato
+ * @return Numero di risultati (al più k), ordinati per distanza
+ */
+int kd_search(const Speedcam* speedcams, int count, KdQuery& query);
+
+/**
+ * Stessa ricerca per forza bruta sulle speedcam [first, end), in qualsiasi ordine
+ * Si può chiamare più volte sulla stessa query (es. per più intervalli).
+ * @return Numero di risultati (al più k), ordinati per distanza
+ */
+int kd_scan(const Speedcam* speedcams, int first, int end, KdQuery& query);
+
+/**
+ * Distanza approssimata in metri di un risultato
+ */
+float kd_distance_m(int64_t distance2);
+
+/**
+ * Distanza minima in metri (calculate_distance) compatibile con un risultato:
+ * le speedcam escluse da una ricerca piena sono almeno a questa distanza
+ */
+float kd_min_distance_m(int64_t distance2);
+
+#endif // KD_INDEX_H
@@ -0,0 +1,301 @@
+#include "log.h"
+#include "trace.h"
+
+static_assert((LOG_BUFFER_SIZE & (LOG_BUFFER_SIZE - 1)) == 0, "LOG_BUFFER_SIZE deve essere una potenza di 2");
+
+// Header record: lunghezza, livello, modulo, argc, millis, puntatore al formato
+#define LOG_HEADER_SIZE (4 + sizeof(uint32_t) + sizeof(const char*))
+
+static_assert(LOG_RECORD_MAX + LOG_HEADER_SIZE <= 255, "La lunghezza del record deve stare in un byte");
+
+static const char* const module_names[LOG_MODULE_COUNT] = {
+    "Setup",
+    "Loop",
+    "GPS",
+    "Speedcam",
+    "JSON",
+    "Display",
+    "Animation",
+    "Trace",
+    "Memory",
+    "State",
+    "Section",
+};
+
+static uint8_t ring[LOG_BUFFER_SIZE];
+static uint16_t ring_head = 0;   // Prossima scrittura
+static uint16_t ring_tail = 0;   // Prossima lettura
+static uint16_t ring_used = 0;
+static bool deferred_mode = true;
+static Print* output = nullptr;
+static LogStats stats = { 0, 0, 0, 0 };
+static unsigned long reported_dropped = 0;
+
+// ---- Codifica ----
+
+void LogRecordBuilder::putInt(int32_t value) {
+    if (length + 1 + sizeof(value) > LOG_RECORD_MAX) return;
+    data[length++] = LOG_ARG_INT;
+    memcpy(&data[length], &value, sizeof(value));
+    length += sizeof(value);
+    argc++;
+}
+
+void LogRecordBuilder::putUInt(uint32_t value) {
+    if (length + 1 + sizeof(value) > LOG_RECORD_MAX) return;
+    data[length++] = LOG_ARG_UINT;
+    memcpy(&data[length], &value, sizeof(value));
+    length += sizeof(value);
+    argc++;
+}
+
+void LogRecordBuilder::putDouble(double value) {
+    if (length + 1 + sizeof(value) > LOG_RECORD_MAX) return;
+    data[length++] = LOG_ARG_DOUBLE;
+    memcpy(&data[length], &value, sizeof(value));
+    length += sizeof(value);
+    argc++;
+}
+
+void LogRecordBuilder::putChar(char value) {
+    if (length + 2 > LOG_RECORD_MAX) return;
+    data[length++] = LOG_ARG_CHAR;
+    data[length++] = (uint8_t)value;
+    argc++;
+}
+
+void LogRecordBuilder::putString(const char* value) {
+    if (!value) value = "(null)";
+    size_t n = strlen(value);
+    if (n > LOG_MAX_STRING_ARG) n = LOG_MAX_STRING_ARG;
+    if (length + 2 + n > LOG_RECORD_MAX) {
+        if (length + 2 >= LOG_RECORD_MAX) return;
+        n = LOG_RECORD_MAX - length - 2;
+    }
+    data[length++] = LOG_ARG_STRING;
+    data[length++] = (uint8_t)n;
+    memcpy(&data[length], value, n);
+    length += n;
+    argc++;
+}
+
+// ---- Ring buffer ----
+
+static void ring_put(const void* src, uint16_t n) {
+    const uint8_t* bytes = (const uint8_t*)src;
+    for (uint16_t i = 0; i < n; i++) {
+        ring[ring_head] = bytes[i];
+        ring_head = (ring_head + 1) & (LOG_BUFFER_SIZE - 1);
+    }
+    ring_used += n;
+}
+
+static void ring_get(void* dst, uint16_t n) {
+    uint8_t* bytes = (uint8_t*)dst;
+    for (uint16_t i = 0; i < n; i++) {
+        bytes[i] = ring[ring_tail];
+        ring_tail = (ring_tail + 1) & (LOG_BUFFER_SIZE - 1);
+    }
+    ring_used -= n;
+}
+
+void log_commit(uint8_t level, uint8_t module, const char* format, const LogRecordBuilder& record) {
+    uint16_t total = LOG_HEADER_SIZE + record.length;
+    stats.records++;
+
+    if (total > LOG_BUFFER_SIZE - ring_used) {
+        // Buffer pieno: il record più recente si perde (contato e segnalato al flush)
+        stats.dropped++;
+        if (!deferred_mode) log_flush();
+        return;
+    }
+
+    uint8_t header[4] = { (uint8_t)total, level, module, record.argc };
+    uint32_t time_ms = millis();
+    ring_put(header, sizeof(header));
+    ring_put(&time_ms, sizeof(time_ms));
+    ring_put(&format, sizeof(format));
+    ring_put(record.data, record.length);
+
+    if (!deferred_mode) {
+        log_flush();
+    }
+}
+
+// ---- Formattazione (fuori dal percorso critico) ----
+
+static void print_padded(Print& out, const char* text, size_t length, int width, bool left, bool zero) {
+    int pad = width > (int)length ? width - (int)length : 0;
+    if (!left) {
+        // Zeri dopo il segno
+        if (zero && length > 0 && text[0] == '-') {
+            out.write('-');
+            text++;
+            length--;
+        }
+        for (int i = 0; i < pad; i++) out.write(zero ? '0' : ' ');
+    }
+    out.write((const uint8_t*)text, length);
+    if (left) {
+        for (int i = 0; i < pad; i++) out.write(' ');
+    }
+}
+
+static void format_record(Print& out, const char* format, const uint8_t* args, uint8_t args_length, uint8_t argc) {
+    uint8_t pos = 0;
+    uint8_t used = 0;
+    char text[40];
+
+    for (const char* p = format; *p; p++) {
+        if (*p != '%') {
+            out.write((uint8_t)*p);
+            continue;
+        }
+        p++;
+        if (*p == '%') {
+            out.write('%');
+            continue;
+        }
+
+        // Specifica: flag, larghezza, precisione, conversione
+        bool left = false;
+        bool zero = false;
+        for (; *p == '-' || *p == '0' || *p == '+' || *p == ' '; p++) {
+            if (*p == '-') left = true;
+            if (*p == '0') zero = true;
+        }
+        int width = 0;
+        for (; *p >= '0' && *p <= '9'; p++) width = width * 10 + (*p - '0');
+        int precision = -1;
+        if (*p == '.') {
+            precision = 0;
+            for (p++; *p >= '0' && *p <= '9'; p++) precision = precision * 10 + (*p - '0');
+        }
+        while (*p == 'l' || *p == 'h') p++;
+        if (!*p) break;
+        char conversion = *p;
+
+        if (used >= argc || pos >= args_length) {
+            out.print("<?>");
+            continue;
+        }
+        used++;
+
+        uint8_t type = args[pos++];
+        size_t length = 0;
+        const char* value = text;
+        bool hex = conversion == 'x' || conversion == 'X';
+
+        switch (type) {
+            case LOG_ARG_INT: {
+                int32_t v;
+                memcpy(&v, &args[pos], sizeof(v));
+                pos += sizeof(v);
+                length = snprintf(text, sizeof(text), hex ? (conversion == 'x' ? "%lx" : "%lX") : "%ld", (long)v);
+                break;
+            }
+            case LOG_ARG_UINT: {
+                uint32_t v;
+                memcpy(&v, &args[pos], sizeof(v));
+                pos += sizeof(v);
+                if (conversion == 'c') {
+                    text[0] = (char)v;
+                    length = 1;
+                } else {
+                    length = snprintf(text, sizeof(text), hex ? (conversion == 'x' ? "%lx" : "%lX") : "%lu",
+                                      (unsigned long)v);
+                }
+                break;
+            }
+            case LOG_ARG_DOUBLE: {
+                double v;
+                memcpy(&v, &args[pos], sizeof(v));
+                pos += sizeof(v);
+                // Come Print::print(double): 2 decimali se non specificato
+                length = snprintf(text, sizeof(text), "%.*f", precision < 0 ? 2 : precision, v);
+                break;
+            }
+            case LOG_ARG_CHAR:
+                text[0] = (char)args[pos++];
+                length = 1;
+                break;
+            case LOG_ARG_STRING:
+                length = args[pos++];
+                value = (const char*)&args[pos];
+                pos += length;
+                if (precision >= 0 && (size_t)precision < length) length = precision;
+                break;
+            default:
+                pos = args_length;
+                break;
+        }
+        if (length >= sizeof(text) && value == text) length = sizeof(text) - 1;
+        print_padded(out, value, length, width, left, zero);
+    }
+}
+
+uint16_t log_flush(uint16_t max_records) {
+    TRACE_SCOPE(TRACE_LOG_FLUSH);
+    
+    if (!output) output = &Serial;
+    Print& out = *output;
+
+    if (stats.dropped != reported_dropped) {
+        out.print("[Log] ");
+        out.print(stats.dropped - reported_dropped);
+        out.println(" messaggi persi (buffer pieno)");
+        reported_dropped = stats.dropped;
+    }
+
+    uint16_t printed = 0;
+    uint8_t args[LOG_RECORD_MAX];
+    while (ring_used >= LOG_HEADER_SIZE && (max_records == 0 || printed < max_records)) {
+        uint8_t header[4];
+        uint32_t time_ms;
+        const char* format;
+        ring_get(header, sizeof(header));
+        ring_get(&time_ms, sizeof(time_ms));
+        ring_get(&format, sizeof(format));
+        uint8_t args_length = header[0] - LOG_HEADER_SIZE;
+        ring_get(args, args_length);
+
+        uint8_t module = header[2] < LOG_MODULE_COUNT ? header[2] : 0;
+        out.write('[');
+        out.print(module_names[module]);
+        out.print("] ");
+        if (header[1] == LOG_LEVEL_ERROR) {
+            out.print("ERRORE: ");
+        } else if (header[1] == LOG_LEVEL_WARN) {
+            out.print("ATTENZIONE: ");
+        }
+        format_record(out, format, args, args_length, header[3]);
+        out.println();
+        printed++;
+    }
+    stats.flushed += printed;
+    return printed;
+}
+
+// ---- Configurazione ----
+
+void log_begin(Print* out) {
+    output = out;
+}
+
+void log_set_deferred(bool deferred) {
+    deferred_mode = deferred;
+    if (!deferred) log_flush();
+}
+
+LogStats log_get_stats() {
+    LogStats result = stats;
+    result.pending_bytes = ring_used;
+    return result;
+}
+
+void log_reset_stats() {
+    stats.records = 0;
+    stats.dropped = 0;
+    stats.flushed = 0;
+    reported_dropped = 0;
+}
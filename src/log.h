@@ -0,0 +1,219 @@
+#ifndef LOG_H
+#define LOG_H
+
+#include <Arduino.h>
+#include "config.h"
+
+/**
+ * Log a livelli per modulo
+ *
+ *   LOG_I(GPS, "Fix ottenuto, satelliti: %u", satellites);
+ *
+ * Il livello di ogni modulo è una costante di compilazione (LOG_LEVEL e
+ * LOG_LEVEL_<MODULO> in config.h): sotto il livello la chiamata è un if su una
+ * costante falsa e non genera codice, argomenti compresi.
+ *
+ * Sopra il livello la formattazione è differita: il puntatore al formato e gli
+ * argomenti in binario vanno in un ring buffer (stringhe copiate, troncate a
+ * LOG_MAX_STRING_ARG), il testo si compone in log_flush() fuori dal percorso
+ * critico. Il formato deve quindi essere una stringa letterale.
+ *
+ * Formato stile printf: %d %i %u %x %X %c %s %f con larghezza, '0', '-' e
+ * precisione (%.6f). Il valore è stampato secondo il tipo reale dell'argomento.
+ */
+
+#define LOG_LEVEL_NONE 0
+#define LOG_LEVEL_ERROR 1
+#define LOG_LEVEL_WARN 2
+#define LOG_LEVEL_INFO 3
+#define LOG_LEVEL_DEBUG 4
+#define LOG_LEVEL_VERBOSE 5
+
+#ifndef LOG_LEVEL
+#define LOG_LEVEL LOG_LEVEL_INFO
+#endif
+
+// Livelli per modulo (default: LOG_LEVEL)
+#ifndef LOG_LEVEL_SETUP
+#define LOG_LEVEL_SETUP LOG_LEVEL
+#endif
+#ifndef LOG_LEVEL_LOOP
+#define LOG_LEVEL_LOOP LOG_LEVEL
+#endif
+#ifndef LOG_LEVEL_GPS
+#define LOG_LEVEL_GPS LOG_LEVEL
+#endif
+#ifndef LOG_LEVEL_SPEEDCAM
+#define LOG_LEVEL_SPEEDCAM LOG_LEVEL
+#endif
+#ifndef LOG_LEVEL_JSON
+#define LOG_LEVEL_JSON LOG_LEVEL
+#endif
+#ifndef LOG_LEVEL_DISPLAY
+#define LOG_LEVEL_DISPLAY LOG_LEVEL
+#endif
+#ifndef LOG_LEVEL_ANIMATION
+#define LOG_LEVEL_ANIMATION LOG_LEVEL
+#endif
+#ifndef LOG_LEVEL_TRACE
+#define LOG_LEVEL_TRACE LOG_LEVEL
+#endif
+#ifndef LOG_LEVEL_MEMORY
+#define LOG_LEVEL_MEMORY LOG_LEVEL
+#endif
+#ifndef LOG_LEVEL_STATE
+#define LOG_LEVEL_STATE LOG_LEVEL
+#endif
+#ifndef LOG_LEVEL_SECTION
+#define LOG_LEVEL_SECTION LOG_LEVEL
+#endif
+
+/**
+ * Moduli (prefisso "[Nome]" nelle righe di log, nomi in log.cpp)
+ */
+enum LogModule : uint8_t {
+    LOG_MODULE_SETUP = 0,
+    LOG_MODULE_LOOP,
+    LOG_MODULE_GPS,
+    LOG_MODULE_SPEEDCAM,
+    LOG_MODULE_JSON,
+    LOG_MODULE_DISPLAY,
+    LOG_MODULE_ANIMATION,
+    LOG_MODULE_TRACE,
+    LOG_MODULE_MEMORY,
+    LOG_MODULE_STATE,
+    LOG_MODULE_SECTION,
+    LOG_MODULE_COUNT
+};
+
+/**
+ * Vero (costante di compilazione) se il modulo registra il livello
+ */
+#define LOG_ENABLED(module, level) (LOG_LEVEL_##module >= (level))
+
+#define LOG_AT(level, module, ...) \
+    do { \
+        if (LOG_ENABLED(module, level)) { \
+            log_write(level, LOG_MODULE_##module, __VA_ARGS__); \
+        } \
+    } while (0)
+
+#define LOG_E(module, ...) LOG_AT(LOG_LEVEL_ERROR, module, __VA_ARGS__)
+#define LOG_W(module, ...) LOG_AT(LOG_LEVEL_WARN, module, __VA_ARGS__)
+#define LOG_I(module, ...) LOG_AT(LOG_LEVEL_INFO, module, __VA_ARGS__)
+#define LOG_D(module, ...) LOG_AT(LOG_LEVEL_DEBUG, module, __VA_ARGS__)
+#define LOG_V(module, ...) LOG_AT(LOG_LEVEL_VERBOSE, module, __VA_ARGS__)
+
+/**
+ * Log al più una volta ogni interval_ms (messaggi ripetuti dal loop)
+ */
+#define LOG_EVERY(level, module, interval_ms, ...) \
+    do { \
+        if (LOG_ENABLED(module, level)) { \
+            static unsigned long log_last_time = 0; \
+            static bool log_logged = false; \
+            if (!log_logged || millis() - log_last_time >= (interval_ms)) { \
+                log_logged = true; \
+                log_last_time = millis(); \
+                log_write(level, LOG_MODULE_##module, __VA_ARGS__); \
+            } \
+        } \
+    } while (0)
+
+/**
+ * Tipi degli argomenti nel record
+ */
+enum LogArgType : uint8_t {
+    LOG_ARG_INT = 0,     // int32
+    LOG_ARG_UINT,        // uint32
+    LOG_ARG_DOUBLE,      // double
+    LOG_ARG_CHAR,        // char
+    LOG_ARG_STRING       // lunghezza (uint8) + caratteri
+};
+
+/**
+ * Record in composizione (buffer sullo stack del chiamante)
+ */
+struct LogRecordBuilder {
+    uint8_t data[LOG_RECORD_MAX];
+    uint8_t length;
+    uint8_t argc;
+
+    void putInt(int32_t value);
+    void putUInt(uint32_t value);
+    void putDouble(double value);
+    void putChar(char value);
+    void putString(const char* value);
+};
+
+// Codifica per tipo (stesse regole di Print::print: uint8_t è un numero, char un carattere)
+inline void log_put(LogRecordBuilder& r, char v) { r.putChar(v); }
+inline void log_put(LogRecordBuilder& r, bool v) { r.putInt(v ? 1 : 0); }
+inline void log_put(LogRecordBuilder& r, signed char v) { r.putInt(v); }
+inline void log_put(LogRecordBuilder& r, unsigned char v) { r.putUInt(v); }
+inline void log_put(LogRecordBuilder& r, short v) { r.putInt(v); }
+inline void log_put(LogRecordBuilder& r, unsigned short v) { r.putUInt(v); }
+inline void log_put(LogRecordBuilder& r, int v) { r.putInt(v); }
+inline void log_put(LogRecordBuilder& r, unsigned int v) { r.putUInt(v); }
+inline void log_put(LogRecordBuilder& r, long v) { r.putInt((int32_t)v); }
+inline void log_put(LogRecordBuilder& r, unsigned long v) { r.putUInt((uint32_t)v); }
+inline void log_put(LogRecordBuilder& r, long long v) { r.putInt((int32_t)v); }
+inline void log_put(LogRecordBuilder& r, unsigned long long v) { r.putUInt((uint32_t)v); }
+inline void log_put(LogRecordBuilder& r, float v) { r.putDouble(v); }
+inline void log_put(LogRecordBuilder& r, double v) { r.putDouble(v); }
+inline void log_put(LogRecordBuilder& r, const char* v) { r.putString(v); }
+inline void log_put(LogRecordBuilder& r, const String& v) { r.putString(v.c_str()); }
+
+inline void log_put_all(LogRecordBuilder&) {}
+
+template <typename T, typename... Rest>
+inline void log_put_all(LogRecordBuilder& r, const T& value, const Rest&... rest) {
+    log_put(r, value);
+    log_put_all(r, rest...);
+}
+
+/**
+ * Accoda un record già codificato (e lo stampa subito se il log non è differito)
+ */
+void log_commit(uint8_t level, uint8_t module, const char* format, const LogRecordBuilder& record);
+
+template <typename... Args>
+void log_write(uint8_t level, uint8_t module, const char* format, const Args&... args) {
+    LogRecordBuilder record;
+    record.length = 0;
+    record.argc = 0;
+    log_put_all(record, args...);
+    log_commit(level, module, format, record);
+}
+
+/**
+ * Destinazione del testo (default: Serial)
+ */
+void log_begin(Print* out);
+
+/**
+ * Modalità differita: false = ogni record è formattato e stampato subito
+ * (utile in setup(), dove l'ordine con le altre stampe conta più della latenza)
+ */
+void log_set_deferred(bool deferred);
+
+/**
+ * Formatta e stampa i record in coda
+ * @param max_records Numero massimo di record (0 = tutti)
+ * @return Record stampati
+ */
+uint16_t log_flush(uint16_t max_records = 0);
+
+/**
+ * Statistiche log
+ */
+struct LogStats {
+    unsigned long records;      // Record accodati
+    unsigned long dropped;      // Record persi per buffer pieno
+    unsigned long flushed;      // Record stampati
+    uint16_t pending_bytes;     // Byte in coda
+};
+LogStats log_get_stats();
+void log_reset_stats();
+
+#endif // LOG_H
@@ -0,0 +1,206 @@
+#include "lookahead.h"
+#include "utils.h"
+
+// Metri per grado di latitudine (EARTH_RADIUS_M di utils.cpp)
+static const double METERS_PER_DEGREE = 6371000.0 * M_PI / 180.0;
+
+SpeedcamLookahead::SpeedcamLookahead() {
+    count = 0;
+    passed_count = 0;
+    fix_lat = 0.0;
+    fix_lng = 0.0;
+    meters_per_lng = (float)METERS_PER_DEGREE;
+    course_sin = 0.0f;
+    course_cos = 1.0f;
+    course_deg = 0.0f;
+    has_fix = false;
+    has_course = false;
+    refill_lat = 0.0;
+    refill_lng = 0.0;
+    refill_course = 0.0f;
+    refilled = false;
+    refill_truncated = false;
+    resetStats();
+}
+
+void SpeedcamLookahead::clear() {
+    count = 0;
+    refilled = false;
+}
+
+void SpeedcamLookahead::offset(float lat, float lng, float& x, float& y) const {
+    x = (float)(lng - fix_lng) * meters_per_lng;
+    y = (float)((lat - fix_lat) * METERS_PER_DEGREE);
+}
+
+void SpeedcamLookahead::measure(LookaheadEntry& entry) const {
+    float x;
+    float y;
+    offset(entry.speedcam->lat, entry.speedcam->lng, x, y);
+    entry.along_m = x * course_sin + y * course_cos;
+    entry.distance_m = sqrtf(x * x + y * y);
+}
+
+void SpeedcamLookahead::update(double lat, double lng, float course, bool course_valid, float forget_radius) {
+    stats.updates++;
+    // Tratto dall'ultimo fix: a velocità alta una speedcam superata non cade mai
+    // entro LOOKAHEAD_PASSED_M, ma entro il tratto percorso sì
+    float step_m = 0.0f;
+    if (has_fix) {
+        float x = (float)(lng - fix_lng) * meters_per_lng;
+        float y = (float)((lat - fix_lat) * METERS_PER_DEGREE);
+        step_m = sqrtf(x * x + y * y);
+    }
+    fix_lat = lat;
+    fix_lng = lng;
+    meters_per_lng = (float)(METERS_PER_DEGREE * cos(deg_to_rad(lat)));
+    has_fix = true;
+    if (course_valid) {
+        double rad = deg_to_rad(course);
+        course_sin = (float)sin(rad);
+        course_cos = (float)cos(rad);
+        course_deg = course;
+        has_course = true;
+    }
+
+    // Voci in coda: superate nell'elenco delle superate, dietro senza essere state
+    // raggiunte (inversione, svolta) o fuori portata scartate
+    int kept = 0;
+    for (int i = 0; i < count; i++) {
+        LookaheadEntry& entry = entries[i];
+        measure(entry);
+        if (entry.distance_m <= LOOKAHEAD_PASSED_M + step_m) entry.reached = true;
+        if (entry.along_m < -LOOKAHEAD_PASSED_M && !entry.reached) {
+            stats.dropped++;
+            continue;
+        }
+        if (entry.along_m < -LOOKAHEAD_PASSED_M) {
+            addPassed(*entry.speedcam);
+            stats.passed++;
+            // Il riempimento aveva lasciato fuori speedcam: il posto liberato va
+            // riempito subito, non dopo LOOKAHEAD_REFILL_M (gruppi di speedcam)
+            if (refill_truncated) refilled = false;
+            continue;
+        }
+        if (entry.distance_m > LOOKAHEAD_RADIUS_M + LOOKAHEAD_REFILL_M) {
+            stats.dropped++;
+            continue;
+        }
+        entries[kept++] = entry;
+    }
+    count = kept;
+    sort();
+
+    // Superate lontane: di nuovo rilevabili (es. stesso tratto percorso più tardi)
+    kept = 0;
+    for (int i = 0; i < passed_count; i++) {
+        float x;
+        float y;
+        offset(passed[i].lat, passed[i].lng, x, y);
+        if (x * x + y * y <= forget_radius * forget_radius) {
+            passed[kept++] = passed[i];
+        }
+    }
+    passed_count = kept;
+}
+
+bool SpeedcamLookahead::needsRefill() const {
+    if (!has_fix) return false;
+    if (!refilled) return true;
+    float x = (float)(fix_lng - refill_lng) * meters_per_lng;
+    float y = (float)((fix_lat - refill_lat) * METERS_PER_DEGREE);
+    if (x * x + y * y >= (float)LOOKAHEAD_REFILL_M * (float)LOOKAHEAD_REFILL_M) return true;
+    if (!has_course) return false;
+    float turn = fabsf(course_deg - refill_course);
+    if (turn > 180.0f) turn = 360.0f - turn;
+    return turn > LOOKAHEAD_REFILL_COURSE;
+}
+
+void SpeedcamLookahead::refill(const Speedcam* const* found, int found_count) {
+    stats.refills++;
+    refill_lat = fix_lat;
+    refill_lng = fix_lng;
+    refill_course = course_deg;
+    refilled = true;
+    refill_truncated = false;
+
+    // Speedcam raggiunte (entro LOOKAHEAD_PASSED_M, davanti o dietro): la ricerca
+    // davanti può non trovarle più, restano in coda finché update() non le supera
+    LookaheadEntry reached[LOOKAHEAD_MAX];
+    int reached_count = 0;
+    for (int i = 0; i < count; i++) {
+        if (entries[i].along_m <= LOOKAHEAD_PASSED_M) reached[reached_count++] = entries[i];
+    }
+
+    count = 0;
+    for (int i = 0; i < reached_count; i++) {
+        insert(reached[i]);
+    }
+    for (int i = 0; i < found_count; i++) {
+        if (isPassed(found[i]->id) || contains(found[i]->id)) continue;
+        LookaheadEntry entry;
+        entry.speedcam = found[i];
+        entry.reached = false;
+        measure(entry);
+        if (entry.along_m < -LOOKAHEAD_PASSED_M) continue;
+        insert(entry);
+    }
+}
+
+bool SpeedcamLookahead::contains(uint32_t speedcam_id) const {
+    for (int i = 0; i < count; i++) {
+        if (entries[i].speedcam->id == speedcam_id) return true;
+    }
+    return false;
+}
+
+void SpeedcamLookahead::insert(const LookaheadEntry& entry) {
+    // Coda piena: entra solo se più vicina lungo la rotta dell'ultima
+    if (count < LOOKAHEAD_MAX) {
+        entries[count++] = entry;
+    } else if (entry.along_m < entries[count - 1].along_m) {
+        entries[count - 1] = entry;
+        refill_truncated = true;
+    } else {
+        refill_truncated = true;
+        return;
+    }
+    sort();
+}
+
+bool SpeedcamLookahead::isPassed(uint32_t speedcam_id) const {
+    for (int i = 0; i < passed_count; i++) {
+        if (passed[i].id == speedcam_id) return true;
+    }
+    return false;
+}
+
+void SpeedcamLookahead::addPassed(const Speedcam& speedcam) {
+    if (isPassed(speedcam.id)) return;
+    // Elenco pieno: si dimentica la superata più vecchia
+    if (passed_count == LOOKAHEAD_PASSED_MAX) {
+        memmove(&passed[0], &passed[1], (LOOKAHEAD_PASSED_MAX - 1) * sizeof(LookaheadPassed));
+        passed_count--;
+    }
+    LookaheadPassed& entry = passed[passed_count++];
+    entry.id = speedcam.id;
+    entry.lat = speedcam.lat;
+    entry.lng = speedcam.lng;
+}
+
+void SpeedcamLookahead::sort() {
+    // Insertion sort: al più LOOKAHEAD_MAX voci, quasi sempre già in ordine
+    for (int i = 1; i < count; i++) {
+        LookaheadEntry entry = entries[i];
+        int j = i - 1;
+        while (j >= 0 && entries[j].along_m > entry.along_m) {
+            entries[j + 1] = entries[j];
+            j--;
+        }
+        entries[j + 1] = entry;
+    }
+}
+
+void SpeedcamLookahead::resetStats() {
+    memset(&stats, 0, sizeof(stats));
+}
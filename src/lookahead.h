@@ -0,0 +1,133 @@
+#ifndef LOOKAHEAD_H
+#define LOOKAHEAD_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "speedcam.h"
+
+/**
+ * Coda delle prossime speedcam davanti, ordinate per distanza lungo la rotta
+ *
+ * Riempita dalla ricerca "davanti" dell'indice (findSpeedcamsAhead) solo dopo
+ * LOOKAHEAD_REFILL_M percorsi o una svolta, oppure alla prima superata se il
+ * riempimento precedente non è entrato nella coda; a ogni fix le voci vengono
+ * aggiornate sul posto (proiezione sulla rotta in coordinate locali, niente
+ * Haversine) e quelle superate passano nell'elenco delle superate, che la
+ * rilevazione salta finché restano entro il raggio: con speedcam ravvicinate
+ * l'alert passa alla successiva appena superata la prima. Superata vuol dire
+ * raggiunta e poi dietro: una voce finita dietro per un'inversione o una
+ * svolta prima di raggiungerla viene solo scartata e resta rilevabile.
+ */
+
+/**
+ * Una speedcam in coda (il puntatore vale fino al prossimo caricamento: clear())
+ */
+struct LookaheadEntry {
+    const Speedcam* speedcam;
+    float along_m;              // Distanza lungo la rotta (negativa = dietro)
+    float distance_m;           // In linea d'aria
+    bool reached;               // Entro LOOKAHEAD_PASSED_M più il tratto dall'ultimo fix
+};
+
+/**
+ * Speedcam superata: resta finché è entro il raggio di rilevazione
+ */
+struct LookaheadPassed {
+    uint32_t id;
+    float lat;
+    float lng;
+};
+
+class SpeedcamLookahead {
+public:
+    SpeedcamLookahead();
+
+    /**
+     * Svuota la coda (database sostituito: i puntatori non valgono più) e la
+     * riempie di nuovo al prossimo fix; le superate restano (ID e coordinate copiati)
+     */
+    void clear();
+
+    /**
+     * Aggiorna la coda con un nuovo fix: distanze, superate, ordine.
+     * Senza rotta affidabile (course_valid false) resta quella precedente.
+     * @param forget_radius Le superate oltre questa distanza vengono dimenticate
+     */
+    void update(double lat, double lng, float course_deg, bool course_valid, float forget_radius);
+
+    /**
+     * Vero se la coda va riempita di nuovo: mai riempita, LOOKAHEAD_REFILL_M
+     * percorsi, rotta cambiata di oltre LOOKAHEAD_REFILL_COURSE dall'ultima volta
+     * o speedcam superata con altre rimaste fuori dalla coda
+     */
+    bool needsRefill() const;
+
+    /**
+     * Sostituisce la coda con le speedcam trovate davanti (già filtrate da chi
+     * chiama), escluse le superate; tiene le LOOKAHEAD_MAX più vicine lungo la rotta.
+     * Le voci già raggiunte (dietro, non ancora superate) restano in coda.
+     * Da chiamare dopo update() con lo stesso fix.
+     */
+    void refill(const Speedcam* const* found, int count);
+
+    /**
+     * Speedcam superata di recente (da saltare nella rilevazione)
+     */
+    bool isPassed(uint32_t speedcam_id) const;
+
+    /**
+     * Prima speedcam in coda (la più vicina lungo la rotta), nullptr se vuota
+     */
+    const LookaheadEntry* next() const { return count > 0 ? &entries[0] : nullptr; }
+    const LookaheadEntry& get(int i) const { return entries[i]; }
+    int getCount() const { return count; }
+
+    /**
+     * Statistiche
+     */
+    struct Stats {
+        unsigned long updates;          // Fix elaborati
+        unsigned long refills;          // Riempimenti dall'indice
+        unsigned long passed;           // Speedcam superate
+        unsigned long dropped;          // Uscite dalla coda senza essere superate (svolta, inversione)
+    };
+    Stats getStats() const { return stats; }
+    void resetStats();
+
+private:
+    LookaheadEntry entries[LOOKAHEAD_MAX];
+    int count;
+    LookaheadPassed passed[LOOKAHEAD_PASSED_MAX];
+    int passed_count;
+
+    // Ultimo fix: coordinate locali (metri) attorno alla posizione
+    double fix_lat;
+    double fix_lng;
+    float meters_per_lng;       // Metri per grado di longitudine alla latitudine del fix
+    float course_sin;
+    float course_cos;
+    float course_deg;
+    bool has_fix;
+    bool has_course;
+
+    // Ultimo riempimento
+    double refill_lat;
+    double refill_lng;
+    float refill_course;
+    bool refilled;
+    bool refill_truncated;      // Trovate più speedcam di LOOKAHEAD_MAX: nuovo riempimento alla prima superata
+
+    Stats stats;
+
+    /**
+     * Posizione di una speedcam rispetto al fix in metri (x est, y nord)
+     */
+    void offset(float lat, float lng, float& x, float& y) const;
+    void measure(LookaheadEntry& entry) const;
+    void addPassed(const Speedcam& speedcam);
+    bool contains(uint32_t speedcam_id) const;
+    void insert(const LookaheadEntry& entry);
+    void sort();
+};
+
+#endif // LOOKAHEAD_H
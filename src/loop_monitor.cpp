@@ -0,0 +1,144 @@
+#include "loop_monitor.h"
+#include "hal.h"
+#include "log.h"
+#include "trace.h"
+
+static LatencyHistogram iteration_histogram;
+static LatencyHistogram period_histogram;
+static LoopMonitorStats stats;
+
+static uint32_t iteration_start_cycles = 0;
+static unsigned long iteration_start_us = 0;
+static bool iteration_started = false;
+static uint32_t last_feed_cycles = 0;
+static unsigned long next_deadline = 0;
+
+void loop_monitor_reset_stats() {
+    iteration_histogram.reset();
+    period_histogram.reset();
+    stats.iterations = 0;
+    stats.overruns = 0;
+    stats.alarms = 0;
+    stats.max_iteration_us = 0;
+    stats.max_feed_gap_us = 0;
+    stats.wdt_margin_us = 0;
+    stats.longest_span_us = 0;
+    stats.longest_span_id = LOOP_MONITOR_SPAN_UNKNOWN;
+    // Il prossimo periodo parte dalla prossima iterazione
+    iteration_started = false;
+}
+
+void loop_monitor_begin() {
+    loop_monitor_reset_stats();
+    last_feed_cycles = hal_cycles();
+    next_deadline = millis() + MAIN_LOOP_PERIOD;
+
+    LOG_I(LOOP, "Periodo %d ms, allarme iterazione > %d ms, watchdog %d ms (allarme margine < %d ms)",
+          MAIN_LOOP_PERIOD, LOOP_ALARM_ITERATION_MS, LOOP_WDT_TIMEOUT_MS, LOOP_ALARM_WDT_MARGIN_MS);
+}
+
+void loop_monitor_iteration_start() {
+    unsigned long now_us = micros();
+    if (iteration_started) {
+        period_histogram.record(now_us - iteration_start_us);
+    }
+    iteration_start_us = now_us;
+    iteration_started = true;
+
+    #ifdef TRACE_ENABLED
+    trace_reset_longest();
+    #endif
+    iteration_start_cycles = hal_cycles();
+}
+
+void loop_monitor_iteration_end() {
+    uint32_t iteration_us = (hal_cycles() - iteration_start_cycles) / hal_cycles_per_us();
+    iteration_histogram.record(iteration_us);
+    stats.iterations++;
+
+    // Sezione più lunga dell'iterazione (dagli span del trace)
+    uint8_t span_id = LOOP_MONITOR_SPAN_UNKNOWN;
+    uint32_t span_us = 0;
+    #ifdef TRACE_ENABLED
+    span_us = trace_longest(&span_id) / hal_cycles_per_us();
+    if (span_us == 0) span_id = LOOP_MONITOR_SPAN_UNKNOWN;
+    #endif
+
+    if (iteration_us >= stats.max_iteration_us) {
+        stats.max_iteration_us = iteration_us;
+        stats.longest_span_us = span_us;
+        stats.longest_span_id = span_id;
+    }
+
+    if (iteration_us > (uint32_t)LOOP_ALARM_ITERATION_MS * 1000) {
+        stats.alarms++;
+        #ifdef TRACE_ENABLED
+        LOG_EVERY(LOG_LEVEL_WARN, LOOP, 1000, "Iterazione lenta: %lu us (sezione più lunga: %s, %lu us)",
+                  (unsigned long)iteration_us, trace_span_name(span_id), (unsigned long)span_us);
+        #else
+        LOG_EVERY(LOG_LEVEL_WARN, LOOP, 1000, "Iterazione lenta: %lu us", (unsigned long)iteration_us);
+        #endif
+    }
+}
+
+void loop_monitor_feed() {
+    uint32_t now = hal_cycles();
+    uint32_t gap_us = (now - last_feed_cycles) / hal_cycles_per_us();
+    last_feed_cycles = now;
+
+    if (gap_us > stats.max_feed_gap_us) {
+        stats.max_feed_gap_us = gap_us;
+    }
+
+    uint32_t timeout_us = (uint32_t)LOOP_WDT_TIMEOUT_MS * 1000;
+    uint32_t margin_us = gap_us < timeout_us ? timeout_us - gap_us : 0;
+    if (margin_us < (uint32_t)LOOP_ALARM_WDT_MARGIN_MS * 1000) {
+        stats.alarms++;
+        LOG_EVERY(LOG_LEVEL_WARN, LOOP, 1000, "Margine watchdog %lu ms (%lu ms senza feed)",
+                  (unsigned long)(margin_us / 1000), (unsigned long)(gap_us / 1000));
+    }
+}
+
+uint32_t loop_monitor_wait() {
+    unsigned long now = millis();
+    long remaining = (long)(next_deadline - now);
+    if (remaining < 0) {
+        // Deadline mancato: si riparte da adesso senza recuperare i periodi persi
+        stats.overruns++;
+        next_deadline = now;
+        remaining = 0;
+    }
+    uint32_t wait_ms = remaining < LOOP_MIN_IDLE_MS ? LOOP_MIN_IDLE_MS : (uint32_t)remaining;
+
+    // Il feed avviene quando il loop si blocca: il tempo di attesa non conta nel gap
+    loop_monitor_feed();
+    delay(wait_ms);
+    last_feed_cycles = hal_cycles();
+
+    next_deadline += MAIN_LOOP_PERIOD;
+    return wait_ms;
+}
+
+LoopMonitorStats loop_monitor_get_stats() {
+    LoopMonitorStats result = stats;
+    uint32_t timeout_us = (uint32_t)LOOP_WDT_TIMEOUT_MS * 1000;
+    result.wdt_margin_us = stats.max_feed_gap_us < timeout_us ? timeout_us - stats.max_feed_gap_us : 0;
+    return result;
+}
+
+const LatencyHistogram& loop_monitor_iterations() {
+    return iteration_histogram;
+}
+
+const LatencyHistogram& loop_monitor_periods() {
+    return period_histogram;
+}
+
+const char* loop_monitor_longest_span_name() {
+    #ifdef TRACE_ENABLED
+    if (stats.longest_span_id != LOOP_MONITOR_SPAN_UNKNOWN) {
+        return trace_span_name(stats.longest_span_id);
+    }
+    #endif
+    return "n/d";
+}
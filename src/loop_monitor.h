@@ -0,0 +1,88 @@
+#ifndef LOOP_MONITOR_H
+#define LOOP_MONITOR_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "metrics.h"
+
+/**
+ * Monitor del loop principale e scheduling a deadline
+ *
+ *   void loop() {
+ *       loop_monitor_iteration_start();
+ *       ...lavoro del ciclo...
+ *       loop_monitor_iteration_end();
+ *       loop_monitor_wait();
+ *   }
+ *
+ * Misura la durata di ogni iterazione, il periodo tra due inizi e il tempo
+ * massimo tra due "feed" del watchdog. Sull'ESP32 il core Arduino serve il
+ * watchdog del loopTask tra due chiamate a loop() e quello del task idle solo
+ * quando il loop si blocca (delay): loop_monitor_wait() attende sempre almeno
+ * LOOP_MIN_IDLE_MS ed è il punto di feed. Il margine è LOOP_WDT_TIMEOUT_MS
+ * meno il tempo massimo osservato senza feed.
+ *
+ * Con TRACE_ENABLED ogni iterazione lenta riporta lo span più lungo (la
+ * sezione bloccante e il suo punto di chiamata); senza trace l'id è
+ * LOOP_MONITOR_SPAN_UNKNOWN.
+ *
+ * Scheduling: il prossimo inizio è il deadline precedente + MAIN_LOOP_PERIOD,
+ * non "fine ciclo + delay": la durata del lavoro non allunga il periodo. Se il
+ * ciclo è in ritardo oltre il deadline i periodi persi non vengono recuperati
+ * a raffica (overrun contato, deadline riallineato).
+ */
+
+#define LOOP_MONITOR_SPAN_UNKNOWN 0xFF
+
+/**
+ * Inizializza (fine di setup(): primo deadline e primo feed)
+ */
+void loop_monitor_begin();
+
+/**
+ * Inizio e fine del lavoro di un'iterazione
+ * La fine controlla le soglie e registra gli allarmi nel log (differito)
+ */
+void loop_monitor_iteration_start();
+void loop_monitor_iteration_end();
+
+/**
+ * Attende il prossimo deadline (almeno LOOP_MIN_IDLE_MS) e registra il feed
+ * @return Millisecondi attesi
+ */
+uint32_t loop_monitor_wait();
+
+/**
+ * Feed esplicito, per sezioni lunghe che si bloccano a metà (es. delay in un caricamento)
+ */
+void loop_monitor_feed();
+
+/**
+ * Statistiche del loop
+ */
+struct LoopMonitorStats {
+    unsigned long iterations;
+    unsigned long overruns;         // Iterazioni terminate oltre il deadline
+    unsigned long alarms;           // Iterazioni oltre LOOP_ALARM_ITERATION_MS o con margine WDT sotto soglia
+    uint32_t max_iteration_us;      // Iterazione più lunga
+    uint32_t max_feed_gap_us;       // Tempo massimo senza feed del watchdog
+    uint32_t wdt_margin_us;         // LOOP_WDT_TIMEOUT_MS - max_feed_gap_us (0 se superato)
+    uint32_t longest_span_us;       // Span più lungo nell'iterazione più lenta
+    uint8_t longest_span_id;        // TraceSpanId di quello span (LOOP_MONITOR_SPAN_UNKNOWN senza trace)
+};
+LoopMonitorStats loop_monitor_get_stats();
+
+/**
+ * Istogrammi: durata iterazioni e periodo tra due inizi (µs)
+ */
+const LatencyHistogram& loop_monitor_iterations();
+const LatencyHistogram& loop_monitor_periods();
+
+/**
+ * Nome della sezione più lunga (nome dello span, "n/d" senza trace)
+ */
+const char* loop_monitor_longest_span_name();
+
+void loop_monitor_reset_stats();
+
+#endif // LOOP_MONITOR_H
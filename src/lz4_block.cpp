@@ -0,0 +1,57 @@
+#include "lz4_block.h"
+
+#define LZ4_MIN_MATCH 4
+
+/**
+ * Lunghezza estesa: byte da 255 finché non arriva un byte più piccolo
+ */
+static bool read_length(const uint8_t*& ip, const uint8_t* end, uint32_t& length) {
+    uint8_t byte;
+    do {
+        if (ip >= end) return false;
+        byte = *ip++;
+        length += byte;
+    } while (byte == 255);
+    return true;
+}
+
+int lz4_block_decompress(const uint8_t* src, uint32_t src_size, uint8_t* dst, uint32_t dst_capacity) {
+    const uint8_t* ip = src;
+    const uint8_t* end = src + src_size;
+    uint8_t* op = dst;
+    uint8_t* dst_end = dst + dst_capacity;
+
+    while (ip < end) {
+        uint8_t token = *ip++;
+
+        uint32_t literals = token >> 4;
+        if (literals == 15 && !read_length(ip, end, literals)) return -1;
+        if (literals > (uint32_t)(end - ip) || literals > (uint32_t)(dst_end - op)) return -1;
+        memcpy(op, ip, literals);
+        ip += literals;
+        op += literals;
+
+        // L'ultima sequenza finisce dopo i letterali
+        if (ip == end) break;
+
+        if (end - ip < 2) return -1;
+        uint32_t offset = ip[0] | (ip[1] << 8);
+        ip += 2;
+        if (offset == 0 || offset > (uint32_t)(op - dst)) return -1;
+
+        uint32_t length = token & 0x0F;
+        if (length == 15 && !read_length(ip, end, length)) return -1;
+        length += LZ4_MIN_MATCH;
+        if (length > (uint32_t)(dst_end - op)) return -1;
+
+        // Con offset < lunghezza il match si sovrappone a ciò che scrive (run): byte per byte
+        const uint8_t* match = op - offset;
+        if (offset >= length) {
+            memcpy(op, match, length);
+            op += length;
+        } else {
+            while (length--) *op++ = *match++;
+        }
+    }
+    return (int)(op - dst);
+}
@@ -0,0 +1,20 @@
+#ifndef LZ4_BLOCK_H
+#define LZ4_BLOCK_H
+
+#include <Arduino.h>
+
+/**
+ * Decompressione nel formato di blocco LZ4 (senza frame né checksum)
+ *
+ * Sequenze di token (4 bit lunghezza letterali, 4 bit lunghezza match - 4),
+ * letterali, offset a 16 bit little-endian; l'ultima sequenza ha solo
+ * letterali. La finestra è il solo buffer di uscita: nessuna tabella, nessuna
+ * allocazione. Lo compattano make_speedcam_db.py e i bench host.
+ */
+
+/**
+ * @return Byte scritti in dst, -1 se il blocco non è valido o non entra in dst_capacity
+ */
+int lz4_block_decompress(const uint8_t* src, uint32_t src_size, uint8_t* dst, uint32_t dst_capacity);
+
+#endif // LZ4_BLOCK_H
@@ -0,0 +1,79 @@
+#include "metrics.h"
+
+LatencyHistogram::LatencyHistogram() {
+    reset();
+}
+
+void LatencyHistogram::reset() {
+    for (uint16_t i = 0; i < BUCKET_COUNT; i++) {
+        buckets[i] = 0;
+    }
+    samples = 0;
+    min_value = 0xFFFFFFFF;
+    max_value = 0;
+    total = 0;
+}
+
+uint16_t LatencyHistogram::bucketIndex(uint32_t value) {
+    // Valori piccoli: un bucket per valore
+    if (value < SUB_BUCKETS) {
+        return (uint16_t)value;
+    }
+    
+    // Posizione del bit più alto, poi i METRICS_HISTOGRAM_SUB_BITS bit successivi
+    uint8_t msb = 31 - __builtin_clz(value);
+    uint8_t shift = msb - METRICS_HISTOGRAM_SUB_BITS;
+    uint16_t sub = (value >> shift) & (SUB_BUCKETS - 1);
+    return (uint16_t)((shift + 1) * SUB_BUCKETS + sub);
+}
+
+uint32_t LatencyHistogram::bucketUpperBound(uint16_t index) {
+    if (index < SUB_BUCKETS) {
+        return index;
+    }
+    
+    uint8_t shift = index / SUB_BUCKETS - 1;
+    uint32_t sub = index % SUB_BUCKETS;
+    uint64_t low = ((uint64_t)(SUB_BUCKETS + sub)) << shift;
+    uint64_t high = low + ((uint64_t)1 << shift) - 1;
+    return high > 0xFFFFFFFF ? 0xFFFFFFFF : (uint32_t)high;
+}
+
+void LatencyHistogram::record(uint32_t value) {
+    buckets[bucketIndex(value)]++;
+    samples++;
+    total += value;
+    if (value < min_value) min_value = value;
+    if (value > max_value) max_value = value;
+}
+
+uint32_t LatencyHistogram::percentile(float p) const {
+    if (samples == 0) return 0;
+    
+    // Rango del campione richiesto (1..samples)
+    uint32_t rank = (uint32_t)ceilf(p / 100.0f * samples);
+    if (rank < 1) rank = 1;
+    if (rank > samples) rank = samples;
+    
+    uint32_t seen = 0;
+    for (uint16_t i = 0; i < BUCKET_COUNT; i++) {
+        seen += buckets[i];
+        if (seen >= rank) {
+            uint32_t bound = bucketUpperBound(i);
+            return bound < max_value ? bound : max_value;
+        }
+    }
+    return max_value;
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+    for (uint16_t i = 0; i < BUCKET_COUNT; i++) {
+        buckets[i] += other.buckets[i];
+    }
+    samples += other.samples;
+    total += other.total;
+    if (other.samples) {
+        if (other.min_value < min_value) min_value = other.min_value;
+        if (other.max_value > max_value) max_value = other.max_value;
+    }
+}
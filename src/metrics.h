@@ -0,0 +1,55 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <Arduino.h>
+#include "config.h"
+
+/**
+ * Istogramma di latenze a bucket logaritmici
+ * Ogni potenza di 2 è divisa in 2^METRICS_HISTOGRAM_SUB_BITS sotto-bucket lineari:
+ * errore relativo sui percentili <= 1/2^METRICS_HISTOGRAM_SUB_BITS, memoria fissa,
+ * record() in tempo costante (nessuna allocazione, utilizzabile anche sul firmware)
+ */
+class LatencyHistogram {
+public:
+    LatencyHistogram();
+    
+    /**
+     * Registra un campione (tipicamente microsecondi)
+     */
+    void record(uint32_t value);
+    
+    /**
+     * Percentile (0-100): limite superiore del bucket che lo contiene,
+     * mai oltre il massimo registrato
+     */
+    uint32_t percentile(float p) const;
+    
+    uint32_t count() const { return samples; }
+    uint32_t min() const { return samples ? min_value : 0; }
+    uint32_t max() const { return max_value; }
+    uint64_t sum() const { return total; }
+    uint32_t mean() const { return samples ? (uint32_t)(total / samples) : 0; }
+    
+    /**
+     * Somma i campioni di un altro istogramma
+     */
+    void merge(const LatencyHistogram& other);
+    
+    void reset();
+
+private:
+    static const uint8_t SUB_BUCKETS = 1 << METRICS_HISTOGRAM_SUB_BITS;
+    static const uint16_t BUCKET_COUNT = (32 - METRICS_HISTOGRAM_SUB_BITS + 1) * SUB_BUCKETS;
+    
+    uint32_t buckets[BUCKET_COUNT];
+    uint32_t samples;
+    uint32_t min_value;
+    uint32_t max_value;
+    uint64_t total;
+    
+    static uint16_t bucketIndex(uint32_t value);
+    static uint32_t bucketUpperBound(uint16_t index);
+};
+
+#endif // METRICS_H
@@ -0,0 +1,304 @@
+#include "metrics_console.h"
+#include "hal.h"
+#include "log.h"
+#include "loop_monitor.h"
+#include "arena.h"
+#include "gps_controller.h"
+#include "speedcam_controller.h"
+#include "display_controller.h"
+
+// Versione del protocollo: cambia se campi esistenti cambiano significato
+// (campi nuovi si aggiungono in coda, il client usa i nomi della riga H)
+#define METRICS_PROTOCOL_VERSION 1
+
+static const char* const field_names[] = {
+    "uptime_ms",
+    "loops",
+    "loop_p50_us",
+    "loop_p99_us",
+    "loop_max_us",
+    "period_p50_us",
+    "period_p99_us",
+    "period_max_us",
+    "jitter_us",
+    "checks",
+    "check_p50_us",
+    "check_p99_us",
+    "check_max_us",
+    "detections",
+    "gps_sentences",
+    "gps_valid",
+    "gps_fix_attempts",
+    "heap_free",
+    "heap_min_free",
+    "stack_free_min",
+    "spi_bytes",
+    "spi_windows",
+    "frames",
+    "last_alert_us",
+    "db_count",
+    "db_capacity",
+    "log_records",
+    "log_dropped",
+    "reports",
+    "overruns",
+    "loop_alarms",
+    "feed_gap_max_us",
+    "wdt_margin_us",
+    "longest_span_us",
+    "longest_span_id",
+    "arena_db_peak",
+    "arena_scratch_peak",
+    "arena_render_peak",
+    "arena_gps_peak",
+    "db_records",
+    "db_dropped",
+    "db_version",
+    "db_swaps",
+    "db_rejected",
+    "db_patch_size",
+    "sections",
+    "section_entries",
+    "section_completed",
+    "section_over_limit",
+    "section_aborted",
+    "corridor_matches",
+    "corridor_matched",
+    "corridor_suppressed",
+    "corridor_max_segments",
+    "overspeed_warnings",
+    "overspeed_brake",
+    "overspeed_critical",
+    "overspeed_max_decel",
+    "lookahead_refills",
+    "lookahead_passed",
+    "alert_transitions",
+    "preview_updates",
+};
+
+#define FIELD_COUNT (sizeof(field_names) / sizeof(field_names[0]))
+
+/**
+ * Valori del report nell'ordine di field_names. Un campo in più non scrive
+ * oltre l'array ma viene contato: printReport() confronta il totale con FIELD_COUNT
+ */
+struct ReportValues {
+    uint32_t values[FIELD_COUNT];
+    size_t count = 0;
+
+    void add(uint32_t value) {
+        if (count < FIELD_COUNT) values[count] = value;
+        count++;
+    }
+};
+
+MetricsConsole::MetricsConsole() :
+    stream(nullptr),
+    gps_controller(nullptr),
+    speedcam_controller(nullptr),
+    display_controller(nullptr),
+    reports(0) {
+}
+
+void MetricsConsole::begin(Stream* stream, GPSController* gps_controller,
+                           SpeedcamController* speedcam_controller, DisplayController* display_controller) {
+    this->stream = stream;
+    this->gps_controller = gps_controller;
+    this->speedcam_controller = speedcam_controller;
+    this->display_controller = display_controller;
+}
+
+int MetricsConsole::poll() {
+    if (!stream) return -1;
+
+    // Solo i byte già ricevuti: nessuna attesa nel loop
+    int unhandled = -1;
+    while (stream->available() > 0) {
+        int c = stream->read();
+        if (c == METRICS_COMMAND_REPORT) {
+            printReport(*stream);
+            reports++;
+        } else if (c == METRICS_COMMAND_HEADER) {
+            printHeader(*stream);
+        } else if (c == METRICS_COMMAND_RESET) {
+            reset();
+            stream->print("#MNR,");
+            stream->println(METRICS_PROTOCOL_VERSION);
+        } else if (c >= 0 && c != '\r' && c != '\n' && c != ' ') {
+            // Altri comandi (es. dump trace) restano al chiamante
+            unhandled = c;
+            break;
+        }
+    }
+    return unhandled;
+}
+
+void MetricsConsole::printHeader(Print& out) const {
+    out.print("#MNH,");
+    out.print(METRICS_PROTOCOL_VERSION);
+    for (size_t i = 0; i < FIELD_COUNT; i++) {
+        out.write(',');
+        out.print(field_names[i]);
+    }
+    out.println();
+}
+
+void MetricsConsole::printReport(Print& out) const {
+    ReportValues values;
+
+    LoopMonitorStats loop_stats = loop_monitor_get_stats();
+    const LatencyHistogram& loop_work = loop_monitor_iterations();
+    const LatencyHistogram& loop_period = loop_monitor_periods();
+
+    values.add(millis());
+    values.add(loop_stats.iterations);
+    values.add(loop_work.percentile(50));
+    values.add(loop_work.percentile(99));
+    values.add(loop_work.max());
+    values.add(loop_period.percentile(50));
+    values.add(loop_period.percentile(99));
+    values.add(loop_period.max());
+    values.add(loop_period.percentile(99) - loop_period.percentile(50));
+
+    if (speedcam_controller) {
+        SpeedcamController::Stats stats = speedcam_controller->getStats();
+        const LatencyHistogram& check = speedcam_controller->getCheckLatency();
+        values.add(stats.checks_count);
+        values.add(check.percentile(50));
+        values.add(check.percentile(99));
+        values.add(check.max());
+        values.add(stats.detections_count);
+    } else {
+        for (int i = 0; i < 5; i++) values.add(0);
+    }
+
+    if (gps_controller) {
+        GPSController::Stats stats = gps_controller->getStats();
+        values.add(stats.sentences_received);
+        values.add(stats.valid_sentences);
+        values.add(stats.fix_attempts);
+    } else {
+        for (int i = 0; i < 3; i++) values.add(0);
+    }
+
+    values.add(hal_free_heap());
+    values.add(hal_min_free_heap());
+    values.add(hal_stack_free_min());
+
+    if (display_controller) {
+        DisplayController::Stats stats = display_controller->getStats();
+        values.add(stats.spi_bytes);
+        values.add(stats.spi_windows);
+        values.add(stats.frames);
+        values.add(stats.last_alert_cycles / hal_cycles_per_us());
+    } else {
+        for (int i = 0; i < 4; i++) values.add(0);
+    }
+
+    values.add(speedcam_controller ? speedcam_controller->getSpeedcamCount() : 0);
+    values.add(speedcam_controller ? speedcam_controller->getSpeedcamCapacity() : 0);
+
+    LogStats log_stats = log_get_stats();
+    values.add(log_stats.records);
+    values.add(log_stats.dropped);
+    values.add(reports);
+
+    values.add(loop_stats.overruns);
+    values.add(loop_stats.alarms);
+    values.add(loop_stats.max_feed_gap_us);
+    values.add(loop_stats.wdt_margin_us);
+    values.add(loop_stats.longest_span_us);
+    values.add(loop_stats.longest_span_id);
+
+    for (uint8_t i = 0; i < ARENA_REGION_COUNT; i++) {
+        values.add(arena_get((ArenaRegion)i).peak());
+    }
+
+    if (speedcam_controller) {
+        const SpeedcamLoadStats& load = speedcam_controller->getLoadStats();
+        values.add(load.records);
+        values.add(load.dropped_invalid + load.dropped_distance + load.dropped_budget);
+        SpeedcamController::Stats stats = speedcam_controller->getStats();
+        values.add(load.db_version);
+        values.add(stats.db_swaps);
+        values.add(stats.db_rejected);
+        values.add(load.patch_size);
+    } else {
+        for (int i = 0; i < 6; i++) values.add(0);
+    }
+
+    if (speedcam_controller) {
+        const SectionTracker& sections = speedcam_controller->getSections();
+        SectionTracker::Stats stats = sections.getStats();
+        values.add(sections.getSectionCount());
+        values.add(stats.entries);
+        values.add(stats.completed);
+        values.add(stats.over_limit);
+        values.add(stats.aborted);
+    } else {
+        for (int i = 0; i < 5; i++) values.add(0);
+    }
+
+    if (speedcam_controller) {
+        CorridorMap::Stats stats = speedcam_controller->getCorridors().getStats();
+        values.add(stats.matches);
+        values.add(stats.matched);
+        values.add(stats.suppressed);
+        values.add(stats.max_segments);
+    } else {
+        for (int i = 0; i < 4; i++) values.add(0);
+    }
+
+    if (speedcam_controller) {
+        OverspeedMonitor::Stats stats = speedcam_controller->getOverspeed().getStats();
+        values.add(stats.warnings);
+        values.add(stats.brake);
+        values.add(stats.critical);
+        values.add(stats.max_decel);
+    } else {
+        for (int i = 0; i < 4; i++) values.add(0);
+    }
+
+    if (speedcam_controller) {
+        SpeedcamLookahead::Stats stats = speedcam_controller->getLookahead().getStats();
+        values.add(stats.refills);
+        values.add(stats.passed);
+    } else {
+        for (int i = 0; i < 2; i++) values.add(0);
+    }
+
+    if (display_controller) {
+        DisplayController::Stats stats = display_controller->getStats();
+        values.add(stats.alert_transitions);
+        values.add(stats.preview_updates);
+    } else {
+        for (int i = 0; i < 2; i++) values.add(0);
+    }
+
+    // Campi non allineati a field_names: la riga non viene inviata (il client
+    // assegnerebbe i valori ai nomi sbagliati)
+    if (values.count != FIELD_COUNT) {
+        out.print("[Metrics] ERRORE: report con ");
+        out.print((unsigned long)values.count);
+        out.print(" campi invece di ");
+        out.println((unsigned long)FIELD_COUNT);
+        return;
+    }
+
+    out.print("#MN,");
+    out.print(METRICS_PROTOCOL_VERSION);
+    for (size_t i = 0; i < FIELD_COUNT; i++) {
+        out.write(',');
+        out.print(values.values[i]);
+    }
+    out.println();
+}
+
+void MetricsConsole::reset() {
+    reports = 0;
+    loop_monitor_reset_stats();
+    log_reset_stats();
+    if (gps_controller) gps_controller->resetStats();
+    if (speedcam_controller) speedcam_controller->resetStats();
+    if (display_controller) display_controller->resetStats();
+}
@@ -0,0 +1,66 @@
+#ifndef METRICS_CONSOLE_H
+#define METRICS_CONSOLE_H
+
+#include <Arduino.h>
+#include "config.h"
+
+// Forward declaration
+class GPSController;
+class SpeedcamController;
+class DisplayController;
+
+/**
+ * Console metriche sulla seriale USB
+ *
+ * Protocollo a comandi di un carattere (METRICS_COMMAND_* in config.h), letti
+ * senza bloccare con i byte già disponibili; ogni risposta è una riga:
+ *
+ *   H  ->  #MNH,<versione>,uptime_ms,loops,...      nomi dei campi
+ *   M  ->  #MN,<versione>,123456,1200,...            valori, stesso ordine
+ *   R  ->  #MNR,<versione>                          contatori e istogrammi azzerati
+ *
+ * Le righe iniziano con '#MN' e si distinguono dai log [Modulo] sulla stessa
+ * seriale. Durata e periodo del loop vengono da loop_monitor.h.
+ * Gli istogrammi sono cumulativi dall'avvio o dall'ultimo R: per
+ * percentili su finestra il client invia R dopo ogni M (metrics_cli.py --window).
+ * Tempi in µs, memoria in byte.
+ */
+class MetricsConsole {
+public:
+    MetricsConsole();
+
+    /**
+     * Inizializza la console
+     * @param stream Seriale dei comandi e delle risposte
+     * I controller sono opzionali (campi a 0 se nullptr)
+     */
+    void begin(Stream* stream, GPSController* gps_controller,
+               SpeedcamController* speedcam_controller, DisplayController* display_controller);
+
+    /**
+     * Legge ed esegue i comandi arrivati (da chiamare in loop())
+     * @return Carattere ricevuto non gestito dalla console (es. TRACE_DUMP_COMMAND), -1 se nessuno
+     */
+    int poll();
+
+    /**
+     * Scrive le righe del protocollo (anche senza comando, es. a fine replay host)
+     */
+    void printHeader(Print& out) const;
+    void printReport(Print& out) const;
+
+    /**
+     * Azzera contatori e istogrammi (console, monitor del loop e controller)
+     */
+    void reset();
+
+private:
+    Stream* stream;
+    GPSController* gps_controller;
+    SpeedcamController* speedcam_controller;
+    DisplayController* display_controller;
+
+    unsigned long reports;
+};
+
+#endif // METRICS_CONSOLE_H
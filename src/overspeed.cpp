@@ -0,0 +1,126 @@
+#include "overspeed.h"
+#include "span_raster.h"
+#include "utils.h"
+
+// Soglie in cm/s² (costanti di compilazione: nessun float per fix)
+static const uint32_t BRAKE_DECEL_CMS2 = (uint32_t)(OVERSPEED_BRAKE_DECEL * 100.0);
+static const uint32_t CRITICAL_DECEL_CMS2 = (uint32_t)(OVERSPEED_CRITICAL_DECEL * 100.0);
+
+OverspeedMonitor::OverspeedMonitor() {
+    clearTarget();
+    resetStats();
+}
+
+void OverspeedMonitor::setTarget(const Speedcam& speedcam) {
+    if (target_id == speedcam.id) return;
+    clearTarget();
+    target_id = speedcam.id;
+    target_lat_e6 = (int32_t)lround(speedcam.lat * 1000000.0);
+    target_lng_e6 = (int32_t)lround(speedcam.lng * 1000000.0);
+    // Coseno una volta per speedcam: sulla distanza di un alert la latitudine non cambia
+    cos_lat_q15 = (int32_t)(cos(deg_to_rad(speedcam.lat)) * 32768.0);
+    if (cos_lat_q15 < 1) cos_lat_q15 = 1;
+    vmax_kmh = speedcam.vmax;
+}
+
+void OverspeedMonitor::clearTarget() {
+    target_id = 0;
+    target_lat_e6 = 0;
+    target_lng_e6 = 0;
+    cos_lat_q15 = 32768;
+    vmax_kmh = 0;
+    level = OVERSPEED_NONE;
+    passed = false;
+    lowering = false;
+    lower_since = 0;
+    distance_cm = UINT32_MAX;
+    min_distance_cm = UINT32_MAX;
+    required_decel = 0;
+}
+
+OverspeedLevel OverspeedMonitor::evaluate(const OverspeedFix& fix) {
+    required_decel = 0;
+
+    // Distanza in microgradi di latitudine, longitudine scalata per il coseno
+    int32_t dlat = fix.lat_e6 - target_lat_e6;
+    int32_t dlng = (int32_t)(((int64_t)(fix.lng_e6 - target_lng_e6) * cos_lat_q15) >> 15);
+    if (dlat > OVERSPEED_RANGE_E6 || dlat < -OVERSPEED_RANGE_E6 ||
+        dlng > OVERSPEED_RANGE_E6 || dlng < -OVERSPEED_RANGE_E6) {
+        distance_cm = UINT32_MAX;
+        return OVERSPEED_NONE;
+    }
+    uint32_t d2 = (uint32_t)(dlat * dlat) + (uint32_t)(dlng * dlng);
+    distance_cm = (uint32_t)span_isqrt(d2) * 1112 / 100;  // 1 microgrado = 11.12 cm
+
+    // Superata: la distanza risale oltre il minimo visto
+    if (distance_cm < min_distance_cm) {
+        min_distance_cm = distance_cm;
+    } else if (distance_cm > min_distance_cm + OVERSPEED_PASSED_M * 100) {
+        passed = true;
+    }
+    if (passed || vmax_kmh == 0) {
+        return OVERSPEED_NONE;
+    }
+    if (fix.speed_x10 <= (uint32_t)(vmax_kmh + OVERSPEED_MARGIN_KMH) * 10) {
+        return OVERSPEED_NONE;
+    }
+
+    // Velocità in cm/s: km/h x 10 * 100000 / 36000
+    uint32_t v = (uint32_t)fix.speed_x10 * 25 / 9;
+    uint32_t v_limit = (uint32_t)vmax_kmh * 250 / 9;
+    uint32_t reaction_cm = v * OVERSPEED_REACTION_MS / 1000;
+    if (distance_cm <= reaction_cm) {
+        // Speedcam entro lo spazio di reazione: la decelerazione non è più
+        // calcolabile e qui anche pochi km/h oltre darebbero il beep. Al più
+        // frenata; il critico resta ai casi arrivati fin qui con la decelerazione
+        required_decel = UINT32_MAX;
+        return OVERSPEED_BRAKE;
+    }
+    uint64_t dv2 = (uint64_t)v * v - (uint64_t)v_limit * v_limit;
+    required_decel = (uint32_t)(dv2 / (2 * (uint64_t)(distance_cm - reaction_cm)));
+    if (required_decel > stats.max_decel) stats.max_decel = required_decel;
+
+    if (required_decel >= CRITICAL_DECEL_CMS2) return OVERSPEED_CRITICAL;
+    if (required_decel >= BRAKE_DECEL_CMS2) return OVERSPEED_BRAKE;
+    return OVERSPEED_OVER;
+}
+
+bool OverspeedMonitor::update(const OverspeedFix& fix) {
+    if (!target_id) return false;
+    stats.updates++;
+
+    OverspeedLevel next = evaluate(fix);
+    if (next >= level) {
+        // Salita immediata
+        lowering = false;
+        return setLevel(next);
+    }
+    if (passed) {
+        lowering = false;
+        return setLevel(OVERSPEED_NONE);
+    }
+    // Discesa solo dopo OVERSPEED_RELEASE_MS sempre sotto il livello corrente
+    if (!lowering) {
+        lowering = true;
+        lower_since = fix.time_ms;
+        return false;
+    }
+    if (fix.time_ms - lower_since < OVERSPEED_RELEASE_MS) {
+        return false;
+    }
+    lowering = false;
+    return setLevel(next);
+}
+
+bool OverspeedMonitor::setLevel(OverspeedLevel next) {
+    if (next == level) return false;
+    if (level == OVERSPEED_NONE) stats.warnings++;
+    if (next >= OVERSPEED_BRAKE && level < OVERSPEED_BRAKE) stats.brake++;
+    if (next == OVERSPEED_CRITICAL) stats.critical++;
+    level = next;
+    return true;
+}
+
+void OverspeedMonitor::resetStats() {
+    memset(&stats, 0, sizeof(stats));
+}
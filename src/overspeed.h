@@ -0,0 +1,111 @@
+#ifndef OVERSPEED_H
+#define OVERSPEED_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "speedcam.h"
+
+/**
+ * Avviso di eccesso di velocità verso la speedcam dell'alert
+ *
+ * A ogni fix confronta la velocità con il limite (vmax intero dal database) e
+ * calcola la decelerazione necessaria per arrivare alla speedcam al limite,
+ * dopo un tempo di reazione: a = (v² - vmax²) / (2 * (d - v * t_reazione)).
+ * Il livello sale subito e scende solo dopo OVERSPEED_RELEASE_MS sotto il
+ * livello corrente (niente lampeggi con il rumore del GPS). Il calcolo per fix
+ * è tutto intero: microgradi, cm e cm/s.
+ */
+
+enum OverspeedLevel : uint8_t {
+    OVERSPEED_NONE = 0,         // Entro il limite (o nessuna speedcam con limite)
+    OVERSPEED_OVER,             // Oltre vmax + OVERSPEED_MARGIN_KMH: colore
+    OVERSPEED_BRAKE,            // Decelerazione necessaria >= OVERSPEED_BRAKE_DECEL o speedcam entro il tempo di reazione: lampeggio
+    OVERSPEED_CRITICAL          // Decelerazione necessaria >= OVERSPEED_CRITICAL_DECEL: beep
+};
+
+#define OVERSPEED_PASSED_M 10       // Allontanamento dalla distanza minima oltre cui la speedcam è superata
+#define OVERSPEED_RANGE_E6 40000    // Oltre ~4.4 km (microgradi per asse) nessun avviso
+
+/**
+ * Un fix in interi (da GPSPosition, senza dipendere dal parser NMEA)
+ */
+struct OverspeedFix {
+    int32_t lat_e6;             // Microgradi
+    int32_t lng_e6;
+    uint16_t speed_x10;         // Decimi di km/h
+    uint32_t time_ms;           // Ora del fix (ms, crescente salvo overflow)
+};
+
+/**
+ * Conversione al confine con il GPS (una per fix, il resto è intero)
+ */
+inline OverspeedFix overspeed_fix(double lat, double lng, float speed_kmh, uint32_t time_ms) {
+    OverspeedFix fix;
+    fix.lat_e6 = (int32_t)lround(lat * 1000000.0);
+    fix.lng_e6 = (int32_t)lround(lng * 1000000.0);
+    fix.speed_x10 = speed_kmh <= 0.0f ? 0 : speed_kmh >= 6553.0f ? 65535 : (uint16_t)(speed_kmh * 10.0f + 0.5f);
+    fix.time_ms = time_ms;
+    return fix;
+}
+
+class OverspeedMonitor {
+public:
+    OverspeedMonitor();
+
+    /**
+     * Speedcam verso cui valutare la velocità (quella dell'alert). Stessa
+     * speedcam: nessun effetto; altrimenti il livello riparte da OVERSPEED_NONE.
+     */
+    void setTarget(const Speedcam& speedcam);
+    void clearTarget();
+    bool hasTarget() const { return target_id != 0; }
+    uint32_t getTargetId() const { return target_id; }
+
+    /**
+     * Valuta un fix (solo interi)
+     * @return true se il livello è cambiato
+     */
+    bool update(const OverspeedFix& fix);
+
+    OverspeedLevel getLevel() const { return level; }
+    uint32_t getDistanceCm() const { return distance_cm; }
+    uint32_t getRequiredDecel() const { return required_decel; }  // cm/s² (UINT32_MAX entro lo spazio di reazione)
+
+    /**
+     * Statistiche
+     */
+    struct Stats {
+        unsigned long updates;          // Fix valutati con una speedcam
+        unsigned long warnings;         // Passaggi da OVERSPEED_NONE a un avviso
+        unsigned long brake;            // Ingressi in OVERSPEED_BRAKE (o oltre)
+        unsigned long critical;         // Ingressi in OVERSPEED_CRITICAL
+        uint32_t max_decel;             // Decelerazione necessaria massima (cm/s²)
+    };
+    Stats getStats() const { return stats; }
+    void resetStats();
+
+private:
+    uint32_t target_id;
+    int32_t target_lat_e6;
+    int32_t target_lng_e6;
+    int32_t cos_lat_q15;        // Coseno della latitudine della speedcam (Q15)
+    uint16_t vmax_kmh;
+
+    OverspeedLevel level;
+    bool passed;
+    bool lowering;              // Livello calcolato sotto quello corrente da lower_since
+    uint32_t lower_since;
+    uint32_t distance_cm;
+    uint32_t min_distance_cm;
+    uint32_t required_decel;
+
+    Stats stats;
+
+    /**
+     * Livello per il fix, senza isteresi
+     */
+    OverspeedLevel evaluate(const OverspeedFix& fix);
+    bool setLevel(OverspeedLevel next);
+};
+
+#endif // OVERSPEED_H
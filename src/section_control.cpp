@@ -0,0 +1,225 @@
+#include "section_control.h"
+#include "utils.h"
+#include "log.h"
+
+// Ore GPS: l'ora del giorno ricomincia a mezzanotte
+#define SECTION_DAY_MS 86400000UL
+// Metri per grado di latitudine, con margine (scarto rapido attorno ai portali)
+#define SECTION_METERS_PER_DEGREE (6371000.0 * M_PI / 180.0 / 1.01)
+
+SectionTracker::SectionTracker() :
+    section_count(0),
+    last_lat(0.0),
+    last_lng(0.0),
+    entry_time(0),
+    last_time(0),
+    gps_time(false),
+    blocked_start_id(0) {
+    memset(&status, 0, sizeof(status));
+    memset(&stats, 0, sizeof(stats));
+}
+
+int SectionTracker::build(const Speedcam* speedcams, int count) {
+    section_count = 0;
+    stats.unpaired = 0;
+
+    // Inizi: tratte ancora senza fine
+    for (int i = 0; i < count; i++) {
+        const Speedcam& sc = speedcams[i];
+        if (strcmp(sc.type, SECTION_TYPE_START) != 0) continue;
+        if (section_count == SECTION_MAX) {
+            stats.unpaired++;
+            continue;
+        }
+        SpeedcamSection& section = sections[section_count++];
+        section.start_id = sc.id;
+        section.end_id = 0;
+        section.start_lat = sc.lat;
+        section.start_lng = sc.lng;
+        section.length_m = 0.0f;
+        section.vmax_kmh = sc.vmax;
+    }
+
+    // Fini: ciascuna all'inizio libero più vicino con lo stesso limite
+    for (int i = 0; i < count && section_count > 0; i++) {
+        const Speedcam& sc = speedcams[i];
+        if (strcmp(sc.type, SECTION_TYPE_END) != 0) continue;
+        uint16_t vmax = sc.vmax;
+        int best = -1;
+        float best_distance = SECTION_MAX_LENGTH_M;
+        for (int s = 0; s < section_count; s++) {
+            const SpeedcamSection& section = sections[s];
+            if (section.end_id != 0) continue;
+            if (vmax && section.vmax_kmh && vmax != section.vmax_kmh) continue;
+            float distance = calculate_distance(section.start_lat, section.start_lng, sc.lat, sc.lng);
+            if (distance < best_distance) {
+                best_distance = distance;
+                best = s;
+            }
+        }
+        if (best < 0) {
+            stats.unpaired++;
+            continue;
+        }
+        SpeedcamSection& section = sections[best];
+        section.end_id = sc.id;
+        section.end_lat = sc.lat;
+        section.end_lng = sc.lng;
+        section.length_m = best_distance;
+        if (!section.vmax_kmh) section.vmax_kmh = vmax;
+    }
+
+    // Compatta: restano solo le tratte con entrambi i portali
+    int linked = 0;
+    for (int s = 0; s < section_count; s++) {
+        if (sections[s].end_id == 0) {
+            stats.unpaired++;
+            continue;
+        }
+        sections[linked++] = sections[s];
+    }
+    section_count = linked;
+
+    if (section_count > 0 || stats.unpaired > 0) {
+        LOG_I(SECTION, "Tutor: %d tratte collegate, %lu portali senza corrispondente",
+              section_count, stats.unpaired);
+    }
+    return section_count;
+}
+
+uint32_t SectionTracker::elapsedSince(uint32_t from, const SectionFix& fix) const {
+    if (fix.gps_time) {
+        return (fix.time_ms + SECTION_DAY_MS - from) % SECTION_DAY_MS;
+    }
+    return fix.time_ms - from;
+}
+
+bool SectionTracker::update(const SectionFix& fix) {
+    if (!status.active) {
+        return section_count > 0 && enter(fix);
+    }
+
+    // Stesso fix ricevuto più volte (una callback per frase NMEA)
+    if (fix.gps_time == gps_time && fix.time_ms == last_time) {
+        return false;
+    }
+    if (fix.gps_time != gps_time || elapsedSince(last_time, fix) > SECTION_FIX_TIMEOUT_MS) {
+        finish(false, "fix perso");
+        return true;
+    }
+
+    // Tempo costante: un tratto dall'ultimo fix e la distanza dal portale di fine
+    status.travelled_m += calculate_distance(last_lat, last_lng, fix.lat, fix.lng);
+    last_lat = fix.lat;
+    last_lng = fix.lng;
+    last_time = fix.time_ms;
+    status.elapsed_ms = elapsedSince(entry_time, fix);
+    status.remaining_m = calculate_distance(fix.lat, fix.lng, status.section.end_lat, status.section.end_lng);
+    updateProjection(fix.speed_kmh);
+
+    if (status.remaining_m <= SECTION_GATE_RADIUS_M) {
+        finish(true, nullptr);
+    } else if (status.travelled_m > status.section.length_m * SECTION_MAX_DETOUR + SECTION_GATE_RADIUS_M) {
+        finish(false, "uscita dal percorso");
+    }
+    return true;
+}
+
+bool SectionTracker::enter(const SectionFix& fix) {
+    double dlat = SECTION_GATE_RADIUS_M / SECTION_METERS_PER_DEGREE;
+    double cos_lat = cos(deg_to_rad(fix.lat));
+    double dlng = dlat / max(cos_lat, 0.01);
+
+    for (int s = 0; s < section_count; s++) {
+        const SpeedcamSection& section = sections[s];
+        // Scarto rapido fuori dal quadrato del portale
+        bool near_gate = fabs(fix.lat - section.start_lat) <= dlat && fabs(fix.lng - section.start_lng) <= dlng &&
+                         calculate_distance(fix.lat, fix.lng, section.start_lat, section.start_lng) <= SECTION_GATE_RADIUS_M;
+        if (section.start_id == blocked_start_id) {
+            if (!near_gate) blocked_start_id = 0;
+            continue;
+        }
+        if (!near_gate) continue;
+
+        // In marcia la rotta deve puntare verso la fine (non si entra percorrendo la tratta al contrario)
+        if (fix.speed_kmh >= SECTION_MIN_SPEED_KMH) {
+            double to_end_x = (section.end_lng - fix.lng) * cos_lat;
+            double to_end_y = section.end_lat - fix.lat;
+            double course = deg_to_rad(fix.course_deg);
+            if (to_end_x * sin(course) + to_end_y * cos(course) <= 0.0) continue;
+        }
+
+        status.active = true;
+        status.section = section;
+        status.travelled_m = 0.0f;
+        status.elapsed_ms = 0;
+        status.remaining_m = calculate_distance(fix.lat, fix.lng, section.end_lat, section.end_lng);
+        last_lat = fix.lat;
+        last_lng = fix.lng;
+        entry_time = fix.time_ms;
+        last_time = fix.time_ms;
+        gps_time = fix.gps_time;
+        updateProjection(fix.speed_kmh);
+        stats.entries++;
+
+        LOG_I(SECTION, "Tutor: ingresso tratta %u -> %u (%.1f km, limite %u km/h)",
+              section.start_id, section.end_id, section.length_m / 1000.0f, section.vmax_kmh);
+        return true;
+    }
+    return false;
+}
+
+void SectionTracker::updateProjection(float speed_kmh) {
+    float elapsed_s = status.elapsed_ms / 1000.0f;
+    float speed_ms = max(speed_kmh, (float)SECTION_MIN_SPEED_KMH) / 3.6f;
+    status.average_kmh = elapsed_s > 0.0f ? status.travelled_m / elapsed_s * 3.6f : speed_kmh;
+
+    // Resto della tratta alla velocità attuale
+    float total_m = status.travelled_m + status.remaining_m;
+    float total_s = elapsed_s + status.remaining_m / speed_ms;
+    status.projected_kmh = total_s > 0.0f ? total_m / total_s * 3.6f : speed_kmh;
+
+    uint16_t vmax = status.section.vmax_kmh;
+    if (vmax == 0) {
+        status.margin_kmh = 0.0f;
+        status.allowed_kmh = SECTION_NO_LIMIT;
+        return;
+    }
+    status.margin_kmh = vmax - status.projected_kmh;
+    // Tempo minimo per uscire con la media al limite, e quanto ne resta
+    float left_s = total_m / (vmax / 3.6f) - elapsed_s;
+    float allowed = left_s > 0.0f ? status.remaining_m / left_s * 3.6f : SECTION_NO_LIMIT;
+    status.allowed_kmh = min(allowed, SECTION_NO_LIMIT);
+}
+
+void SectionTracker::finish(bool completed, const char* reason) {
+    const SpeedcamSection& section = status.section;
+    if (completed) {
+        // Media all'uscita: include gli ultimi metri fino al portale alla velocità attuale
+        stats.completed++;
+        stats.last_average_kmh = status.projected_kmh;
+        if (section.vmax_kmh && status.projected_kmh > section.vmax_kmh) {
+            stats.over_limit++;
+        }
+        LOG_I(SECTION, "Tutor: tratta %u -> %u completata, media %.1f km/h (limite %u) in %lu s",
+              section.start_id, section.end_id, status.projected_kmh, section.vmax_kmh,
+              (unsigned long)(status.elapsed_ms / 1000));
+    } else {
+        stats.aborted++;
+        LOG_I(SECTION, "Tutor: tratta %u -> %u interrotta (%s) dopo %.0f m",
+              section.start_id, section.end_id, reason, status.travelled_m);
+    }
+    blocked_start_id = section.start_id;
+    status.active = false;
+}
+
+void SectionTracker::reset() {
+    status.active = false;
+}
+
+void SectionTracker::resetStats() {
+    unsigned long unpaired = stats.unpaired;
+    memset(&stats, 0, sizeof(stats));
+    // Portali senza corrispondente: esito dell'ultimo build, non un contatore
+    stats.unpaired = unpaired;
+}
@@ -0,0 +1,123 @@
+#ifndef SECTION_CONTROL_H
+#define SECTION_CONTROL_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "speedcam.h"
+
+/**
+ * Tutor: controllo della velocità media su tratta
+ *
+ * Le tratte sono coppie di speedcam del database (type SECTION_TYPE_START e
+ * SECTION_TYPE_END) collegate dopo ogni caricamento. Passato il portale di
+ * inizio nella direzione della fine, ogni fix aggiorna in tempo costante la
+ * velocità media (distanza percorsa tra i fix / tempo GPS dall'ingresso) e la
+ * proiezione all'uscita; al portale di fine la tratta è completata.
+ */
+
+/**
+ * Una tratta: portali copiati dal database (restano validi se il database cambia)
+ */
+struct SpeedcamSection {
+    uint32_t start_id;
+    uint32_t end_id;
+    float start_lat;
+    float start_lng;
+    float end_lat;
+    float end_lng;
+    float length_m;         // Distanza in linea d'aria tra i portali
+    uint16_t vmax_kmh;      // Limite della tratta (0 = sconosciuto)
+};
+
+/**
+ * Stato della tratta in corso, per il display
+ */
+struct SectionStatus {
+    bool active;
+    SpeedcamSection section;
+    float travelled_m;      // Percorsi dall'ingresso (somma delle distanze tra i fix)
+    uint32_t elapsed_ms;    // Dall'ingresso (ora GPS)
+    float remaining_m;      // Al portale di fine, in linea d'aria
+    float average_kmh;      // Media finora
+    float projected_kmh;    // Media all'uscita mantenendo la velocità attuale
+    float margin_kmh;       // vmax - projected_kmh (negativo = media oltre il limite)
+    float allowed_kmh;      // Velocità massima sul resto per uscire con la media al limite
+                            // (SECTION_NO_LIMIT se il tempo minimo è già trascorso)
+};
+
+#define SECTION_NO_LIMIT 999.0f
+
+/**
+ * Un fix GPS (da GPSPosition, senza dipendere dal parser NMEA)
+ */
+struct SectionFix {
+    double lat;
+    double lng;
+    float speed_kmh;
+    float course_deg;
+    uint32_t time_ms;       // Ora UTC in ms dalla mezzanotte, o millis() del fix se !gps_time
+    bool gps_time;
+};
+
+class SectionTracker {
+public:
+    SectionTracker();
+
+    /**
+     * Collega le tratte del database: ogni fine all'inizio ancora libero più
+     * vicino entro SECTION_MAX_LENGTH_M, con lo stesso limite (o senza limite).
+     * Una tratta in corso prosegue (i portali sono copiati nello stato).
+     * @return Tratte collegate
+     */
+    int build(const Speedcam* speedcams, int count);
+
+    /**
+     * Aggiorna con un nuovo fix (tempo costante con una tratta in corso)
+     * @return true se lo stato è cambiato (ingresso, aggiornamento o uscita)
+     */
+    bool update(const SectionFix& fix);
+
+    /**
+     * Termina la tratta in corso senza completarla (es. database cambiato)
+     */
+    void reset();
+
+    const SectionStatus& getStatus() const { return status; }
+    int getSectionCount() const { return section_count; }
+    const SpeedcamSection* getSections() const { return sections; }
+
+    /**
+     * Statistiche
+     */
+    struct Stats {
+        unsigned long entries;          // Ingressi in tratta
+        unsigned long completed;        // Uscite dal portale di fine
+        unsigned long over_limit;       // Completate con media oltre vmax
+        unsigned long aborted;          // Fix perso o uscita dal percorso
+        unsigned long unpaired;         // Portali senza corrispondente (ultimo build)
+        float last_average_kmh;         // Media dell'ultima tratta completata
+    };
+    Stats getStats() const { return stats; }
+    void resetStats();
+
+private:
+    SpeedcamSection sections[SECTION_MAX];
+    int section_count;
+
+    SectionStatus status;
+    double last_lat;            // Ultimo fix in tratta
+    double last_lng;
+    uint32_t entry_time;        // Ora del fix di ingresso (ms)
+    uint32_t last_time;
+    bool gps_time;              // Tempi dall'ora GPS (altrimenti millis del fix)
+    uint32_t blocked_start_id;  // Portale dell'ultima tratta: nessun nuovo ingresso finché non ci si allontana
+
+    Stats stats;
+
+    bool enter(const SectionFix& fix);
+    uint32_t elapsedSince(uint32_t from, const SectionFix& fix) const;
+    void finish(bool completed, const char* reason);
+    void updateProjection(float speed_kmh);
+};
+
+#endif // SECTION_CONTROL_H
@@ -0,0 +1,241 @@
+#include "span_raster.h"
+
+uint16_t span_isqrt(uint32_t value) {
+    uint32_t result = 0;
+    uint32_t bit = 1UL << 30;
+
+    while (bit > value) {
+        bit >>= 2;
+    }
+    while (bit) {
+        if (value >= result + bit) {
+            value -= result + bit;
+            result = (result >> 1) + bit;
+        } else {
+            result >>= 1;
+        }
+        bit >>= 2;
+    }
+    return (uint16_t)result;
+}
+
+static void add_span(SpanRow& out, int16_t x0, int16_t x1) {
+    if (x0 > x1 || out.span_count >= SPAN_ROW_MAX) return;
+    out.spans[out.span_count].x0 = x0;
+    out.spans[out.span_count].x1 = x1;
+    out.span_count++;
+}
+
+static void add_edge(SpanRow& out, int16_t x, float coverage, bool inner = false) {
+    if (coverage <= 0.0f || out.edge_count >= SPAN_ROW_MAX) return;
+    if (coverage > 1.0f) coverage = 1.0f;
+    out.edges[out.edge_count].x = x;
+    out.edges[out.edge_count].alpha = (uint8_t)(coverage * 255.0f + 0.5f);
+    out.edges[out.edge_count].inner = inner;
+    out.edge_count++;
+}
+
+/**
+ * Rientro orizzontale della riga dovuto agli angoli arrotondati
+ */
+static int16_t rounded_rect_inset(int16_t w, int16_t h, int16_t radius, int16_t row) {
+    radius = min(radius, (int16_t)min(w / 2, h / 2));
+    if (radius <= 0) return 0;
+
+    // Righe in basso speculari a quelle in alto
+    if (row >= h - radius) {
+        row = h - 1 - row;
+    }
+    if (row >= radius) return 0;
+
+    int32_t dy = radius - row;
+    return radius - span_isqrt((uint32_t)radius * radius - dy * dy);
+}
+
+void span_rounded_rect_row(int16_t w, int16_t h, int16_t radius, int16_t stroke,
+                           int16_t row, SpanRow& out) {
+    out.span_count = 0;
+    out.edge_count = 0;
+    if (row < 0 || row >= h || w <= 0) return;
+
+    int16_t outer = rounded_rect_inset(w, h, radius, row);
+
+    // Pieno, oppure righe superiori/inferiori del bordo
+    if (stroke <= 0 || row < stroke || row >= h - stroke || w <= 2 * stroke) {
+        add_span(out, outer, w - 1 - outer);
+        return;
+    }
+
+    // Bordo: tra il contorno esterno e quello del rettangolo interno (rientrato di stroke)
+    int16_t inner = stroke + rounded_rect_inset(w - 2 * stroke, h - 2 * stroke,
+                                                max((int16_t)(radius - stroke), (int16_t)0),
+                                                row - stroke);
+    add_span(out, outer, max(outer, (int16_t)(inner - 1)));
+    add_span(out, min((int16_t)(w - 1 - outer), (int16_t)(w - inner)), w - 1 - outer);
+}
+
+void span_ring_row(int16_t r_outer, int16_t r_inner, int16_t dy, bool antialias, SpanRow& out) {
+    out.span_count = 0;
+    out.edge_count = 0;
+
+    int32_t ady = abs(dy);
+    if (ady > r_outer) return;
+    bool has_hole = r_inner > 0 && ady <= r_inner;
+
+    if (!antialias) {
+        int16_t outer = span_isqrt((uint32_t)r_outer * r_outer - ady * ady);
+        if (!has_hole) {
+            add_span(out, -outer, outer);
+            return;
+        }
+        int16_t inner = span_isqrt((uint32_t)r_inner * r_inner - ady * ady);
+        add_span(out, -outer, -inner - 1);
+        add_span(out, inner + 1, outer);
+        return;
+    }
+
+    // Copertura orizzontale: un pixel x è pieno se x <= bordo - 0.5
+    float outer_edge = sqrtf((float)r_outer * r_outer - (float)(ady * ady));
+    int16_t outer_full = (int16_t)floorf(outer_edge - 0.5f);
+    int16_t outer_x = outer_full + 1;
+    float outer_cov = outer_edge - outer_x + 0.5f;
+
+    if (!has_hole || ady == r_inner) {
+        if (outer_full < 0) {
+            // Riga tangente: solo il pixel centrale, parzialmente coperto
+            add_edge(out, 0, outer_edge + 0.5f);
+            return;
+        }
+        add_span(out, -outer_full, outer_full);
+        add_edge(out, -outer_x, outer_cov);
+        add_edge(out, outer_x, outer_cov);
+        return;
+    }
+
+    float inner_edge = sqrtf((float)r_inner * r_inner - (float)(ady * ady));
+    int16_t inner_full = (int16_t)ceilf(inner_edge + 0.5f);
+    int16_t inner_x = inner_full - 1;
+    float inner_cov = inner_x + 0.5f - inner_edge;
+
+    add_span(out, -outer_full, -inner_full);
+    add_span(out, inner_full, outer_full);
+
+    if (inner_x == outer_x) {
+        // Anello più sottile di un pixel su questa riga: coperture combinate
+        float cov = outer_cov + inner_cov - 1.0f;
+        add_edge(out, -outer_x, cov, true);
+        if (outer_x != 0) add_edge(out, outer_x, cov, true);
+        return;
+    }
+    add_edge(out, -outer_x, outer_cov);
+    add_edge(out, outer_x, outer_cov);
+    if (inner_x > 0) {
+        add_edge(out, -inner_x, inner_cov, true);
+        add_edge(out, inner_x, inner_cov, true);
+    } else if (inner_x == 0) {
+        add_edge(out, 0, inner_cov, true);
+    }
+}
+
+/**
+ * Verifica se il punto (dx, dy) cade nel settore [start, start + sweep)
+ */
+static bool in_sector(float dx, int16_t dy, float start_deg, float sweep_deg) {
+    float angle = atan2f(dx, (float)-dy) * (180.0f / PI);
+    float rel = fmodf(angle - start_deg + 720.0f, 360.0f);
+    return rel < sweep_deg;
+}
+
+void span_arc_row(int16_t r_outer, int16_t r_inner, int16_t dy,
+                  float start_deg, float sweep_deg, bool antialias, SpanRow& out) {
+    SpanRow ring;
+    span_ring_row(r_outer, r_inner, dy, antialias, ring);
+
+    if (sweep_deg >= 360.0f) {
+        out = ring;
+        return;
+    }
+
+    out.span_count = 0;
+    out.edge_count = 0;
+    if (sweep_deg <= 0.0f) return;
+
+    // Intersezioni dei due raggi del settore con la riga (al più una per raggio):
+    // tra due tagli consecutivi l'appartenenza al settore non cambia
+    float cuts[2];
+    uint8_t cut_count = 0;
+    const float bounds[2] = { start_deg, start_deg + sweep_deg };
+    for (uint8_t i = 0; i < 2; i++) {
+        float rad = bounds[i] * (PI / 180.0f);
+        float c = cosf(rad);
+        if (fabsf(c) < 1e-6f) continue;
+        float t = (float)-dy / c;
+        if (t <= 0.0f) continue;
+        cuts[cut_count++] = t * sinf(rad);
+    }
+    if (cut_count == 2 && cuts[1] < cuts[0]) {
+        float tmp = cuts[0];
+        cuts[0] = cuts[1];
+        cuts[1] = tmp;
+    }
+
+    for (uint8_t s = 0; s < ring.span_count; s++) {
+        int16_t x0 = ring.spans[s].x0;
+        const int16_t x1 = ring.spans[s].x1;
+
+        for (uint8_t c = 0; c <= cut_count && x0 <= x1; c++) {
+            int16_t piece_end = x1;
+            if (c < cut_count) {
+                int16_t cut = (int16_t)ceilf(cuts[c]);
+                if (cut <= x0) continue;
+                if (cut - 1 < x1) piece_end = cut - 1;
+            }
+            if (in_sector((x0 + piece_end) * 0.5f, dy, start_deg, sweep_deg)) {
+                add_span(out, x0, piece_end);
+            }
+            x0 = piece_end + 1;
+        }
+    }
+
+    for (uint8_t e = 0; e < ring.edge_count; e++) {
+        if (in_sector(ring.edges[e].x, dy, start_deg, sweep_deg)) {
+            out.edges[out.edge_count++] = ring.edges[e];
+        }
+    }
+}
+
+void span_arc_rows(int16_t r_outer, int16_t r_inner, float start_deg, float sweep_deg,
+                   int16_t* dy_min, int16_t* dy_max) {
+    if (sweep_deg >= 360.0f) {
+        *dy_min = -r_outer;
+        *dy_max = r_outer;
+        return;
+    }
+
+    // Estremi verticali: i due raggi del settore più le direzioni cardinali comprese
+    float y_min = 0.0f;
+    float y_max = 0.0f;
+    bool first = true;
+    const float radii[2] = { (float)r_outer, (float)r_inner };
+
+    for (uint8_t k = 0; k < 6; k++) {
+        float angle;
+        if (k < 2) {
+            angle = start_deg + (k == 0 ? 0.0f : sweep_deg);
+        } else {
+            // 0, 90, 180, 270 gradi se compresi nel settore
+            angle = (k - 2) * 90.0f;
+            if (fmodf(angle - start_deg + 720.0f, 360.0f) > sweep_deg) continue;
+        }
+        float c = -cosf(angle * (PI / 180.0f));
+        for (uint8_t r = 0; r < 2; r++) {
+            float y = c * radii[r];
+            if (first || y < y_min) y_min = y;
+            if (first || y > y_max) y_max = y;
+            first = false;
+        }
+    }
+
+    *dy_min = max((int16_t)floorf(y_min), (int16_t)-r_outer);
+    *dy_max = min((int16_t)ceilf(y_max), r_outer);
+}
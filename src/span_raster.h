@@ -0,0 +1,74 @@
+#ifndef SPAN_RASTER_H
+#define SPAN_RASTER_H
+
+#include <Arduino.h>
+
+// Numero massimo di span (e pixel di bordo anti-aliased) per riga
+#define SPAN_ROW_MAX 4
+
+/**
+ * Span orizzontale [x0, x1] (estremi inclusi)
+ */
+struct Span {
+    int16_t x0;
+    int16_t x1;
+};
+
+/**
+ * Pixel di bordo anti-aliased: copertura parziale della forma
+ */
+struct SpanEdge {
+    int16_t x;
+    uint8_t alpha;       // 0 = fuori, 255 = coperto
+    bool inner;          // Bordo verso il foro dell'anello (altrimenti bordo esterno)
+};
+
+/**
+ * Estensioni orizzontali di una forma su una riga
+ * Calcolate una volta per riga: ogni span diventa una singola scrittura
+ * (una finestra SPI) invece di pixel singoli
+ */
+struct SpanRow {
+    uint8_t span_count;
+    Span spans[SPAN_ROW_MAX];
+    uint8_t edge_count;
+    SpanEdge edges[SPAN_ROW_MAX];
+};
+
+/**
+ * Radice quadrata intera (floor)
+ */
+uint16_t span_isqrt(uint32_t value);
+
+/**
+ * Riga di un rounded rectangle, coordinate relative al box (0..w-1)
+ * @param stroke Spessore bordo, 0 = rettangolo pieno
+ * @param row Riga relativa (0..h-1)
+ */
+void span_rounded_rect_row(int16_t w, int16_t h, int16_t radius, int16_t stroke,
+                           int16_t row, SpanRow& out);
+
+/**
+ * Riga di un anello (o cerchio pieno con r_inner = 0), coordinate relative al centro
+ * Un pixel appartiene all'anello se r_inner² < d² <= r_outer²
+ * @param dy Distanza verticale dal centro
+ * @param antialias Aggiunge pixel di bordo con copertura parziale
+ */
+void span_ring_row(int16_t r_outer, int16_t r_inner, int16_t dy, bool antialias, SpanRow& out);
+
+/**
+ * Riga di un arco di anello, coordinate relative al centro
+ * Angoli in gradi, senso orario a partire da ore 12
+ * @param start_deg Angolo iniziale
+ * @param sweep_deg Ampiezza (0..360)
+ */
+void span_arc_row(int16_t r_outer, int16_t r_inner, int16_t dy,
+                  float start_deg, float sweep_deg, bool antialias, SpanRow& out);
+
+/**
+ * Righe (relative al centro) toccate da un arco, per non scandire l'intero anello
+ */
+void span_arc_rows(int16_t r_outer, int16_t r_inner, float start_deg, float sweep_deg,
+                   int16_t* dy_min, int16_t* dy_max);
+
+#endif // SPAN_RASTER_H
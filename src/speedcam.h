@@ -0,0 +1,83 @@
+#ifndef SPEEDCAM_H
+#define SPEEDCAM_H
+
+#include <Arduino.h>
+
+// Direzione controllata (campo direction)
+#define SPEEDCAM_DIRECTION_ANY 0     // Nessuna informazione: tutte le direzioni
+#define SPEEDCAM_DIRECTION_ONE 1     // Solo chi viaggia verso heading
+#define SPEEDCAM_DIRECTION_BOTH 2    // heading e direzione opposta (non le strade trasversali)
+
+#define SPEEDCAM_VMAX_MAX 300        // Limiti oltre questo valore sono dati non validi (0 = sconosciuto)
+
+/**
+ * Struttura dati speedcam
+ * Ottimizzata per memoria limitata ESP32
+ */
+struct Speedcam {
+    uint32_t id;
+    float lat;
+    float lng;
+    char type[4];        // "G50", "A", "BK", ecc.
+    uint16_t vmax;       // Limite in km/h, decodificato al caricamento (0 = sconosciuto, es. "/")
+    uint8_t reserved[2]; // 0
+    char status;         // 'A' (attivo) o 'L' (inattivo)
+    char art;            // Tipo: 'G', 'A', 'BK', ecc.
+    uint8_t heading;     // Direzione di marcia controllata in angolo binario (256 = 360°, 0 = nord)
+    uint8_t direction;   // SPEEDCAM_DIRECTION_* (nel database binario: byte di padding, 0 nei file vecchi)
+    
+    Speedcam() : 
+        id(0), 
+        lat(0.0), 
+        lng(0.0), 
+        vmax(0),
+        status(' '), 
+        art(' '),
+        heading(0),
+        direction(SPEEDCAM_DIRECTION_ANY) {
+        // Tutto il campo a zero: i record scritti nel database hanno byte deterministici (CRC)
+        memset(type, 0, sizeof(type));
+        reserved[0] = reserved[1] = 0;
+    }
+};
+
+/**
+ * Coordinate utilizzabili: entro ±90°/±180° e nessuna delle due a 0 (campo
+ * mancante nei dati di origine). Controllate una volta al caricamento (JSON e
+ * slot binari): l'array delle speedcam contiene solo posizioni valide e la
+ * rilevazione non le ricontrolla a ogni scansione. NaN e infiniti falliscono
+ * i confronti.
+ */
+inline bool speedcam_position_valid(float lat, float lng) {
+    return lat != 0.0f && lng != 0.0f && fabsf(lat) <= 90.0f && fabsf(lng) <= 180.0f;
+}
+
+/**
+ * Limite di velocità dal testo del database ("50", "/", ""): cifre iniziali in
+ * km/h, 0 se assenti o oltre SPEEDCAM_VMAX_MAX
+ */
+inline uint16_t speedcam_parse_vmax(const char* text) {
+    if (!text) return 0;
+    uint16_t value = 0;
+    for (const char* c = text; *c >= '0' && *c <= '9'; c++) {
+        value = value * 10 + (*c - '0');
+        if (value > SPEEDCAM_VMAX_MAX) return 0;
+    }
+    return value;
+}
+
+/**
+ * Vero se una speedcam controlla chi viaggia con rotta course (angolo binario)
+ * Differenza a 8 bit: l'avvolgimento a 360° è quello naturale dell'aritmetica
+ * modulo 256, nessuna funzione trigonometrica per candidata.
+ * @param tolerance Scarto massimo dalla direzione controllata (angolo binario)
+ */
+inline bool speedcam_heading_match(const Speedcam& speedcam, uint8_t course, uint8_t tolerance) {
+    if (speedcam.direction == SPEEDCAM_DIRECTION_ANY) return true;
+    int diff = (int8_t)(uint8_t)(course - speedcam.heading);
+    if (abs(diff) <= tolerance) return true;
+    // Direzione opposta: differenza spostata di mezzo giro
+    return speedcam.direction == SPEEDCAM_DIRECTION_BOTH && abs((int8_t)(uint8_t)(diff + 128)) <= tolerance;
+}
+
+#endif // SPEEDCAM_H
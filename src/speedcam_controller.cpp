@@ -1,155 +1,537 @@
 #include "speedcam_controller.h"
 #include "display_controller.h"
+#include "hal.h"
+#include "arena.h"
+#include "trace.h"
+#include "log.h"
+
+// Record letti per volta dal database binario (sullo stack)
+#define DB_READ_BATCH 16
+
+// Tolleranza del filtro direzionale in angolo binario (256 = 360°)
+#define SPEEDCAM_HEADING_TOLERANCE_BINARY ((uint8_t)(SPEEDCAM_HEADING_TOLERANCE * 256.0 / 360.0 + 0.5))
+
+static_assert(SPEEDCAM_RAM_BUDGET * (SPEEDCAM_DB_HOT_SWAP ? 2 : 1) <= ARENA_DATABASE_SIZE,
+              "ARENA_DATABASE_SIZE non contiene SPEEDCAM_RAM_BUDGET");
+static_assert(SPEEDCAM_RAM_BUDGET / sizeof(Speedcam) <= 65536,
+              "Gli indici del working set sono a 16 bit");
+static_assert(SPEEDCAM_KD_NEAREST <= HILBERT_MAX_SPANS,
+              "I risultati del k-d tree nei check usano gli intervalli dell'indice");
+
+/**
+ * Anelli di distanza del pre-filtro: raggio esterno dell'anello i =
+ * PRE_FILTER_MAX_KM * ((i + 1) / PRE_FILTER_RINGS)^2, più fini vicino al centro.
+ * L'ultimo anello contiene anche tutto ciò che è oltre PRE_FILTER_MAX_KM.
+ */
+static uint8_t distance_ring(float distance_km) {
+    float x = sqrtf(distance_km / PRE_FILTER_MAX_KM) * PRE_FILTER_RINGS;
+    if (x >= PRE_FILTER_RINGS - 1) return PRE_FILTER_RINGS - 1;
+    return (uint8_t)x;
+}
+
+static float ring_outer_km(uint8_t ring) {
+    float f = (ring + 1.0f) / PRE_FILTER_RINGS;
+    return PRE_FILTER_MAX_KM * f * f;
+}
+
+static uint8_t record_ring(const SpeedcamLoadStats* stats, const Speedcam& speedcam) {
+    float distance_m = calculate_distance(stats->center_lat, stats->center_lng, speedcam.lat, speedcam.lng);
+    return distance_ring(distance_m / 1000.0f);
+}
+
+static void count_record(void* ctx, const Speedcam& speedcam) {
+    SpeedcamCountPass* pass = (SpeedcamCountPass*)ctx;
+    SpeedcamLoadStats* stats = pass->stats;
+    if (pass->valid == 0) {
+        stats->min_lat = stats->max_lat = speedcam.lat;
+        stats->min_lng = stats->max_lng = speedcam.lng;
+    } else {
+        if (speedcam.lat < stats->min_lat) stats->min_lat = speedcam.lat;
+        if (speedcam.lat > stats->max_lat) stats->max_lat = speedcam.lat;
+        if (speedcam.lng < stats->min_lng) stats->min_lng = speedcam.lng;
+        if (speedcam.lng > stats->max_lng) stats->max_lng = speedcam.lng;
+    }
+    pass->valid++;
+    pass->rings[record_ring(stats, speedcam)]++;
+}
+
+static void load_record(void* ctx, const Speedcam& speedcam) {
+    SpeedcamLoadPass* pass = (SpeedcamLoadPass*)ctx;
+    if (pass->filter) {
+        uint8_t ring = record_ring(pass->stats, speedcam);
+        if (ring > pass->edge_ring) {
+            pass->stats->dropped_distance++;
+            return;
+        }
+        if (ring == pass->edge_ring) {
+            if (pass->edge_taken >= pass->edge_slots) {
+                pass->stats->dropped_budget++;
+                return;
+            }
+            pass->edge_taken++;
+        }
+    }
+    // Senza pre-filtro (o se il file è cambiato tra i passaggi) oltre la capacità si scarta
+    if (pass->count >= pass->capacity) {
+        pass->stats->dropped_budget++;
+        return;
+    }
+    pass->speedcams[pass->count++] = speedcam;
+}
+
+/**
+ * Filtri di un check fuori dal working set, applicati dentro la ricerca nel
+ * k-d tree (kd_query_filter): le SPEEDCAM_KD_NEAREST più vicine sono cercate
+ * tra le speedcam accettate, così un gruppo di scartate non nasconde le altre
+ */
+struct DetectionFilter {
+    const SpeedcamLookahead* lookahead;  // Speedcam superate (nullptr = non filtrate)
+    bool heading_known;
+    uint8_t course;
+    const CorridorMap* corridors;        // nullptr senza corridoi caricati
+};
+
+static bool detection_filter(void* ctx, const Speedcam& speedcam) {
+    const DetectionFilter* filter = (const DetectionFilter*)ctx;
+#if LOOKAHEAD_ENABLED
+    if (filter->lookahead && filter->lookahead->isPassed(speedcam.id)) return false;
+#endif
+#if SPEEDCAM_HEADING_FILTER
+    if (filter->heading_known && !speedcam_heading_match(speedcam, filter->course, SPEEDCAM_HEADING_TOLERANCE_BINARY)) {
+        return false;
+    }
+#endif
+    // Senza contare le scartate: il conteggio resta al check sul risultato (isRelevant)
+    if (filter->corridors && !filter->corridors->checkRelevant(speedcam.id)) return false;
+    return true;
+}
 
 SpeedcamController::SpeedcamController() :
     gps_controller(nullptr),
     display_controller(nullptr),
     speedcams(nullptr),
     speedcam_count(0),
-    max_speedcam_count(MAX_SPEEDCAM_COUNT),
+    complete_radius_m(-1.0f),
+    active_bank(0),
+    active_slot(-1),
+    update_phase(UPDATE_IDLE),
+    update_slot(-1),
+    update_patched(false),
+    load_start_time(0),
+    candidate_count(0),
+    candidate_lat(0.0),
+    candidate_lng(0.0),
+    candidate_coverage(0.0f),
     enabled(SPEEDCAM_ENABLED),
     detection_radius(SPEEDCAM_DETECTION_RADIUS),
     check_interval(SPEEDCAM_CHECK_INTERVAL),
     last_detected_speedcam_id(0),
     last_detected_distance(0.0),
     previous_detected_distance(0.0),
-    last_check_time(0) {
+    last_check_time(0),
+    corridor_buffer(nullptr) {
     
     stats.detections_count = 0;
     stats.last_detection_time = 0;
     stats.checks_count = 0;
+    stats.full_scans = 0;
+    stats.index_checks = 0;
+    stats.db_swaps = 0;
+    stats.db_rejected = 0;
     
-    // Alloca array speedcam
-    // Ogni Speedcam è ~24 bytes, quindi 2000 speedcam = ~48KB
-    // NOTA: Non usare Serial qui - viene chiamato prima che Serial.begin() sia eseguito
-    speedcams = new Speedcam[max_speedcam_count];
-    if (!speedcams) {
-        // Allocazione fallita - imposta max a 0
-        max_speedcam_count = 0;
-    }
+    // I buffer del database vengono riservati in begin(), riempiti da loadDatabase()
+    banks[0] = banks[1] = nullptr;
+    memset(rejected_header_crc, 0, sizeof(rejected_header_crc));
+    rejected_patch_crc = 0;
+    memset(&load_stats, 0, sizeof(load_stats));
+    memset(&next_stats, 0, sizeof(next_stats));
+    memset(&count_pass, 0, sizeof(count_pass));
+    memset(&load_pass, 0, sizeof(load_pass));
+    load_stats.capacity = SPEEDCAM_RAM_BUDGET / sizeof(Speedcam);
 }
 
 SpeedcamController::~SpeedcamController() {
-    if (speedcams) {
-        delete[] speedcams;
-    }
+    // Array nell'arena database: nessun rilascio
 }
 
 bool SpeedcamController::begin(GPSController* gps_controller, DisplayController* display_controller) {
     this->gps_controller = gps_controller;
     this->display_controller = display_controller;
     
-    // Messaggio di debug dopo che Serial è inizializzato
-    #ifdef DEBUG_ENABLED
-    if (DEBUG_ENABLED) {
-        Serial.print("[Speedcam] Allocazione memoria: ");
-        Serial.print(max_speedcam_count);
-        Serial.print(" speedcam (~");
-        Serial.print((max_speedcam_count * sizeof(Speedcam)) / 1024);
-        Serial.println(" KB)");
-        if (!speedcams) {
-            Serial.println("[Speedcam] ERRORE: Memoria non allocata!");
-        } else {
-            Serial.println("[Speedcam] Memoria allocata con successo");
-        }
-    }
-    #endif
-    
     if (!gps_controller) {
-        #ifdef DEBUG_ENABLED
-        if (DEBUG_ENABLED) {
-            Serial.println("[Speedcam] GPS controller non valido!");
-        }
-        #endif
+        LOG_E(SPEEDCAM, "GPS controller non valido!");
         return false;
     }
     
-    #ifdef DEBUG_ENABLED
-    if (DEBUG_ENABLED) {
-        Serial.println("[Speedcam] Controller inizializzato");
-        Serial.print("[Speedcam] Memoria allocata per ");
-        Serial.print(max_speedcam_count);
-        Serial.println(" speedcam");
+    // Buffer attivo e buffer per gli aggiornamenti, ciascuno grande quanto il budget
+    Arena& database = arena_get(ARENA_DATABASE);
+    banks[0] = database.allocateArray<Speedcam>(load_stats.capacity);
+    banks[1] = SPEEDCAM_DB_HOT_SWAP ? database.allocateArray<Speedcam>(load_stats.capacity) : banks[0];
+    if (!banks[0] || !banks[1]) {
+        LOG_E(SPEEDCAM, "Memoria non allocata per %u speedcam!", (unsigned int)load_stats.capacity);
+        return false;
+    }
+#if CORRIDOR_MATCHING_ENABLED
+    corridor_buffer = (uint8_t*)database.allocate(CORRIDOR_RAM_BUDGET);
+    if (!corridor_buffer) {
+        LOG_E(SPEEDCAM, "Memoria non allocata per i corridoi!");
+        return false;
     }
-    #endif
+#endif
+    
+    LOG_I(SPEEDCAM, "Controller inizializzato");
+    LOG_I(SPEEDCAM, "Budget RAM database: %u KB (max %u speedcam)%s",
+          (unsigned int)(SPEEDCAM_RAM_BUDGET / 1024), (unsigned int)load_stats.capacity,
+          SPEEDCAM_DB_HOT_SWAP ? ", doppio buffer" : "");
     
     return true;
 }
 
-bool SpeedcamController::loadDatabase(const char* filename, bool pre_filter,
-                                     float min_lat, float max_lat,
-                                     float min_lng, float max_lng) {
-    if (!speedcams) {
-        #ifdef DEBUG_ENABLED
-        if (DEBUG_ENABLED) {
-            Serial.println("[Speedcam] Array speedcam non allocato!");
-        }
-        #endif
+bool SpeedcamController::loadDatabase(const char* filename, const GPSPosition* reference) {
+    // Sostituisce un eventuale aggiornamento in background
+    update_reader.close();
+    update_phase = UPDATE_IDLE;
+    update_slot = -1;
+    update_patched = false;
+    beginLoad(reference);
+    
+    // 1. Conteggio, bounding box e distribuzione per distanza dal centro
+    JSONParser parser;
+    int valid = parser.scanFile(filename, count_record, &count_pass, &next_stats);
+    if (valid < 0) {
+        LOG_E(SPEEDCAM, "Caricamento database fallito");
         return false;
     }
     
-    JSONParser parser;
-    int loaded = parser.loadFromFile(filename, speedcams, max_speedcam_count);
+    // 2. Capacità e pre-filtro entro il budget
+    planLoad();
     
-    if (loaded < 0) {
-        #ifdef DEBUG_ENABLED
-        if (DEBUG_ENABLED) {
-            Serial.println("[Speedcam] Errore caricamento database");
+    // 3. Caricamento nel buffer libero (con pre-filtro se oltre budget)
+    if (load_pass.capacity > 0 && parser.scanFile(filename, load_record, &load_pass) < 0) {
+        LOG_E(SPEEDCAM, "Caricamento database fallito");
+        return false;
+    }
+    
+    commitLoad();
+    return true;
+}
+
+bool SpeedcamController::loadDatabaseSlots(const GPSPosition* reference) {
+    // Se lo slot più recente è corrotto viene rifiutato e si prova l'altro;
+    // una patch rifiutata lascia lo slot a cui si applica (un tentativo in più)
+    for (uint8_t attempt = 0; attempt <= SPEEDCAM_DB_SLOT_COUNT; attempt++) {
+        bool patched;
+        int slot = selectSlot(0, &patched);
+        if (slot < 0) break;
+        if (!startSlotLoad((uint8_t)slot, patched, reference)) continue;
+        // A blocchi: tra un blocco e l'altro avanzano le animazioni del boot logo
+        while (update_phase != UPDATE_IDLE) {
+            stepSlotLoad(SPEEDCAM_DB_LOAD_CHUNK);
+            if (display_controller) display_controller->update();
         }
-        #endif
+        if (active_slot == slot) return true;
+    }
+    LOG_I(SPEEDCAM, "Nessuno slot del database valido");
+    return false;
+}
+
+bool SpeedcamController::requestDatabaseUpdate() {
+    if (update_phase != UPDATE_IDLE) {
         return false;
     }
+    if (!SPEEDCAM_DB_HOT_SWAP && speedcams) {
+        LOG_W(SPEEDCAM, "Aggiornamento in background senza SPEEDCAM_DB_HOT_SWAP: serve un riavvio");
+        return false;
+    }
+    
+    bool patched;
+    int slot = selectSlot(load_stats.db_version, &patched);
+    if (slot < 0) {
+        LOG_I(SPEEDCAM, "Nessun aggiornamento del database (versione attiva %u)",
+              (unsigned int)load_stats.db_version);
+        return false;
+    }
+    // Centro del nuovo database: posizione corrente (beginLoad)
+    return startSlotLoad((uint8_t)slot, patched, nullptr);
+}
+
+bool SpeedcamController::updateDatabase() {
+    if (update_phase == UPDATE_IDLE) {
+        return false;
+    }
+    TRACE_SCOPE(TRACE_SPEEDCAM_DB_UPDATE);
+    stepSlotLoad(SPEEDCAM_DB_LOAD_CHUNK);
+    return update_phase != UPDATE_IDLE;
+}
+
+bool SpeedcamController::isUpdating() const {
+    return update_phase != UPDATE_IDLE;
+}
+
+int SpeedcamController::getDatabaseSlot() const {
+    return active_slot;
+}
+
+void SpeedcamController::beginLoad(const GPSPosition* reference) {
+    load_start_time = millis();
+    
+    memset(&next_stats, 0, sizeof(next_stats));
+    next_stats.capacity = SPEEDCAM_RAM_BUDGET / sizeof(Speedcam);
+    
+    // Centro del pre-filtro: ultima posizione nota, GPS o default da config
+    if (reference && reference->is_valid) {
+        next_stats.center_lat = reference->latitude;
+        next_stats.center_lng = reference->longitude;
+    } else if (gps_controller && gps_controller->hasFix()) {
+        GPSPosition position = gps_controller->getPosition();
+        next_stats.center_lat = position.latitude;
+        next_stats.center_lng = position.longitude;
+    } else {
+        next_stats.center_lat = PRE_FILTER_DEFAULT_LAT;
+        next_stats.center_lng = PRE_FILTER_DEFAULT_LNG;
+    }
     
-    speedcam_count = loaded;
+    memset(&count_pass, 0, sizeof(count_pass));
+    count_pass.stats = &next_stats;
+    memset(&load_pass, 0, sizeof(load_pass));
+    load_pass.stats = &next_stats;
+    load_pass.complete_radius_m = -1.0f;
     
-    // Pre-filtraggio geografico se abilitato
-    if (pre_filter && SPEEDCAM_PRE_FILTER_ENABLED && 
-        min_lat != 0 && max_lat != 0 && min_lng != 0 && max_lng != 0) {
-        int filtered = parser.filterByBoundingBox(speedcams, speedcam_count,
-                                                  min_lat, max_lat, min_lng, max_lng);
-        
-        #ifdef DEBUG_ENABLED
-        if (DEBUG_ENABLED) {
-            Serial.print("[Speedcam] Pre-filtraggio geografico: ");
-            Serial.print(speedcam_count);
-            Serial.print(" -> ");
-            Serial.print(filtered);
-            Serial.println(" speedcam");
-        }
-        #endif
-        
-        speedcam_count = filtered;
+    // Con un solo buffer il database attivo viene sovrascritto: non più valido
+    uint8_t target = speedcams ? active_bank ^ 1 : active_bank;
+    if (banks[target] == speedcams) {
+        speedcams = nullptr;
+        speedcam_count = 0;
+        candidate_count = 0;
+        candidate_coverage = 0.0f;
+        active_slot = -1;
     }
+}
+
+void SpeedcamController::planLoad() {
+    load_pass.capacity = count_pass.valid;
     
-    #ifdef DEBUG_ENABLED
-    if (DEBUG_ENABLED) {
-        Serial.print("[Speedcam] Database caricato: ");
-        Serial.print(speedcam_count);
-        Serial.println(" speedcam");
+    if (load_pass.capacity > next_stats.capacity) {
+        load_pass.capacity = next_stats.capacity;
         
-        // Mostra prime 5 speedcam per debug
-        if (speedcam_count > 0) {
-            Serial.println("[Speedcam] Prime speedcam caricate:");
-            int show_count = min(5, speedcam_count);
-            for (int i = 0; i < show_count; i++) {
-                Serial.print("  [");
-                Serial.print(i);
-                Serial.print("] ID: ");
-                Serial.print(speedcams[i].id);
-                Serial.print(", Lat: ");
-                Serial.print(speedcams[i].lat, 6);
-                Serial.print(", Lng: ");
-                Serial.print(speedcams[i].lng, 6);
-                Serial.print(", Tipo: ");
-                Serial.println(speedcams[i].type);
+        if (SPEEDCAM_PRE_FILTER_ENABLED) {
+            // Anelli interi finché entrano; il primo che non entra riempie i posti rimasti
+            uint32_t total = 0;
+            uint8_t ring = 0;
+            while (ring < PRE_FILTER_RINGS - 1 && total + count_pass.rings[ring] <= load_pass.capacity) {
+                total += count_pass.rings[ring++];
             }
+            load_pass.filter = true;
+            load_pass.edge_ring = ring;
+            load_pass.edge_slots = load_pass.capacity - total;
+            next_stats.radius_km = ring_outer_km(ring);
+            // L'anello di confine è parziale: completo fino al suo raggio interno
+            load_pass.complete_radius_m = ring > 0 ? ring_outer_km(ring - 1) * 1000.0f : 0.0f;
+        } else {
+            // Troncato nell'ordine del file: nessuna zona sicuramente completa
+            load_pass.complete_radius_m = 0.0f;
         }
     }
-    #endif
     
+    load_pass.speedcams = banks[speedcams ? active_bank ^ 1 : active_bank];
+}
+
+void SpeedcamController::commitLoad() {
+#if SPEEDCAM_INDEX == SPEEDCAM_INDEX_KDTREE
+    // Albero costruito sul posto nel buffer nuovo, prima dello scambio
+    unsigned long build_start = millis();
+    kd_build(load_pass.speedcams, load_pass.count);
+    LOG_I(SPEEDCAM, "k-d tree: %d speedcam in %lu ms", load_pass.count, millis() - build_start);
+#elif SPEEDCAM_INDEX == SPEEDCAM_INDEX_HILBERT
+    // Il compilatore scrive i record già ordinati: il JSON va ordinato qui
+    if (!hilbert_is_sorted(load_pass.speedcams, load_pass.count)) {
+        unsigned long sort_start = millis();
+        hilbert_sort(load_pass.speedcams, load_pass.count);
+        LOG_I(SPEEDCAM, "Indice di Hilbert: %d speedcam ordinate in %lu ms",
+              load_pass.count, millis() - sort_start);
+    }
+#endif
+    
+    // Scambio: i check successivi usano il nuovo buffer, il vecchio diventa libero
+    uint8_t target = speedcams ? active_bank ^ 1 : active_bank;
+    bool swap = speedcams != nullptr;
+    active_bank = target;
+    speedcams = banks[target];
+    speedcam_count = load_pass.count;
+    complete_radius_m = load_pass.complete_radius_m;
+    active_slot = update_slot;
+    
+    // Il working set contiene indici del vecchio buffer, la coda puntatori
+    candidate_count = 0;
+    candidate_coverage = 0.0f;
+    lookahead.clear();
+    
+    // Le tratte copiano i portali: una tratta in corso prosegue sul nuovo database
+    sections.build(speedcams, speedcam_count);
+    
+    next_stats.loaded = load_pass.count;
+    next_stats.duration_ms = millis() - load_start_time;
+    load_stats = next_stats;
+    if (swap) stats.db_swaps++;
+    
+    if (active_slot >= 0) {
+        LOG_I(SPEEDCAM, "Database slot %s versione %u (CRC %08x)%s",
+              active_slot == 0 ? "A" : "B", (unsigned int)load_stats.db_version, (unsigned int)load_stats.db_crc,
+              swap ? ": sostituito il database attivo" : "");
+        if (load_stats.patch_size > 0) {
+            LOG_I(SPEEDCAM, "Patch %s applicata (%u byte)", SPEEDCAM_DB_PATCH, (unsigned int)load_stats.patch_size);
+        }
+    }
+    LOG_I(SPEEDCAM, "Database caricato: %d speedcam su %u record (%u KB, budget %u KB) in %lu ms",
+          speedcam_count, (unsigned int)load_stats.records,
+          (unsigned int)((speedcam_count * sizeof(Speedcam)) / 1024),
+          (unsigned int)(SPEEDCAM_RAM_BUDGET / 1024), load_stats.duration_ms);
+    if (count_pass.valid > 0) {
+        LOG_D(SPEEDCAM, "Bounding box: lat %.4f..%.4f, lng %.4f..%.4f",
+              load_stats.min_lat, load_stats.max_lat, load_stats.min_lng, load_stats.max_lng);
+    }
+    if (load_stats.dropped_invalid > 0) {
+        LOG_W(SPEEDCAM, "Scartate %u speedcam non valide", (unsigned int)load_stats.dropped_invalid);
+    }
+    if (load_pass.filter) {
+        LOG_W(SPEEDCAM, "Database oltre budget: pre-filtro %.0f km attorno a %.4f,%.4f",
+              load_stats.radius_km, load_stats.center_lat, load_stats.center_lng);
+    }
+    if (load_stats.dropped_distance > 0 || load_stats.dropped_budget > 0) {
+        LOG_W(SPEEDCAM, "Scartate %u speedcam oltre il raggio, %u oltre la capacità",
+              (unsigned int)load_stats.dropped_distance, (unsigned int)load_stats.dropped_budget);
+    }
+    
+    // Prime 5 speedcam per debug
+    int show_count = min(5, speedcam_count);
+    for (int i = 0; i < show_count; i++) {
+        LOG_D(SPEEDCAM, "  [%d] ID: %u, Lat: %.6f, Lng: %.6f, Tipo: %s",
+              i, speedcams[i].id, speedcams[i].lat, speedcams[i].lng, speedcams[i].type);
+    }
+}
+
+int SpeedcamController::selectSlot(uint32_t newer_than, bool* patched) {
+    SpeedcamDbPatchHeader patch;
+    bool has_patch = SpeedcamDbReader::readPatchHeader(SPEEDCAM_DB_PATCH, patch) &&
+                     patch.header_crc != rejected_patch_crc;
+    int best = -1;
+    uint32_t best_version = newer_than;
+    *patched = false;
+    for (uint8_t slot = 0; slot < SPEEDCAM_DB_SLOT_COUNT; slot++) {
+        SpeedcamDbHeader header;
+        if (!SpeedcamDbReader::readHeader(speedcam_db_slot_path(slot), header)) continue;
+        if (header.header_crc == rejected_header_crc[slot]) continue;
+        if (header.version > best_version) {
+            best = slot;
+            best_version = header.version;
+            *patched = false;
+        }
+        if (has_patch && patch.base_version == header.version && patch.base_crc == header.records_crc &&
+            patch.version > best_version) {
+            best = slot;
+            best_version = patch.version;
+            *patched = true;
+        }
+    }
+    return best;
+}
+
+bool SpeedcamController::startSlotLoad(uint8_t slot, bool patched, const GPSPosition* reference) {
+    const char* filename = speedcam_db_slot_path(slot);
+    if (!update_reader.open(filename, patched ? SPEEDCAM_DB_PATCH : nullptr)) {
+        LOG_E(SPEEDCAM, "Database %s non leggibile%s", filename, patched ? " con la patch" : "");
+        if (patched) {
+            // Al prossimo tentativo lo slot senza patch
+            SpeedcamDbPatchHeader patch;
+            SpeedcamDbReader::readPatchHeader(SPEEDCAM_DB_PATCH, patch);
+            rejected_patch_crc = patch.header_crc;
+            stats.db_rejected++;
+        }
+        return false;
+    }
+    
+    beginLoad(reference);
+    const SpeedcamDbHeader& header = update_reader.header();
+    next_stats.records = header.record_count;
+    next_stats.file_size = update_reader.fileSize();
+    next_stats.db_version = header.version;
+    next_stats.db_crc = header.records_crc;
+    next_stats.patch_size = update_reader.patchSize();
+    update_slot = (int8_t)slot;
+    update_patched = patched;
+    update_phase = UPDATE_COUNT;
+    
+    LOG_I(SPEEDCAM, "Caricamento database slot %s versione %u (%u record%s)%s",
+          slot == 0 ? "A" : "B", (unsigned int)header.version, (unsigned int)header.record_count,
+          update_reader.isCompressed() ? ", compresso" : "", patched ? " con la patch" : "");
     return true;
 }
 
+void SpeedcamController::stepSlotLoad(uint32_t max_records) {
+    Speedcam batch[DB_READ_BATCH];
+    uint32_t processed = 0;
+    
+    while (processed < max_records && !update_reader.done()) {
+        uint32_t n = min((uint32_t)DB_READ_BATCH, max_records - processed);
+        int valid = update_reader.read(batch, n);
+        if (valid < 0) {
+            rejectSlotLoad("lettura interrotta");
+            return;
+        }
+        processed += n;
+        for (int i = 0; i < valid; i++) {
+            if (update_phase == UPDATE_COUNT) {
+                count_record(&count_pass, batch[i]);
+            } else {
+                load_record(&load_pass, batch[i]);
+            }
+        }
+    }
+    if (!update_reader.done()) {
+        return;
+    }
+    
+    // Fine di un passaggio: il database attivo cambia solo con il CRC verificato
+    if (!update_reader.verify()) {
+        rejectSlotLoad("CRC dei record errato");
+        return;
+    }
+    
+    if (update_phase == UPDATE_COUNT) {
+        next_stats.dropped_invalid = update_reader.invalid();
+        planLoad();
+        // Secondo passaggio con nuova verifica: il file può cambiare tra i due
+        if (!update_reader.rewind()) {
+            rejectSlotLoad("riposizionamento fallito");
+            return;
+        }
+        update_phase = UPDATE_LOAD;
+        return;
+    }
+    
+    update_reader.close();
+    update_phase = UPDATE_IDLE;
+    commitLoad();
+}
+
+void SpeedcamController::rejectSlotLoad(const char* reason) {
+    LOG_E(SPEEDCAM, "Database slot %s versione %u rifiutato: %s (resta %s)",
+          update_slot == 0 ? "A" : "B", (unsigned int)update_reader.header().version, reason,
+          speedcams ? "il database attivo" : "nessun database");
+    // Patch rifiutata: lo slot resta valido senza. header() resta quello della
+    // patch anche dopo close(), che azzera isPatched()
+    if (update_patched) {
+        rejected_patch_crc = update_reader.header().header_crc;
+    } else {
+        rejected_header_crc[update_slot] = update_reader.header().header_crc;
+    }
+    stats.db_rejected++;
+    update_reader.close();
+    update_phase = UPDATE_IDLE;
+    update_slot = -1;
+    update_patched = false;
+}
+
 const Speedcam* SpeedcamController::checkSpeedcams(const GPSPosition* position) {
     // Throttling: esegui check solo ogni X millisecondi
     unsigned long current_time = millis();
@@ -157,16 +539,10 @@ const Speedcam* SpeedcamController::checkSpeedcams(const GPSPosition* position)
         return nullptr;  // Troppo presto, salta il check
     }
     
+    TRACE_SCOPE(TRACE_SPEEDCAM_CHECK);
+    
     if (!enabled) {
-        #ifdef DEBUG_ENABLED
-        if (DEBUG_ENABLED) {
-            static unsigned long last_warn = 0;
-            if (millis() - last_warn > 10000) {
-                Serial.println("[Speedcam] Controller disabilitato!");
-                last_warn = millis();
-            }
-        }
-        #endif
+        LOG_EVERY(LOG_LEVEL_WARN, SPEEDCAM, 10000, "Controller disabilitato!");
         return nullptr;
     }
     
@@ -184,33 +560,23 @@ const Speedcam* SpeedcamController::checkSpeedcams(const GPSPosition* position)
     
     // Verifica validità posizione
     if (!gps_position.is_valid) {
-        #ifdef DEBUG_ENABLED
-        if (DEBUG_ENABLED) {
-            static unsigned long last_warn = 0;
-            if (millis() - last_warn > 5000) {
-                Serial.println("[Speedcam] Posizione GPS non valida!");
-                last_warn = millis();
-            }
-        }
-        #endif
+        LOG_EVERY(LOG_LEVEL_WARN, SPEEDCAM, 5000, "Posizione GPS non valida!");
         return nullptr;
     }
     
     // Aggiorna tempo ultimo check
     last_check_time = current_time;
     stats.checks_count++;
+    uint32_t check_start = hal_cycles();
     
-    #ifdef DEBUG_ENABLED
-    if (DEBUG_ENABLED) {
-        static unsigned long last_check_debug = 0;
-        if (millis() - last_check_debug > 5000) {
-            Serial.print("[Speedcam] Check eseguito - Posizione valida, Database: ");
-            Serial.print(speedcam_count);
-            Serial.println(" speedcam");
-            last_check_debug = millis();
-        }
-    }
-    #endif
+    LOG_EVERY(LOG_LEVEL_DEBUG, SPEEDCAM, 5000, "Check eseguito - Posizione valida, Database: %d speedcam", speedcam_count);
+    
+#if LOOKAHEAD_ENABLED
+    // Coda delle prossime speedcam: distanze aggiornate sul posto, le superate
+    // vengono saltate dalla rilevazione
+    lookahead.update(gps_position.latitude, gps_position.longitude, gps_position.course,
+                     gps_position.speed >= SPEEDCAM_HEADING_MIN_SPEED, detection_radius);
+#endif
     
     // Rileva speedcam vicine
     const Speedcam* detected = detectSpeedcam(gps_position, detection_radius);
@@ -221,9 +587,14 @@ const Speedcam* SpeedcamController::checkSpeedcams(const GPSPosition* position)
         // Nessuna speedcam rilevata: se c'era un alert attivo, nascondilo
         // Solo se la speedcam precedente non è più nel raggio
         if (last_detected_speedcam_id != 0 && display_controller) {
-            // Verifica se la speedcam precedente è ancora nel raggio
+            // Verifica se la speedcam precedente è ancora nel raggio (superata: non più)
             bool still_in_range = false;
-            for (int i = 0; i < speedcam_count; i++) {
+#if LOOKAHEAD_ENABLED
+            bool passed = lookahead.isPassed(last_detected_speedcam_id);
+#else
+            bool passed = false;
+#endif
+            for (int i = 0; !passed && i < speedcam_count; i++) {
                 if (speedcams[i].id == last_detected_speedcam_id) {
                     float distance = calculate_distance(
                         gps_position.latitude,
@@ -240,12 +611,9 @@ const Speedcam* SpeedcamController::checkSpeedcams(const GPSPosition* position)
             
             // Se non è più nel raggio, nascondi alert e resetta tracking
             if (!still_in_range) {
-                #ifdef DEBUG_ENABLED
-                if (DEBUG_ENABLED) {
-                    Serial.println("[Speedcam] Speedcam uscita dal raggio, nascondo alert");
-                }
-                #endif
+                LOG_D(SPEEDCAM, "Speedcam uscita dal raggio, nascondo alert");
                 display_controller->hideSpeedcamAlert();
+                overspeed.clearTarget();
                 last_detected_speedcam_id = 0;
                 last_detected_distance = 0.0;
                 previous_detected_distance = 0.0;
@@ -253,48 +621,112 @@ const Speedcam* SpeedcamController::checkSpeedcams(const GPSPosition* position)
         }
     }
     
+#if LOOKAHEAD_ENABLED
+    updateLookahead(gps_position);
+#endif
+    
+    check_latency.record((hal_cycles() - check_start) / hal_cycles_per_us());
     return detected;
 }
 
 const Speedcam* SpeedcamController::detectSpeedcam(const GPSPosition& position, float radius) {
+    TRACE_SCOPE(TRACE_SPEEDCAM_DETECT);
+    
     if (speedcam_count == 0) {
-        #ifdef DEBUG_ENABLED
-        if (DEBUG_ENABLED) {
-            Serial.println("[Speedcam] detectSpeedcam: Nessuna speedcam nel database!");
-        }
-        #endif
+        LOG_EVERY(LOG_LEVEL_WARN, SPEEDCAM, 5000, "detectSpeedcam: Nessuna speedcam nel database!");
         return nullptr;
     }
     
     const Speedcam* closest_speedcam = nullptr;
     float closest_distance = radius + 1.0;  // Inizia oltre il raggio
     
-    #ifdef DEBUG_ENABLED
-    if (DEBUG_ENABLED) {
-        static unsigned long last_debug_time = 0;
-        if (millis() - last_debug_time > 5000) {  // Debug ogni 5 secondi
-            Serial.print("[Speedcam] Check posizione: ");
-            Serial.print(position.latitude, 6);
-            Serial.print(", ");
-            Serial.print(position.longitude, 6);
-            Serial.print(" | Database: ");
-            Serial.print(speedcam_count);
-            Serial.print(" speedcam | Raggio: ");
-            Serial.print(radius);
-            Serial.println("m");
-            last_debug_time = millis();
+    // Working set: ricostruito solo quando non copre più il raggio di rilevazione
+    updateCandidates(position);
+    // In zone molto dense il working set può non coprire il raggio: ricerca nell'indice
+    bool use_candidates = candidatesCover(position, radius);
+    
+#if SPEEDCAM_HEADING_FILTER
+    // Rotta in angolo binario una volta per check: per candidata basta una differenza a 8 bit
+    bool heading_known = position.speed >= SPEEDCAM_HEADING_MIN_SPEED;
+    uint8_t course = heading_to_binary(position.course);
+#endif
+    
+#if CORRIDOR_MATCHING_ENABLED
+    // Corridoio e verso di marcia una volta per check; poi per candidata una ricerca binaria
+    bool corridor_filter = corridors.isLoaded();
+    if (corridor_filter) {
+        const CorridorMatch& match = corridors.match(position.latitude, position.longitude, position.course,
+                                                     position.speed >= SPEEDCAM_HEADING_MIN_SPEED);
+        LOG_D(SPEEDCAM, "Corridoio: %d, progressiva %.0fm, verso %d, scarto %.0fm, %u segmenti",
+              match.matched ? match.corridor : -1, match.position_m, match.direction, match.offset_m,
+              match.segments);
+    }
+#endif
+    
+    HilbertSpan spans[HILBERT_MAX_SPANS];
+    int span_count = 0;
+    int scan_count = candidate_count;
+    if (!use_candidates) {
+        stats.index_checks++;
+#if SPEEDCAM_INDEX == SPEEDCAM_INDEX_KDTREE
+        // Le più vicine secondo l'albero tra quelle che passano i filtri, un intervallo
+        // ciascuna: decide la distanza Haversine
+        DetectionFilter filter;
+        filter.lookahead = LOOKAHEAD_ENABLED ? &lookahead : nullptr;
+#if SPEEDCAM_HEADING_FILTER
+        filter.heading_known = heading_known;
+        filter.course = course;
+#else
+        filter.heading_known = false;
+        filter.course = 0;
+#endif
+#if CORRIDOR_MATCHING_ENABLED
+        filter.corridors = corridor_filter ? &corridors : nullptr;
+#else
+        filter.corridors = nullptr;
+#endif
+        KdNeighbor nearest[SPEEDCAM_KD_NEAREST];
+        KdQuery query;
+        kd_query_init(query, position.latitude, position.longitude, radius, nearest, SPEEDCAM_KD_NEAREST);
+        kd_query_filter(query, detection_filter, &filter);
+        span_count = kd_search(speedcams, speedcam_count, query);
+        for (int j = 0; j < span_count; j++) {
+            spans[j].first = nearest[j].index;
+            spans[j].end = nearest[j].index + 1;
         }
+#else
+        span_count = querySpans(position, radius, spans);
+#endif
+        scan_count = 0;
+        for (int s = 0; s < span_count; s++) scan_count += spans[s].end - spans[s].first;
     }
-    #endif
     
-    // Calcola distanza da tutte le speedcam e trova la più vicina
-    for (int i = 0; i < speedcam_count; i++) {
-        const Speedcam& sc = speedcams[i];
+    LOG_D(SPEEDCAM, "Check posizione: %.6f, %.6f | Database: %d speedcam | Scansione: %d | Raggio: %.0fm",
+          position.latitude, position.longitude, speedcam_count, scan_count, radius);
+    
+    // Calcola distanza dalle speedcam candidate e trova la più vicina
+    int s = 0;
+    int i = span_count > 0 ? spans[0].first : 0;
+    for (int k = 0; k < scan_count; k++) {
+        if (!use_candidates) {
+            while (i >= spans[s].end) i = spans[++s].first;
+        }
+        // Coordinate già validate al caricamento (speedcam_position_valid)
+        const Speedcam& sc = speedcams[use_candidates ? candidates[k] : i++];
+        
+#if LOOKAHEAD_ENABLED
+        // Appena superata: l'alert passa alla successiva anche se questa è ancora più vicina
+        if (lookahead.isPassed(sc.id)) {
+            continue;
+        }
+#endif
         
-        // Verifica che le coordinate siano valide
-        if (!is_valid_float(sc.lat) || !is_valid_float(sc.lng)) {
+#if SPEEDCAM_HEADING_FILTER
+        // Speedcam di un'altra carreggiata: scartata prima della distanza
+        if (heading_known && !speedcam_heading_match(sc, course, SPEEDCAM_HEADING_TOLERANCE_BINARY)) {
             continue;
         }
+#endif
         
         // Calcola distanza usando formula Haversine
         float distance = calculate_distance(
@@ -304,26 +736,19 @@ const Speedcam* SpeedcamController::detectSpeedcam(const GPSPosition& position,
             sc.lng
         );
         
-        #ifdef DEBUG_ENABLED
-        if (DEBUG_ENABLED) {
-            // Log solo le speedcam vicine (entro 2km per debug)
-            if (distance < 2000.0) {
-                static unsigned long last_near_debug = 0;
-                if (millis() - last_near_debug > 2000) {  // Ogni 2 secondi
-                    Serial.print("[Speedcam] Speedcam vicina - ID: ");
-                    Serial.print(sc.id);
-                    Serial.print(", Distanza: ");
-                    Serial.print((int)distance);
-                    Serial.print("m, Tipo: ");
-                    Serial.println(sc.type);
-                    last_near_debug = millis();
-                }
-            }
+        // Solo le speedcam vicine (entro 2km); sotto VERBOSE non genera codice
+        if (distance < 2000.0) {
+            LOG_V(SPEEDCAM, "Speedcam vicina - ID: %u, Distanza: %dm, Tipo: %s", sc.id, (int)distance, sc.type);
         }
-        #endif
         
         // Verifica se è entro raggio e più vicina
         if (distance <= radius && distance < closest_distance) {
+#if CORRIDOR_MATCHING_ENABLED
+            // Speedcam di un'altra strada (laterale, cavalcavia) o già superata
+            if (corridor_filter && !corridors.isRelevant(sc.id)) {
+                continue;
+            }
+#endif
             closest_distance = distance;
             closest_speedcam = &sc;
         }
@@ -338,20 +763,14 @@ const Speedcam* SpeedcamController::detectSpeedcam(const GPSPosition& position,
             
             // Se ci stiamo allontanando (distanza aumenta), nascondi alert e non notificare
             if (distance_change > 10.0) {  // Soglia 10m per evitare oscillazioni
-                #ifdef DEBUG_ENABLED
-                if (DEBUG_ENABLED) {
-                    Serial.print("[Speedcam] Allontanamento rilevato - Distanza: ");
-                    Serial.print((int)closest_distance);
-                    Serial.print("m (precedente: ");
-                    Serial.print((int)previous_detected_distance);
-                    Serial.println("m), nascondo alert");
-                }
-                #endif
+                LOG_D(SPEEDCAM, "Allontanamento rilevato - Distanza: %dm (precedente: %dm), nascondo alert",
+                  (int)closest_distance, (int)previous_detected_distance);
                 
                 // Nascondi alert se presente
                 if (display_controller) {
                     display_controller->hideSpeedcamAlert();
                 }
+                overspeed.clearTarget();
                 
                 // Se ci siamo allontanati oltre il raggio, resetta tracking
                 if (closest_distance > radius) {
@@ -385,25 +804,318 @@ const Speedcam* SpeedcamController::detectSpeedcam(const GPSPosition& position,
     return closest_speedcam;
 }
 
+void SpeedcamController::updateCandidates(const GPSPosition& position) {
+    if (!candidatesCover(position, detection_radius)) {
+        buildCandidates(position);
+    }
+}
+
+bool SpeedcamController::candidatesCover(const GPSPosition& position, float radius) const {
+    if (candidate_coverage <= 0.0f) return false;
+    // Ogni speedcam entro radius dalla posizione è entro (distanza dal centro + radius) dal centro
+    float distance = calculate_distance(candidate_lat, candidate_lng, position.latitude, position.longitude);
+    return distance + radius < candidate_coverage;
+}
+
+int SpeedcamController::findSpeedcamsAhead(const GPSPosition& position, float radius,
+                                          const Speedcam** found, float* distances, int max,
+                                          KdFilter filter, void* filter_ctx) {
+    if (speedcam_count == 0 || max <= 0) return 0;
+    
+    KdNeighbor nearest[SPEEDCAM_AHEAD_MAX];
+    KdQuery query;
+    kd_query_init(query, position.latitude, position.longitude, radius, nearest, min(max, SPEEDCAM_AHEAD_MAX));
+    kd_query_ahead(query, position.course, SPEEDCAM_AHEAD_HALF_ANGLE);
+    kd_query_filter(query, filter, filter_ctx);
+#if SPEEDCAM_INDEX == SPEEDCAM_INDEX_KDTREE
+    kd_search(speedcams, speedcam_count, query);
+#else
+    // Stessa ricerca per forza bruta sugli intervalli dell'indice
+    HilbertSpan spans[HILBERT_MAX_SPANS];
+    int span_count = querySpans(position, radius, spans);
+    for (int s = 0; s < span_count; s++) {
+        kd_scan(speedcams, spans[s].first, spans[s].end, query);
+    }
+#endif
+    
+    int count = 0;
+    for (int j = 0; j < query.count; j++) {
+        const Speedcam& sc = speedcams[nearest[j].index];
+        float distance = calculate_distance(position.latitude, position.longitude, sc.lat, sc.lng);
+        if (distance > radius) continue;
+        found[count] = &sc;
+        if (distances) distances[count] = distance;
+        count++;
+    }
+    return count;
+}
+
+void SpeedcamController::updateLookahead(const GPSPosition& position) {
+    if (lookahead.needsRefill()) {
+        // Ricerca davanti nell'indice solo ogni LOOKAHEAD_REFILL_M o dopo una svolta.
+        // Rotta e corridoio filtrano dentro la ricerca: le scartate non occupano posti
+        DetectionFilter filter;
+        filter.lookahead = nullptr;
+        filter.heading_known = position.speed >= SPEEDCAM_HEADING_MIN_SPEED;
+        filter.course = heading_to_binary(position.course);
+        filter.corridors = CORRIDOR_MATCHING_ENABLED && corridors.isLoaded() ? &corridors : nullptr;
+        const Speedcam* found[SPEEDCAM_AHEAD_MAX];
+        int count = findSpeedcamsAhead(position, LOOKAHEAD_RADIUS_M, found, nullptr, SPEEDCAM_AHEAD_MAX,
+                                       detection_filter, &filter);
+        lookahead.refill(found, count);
+    }
+    
+    if (!display_controller) return;
+    
+    // Anteprima della prima speedcam davanti, senza alert a schermo
+    const LookaheadEntry* next = lookahead.next();
+    if (last_detected_speedcam_id == 0 && next && next->along_m > 0.0f && next->distance_m <= LOOKAHEAD_RADIUS_M) {
+        display_controller->showNextSpeedcam(*next->speedcam, next->distance_m);
+    } else {
+        display_controller->hideNextSpeedcam();
+    }
+}
+
+const SpeedcamLookahead& SpeedcamController::getLookahead() const {
+    return lookahead;
+}
+
+void SpeedcamController::updateSection(const GPSPosition& position) {
+    TRACE_SCOPE(TRACE_SECTION_UPDATE);
+    
+    if (!enabled || !position.is_valid) return;
+    
+    SectionFix fix;
+    fix.lat = position.latitude;
+    fix.lng = position.longitude;
+    fix.speed_kmh = position.speed;
+    fix.course_deg = position.course;
+    // Senza ora GPS (es. percorso fake) i tempi sono quelli di ricezione del fix
+    fix.gps_time = position.time_valid;
+    fix.time_ms = position.time_valid ? position.time_ms : (uint32_t)position.last_update;
+    
+    bool was_active = sections.getStatus().active;
+    if (!sections.update(fix) || !display_controller) return;
+    
+    const SectionStatus& status = sections.getStatus();
+    if (status.active) {
+        display_controller->showSectionStatus(status);
+    } else if (was_active) {
+        display_controller->hideSectionStatus();
+    }
+}
+
+const SectionTracker& SpeedcamController::getSections() const {
+    return sections;
+}
+
+void SpeedcamController::updateOverspeed(const GPSPosition& position) {
+    if (!enabled || !position.is_valid || !overspeed.hasTarget()) return;
+    
+    // Conversione in interi al confine, il resto del calcolo per fix è intero
+    OverspeedFix fix = overspeed_fix(position.latitude, position.longitude, position.speed,
+                                     position.time_valid ? position.time_ms : (uint32_t)position.last_update);
+    if (overspeed.update(fix)) {
+        LOG_I(SPEEDCAM, "Avviso velocità %u - Speedcam %u, %u km/h, decelerazione %u cm/s², distanza %um",
+              (unsigned int)overspeed.getLevel(), overspeed.getTargetId(), (unsigned int)(fix.speed_x10 / 10),
+              overspeed.getRequiredDecel(), overspeed.getDistanceCm() / 100);
+    }
+    // Ogni fix: un alert ridisegnato dopo un timeout riprende il livello corrente
+    if (display_controller) {
+        display_controller->setOverspeedLevel(overspeed.getLevel());
+    }
+}
+
+const OverspeedMonitor& SpeedcamController::getOverspeed() const {
+    return overspeed;
+}
+
+bool SpeedcamController::loadCorridors(const char* filename) {
+    corridors.clear();
+    if (!corridor_buffer || !JSONParser::isLittleFSMounted() || !LittleFS.exists(filename)) {
+        return false;
+    }
+    File file = LittleFS.open(filename, "r");
+    if (!file) {
+        return false;
+    }
+    size_t size = file.size();
+    if (size > CORRIDOR_RAM_BUDGET) {
+        LOG_W(SPEEDCAM, "Corridoi %s: %u byte oltre il budget di %u", filename,
+              (unsigned int)size, (unsigned int)CORRIDOR_RAM_BUDGET);
+        file.close();
+        return false;
+    }
+    size_t read = file.read(corridor_buffer, size);
+    file.close();
+    
+    // CRC dell'header e dei dati prima di usare le tabelle
+    const CorridorHeader* header = (const CorridorHeader*)corridor_buffer;
+    bool valid = read == size && size >= sizeof(CorridorHeader) &&
+                 speedcam_db_crc32(0, header, offsetof(CorridorHeader, header_crc)) == header->header_crc &&
+                 speedcam_db_crc32(0, corridor_buffer + sizeof(CorridorHeader), size - sizeof(CorridorHeader)) == header->data_crc &&
+                 corridors.attach(corridor_buffer, size);
+    if (!valid) {
+        LOG_W(SPEEDCAM, "Corridoi %s non validi (%u byte)", filename, (unsigned int)size);
+        corridors.clear();
+        return false;
+    }
+    LOG_I(SPEEDCAM, "Corridoi: %u strade, %u punti, %u speedcam agganciate (%u byte)",
+          corridors.getCorridorCount(), (unsigned int)corridors.getPointCount(),
+          (unsigned int)corridors.getCameraCount(), (unsigned int)size);
+    return true;
+}
+
+const CorridorMap& SpeedcamController::getCorridors() const {
+    return corridors;
+}
+
+int SpeedcamController::querySpans(const GPSPosition& position, float radius, HilbertSpan* spans) const {
+    if (speedcam_count <= 0) return 0;
+#if SPEEDCAM_INDEX == SPEEDCAM_INDEX_HILBERT
+    return hilbert_query(speedcams, speedcam_count, position.latitude, position.longitude, radius, spans);
+#else
+    (void)position;
+    (void)radius;
+    spans[0].first = 0;
+    spans[0].end = speedcam_count;
+    return 1;
+#endif
+}
+
+void SpeedcamController::buildCandidates(const GPSPosition& position) {
+    stats.full_scans++;
+    
+    // Le SPEEDCAM_CANDIDATE_MAX più vicine, ordinate per distanza (inserimento)
+    float distances[SPEEDCAM_CANDIDATE_MAX];
+    uint16_t count = 0;
+    // Copertura: raggio entro cui nessuna speedcam è stata esclusa
+    float coverage = SPEEDCAM_CANDIDATE_RADIUS;
+    
+    auto offer = [&](int i) {
+        const Speedcam& sc = speedcams[i];
+        float distance = calculate_distance(position.latitude, position.longitude, sc.lat, sc.lng);
+        if (distance >= coverage) {
+            return;
+        }
+        if (count == SPEEDCAM_CANDIDATE_MAX) {
+            // Pieno: resta fuori la più lontana tra questa e l'ultima, e limita la copertura
+            if (distance >= distances[count - 1]) {
+                coverage = distance;
+                return;
+            }
+            count--;
+            coverage = distances[count];
+        }
+        uint16_t pos = count;
+        while (pos > 0 && distances[pos - 1] > distance) {
+            distances[pos] = distances[pos - 1];
+            candidates[pos] = candidates[pos - 1];
+            pos--;
+        }
+        distances[pos] = distance;
+        candidates[pos] = (uint16_t)i;
+        count++;
+    };
+    
+#if SPEEDCAM_INDEX == SPEEDCAM_INDEX_KDTREE
+    // Le SPEEDCAM_CANDIDATE_MAX + 1 più vicine secondo l'albero: se c'è l'ultima,
+    // le speedcam escluse sono almeno alla sua distanza minima compatibile
+    KdNeighbor nearest[SPEEDCAM_CANDIDATE_MAX + 1];
+    KdQuery query;
+    kd_query_init(query, position.latitude, position.longitude, SPEEDCAM_CANDIDATE_RADIUS,
+                  nearest, SPEEDCAM_CANDIDATE_MAX + 1);
+    int found = kd_search(speedcams, speedcam_count, query);
+    if (found > SPEEDCAM_CANDIDATE_MAX) {
+        coverage = min(coverage, kd_min_distance_m(nearest[SPEEDCAM_CANDIDATE_MAX].distance2));
+        found = SPEEDCAM_CANDIDATE_MAX;
+    }
+    for (int j = 0; j < found; j++) {
+        offer(nearest[j].index);
+    }
+#else
+    // Solo gli intervalli dell'indice che possono contenere il raggio del working set
+    HilbertSpan spans[HILBERT_MAX_SPANS];
+    int span_count = querySpans(position, SPEEDCAM_CANDIDATE_RADIUS, spans);
+    
+    for (int s = 0; s < span_count; s++) {
+        for (int i = spans[s].first; i < spans[s].end; i++) {
+            offer(i);
+        }
+    }
+#endif
+    
+    candidate_count = count;
+    candidate_lat = position.latitude;
+    candidate_lng = position.longitude;
+    candidate_coverage = coverage;
+    
+    LOG_D(SPEEDCAM, "Working set: %u speedcam entro %.0fm", (unsigned int)count, coverage);
+}
+
+int SpeedcamController::getCandidates(double& lat, double& lng, float& coverage, uint32_t* ids) const {
+    if (candidate_coverage <= 0.0f) return -1;
+    
+    coverage = candidate_coverage;
+    if (complete_radius_m >= 0.0f) {
+        // Oltre il raggio completo un altro caricamento può contenere speedcam assenti ora
+        float from_center = calculate_distance(load_stats.center_lat, load_stats.center_lng,
+                                               candidate_lat, candidate_lng);
+        if (complete_radius_m - from_center < coverage) {
+            coverage = complete_radius_m - from_center;
+        }
+        if (coverage <= 0.0f) return -1;
+    }
+    
+    lat = candidate_lat;
+    lng = candidate_lng;
+    for (uint16_t k = 0; k < candidate_count; k++) {
+        ids[k] = speedcams[candidates[k]].id;
+    }
+    return candidate_count;
+}
+
+bool SpeedcamController::restoreCandidates(double lat, double lng, float coverage,
+                                           const uint32_t* ids, uint16_t count) {
+    candidate_coverage = 0.0f;
+    if (count > SPEEDCAM_CANDIDATE_MAX || coverage <= 0.0f) return false;
+    
+    uint16_t found = 0;
+    for (int i = 0; i < speedcam_count && found < count; i++) {
+        for (uint16_t k = 0; k < count; k++) {
+            if (speedcams[i].id == ids[k]) {
+                candidates[k] = (uint16_t)i;
+                found++;
+                break;
+            }
+        }
+    }
+    if (found != count) {
+        LOG_W(SPEEDCAM, "Working set salvato non valido: %u/%u speedcam nel database",
+              (unsigned int)found, (unsigned int)count);
+        return false;
+    }
+    
+    candidate_count = count;
+    candidate_lat = lat;
+    candidate_lng = lng;
+    candidate_coverage = coverage;
+    
+    LOG_I(SPEEDCAM, "Working set ripristinato: %u speedcam entro %.0fm", (unsigned int)count, coverage);
+    return true;
+}
+
 void SpeedcamController::notifySpeedcamDetected(const Speedcam& speedcam, float distance) {
-    #ifdef DEBUG_ENABLED
-    if (DEBUG_ENABLED) {
-        Serial.print("[Speedcam] 🚨 Speedcam rilevata - ID: ");
-        Serial.print(speedcam.id);
-        Serial.print(", Tipo: ");
-        Serial.print(speedcam.type);
-        Serial.print(", Limite: ");
-        Serial.print(speedcam.vmax);
-        Serial.print(" km/h, Distanza: ");
-        Serial.print((int)distance);
-        Serial.println("m");
-    }
-    #endif
+    LOG_I(SPEEDCAM, "🚨 Speedcam rilevata - ID: %u, Tipo: %s, Limite: %u km/h, Distanza: %dm",
+          speedcam.id, speedcam.type, speedcam.vmax, (int)distance);
     
     // Aggiorna statistiche
     stats.detections_count++;
     stats.last_detection_time = millis();
     
+    // Speedcam di riferimento per l'avviso di velocità (stessa speedcam: nessun effetto)
+    overspeed.setTarget(speedcam);
+    
     // Visualizza alert su display
     if (display_controller) {
         display_controller->showSpeedcamAlert(speedcam, distance);
@@ -434,8 +1146,33 @@ SpeedcamController::Stats SpeedcamController::getStats() const {
     return stats;
 }
 
+const LatencyHistogram& SpeedcamController::getCheckLatency() const {
+    return check_latency;
+}
+
+int SpeedcamController::getSpeedcamCount() const {
+    return speedcam_count;
+}
+
+int SpeedcamController::getSpeedcamCapacity() const {
+    return load_stats.capacity;
+}
+
+const SpeedcamLoadStats& SpeedcamController::getLoadStats() const {
+    return load_stats;
+}
+
 void SpeedcamController::resetStats() {
     stats.detections_count = 0;
     stats.last_detection_time = 0;
     stats.checks_count = 0;
+    stats.full_scans = 0;
+    stats.index_checks = 0;
+    stats.db_swaps = 0;
+    stats.db_rejected = 0;
+    check_latency.reset();
+    sections.resetStats();
+    corridors.resetStats();
+    overspeed.resetStats();
+    lookahead.resetStats();
 }
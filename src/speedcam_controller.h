@@ -4,12 +4,44 @@
 #include <Arduino.h>
 #include "gps_controller.h"
 #include "json_parser.h"
+#include "speedcam_db.h"
+#include "hilbert_index.h"
+#include "kd_index.h"
+#include "section_control.h"
+#include "corridor_map.h"
+#include "overspeed.h"
+#include "lookahead.h"
 #include "utils.h"
+#include "metrics.h"
 #include "config.h"
 
 // Forward declaration
 class DisplayController;
 
+/**
+ * Primo passaggio del caricamento: bounding box e conteggio per anello di distanza
+ */
+struct SpeedcamCountPass {
+    SpeedcamLoadStats* stats;
+    uint32_t valid;
+    uint32_t rings[PRE_FILTER_RINGS];
+};
+
+/**
+ * Secondo passaggio: copia nel buffer, con pre-filtro se il database è oltre budget
+ */
+struct SpeedcamLoadPass {
+    SpeedcamLoadStats* stats;
+    Speedcam* speedcams;
+    uint32_t capacity;
+    uint32_t count;
+    bool filter;
+    uint8_t edge_ring;          // Anelli precedenti interi in RAM, questo fino a edge_slots
+    uint32_t edge_slots;
+    uint32_t edge_taken;
+    float complete_radius_m;    // Vedi SpeedcamController::complete_radius_m
+};
+
 /**
  * Controller per rilevazione speedcam
  * Gestisce il database speedcam e la detection basata su posizione GPS
@@ -29,17 +61,49 @@ public:
     
     /**
      * Carica database speedcam da file JSON
+     * Primo passaggio: conteggio, bounding box e distanze dal centro; il secondo
+     * riempie il buffer libero dell'arena database (SPEEDCAM_RAM_BUDGET).
+     * Se le speedcam non entrano nel budget il secondo passaggio tiene solo le
+     * più vicine al centro (PRE_FILTER_*): raggio e scartate in getLoadStats().
+     * Il database attivo viene sostituito solo a caricamento riuscito.
      * @param filename Nome file JSON su LittleFS
-     * @param pre_filter Abilita pre-filtraggio geografico (bounding box)
-     * @param min_lat Latitudine minima per pre-filtro (opzionale)
-     * @param max_lat Latitudine massima per pre-filtro (opzionale)
-     * @param min_lng Longitudine minima per pre-filtro (opzionale)
-     * @param max_lng Longitudine massima per pre-filtro (opzionale)
+     * @param reference Ultima posizione nota (opzionale: altrimenti fix GPS,
+     *                  poi PRE_FILTER_DEFAULT_LAT/LNG)
      * @return true se caricamento riuscito
      */
-    bool loadDatabase(const char* filename, bool pre_filter = false,
-                     float min_lat = 0, float max_lat = 0,
-                     float min_lng = 0, float max_lng = 0);
+    bool loadDatabase(const char* filename, const GPSPosition* reference = nullptr);
+    
+    /**
+     * Carica il database binario dallo slot A/B valido con la versione più alta
+     * (bloccante, per il boot). Se il CRC dei record è errato prova l'altro slot.
+     * Legge SPEEDCAM_DB_LOAD_CHUNK record alla volta e tra un blocco e l'altro
+     * chiama DisplayController::update(): il fade del boot logo non si ferma.
+     * @param reference Come in loadDatabase()
+     * @return false se nessuno slot è valido (resta il fallback JSON)
+     */
+    bool loadDatabaseSlots(const GPSPosition* reference = nullptr);
+    
+    /**
+     * Cerca negli slot una versione più recente di quella attiva e ne avvia il
+     * caricamento in background (updateDatabase). Uno slot già rifiutato non
+     * viene ritentato finché il suo header non cambia.
+     * @return true se un aggiornamento è stato avviato
+     */
+    bool requestDatabaseUpdate();
+    
+    /**
+     * Avanza l'aggiornamento in corso di SPEEDCAM_DB_LOAD_CHUNK record (da loop()).
+     * I check continuano sul database attivo; a CRC verificato il nuovo buffer lo
+     * sostituisce (scambio di puntatori), altrimenti resta il database attivo.
+     * @return true se l'aggiornamento è ancora in corso
+     */
+    bool updateDatabase();
+    bool isUpdating() const;
+    
+    /**
+     * Slot del database attivo (0 = A, 1 = B), -1 se caricato dal JSON o assente
+     */
+    int getDatabaseSlot() const;
     
     /**
      * Verifica speedcam vicine basandosi sulla posizione GPS
@@ -74,11 +138,106 @@ public:
         unsigned long detections_count;
         unsigned long last_detection_time;
         unsigned long checks_count;
+        unsigned long full_scans;      // Ricostruzioni del working set (ricerca nell'indice del database)
+        unsigned long index_checks;    // Check fuori dal working set (zone dense: ricerca nell'indice)
+        unsigned long db_swaps;        // Database sostituiti da un aggiornamento
+        unsigned long db_rejected;     // Aggiornamenti rifiutati (header, lettura o CRC)
     };
     Stats getStats() const;
     
     /**
-     * Reset statistiche
+     * Latenza dei check eseguiti (µs, esclusi quelli saltati dal throttling)
+     */
+    const LatencyHistogram& getCheckLatency() const;
+    
+    /**
+     * Speedcam caricate e capacità del budget RAM
+     */
+    int getSpeedcamCount() const;
+    int getSpeedcamCapacity() const;
+    
+    /**
+     * Esito dell'ultimo caricamento (scartate per motivo, bounding box, pre-filtro)
+     */
+    const SpeedcamLoadStats& getLoadStats() const;
+    
+    /**
+     * Speedcam più vicine davanti alla posizione: entro SPEEDCAM_AHEAD_HALF_ANGLE
+     * dalla rotta (position.course), per l'anteprima della prossima speedcam
+     * @param found Array di almeno max elementi, in ordine di distanza
+     * @param distances Distanze in metri (opzionale)
+     * @param max Al più SPEEDCAM_AHEAD_MAX
+     * @param filter Filtro applicato nella ricerca, prima del taglio a max (opzionale)
+     * @return Numero di speedcam trovate entro radius
+     */
+    int findSpeedcamsAhead(const GPSPosition& position, float radius, const Speedcam** found,
+                           float* distances, int max, KdFilter filter = nullptr, void* filter_ctx = nullptr);
+    
+    /**
+     * Coda delle prossime speedcam davanti (ordinate lungo la rotta) e superate
+     */
+    const SpeedcamLookahead& getLookahead() const;
+    
+    /**
+     * Aggiorna il Tutor con un nuovo fix (dalla callback GPS, tempo costante in
+     * tratta) e mostra o nasconde sul display lo stato della tratta in corso
+     */
+    void updateSection(const GPSPosition& position);
+    
+    /**
+     * Tratte collegate dopo l'ultimo caricamento e stato del Tutor
+     */
+    const SectionTracker& getSections() const;
+    
+    /**
+     * Valuta la velocità del fix rispetto al vmax della speedcam dell'alert
+     * (decelerazione necessaria, solo interi) e passa il livello al display
+     */
+    void updateOverspeed(const GPSPosition& position);
+    
+    /**
+     * Avviso di velocità: speedcam di riferimento, livello e statistiche
+     */
+    const OverspeedMonitor& getOverspeed() const;
+    
+    /**
+     * Carica il file dei corridoi (make_corridors.py) nel buffer riservato in
+     * begin(), entro CORRIDOR_RAM_BUDGET, con verifica dei CRC. Da quel momento
+     * ogni check associa la posizione a un corridoio e scarta le speedcam
+     * agganciate a un altro corridoio o già superate.
+     * @return false se il file manca o non è valido (nessun filtro)
+     */
+    bool loadCorridors(const char* filename = CORRIDOR_PATH);
+    
+    /**
+     * Corridoi caricati e ultimo match
+     */
+    const CorridorMap& getCorridors() const;
+    
+    /**
+     * Ricostruisce il working set se non copre più il raggio di rilevazione
+     * attorno alla posizione (scansione completa solo in quel caso)
+     */
+    void updateCandidates(const GPSPosition& position);
+    
+    /**
+     * Working set corrente, per il warm start: centro, copertura e ID delle speedcam.
+     * La copertura è ridotta alla zona in cui il database caricato è completo,
+     * così resta valida anche con un database caricato attorno a un altro centro.
+     * @param ids Array di almeno SPEEDCAM_CANDIDATE_MAX elementi
+     * @return Numero di ID scritti, -1 se non c'è un working set salvabile
+     */
+    int getCandidates(double& lat, double& lng, float& coverage, uint32_t* ids) const;
+    
+    /**
+     * Ripristina un working set salvato (dopo loadDatabase dello stesso file):
+     * il primo check dopo il boot non scansiona tutto il database
+     * @return true se tutte le speedcam del working set sono nel database
+     */
+    bool restoreCandidates(double lat, double lng, float coverage, const uint32_t* ids, uint16_t count);
+    
+    /**
+     * Reset statistiche (contatori e istogramma latenza)
      */
     void resetStats();
 
@@ -86,10 +245,41 @@ private:
     GPSController* gps_controller;
     DisplayController* display_controller;
     
-    // Database speedcam
+    // Database speedcam (speedcams punta a banks[active_bank])
     Speedcam* speedcams;
     int speedcam_count;
-    int max_speedcam_count;
+    SpeedcamLoadStats load_stats;
+    float complete_radius_m;   // Database completo entro questo raggio dal centro di caricamento (<0: ovunque)
+    
+    // Doppio buffer: il caricamento riempie il buffer libero, poi i puntatori vengono
+    // scambiati. Senza SPEEDCAM_DB_HOT_SWAP i due puntatori coincidono.
+    Speedcam* banks[2];
+    uint8_t active_bank;
+    int8_t active_slot;
+    uint32_t rejected_header_crc[SPEEDCAM_DB_SLOT_COUNT];  // Slot rifiutati, 0 = nessuno
+    uint32_t rejected_patch_crc;                           // Patch rifiutata, 0 = nessuna
+    
+    // Caricamento in corso (nel buffer libero)
+    enum UpdatePhase : uint8_t {
+        UPDATE_IDLE = 0,
+        UPDATE_COUNT,     // Primo passaggio e verifica CRC
+        UPDATE_LOAD       // Secondo passaggio, nuova verifica CRC, scambio
+    };
+    UpdatePhase update_phase;
+    int8_t update_slot;
+    bool update_patched;      // Con la patch: il reader la chiude (close()) se la lettura fallisce
+    SpeedcamDbReader update_reader;
+    SpeedcamLoadStats next_stats;
+    SpeedcamCountPass count_pass;
+    SpeedcamLoadPass load_pass;
+    unsigned long load_start_time;
+    
+    // Working set: tutte le speedcam entro candidate_coverage dal centro (indici in speedcams)
+    uint16_t candidates[SPEEDCAM_CANDIDATE_MAX];
+    uint16_t candidate_count;
+    double candidate_lat;
+    double candidate_lng;
+    float candidate_coverage;  // 0 = working set non valido
     
     // Configurazione
     bool enabled;
@@ -104,6 +294,20 @@ private:
     
     // Statistiche
     Stats stats;
+    LatencyHistogram check_latency;
+    
+    // Tutor: tratte del database attivo
+    SectionTracker sections;
+    
+    // Corridoi stradali: il file resta nel buffer (arena database), la mappa lo legge sul posto
+    uint8_t* corridor_buffer;
+    CorridorMap corridors;
+    
+    // Avviso di velocità verso la speedcam dell'alert
+    OverspeedMonitor overspeed;
+    
+    // Prossime speedcam davanti (puntatori in speedcams, svuotata a ogni caricamento)
+    SpeedcamLookahead lookahead;
     
     /**
      * Rileva speedcam entro raggio dalla posizione GPS
@@ -113,6 +317,60 @@ private:
      */
     const Speedcam* detectSpeedcam(const GPSPosition& position, float radius);
     
+    /**
+     * Dopo il check: riempie la coda delle prossime speedcam se serve (ricerca
+     * davanti, stessi filtri di direzione e corridoio della rilevazione) e
+     * aggiorna l'anteprima sul display
+     */
+    void updateLookahead(const GPSPosition& position);
+    
+    /**
+     * Vero se il working set contiene tutte le speedcam entro radius dalla posizione
+     */
+    bool candidatesCover(const GPSPosition& position, float radius) const;
+    
+    /**
+     * Ricostruisce il working set attorno alla posizione (ricerca nell'indice)
+     */
+    void buildCandidates(const GPSPosition& position);
+    
+    /**
+     * Intervalli del database che possono contenere le speedcam entro radius
+     * (SPEEDCAM_INDEX_LINEAR e SPEEDCAM_INDEX_KDTREE: un solo intervallo, tutto l'array)
+     * @param spans Array di almeno HILBERT_MAX_SPANS elementi
+     */
+    int querySpans(const GPSPosition& position, float radius, HilbertSpan* spans) const;
+    
+    /**
+     * Inizializza un caricamento: centro del pre-filtro e contatori dei passaggi
+     */
+    void beginLoad(const GPSPosition* reference);
+    
+    /**
+     * Dopo il primo passaggio: capacità, pre-filtro e buffer di destinazione
+     */
+    void planLoad();
+    
+    /**
+     * Sostituisce il database attivo con quello appena caricato
+     */
+    void commitLoad();
+    
+    /**
+     * Slot valido, non rifiutato, con versione maggiore di newer_than (-1 se nessuno).
+     * Conta anche la versione dello slot con la patch SPEEDCAM_DB_PATCH, se è per
+     * quello slot: patched dice se va applicata.
+     */
+    int selectSlot(uint32_t newer_than, bool* patched);
+    
+    /**
+     * Caricamento di uno slot (con la patch se patched): avvio, passo di
+     * max_records record, rifiuto
+     */
+    bool startSlotLoad(uint8_t slot, bool patched, const GPSPosition* reference);
+    void stepSlotLoad(uint32_t max_records);
+    void rejectSlotLoad(const char* reason);
+    
     /**
      * Notifica rilevazione speedcam
      */
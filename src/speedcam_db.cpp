@@ -0,0 +1,447 @@
+#include "speedcam_db.h"
+#include "json_parser.h"
+#include "lz4_block.h"
+#include "log.h"
+
+// CRC-32 a 4 bit per passo: 64 byte di tabella invece di 1KB
+static const uint32_t crc_nibble_table[16] = {
+    0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC,
+    0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+    0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C,
+    0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C,
+};
+
+uint32_t speedcam_db_crc32(uint32_t crc, const void* data, size_t length) {
+    const uint8_t* bytes = (const uint8_t*)data;
+    crc = ~crc;
+    for (size_t i = 0; i < length; i++) {
+        crc ^= bytes[i];
+        crc = (crc >> 4) ^ crc_nibble_table[crc & 0x0F];
+        crc = (crc >> 4) ^ crc_nibble_table[crc & 0x0F];
+    }
+    return ~crc;
+}
+
+const char* speedcam_db_slot_path(uint8_t slot) {
+    return slot == 0 ? SPEEDCAM_DB_SLOT_A : SPEEDCAM_DB_SLOT_B;
+}
+
+SpeedcamDbReader::SpeedcamDbReader() :
+    is_open(false),
+    file_size(0),
+    next_record(0),
+    crc(0),
+    invalid_count(0),
+    block_records(0),
+    block_count(0),
+    next_block(0),
+    data_offset(sizeof(SpeedcamDbHeader)),
+    window_count(0),
+    window_next(0),
+    sequential(true),
+    patched(false),
+    patch_size(0),
+    patch_ops(0),
+    base_count(0),
+    base_next(0),
+    ops_read(0),
+    op_remaining(0) {
+    memset(&db_header, 0, sizeof(db_header));
+    memset(&op, 0, sizeof(op));
+}
+
+bool SpeedcamDbReader::validHeader(const SpeedcamDbHeader& header, uint32_t file_size) {
+    if (header.magic != SPEEDCAM_DB_MAGIC || header.format != SPEEDCAM_DB_FORMAT ||
+        header.record_size != SPEEDCAM_DB_RECORD_SIZE || header.version == 0) {
+        return false;
+    }
+    if (speedcam_db_crc32(0, &header, offsetof(SpeedcamDbHeader, header_crc)) != header.header_crc) {
+        return false;
+    }
+    if (file_size < sizeof(SpeedcamDbHeader)) {
+        return false;
+    }
+    uint32_t data = file_size - sizeof(SpeedcamDbHeader);
+    if (header.block_records == 0) {
+        // Dimensione esatta: un file troncato o con byte in coda non è valido
+        return data / SPEEDCAM_DB_RECORD_SIZE == header.record_count && data % SPEEDCAM_DB_RECORD_SIZE == 0;
+    }
+    // Compresso: qui indice e dimensioni dei blocchi, la fine del file dopo l'ultimo blocco
+    if (header.block_records > SPEEDCAM_DB_BLOCK_RECORDS_MAX) {
+        return false;
+    }
+    uint32_t blocks = (header.record_count + header.block_records - 1) / header.block_records;
+    return data / (sizeof(SpeedcamDbBlock) + sizeof(uint16_t)) >= blocks;
+}
+
+bool SpeedcamDbReader::validPatchHeader(const SpeedcamDbPatchHeader& header, uint32_t file_size) {
+    if (header.magic != SPEEDCAM_DB_PATCH_MAGIC || header.format != SPEEDCAM_DB_PATCH_FORMAT ||
+        header.record_size != SPEEDCAM_DB_RECORD_SIZE || header.version <= header.base_version) {
+        return false;
+    }
+    if (speedcam_db_crc32(0, &header, offsetof(SpeedcamDbPatchHeader, header_crc)) != header.header_crc) {
+        return false;
+    }
+    // Le op hanno lunghezza variabile: qui solo il minimo, il resto in finishPatch()
+    return file_size >= sizeof(SpeedcamDbPatchHeader) &&
+           (file_size - sizeof(SpeedcamDbPatchHeader)) / sizeof(SpeedcamDbPatchOp) >= header.op_count;
+}
+
+bool SpeedcamDbReader::readPatchHeader(const char* filename, SpeedcamDbPatchHeader& header) {
+    memset(&header, 0, sizeof(header));
+    if (!JSONParser::isLittleFSMounted() || !LittleFS.exists(filename)) {
+        return false;
+    }
+    File file = LittleFS.open(filename, "r");
+    if (!file) {
+        return false;
+    }
+    uint32_t size = file.size();
+    bool valid = file.read((uint8_t*)&header, sizeof(header)) == sizeof(header) && validPatchHeader(header, size);
+    file.close();
+    return valid;
+}
+
+bool SpeedcamDbReader::readHeader(const char* filename, SpeedcamDbHeader& header) {
+    // Senza un SpeedcamDbReader: i buffer dei blocchi non servono (e non vanno sullo stack)
+    memset(&header, 0, sizeof(header));
+    if (!JSONParser::isLittleFSMounted() || !LittleFS.exists(filename)) {
+        return false;
+    }
+    File file = LittleFS.open(filename, "r");
+    if (!file) {
+        return false;
+    }
+    uint32_t size = file.size();
+    bool valid = file.read((uint8_t*)&header, sizeof(header)) == sizeof(header) && validHeader(header, size);
+    file.close();
+    if (!valid) {
+        LOG_W(SPEEDCAM, "Database %s: header non valido o file troncato (%u byte)", filename, (unsigned int)size);
+    }
+    return valid;
+}
+
+bool SpeedcamDbReader::open(const char* filename, const char* patch_filename) {
+    close();
+    memset(&db_header, 0, sizeof(db_header));
+
+    if (!JSONParser::isLittleFSMounted() || !LittleFS.exists(filename)) {
+        return false;
+    }
+    file = LittleFS.open(filename, "r");
+    if (!file) {
+        return false;
+    }
+
+    file_size = file.size();
+    if (file.read((uint8_t*)&db_header, sizeof(db_header)) != sizeof(db_header) ||
+        !validHeader(db_header, file_size)) {
+        LOG_W(SPEEDCAM, "Database %s: header non valido o file troncato (%u byte)",
+              filename, (unsigned int)file_size);
+        file.close();
+        return false;
+    }
+
+    base_count = db_header.record_count;
+    block_records = db_header.block_records;
+    block_count = block_records > 0 ? (base_count + block_records - 1) / block_records : 0;
+    data_offset = sizeof(SpeedcamDbHeader) + block_count * sizeof(SpeedcamDbBlock);
+    if (block_count > 0) {
+        // Il primo blocco segue l'indice: un indice spostato o troncato non è valido
+        SpeedcamDbBlock first;
+        if (file.read((uint8_t*)&first, sizeof(first)) != sizeof(first) || first.offset != data_offset ||
+            !file.seek(data_offset)) {
+            LOG_W(SPEEDCAM, "Database %s: indice dei blocchi non valido", filename);
+            file.close();
+            return false;
+        }
+    }
+
+    if (patch_filename && !openPatch(patch_filename)) {
+        file.close();
+        return false;
+    }
+
+    is_open = true;
+    next_record = 0;
+    crc = 0;
+    invalid_count = 0;
+    next_block = 0;
+    window_count = 0;
+    window_next = 0;
+    sequential = true;
+    return true;
+}
+
+bool SpeedcamDbReader::openPatch(const char* patch_filename) {
+    SpeedcamDbPatchHeader patch;
+    if (!LittleFS.exists(patch_filename)) {
+        return false;
+    }
+    patch_file = LittleFS.open(patch_filename, "r");
+    if (!patch_file) {
+        return false;
+    }
+    patch_size = patch_file.size();
+    if (patch_file.read((uint8_t*)&patch, sizeof(patch)) != sizeof(patch) ||
+        !validPatchHeader(patch, patch_size)) {
+        LOG_W(SPEEDCAM, "Patch %s: header non valido (%u byte)", patch_filename, (unsigned int)patch_size);
+        patch_file.close();
+        return false;
+    }
+    if (patch.base_version != db_header.version || patch.base_crc != db_header.records_crc) {
+        LOG_W(SPEEDCAM, "Patch %s: per la versione %u, non per la %u", patch_filename,
+              (unsigned int)patch.base_version, (unsigned int)db_header.version);
+        patch_file.close();
+        return false;
+    }
+
+    // Da qui header() descrive la versione risultante
+    db_header.version = patch.version;
+    db_header.record_count = patch.record_count;
+    db_header.created = patch.created;
+    db_header.records_crc = patch.records_crc;
+    db_header.header_crc = patch.header_crc;
+    patch_ops = patch.op_count;
+    patched = true;
+    resetPatch();
+    return true;
+}
+
+void SpeedcamDbReader::resetPatch() {
+    base_next = 0;
+    ops_read = 0;
+    op_remaining = 0;
+    memset(&op, 0, sizeof(op));
+}
+
+int SpeedcamDbReader::read(Speedcam* speedcams, uint32_t max) {
+    if (!is_open || !sequential) return -1;
+
+    uint32_t count = db_header.record_count - next_record;
+    if (count > max) count = max;
+    if (count == 0) return 0;
+
+    // Dalla patch applicata o dallo slot (file o blocchi), direttamente nell'array
+    size_t bytes = count * SPEEDCAM_DB_RECORD_SIZE;
+    if (patched && !readPatched(speedcams, count)) {
+        LOG_E(SPEEDCAM, "Patch: op non valida o lettura interrotta al record %u (op %u)",
+              (unsigned int)next_record, (unsigned int)ops_read);
+        close();
+        return -1;
+    }
+    if (!patched && !readRecords((uint8_t*)speedcams, count)) {
+        LOG_E(SPEEDCAM, "Database: lettura interrotta o blocco non valido al record %u", (unsigned int)next_record);
+        close();
+        return -1;
+    }
+    crc = speedcam_db_crc32(crc, speedcams, bytes);
+    next_record += count;
+    if (patched && done() && !finishPatch()) {
+        LOG_E(SPEEDCAM, "Patch: op o record della base in eccesso");
+        close();
+        return -1;
+    }
+
+    return (int)compact(speedcams, count);
+}
+
+uint32_t SpeedcamDbReader::compact(Speedcam* speedcams, uint32_t count) {
+    // Compatta le speedcam valide all'inizio dell'array
+    uint32_t valid = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        Speedcam& speedcam = speedcams[i];
+        if (!speedcam_position_valid(speedcam.lat, speedcam.lng)) {
+            invalid_count++;
+            continue;
+        }
+        speedcam.type[sizeof(speedcam.type) - 1] = '\0';
+        if (speedcam.vmax > SPEEDCAM_VMAX_MAX) speedcam.vmax = 0;
+        if (speedcam.direction > SPEEDCAM_DIRECTION_BOTH) speedcam.direction = SPEEDCAM_DIRECTION_ANY;
+        if (valid != i) speedcams[valid] = speedcam;
+        valid++;
+    }
+    return valid;
+}
+
+bool SpeedcamDbReader::readRecords(uint8_t* records, uint32_t count) {
+    if (block_records == 0) {
+        // I record hanno il layout di Speedcam: letti direttamente nell'array
+        size_t bytes = count * SPEEDCAM_DB_RECORD_SIZE;
+        return file.read(records, bytes) == bytes;
+    }
+    while (count > 0) {
+        if (window_next == window_count) {
+            if (next_block >= block_count || !loadBlock(next_block)) return false;
+            next_block++;
+            // Dopo l'ultimo blocco il file deve finire
+            if (next_block == block_count && file.position() != file_size) return false;
+        }
+        uint32_t n = min(count, (uint32_t)(window_count - window_next));
+        takeWindow(records, n);
+        records += n * SPEEDCAM_DB_RECORD_SIZE;
+        count -= n;
+    }
+    return true;
+}
+
+void SpeedcamDbReader::takeWindow(uint8_t* records, uint32_t count) {
+    // Trasposizione inversa: byte j del record i in window[j * window_count + i]
+    for (uint32_t i = 0; i < count; i++) {
+        const uint8_t* source = &window[window_next + i];
+        for (uint32_t j = 0; j < SPEEDCAM_DB_RECORD_SIZE; j++) {
+            records[j] = source[j * window_count];
+        }
+        records += SPEEDCAM_DB_RECORD_SIZE;
+    }
+    window_next += count;
+}
+
+bool SpeedcamDbReader::loadBlock(uint32_t block) {
+    uint16_t size;
+    if (file.read((uint8_t*)&size, sizeof(size)) != sizeof(size)) return false;
+    uint32_t records = min(block_records, base_count - block * block_records);
+    uint32_t raw = records * SPEEDCAM_DB_RECORD_SIZE;
+    uint32_t stored = size & ~SPEEDCAM_DB_BLOCK_STORED;
+
+    if (size & SPEEDCAM_DB_BLOCK_STORED) {
+        if (stored != raw || file.read(window, raw) != raw) return false;
+    } else {
+        // Il compilatore non comprime un blocco che non si riduce
+        if (stored == 0 || stored >= raw || file.read(block_buffer, stored) != stored) return false;
+        if (lz4_block_decompress(block_buffer, stored, window, raw) != (int)raw) return false;
+    }
+    window_count = records;
+    window_next = 0;
+    return true;
+}
+
+bool SpeedcamDbReader::readIndex(uint32_t block, SpeedcamDbBlock& entry) {
+    return file.seek(sizeof(SpeedcamDbHeader) + block * sizeof(SpeedcamDbBlock)) &&
+           file.read((uint8_t*)&entry, sizeof(entry)) == sizeof(entry);
+}
+
+int SpeedcamDbReader::findBlock(uint32_t key) {
+    if (!is_open || block_count == 0) return -1;
+    sequential = false;
+
+    // Ultimo blocco con la prima chiave < key: il precedente può finire con la stessa chiave
+    uint32_t low = 0;
+    uint32_t high = block_count - 1;
+    while (low < high) {
+        uint32_t mid = (low + high + 1) / 2;
+        SpeedcamDbBlock entry;
+        if (!readIndex(mid, entry)) return -1;
+        if (entry.first_key < key) {
+            low = mid;
+        } else {
+            high = mid - 1;
+        }
+    }
+    return (int)low;
+}
+
+int SpeedcamDbReader::readBlock(uint32_t block, Speedcam* speedcams) {
+    if (!is_open || patched || block >= block_count) return -1;
+    sequential = false;
+
+    SpeedcamDbBlock entry;
+    if (!readIndex(block, entry) || entry.offset < data_offset || entry.offset >= file_size ||
+        !file.seek(entry.offset) || !loadBlock(block)) {
+        return -1;
+    }
+    uint32_t count = window_count;
+    takeWindow((uint8_t*)speedcams, count);
+    return (int)compact(speedcams, count);
+}
+
+bool SpeedcamDbReader::readPatched(Speedcam* speedcams, uint32_t count) {
+    uint32_t filled = 0;
+    while (filled < count) {
+        if (op_remaining == 0) {
+            if (!nextOp()) return false;
+            continue;
+        }
+        uint32_t n = min(op_remaining, count - filled);
+        size_t bytes = n * SPEEDCAM_DB_RECORD_SIZE;
+        uint8_t* target = (uint8_t*)&speedcams[filled];
+        if (op.kind == PATCH_COPY) {
+            if (!readRecords(target, n)) return false;
+            base_next += n;
+        } else {
+            // MODIFY e INSERT: record nella patch
+            if (patch_file.read(target, bytes) != bytes) return false;
+        }
+        op_remaining -= n;
+        filled += n;
+    }
+    return true;
+}
+
+bool SpeedcamDbReader::nextOp() {
+    if (ops_read >= patch_ops) return false;
+    if (patch_file.read((uint8_t*)&op, sizeof(op)) != sizeof(op)) return false;
+    ops_read++;
+
+    switch (op.kind) {
+        case PATCH_COPY:
+            if (op.arg == 0 || op.arg > base_count - base_next) return false;
+            op_remaining = op.arg;
+            return true;
+        case PATCH_DELETE:
+            op_remaining = 0;
+            return skipBase(op.arg);
+        case PATCH_MODIFY:
+            op_remaining = 1;
+            return skipBase(op.arg);
+        case PATCH_INSERT:
+            if (op.arg == 0) return false;
+            op_remaining = op.arg;
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool SpeedcamDbReader::skipBase(uint32_t id) {
+    Speedcam record;
+    if (base_next >= base_count || !readRecords((uint8_t*)&record, 1)) return false;
+    base_next++;
+    return record.id == id;
+}
+
+bool SpeedcamDbReader::finishPatch() {
+    // Un'op che produce record oltre record_count resterebbe a metà
+    if (op_remaining > 0) return false;
+    while (ops_read < patch_ops) {
+        if (!nextOp() || op.kind != PATCH_DELETE) return false;
+    }
+    return base_next == base_count && patch_file.position() == patch_size;
+}
+
+bool SpeedcamDbReader::rewind() {
+    if (!is_open || !file.seek(data_offset)) return false;
+    next_block = 0;
+    window_count = 0;
+    window_next = 0;
+    sequential = true;
+    if (patched) {
+        if (!patch_file.seek(sizeof(SpeedcamDbPatchHeader))) return false;
+        resetPatch();
+    }
+    next_record = 0;
+    crc = 0;
+    invalid_count = 0;
+    return true;
+}
+
+void SpeedcamDbReader::close() {
+    if (is_open) {
+        file.close();
+    }
+    if (patched) {
+        patch_file.close();
+    }
+    is_open = false;
+    patched = false;
+}
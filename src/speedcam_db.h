@@ -0,0 +1,266 @@
+#ifndef SPEEDCAM_DB_H
+#define SPEEDCAM_DB_H
+
+#include <Arduino.h>
+#include <FS.h>
+#include <LittleFS.h>
+#include "config.h"
+#include "speedcam.h"
+
+/**
+ * Database speedcam binario (generato da make_speedcam_db.py)
+ *
+ *   header   SpeedcamDbHeader (32 byte, little-endian)
+ *   record   record_count x 24 byte, stesso layout di struct Speedcam
+ *            (id, lat, lng, type[4], vmax uint16 + 2 byte a zero, status, art,
+ *            heading, direction)
+ *
+ * Il CRC-32 (zlib) dei record è nell'header, protetto a sua volta dal proprio
+ * CRC: un file troncato, un header alterato o un record corrotto vengono
+ * rifiutati prima di sostituire il database attivo.
+ *
+ * Slot compresso (block_records > 0): i record sono divisi in blocchi di
+ * block_records record (l'ultimo può essere più corto), decomprimibili uno
+ * per uno in una finestra di SPEEDCAM_DB_BLOCK_RECORDS_MAX record.
+ *
+ *   header   SpeedcamDbHeader, records_crc sempre sui record non compressi
+ *   indice   block_count x SpeedcamDbBlock: offset nel file e chiave di
+ *            Hilbert del primo record (per leggere solo i blocchi di una zona)
+ *   blocchi  uint16 dimensione (SPEEDCAM_DB_BLOCK_STORED: non compresso) e
+ *            record del blocco trasposti per byte (byte j del record i in
+ *            j * record + i: i byte alti di coordinate vicine, type e vmax
+ *            ripetuti diventano sequenze lunghe), compressi in formato LZ4
+ *
+ * Patch (make_speedcam_db.py --patch-from): differenze per id tra uno slot
+ * (base) e una versione più recente, applicate durante la lettura dello slot
+ * senza riscriverlo. Un aggiornamento settimanale scrive sulla flash solo la
+ * patch (pochi KB) invece dell'intero database.
+ *
+ *   header   SpeedcamDbPatchHeader (44 byte)
+ *   op       op_count x SpeedcamDbPatchOp (8 byte), nell'ordine dei record della
+ *            versione nuova; MODIFY è seguita da un record, INSERT da arg record
+ *
+ * La versione nuova è verificata con il CRC dei suoi record (records_crc
+ * dell'header della patch), calcolato sui record prodotti come per uno slot.
+ */
+
+#define SPEEDCAM_DB_MAGIC 0x42444E4D   // "MNDB"
+#define SPEEDCAM_DB_FORMAT 2           // Cambia se cambia il layout di header o record (2: vmax intero)
+#define SPEEDCAM_DB_RECORD_SIZE 24
+#define SPEEDCAM_DB_SLOT_COUNT 2
+
+struct SpeedcamDbHeader {
+    uint32_t magic;             // SPEEDCAM_DB_MAGIC
+    uint16_t format;            // SPEEDCAM_DB_FORMAT
+    uint16_t record_size;       // SPEEDCAM_DB_RECORD_SIZE
+    uint32_t version;           // Versione del database (>= 1, crescente a ogni aggiornamento)
+    uint32_t record_count;
+    uint32_t created;           // Unix time della compilazione (solo informativo)
+    uint32_t records_crc;       // CRC-32 dei record
+    uint32_t block_records;     // Record per blocco compresso, 0 = record non compressi
+    uint32_t header_crc;        // CRC-32 dei 28 byte precedenti
+};
+
+struct SpeedcamDbBlock {
+    uint32_t offset;            // Dal primo byte del file
+    uint32_t first_key;         // hilbert_key() del primo record
+};
+
+#define SPEEDCAM_DB_BLOCK_STORED 0x8000    // Nella dimensione del blocco: trasposto ma non compresso
+
+static_assert(sizeof(SpeedcamDbHeader) == 32, "Header del database: 32 byte");
+static_assert(sizeof(Speedcam) == SPEEDCAM_DB_RECORD_SIZE, "Record del database: layout di Speedcam");
+static_assert(SPEEDCAM_DB_BLOCK_RECORDS_MAX * SPEEDCAM_DB_RECORD_SIZE < SPEEDCAM_DB_BLOCK_STORED,
+              "Blocco non compresso: la dimensione deve entrare in 15 bit");
+
+#define SPEEDCAM_DB_PATCH_MAGIC 0x50444E4D   // "MNDP"
+#define SPEEDCAM_DB_PATCH_FORMAT 1
+
+struct SpeedcamDbPatchHeader {
+    uint32_t magic;             // SPEEDCAM_DB_PATCH_MAGIC
+    uint16_t format;            // SPEEDCAM_DB_PATCH_FORMAT
+    uint16_t record_size;       // SPEEDCAM_DB_RECORD_SIZE
+    uint32_t base_version;      // Versione dello slot a cui si applica
+    uint32_t base_crc;          // records_crc dello slot a cui si applica
+    uint32_t version;           // Versione risultante (> base_version)
+    uint32_t record_count;      // Record della versione risultante
+    uint32_t created;
+    uint32_t records_crc;       // CRC-32 dei record della versione risultante
+    uint32_t op_count;
+    uint32_t reserved;
+    uint32_t header_crc;        // CRC-32 dei 40 byte precedenti
+};
+
+enum SpeedcamDbPatchKind : uint8_t {
+    PATCH_COPY = 'C',           // arg record copiati dalla base
+    PATCH_DELETE = 'D',         // Il prossimo record della base (id = arg) viene saltato
+    PATCH_MODIFY = 'M',         // Il prossimo record della base (id = arg) è sostituito dal record che segue
+    PATCH_INSERT = 'I'          // arg record nuovi, che seguono l'op
+};
+
+struct SpeedcamDbPatchOp {
+    uint8_t kind;               // SpeedcamDbPatchKind
+    uint8_t reserved[3];
+    uint32_t arg;
+};
+
+static_assert(sizeof(SpeedcamDbPatchHeader) == 44, "Header della patch: 44 byte");
+static_assert(sizeof(SpeedcamDbPatchOp) == 8, "Op della patch: 8 byte");
+
+/**
+ * CRC-32 (polinomio riflesso 0xEDB88320, come zlib.crc32)
+ * @param crc CRC dei byte precedenti (0 all'inizio)
+ */
+uint32_t speedcam_db_crc32(uint32_t crc, const void* data, size_t length);
+
+/**
+ * Path dello slot (0 = A, 1 = B)
+ */
+const char* speedcam_db_slot_path(uint8_t slot);
+
+/**
+ * Lettura a blocchi di un file del database, eventualmente con una patch
+ * Il CRC dei record viene calcolato durante la lettura: verify() è affidabile
+ * solo dopo aver letto tutto il file (done()).
+ * Con una patch la base e la patch sono lette in parallelo senza buffer propri
+ * (i record copiati vanno direttamente nell'array di chi legge): header(),
+ * done() e verify() si riferiscono alla versione risultante.
+ */
+class SpeedcamDbReader {
+public:
+    SpeedcamDbReader();
+
+    /**
+     * Apre il file e valida l'header (magic, formato, CRC, dimensione del file)
+     * @param patch_filename Patch da applicare durante la lettura (opzionale):
+     *                       deve riferirsi a versione e CRC del file
+     * @return false se il file manca o l'header (o quello della patch) non è valido
+     */
+    bool open(const char* filename, const char* patch_filename = nullptr);
+
+    /**
+     * Legge fino a max record; quelli senza coordinate valide sono contati in invalid()
+     * @param speedcams Array di almeno max elementi
+     * @return Speedcam valide scritte, -1 se errore di lettura (file troncato)
+     */
+    int read(Speedcam* speedcams, uint32_t max);
+
+    /**
+     * Torna al primo record (per un secondo passaggio)
+     */
+    bool rewind();
+
+    void close();
+
+    bool isOpen() const { return is_open; }
+    bool isPatched() const { return patched; }
+    bool isCompressed() const { return block_records > 0; }
+    bool done() const { return next_record >= db_header.record_count; }
+    bool verify() const { return done() && crc == db_header.records_crc; }
+    const SpeedcamDbHeader& header() const { return db_header; }
+    uint32_t fileSize() const { return file_size; }
+    uint32_t patchSize() const { return patched ? patch_size : 0; }
+    uint32_t invalid() const { return invalid_count; }
+
+    /**
+     * Legge e valida solo l'header (per scegliere lo slot senza tenere aperto il file)
+     */
+    static bool readHeader(const char* filename, SpeedcamDbHeader& header);
+    static bool readPatchHeader(const char* filename, SpeedcamDbPatchHeader& header);
+
+    /**
+     * Accesso per blocchi di uno slot compresso (senza patch), es. per caricare
+     * solo una zona. Interrompe la lettura sequenziale: dopo serve rewind().
+     */
+    uint32_t blockCount() const { return block_count; }
+
+    /**
+     * Primo blocco che può contenere record con chiave di Hilbert >= key
+     * @return -1 se lo slot non è compresso o l'indice non è leggibile
+     */
+    int findBlock(uint32_t key);
+
+    /**
+     * Decomprime un blocco; le speedcam senza coordinate valide sono scartate come in read()
+     * @param speedcams Array di almeno SPEEDCAM_DB_BLOCK_RECORDS_MAX elementi
+     * @return Speedcam valide scritte, -1 se il blocco non è valido
+     */
+    int readBlock(uint32_t block, Speedcam* speedcams);
+
+private:
+    File file;
+    SpeedcamDbHeader db_header;
+    bool is_open;
+    uint32_t file_size;
+    uint32_t next_record;
+    uint32_t crc;
+    uint32_t invalid_count;
+
+    // Slot compresso: blocco corrente decompresso nella finestra
+    uint32_t block_records;
+    uint32_t block_count;
+    uint32_t next_block;
+    uint32_t data_offset;       // Primo record o primo blocco
+    uint16_t window_count;      // Record nella finestra
+    uint16_t window_next;       // Prossimo record della finestra da restituire
+    bool sequential;            // Falso dopo readBlock(), fino a rewind()
+    uint8_t window[SPEEDCAM_DB_BLOCK_RECORDS_MAX * SPEEDCAM_DB_RECORD_SIZE];
+    uint8_t block_buffer[SPEEDCAM_DB_BLOCK_RECORDS_MAX * SPEEDCAM_DB_RECORD_SIZE];
+
+    // Patch: header() diventa quello della versione risultante
+    File patch_file;
+    bool patched;
+    uint32_t patch_size;
+    uint32_t patch_ops;
+    uint32_t base_count;
+    uint32_t base_next;         // Record della base già consumati
+    uint32_t ops_read;
+    SpeedcamDbPatchOp op;       // Op corrente
+    uint32_t op_remaining;      // Record ancora da produrre per l'op corrente
+
+    static bool validHeader(const SpeedcamDbHeader& header, uint32_t file_size);
+    static bool validPatchHeader(const SpeedcamDbPatchHeader& header, uint32_t file_size);
+
+    /**
+     * Prossimi count record della base (file o blocchi), non compattati
+     */
+    bool readRecords(uint8_t* records, uint32_t count);
+
+    /**
+     * Decomprime nella finestra il blocco che inizia alla posizione corrente del file
+     * (block: per il numero di record)
+     */
+    bool loadBlock(uint32_t block);
+    bool readIndex(uint32_t block, SpeedcamDbBlock& entry);
+
+    /**
+     * Copia count record dalla finestra (trasposizione inversa)
+     */
+    void takeWindow(uint8_t* records, uint32_t count);
+    uint32_t compact(Speedcam* speedcams, uint32_t count);
+
+    bool openPatch(const char* patch_filename);
+
+    /**
+     * Produce count record della versione risultante applicando le op
+     */
+    bool readPatched(Speedcam* speedcams, uint32_t count);
+
+    /**
+     * Legge la prossima op; DELETE viene applicata subito (nessun record prodotto)
+     */
+    bool nextOp();
+
+    /**
+     * Legge il prossimo record della base verificandone l'id (DELETE, MODIFY)
+     */
+    bool skipBase(uint32_t id);
+
+    /**
+     * Dopo l'ultimo record: DELETE in coda, poi op, base e patch esaurite
+     */
+    bool finishPatch();
+    void resetPatch();
+};
+
+#endif // SPEEDCAM_DB_H
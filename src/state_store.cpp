@@ -0,0 +1,167 @@
+#include "state_store.h"
+#include "speedcam_controller.h"
+#include "utils.h"
+#include "log.h"
+
+// Versione del layout di WarmState: uno stato di un'altra versione viene ignorato
+#define STATE_STORE_VERSION 2
+#define STATE_STORE_KEY "warm"
+
+// Byte del blob senza gli ID non usati
+#define WARM_STATE_SIZE(count) (offsetof(WarmState, candidate_ids) + (count) * sizeof(uint32_t))
+
+StateStore::StateStore() :
+    gps_controller(nullptr),
+    speedcam_controller(nullptr),
+    opened(false),
+    has_state(false),
+    last_fix_update(0) {
+    
+    memset(&saved, 0, sizeof(saved));
+    stats.writes = 0;
+    stats.bytes_written = 0;
+    stats.last_write_time = 0;
+    stats.position_restored = false;
+    stats.candidates_restored = false;
+}
+
+bool StateStore::begin(GPSController* gps_controller, SpeedcamController* speedcam_controller) {
+    this->gps_controller = gps_controller;
+    this->speedcam_controller = speedcam_controller;
+    
+    opened = preferences.begin(STATE_STORE_NAMESPACE, false);
+    if (!opened) {
+        LOG_E(STATE, "NVS non disponibile, nessun warm start");
+        return false;
+    }
+    
+    size_t length = preferences.getBytesLength(STATE_STORE_KEY);
+    if (length == 0) {
+        LOG_I(STATE, "Nessuno stato salvato (cold start)");
+        return false;
+    }
+    
+    WarmState state;
+    memset(&state, 0, sizeof(state));
+    if (length < WARM_STATE_SIZE(0) || length > sizeof(state) ||
+        preferences.getBytes(STATE_STORE_KEY, &state, sizeof(state)) != length ||
+        state.version != STATE_STORE_VERSION ||
+        state.candidate_count > SPEEDCAM_CANDIDATE_MAX ||
+        length != WARM_STATE_SIZE(state.candidate_count)) {
+        LOG_W(STATE, "Stato salvato non valido (%u byte), ignorato", (unsigned int)length);
+        return false;
+    }
+    
+    saved = state;
+    has_state = true;
+    last_known.latitude = state.lat;
+    last_known.longitude = state.lng;
+    last_known.is_valid = true;
+    stats.position_restored = true;
+    
+    LOG_I(STATE, "Ultima posizione nota: %.6f, %.6f (working set %u speedcam)",
+          state.lat, state.lng, (unsigned int)state.candidate_count);
+    return true;
+}
+
+const GPSPosition* StateStore::lastKnownPosition() const {
+    return has_state ? &last_known : nullptr;
+}
+
+bool StateStore::restore() {
+    if (!has_state || !speedcam_controller || saved.candidate_coverage <= 0.0f) {
+        return false;
+    }
+    
+    // Il working set vale solo per lo stesso database
+    const SpeedcamLoadStats& load = speedcam_controller->getLoadStats();
+    if (load.file_size != saved.db_size || load.records != saved.db_records || load.db_crc != saved.db_crc) {
+        LOG_I(STATE, "Database cambiato, working set salvato ignorato");
+        return false;
+    }
+    
+    stats.candidates_restored = speedcam_controller->restoreCandidates(
+        saved.candidate_lat, saved.candidate_lng, saved.candidate_coverage,
+        saved.candidate_ids, saved.candidate_count);
+    return stats.candidates_restored;
+}
+
+bool StateStore::update() {
+    if (!opened || !gps_controller) {
+        return false;
+    }
+    
+    // Valuta solo i fix nuovi
+    GPSPosition position = gps_controller->getPosition();
+    if (!position.is_valid || position.last_update == last_fix_update) {
+        return false;
+    }
+    last_fix_update = position.last_update;
+    
+    // Nessuna scrittura senza uno spostamento dall'ultimo stato salvato
+    if (has_state && calculate_distance(saved.lat, saved.lng, position.latitude, position.longitude) <
+                     STATE_SAVE_MIN_DISTANCE_M) {
+        return false;
+    }
+    
+    // In marcia al più una scrittura per intervallo; da fermi subito
+    bool stopped = position.speed < STATE_SAVE_STOP_SPEED_KMH;
+    if (!stopped && stats.writes > 0 && millis() - stats.last_write_time < STATE_SAVE_INTERVAL_MS) {
+        return false;
+    }
+    
+    return save(position);
+}
+
+bool StateStore::save(const GPSPosition& position) {
+    WarmState state;
+    memset(&state, 0, sizeof(state));
+    state.version = STATE_STORE_VERSION;
+    state.lat = position.latitude;
+    state.lng = position.longitude;
+    
+    if (speedcam_controller) {
+        const SpeedcamLoadStats& load = speedcam_controller->getLoadStats();
+        state.db_size = load.file_size;
+        state.db_records = load.records;
+        state.db_crc = load.db_crc;
+        
+        // Working set attorno alla posizione salvata: al riavvio copre il primo fix
+        speedcam_controller->updateCandidates(position);
+        int count = speedcam_controller->getCandidates(state.candidate_lat, state.candidate_lng,
+                                                       state.candidate_coverage, state.candidate_ids);
+        if (count >= 0) {
+            state.candidate_count = (uint16_t)count;
+        } else {
+            state.candidate_coverage = 0.0f;
+        }
+    }
+    
+    size_t length = WARM_STATE_SIZE(state.candidate_count);
+    if (preferences.putBytes(STATE_STORE_KEY, &state, length) != length) {
+        LOG_E(STATE, "Scrittura NVS fallita");
+        return false;
+    }
+    
+    saved = state;
+    has_state = true;
+    stats.writes++;
+    stats.bytes_written += length;
+    stats.last_write_time = millis();
+    
+    LOG_D(STATE, "Stato salvato: %.6f, %.6f, working set %u speedcam (%u byte)",
+          state.lat, state.lng, (unsigned int)state.candidate_count, (unsigned int)length);
+    return true;
+}
+
+void StateStore::clear() {
+    if (opened) {
+        preferences.remove(STATE_STORE_KEY);
+    }
+    has_state = false;
+    memset(&saved, 0, sizeof(saved));
+}
+
+StateStore::Stats StateStore::getStats() const {
+    return stats;
+}
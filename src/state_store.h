@@ -0,0 +1,104 @@
+#ifndef STATE_STORE_H
+#define STATE_STORE_H
+
+#include <Arduino.h>
+#include <Preferences.h>
+#include "config.h"
+#include "gps_controller.h"
+
+// Forward declaration
+class SpeedcamController;
+
+/**
+ * Stato salvato in NVS per il warm start
+ * Il blob contiene solo i candidate_count ID usati del working set
+ */
+struct WarmState {
+    uint32_t version;           // Layout della struttura (STATE_STORE_VERSION)
+    double lat;                 // Ultimo fix valido
+    double lng;
+    uint32_t db_size;           // Firma del database: dimensione file, record e CRC
+    uint32_t db_records;
+    uint32_t db_crc;
+    double candidate_lat;       // Working set (SpeedcamController::getCandidates)
+    double candidate_lng;
+    float candidate_coverage;   // 0 = nessun working set
+    uint16_t candidate_count;
+    uint32_t candidate_ids[SPEEDCAM_CANDIDATE_MAX];
+};
+
+/**
+ * Persistenza dello stato tra i riavvii (Preferences / NVS)
+ *
+ * Al boot l'ultima posizione salvata diventa il centro del pre-filtro del
+ * database e il working set salvato evita la scansione completa al primo
+ * check. In marcia lo stato viene riscritto al più ogni STATE_SAVE_INTERVAL_MS
+ * e solo dopo STATE_SAVE_MIN_DISTANCE_M; da fermi (parcheggio, poco prima dello
+ * spegnimento) subito, e poi più nulla finché il veicolo non si sposta.
+ */
+class StateStore {
+public:
+    StateStore();
+    
+    /**
+     * Apre il namespace NVS e legge lo stato del boot precedente
+     * @return true se c'è uno stato valido
+     */
+    bool begin(GPSController* gps_controller, SpeedcamController* speedcam_controller);
+    
+    /**
+     * Ultima posizione salvata (per SpeedcamController::loadDatabase), nullptr se nessuna
+     */
+    const GPSPosition* lastKnownPosition() const;
+    
+    /**
+     * Ripristina il working set se il database caricato è quello dello stato salvato
+     * (da chiamare dopo loadDatabase)
+     * @return true se ripristinato
+     */
+    bool restore();
+    
+    /**
+     * Salva lo stato se lo richiede la politica di scrittura (da chiamare in loop())
+     * @return true se ha scritto in NVS
+     */
+    bool update();
+    
+    /**
+     * Cancella lo stato salvato (cold start al prossimo boot)
+     */
+    void clear();
+    
+    /**
+     * Ottiene statistiche
+     */
+    struct Stats {
+        unsigned long writes;
+        unsigned long bytes_written;
+        unsigned long last_write_time;
+        bool position_restored;
+        bool candidates_restored;
+    };
+    Stats getStats() const;
+
+private:
+    Preferences preferences;
+    GPSController* gps_controller;
+    SpeedcamController* speedcam_controller;
+    bool opened;
+    
+    // Ultimo stato scritto (o letto al boot)
+    WarmState saved;
+    bool has_state;
+    GPSPosition last_known;
+    
+    unsigned long last_fix_update;
+    Stats stats;
+    
+    /**
+     * Scrive lo stato corrente con la posizione indicata
+     */
+    bool save(const GPSPosition& position);
+};
+
+#endif // STATE_STORE_H
@@ -0,0 +1,111 @@
+#include "trace.h"
+#include "log.h"
+
+#ifdef TRACE_ENABLED
+
+// Formato dump: versione da incrementare se cambia TraceEvent o l'header
+#define TRACE_DUMP_VERSION 1
+#define TRACE_CALIBRATION_SPANS 256
+
+static_assert(sizeof(TraceEvent) == 12, "TraceEvent deve restare di 12 byte (formato dump)");
+
+TraceEvent trace_buffer[TRACE_BUFFER_EVENTS];
+uint16_t trace_head = 0;
+uint32_t trace_recorded = 0;
+uint8_t trace_depth = 0;
+uint32_t trace_longest_cycles = 0;
+uint8_t trace_longest_id = 0;
+
+static uint32_t overhead_cycles = 0;
+
+static const char* const span_names[TRACE_SPAN_COUNT] = {
+    "GPSController::updatePosition",
+    "SpeedcamController::checkSpeedcams",
+    "SpeedcamController::detectSpeedcam",
+    "JSONParser::scanFile",
+    "DisplayController::drawSpeedcamAlertContent",
+    "DisplayController::updateSpeedcamAlertContent",
+    "DisplayController::hideSpeedcamAlert",
+    "DisplayController::drawBootLogoFrame",
+    "DisplayController::showIdleScreen",
+    "DisplayController::updateGPSIndicator",
+    "GPSController::update",
+    "DisplayController::update",
+    "log_flush",
+    "SpeedcamController::updateDatabase",
+    "SpeedcamController::updateSection",
+};
+
+void trace_reset() {
+    trace_head = 0;
+    trace_recorded = 0;
+    trace_reset_longest();
+}
+
+uint32_t trace_longest(uint8_t* id) {
+    if (id) *id = trace_longest_id;
+    return trace_longest_cycles;
+}
+
+void trace_reset_longest() {
+    trace_longest_cycles = 0;
+    trace_longest_id = 0;
+}
+
+const char* trace_span_name(uint8_t id) {
+    return id < TRACE_SPAN_COUNT ? span_names[id] : "?";
+}
+
+void trace_begin() {
+    // Span vuoti: il costo include le due letture del contatore e la scrittura
+    uint32_t start = hal_cycles();
+    for (uint16_t i = 0; i < TRACE_CALIBRATION_SPANS; i++) {
+        TRACE_SCOPE(TRACE_GPS_UPDATE_POSITION);
+    }
+    overhead_cycles = (hal_cycles() - start) / TRACE_CALIBRATION_SPANS;
+    trace_reset();
+    
+    LOG_I(TRACE, "Buffer %d eventi (%lu byte), costo span %lu cicli",
+          TRACE_BUFFER_EVENTS, (unsigned long)sizeof(trace_buffer), (unsigned long)overhead_cycles);
+}
+
+uint32_t trace_overhead_cycles() {
+    return overhead_cycles;
+}
+
+static void write_u16(Print& out, uint16_t value) {
+    uint8_t bytes[2] = { (uint8_t)value, (uint8_t)(value >> 8) };
+    out.write(bytes, 2);
+}
+
+static void write_u32(Print& out, uint32_t value) {
+    uint8_t bytes[4] = { (uint8_t)value, (uint8_t)(value >> 8), (uint8_t)(value >> 16), (uint8_t)(value >> 24) };
+    out.write(bytes, 4);
+}
+
+void trace_dump(Print& out) {
+    uint16_t count = trace_recorded < TRACE_BUFFER_EVENTS ? trace_recorded : TRACE_BUFFER_EVENTS;
+    uint16_t first = trace_recorded < TRACE_BUFFER_EVENTS ? 0 : trace_head;
+    
+    // Header
+    out.write((const uint8_t*)"MNTR", 4);
+    write_u16(out, TRACE_DUMP_VERSION);
+    write_u16(out, TRACE_SPAN_COUNT);
+    write_u32(out, hal_cycles_per_us());
+    write_u32(out, overhead_cycles);
+    write_u32(out, trace_recorded);
+    write_u32(out, count);
+    
+    // Nomi span, terminati da '\0'
+    for (uint8_t i = 0; i < TRACE_SPAN_COUNT; i++) {
+        out.write((const uint8_t*)span_names[i], strlen(span_names[i]) + 1);
+    }
+    
+    // Eventi dal più vecchio (ESP32 e host sono little-endian: struct scritta direttamente)
+    for (uint16_t i = 0; i < count; i++) {
+        out.write((const uint8_t*)&trace_buffer[(first + i) % TRACE_BUFFER_EVENTS], sizeof(TraceEvent));
+    }
+    out.flush();
+}
+
+#endif // TRACE_ENABLED
@@ -0,0 +1,136 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "hal.h"
+
+/**
+ * Tracing del percorso critico
+ *
+ * TRACE_SCOPE(id) misura il blocco in cui è dichiarato con il contatore cicli
+ * e, all'uscita, scrive un evento (inizio, durata, profondità) in un ring buffer
+ * in RAM. Nessuna stampa sul percorso critico: il buffer si scarica in binario
+ * su richiesta (trace_dump) e trace_to_perfetto.py lo converte in JSON Chrome
+ * trace / Perfetto.
+ *
+ * Senza TRACE_ENABLED (config.h) le macro non generano codice.
+ */
+
+/**
+ * Span tracciati (i nomi sono nel dump, in trace.cpp)
+ */
+enum TraceSpanId : uint8_t {
+    TRACE_GPS_UPDATE_POSITION = 0,
+    TRACE_SPEEDCAM_CHECK,
+    TRACE_SPEEDCAM_DETECT,
+    TRACE_JSON_LOAD_FILE,
+    TRACE_DISPLAY_ALERT_DRAW,
+    TRACE_DISPLAY_ALERT_UPDATE,
+    TRACE_DISPLAY_ALERT_HIDE,
+    TRACE_DISPLAY_BOOT_LOGO,
+    TRACE_DISPLAY_IDLE_SCREEN,
+    TRACE_DISPLAY_GPS_INDICATOR,
+    TRACE_GPS_UPDATE,
+    TRACE_DISPLAY_UPDATE,
+    TRACE_LOG_FLUSH,
+    TRACE_SPEEDCAM_DB_UPDATE,
+    TRACE_SECTION_UPDATE,
+    TRACE_SPAN_COUNT
+};
+
+/**
+ * Evento nel ring buffer (12 byte, scritto così com'è nel dump little-endian)
+ */
+struct TraceEvent {
+    uint32_t start;      // hal_cycles() all'ingresso
+    uint32_t cycles;     // Durata in cicli
+    uint8_t id;          // TraceSpanId
+    uint8_t depth;       // Annidamento (0 = span esterno)
+    uint16_t reserved;
+};
+
+#ifdef TRACE_ENABLED
+
+extern TraceEvent trace_buffer[TRACE_BUFFER_EVENTS];
+extern uint16_t trace_head;
+extern uint32_t trace_recorded;
+extern uint8_t trace_depth;
+extern uint32_t trace_longest_cycles;
+extern uint8_t trace_longest_id;
+
+/**
+ * Span con durata del blocco (RAII): una lettura del contatore in ingresso,
+ * una in uscita e una scrittura nel ring buffer
+ */
+class TraceScope {
+public:
+    explicit TraceScope(uint8_t id) : id(id), depth(trace_depth++), start(hal_cycles()) {}
+    
+    ~TraceScope() {
+        uint32_t cycles = hal_cycles() - start;
+        trace_depth--;
+        TraceEvent& event = trace_buffer[trace_head];
+        event.start = start;
+        event.cycles = cycles;
+        event.id = id;
+        event.depth = depth;
+        trace_head = (trace_head + 1) % TRACE_BUFFER_EVENTS;
+        trace_recorded++;
+        if (cycles > trace_longest_cycles) {
+            trace_longest_cycles = cycles;
+            trace_longest_id = id;
+        }
+    }
+
+private:
+    uint8_t id;
+    uint8_t depth;
+    uint32_t start;
+};
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+#define TRACE_SCOPE(id) TraceScope TRACE_CONCAT(trace_scope_, __LINE__)(id)
+
+/**
+ * Misura il costo di uno span vuoto (cicli) e svuota il buffer
+ * Da chiamare una volta all'avvio, prima degli span da misurare
+ */
+void trace_begin();
+
+/**
+ * Costo medio di uno span vuoto misurato da trace_begin()
+ */
+uint32_t trace_overhead_cycles();
+
+/**
+ * Scrive il buffer in binario (header "MNTR", nomi span, eventi dal più vecchio)
+ */
+void trace_dump(Print& out);
+
+/**
+ * Svuota il buffer
+ */
+void trace_reset();
+
+/**
+ * Span più lungo dall'ultimo trace_reset_longest() (usato da loop_monitor.h
+ * per indicare la sezione bloccante di un'iterazione lenta)
+ * @return Durata in cicli, 0 se nessuno span
+ */
+uint32_t trace_longest(uint8_t* id);
+void trace_reset_longest();
+
+/**
+ * Nome di uno span ("?" se id non valido)
+ */
+const char* trace_span_name(uint8_t id);
+
+#else
+
+#define TRACE_SCOPE(id) do {} while (0)
+
+#endif // TRACE_ENABLED
+
+#endif // TRACE_H
@@ -7,6 +7,11 @@ double deg_to_rad(double deg) {
     return deg * (M_PI / 180.0);
 }
 
+uint8_t heading_to_binary(float degrees) {
+    // Modulo 256 dopo l'arrotondamento: anche 359.9° e valori negativi finiscono nel giro
+    return (uint8_t)(int32_t)lroundf(degrees * (256.0f / 360.0f));
+}
+
 double calculate_distance(double lat1, double lon1, double lat2, double lon2) {
     // Formula di Haversine per calcolare distanza tra due punti sulla sfera
     
@@ -20,6 +20,12 @@ double calculate_distance(double lat1, double lon1, double lat2, double lon2);
  */
 double deg_to_rad(double deg);
 
+/**
+ * Converte una direzione in gradi (0 = nord, senso orario) in angolo binario
+ * a 8 bit (256 = 360°, passo ~1.4°), arrotondando al passo più vicino
+ */
+uint8_t heading_to_binary(float degrees);
+
 /**
  * Verifica se un valore è valido (non NaN, non infinito)
  */
@@ -0,0 +1,79 @@
+#include "viewport.h"
+#include "span_raster.h"
+
+static uint8_t half_widths[DISPLAY_HEIGHT];
+static bool table_ready = false;
+
+void viewport_begin() {
+    if (table_ready) return;
+
+    // Coordinate raddoppiate per lavorare sui centri dei pixel con interi:
+    // la colonna k-esima a destra del centro è visibile se (2k+1)² + dy2² <= (2R)²
+    const int32_t diameter = 2 * DISPLAY_VIEWPORT_RADIUS;
+    const int16_t center_y = DISPLAY_HEIGHT / 2;
+    for (int16_t y = 0; y < DISPLAY_HEIGHT; y++) {
+        int32_t dy2 = 2 * (y - center_y) + 1;
+        int32_t rem = diameter * diameter - dy2 * dy2;
+        uint16_t hw = rem > 0 ? (span_isqrt((uint32_t)rem) + 1) / 2 : 0;
+        half_widths[y] = (uint8_t)min(hw, (uint16_t)(DISPLAY_WIDTH / 2));
+    }
+    table_ready = true;
+}
+
+uint8_t viewport_half_width(int16_t y) {
+    if (y < 0 || y >= DISPLAY_HEIGHT) return 0;
+    if (!table_ready) viewport_begin();
+    return half_widths[y];
+}
+
+bool viewport_clip_span(int16_t y, int16_t& x0, int16_t& x1) {
+    uint8_t hw = viewport_half_width(y);
+    if (hw == 0) return false;
+
+    const int16_t center_x = DISPLAY_WIDTH / 2;
+    if (x0 < center_x - hw) x0 = center_x - hw;
+    if (x1 > center_x + hw - 1) x1 = center_x + hw - 1;
+    return x0 <= x1;
+}
+
+bool viewport_rect_inside(int16_t x, int16_t y, int16_t w, int16_t h) {
+    if (w <= 0 || h <= 0) return true;
+
+    // Le righe più strette del rettangolo sono quelle più lontane dal centro:
+    // basta controllare la prima e l'ultima
+    const int16_t rows[2] = { y, (int16_t)(y + h - 1) };
+    for (uint8_t i = 0; i < 2; i++) {
+        int16_t x0 = x;
+        int16_t x1 = x + w - 1;
+        if (!viewport_clip_span(rows[i], x0, x1) || x0 != x || x1 != x + w - 1) {
+            return false;
+        }
+    }
+    return true;
+}
+
+uint32_t viewport_visible_pixels(int16_t x, int16_t y, int16_t w, int16_t h) {
+    uint32_t visible = 0;
+    for (int16_t row = y; row < y + h; row++) {
+        int16_t x0 = x;
+        int16_t x1 = x + w - 1;
+        if (viewport_clip_span(row, x0, x1)) {
+            visible += x1 - x0 + 1;
+        }
+    }
+    return visible;
+}
+
+bool viewport_fit_box(uint16_t w, uint16_t h, int16_t* x, int16_t* y) {
+    *x = (DISPLAY_WIDTH - (int16_t)w) / 2;
+
+    // Avvicina il box al centro verticale una riga alla volta
+    const int16_t center_top = (DISPLAY_HEIGHT - (int16_t)h) / 2;
+    int16_t top = *y;
+    while (!viewport_rect_inside(*x, top, w, h)) {
+        if (top == center_top) return false;
+        top += (top < center_top) ? 1 : -1;
+    }
+    *y = top;
+    return true;
+}
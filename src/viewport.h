@@ -0,0 +1,51 @@
+#ifndef VIEWPORT_H
+#define VIEWPORT_H
+
+#include <Arduino.h>
+#include "config.h"
+
+/**
+ * Viewport circolare del pannello GC9A01
+ * Il pannello è 240x240 ma solo il disco inscritto è visibile: per ogni riga
+ * una tabella precalcolata dà la semi-larghezza visibile, usata per tagliare
+ * gli span prima dell'invio SPI e per posizionare i contenuti
+ * Un pixel è visibile se il suo centro cade nel disco di raggio DISPLAY_VIEWPORT_RADIUS
+ */
+
+/**
+ * Calcola la tabella delle semi-larghezze (chiamata una volta all'avvio)
+ */
+void viewport_begin();
+
+/**
+ * Semi-larghezza visibile della riga y (0 = riga fuori dal disco)
+ * La riga è visibile nelle colonne [DISPLAY_WIDTH/2 - hw, DISPLAY_WIDTH/2 + hw - 1]
+ */
+uint8_t viewport_half_width(int16_t y);
+
+/**
+ * Taglia lo span [x0, x1] della riga y al disco visibile
+ * @return false se non resta nessun pixel visibile
+ */
+bool viewport_clip_span(int16_t y, int16_t& x0, int16_t& x1);
+
+/**
+ * Verifica se un rettangolo è interamente visibile (nessun taglio necessario)
+ */
+bool viewport_rect_inside(int16_t x, int16_t y, int16_t w, int16_t h);
+
+/**
+ * Pixel visibili di un rettangolo (per il conteggio dei pixel scartati)
+ */
+uint32_t viewport_visible_pixels(int16_t x, int16_t y, int16_t w, int16_t h);
+
+/**
+ * Layout: centra orizzontalmente un box w x h e lo sposta verso il centro
+ * verticale finché non è interamente visibile
+ * @param y Ordinata desiderata (bordo superiore), aggiornata se il box non ci sta
+ * @param x Ascissa del bordo sinistro del box centrato
+ * @return false se il box non entra nel disco a nessuna altezza
+ */
+bool viewport_fit_box(uint16_t w, uint16_t h, int16_t* x, int16_t* y);
+
+#endif // VIEWPORT_H
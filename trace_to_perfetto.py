@@ -0,0 +1,172 @@
+#!/usr/bin/env python3
+"""
+Converte il dump binario di trace.h in JSON Chrome trace / Perfetto
+- Input: file con il dump (anche un log seriale con testo prima/dopo il dump)
+  oppure la seriale della board (--port, richiede pyserial): invia il
+  comando di dump e legge la risposta
+- Output: JSON da aprire in https://ui.perfetto.dev o chrome://tracing
+- Riepilogo per span: conteggio, media, p99 e max in µs
+
+Uso:
+    python3 trace_to_perfetto.py dump.bin -o trace.json
+    python3 trace_to_perfetto.py --port /dev/ttyACM0 -o trace.json
+"""
+
+import argparse
+import json
+import struct
+import sys
+import time
+
+MAGIC = b"MNTR"
+SUPPORTED_VERSION = 1
+HEADER = struct.Struct("<4sHHIIII")   # magic, versione, span, cicli/µs, overhead, registrati, eventi
+EVENT = struct.Struct("<IIBBH")       # start, cicli, id, profondità, riservato
+DUMP_COMMAND = b"T"                   # TRACE_DUMP_COMMAND in config.h
+
+
+def read_serial(port, baud, timeout):
+    """Richiede il dump alla board e restituisce i byte ricevuti"""
+    try:
+        import serial
+    except ImportError:
+        sys.exit("❌ pyserial non installato: pip install pyserial")
+
+    data = bytearray()
+    with serial.Serial(port, baud, timeout=0.2) as link:
+        link.reset_input_buffer()
+        link.write(DUMP_COMMAND)
+        deadline = time.time() + timeout
+        while time.time() < deadline:
+            chunk = link.read(4096)
+            if chunk:
+                data.extend(chunk)
+                deadline = time.time() + 1.0  # Fine dump: un secondo senza dati
+    return bytes(data)
+
+
+def parse_dump(data):
+    """Cerca l'ultimo dump completo nei dati e restituisce header, nomi, eventi"""
+    # Ultimo "MNTR" seguito da un header valido (i byte degli eventi possono contenerlo)
+    offset = len(data)
+    while True:
+        offset = data.rfind(MAGIC, 0, offset)
+        if offset < 0:
+            sys.exit("❌ Nessun dump MNTR trovato nei dati")
+        if len(data) - offset < HEADER.size:
+            continue
+        magic, version, span_count, cycles_per_us, overhead, recorded, count = HEADER.unpack_from(data, offset)
+        if version == SUPPORTED_VERSION and 0 < span_count < 256:
+            break
+    pos = offset + HEADER.size
+
+    names = []
+    for _ in range(span_count):
+        end = data.find(b"\0", pos)
+        if end < 0:
+            sys.exit("❌ Dump troncato (nomi span)")
+        names.append(data[pos:end].decode("ascii", "replace"))
+        pos = end + 1
+
+    if len(data) - pos < count * EVENT.size:
+        sys.exit(f"❌ Dump troncato: attesi {count} eventi")
+    events = [EVENT.unpack_from(data, pos + i * EVENT.size) for i in range(count)]
+
+    header = {
+        "cycles_per_us": cycles_per_us,
+        "overhead_cycles": overhead,
+        "recorded": recorded,
+    }
+    return header, names, events
+
+
+def unwrap(events):
+    """Il contatore è a 32 bit: gli eventi sono in ordine di fine, si ricostruisce
+    una fine monotona a 64 bit e l'inizio come fine - durata"""
+    result = []
+    wraps = 0
+    previous_end = None
+    for start, cycles, span_id, depth, _ in events:
+        end = (start + cycles) & 0xFFFFFFFF
+        if previous_end is not None and end < previous_end:
+            wraps += 1
+        previous_end = end
+        end64 = end + (wraps << 32)
+        result.append((end64 - cycles, cycles, span_id, depth))
+    return result
+
+
+def to_chrome_trace(header, names, events):
+    cycles_per_us = header["cycles_per_us"] or 1
+    base = min((start for start, _, _, _ in events), default=0)
+    trace_events = []
+    for start, cycles, span_id, depth in events:
+        name = names[span_id] if span_id < len(names) else f"span_{span_id}"
+        trace_events.append({
+            "name": name,
+            "cat": name.split("::")[0],
+            "ph": "X",
+            "ts": (start - base) / cycles_per_us,
+            "dur": cycles / cycles_per_us,
+            "pid": 1,
+            "tid": 1,
+            "args": {"cycles": cycles, "depth": depth},
+        })
+    return {
+        "traceEvents": trace_events,
+        "displayTimeUnit": "ns",
+        "otherData": {
+            "source": "MicroNav trace.h",
+            "cycles_per_us": header["cycles_per_us"],
+            "span_overhead_cycles": header["overhead_cycles"],
+            "spans_recorded": header["recorded"],
+        },
+    }
+
+
+def print_summary(header, names, events):
+    cycles_per_us = header["cycles_per_us"] or 1
+    print(f"📊 {len(events)} eventi nel buffer ({header['recorded']} registrati), "
+          f"costo span {header['overhead_cycles']} cicli "
+          f"({header['overhead_cycles'] / cycles_per_us:.2f} µs)")
+    by_span = {}
+    for _, cycles, span_id, _ in events:
+        by_span.setdefault(span_id, []).append(cycles / cycles_per_us)
+    print(f"   {'span':<46} {'n':>6} {'media µs':>10} {'p99 µs':>10} {'max µs':>10}")
+    for span_id in sorted(by_span):
+        values = sorted(by_span[span_id])
+        p99 = values[min(len(values) - 1, int(len(values) * 0.99))]
+        name = names[span_id] if span_id < len(names) else f"span_{span_id}"
+        print(f"   {name:<46} {len(values):>6} {sum(values) / len(values):>10.1f} "
+              f"{p99:>10.1f} {values[-1]:>10.1f}")
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Dump trace MicroNav -> JSON Chrome trace / Perfetto")
+    parser.add_argument("input", nargs="?", help="File con il dump (o log seriale che lo contiene)")
+    parser.add_argument("--port", help="Seriale della board (es. /dev/ttyACM0)")
+    parser.add_argument("--baud", type=int, default=115200, help="Baudrate seriale")
+    parser.add_argument("--timeout", type=float, default=10.0, help="Attesa massima dump in secondi")
+    parser.add_argument("-o", "--output", default="trace.json", help="File JSON di output")
+    args = parser.parse_args()
+
+    if args.port:
+        print(f"🔌 Richiesta dump su {args.port}...")
+        data = read_serial(args.port, args.baud, args.timeout)
+    elif args.input:
+        with open(args.input, "rb") as f:
+            data = f.read()
+    else:
+        parser.error("serve un file di input oppure --port")
+
+    header, names, raw_events = parse_dump(data)
+    events = unwrap(raw_events)
+
+    with open(args.output, "w") as f:
+        json.dump(to_chrome_trace(header, names, events), f)
+    print_summary(header, names, events)
+    print(f"✅ Scritto {args.output} (apri con https://ui.perfetto.dev)")
+
+
+if __name__ == "__main__":
+    main()
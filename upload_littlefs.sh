@@ -134,9 +134,28 @@ else
     echo -e "${RED}Errore: Nessun file *.json trovato in data/!${NC}"
     exit 1
 fi
+
+# Slot del database binario (make_speedcam_db.py), se presenti
+if ls "$DATA_DIR"/speedcams_*.bin 1> /dev/null 2>&1; then
+    cp "$DATA_DIR"/speedcams_*.bin "$TEMP_DATA_DIR/"
+    echo -e "${GREEN}Slot database binario:${NC}"
+    ls -lh "$TEMP_DATA_DIR"/speedcams_*.bin 2>/dev/null | awk '{print "  - " $9 " (" $5 ")"}'
+fi
+
+# Patch del database (make_speedcam_db.py --patch-from), se presente
+if [ -f "$DATA_DIR/speedcams.patch" ]; then
+    cp "$DATA_DIR/speedcams.patch" "$TEMP_DATA_DIR/"
+    echo -e "${GREEN}Patch database: speedcams.patch ($(wc -c < "$DATA_DIR/speedcams.patch") byte)${NC}"
+fi
+
+# Corridoi stradali (make_corridors.py), se presenti
+if [ -f "$DATA_DIR/corridors.bin" ]; then
+    cp "$DATA_DIR/corridors.bin" "$TEMP_DATA_DIR/"
+    echo -e "${GREEN}Corridoi stradali: corridors.bin ($(wc -c < "$DATA_DIR/corridors.bin") byte)${NC}"
+fi
 echo -e "${YELLOW}Nota: boot_logo.* esclusi (boot logo è compilato nel firmware)${NC}"
 
-echo -e "${GREEN}Creazione immagine LittleFS (solo *.json)...${NC}"
+echo -e "${GREEN}Creazione immagine LittleFS (*.json, slot del database e corridoi)...${NC}"
 
 # Crea immagine LittleFS usando solo la directory temporanea (2.5MB = 0x270000 bytes)
 IMAGE_FILE="$SCRIPT_DIR/littlefs.bin"